@@ -22,6 +22,8 @@
 #include "afloat.h"
 #include "atest.h"
 #include "aprecompute.h"
+#include "adispatch.h"
+#include "aexp.h"  // AUSSIE_GELU_TANH_*
 
 #include "aactivation.h"  // self-include
 
@@ -108,18 +110,18 @@ float aussie_GELU_basic2(float x)   // Basic Gaussian GELU (still inefficient)
 
 float aussie_GELU_approx1(float f)   // Approximated Gaussian GELU
 {
-	// GELU paper approx #1 = 0.5 * x * ( 1 + tanh ( sqrt(2/PI) * (x + 0.44715 * x^3)  ) ) 
+	// GELU paper approx #1 = 0.5 * x * ( 1 + tanh ( sqrt(2/PI) * (x + 0.044715 * x^3)  ) ) 
 
-	return 0.5f * f * (1.0f + tanhf(sqrtf(2.0f / AUSSIE_PI) * (f + (0.44715f * (f * f * f)))));
+	return 0.5f * f * (1.0f + tanhf(sqrtf(2.0f / AUSSIE_PI) * (f + (0.044715f * (f * f * f)))));
 }
 
 float aussie_GELU_approx1_optimized(float f)   // Approximated Gaussian GELU (with minor optimizations)
 {
-	// GELU paper approx #1 = 0.5 * x * ( 1 + tanh ( sqrt(2/PI) * (x + 0.44715 * x^3)  ) ) 
+	// GELU paper approx #1 = 0.5 * x * ( 1 + tanh ( sqrt(2/PI) * (x + 0.044715 * x^3)  ) ) 
 	static float s_sqrt_2_div_pi = sqrtf(2.0f / AUSSIE_PI);
 	return 0.5f * f *
 		(1.0f + tanhf(s_sqrt_2_div_pi *
-			(f + (0.44715f * (f * f * f))))
+			(f + (0.044715f * (f * f * f))))
 			);
 }
 
@@ -133,18 +135,58 @@ float aussie_GELU_approx1_optimized(float f)   // Approximated Gaussian GELU (wi
 
 float aussie_GELU_approx1_optimized2(float f)   // Approximated Gaussian GELU (with 2nd minor optimizations)
 {
-	// GELU paper approx #1 = 0.5 * x * ( 1 + tanh ( sqrt(2/PI) * (x + 0.44715 * x^3)  ) ) 
+	// GELU paper approx #1 = 0.5 * x * ( 1 + tanh ( sqrt(2/PI) * (x + 0.044715 * x^3)  ) ) 
 	// Optimize by factoring out one multiplication by f (reducing x*x*x to x*x)
 	static float s_sqrt_2_div_pi = sqrtf(2.0f / AUSSIE_PI);
 	return 0.5f * f *
 		(1.0f
 			+ tanhf(s_sqrt_2_div_pi *
 				f *
-				(1.0f + (0.44715f * (f * f)))
+				(1.0f + (0.044715f * (f * f)))
 			)
 			);
 }
 
+//---------------------------------------------------
+// Vector activations (scalar versions of the aavx.cpp kernels)
+//---------------------------------------------------
+
+void aussie_vector_sigmoid(float v[], int n)   // 1 / (1 + e^-x)
+{
+	for (int i = 0; i < n; i++) {
+		v[i] = 1.0f / (1.0f + expf(-v[i]));
+	}
+}
+
+void aussie_vector_SiLU(float v[], int n)   // x * sigmoid(x)
+{
+	for (int i = 0; i < n; i++) {
+		v[i] = v[i] / (1.0f + expf(-v[i]));
+	}
+}
+
+void aussie_vector_GELU_tanh(float v[], int n)   // 0.5 * x * (1 + tanh(sqrt(2/pi) * (x + 0.044715 * x^3)))
+{
+	for (int i = 0; i < n; i++) {
+		float x = v[i];
+		v[i] = 0.5f * x * (1.0f + tanhf(AUSSIE_GELU_TANH_C * x * (1.0f + AUSSIE_GELU_TANH_A * x * x)));
+	}
+}
+
+void aussie_vector_GELU_sigmoid(float v[], int n)   // x * sigmoid(1.702 * x)
+{
+	for (int i = 0; i < n; i++) {
+		v[i] = v[i] / (1.0f + expf(-AUSSIE_GELU_SIGMOID_C * v[i]));
+	}
+}
+
+void aussie_vector_GELU_basic(float v[], int n)   // Exact GELU (erff)
+{
+	for (int i = 0; i < n; i++) {
+		v[i] = aussie_GELU_basic(v[i]);
+	}
+}
+
 float aussie_sigmoid(float x)
 {
 	// SIGMOID = 1 / ( 1 + e^-x)
@@ -209,7 +251,8 @@ float gelu_fast_FP32(float f)    // Table lookup GELU
 	return g_global_GELU_table_FP32[i32];   // FP32 version
 }
 
-float g_global_GELU_table_FP32_24bits[1UL << 24 /*~16Mx4 bytes = 64Meg*/];
+const float* g_global_GELU_table_FP32_24bits = NULL;  // 1<<24 floats (64Meg): mapped file or heap, not BSS
+static aussie_table s_aussie_GELU_table_24bits;
 
 
 
@@ -221,7 +264,9 @@ void aussie_GELU_setup_table_FP32_24bits() // Initialize 24-bits GELU precompute
 		return;  // Avoid double intialization!
 	}
 	s_once = true;
-	aussie_precompute_table_FP32_generic_24bits(g_global_GELU_table_FP32_24bits, 1u << 24, aussie_GELU_basic);
+	// Mapped from $AUSSIE_TABLE_DIR (generated there the first time), else computed on the heap
+	char path[1000];
+	aussie_GELU_load_table_FP32_24bits(aussie_table_default_path(path, (int)sizeof(path), AUSSIE_TABLE_FN_GELU, 24));
 
 #if 0
 	unsigned long int u = 0;
@@ -234,6 +279,15 @@ void aussie_GELU_setup_table_FP32_24bits() // Initialize 24-bits GELU precompute
 #endif
 }
 
+bool aussie_GELU_load_table_FP32_24bits(const char* fname)  // Map the table file (generating it if missing), NULL = compute
+{
+	aussie_table_release(s_aussie_GELU_table_24bits);
+	bool ok = aussie_table_load(s_aussie_GELU_table_24bits, fname, AUSSIE_TABLE_FN_GELU, 24, aussie_GELU_basic);
+	g_global_GELU_table_FP32_24bits = s_aussie_GELU_table_24bits.data;
+	yassert(ok);
+	return ok;
+}
+
 void aussie_GELU_setup_table_FP32_24bits_PRINT_SOURCE( // Initialize 24-bits GELU precomputed table 
 	char* nickname,
 	char* outfname
@@ -244,7 +298,7 @@ void aussie_GELU_setup_table_FP32_24bits_PRINT_SOURCE( // Initialize 24-bits GEL
 		outfname, 
 		aussie_GELU_basic,
 		1u<<24,
-		g_global_GELU_table_FP32_24bits
+		NULL  // The table itself is read-only (mapped)
 	);
 	return;
 
@@ -327,6 +381,14 @@ float gelu_fast_FP32_24bits(float f)    // Table lookup GELU (using 24 bits)
 {
 	unsigned int u = AUSSIE_FLOAT_TO_UINT(f);
 	u >>= 8;  // Cut least-significant 8 mantissa bits off
+	if (g_global_GELU_table_FP32_24bits == NULL) {  // Not set up (aussie_GELU_setup_table_FP32_24bits)
+		static bool s_warned = false;
+		if (!s_warned) {
+			s_warned = true;
+			yassert(g_global_GELU_table_FP32_24bits != NULL);
+		}
+		return aussie_GELU_basic(f);
+	}
 	return g_global_GELU_table_FP32_24bits[u];   // Look up in 24-bit FP32 version
 }
 
@@ -447,6 +509,55 @@ void aussie_test_step_functions(float f, float expected)
 //---------------------------------------------------
 //---------------------------------------------------
 
+static void aussie_test_vector_activations()
+{
+	// Dispatched (SIMD) vector activations against the exact functions over [-10,10]
+	const int n = 2001;
+	float* x = (float*)malloc(n * sizeof(float));
+	float* v = (float*)malloc(n * sizeof(float));
+	for (int i = 0; i < n; i++) x[i] = -10.0f + 20.0f * (float)i / (float)(n - 1);
+	struct {
+		const char* name;
+		void (*vecfn)(float v[], int n);
+		float (*exact)(float);
+		float maxerr;  // Absolute
+	} acts[] = {
+		{ "sigmoid", aussie_vector_sigmoid_dispatch, aussie_sigmoid, 1e-6f },
+		{ "SiLU", aussie_vector_SiLU_dispatch, aussie_SiLU_basic, 4e-6f },  // A few ulps of 10
+		{ "GELU tanh", aussie_vector_GELU_tanh_dispatch, aussie_GELU_basic, 5e-4f },  // The approximation's own error
+		{ "GELU sigmoid", aussie_vector_GELU_sigmoid_dispatch, aussie_GELU_basic, 0.021f },
+	};
+	for (int k = 0; k < (int)(sizeof(acts) / sizeof(acts[0])); k++) {
+		memcpy(v, x, n * sizeof(float));
+		acts[k].vecfn(v, n);
+		float maxerr = 0.0f;
+		for (int i = 0; i < n; i++) {
+			float err = fabsf(v[i] - acts[k].exact(x[i]));
+			if (err > maxerr) maxerr = err;
+		}
+		fprintf(stderr, "INFO: Vector %s (%s): max error %g on [-10,10]\n", acts[k].name,
+			aussie_dispatch_isa_name(g_aussie_dispatch.isa), maxerr);
+		ytest(maxerr < acts[k].maxerr);
+	}
+	free(x);
+	free(v);
+
+	// Saturation and NaN
+	float w[5] = { -100.0f, 100.0f, 0.0f, NAN, -0.5f };
+	aussie_vector_sigmoid_dispatch(w, 5);
+	ytestf(w[0], 0.0f);
+	ytestf(w[1], 1.0f);
+	ytestf(w[2], 0.5f);
+	ytest(isnan(w[3]));
+	float g[5] = { -100.0f, 100.0f, 0.0f, NAN, -0.5f };
+	aussie_vector_GELU_tanh_dispatch(g, 5);
+	ytestf(g[0], 0.0f);
+	ytestf(g[1], 100.0f);
+	ytestf(g[2], 0.0f);
+	ytest(isnan(g[3]));
+	ytest(fabsf(g[4] - aussie_GELU_approx1(-0.5f)) < 1e-6f);  // Same formula as the scalar version
+}
+
 void aussie_activation_unit_tests()
 {
 	fprintf(stderr, "INFO: %s: Running unit tests\n", __func__);
@@ -466,6 +577,8 @@ void aussie_activation_unit_tests()
 	aussie_test_step_functions(-1.0f, 0.0f);
 	aussie_test_step_functions(0.0f, 1.0f);  // Step of 0 is 1
 
+	aussie_test_vector_activations();
+
 }
 
 
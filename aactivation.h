@@ -44,7 +44,7 @@ float aussie_ELU_basic(float x, float alpha_hyperparam);   // Basic ELU activati
 // GELU paper: https://arxiv.org/abs/1606.08415 -- Hendrycks & Gimpel 2016/revised 2023
 float aussie_GELU_basic(float x);   // Basic Gaussian GELU (inefficient)
 float aussie_GELU_basic2(float x);   // Basic Gaussian GELU (still inefficient)
-// GELU paper approx #1 = 0.5 * x * ( 1 + tanh ( sqrt(2/PI) * (x + 0.44715 * x^3)  ) ) 
+// GELU paper approx #1 = 0.5 * x * ( 1 + tanh ( sqrt(2/PI) * (x + 0.044715 * x^3)  ) ) 
 float aussie_GELU_approx1(float f);   // Approximated Gaussian GELU
 float aussie_GELU_approx1_optimized(float f);   // Approximated Gaussian GELU (with minor optimizations)
 float aussie_GELU_approx1_optimized2(float f);   // Approximated Gaussian GELU (with 2nd minor optimizations)
@@ -62,6 +62,7 @@ void aussie_GELU_setup_table_FP16(); // Initialize GELU precomputed table for FP
 // GELU precomputation in 24-bit lookup table...
 void aussie_GELU_setup_table_FP32_24bits_PRINT_SOURCE(char* nickname, char *outfname); // Initialize 24-bits GELU precomputed table
 void aussie_GELU_setup_table_FP32_24bits(); // Initialize 24-bits GELU precomputed table
+bool aussie_GELU_load_table_FP32_24bits(const char* fname);  // Map a table file (aprecompute.h), generating it if missing; NULL = compute
 float gelu_fast_FP32_24bits(float f);    // Table lookup GELU (using 24 bits)
 
 //-------------------------------------------------------------------------
@@ -70,6 +71,20 @@ float gelu_fast_FP32_24bits(float f);    // Table lookup GELU (using 24 bits)
 
 float aussie_SiLU_basic(float x);   // Basic SiLU (inefficient)
 
+//-------------------------------------------------------------------------
+// Vector activations: a whole FFN vector at a time (11K-14K elements per layer per token)
+// ... scalar versions here; AVX2/AVX-512 versions in aavx.h, dispatched in adispatch.h
+// ... GELU tanh approximation via 0.5 * (1 + tanh(u)) = sigmoid(2u), so every kernel is one expf and a division
+//-------------------------------------------------------------------------
+
+#define AUSSIE_GELU_SIGMOID_C  1.702f
+
+void aussie_vector_sigmoid(float v[], int n);   // 1 / (1 + e^-x)
+void aussie_vector_SiLU(float v[], int n);   // x * sigmoid(x)
+void aussie_vector_GELU_tanh(float v[], int n);   // 0.5 * x * (1 + tanh(sqrt(2/pi) * (x + 0.044715 * x^3)))
+void aussie_vector_GELU_sigmoid(float v[], int n);   // x * sigmoid(1.702 * x) (less accurate)
+void aussie_vector_GELU_basic(float v[], int n);   // Exact GELU (erff), the reference
+
 //-------------------------------------------------------------------------
 
 void aussie_precompute_tests();  // Test precompute of activations example
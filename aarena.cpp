@@ -0,0 +1,430 @@
+// aarena.cpp -- Arena (bump) allocator for scratch buffers -- Aussie AI Base Library
+// Created Oct 17th 2026
+// Copyright (c) 2023 Aussie AI Labs Pty Ltd
+//---------------------------------------------------
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <math.h>
+#include <stdint.h>
+#include <mutex>
+
+#include "aport.h"
+
+#if !LINUX
+#include <malloc.h>  // _aligned_malloc
+#endif
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+#include "aussieai.h"
+#include "aassert.h"
+#include "atest.h"
+#include "athread.h"
+#include "atopk.h"
+#include "agemm.h"
+#include "asoftmax.h"
+
+#include "aarena.h"  // self-include
+
+//---------------------------------------------------
+// Arena
+//---------------------------------------------------
+
+struct aussie_arena_overflow {
+	aussie_arena_overflow* next;
+	size_t charge;  // Bytes it adds to the arena's live count
+};
+
+#define AUSSIE_ARENA_GROW_ROUND 4096  // Grown blocks are whole pages
+
+static size_t aussie_arena_round_up(size_t n, size_t align)
+{
+	return (n + align - 1) / align * align;
+}
+
+bool aussie_arena_init(aussie_arena& a, size_t capacity, const char* name /*= NULL*/)
+{
+	memset(&a, 0, sizeof(a));
+	a.name = name ? name : "arena";
+	if (capacity == 0) return true;  // Grows on first use
+	capacity = aussie_arena_round_up(capacity, AUSSIE_ARENA_ALIGN);
+	a.block = (char*)AUSSIE_ALIGNED_MALLOC(capacity, AUSSIE_ARENA_ALIGN);
+	if (a.block == NULL) {
+		yassert(a.block != NULL);
+		return false;  // fail
+	}
+	a.capacity = capacity;
+	a.nheap = 1;
+	return true;
+}
+
+static void aussie_arena_free_overflow(aussie_arena& a, aussie_arena_overflow* stop)
+{
+	while (a.overflow != NULL && a.overflow != stop) {
+		aussie_arena_overflow* next = a.overflow->next;
+		AUSSIE_ALIGNED_FREE(a.overflow);
+		a.overflow = next;
+	}
+}
+
+void aussie_arena_destroy(aussie_arena& a)
+{
+	aussie_arena_free_overflow(a, NULL);
+	if (a.block) AUSSIE_ALIGNED_FREE(a.block);
+	const char* name = a.name;
+	memset(&a, 0, sizeof(a));
+	a.name = name;
+}
+
+static void aussie_arena_grow_if_empty(aussie_arena& a)
+{
+	// Only an empty arena can move: nothing points into the old block
+	if (a.used != 0 || a.overflow != NULL || a.high_water <= a.capacity) return;
+	size_t capacity = aussie_arena_round_up(a.high_water, AUSSIE_ARENA_GROW_ROUND);
+	char* block = (char*)AUSSIE_ALIGNED_MALLOC(capacity, AUSSIE_ARENA_ALIGN);
+	a.nheap++;
+	if (block == NULL) return;  // Keep the old block (overflow continues to work)
+	if (a.block) AUSSIE_ALIGNED_FREE(a.block);
+	a.block = block;
+	a.capacity = capacity;
+}
+
+void* aussie_arena_alloc(aussie_arena& a, size_t bytes, size_t align /*= AUSSIE_ARENA_ALIGN*/)
+{
+	if (align == 0 || (align & (align - 1)) != 0) {
+		yassert(align != 0 && (align & (align - 1)) == 0);  // Power of two
+		return NULL;  // fail
+	}
+	a.nallocs++;
+	if (a.block != NULL) {
+		uintptr_t base = (uintptr_t)a.block;
+		uintptr_t p = (base + a.used + align - 1) & ~(uintptr_t)(align - 1);
+		if (p + bytes <= base + a.capacity) {  // The common case: a pointer bump
+			size_t newused = (size_t)(p + bytes - base);
+			a.live += newused - a.used;
+			a.used = newused;
+			if (a.live > a.high_water) a.high_water = a.live;
+			return (void*)p;
+		}
+	}
+
+	// Doesn't fit: a heap block of its own, until the arena is next empty
+	size_t blockalign = align > AUSSIE_ARENA_ALIGN ? align : AUSSIE_ARENA_ALIGN;
+	size_t header = aussie_arena_round_up(sizeof(aussie_arena_overflow), blockalign);
+	aussie_arena_overflow* ov = (aussie_arena_overflow*)AUSSIE_ALIGNED_MALLOC(header + bytes, blockalign);
+	a.nheap++;
+	if (ov == NULL) {
+		yassert(ov != NULL);
+		return NULL;  // fail (out of memory)
+	}
+	ov->next = a.overflow;
+	ov->charge = bytes + align;  // As if in the block (worst-case padding)
+	a.overflow = ov;
+	a.live += ov->charge;
+	if (a.live > a.high_water) a.high_water = a.live;
+	return (char*)ov + header;
+}
+
+void* aussie_arena_calloc(aussie_arena& a, size_t bytes, size_t align /*= AUSSIE_ARENA_ALIGN*/)
+{
+	void* p = aussie_arena_alloc(a, bytes, align);
+	if (p) memset(p, 0, bytes);
+	return p;
+}
+
+float* aussie_arena_alloc_floats(aussie_arena& a, long long n)
+{
+	if (n < 0) {
+		yassert(n >= 0);
+		return NULL;  // fail
+	}
+	return (float*)aussie_arena_alloc(a, (size_t)n * sizeof(float), AUSSIE_ARENA_ALIGN);
+}
+
+aussie_arena_mark aussie_arena_get_mark(const aussie_arena& a)
+{
+	aussie_arena_mark mark;
+	mark.used = a.used;
+	mark.live = a.live;
+	mark.overflow = a.overflow;
+	return mark;
+}
+
+void aussie_arena_release(aussie_arena& a, const aussie_arena_mark& mark)
+{
+	if (mark.used > a.used || mark.live > a.live) {
+		yassert(mark.used <= a.used && mark.live <= a.live);  // Released in the wrong order
+		return;  // fail
+	}
+	aussie_arena_free_overflow(a, mark.overflow);
+	a.used = mark.used;
+	a.live = mark.live;
+	aussie_arena_grow_if_empty(a);
+}
+
+void aussie_arena_reset(aussie_arena& a)
+{
+	aussie_arena_free_overflow(a, NULL);
+	a.used = 0;
+	a.live = 0;
+	aussie_arena_grow_if_empty(a);
+}
+
+void aussie_arena_report(FILE* fp, const aussie_arena& a)
+{
+	fprintf(fp, "%s: capacity %lu KB, in use %lu KB, high-water %lu KB, %lld allocations, %lld heap calls%s\n",
+		a.name ? a.name : "arena",
+		(unsigned long)(a.capacity / 1024), (unsigned long)(a.live / 1024), (unsigned long)(a.high_water / 1024),
+		a.nallocs, a.nheap, a.overflow ? " (overflowed)" : "");
+}
+
+//---------------------------------------------------
+// Per-thread arenas
+//---------------------------------------------------
+
+static aussie_arena s_aussie_thread_arenas[AUSSIE_ARENA_MAX_THREADS];
+static char s_aussie_thread_arena_names[AUSSIE_ARENA_MAX_THREADS][24];
+static int s_aussie_thread_arena_count = 0;  // Slots ever used
+static int s_aussie_thread_arena_free[AUSSIE_ARENA_MAX_THREADS];  // Slots of threads that have exited
+static int s_aussie_thread_arena_nfree = 0;
+static std::mutex s_aussie_thread_arena_mutex;  // Guards creation, thread exit, and the reports
+static thread_local aussie_arena* s_aussie_my_arena = NULL;
+
+struct aussie_thread_arena_owner {  // Gives this thread's slot back when the thread exits
+	int slot;
+	aussie_thread_arena_owner() : slot(-1) {}
+	~aussie_thread_arena_owner()
+	{
+		if (slot < 0) return;
+		std::lock_guard<std::mutex> guard(s_aussie_thread_arena_mutex);
+		aussie_arena_reset(s_aussie_thread_arenas[slot]);  // The block is kept (warm) for the next thread
+		s_aussie_thread_arena_free[s_aussie_thread_arena_nfree++] = slot;
+		s_aussie_my_arena = NULL;
+		slot = -1;
+	}
+};
+static thread_local aussie_thread_arena_owner s_aussie_my_arena_owner;
+
+aussie_arena* aussie_thread_arena()
+{
+	if (s_aussie_my_arena != NULL) return s_aussie_my_arena;
+	std::lock_guard<std::mutex> guard(s_aussie_thread_arena_mutex);
+	int slot = -1;
+	if (s_aussie_thread_arena_nfree > 0) {
+		slot = s_aussie_thread_arena_free[--s_aussie_thread_arena_nfree];  // Reuse an exited thread's arena
+	}
+	else {
+		if (s_aussie_thread_arena_count >= AUSSIE_ARENA_MAX_THREADS) return NULL;  // Callers fall back to the heap
+		slot = s_aussie_thread_arena_count;
+		if (!aussie_arena_init(s_aussie_thread_arenas[slot], AUSSIE_ARENA_THREAD_BYTES, s_aussie_thread_arena_names[slot])) {
+			return NULL;
+		}
+		s_aussie_thread_arena_count++;
+	}
+	sprintf(s_aussie_thread_arena_names[slot], "Arena %d (thread %d)", slot, aussie_thread_index());
+	s_aussie_my_arena_owner.slot = slot;
+	s_aussie_my_arena = &s_aussie_thread_arenas[slot];
+	return s_aussie_my_arena;
+}
+
+void aussie_thread_arena_report(FILE* fp)
+{
+	std::lock_guard<std::mutex> guard(s_aussie_thread_arena_mutex);
+	for (int i = 0; i < s_aussie_thread_arena_count; i++) {
+		aussie_arena_report(fp, s_aussie_thread_arenas[i]);
+	}
+}
+
+size_t aussie_thread_arena_high_water()
+{
+	std::lock_guard<std::mutex> guard(s_aussie_thread_arena_mutex);
+	size_t hw = 0;
+	for (int i = 0; i < s_aussie_thread_arena_count; i++) {
+		if (s_aussie_thread_arenas[i].high_water > hw) hw = s_aussie_thread_arenas[i].high_water;
+	}
+	return hw;
+}
+
+long long aussie_thread_arena_heap_calls()
+{
+	std::lock_guard<std::mutex> guard(s_aussie_thread_arena_mutex);
+	long long n = 0;
+	for (int i = 0; i < s_aussie_thread_arena_count; i++) n += s_aussie_thread_arenas[i].nheap;
+	return n;
+}
+
+//---------------------------------------------------
+// Unit tests
+//---------------------------------------------------
+
+static void aussie_arena_test_basic()
+{
+	aussie_arena a;
+	ytest(aussie_arena_init(a, 1000, "test arena"));
+	ytest(a.capacity == 1024);  // Whole cache lines
+	ytest(((size_t)a.block % AUSSIE_ARENA_ALIGN) == 0);
+
+	// Aligned bumps
+	char* p1 = (char*)aussie_arena_alloc(a, 10);
+	char* p2 = (char*)aussie_arena_alloc(a, 100, 16);
+	char* p3 = (char*)aussie_arena_alloc(a, 1, 1);
+	float* f = aussie_arena_alloc_floats(a, 20);
+	ytest(p1 == a.block);
+	ytest(((size_t)p2 % 16) == 0 && p2 == p1 + 16);
+	ytest(p3 == p2 + 100);
+	ytest(((size_t)f % AUSSIE_ARENA_ALIGN) == 0 && (char*)f > p3);
+	for (int i = 0; i < 20; i++) f[i] = (float)i;
+	ytest(a.used == (size_t)((char*)(f + 20) - a.block));
+	ytest(a.overflow == NULL && a.nheap == 1 && a.nallocs == 4);
+	int* z = (int*)aussie_arena_calloc(a, 8 * sizeof(int), 4);
+	ytesti(z[7], 0);
+
+	// Mark and release: stack-like scratch
+	aussie_arena_mark mark = aussie_arena_get_mark(a);
+	size_t used = a.used;
+	ytest(aussie_arena_alloc(a, 200) != NULL);
+	ytest(a.used > used);
+	aussie_arena_release(a, mark);
+	ytest(a.used == used);
+	ytestf(f[19], 19.0f);  // Older allocations untouched
+
+	// Overflow: still works, then the block grows when empty
+	char* big = (char*)aussie_arena_alloc(a, 5000, 128);
+	ytest(big != NULL && a.overflow != NULL);
+	ytest(((size_t)big % 128) == 0);
+	memset(big, 1, 5000);
+	ytest(a.nheap == 2);
+	size_t hw = a.high_water;
+	ytest(hw > 5000);
+	aussie_arena_reset(a);
+	ytest(a.overflow == NULL && a.used == 0 && a.live == 0);
+	ytest(a.capacity >= hw && a.nheap == 3);
+
+	// After warmup the same work makes no heap calls
+	long long nheap = a.nheap;
+	for (int step = 0; step < 3; step++) {
+		ytest(aussie_arena_alloc(a, 1000) != NULL);
+		ytest(aussie_arena_alloc(a, 5000, 128) != NULL);
+		aussie_arena_reset(a);
+	}
+	ytest(a.nheap == nheap);
+	ytest(a.high_water <= a.capacity);
+	aussie_arena_destroy(a);
+	ytest(a.block == NULL && a.capacity == 0);
+
+	// Empty arena: first allocation overflows, then it has a block
+	ytest(aussie_arena_init(a, 0));
+	ytest(aussie_arena_alloc(a, 0) != NULL);
+	ytest(aussie_arena_alloc(a, 300) != NULL);
+	aussie_arena_reset(a);
+	ytest(a.block != NULL && a.capacity >= 300);
+	aussie_arena_destroy(a);
+}
+
+struct aussie_arena_test_thread_args {
+	aussie_arena* arenas[AUSSIE_ARENA_MAX_THREADS];
+};
+
+static void aussie_arena_test_thread_task(int itask, void* arg)
+{
+	aussie_arena_test_thread_args* args = (aussie_arena_test_thread_args*)arg;
+	aussie_arena* a = aussie_thread_arena();
+	if (a == NULL) return;
+	args->arenas[itask] = a;
+	aussie_arena_mark mark = aussie_arena_get_mark(*a);
+	float* f = aussie_arena_alloc_floats(*a, 1000);
+	for (int i = 0; i < 1000; i++) f[i] = (float)itask;
+	ytestf(f[999], (float)itask);  // No other thread wrote here
+	aussie_arena_release(*a, mark);
+}
+
+static void aussie_arena_test_threads()
+{
+	aussie_arena* a = aussie_thread_arena();
+	ytest(a != NULL);
+	ytest(aussie_thread_arena() == a);  // Same arena every time
+	aussie_arena_test_thread_args args;
+	memset(&args, 0, sizeof(args));
+	int nthreads = aussie_thread_count();
+	int ntasks = nthreads < AUSSIE_ARENA_MAX_THREADS ? nthreads : AUSSIE_ARENA_MAX_THREADS;
+	aussie_parallel_run(ntasks, aussie_arena_test_thread_task, &args, AUSSIE_SCHEDULE_STATIC);
+	for (int i = 0; i < ntasks; i++) {
+		ytest(args.arenas[i] != NULL);
+		for (int j = 0; j < i; j++) ytest(args.arenas[i] != args.arenas[j]);  // One per thread
+	}
+	ytest(aussie_thread_arena_high_water() >= 1000 * sizeof(float));
+}
+
+static void aussie_arena_test_pool_restarts()
+{
+	// Exited threads give their arenas back: restarting the pool many times
+	// (more threads in total than AUSSIE_ARENA_MAX_THREADS) reuses the same slots
+	const int nthreads = 4;
+	int nrestarts = 2 * AUSSIE_ARENA_MAX_THREADS / (nthreads - 1) + 1;
+	int nslots = 0;
+	for (int r = 0; r < nrestarts; r++) {
+		aussie_thread_pool_shutdown();
+		aussie_thread_pool_init(nthreads);
+		aussie_arena_test_thread_args args;
+		memset(&args, 0, sizeof(args));
+		aussie_parallel_run(nthreads, aussie_arena_test_thread_task, &args, AUSSIE_SCHEDULE_STATIC);
+		for (int i = 0; i < nthreads; i++) ytest(args.arenas[i] != NULL);  // Never out of slots
+		if (r == 0) {
+			std::lock_guard<std::mutex> guard(s_aussie_thread_arena_mutex);
+			nslots = s_aussie_thread_arena_count;
+		}
+	}
+	aussie_thread_pool_shutdown();  // Back to the default size on next use
+	std::lock_guard<std::mutex> guard(s_aussie_thread_arena_mutex);
+	ytesti(s_aussie_thread_arena_count, nslots);  // No new slots after the first pool
+}
+
+static void aussie_arena_test_kernel_step(float* v, float* A, float* C, int n, int m)
+{
+	// One "inference step" of kernels that need scratch memory
+	float vout[10];
+	int pout[10];
+	aussie_vector_top_k_qsort_permut(v, n, 10, vout, pout);
+	ytest(vout[0] >= vout[9]);
+	aussie_gemm(false, false, m, m, m, 1.0f, A, m, A, m, 0.0f, C, m);
+	aussie_vector_softmax_parallel(v, n);
+}
+
+static void aussie_arena_test_kernels()
+{
+	// After a warmup step, kernel scratch memory makes no heap calls
+	int n = 5000, m = 200;
+	float* v = (float*)malloc(n * sizeof(float));
+	float* A = (float*)malloc(m * m * sizeof(float));
+	float* C = (float*)malloc(m * m * sizeof(float));
+	for (int i = 0; i < n; i++) v[i] = (float)((i * 37) % 101) / 101.0f;
+	for (int i = 0; i < m * m; i++) A[i] = (float)(i % 13) / 13.0f;
+	aussie_arena_test_kernel_step(v, A, C, n, m);  // Warmup: arenas grow
+	long long nheap = aussie_thread_arena_heap_calls();
+	for (int step = 0; step < 3; step++) aussie_arena_test_kernel_step(v, A, C, n, m);
+	ytest(aussie_thread_arena_heap_calls() == nheap);
+	ytest(aussie_thread_arena()->live == 0);  // Kernels released their scratch
+	ytest(aussie_thread_arena_high_water() >= (size_t)n * sizeof(aussie_topk_item));
+	free(v); free(A); free(C);
+}
+
+void aussie_arena_unit_tests()
+{
+	fprintf(stderr, "INFO: %s: Running unit tests\n", __func__);
+	aussie_arena_test_basic();
+	aussie_arena_test_threads();
+	aussie_arena_test_pool_restarts();
+	aussie_arena_test_kernels();
+	aussie_thread_arena_report(stderr);  // High-water marks
+}
+
+//---------------------------------------------------
+//---------------------------------------------------
@@ -0,0 +1,78 @@
+//---------------------------------------------------
+// aarena.h -- Arena (bump) allocator for scratch buffers -- Aussie AI Base Library
+// Created Oct 17th 2026
+// Copyright (c) 2023 Aussie AI Labs Pty Ltd
+//---------------------------------------------------
+
+#ifndef AUSSIE_YARENA_INCLUDE_HEADER_H
+#define AUSSIE_YARENA_INCLUDE_HEADER_H
+
+//---------------------------------------------------
+// Arena: one aligned block, allocation is a pointer bump, and everything is freed at once
+// (aussie_arena_reset, or back to a mark with aussie_arena_release).
+// ... no per-allocation free, no headers, no locking (one arena per thread)
+// ... when the block is full, the extra requests get their own heap blocks ("overflow"),
+//     and the next time the arena is empty the block grows to the high-water mark,
+//     so after a warmup step the same work makes no heap calls at all
+//---------------------------------------------------
+
+#define AUSSIE_ARENA_ALIGN   64              // Default alignment in bytes (one cache line, one AVX-512 register)
+#define AUSSIE_ARENA_THREAD_BYTES (1u << 20)   // Initial size of each thread's arena (grows as needed)
+#define AUSSIE_ARENA_MAX_THREADS  64
+
+struct aussie_arena_overflow;  // Heap block for a request that didn't fit (internal)
+
+struct aussie_arena {
+	char* block;          // The main block (AUSSIE_ARENA_ALIGN aligned)
+	size_t capacity;      // Bytes in the block
+	size_t used;          // Bytes handed out from the block (including alignment padding)
+	size_t live;          // Bytes in use, block plus overflow
+	size_t high_water;    // Most bytes ever in use at once
+	aussie_arena_overflow* overflow;  // Overflow blocks, newest first
+	long long nallocs;    // Allocations from the arena
+	long long nheap;      // Heap calls (block creation, growth, overflow blocks)
+	const char* name;
+};
+
+struct aussie_arena_mark {  // A point to go back to (stack-like scratch)
+	size_t used;
+	size_t live;
+	aussie_arena_overflow* overflow;
+};
+
+bool aussie_arena_init(aussie_arena& a, size_t capacity, const char* name = NULL);
+void aussie_arena_destroy(aussie_arena& a);
+
+void* aussie_arena_alloc(aussie_arena& a, size_t bytes, size_t align = AUSSIE_ARENA_ALIGN);  // Uninitialized (NULL only if out of memory)
+void* aussie_arena_calloc(aussie_arena& a, size_t bytes, size_t align = AUSSIE_ARENA_ALIGN);  // Zeroed
+float* aussie_arena_alloc_floats(aussie_arena& a, long long n);  // Uninitialized, 64-byte aligned
+
+void aussie_arena_reset(aussie_arena& a);  // Free everything (grows the block to the high-water mark if it overflowed)
+aussie_arena_mark aussie_arena_get_mark(const aussie_arena& a);
+void aussie_arena_release(aussie_arena& a, const aussie_arena_mark& mark);  // Free everything allocated since the mark
+
+void aussie_arena_report(FILE* fp, const aussie_arena& a);  // Capacity, high-water mark, heap calls
+
+//---------------------------------------------------
+// Per-thread arenas: each thread (pool workers and callers) gets its own on first use,
+// so kernels inside parallel tasks can take scratch memory without locks.
+// ... kernels use mark/release around their scratch buffers, so the arena is empty between calls
+// ... when a thread exits (e.g. aussie_thread_pool_shutdown) its arena goes back on a free list,
+//     block and all, for the next new thread
+//---------------------------------------------------
+
+aussie_arena* aussie_thread_arena();  // This thread's arena (NULL if more than AUSSIE_ARENA_MAX_THREADS threads at once)
+void aussie_thread_arena_report(FILE* fp);  // Every thread's arena
+size_t aussie_thread_arena_high_water();  // Largest high-water mark of all threads
+long long aussie_thread_arena_heap_calls();  // Heap calls by all thread arenas (stops growing after warmup)
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+void aussie_arena_unit_tests();
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+
+#endif //AUSSIE_YARENA_INCLUDE_HEADER_H
@@ -15,10 +15,10 @@
 
 #include "aport.h"
 
-#if !LINUX  // Don't include the entire file for Linux!
+#if AUSSIE_X86  // Only x86 CPUs have AVX (the whole file is x86-only)
 
+#include <immintrin.h>  // SSE/AVX/AVX-2/AVX-512 intrinsics
 #if !LINUX
-#include <xmmintrin.h>
 #include <intrin.h>
 #endif
 
@@ -29,6 +29,10 @@
 #include "aassert.h"
 #include "atest.h"
 #include "avector.h"
+#include "aactivation.h"
+#include "adispatch.h"
+#include "aexp.h"
+#include "asoftmax.h"
 
 #include "aavx.h"  // self-include
 
@@ -37,10 +41,16 @@
 //---------------------------------------------------
 void aussie_unit_test_avx() // AVX, AVX-2, AVX-512, SSE
 {
+	fprintf(stderr, "INFO: %s: Running unit tests\n", __func__);
+	if (!aussie_cpu_has_avx()) {
+		fprintf(stderr, "INFO: %s: AVX not supported by this CPU, skipping AVX tests\n", __func__);
+		return;
+	}
 	aussie_unit_test_avx1_basics();
+	aussie_test_avx_any_length();
 }
 
-void aussie_avx_multiply_4_floats(float v1[4], float v2[4], float vresult[4])
+AUSSIE_TARGET_AVX1 void aussie_avx_multiply_4_floats(float v1[4], float v2[4], float vresult[4])
 {
 	// Use 128-bit AVX registers to multiply 4x32-bit floats...
 	__m128 r1 = _mm_loadu_ps(v1);   // Load floats into 128-bits
@@ -49,7 +59,7 @@ void aussie_avx_multiply_4_floats(float v1[4], float v2[4], float vresult[4])
 	_mm_storeu_ps(vresult, dst);  // Convert 128-bit to floats
 }
 
-float aussie_avx_vecdot_fma_4_floats(float v1[4], float v2[4])  // AVX1 vecdot using FMA (Fused Multiply-Add) primitives
+AUSSIE_TARGET_AVX1_FMA float aussie_avx_vecdot_fma_4_floats(float v1[4], float v2[4])  // AVX1 vecdot using FMA (Fused Multiply-Add) primitives
 {
 	// Use 128-bit AVX registers to multiply 4x32-bit floats...
 	__m128 r1 = _mm_loadu_ps(v1);   // Load floats into 128-bits
@@ -61,7 +71,7 @@ float aussie_avx_vecdot_fma_4_floats(float v1[4], float v2[4])  // AVX1 vecdot u
 	return sum;
 }
 
-float aussie_avx_vecdot_4_floats(float v1[4], float v2[4]) // AVX-1 (128-bit) dot product
+AUSSIE_TARGET_AVX1 float aussie_avx_vecdot_4_floats(float v1[4], float v2[4]) // AVX-1 (128-bit) dot product
 {
 	// AVX: Vector dot product of 2 vectors of 4x32-bit floats... 128 bit
 	__m128 r1 = _mm_loadu_ps(v1);   // Load floats into 128-bits
@@ -72,7 +82,7 @@ float aussie_avx_vecdot_4_floats(float v1[4], float v2[4]) // AVX-1 (128-bit) do
 }
 
 
-void aussie_avx_multiply_4_floats_aligned(float v1[4], float v2[4], float vresult[4]) // AVX1(128-bit)
+AUSSIE_TARGET_AVX1 void aussie_avx_multiply_4_floats_aligned(float v1[4], float v2[4], float vresult[4]) // AVX1(128-bit)
 {
 	// Use 128-bit AVX-1 registers to multiply 4x32-bit floats...
 	__m128 r1 = _mm_loadu_ps(v1);   // Load floats into 128-bits
@@ -82,7 +92,7 @@ void aussie_avx_multiply_4_floats_aligned(float v1[4], float v2[4], float vresul
 }
 
 
-void aussie_avx2_multiply_8_floats(float v1[8], float v2[8], float vresult[8]) // AVX-2
+AUSSIE_TARGET_AVX2 void aussie_avx2_multiply_8_floats(float v1[8], float v2[8], float vresult[8]) // AVX-2
 {
 	// Use 256-bit AVX2 registers to multiply 8x32-bit floats...
 	__m256 r1 = _mm256_loadu_ps(v1);   // Load floats into 256-bits
@@ -92,7 +102,7 @@ void aussie_avx2_multiply_8_floats(float v1[8], float v2[8], float vresult[8]) /
 }
 
 
-float aussie_avx2_vecdot_8_floats_buggy(float v1[8], float v2[8]) // AVX-2 (256-bit) dot product
+AUSSIE_TARGET_AVX2 float aussie_avx2_vecdot_8_floats_buggy(float v1[8], float v2[8]) // AVX-2 (256-bit) dot product
 {
 	// AVX2 (256-bit): Vector dot product of 2 vectors of 8x32-bit floats
 	__m256 r1 = _mm256_loadu_ps(v1);   // Load floats into 256-bits
@@ -103,7 +113,7 @@ float aussie_avx2_vecdot_8_floats_buggy(float v1[8], float v2[8]) // AVX-2 (256-
 }
 
 
-void aussie_avx512_multiply_16_floats(float v1[16], float v2[16], float vresult[16])
+AUSSIE_TARGET_AVX512 void aussie_avx512_multiply_16_floats(float v1[16], float v2[16], float vresult[16])
 {
 #if AUSSIE_DO_AVX512 // Crashes with unhandled exception/illegal instructions
 	// Use AVX-512's 512-bit registers to multiply 16x32-bit floats...
@@ -114,160 +124,194 @@ void aussie_avx512_multiply_16_floats(float v1[16], float v2[16], float vresult[
 #endif
 }
 
-void aussie_vector_reluize_AVX1(float v[], int n)   // Apply RELU to each element (sets negatives to zero)
+//---------------------------------------------------
+// Vector kernels: any n, any alignment.
+// ... AVX1/AVX2 do whole registers with unaligned loads/stores, then a scalar loop for the leftovers.
+// ... AVX-512 uses a masked load/store for the last partial register instead.
+//---------------------------------------------------
+
+AUSSIE_TARGET_AVX1 void aussie_vector_reluize_AVX1(float v[], int n)   // Apply RELU to each element (sets negatives to zero)
 {
-	if (n % 4 != 0) {
-		yassert(n % 4 == 0);
-		return; // fail
-	}
 	const __m128 rzeros = _mm_set1_ps(0.0f);  // Set up vector full of zeros...
-	for (int i = 0; i < n; i += 4) {
+	int i = 0;
+	for (; i + 4 <= n; i += 4) {
 		__m128 r1 = _mm_loadu_ps(&v[i]);   // Load floats into 128-bits
 		__m128 dst = _mm_max_ps(r1, rzeros);   // MAX(r1,0)
-		_mm_store_ps(&v[i], dst);  // store back to floats
+		_mm_storeu_ps(&v[i], dst);  // store back to floats
 	}
+	for (; i < n; i++) if (v[i] < 0.0f) v[i] = 0.0f;  // Leftovers
 }
 
-void aussie_vector_reluize_AVX2(float v[], int n)  // Apply RELU to each element (sets negatives to zero)
+AUSSIE_TARGET_AVX2 void aussie_vector_reluize_AVX2(float v[], int n)  // Apply RELU to each element (sets negatives to zero)
 {
-	if (n % 8 != 0) {
-		yassert(n % 8 == 0);
-		return; // fail
-	}
 	const __m256 rzeros = _mm256_set1_ps(0.0f);  // vector full of zeros...
-	for (int i = 0; i < n; i += 8) {
+	int i = 0;
+	for (; i + 8 <= n; i += 8) {
 		__m256 r1 = _mm256_loadu_ps(&v[i]);   // Load floats into 256-bits
 		__m256 dst = _mm256_max_ps(r1, rzeros);   // MAX(R1, 0)
-		_mm256_store_ps(&v[i], dst);  // store back to floats
+		_mm256_storeu_ps(&v[i], dst);  // store back to floats
 	}
+	for (; i < n; i++) if (v[i] < 0.0f) v[i] = 0.0f;  // Leftovers
 }
 
-float aussie_vector_max_AVX1(float v[], int n)   // Maximum (horizontal) of a single vector
+AUSSIE_TARGET_AVX1 float aussie_vector_max_AVX1(float v[], int n)   // Maximum (horizontal) of a single vector
 {
-	if (n % 4 != 0) {
-		yassert(n % 4 == 0);
+	if (n <= 0) {
+		yassert(n > 0);
 		return 0.0; // fail
 	}
+	if (n < 4) return aussie_vector_max(v, n);  // Too short for SIMD
 
 	__m128 sumdst = _mm_loadu_ps(&v[0]);   // Initial 4 values
-	for (int i = 4 /*not 0*/; i < n; i += 4) {
+	int i = 4 /*not 0*/;
+	for (; i + 4 <= n; i += 4) {
 		__m128 r1 = _mm_loadu_ps(&v[i]); // Load floats into 128-bits
 		sumdst = _mm_max_ps(r1, sumdst); // dst = MAX(dst, r1)
 	}
 
 	// Find Max of the final 4 accumulators
-	float* farr = sumdst.m128_f32;
+	float* farr = (float*)&sumdst;
 	float fmax = farr[0];
 	if (farr[1] > fmax) fmax = farr[1];
 	if (farr[2] > fmax) fmax = farr[2];
 	if (farr[3] > fmax) fmax = farr[3];
+	for (; i < n; i++) if (v[i] > fmax) fmax = v[i];  // Leftovers
 	return fmax;
 }
 
-float aussie_vector_max_AVX1b(float v[], int n)   // Maximum (horizontal) of a single vector
+AUSSIE_TARGET_AVX1 float aussie_vector_max_AVX1b(float v[], int n)   // Maximum (horizontal) of a single vector
 {
-	yassert(n % 4 == 0);
+	if (n <= 0) {
+		yassert(n > 0);
+		return 0.0; // fail
+	}
+	if (n < 4) return aussie_vector_max(v, n);  // Too short for SIMD
 	__m128 sumdst = _mm_loadu_ps(&v[0]);   // Initial 4 values
-	for (int i = 4 /*not 0*/; i < n; i += 4) {
+	int i = 4 /*not 0*/;
+	for (; i + 4 <= n; i += 4) {
 		__m128 r1 = _mm_loadu_ps(&v[i]); // Load floats into 128-bits
 		sumdst = _mm_max_ps(r1, sumdst); // dst = MAX(dst, r1)
 	}
 
 	// Find Max of the final 4 accumulators
 #define FMAX(x,y)  ( (x) > (y) ? (x) : (y) )
-	float* farr = sumdst.m128_f32;
+	float* farr = (float*)&sumdst;
 	float fmax1 = FMAX(farr[0], farr[1]);
 	float fmax2 = FMAX(farr[2], farr[3]);
 	float fmax = FMAX(fmax1, fmax2);
+	for (; i < n; i++) fmax = FMAX(fmax, v[i]);  // Leftovers
 	return fmax;
 }
 
 
-float aussie_vector_max_min_fusion_AVX1b(float v[], int n, float &fminout)   
+AUSSIE_TARGET_AVX1 float aussie_vector_max_min_fusion_AVX1b(float v[], int n, float &fminout)
 {
 	// Maximum and Minimum (horizontal) of a single vector
-	yassert(n % 4 == 0);
+	if (n <= 0) {
+		yassert(n > 0);
+		fminout = 0.0f;
+		return 0.0; // fail
+	}
+	if (n < 4) {  // Too short for SIMD
+		fminout = aussie_vector_min(v, n);
+		return aussie_vector_max(v, n);
+	}
 	__m128 maxsumdst = _mm_loadu_ps(&v[0]);   // Initial 4 values
 	__m128 minsumdst = maxsumdst;   // Initial 4 values
-	for (int i = 4 /*not 0*/; i < n; i += 4) {
+	int i = 4 /*not 0*/;
+	for (; i + 4 <= n; i += 4) {
 		__m128 r1 = _mm_loadu_ps(&v[i]); // Load floats into 128-bits
 		maxsumdst = _mm_max_ps(r1, maxsumdst); // dst = MAX(dst, r1)
 		minsumdst = _mm_min_ps(r1, minsumdst); // dst = MIN(dst, r1)
 	}
 	// Find Min of the final 4 accumulators
 #define FMIN(x,y)  ( (x) < (y) ? (x) : (y) )
-	float* farr = minsumdst.m128_f32;
+	float* farr = (float*)&minsumdst;
 	float fmin1 = FMIN(farr[0], farr[1]);
 	float fmin2 = FMIN(farr[2], farr[3]);
-	fminout = FMIN(fmin1, fmin2);
+	float fmin = FMIN(fmin1, fmin2);
 	// Find Max of the final 4 accumulators
 #define FMAX(x,y)  ( (x) > (y) ? (x) : (y) )
-	farr = maxsumdst.m128_f32;
+	farr = (float*)&maxsumdst;
 	float fmax1 = FMAX(farr[0], farr[1]);
 	float fmax2 = FMAX(farr[2], farr[3]);
-	return FMAX(fmax1, fmax2); 
+	float fmax = FMAX(fmax1, fmax2);
+	for (; i < n; i++) {  // Leftovers
+		fmin = FMIN(fmin, v[i]);
+		fmax = FMAX(fmax, v[i]);
+	}
+	fminout = fmin;
+	return fmax;
 }
 
-float aussie_vector_min_AVX1(float v[], int n)   // Minimum (horizontal) of a single vector
+AUSSIE_TARGET_AVX1 float aussie_vector_min_AVX1(float v[], int n)   // Minimum (horizontal) of a single vector
 {
-	if (n % 4 != 0) {
-		yassert(n % 4 == 0);
+	if (n <= 0) {
+		yassert(n > 0);
 		return 0.0; // fail
 	}
+	if (n < 4) return aussie_vector_min(v, n);  // Too short for SIMD
 
 	__m128 sumdst = _mm_loadu_ps(&v[0]);   // Initial 4 values
-	for (int i = 4 /*not 0*/; i < n; i += 4) {
+	int i = 4 /*not 0*/;
+	for (; i + 4 <= n; i += 4) {
 		__m128 r1 = _mm_loadu_ps(&v[i]); // Load floats into 128-bits
 		sumdst = _mm_min_ps(r1, sumdst); // dst = MIN(dst, r1)
 	}
 
 	// Find Min of the final 4 accumulators
-	float* farr = sumdst.m128_f32;
+	float* farr = (float*)&sumdst;
 	float fmin = farr[0];
 	if (farr[1] < fmin) fmin = farr[1];
 	if (farr[2] < fmin) fmin = farr[2];
 	if (farr[3] < fmin) fmin = farr[3];
+	for (; i < n; i++) if (v[i] < fmin) fmin = v[i];  // Leftovers
 	return fmin;
 }
 
 
-float aussie_vector_min_AVX1b(float v[], int n)   // Minimum (horizontal) of a single vector
+AUSSIE_TARGET_AVX1 float aussie_vector_min_AVX1b(float v[], int n)   // Minimum (horizontal) of a single vector
 {
-	if (n % 4 != 0) {
-		yassert(n % 4 == 0);
+	if (n <= 0) {
+		yassert(n > 0);
 		return 0.0; // fail
 	}
+	if (n < 4) return aussie_vector_min(v, n);  // Too short for SIMD
 
 	__m128 sumdst = _mm_loadu_ps(&v[0]);   // Initial 4 values
-	for (int i = 4 /*not 0*/; i < n; i += 4) {
+	int i = 4 /*not 0*/;
+	for (; i + 4 <= n; i += 4) {
 		__m128 r1 = _mm_loadu_ps(&v[i]); // Load floats into 128-bits
 		sumdst = _mm_min_ps(r1, sumdst); // dst = MIN(dst, r1)
 	}
 
 	// Find Min of the final 4 accumulators
 #define FMIN(x,y)  ( (x) < (y) ? (x) : (y) )
-	float* farr = sumdst.m128_f32;
+	float* farr = (float*)&sumdst;
 	float fmin1 = FMIN(farr[0], farr[1]);
 	float fmin2 = FMIN(farr[2], farr[3]);
 	float fmin = FMIN(fmin1, fmin2);
+	for (; i < n; i++) fmin = FMIN(fmin, v[i]);  // Leftovers
 	return fmin;
 }
 
 
-float aussie_vector_max_AVX2(float v[], int n)   // Maximum (horizontal) of a single vector
+AUSSIE_TARGET_AVX2 float aussie_vector_max_AVX2(float v[], int n)   // Maximum (horizontal) of a single vector
 {
-	if (n % 8 != 0) { // Safety check (no extra cases)
-		yassert(n % 8 == 0);
+	if (n <= 0) {
+		yassert(n > 0);
 		return 0.0; // fail
 	}
+	if (n < 8) return aussie_vector_max(v, n);  // Too short for SIMD
 	__m256 sumdst = _mm256_loadu_ps(&v[0]);   // Initial 8 values
-	for (int i = 8/*not 0*/; i < n; i += 8) {
+	int i = 8/*not 0*/;
+	for (; i + 8 <= n; i += 8) {
 		__m256 r1 = _mm256_loadu_ps(&v[i]); // Load floats into 256-bits
 		sumdst = _mm256_max_ps(r1, sumdst); // dst = MAX(dst, r1)
 	}
 
 	// Find Max of the final 8 accumulators
-	float* farr = sumdst.m256_f32;
+	float* farr = (float*)&sumdst;
 	float fmax = farr[0];
 	if (farr[1] > fmax) fmax = farr[1];
 	if (farr[2] > fmax) fmax = farr[2];
@@ -276,22 +320,25 @@ float aussie_vector_max_AVX2(float v[], int n)   // Maximum (horizontal) of a si
 	if (farr[5] > fmax) fmax = farr[5];
 	if (farr[6] > fmax) fmax = farr[6];
 	if (farr[7] > fmax) fmax = farr[7];
+	for (; i < n; i++) if (v[i] > fmax) fmax = v[i];  // Leftovers
 	return fmax;
 }
 
-float aussie_vector_min_AVX2(float v[], int n)   // Minimum (horizontal) of a single vector
+AUSSIE_TARGET_AVX2 float aussie_vector_min_AVX2(float v[], int n)   // Minimum (horizontal) of a single vector
 {
-	if (n % 8 != 0) { // Safety check (no extra cases)
-		yassert(n % 8 == 0);
+	if (n <= 0) {
+		yassert(n > 0);
 		return 0.0; // fail
 	}
+	if (n < 8) return aussie_vector_min(v, n);  // Too short for SIMD
 	__m256 sumdst = _mm256_loadu_ps(&v[0]);   // Initial 8 values
-	for (int i = 8/*not 0*/; i < n; i += 8) {
+	int i = 8/*not 0*/;
+	for (; i + 8 <= n; i += 8) {
 		__m256 r1 = _mm256_loadu_ps(&v[i]); // Load floats into 256-bits
 		sumdst = _mm256_min_ps(r1, sumdst); // dst = MIN(dst, r1)
 	}
 	// Find Min of the final 8 accumulators
-	float* farr = sumdst.m256_f32;
+	float* farr = (float*)&sumdst;
 	float fmin = farr[0];
 	if (farr[1] < fmin) fmin = farr[1];
 	if (farr[2] < fmin) fmin = farr[2];
@@ -300,24 +347,27 @@ float aussie_vector_min_AVX2(float v[], int n)   // Minimum (horizontal) of a si
 	if (farr[5] < fmin) fmin = farr[5];
 	if (farr[6] < fmin) fmin = farr[6];
 	if (farr[7] < fmin) fmin = farr[7];
+	for (; i < n; i++) if (v[i] < fmin) fmin = v[i];  // Leftovers
 	return fmin;
 }
 
-float aussie_vector_min_AVX2b(float v[], int n)   // Minimum (horizontal) of a single vector
+AUSSIE_TARGET_AVX2 float aussie_vector_min_AVX2b(float v[], int n)   // Minimum (horizontal) of a single vector
 {
-	if (n % 8 != 0) { // Safety check (no extra cases)
-		yassert(n % 8 == 0);
+	if (n <= 0) {
+		yassert(n > 0);
 		return 0.0; // fail
 	}
+	if (n < 8) return aussie_vector_min(v, n);  // Too short for SIMD
 	__m256 sumdst = _mm256_loadu_ps(&v[0]);   // Initial 8 values
-	for (int i = 8/*not 0*/; i < n; i += 8) {
+	int i = 8/*not 0*/;
+	for (; i + 8 <= n; i += 8) {
 		__m256 r1 = _mm256_loadu_ps(&v[i]); // Load floats into 256-bits
 		sumdst = _mm256_min_ps(r1, sumdst); // dst = MIN(dst, r1)
 	}
 
 	// Find Min of the final 8 accumulators
 #define FMIN(x,y)  ( (x) < (y) ? (x) : (y) )
-	float* farr = sumdst.m256_f32;
+	float* farr = (float*)&sumdst;
 	float fmin1 = FMIN(farr[0], farr[1]); // Quarters
 	float fmin2 = FMIN(farr[2], farr[3]);
 	float fmin3 = FMIN(farr[4], farr[5]);
@@ -325,46 +375,41 @@ float aussie_vector_min_AVX2b(float v[], int n)   // Minimum (horizontal) of a s
 	float fmin1a = FMIN(fmin1, fmin2);  // Semis
 	float fmin2a = FMIN(fmin3, fmin4);
 	float fmin = FMIN(fmin1a, fmin2a);  // Final
+	for (; i < n; i++) fmin = FMIN(fmin, v[i]);  // Leftovers
 	return fmin;
 
 }
 
-float aussie_vector_sum_AVX1(float v[], int n)   // Summation (horizontal) of a single vector
+AUSSIE_TARGET_AVX1 float aussie_vector_sum_AVX1(float v[], int n)   // Summation (horizontal) of a single vector
 {
-	if (n % 4 != 0) {
-		yassert(n % 4 == 0);
-		return 0.0; // fail
-	}
-
 	__m128 sumdst = _mm_setzero_ps();   // Set accumulators to zero
-	for (int i = 0; i < n; i += 4) {
+	int i = 0;
+	for (; i + 4 <= n; i += 4) {
 		__m128 r1 = _mm_loadu_ps(&v[i]); // Load floats into 128-bits
 		sumdst = _mm_add_ps(r1, sumdst); // SUM = SUM + V
 	}
 
 	// Add the final 4 accumulators manually
-	float* farr = sumdst.m128_f32;
+	float* farr = (float*)&sumdst;
 	float sum = farr[0] + farr[1] + farr[2] + farr[3];
+	for (; i < n; i++) sum += v[i];  // Leftovers
 	return sum;
 }
 
-float aussie_vector_sum_AVX2(float v[], int n)   // Summation (horizontal) of a single vector
+AUSSIE_TARGET_AVX2 float aussie_vector_sum_AVX2(float v[], int n)   // Summation (horizontal) of a single vector
 {
-	if (n % 8 != 0) { // Safety check (no extra cases)
-		yassert(n % 8 == 0);
-		return 0.0; // fail
-	}
-
 	__m256 sumdst = _mm256_setzero_ps();   // Set accumulators to zero
-	for (int i = 0; i < n; i += 8) {
+	int i = 0;
+	for (; i + 8 <= n; i += 8) {
 		__m256 r1 = _mm256_loadu_ps(&v[i]);   // Load floats into 256-bits
 		sumdst = _mm256_add_ps(r1, sumdst); // SUM = SUM + V
 	}
 
 	// Add the final 8 accumulators manually
-	float* farr = sumdst.m256_f32;
+	float* farr = (float*)&sumdst;
 	float sum = farr[0] + farr[1] + farr[2] + farr[3]
 		+ farr[4] + farr[5] + farr[6] + farr[7]		;
+	for (; i < n; i++) sum += v[i];  // Leftovers
 	return sum;
 }
 
@@ -377,204 +422,718 @@ float aussie_vector_sum_squares_basic(float v[], int n)  // Summation of squares
 	return sum;
 }
 
-float aussie_vector_sum_squares_AVX1(float v[], int n)  // Summation of squares of all elements
+AUSSIE_TARGET_AVX1 float aussie_vector_sum_squares_AVX1(float v[], int n)  // Summation of squares of all elements
 {
-	if (n % 4 != 0) { // Safety check (no extra cases)
-		yassert(n % 4 == 0);
-		return 0.0; // fail
-	}
 	__m128 sumdst = _mm_setzero_ps();   // Set accumulators to zero
-	for (int i = 0; i < n; i += 4) {
+	int i = 0;
+	for (; i + 4 <= n; i += 4) {
 		__m128 r1 = _mm_loadu_ps(&v[i]); // Load floats into 128-bits
 		__m128 sqr = _mm_mul_ps(r1, r1);   // Square (V*V)
 		sumdst = _mm_add_ps(sqr, sumdst); // SUM = SUM + V*V
 	}
 	// Add the final 4 accumulators manually
-	float* farr = sumdst.m128_f32;
+	float* farr = (float*)&sumdst;
 	float sum = farr[0] + farr[1] + farr[2] + farr[3];
+	for (; i < n; i++) sum += v[i] * v[i];  // Leftovers
 	return sum;
 }
 
-float aussie_vector_sum_squares_AVX2(float v[], int n)  // Summation of squares of all elements
+AUSSIE_TARGET_AVX2 float aussie_vector_sum_squares_AVX2(float v[], int n)  // Summation of squares of all elements
 {
-	if (n % 8 != 0) { // Safety check (no extra cases)
-		yassert(n % 8 == 0);
-		return 0.0; // fail
-	}
-
 	__m256 sumdst = _mm256_setzero_ps();   // Set accumulators to zero
-	for (int i = 0; i < n; i += 8) {
+	int i = 0;
+	for (; i + 8 <= n; i += 8) {
 		__m256 r1 = _mm256_loadu_ps(&v[i]);   // Load floats into 256-bits
 		__m256 sqr = _mm256_mul_ps(r1, r1);   // Square (V*V)
 		sumdst = _mm256_add_ps(sqr, sumdst); // SUM = SUM + V*V
 	}
 
 	// Add the final 8 accumulators manually
-	float* farr = sumdst.m256_f32;
+	float* farr = (float*)&sumdst;
 	float sum = farr[0] + farr[1] + farr[2] + farr[3]
 		+ farr[4] + farr[5] + farr[6] + farr[7];
+	for (; i < n; i++) sum += v[i] * v[i];  // Leftovers
 	return sum;
 }
 
 
-float aussie_vector_sum_diff_squared_fused_AVX1(float v[], int n, float meanval)
+AUSSIE_TARGET_AVX1 float aussie_vector_sum_diff_squared_fused_AVX1(float v[], int n, float meanval)
 {
 	// Fused version of "sum diff squared" that leaves the DIFF in the vector...
-	if (n % 4 != 0) { // Safety check (no extra cases)
-		yassert(n % 4 == 0);
-		return 0.0; // fail
-	}
 	__m128 sumdst = _mm_setzero_ps();   // Set accumulators to zero
 	const __m128 vmean = _mm_set1_ps(-meanval);  // Set up the negated mean values..
-	for (int i = 0; i < n; i += 4) {
+	int i = 0;
+	for (; i + 4 <= n; i += 4) {
 		__m128 r1 = _mm_loadu_ps(&v[i]); // Load V[i] floats into 128-bits
 		__m128 rdiff = _mm_add_ps(r1, vmean); // DIFF = V[i] - MEAN
-		_mm_store_ps(&v[i], rdiff);  // V[i] = DIFF (store diffs back)
+		_mm_storeu_ps(&v[i], rdiff);  // V[i] = DIFF (store diffs back)
 		__m128 sqr = _mm_mul_ps(rdiff, rdiff);   // Square (V*V)
 		sumdst = _mm_add_ps(sqr, sumdst); // SUM = SUM + V*V
 	}
 	// Add the final 4 accumulators manually
-	float* farr = sumdst.m128_f32;
+	float* farr = (float*)&sumdst;
 	float sum = farr[0] + farr[1] + farr[2] + farr[3];
+	for (; i < n; i++) {  // Leftovers
+		v[i] -= meanval;
+		sum += v[i] * v[i];
+	}
 	return sum;
 }
 
-float aussie_vector_sum_diff_squared_fused_AVX2(float v[], int n, float meanval)
+AUSSIE_TARGET_AVX2 float aussie_vector_sum_diff_squared_fused_AVX2(float v[], int n, float meanval)
 {
 	// Fused version of "sum diff squared" that leaves the DIFF in the vector..
-	if (n % 8 != 0) { // Safety check (no extra cases)
-		yassert(n % 8 == 0);
-		return 0.0; // fail
-	}
 	__m256 sumdst = _mm256_setzero_ps();   // Set accumulators to zero
 	const __m256 vmean = _mm256_set1_ps(-meanval);  // Set up the negated mean values..
-	for (int i = 0; i < n; i += 8) {
+	int i = 0;
+	for (; i + 8 <= n; i += 8) {
 		__m256 r1 = _mm256_loadu_ps(&v[i]); // Load V[i] floats into 128-bits
 		__m256 rdiff = _mm256_add_ps(r1, vmean); // DIFF = V[i] - MEAN
-		_mm256_store_ps(&v[i], rdiff);  // V[i] = DIFF (store diffs back)
+		_mm256_storeu_ps(&v[i], rdiff);  // V[i] = DIFF (store diffs back)
 		__m256 sqr = _mm256_mul_ps(rdiff, rdiff);   // Square (V*V)
 		sumdst = _mm256_add_ps(sqr, sumdst); // SUM = SUM + V*V
 	}
 	// Add the final 8 accumulators manually
-	float* farr = sumdst.m256_f32;
+	float* farr = (float*)&sumdst;
 	float sum = farr[0] + farr[1] + farr[2] + farr[3]
 		+ farr[4] + farr[5] + farr[6] + farr[7];
+	for (; i < n; i++) {  // Leftovers
+		v[i] -= meanval;
+		sum += v[i] * v[i];
+	}
 	return sum;
 }
 
-float aussie_vector_fused_expf_sum_AVX2(float v[], int n)   // Fused EXPF and SUMMATION of a single vector
+AUSSIE_TARGET_AVX2 float aussie_vector_fused_expf_sum_AVX2(float v[], int n)   // Fused EXPF and SUMMATION of a single vector
 {
-	if (n % 8 != 0) { // Safety check (no extra cases)
-		yassert(n % 8 == 0);
-		return 0.0; // fail
-	}
 	__m256 sumdst = _mm256_setzero_ps();   // Set accumulators to zero
-	for (int i = 0; i < n; i += 8) {
+	int i = 0;
+	for (; i + 8 <= n; i += 8) {
 		__m256 r1 = _mm256_loadu_ps(&v[i]);   // Load floats into 256-bits
-		__m256 expdst = _mm256_exp_ps(r1);    // Exponentiate (expf)
+		__m256 expdst = aussie_exp_ps_AVX2(r1);    // Exponentiate (expf)
+		_mm256_storeu_ps(&v[i], expdst);  // Store back (softmax needs the expf values)
 		sumdst = _mm256_add_ps(expdst, sumdst); // SUM = SUM + V
 	}
 	// Add the final 8 accumulators manually
-	float* farr = sumdst.m256_f32;
+	float* farr = (float*)&sumdst;
 	float sum = farr[0] + farr[1] + farr[2] + farr[3]
 		+ farr[4] + farr[5] + farr[6] + farr[7];
+	for (; i < n; i++) {  // Leftovers
+		v[i] = expf(v[i]);
+		sum += v[i];
+	}
 	return sum;
 }
 
 
-float aussie_vector_fused_expf_sum_AVX1(float v[], int n)   // Apply EXPF (exponential) to each element and SUM them too
+AUSSIE_TARGET_AVX2 aussie_softmax_partial aussie_softmax_online_partial_AVX2(const float v[], int n)  // Online softmax read pass
+{
+	// Per-lane running max and sum; the sums are rescaled only when some lane's max grows
+	__m256 vmax = _mm256_set1_ps(AUSSIE_SOFTMAX_NO_MAX);
+	__m256 vsum = _mm256_setzero_ps();
+	int i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 x = _mm256_loadu_ps(&v[i]);
+		__m256 newmax = _mm256_max_ps(vmax, x);
+		if (_mm256_movemask_ps(_mm256_cmp_ps(newmax, vmax, _CMP_GT_OQ)) != 0) {
+			vsum = _mm256_mul_ps(vsum, aussie_exp_ps_AVX2(_mm256_sub_ps(vmax, newmax)));
+			vmax = newmax;
+		}
+		vsum = _mm256_add_ps(vsum, aussie_exp_ps_AVX2(_mm256_sub_ps(x, vmax)));
+	}
+	// Merge the 8 lanes
+	float* farrmax = (float*)&vmax;
+	float* farrsum = (float*)&vsum;
+	aussie_softmax_partial p = { farrmax[0], farrsum[0] };
+	for (int k = 1; k < 8; k++) {
+		aussie_softmax_partial plane = { farrmax[k], farrsum[k] };
+		p = aussie_softmax_partial_merge(p, plane);
+	}
+	for (; i < n; i++) {  // Leftovers
+		if (v[i] > p.fmax) {
+			p.fsum = p.fsum * expf(p.fmax - v[i]) + 1.0f;
+			p.fmax = v[i];
+		}
+		else {
+			p.fsum += expf(v[i] - p.fmax);
+		}
+	}
+	return p;
+}
+
+AUSSIE_TARGET_AVX2 void aussie_softmax_online_finish_AVX2(float v[], int n, aussie_softmax_partial p)  // Online softmax write pass
+{
+	float recip = 1.0f / p.fsum;
+	__m256 vmax = _mm256_set1_ps(p.fmax);
+	__m256 vrecip = _mm256_set1_ps(recip);
+	int i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 x = _mm256_loadu_ps(&v[i]);
+		_mm256_storeu_ps(&v[i], _mm256_mul_ps(aussie_exp_ps_AVX2(_mm256_sub_ps(x, vmax)), vrecip));
+	}
+	for (; i < n; i++) {  // Leftovers
+		v[i] = expf(v[i] - p.fmax) * recip;
+	}
+}
+
+AUSSIE_TARGET_AVX1 float aussie_vector_fused_expf_sum_AVX1(float v[], int n)   // Apply EXPF (exponential) to each element and SUM them too
 {
 	// Fused EXPF and SUM operators...
-	yassert(n % 4 == 0);  // Safety
 	__m128 sumdst = _mm_setzero_ps();   // Set accumulators to zero
-	for (int i = 0; i < n; i += 4) {
+	int i = 0;
+	for (; i + 4 <= n; i += 4) {
 		__m128 r1 = _mm_loadu_ps(&v[i]);   // Load floats into 128-bits
-		__m128 dstexp = _mm_exp_ps(r1);   // Exponentiate (expf)
-		_mm_store_ps(&v[i], dstexp);  // store as floats
+		__m128 dstexp = aussie_exp_ps_AVX1(r1);   // Exponentiate (expf)
+		_mm_storeu_ps(&v[i], dstexp);  // store as floats
 		sumdst = _mm_add_ps(dstexp, sumdst); // SUM = SUM + V
 	}
 	// Add the final 4 accumulators manually
-	float* farr = sumdst.m128_f32;
+	float* farr = (float*)&sumdst;
 	float sum = farr[0] + farr[1] + farr[2] + farr[3];
+	for (; i < n; i++) {  // Leftovers
+		v[i] = expf(v[i]);
+		sum += v[i];
+	}
 	return sum;
 }
 
-void aussie_vector_expf_AVX1(float v[], int n)   // Apply EXPF (exponential) to each element
+AUSSIE_TARGET_AVX1 void aussie_vector_expf_AVX1(float v[], int n)   // Apply EXPF (exponential) to each element
 {
-	yassert(n % 4 == 0);
-
-	for (int i = 0; i < n; i += 4) {
+	int i = 0;
+	for (; i + 4 <= n; i += 4) {
 		__m128 r1 = _mm_loadu_ps(&v[i]);   // Load floats into 128-bits
-		__m128 dst = _mm_exp_ps(r1);   // Exponentiate (expf)
-		_mm_store_ps(&v[i], dst);  // convert to floats (Aligned version)
+		__m128 dst = aussie_exp_ps_AVX1(r1);   // Exponentiate (expf)
+		_mm_storeu_ps(&v[i], dst);  // convert to floats
 	}
+	for (; i < n; i++) v[i] = expf(v[i]);  // Leftovers
 }
 
-void aussie_vector_expf_AVX2(float v[], int n)  // Apply EXPF (exponential) to each element
+AUSSIE_TARGET_AVX2 void aussie_vector_expf_AVX2(float v[], int n)  // Apply EXPF (exponential) to each element
 {
-	yassert(n % 8 == 0);
-
-	for (int i = 0; i < n; i += 8) {
+	int i = 0;
+	for (; i + 8 <= n; i += 8) {
 		__m256 r1 = _mm256_loadu_ps(&v[i]);   // Load floats into 256-bits
-		__m256 dst = _mm256_exp_ps(r1);    // Exponentiate (expf)
-		_mm256_store_ps(&v[i], dst);  // store back to floats
+		__m256 dst = aussie_exp_ps_AVX2(r1);    // Exponentiate (expf)
+		_mm256_storeu_ps(&v[i], dst);  // store back to floats
+	}
+	for (; i < n; i++) v[i] = expf(v[i]);  // Leftovers
+}
+
+//---------------------------------------------------
+// Activation kernels (whole FFN vectors): one SIMD expf and a division per element (aexp.h)
+//---------------------------------------------------
+
+AUSSIE_TARGET_AVX2 void aussie_vector_sigmoid_AVX2(float v[], int n)   // 1 / (1 + e^-x)
+{
+	int i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 r1 = _mm256_loadu_ps(&v[i]);
+		_mm256_storeu_ps(&v[i], aussie_sigmoid_ps_AVX2(r1));
 	}
+	aussie_vector_sigmoid(&v[i], n - i);  // Leftovers
 }
 
+AUSSIE_TARGET_AVX2 void aussie_vector_SiLU_AVX2(float v[], int n)   // x * sigmoid(x)
+{
+	int i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 r1 = _mm256_loadu_ps(&v[i]);
+		_mm256_storeu_ps(&v[i], aussie_div_1_plus_exp_neg_ps_AVX2(r1, r1));
+	}
+	aussie_vector_SiLU(&v[i], n - i);  // Leftovers
+}
+
+AUSSIE_TARGET_AVX2 void aussie_vector_GELU_tanh_AVX2(float v[], int n)   // GELU tanh approximation
+{
+	int i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 r1 = _mm256_loadu_ps(&v[i]);
+		_mm256_storeu_ps(&v[i], aussie_GELU_tanh_ps_AVX2(r1));
+	}
+	aussie_vector_GELU_tanh(&v[i], n - i);  // Leftovers
+}
 
-void aussie_vector_add_scalar_AVX1(float v[], int n, float c)   // Add scalar constant to all vector elements
+AUSSIE_TARGET_AVX2 void aussie_vector_GELU_sigmoid_AVX2(float v[], int n)   // x * sigmoid(1.702 * x)
+{
+	const __m256 rc = _mm256_set1_ps(AUSSIE_GELU_SIGMOID_C);
+	int i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 r1 = _mm256_loadu_ps(&v[i]);
+		_mm256_storeu_ps(&v[i], aussie_div_1_plus_exp_neg_ps_AVX2(r1, _mm256_mul_ps(r1, rc)));
+	}
+	aussie_vector_GELU_sigmoid(&v[i], n - i);  // Leftovers
+}
+
+AUSSIE_TARGET_AVX1 void aussie_vector_add_scalar_AVX1(float v[], int n, float c)   // Add scalar constant to all vector elements
 {
 	const __m128 rscalar = _mm_set1_ps(c);  // Set up vector full of scalars...
-	for (int i = 0; i < n; i += 4) {
+	int i = 0;
+	for (; i + 4 <= n; i += 4) {
 		__m128 r1 = _mm_loadu_ps(&v[i]);   // Load floats into 128-bits
 		__m128 dst = _mm_add_ps(r1, rscalar);   // Add scalars
-		_mm_store_ps(&v[i], dst);  // store back to floats
+		_mm_storeu_ps(&v[i], dst);  // store back to floats
 	}
+	for (; i < n; i++) v[i] += c;  // Leftovers
 }
 
 
-void aussie_vector_add_scalar_AVX2(float v[], int n, float c)  // Add scalar constant to all vector elements
+AUSSIE_TARGET_AVX2 void aussie_vector_add_scalar_AVX2(float v[], int n, float c)  // Add scalar constant to all vector elements
 {
 	const __m256 rscalar = _mm256_set1_ps(c);  // vector full of scalars...
-	for (int i = 0; i < n; i += 8) {
+	int i = 0;
+	for (; i + 8 <= n; i += 8) {
 		__m256 r1 = _mm256_loadu_ps(&v[i]);   // Load floats into 256-bits
 		__m256 dst = _mm256_add_ps(r1, rscalar);   // Add scalars
-		_mm256_store_ps(&v[i], dst);  // convert to floats (Aligned version)
+		_mm256_storeu_ps(&v[i], dst);  // convert to floats
 	}
+	for (; i < n; i++) v[i] += c;  // Leftovers
 }
 
 
-void aussie_vector_multiply_scalar_AVX1(float v[], int n, float c)  // Multiply all vector elements by constant
+AUSSIE_TARGET_AVX1 void aussie_vector_multiply_scalar_AVX1(float v[], int n, float c)  // Multiply all vector elements by constant
 {
 	const __m128 rscalar = _mm_set1_ps(c);  // Set up vector full of scalars...
-	for (int i = 0; i < n; i += 4) {
+	int i = 0;
+	for (; i + 4 <= n; i += 4) {
 		__m128 r1 = _mm_loadu_ps(&v[i]);   // Load floats into 128-bits
 		__m128 dst = _mm_mul_ps(r1, rscalar);   // Multiply by scalars
-		_mm_store_ps(&v[i], dst);  // convert to floats (Aligned version)
+		_mm_storeu_ps(&v[i], dst);  // convert to floats
 	}
+	for (; i < n; i++) v[i] *= c;  // Leftovers
 }
 
 
 
 
-void aussie_vector_multiply_scalar_AVX2(float v[], int n, float c)  // Multiply all vector elements by constant
+AUSSIE_TARGET_AVX2 void aussie_vector_multiply_scalar_AVX2(float v[], int n, float c)  // Multiply all vector elements by constant
 {
 	const __m256 rscalar = _mm256_set1_ps(c);  // vector full of scalars...
-	for (int i = 0; i < n; i += 8) {
+	int i = 0;
+	for (; i + 8 <= n; i += 8) {
 		__m256 r1 = _mm256_loadu_ps(&v[i]);   // Load floats into 256-bits
 		__m256 dst = _mm256_mul_ps(r1, rscalar);   // Multiply by scalars
-		_mm256_store_ps(&v[i], dst);  // convert to floats (Aligned version)
+		_mm256_storeu_ps(&v[i], dst);  // convert to floats
 	}
+	for (; i < n; i++) v[i] *= c;  // Leftovers
 }
 
 
-void aussie_vector_multiply_scalar_AVX2_pointer_arith(float v[], int n, float c)  // Multiply all vector elements by constant
+AUSSIE_TARGET_AVX2 void aussie_vector_multiply_scalar_AVX2_pointer_arith(float v[], int n, float c)  // Multiply all vector elements by constant
 {
 	const __m256 rscalar = _mm256_set1_ps(c);  // vector full of scalars...
-	for (; n > 0; n -= 8, v += 8) {
+	for (; n >= 8; n -= 8, v += 8) {
 		__m256 r1 = _mm256_loadu_ps(v);   // Load floats into 256-bits
 		__m256 dst = _mm256_mul_ps(r1, rscalar);   // Multiply by scalars
-		_mm256_store_ps(v, dst);  // convert to floats (Aligned version)
+		_mm256_storeu_ps(v, dst);  // convert to floats
+	}
+	for (; n > 0; n--, v++) *v *= c;  // Leftovers
+}
+
+AUSSIE_TARGET_AVX2 int aussie_vector_indices_ge_AVX2(const float v[], int n, float threshold, int indices_out[], int maxout)  // Indices of v[i] >= threshold (-1 if more than maxout)
+{
+	const __m256 rthreshold = _mm256_set1_ps(threshold);
+	int nout = 0;
+	int i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 r1 = _mm256_loadu_ps(&v[i]);   // Load floats into 256-bits
+		int mask = _mm256_movemask_ps(_mm256_cmp_ps(r1, rthreshold, _CMP_GE_OQ));  // 8 bits, one per lane
+		if (mask == 0) continue;  // Usual case: nothing here
+		for (int b = 0; b < 8; b++) {
+			if (mask & (1 << b)) {
+				if (nout >= maxout) return -1;  // fail (too many)
+				indices_out[nout++] = i + b;
+			}
+		}
+	}
+	for (; i < n; i++) {  // Leftovers
+		if (v[i] >= threshold) {
+			if (nout >= maxout) return -1;  // fail (too many)
+			indices_out[nout++] = i;
+		}
+	}
+	return nout;
+}
+
+AUSSIE_TARGET_AVX2 float aussie_fma_peak_AVX2(long niter)  // Peak FMA throughput (registers only): 10 x 8 x 2 FLOPs per iteration
+{
+	// 10 independent accumulators cover the FMA latency (4 cycles x 2 ports)
+	__m256 mul = _mm256_set1_ps(0.999999f);
+	__m256 add = _mm256_set1_ps(1.0e-6f);   // Stays near 1.0 (no overflow or denormals)
+	__m256 a0 = _mm256_set1_ps(1.0f), a1 = _mm256_set1_ps(1.1f), a2 = _mm256_set1_ps(1.2f), a3 = _mm256_set1_ps(1.3f);
+	__m256 a4 = _mm256_set1_ps(1.4f), a5 = _mm256_set1_ps(1.5f), a6 = _mm256_set1_ps(1.6f), a7 = _mm256_set1_ps(1.7f);
+	__m256 a8 = _mm256_set1_ps(1.8f), a9 = _mm256_set1_ps(1.9f);
+	for (long i = 0; i < niter; i++) {
+		a0 = _mm256_fmadd_ps(a0, mul, add);
+		a1 = _mm256_fmadd_ps(a1, mul, add);
+		a2 = _mm256_fmadd_ps(a2, mul, add);
+		a3 = _mm256_fmadd_ps(a3, mul, add);
+		a4 = _mm256_fmadd_ps(a4, mul, add);
+		a5 = _mm256_fmadd_ps(a5, mul, add);
+		a6 = _mm256_fmadd_ps(a6, mul, add);
+		a7 = _mm256_fmadd_ps(a7, mul, add);
+		a8 = _mm256_fmadd_ps(a8, mul, add);
+		a9 = _mm256_fmadd_ps(a9, mul, add);
+	}
+	a0 = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(a0, a1), _mm256_add_ps(a2, a3)), _mm256_add_ps(a4, a5));
+	a0 = _mm256_add_ps(a0, _mm256_add_ps(_mm256_add_ps(a6, a7), _mm256_add_ps(a8, a9)));
+	float farr[8];
+	_mm256_storeu_ps(farr, a0);
+	return farr[0] + farr[1] + farr[2] + farr[3] + farr[4] + farr[5] + farr[6] + farr[7];  // So the loop isn't optimized away
+}
+
+//---------------------------------------------------
+// AVX-512 kernels (16 floats in 512-bits)
+// ... Only call these if aussie_cpu_has_avx512() is true
+// ... The last partial block uses a mask (no scalar tail loop)
+//---------------------------------------------------
+
+#define AUSSIE_AVX512_TAIL_MASK(nleft) \
+	( (nleft) >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << (nleft)) - 1u) )  // Lanes still in range
+
+AUSSIE_TARGET_AVX512 void aussie_vector_expf_AVX512(float v[], int n)  // Apply EXPF (exponential) to each element
+{
+	for (int i = 0; i < n; i += 16) {
+		__mmask16 mask = AUSSIE_AVX512_TAIL_MASK(n - i);
+		__m512 r1 = _mm512_maskz_loadu_ps(mask, &v[i]);   // Load floats into 512-bits
+		__m512 dst = aussie_exp_ps_AVX512(r1);    // Exponentiate (expf)
+		_mm512_mask_storeu_ps(&v[i], mask, dst);  // store back to floats
+	}
+}
+
+AUSSIE_TARGET_AVX512 void aussie_vector_sigmoid_AVX512(float v[], int n)   // 1 / (1 + e^-x)
+{
+	for (int i = 0; i < n; i += 16) {
+		__mmask16 mask = AUSSIE_AVX512_TAIL_MASK(n - i);
+		__m512 r1 = _mm512_maskz_loadu_ps(mask, &v[i]);
+		_mm512_mask_storeu_ps(&v[i], mask, aussie_sigmoid_ps_AVX512(r1));
+	}
+}
+
+AUSSIE_TARGET_AVX512 void aussie_vector_SiLU_AVX512(float v[], int n)   // x * sigmoid(x)
+{
+	for (int i = 0; i < n; i += 16) {
+		__mmask16 mask = AUSSIE_AVX512_TAIL_MASK(n - i);
+		__m512 r1 = _mm512_maskz_loadu_ps(mask, &v[i]);
+		_mm512_mask_storeu_ps(&v[i], mask, aussie_div_1_plus_exp_neg_ps_AVX512(r1, r1));
+	}
+}
+
+AUSSIE_TARGET_AVX512 void aussie_vector_GELU_tanh_AVX512(float v[], int n)   // GELU tanh approximation
+{
+	for (int i = 0; i < n; i += 16) {
+		__mmask16 mask = AUSSIE_AVX512_TAIL_MASK(n - i);
+		__m512 r1 = _mm512_maskz_loadu_ps(mask, &v[i]);
+		_mm512_mask_storeu_ps(&v[i], mask, aussie_GELU_tanh_ps_AVX512(r1));
+	}
+}
+
+AUSSIE_TARGET_AVX512 void aussie_vector_GELU_sigmoid_AVX512(float v[], int n)   // x * sigmoid(1.702 * x)
+{
+	const __m512 rc = _mm512_set1_ps(AUSSIE_GELU_SIGMOID_C);
+	for (int i = 0; i < n; i += 16) {
+		__mmask16 mask = AUSSIE_AVX512_TAIL_MASK(n - i);
+		__m512 r1 = _mm512_maskz_loadu_ps(mask, &v[i]);
+		_mm512_mask_storeu_ps(&v[i], mask, aussie_div_1_plus_exp_neg_ps_AVX512(r1, _mm512_mul_ps(r1, rc)));
+	}
+}
+
+AUSSIE_TARGET_AVX512 float aussie_vector_fused_expf_sum_AVX512(float v[], int n)   // Fused EXPF and SUMMATION of a single vector
+{
+	__m512 sumdst = _mm512_setzero_ps();   // Set accumulators to zero
+	for (int i = 0; i < n; i += 16) {
+		__mmask16 mask = AUSSIE_AVX512_TAIL_MASK(n - i);
+		__m512 r1 = _mm512_maskz_loadu_ps(mask, &v[i]);   // Load floats into 512-bits
+		__m512 expdst = aussie_exp_ps_AVX512(r1);    // Exponentiate (expf)
+		_mm512_mask_storeu_ps(&v[i], mask, expdst);  // Store back (softmax needs the expf values)
+		sumdst = _mm512_mask_add_ps(sumdst, mask, expdst, sumdst); // SUM = SUM + V (not the expf(0) padding)
+	}
+	return _mm512_reduce_add_ps(sumdst);  // Add the final 16 accumulators
+}
+
+AUSSIE_TARGET_AVX512 aussie_softmax_partial aussie_softmax_online_partial_AVX512(const float v[], int n)  // Online softmax read pass
+{
+	// Per-lane running max and sum; the sums are rescaled only when some lane's max grows
+	__m512 vmax = _mm512_set1_ps(AUSSIE_SOFTMAX_NO_MAX);
+	__m512 vsum = _mm512_setzero_ps();
+	for (int i = 0; i < n; i += 16) {
+		__mmask16 mask = AUSSIE_AVX512_TAIL_MASK(n - i);
+		__m512 x = _mm512_mask_loadu_ps(vmax, mask, &v[i]);  // Lanes past the end keep their max
+		__m512 newmax = _mm512_max_ps(vmax, x);
+		if (_mm512_cmp_ps_mask(newmax, vmax, _CMP_GT_OQ) != 0) {
+			vsum = _mm512_mul_ps(vsum, aussie_exp_ps_AVX512(_mm512_sub_ps(vmax, newmax)));
+			vmax = newmax;
+		}
+		vsum = _mm512_mask_add_ps(vsum, mask, vsum, aussie_exp_ps_AVX512(_mm512_sub_ps(x, vmax)));
+	}
+	// Merge the 16 lanes: rescale each lane's sum to the overall max
+	aussie_softmax_partial p;
+	p.fmax = _mm512_reduce_max_ps(vmax);
+	vsum = _mm512_mul_ps(vsum, aussie_exp_ps_AVX512(_mm512_sub_ps(vmax, _mm512_set1_ps(p.fmax))));
+	p.fsum = _mm512_reduce_add_ps(vsum);
+	return p;
+}
+
+AUSSIE_TARGET_AVX512 void aussie_softmax_online_finish_AVX512(float v[], int n, aussie_softmax_partial p)  // Online softmax write pass
+{
+	__m512 vmax = _mm512_set1_ps(p.fmax);
+	__m512 vrecip = _mm512_set1_ps(1.0f / p.fsum);
+	for (int i = 0; i < n; i += 16) {
+		__mmask16 mask = AUSSIE_AVX512_TAIL_MASK(n - i);
+		__m512 x = _mm512_maskz_loadu_ps(mask, &v[i]);
+		_mm512_mask_storeu_ps(&v[i], mask, _mm512_mul_ps(aussie_exp_ps_AVX512(_mm512_sub_ps(x, vmax)), vrecip));
+	}
+}
+
+AUSSIE_TARGET_AVX512 float aussie_vecdot_FMA_unroll_AVX512(const float v1[], const float v2[], int n)   // AVX-512 vecdot using FMA
+{
+	__m512 sumdst = _mm512_setzero_ps();   // Set 16 accumulators to zero
+	for (int i = 0; i < n; i += 16) {
+		__mmask16 mask = AUSSIE_AVX512_TAIL_MASK(n - i);
+		__m512 r1 = _mm512_maskz_loadu_ps(mask, &v1[i]);   // Load floats into 512-bits (zeros past the end)
+		__m512 r2 = _mm512_maskz_loadu_ps(mask, &v2[i]);
+		sumdst = _mm512_fmadd_ps(r1, r2, sumdst); // FMA of 3 vectors
+	}
+	return _mm512_reduce_add_ps(sumdst);  // Horizontal add of the 16 accumulators
+}
+
+AUSSIE_TARGET_AVX512 float aussie_vector_sum_AVX512(float v[], int n)   // Summation (horizontal) of a single vector
+{
+	__m512 sumdst = _mm512_setzero_ps();   // Set accumulators to zero
+	for (int i = 0; i < n; i += 16) {
+		__m512 r1 = _mm512_maskz_loadu_ps(AUSSIE_AVX512_TAIL_MASK(n - i), &v[i]);   // Load floats into 512-bits
+		sumdst = _mm512_add_ps(r1, sumdst); // SUM = SUM + V
+	}
+	return _mm512_reduce_add_ps(sumdst);
+}
+
+AUSSIE_TARGET_AVX512 float aussie_vector_max_AVX512(float v[], int n)   // Maximum (horizontal) of a single vector
+{
+	if (n <= 0) {
+		yassert(n > 0);
+		return 0.0; // fail
+	}
+	__m512 maxdst = _mm512_set1_ps(v[0]);   // Initial values
+	for (int i = 0; i < n; i += 16) {
+		// Masked-off lanes keep the old maximums
+		__m512 r1 = _mm512_mask_loadu_ps(maxdst, AUSSIE_AVX512_TAIL_MASK(n - i), &v[i]); // Load floats into 512-bits
+		maxdst = _mm512_max_ps(r1, maxdst); // dst = MAX(dst, r1)
+	}
+	return _mm512_reduce_max_ps(maxdst);  // Max of the final 16 values
+}
+
+AUSSIE_TARGET_AVX512 float aussie_vector_min_AVX512(float v[], int n)   // Minimum (horizontal) of a single vector
+{
+	if (n <= 0) {
+		yassert(n > 0);
+		return 0.0; // fail
+	}
+	__m512 mindst = _mm512_set1_ps(v[0]);   // Initial values
+	for (int i = 0; i < n; i += 16) {
+		// Masked-off lanes keep the old minimums
+		__m512 r1 = _mm512_mask_loadu_ps(mindst, AUSSIE_AVX512_TAIL_MASK(n - i), &v[i]); // Load floats into 512-bits
+		mindst = _mm512_min_ps(r1, mindst); // dst = MIN(dst, r1)
+	}
+	return _mm512_reduce_min_ps(mindst);  // Min of the final 16 values
+}
+
+AUSSIE_TARGET_AVX512 void aussie_vector_multiply_scalar_AVX512(float v[], int n, float c)  // Multiply all vector elements by constant
+{
+	const __m512 rscalar = _mm512_set1_ps(c);  // vector full of scalars...
+	for (int i = 0; i < n; i += 16) {
+		__mmask16 mask = AUSSIE_AVX512_TAIL_MASK(n - i);
+		__m512 r1 = _mm512_maskz_loadu_ps(mask, &v[i]);   // Load floats into 512-bits
+		__m512 dst = _mm512_mul_ps(r1, rscalar);   // Multiply by scalars
+		_mm512_mask_storeu_ps(&v[i], mask, dst);  // store back to floats
+	}
+}
+
+AUSSIE_TARGET_AVX512 void aussie_vector_reluize_AVX512(float v[], int n)  // Apply RELU to each element (sets negatives to zero)
+{
+	const __m512 rzeros = _mm512_setzero_ps();  // vector full of zeros...
+	for (int i = 0; i < n; i += 16) {
+		__mmask16 mask = AUSSIE_AVX512_TAIL_MASK(n - i);
+		__m512 r1 = _mm512_maskz_loadu_ps(mask, &v[i]);   // Load floats into 512-bits
+		__m512 dst = _mm512_max_ps(r1, rzeros);   // MAX(R1, 0)
+		_mm512_mask_storeu_ps(&v[i], mask, dst);  // store back to floats
+	}
+}
+
+AUSSIE_TARGET_AVX512 int aussie_vector_indices_ge_AVX512(const float v[], int n, float threshold, int indices_out[], int maxout)  // Indices of v[i] >= threshold (-1 if more than maxout)
+{
+	const __m512 rthreshold = _mm512_set1_ps(threshold);
+	const __m512i rsixteen = _mm512_set1_epi32(16);
+	__m512i rindex = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	int nout = 0;
+	for (int i = 0; i < n; i += 16, rindex = _mm512_add_epi32(rindex, rsixteen)) {
+		__mmask16 mask = AUSSIE_AVX512_TAIL_MASK(n - i);
+		__m512 r1 = _mm512_maskz_loadu_ps(mask, &v[i]);   // Load floats into 512-bits
+		__mmask16 mge = _mm512_mask_cmp_ps_mask(mask, r1, rthreshold, _CMP_GE_OQ);
+		if (mge == 0) continue;  // Usual case: nothing here
+		unsigned int bits = mge;  // Count the lanes
+		int count = 0;
+		for (; bits; bits &= bits - 1) count++;
+		if (nout + count > maxout) return -1;  // fail (too many)
+		_mm512_mask_compressstoreu_epi32(&indices_out[nout], mge, rindex);  // Pack the indices together
+		nout += count;
+	}
+	return nout;
+}
+
+AUSSIE_TARGET_AVX512 float aussie_vector_sum_diff_squared_fused_AVX512(float v[], int n, float meanval)
+{
+	// Fused version of "sum diff squared" that leaves the DIFF in the vector..
+	__m512 sumdst = _mm512_setzero_ps();   // Set accumulators to zero
+	const __m512 vmean = _mm512_set1_ps(meanval);
+	for (int i = 0; i < n; i += 16) {
+		__mmask16 mask = AUSSIE_AVX512_TAIL_MASK(n - i);
+		__m512 r1 = _mm512_maskz_loadu_ps(mask, &v[i]); // Load V[i] floats into 512-bits
+		__m512 rdiff = _mm512_maskz_sub_ps(mask, r1, vmean); // DIFF = V[i] - MEAN (zero past the end)
+		_mm512_mask_storeu_ps(&v[i], mask, rdiff);  // V[i] = DIFF (store diffs back)
+		sumdst = _mm512_fmadd_ps(rdiff, rdiff, sumdst); // SUM = SUM + DIFF*DIFF
+	}
+	return _mm512_reduce_add_ps(sumdst);
+}
+
+AUSSIE_TARGET_AVX512 float aussie_fma_peak_AVX512(long niter)  // Peak FMA throughput (registers only): 10 x 16 x 2 FLOPs per iteration
+{
+	__m512 mul = _mm512_set1_ps(0.999999f);
+	__m512 add = _mm512_set1_ps(1.0e-6f);
+	__m512 a0 = _mm512_set1_ps(1.0f), a1 = _mm512_set1_ps(1.1f), a2 = _mm512_set1_ps(1.2f), a3 = _mm512_set1_ps(1.3f);
+	__m512 a4 = _mm512_set1_ps(1.4f), a5 = _mm512_set1_ps(1.5f), a6 = _mm512_set1_ps(1.6f), a7 = _mm512_set1_ps(1.7f);
+	__m512 a8 = _mm512_set1_ps(1.8f), a9 = _mm512_set1_ps(1.9f);
+	for (long i = 0; i < niter; i++) {
+		a0 = _mm512_fmadd_ps(a0, mul, add);
+		a1 = _mm512_fmadd_ps(a1, mul, add);
+		a2 = _mm512_fmadd_ps(a2, mul, add);
+		a3 = _mm512_fmadd_ps(a3, mul, add);
+		a4 = _mm512_fmadd_ps(a4, mul, add);
+		a5 = _mm512_fmadd_ps(a5, mul, add);
+		a6 = _mm512_fmadd_ps(a6, mul, add);
+		a7 = _mm512_fmadd_ps(a7, mul, add);
+		a8 = _mm512_fmadd_ps(a8, mul, add);
+		a9 = _mm512_fmadd_ps(a9, mul, add);
+	}
+	a0 = _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(a0, a1), _mm512_add_ps(a2, a3)), _mm512_add_ps(a4, a5));
+	a0 = _mm512_add_ps(a0, _mm512_add_ps(_mm512_add_ps(a6, a7), _mm512_add_ps(a8, a9)));
+	return _mm512_reduce_add_ps(a0);
+}
+
+//---------------------------------------------------
+// Odd lengths and unaligned vectors: every kernel against the scalar version,
+// with guard values after the end to catch stores past n.
+//---------------------------------------------------
+
+struct aussie_avx_kernel_set {
+	int isa;
+	void (*fn_add_scalar)(float v[], int n, float c);
+	void (*fn_multiply_scalar)(float v[], int n, float c);
+	void (*fn_reluize)(float v[], int n);
+	void (*fn_expf)(float v[], int n);
+	float (*fn_sum)(float v[], int n);
+	float (*fn_sum_squares)(float v[], int n);
+	float (*fn_max)(float v[], int n);
+	float (*fn_min)(float v[], int n);
+	float (*fn_sum_diff_squared_fused)(float v[], int n, float meanval);
+	float (*fn_fused_expf_sum)(float v[], int n);
+	float (*fn_vecdot)(const float v1[], const float v2[], int n);
+};
+
+static void aussie_test_avx_kernels_one_size(const aussie_avx_kernel_set& k, int n, int offset)
+{
+	const float guard = 12345.0f;
+	const int maxn = 64;
+	float buf1[maxn + 4 + 8], buf2[maxn + 4 + 8], bufexpect[maxn + 4 + 8];
+	yassert(n <= maxn && offset < 4);
+	float* v1 = buf1 + offset;  // Unaligned (usually)
+	float* v2 = buf2 + offset;
+	float* vexpect = bufexpect + offset;
+	for (int i = 0; i < n + 8; i++) {
+		v1[i] = (i < n) ? (float)((i * 7) % 13) * 0.25f - 1.5f : guard;
+		v2[i] = (i < n) ? (float)((i * 5) % 11) * 0.5f - 2.0f : guard;
+	}
+	aussie_vector_copy_basic(vexpect, v1, n + 8);
+
+	// Reductions (small exact values)
+	ytestf(k.fn_sum(v1, n), aussie_vector_sum(v1, n));
+	if (k.fn_sum_squares) ytestf(k.fn_sum_squares(v1, n), aussie_vector_sum_squares_basic(v1, n));
+	ytestf(k.fn_vecdot(v1, v2, n), aussie_vecdot_basic(v1, v2, n));
+	if (n > 0) {
+		ytestf(k.fn_max(v1, n), aussie_vector_max(v1, n));
+		ytestf(k.fn_min(v1, n), aussie_vector_min(v1, n));
+	}
+
+	// In-place element-wise kernels
+	if (k.fn_add_scalar) {
+		k.fn_add_scalar(v1, n, 0.5f);
+		for (int i = 0; i < n; i++) vexpect[i] += 0.5f;
+		ytest(aussie_vector_equal(v1, vexpect, n + 8));  // Guards unchanged
+	}
+	k.fn_multiply_scalar(v1, n, -2.0f);
+	aussie_vector_multiply_scalar(vexpect, n, -2.0f);
+	ytest(aussie_vector_equal(v1, vexpect, n + 8));
+	k.fn_reluize(v1, n);
+	aussie_vector_reluize(vexpect, n);
+	ytest(aussie_vector_equal(v1, vexpect, n + 8));
+
+	float fmean = 0.75f;
+	float fsum = k.fn_sum_diff_squared_fused(v1, n, fmean);
+	float fsum2 = aussie_vector_sum_diff_squared_fused(vexpect, n, fmean);
+	ytestf(fsum, fsum2);
+	ytest(aussie_vector_equal(v1, vexpect, n + 8));
+
+	// Exponentials (SIMD expf is within AUSSIE_EXP_MAX_ULP)
+	k.fn_expf(v1, n);
+	aussie_vector_expf(vexpect, n);
+	ytest(aussie_vector_equal_approx(v1, vexpect, n, 1e-5f));
+	ytest(aussie_vector_equal(v1 + n, vexpect + n, 8));
+	aussie_vector_copy_basic(v1, v2, n + 8);
+	aussie_vector_copy_basic(vexpect, v2, n + 8);
+	fsum = k.fn_fused_expf_sum(v1, n);
+	fsum2 = aussie_vector_expf_and_sum(vexpect, n);
+	ytest(fabsf(fsum - fsum2) <= 1e-5f * (1.0f + fsum2));
+	ytest(aussie_vector_equal_approx(v1, vexpect, n, 1e-5f));
+	ytest(aussie_vector_equal(v1 + n, vexpect + n, 8));
+}
+
+void aussie_test_avx_any_length()  // Odd lengths and unaligned vectors for all SIMD kernels
+{
+	aussie_avx_kernel_set kernels[3] = {
+		{ AUSSIE_ISA_AVX1, aussie_vector_add_scalar_AVX1, aussie_vector_multiply_scalar_AVX1, aussie_vector_reluize_AVX1,
+			aussie_vector_expf_AVX1, aussie_vector_sum_AVX1, aussie_vector_sum_squares_AVX1, aussie_vector_max_AVX1,
+			aussie_vector_min_AVX1, aussie_vector_sum_diff_squared_fused_AVX1, aussie_vector_fused_expf_sum_AVX1,
+			aussie_vecdot_unroll_AVX1 },
+		{ AUSSIE_ISA_AVX2, aussie_vector_add_scalar_AVX2, aussie_vector_multiply_scalar_AVX2, aussie_vector_reluize_AVX2,
+			aussie_vector_expf_AVX2, aussie_vector_sum_AVX2, aussie_vector_sum_squares_AVX2, aussie_vector_max_AVX2,
+			aussie_vector_min_AVX2, aussie_vector_sum_diff_squared_fused_AVX2, aussie_vector_fused_expf_sum_AVX2,
+			aussie_vecdot_FMA_unroll_AVX2 },
+		{ AUSSIE_ISA_AVX512, NULL /*no add-scalar*/, aussie_vector_multiply_scalar_AVX512, aussie_vector_reluize_AVX512,
+			aussie_vector_expf_AVX512, aussie_vector_sum_AVX512, NULL /*no sum-squares*/, aussie_vector_max_AVX512,
+			aussie_vector_min_AVX512, aussie_vector_sum_diff_squared_fused_AVX512, aussie_vector_fused_expf_sum_AVX512,
+			aussie_vecdot_FMA_unroll_AVX512 },
+	};
+	for (int i = 0; i < 3; i++) {
+		if (kernels[i].isa == AUSSIE_ISA_AVX2 && !aussie_cpu_has_avx2()) continue;
+		if (kernels[i].isa == AUSSIE_ISA_AVX512 && !aussie_cpu_has_avx512()) continue;
+		for (int n = 0; n <= 40; n++) {
+			for (int offset = 0; offset < 4; offset++) {
+				aussie_test_avx_kernels_one_size(kernels[i], n, offset);
+			}
+		}
+	}
+	// The extra AVX1/AVX2 variants
+	float v[37];
+	for (int n = 1; n <= 37; n += 3) {
+		for (int i = 0; i < n; i++) v[i] = (float)((i * 7) % 13) - 6.0f;
+		float fmin = 0.0f;
+		ytestf(aussie_vector_max_AVX1b(v, n), aussie_vector_max(v, n));
+		ytestf(aussie_vector_min_AVX1b(v, n), aussie_vector_min(v, n));
+		ytestf(aussie_vector_max_min_fusion_AVX1b(v, n, fmin), aussie_vector_max(v, n));
+		ytestf(fmin, aussie_vector_min(v, n));
+		if (aussie_cpu_has_avx2()) {
+			ytestf(aussie_vector_min_AVX2b(v, n), aussie_vector_min(v, n));
+			ytestf(aussie_vecdot_unroll_AVX2(v, v, n), aussie_vecdot_basic(v, v, n));
+			ytestf(aussie_vecdot_FMA_unroll_AVX1(v, v, n), aussie_vecdot_basic(v, v, n));
+		}
 	}
 }
 
@@ -685,9 +1244,9 @@ void aussie_test_avx2_multiply_8_floats()
 
 }
 
+#if 0 // Not working (cannot declare __isa_available?) -- see aussie_cpu_has_avx512() instead
 #include <isa_availability.h>
 
-#if 0 // Not working (cannot declare __isa_available?)
 bool aussie_check_avx512_is_available()
 {
 	int isa_level = __isa_available;
@@ -700,7 +1259,8 @@ bool aussie_check_avx512_is_available()
 void aussie_test_avx512_multiply_16_floats()
 {
 	// Test AVX-512 multiplication of 16 floats...
-#if AUSSIE_DO_AVX512 // not yet working on MSVS
+#if AUSSIE_DO_AVX512
+	if (!aussie_cpu_has_avx512()) return;  // Illegal instruction on older CPUs
 
 	alignas(64) float arr1[16] = { 1.0f , 2.5f , 3.14f, 0.0f, 5.0f, 4.4f, -1.2f, -5.7f };
 	alignas(64) float arr2[16] = { 1.0f , 2.5f , 3.14f, 0.0f, 3.0f, -0.5, -1.07, +3.5f };
@@ -729,13 +1289,15 @@ void aussie_test_avx512_multiply_16_floats()
 }
 
 
-void aussie_unit_test_avx1_basics ()  // AVX version 1 (128-bit) tests __m128
+AUSSIE_TARGET_AVX1 void aussie_unit_test_avx1_basics ()  // AVX version 1 (128-bit) tests __m128
 {
 	aussie_test_avx_multiply_4_floats();
 	aussie_test_avx_multiply_4_floats_with_alignment();
-	aussie_test_avx2_multiply_8_floats();
+	if (aussie_cpu_has_avx2()) {
+		aussie_test_avx2_multiply_8_floats();
+		aussie_test_avx_vecdot_4_floats();  // Has FMA and AVX-2 tests too
+	}
 	aussie_test_avx512_multiply_16_floats();
-	aussie_test_avx_vecdot_4_floats();
 
 	//	__m128 _mm_mul_ps(__m128 a, __m128 b) // 
 	float f = 0.0f;
@@ -781,5 +1343,5 @@ void aussie_unit_test_avx1_basics ()  // AVX version 1 (128-bit) tests __m128
 //---------------------------------------------------
 //---------------------------------------------------
 
-#endif // if !LINUX  // Don't include the entire file for Linux!
+#endif // AUSSIE_X86  // Only x86 CPUs have AVX (the whole file is x86-only)
 
@@ -7,7 +7,7 @@
 #ifndef AUSSIE_YAVX_INCLUDE_HEADER_H
 #define AUSSIE_YAVX_INCLUDE_HEADER_H
 
-#define AUSSIE_DO_AVX512 0
+#define AUSSIE_DO_AVX512 1  // AVX-512 kernels are compiled, but only called if aussie_cpu_has_avx512()
 
 //---------------------------------------------------
 //---------------------------------------------------
@@ -22,6 +22,7 @@ void aussie_avx_multiply_4_floats(float v1[4], float v2[4], float vresult[4]);
 
 void aussie_unit_test_avx();  // AVX, AVX-2, AVX-512, SSE
 void aussie_unit_test_avx1_basics();  // AVX version 1 (128-bit) tests __m128
+void aussie_test_avx_any_length();  // Odd lengths and unaligned vectors for all SIMD kernels
 void aussie_test_avx_multiply_4_floats();
 void aussie_test_avx_multiply_4_floats_with_alignment();
 
@@ -45,6 +46,7 @@ float aussie_vecdot_FMA_unroll_AVX2(const float v1[], const float v2[], int n);
 void aussie_vector_multiply_scalar_AVX1(float v[], int n, float c);  // Multiply all vector elements by constant
 void aussie_vector_multiply_scalar_AVX2(float v[], int n, float c);  // Multiply all vector elements by constant
 void aussie_vector_multiply_scalar_AVX2_pointer_arith(float v[], int n, float c);  // Multiply all vector elements by constant
+int aussie_vector_indices_ge_AVX2(const float v[], int n, float threshold, int indices_out[], int maxout);  // Indices of v[i] >= threshold (-1 if more than maxout)
 
 void aussie_vector_add_scalar_AVX1(float v[], int n, float c);   // Add scalar constant to all vector elements
 void aussie_vector_add_scalar_AVX2(float v[], int n, float c);   // Add scalar constant to all vector elements
@@ -61,6 +63,8 @@ float aussie_vector_sum_squares_AVX2(float v[], int n);  // Summation of squares
 float aussie_vector_sum_diff_squared_fused_AVX1(float v[], int n, float meanval);
 float aussie_vector_sum_diff_squared_fused_AVX2(float v[], int n, float meanval);
 
+float aussie_fma_peak_AVX2(long niter);   // Register-only FMA loop for the roofline peak (160 FLOPs per iteration)
+
 
 //---------------------------------------------------
 //---------------------------------------------------
@@ -82,6 +86,31 @@ float aussie_vector_max_AVX2(float v[], int n);   // Maximum (horizontal) of a s
 void aussie_vector_reluize_AVX1(float v[], int n);   // Apply RELU to each element (sets negatives to zero)
 void aussie_vector_reluize_AVX2(float v[], int n);   // Apply RELU to each element (sets negatives to zero)
 
+void aussie_vector_sigmoid_AVX2(float v[], int n);   // 1 / (1 + e^-x) (aactivation.h)
+void aussie_vector_SiLU_AVX2(float v[], int n);   // x * sigmoid(x)
+void aussie_vector_GELU_tanh_AVX2(float v[], int n);   // GELU tanh approximation
+void aussie_vector_GELU_sigmoid_AVX2(float v[], int n);   // x * sigmoid(1.702 * x)
+
+//---------------------------------------------------
+// AVX-512 kernels (16 floats)
+//---------------------------------------------------
+
+float aussie_vecdot_FMA_unroll_AVX512(const float v1[], const float v2[], int n);   // AVX-512 vecdot using FMA
+float aussie_vector_sum_AVX512(float v[], int n);   // Summation (horizontal) of a single vector
+float aussie_vector_max_AVX512(float v[], int n);   // Maximum (horizontal) of a single vector
+float aussie_vector_min_AVX512(float v[], int n);   // Minimum (horizontal) of a single vector
+void aussie_vector_multiply_scalar_AVX512(float v[], int n, float c);  // Multiply all vector elements by constant
+void aussie_vector_reluize_AVX512(float v[], int n);   // Apply RELU to each element (sets negatives to zero)
+int aussie_vector_indices_ge_AVX512(const float v[], int n, float threshold, int indices_out[], int maxout);  // Indices of v[i] >= threshold (-1 if more than maxout)
+float aussie_vector_sum_diff_squared_fused_AVX512(float v[], int n, float meanval);
+void aussie_vector_expf_AVX512(float v[], int n);   // Apply EXPF (exponential) to each element
+float aussie_vector_fused_expf_sum_AVX512(float v[], int n);   // Apply EXPF (exponential) to each element and SUM them
+void aussie_vector_sigmoid_AVX512(float v[], int n);   // 1 / (1 + e^-x) (aactivation.h)
+void aussie_vector_SiLU_AVX512(float v[], int n);   // x * sigmoid(x)
+void aussie_vector_GELU_tanh_AVX512(float v[], int n);   // GELU tanh approximation
+void aussie_vector_GELU_sigmoid_AVX512(float v[], int n);   // x * sigmoid(1.702 * x)
+float aussie_fma_peak_AVX512(long niter);   // Register-only FMA loop for the roofline peak (320 FLOPs per iteration)
+
 //---------------------------------------------------
 //---------------------------------------------------
 
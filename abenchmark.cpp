@@ -12,6 +12,10 @@
 #include <ctype.h>
 #include <time.h>
 #include <math.h>
+#include <stdarg.h>
+
+#include <chrono>  // Monotonic clock (non-Linux)
+#include <thread>
 
 //---------------------------------------------------
 //---------------------------------------------------
@@ -19,16 +23,464 @@
 #include "aport.h"
 #include "aussieai.h"
 #include "aassert.h"
+#include "atest.h"
 #include "aops.h"
 #include "avector.h"
 #include "anormalize.h"
 #include "asoftmax.h"
 #include "aavx.h"
 #include "amatmul.h"
+#include "adispatch.h"
+#include "agemm.h"
+#include "athread.h"
+#include "atopk.h"
+#include "asample.h"
+#include "afloat.h"
+#include "aquant.h"
+#include "ahalf.h"
+#include "aarena.h"
+#include "alut.h"
+#include "aactivation.h"
+#include "aprecompute.h"
+#include "aconstexpr.h"
+#include "affn.h"
 
 #include "abenchmark.h"  // self-include
 
+#if LINUX
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>  // Hardware performance counters
+#if AUSSIE_X86
+#include <cpuid.h>  // Vendor check (FP ops events are Intel-specific)
+#endif //AUSSIE_X86
+#endif //LINUX
+
+//---------------------------------------------------
+// Benchmark harness
+//---------------------------------------------------
+
+aussie_bench_config g_aussie_bench_config = {
+	AUSSIE_BENCH_TEXT,  // format
+	100000.0,           // min_sample_ns (100 microseconds)
+	2,                  // warmup_samples
+	10,                 // min_samples
+	1000,               // max_samples
+	0.5,                // max_seconds
+	1.0,                // stable_pct
+	NULL,               // fp (stdout)
+	false               // counters
+};
+
+volatile float g_aussie_bench_sink = 0.0f;
+static bool s_aussie_bench_env_done = false;
+static bool s_aussie_bench_csv_header_done = false;
+
+void aussie_bench_config_from_env()  // Read AUSSIE_BENCH_* (automatic on first run)
+{
+	s_aussie_bench_env_done = true;
+	const char* fmt = getenv("AUSSIE_BENCH_FORMAT");
+	if (fmt) {
+		if (strcmp(fmt, "csv") == 0) g_aussie_bench_config.format = AUSSIE_BENCH_CSV;
+		else if (strcmp(fmt, "json") == 0) g_aussie_bench_config.format = AUSSIE_BENCH_JSON;
+		else g_aussie_bench_config.format = AUSSIE_BENCH_TEXT;
+	}
+	const char* secs = getenv("AUSSIE_BENCH_SECONDS");
+	if (secs && atof(secs) > 0.0) g_aussie_bench_config.max_seconds = atof(secs);
+	const char* counters = getenv("AUSSIE_BENCH_COUNTERS");
+	if (counters) g_aussie_bench_config.counters = (atoi(counters) != 0);
+}
+
+void aussie_bench_config_ensure()  // Read AUSSIE_BENCH_* unless already done
+{
+	if (!s_aussie_bench_env_done) aussie_bench_config_from_env();
+}
+
+double aussie_bench_now_ns()  // Monotonic clock in nanoseconds
+{
+#if LINUX
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+#else
+	return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+void aussie_bench_result_init(aussie_bench_result& res, const char* name, long nelements, double bytes, double flops)
+{
+	memset(&res, 0, sizeof(res));
+	res.name = name;
+	res.nelements = nelements;
+	res.bytes = bytes;
+	res.flops = flops;
+	for (int c = 0; c < AUSSIE_COUNTER_MAX; c++) res.counters[c] = -1.0;  // Not counted
+	res.level = NULL;
+	res.roofline_pct = -1.0;
+}
+
+static double aussie_bench_time_batch(aussie_bench_fnptr fn, void* arg, aussie_bench_fnptr setup, long ncalls, bool run_fn)
+{
+	double start = aussie_bench_now_ns();
+	for (long i = 0; i < ncalls; i++) {
+		if (setup) setup(arg);
+		if (run_fn) fn(arg);
+	}
+	return aussie_bench_now_ns() - start;
+}
+
+static double aussie_bench_sample(aussie_bench_fnptr fn, void* arg, aussie_bench_fnptr setup, long ncalls)  // ns per call
+{
+	double ns = aussie_bench_time_batch(fn, arg, setup, ncalls, true);
+	if (setup) {  // Take away the cost of the setup calls
+		ns -= aussie_bench_time_batch(fn, arg, setup, ncalls, false);
+		if (ns < 0.0) ns = 0.0;
+	}
+	return ns / (double)ncalls;
+}
+
+//---------------------------------------------------
+// Hardware performance counters
+//---------------------------------------------------
+
+struct aussie_bench_event {
+	int counter;               // AUSSIE_COUNTER_*
+	unsigned int type;         // PERF_TYPE_*
+	unsigned long long config;
+	double weight;             // Added to the counter per event (FP ops per instruction)
+	bool intel_only;
+};
+
+#if LINUX
+static const aussie_bench_event s_aussie_bench_events[] = {
+	{ AUSSIE_COUNTER_CYCLES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, 1.0, false },
+	{ AUSSIE_COUNTER_INSTRUCTIONS, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, 1.0, false },
+	{ AUSSIE_COUNTER_L1D_MISSES, PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16), 1.0, false },
+	{ AUSSIE_COUNTER_LLC_MISSES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, 1.0, false },
+	{ AUSSIE_COUNTER_BRANCH_MISSES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, 1.0, false },
+	{ AUSSIE_COUNTER_FP_OPS, PERF_TYPE_RAW, 0x03C7, 1.0, true },    // FP_ARITH_INST_RETIRED: scalar single + double
+	{ AUSSIE_COUNTER_FP_OPS, PERF_TYPE_RAW, 0x04C7, 2.0, true },    // ... 128-bit packed double
+	{ AUSSIE_COUNTER_FP_OPS, PERF_TYPE_RAW, 0x18C7, 4.0, true },    // ... 128-bit packed single, 256-bit packed double
+	{ AUSSIE_COUNTER_FP_OPS, PERF_TYPE_RAW, 0x60C7, 8.0, true },    // ... 256-bit packed single, 512-bit packed double
+	{ AUSSIE_COUNTER_FP_OPS, PERF_TYPE_RAW, 0x80C7, 16.0, true },   // ... 512-bit packed single
+};
+#define AUSSIE_BENCH_NEVENTS ((int)(sizeof(s_aussie_bench_events) / sizeof(s_aussie_bench_events[0])))
+static int s_aussie_bench_fds[AUSSIE_BENCH_NEVENTS];
+#endif //LINUX
+
+static int s_aussie_bench_counters_state = 0;  // 0 = not tried, 1 = open, -1 = unavailable
+
+const char* aussie_bench_counter_name(int counter)
+{
+	switch (counter) {
+	case AUSSIE_COUNTER_CYCLES: return "cycles";
+	case AUSSIE_COUNTER_INSTRUCTIONS: return "instructions";
+	case AUSSIE_COUNTER_L1D_MISSES: return "l1d_misses";
+	case AUSSIE_COUNTER_LLC_MISSES: return "llc_misses";
+	case AUSSIE_COUNTER_BRANCH_MISSES: return "branch_misses";
+	case AUSSIE_COUNTER_FP_OPS: return "fp_ops";
+	default: return "unknown";
+	}
+}
+
+#if LINUX
+static bool aussie_bench_cpu_is_intel()
+{
+#if AUSSIE_X86
+	unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+	if (!__get_cpuid(0, &eax, &ebx, &ecx, &edx)) return false;
+	return ebx == 0x756e6547 && edx == 0x49656e69 && ecx == 0x6c65746e;  // "GenuineIntel"
+#else
+	return false;
+#endif //AUSSIE_X86
+}
+#endif //LINUX
+
+bool aussie_bench_counters_open()
+{
+	if (s_aussie_bench_counters_state != 0) return s_aussie_bench_counters_state > 0;
+	s_aussie_bench_counters_state = -1;
+#if LINUX
+	bool intel = aussie_bench_cpu_is_intel();
+	int nopen = 0;
+	for (int i = 0; i < AUSSIE_BENCH_NEVENTS; i++) {
+		s_aussie_bench_fds[i] = -1;
+		if (s_aussie_bench_events[i].intel_only && !intel) continue;
+		struct perf_event_attr attr;
+		memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = s_aussie_bench_events[i].type;
+		attr.config = s_aussie_bench_events[i].config;
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;  // User space only (allowed with perf_event_paranoid 2)
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;  // To scale multiplexed counts
+		s_aussie_bench_fds[i] = (int)syscall(SYS_perf_event_open, &attr, 0 /*this thread*/, -1 /*any CPU*/, -1 /*no group*/, 0);
+		if (s_aussie_bench_fds[i] >= 0) nopen++;
+	}
+	if (nopen > 0) s_aussie_bench_counters_state = 1;
+#endif //LINUX
+	if (s_aussie_bench_counters_state < 0) {
+		fprintf(stderr, "INFO: %s: No hardware performance counters (no PMU, container, or perf_event_paranoid), time only\n", __func__);
+	}
+	return s_aussie_bench_counters_state > 0;
+}
+
+void aussie_bench_counters_close()
+{
+#if LINUX
+	if (s_aussie_bench_counters_state > 0) {
+		for (int i = 0; i < AUSSIE_BENCH_NEVENTS; i++) {
+			if (s_aussie_bench_fds[i] >= 0) close(s_aussie_bench_fds[i]);
+			s_aussie_bench_fds[i] = -1;
+		}
+	}
+#endif //LINUX
+	s_aussie_bench_counters_state = 0;  // Can be opened again
+}
+
+static void aussie_bench_count_batch(aussie_bench_fnptr fn, void* arg, aussie_bench_fnptr setup, long ncalls, bool run_fn, double counts[])
+{
+	for (int c = 0; c < AUSSIE_COUNTER_MAX; c++) counts[c] = -1.0;  // Not counted
+#if LINUX
+	for (int i = 0; i < AUSSIE_BENCH_NEVENTS; i++) {
+		if (s_aussie_bench_fds[i] < 0) continue;
+		ioctl(s_aussie_bench_fds[i], PERF_EVENT_IOC_RESET, 0);
+		ioctl(s_aussie_bench_fds[i], PERF_EVENT_IOC_ENABLE, 0);
+	}
+	aussie_bench_time_batch(fn, arg, setup, ncalls, run_fn);
+	for (int i = 0; i < AUSSIE_BENCH_NEVENTS; i++) {
+		if (s_aussie_bench_fds[i] >= 0) ioctl(s_aussie_bench_fds[i], PERF_EVENT_IOC_DISABLE, 0);
+	}
+	bool bad[AUSSIE_COUNTER_MAX] = { false };  // A counter with a part that never ran (e.g. one FP width)
+	for (int i = 0; i < AUSSIE_BENCH_NEVENTS; i++) {
+		if (s_aussie_bench_fds[i] < 0) continue;
+		int c = s_aussie_bench_events[i].counter;
+		unsigned long long vals[3] = { 0, 0, 0 };  // Count, time enabled, time running
+		if (read(s_aussie_bench_fds[i], vals, sizeof(vals)) != (ssize_t)sizeof(vals) || vals[2] == 0) {
+			bad[c] = true;
+			continue;
+		}
+		double count = (double)vals[0] * ((double)vals[1] / (double)vals[2]);  // Scale up if multiplexed
+		if (counts[c] < 0.0) counts[c] = 0.0;
+		counts[c] += count * s_aussie_bench_events[i].weight;
+	}
+	for (int c = 0; c < AUSSIE_COUNTER_MAX; c++) {
+		if (bad[c]) counts[c] = -1.0;
+	}
+#endif //LINUX
+}
+
+static void aussie_bench_count(aussie_bench_result& res, aussie_bench_fnptr fn, void* arg, aussie_bench_fnptr setup, long ncalls)  // Counters per call
+{
+	long ncount = ncalls;
+	while (ncount * res.ns_median < 10e6 && ncount < (1L << 30)) ncount *= 2;  // About 10ms of calls (fewer multiplexing errors)
+	double counts[AUSSIE_COUNTER_MAX], setupcounts[AUSSIE_COUNTER_MAX];
+	aussie_bench_count_batch(fn, arg, setup, ncount, true, counts);
+	if (setup) aussie_bench_count_batch(fn, arg, setup, ncount, false, setupcounts);
+	res.has_counters = false;
+	for (int c = 0; c < AUSSIE_COUNTER_MAX; c++) {
+		res.counters[c] = -1.0;
+		if (counts[c] < 0.0) continue;
+		double count = counts[c];
+		if (setup) {
+			if (setupcounts[c] < 0.0) continue;
+			count -= setupcounts[c];
+			if (count < 0.0) count = 0.0;
+		}
+		res.counters[c] = count / (double)ncount;
+		res.has_counters = true;
+	}
+}
+
+static int aussie_bench_cmp_double(void const* addr1, void const* addr2)
+{
+	double d1 = *(const double*)addr1;
+	double d2 = *(const double*)addr2;
+	return d1 < d2 ? -1 : (d1 > d2 ? 1 : 0);
+}
+
+static double aussie_bench_median(const double samples[], int n, double sorted[])
+{
+	memcpy(sorted, samples, n * sizeof(double));
+	qsort(sorted, n, sizeof(double), aussie_bench_cmp_double);
+	return sorted[n / 2];
+}
+
+bool aussie_bench_run(aussie_bench_result& res, aussie_bench_fnptr fn, void* arg, aussie_bench_fnptr setup)  // setup() runs before each call, not timed
+{
+	aussie_bench_config_ensure();
+	const aussie_bench_config& cfg = g_aussie_bench_config;
+	int maxsamples = cfg.max_samples < 3 ? 3 : cfg.max_samples;
+	double* samples = (double*)malloc(maxsamples * sizeof(double));
+	double* sorted = (double*)malloc(maxsamples * sizeof(double));
+	if (!fn || !samples || !sorted) {
+		yassert(fn && samples && sorted);
+		free(samples); free(sorted);
+		return false;  // fail
+	}
+	double tstart = aussie_bench_now_ns();
+
+	// Calibrate: double the calls per sample until a sample is long enough (also warms up)
+	long ncalls = 1;
+	for (;;) {
+		double ns = aussie_bench_time_batch(fn, arg, setup, ncalls, true);
+		if (ns >= cfg.min_sample_ns || ncalls >= (1L << 30)) break;
+		ncalls *= 2;
+	}
+	for (int i = 0; i < cfg.warmup_samples; i++) {
+		if (aussie_bench_now_ns() - tstart > cfg.max_seconds * 1e9) break;  // Slow kernel: calibration was the warmup
+		aussie_bench_sample(fn, arg, setup, ncalls);
+	}
+
+	// Samples until the median is stable, or out of time
+	int n = 0;
+	double prev_median = -1.0;
+	while (n < maxsamples) {
+		samples[n++] = aussie_bench_sample(fn, arg, setup, ncalls);
+		bool out_of_time = aussie_bench_now_ns() - tstart > cfg.max_seconds * 1e9;
+		if (out_of_time && n >= 3) break;
+		if (n >= cfg.min_samples && n % 10 == 0) {
+			double median = aussie_bench_median(samples, n, sorted);
+			if (prev_median > 0.0 && fabs(median - prev_median) * 100.0 <= cfg.stable_pct * prev_median) break;  // Stable
+			prev_median = median;
+		}
+	}
+
+	// Statistics (per call)
+	aussie_bench_median(samples, n, sorted);
+	res.nsamples = n;
+	res.calls_per_sample = ncalls;
+	res.ns_min = sorted[0];
+	res.ns_median = sorted[n / 2];
+	int ip99 = (int)ceil(0.99 * n) - 1;  // Nearest rank
+	res.ns_p99 = sorted[ip99 < 0 ? 0 : ip99];
+	double sum = 0.0, sumsq = 0.0;
+	for (int i = 0; i < n; i++) sum += samples[i];
+	res.ns_mean = sum / n;
+	for (int i = 0; i < n; i++) sumsq += (samples[i] - res.ns_mean) * (samples[i] - res.ns_mean);
+	res.ns_stddev = n > 1 ? sqrt(sumsq / (n - 1)) : 0.0;
+	free(samples);
+	free(sorted);
+
+	res.has_counters = false;
+	if (cfg.counters && aussie_bench_counters_open()) aussie_bench_count(res, fn, arg, setup, ncalls);
+	return true;
+}
+
+static void aussie_bench_print_json_string(FILE* fp, const char* str)
+{
+	fputc('"', fp);
+	for (const char* p = str; p && *p; p++) {
+		if (*p == '"' || *p == '\\') fputc('\\', fp);
+		fputc(*p, fp);
+	}
+	fputc('"', fp);
+}
+
+#define AUSSIE_BENCH_NDERIVED 8
+static const char* s_aussie_bench_derived_names[AUSSIE_BENCH_NDERIVED] = {
+	"cycles", "instructions", "ipc", "l1d_miss_per_element", "llc_miss_per_element", "branch_miss_per_element", "fp_ops", "flop_per_byte" };
+
+static void aussie_bench_derived(const aussie_bench_result& res, double d[AUSSIE_BENCH_NDERIVED])  // From the counters (-1 = not available)
+{
+	for (int i = 0; i < AUSSIE_BENCH_NDERIVED; i++) d[i] = -1.0;
+	if (!res.has_counters) return;
+	const double* cnt = res.counters;
+	double nelem = res.nelements > 0 ? (double)res.nelements : 1.0;
+	d[0] = cnt[AUSSIE_COUNTER_CYCLES];
+	d[1] = cnt[AUSSIE_COUNTER_INSTRUCTIONS];
+	if (d[0] > 0.0 && d[1] >= 0.0) d[2] = d[1] / d[0];  // IPC
+	if (cnt[AUSSIE_COUNTER_L1D_MISSES] >= 0.0) d[3] = cnt[AUSSIE_COUNTER_L1D_MISSES] / nelem;
+	if (cnt[AUSSIE_COUNTER_LLC_MISSES] >= 0.0) d[4] = cnt[AUSSIE_COUNTER_LLC_MISSES] / nelem;
+	if (cnt[AUSSIE_COUNTER_BRANCH_MISSES] >= 0.0) d[5] = cnt[AUSSIE_COUNTER_BRANCH_MISSES] / nelem;
+	d[6] = cnt[AUSSIE_COUNTER_FP_OPS];
+	if (d[6] >= 0.0 && res.bytes > 0.0) d[7] = d[6] / res.bytes;  // Achieved arithmetic intensity
+}
+
+void aussie_bench_report(const aussie_bench_result& res)
+{
+	FILE* fp = g_aussie_bench_config.fp ? g_aussie_bench_config.fp : stdout;
+	aussie_dispatch_ensure();
+	const char* isa = aussie_dispatch_isa_name(g_aussie_dispatch.isa);
+	double ns_per_elem = res.nelements > 0 ? res.ns_median / res.nelements : 0.0;
+	double gbsec = res.bytes > 0.0 && res.ns_median > 0.0 ? res.bytes / res.ns_median : 0.0;   // Bytes per ns is GB/sec
+	double gflopsec = res.flops > 0.0 && res.ns_median > 0.0 ? res.flops / res.ns_median : 0.0;
+	double derived[AUSSIE_BENCH_NDERIVED];
+	aussie_bench_derived(res, derived);
+
+	switch (g_aussie_bench_config.format) {
+	case AUSSIE_BENCH_CSV:
+		if (!s_aussie_bench_csv_header_done) {
+			s_aussie_bench_csv_header_done = true;
+			fprintf(fp, "name,isa,n,samples,calls_per_sample,min_ns,median_ns,p99_ns,mean_ns,stddev_ns,ns_per_element,gb_per_sec,gflop_per_sec");
+			for (int i = 0; i < AUSSIE_BENCH_NDERIVED; i++) fprintf(fp, ",%s", s_aussie_bench_derived_names[i]);
+			fprintf(fp, ",level,roofline_pct\n");
+		}
+		fprintf(fp, "\"%s\",%s,%ld,%d,%ld,%.3f,%.3f,%.3f,%.3f,%.3f,%.5f,%.4f,%.4f",
+			res.name, isa, res.nelements, res.nsamples, res.calls_per_sample,
+			res.ns_min, res.ns_median, res.ns_p99, res.ns_mean, res.ns_stddev, ns_per_elem, gbsec, gflopsec);
+		for (int i = 0; i < AUSSIE_BENCH_NDERIVED; i++) {
+			if (derived[i] >= 0.0) fprintf(fp, ",%.5g", derived[i]);
+			else fprintf(fp, ",");  // Not counted
+		}
+		fprintf(fp, ",%s", res.level ? res.level : "");
+		if (res.roofline_pct >= 0.0) fprintf(fp, ",%.2f\n", res.roofline_pct);
+		else fprintf(fp, ",\n");
+		break;
+	case AUSSIE_BENCH_JSON:
+		fprintf(fp, "{\"name\":");
+		aussie_bench_print_json_string(fp, res.name);
+		fprintf(fp, ",\"isa\":\"%s\",\"n\":%ld,\"samples\":%d,\"calls_per_sample\":%ld,"
+			"\"min_ns\":%.3f,\"median_ns\":%.3f,\"p99_ns\":%.3f,\"mean_ns\":%.3f,\"stddev_ns\":%.3f,"
+			"\"ns_per_element\":%.5f,\"gb_per_sec\":%.4f,\"gflop_per_sec\":%.4f",
+			isa, res.nelements, res.nsamples, res.calls_per_sample,
+			res.ns_min, res.ns_median, res.ns_p99, res.ns_mean, res.ns_stddev, ns_per_elem, gbsec, gflopsec);
+		for (int i = 0; i < AUSSIE_BENCH_NDERIVED; i++) {
+			if (derived[i] >= 0.0) fprintf(fp, ",\"%s\":%.5g", s_aussie_bench_derived_names[i], derived[i]);
+			else fprintf(fp, ",\"%s\":null", s_aussie_bench_derived_names[i]);  // Not counted
+		}
+		if (res.level) fprintf(fp, ",\"level\":\"%s\"", res.level);
+		else fprintf(fp, ",\"level\":null");
+		if (res.roofline_pct >= 0.0) fprintf(fp, ",\"roofline_pct\":%.2f}\n", res.roofline_pct);
+		else fprintf(fp, ",\"roofline_pct\":null}\n");
+		break;
+	default:
+		fprintf(fp, "%s: median %.1f ns (min %.1f, p99 %.1f, sd %.1f%%)", res.name,
+			res.ns_median, res.ns_min, res.ns_p99, res.ns_mean > 0.0 ? 100.0 * res.ns_stddev / res.ns_mean : 0.0);
+		if (res.nelements > 0) fprintf(fp, ", %.3f ns/elem", ns_per_elem);
+		if (gbsec > 0.0) fprintf(fp, ", %.2f GB/sec", gbsec);
+		if (gflopsec > 0.0) fprintf(fp, ", %.2f GFLOP/sec", gflopsec);
+		if (derived[2] >= 0.0) fprintf(fp, ", IPC %.2f", derived[2]);
+		if (derived[3] >= 0.0) fprintf(fp, ", L1D miss/elem %.3f", derived[3]);
+		if (derived[4] >= 0.0) fprintf(fp, ", LLC miss/elem %.4f", derived[4]);
+		if (derived[5] >= 0.0) fprintf(fp, ", branch miss/elem %.4f", derived[5]);
+		if (derived[7] >= 0.0) fprintf(fp, ", %.3f FLOP/byte", derived[7]);
+		if (res.level) fprintf(fp, ", %s", res.level);
+		if (res.roofline_pct >= 0.0) fprintf(fp, ", %.1f%% of roofline", res.roofline_pct);
+		fprintf(fp, " [%d x %ld calls]\n", res.nsamples, res.calls_per_sample);
+		break;
+	}
+	fflush(fp);
+}
+
+void aussie_bench_printf(const char* fmt, ...)  // Section titles and notes (text format only)
+{
+	aussie_bench_config_ensure();
+	if (g_aussie_bench_config.format != AUSSIE_BENCH_TEXT) return;  // Keep CSV/JSON machine-readable
+	FILE* fp = g_aussie_bench_config.fp ? g_aussie_bench_config.fp : stdout;
+	va_list ap;
+	va_start(ap, fmt);
+	vfprintf(fp, fmt, ap);
+	va_end(ap);
+}
+
 //---------------------------------------------------
+// Runners for the usual kernel signatures
+//---------------------------------------------------
+
 
 
 void test_accuracy_1000(char* name, long int n, float (*fnptr)(float a, float b), int (*ifnptr)(int a, int b))
@@ -74,70 +526,97 @@ void test_accuracy_1000(char* name, long int n, float (*fnptr)(float a, float b)
 
 }
 
-void run_arith_float_1000(char* name, long int n, float (*fnptr)(float a, float b), int (*ifnptr)(int a, int b))
+struct aussie_bench_arith_args {
+	float (*fnptr)(float a, float b);
+	int (*ifnptr)(int a, int b);
+	float a, b;
+	int ia, ib;
+};
+
+#define AUSSIE_BENCH_ARITH_OPS 1000  // Operations per timed call
+
+static void aussie_bench_arith_call(void* arg)
 {
-	unsigned long start_us = clock();
-	if (fnptr) {
-		float c = 0.0;
-		float a = 555.5;
-		float b = 555.5;
-		for (int i = 0; i <= n; i++) {
-			c = fnptr(a, b);
-		}
+	aussie_bench_arith_args* args = (aussie_bench_arith_args*)arg;
+	if (args->fnptr) {
+		float c = 0.0f;
+		for (int i = 0; i < AUSSIE_BENCH_ARITH_OPS; i++) c += args->fnptr(args->a, args->b);
+		g_aussie_bench_sink = c;
 	}
-	if (ifnptr) {
+	if (args->ifnptr) {
 		int c = 0;
-		int a = 555;
-		int b = 555;
-		for (int i = 0; i <= n; i++) {
-			c = ifnptr(a, b);
-		}
-
+		for (int i = 0; i < AUSSIE_BENCH_ARITH_OPS; i++) c += args->ifnptr(args->ia, args->ib);
+		g_aussie_bench_sink = (float)c;
 	}
+}
 
-	unsigned long after_us = clock();
-	int diff = after_us - start_us;
-
-	fprintf(stdout, "%s: %d ticks (%3.2f seconds)\n", name, diff, diff / (double)CLOCKS_PER_SEC);
+void run_arith_float_1000(char* name, long int n, float (*fnptr)(float a, float b), int (*ifnptr)(int a, int b))
+{
+	yassert(fnptr || ifnptr);
+	aussie_bench_arith_args args = { fnptr, ifnptr, 555.5f, 555.5f, 555, 555 };
+	aussie_bench_result res;
+	aussie_bench_result_init(res, name, AUSSIE_BENCH_ARITH_OPS, 0.0, fnptr ? (double)AUSSIE_BENCH_ARITH_OPS : 0.0);
+	if (aussie_bench_run(res, aussie_bench_arith_call, &args, NULL)) aussie_bench_report(res);
+}
 
+struct aussie_bench_vector_args {
+	float* v1;
+	float* v2;
+	const float* vcopy;  // Fresh data for in-place kernels
+	int n;
+	float fscalar;
+	void (*voidvectorfnptr)(const float v[], int n);
+	float (*floatvectorfnptr)(const float v[], const float v2[], int n);
+	void (*inplacefnptr)(float v[], int n);
+	float (*floatvectorfnptr2)(float v[], float v2[], int n);
+	void (*vectorscalarfnptr)(float v[], int n, float scalar);
+	int (*intvectorfnptr)(int v[], int v2[], int n);
+	int* iv1;
+	int* iv2;
+};
+
+static void aussie_bench_vector_reset(void* arg)  // Re-copy the test vector (in-place kernels)
+{
+	aussie_bench_vector_args* args = (aussie_bench_vector_args*)arg;
+	memcpy(args->v1, args->vcopy, args->n * sizeof(float));
 }
 
+static void aussie_bench_vector_call(void* arg)
+{
+	aussie_bench_vector_args* args = (aussie_bench_vector_args*)arg;
+	if (args->voidvectorfnptr) args->voidvectorfnptr(args->v1, args->n);
+	else if (args->floatvectorfnptr) g_aussie_bench_sink = args->floatvectorfnptr(args->v1, args->v2, args->n);
+	else if (args->inplacefnptr) args->inplacefnptr(args->v1, args->n);
+	else if (args->floatvectorfnptr2) g_aussie_bench_sink = args->floatvectorfnptr2(args->v1, args->v2, args->n);
+	else if (args->vectorscalarfnptr) args->vectorscalarfnptr(args->v1, args->n, args->fscalar);
+	else if (args->intvectorfnptr) g_aussie_bench_sink = (float)args->intvectorfnptr(args->iv1, args->iv2, args->n);
+}
 
-void run_vector_int_N(char* name, long int niter, long int nvecsize,
+void run_vector_int_N(char* name, long int nvecsize,
 	int (*intvectorfnptr)(int v[], int v2[], int n))
 {
 	yassert(intvectorfnptr);
 #define BENCHMARK_VECTOR_MAXSIZE 100000
 	static int v1[BENCHMARK_VECTOR_MAXSIZE];
 	static int v2[BENCHMARK_VECTOR_MAXSIZE];
-	static int vtemp[BENCHMARK_VECTOR_MAXSIZE];
 	yassert(nvecsize <= BENCHMARK_VECTOR_MAXSIZE);
 	if (nvecsize >= BENCHMARK_VECTOR_MAXSIZE) return;  // fail
 	aussie_ivector_set_1_N(v1, nvecsize);  // Dummy data 1..N
 	aussie_ivector_set_1_N(v2, nvecsize);  // Dummy data 1..N
-	aussie_ivector_set_1_N(vtemp, nvecsize);  // Dummy data 1..N
-
-	int memcopybytes = nvecsize * sizeof(v1[0]);
-	unsigned long start_us = clock();  // Before time
-	if (intvectorfnptr) {  // Functions that return void on 1 vector
-		int ret = 0;
-		for (int i = 0; i <= niter; i++) {
-			// Re-copy test vector fast with memcpy
-			//memcpy(v1, vtemp, memcopybytes);
-			//memcpy(v2, vtemp, memcopybytes);
-			ret = intvectorfnptr(v1, v2, nvecsize);
-		}
-	}
-
-	unsigned long after_us = clock();  // After time
-	int diff = after_us - start_us;
-
-	fprintf(stdout, "%s: %d ticks (%3.2f seconds)\n", name, diff, diff / (double)CLOCKS_PER_SEC);
 
+	aussie_bench_vector_args args;
+	memset(&args, 0, sizeof(args));
+	args.n = nvecsize;
+	args.intvectorfnptr = intvectorfnptr;
+	args.iv1 = v1;
+	args.iv2 = v2;
+	aussie_bench_result res;
+	aussie_bench_result_init(res, name, nvecsize, 2.0 * nvecsize * sizeof(int), 0.0);
+	if (aussie_bench_run(res, aussie_bench_vector_call, &args, NULL)) aussie_bench_report(res);
 }
 
 
-void run_vector_scalar_N(char* name, long int niter, long int nvecsize, void (*vectorscalarfnptr)(float v[], int n, float scalar))
+void run_vector_scalar_N(char* name, long int nvecsize, void (*vectorscalarfnptr)(float v[], int n, float scalar))
 {
 	// Run a vector-scalar operation (e.g. multiply by scalar)
 	const float fscalar = 1.5f;
@@ -149,31 +628,46 @@ void run_vector_scalar_N(char* name, long int niter, long int nvecsize, void (*v
 	if (nvecsize >= BENCHMARK_VECTOR_MAXSIZE) return;  // fail
 
 	alignas(32) float v1[BENCHMARK_VECTOR_MAXSIZE];
-	//alignas(32) float v2[BENCHMARK_VECTOR_MAXSIZE];
 	alignas(32) float vcopy[BENCHMARK_VECTOR_MAXSIZE];
 
 	aussie_vector_set_1_N(v1, nvecsize);  // Dummy data 1..N
 	aussie_vector_copy_basic(vcopy, v1, nvecsize);
 
+	aussie_bench_vector_args args;
+	memset(&args, 0, sizeof(args));
+	args.v1 = v1;
+	args.vcopy = vcopy;
+	args.n = nvecsize;
+	args.fscalar = fscalar;
+	args.vectorscalarfnptr = vectorscalarfnptr;
+	aussie_bench_result res;
+	aussie_bench_result_init(res, name, nvecsize, 2.0 * nvecsize * sizeof(float), (double)nvecsize);  // Read and write
+	if (aussie_bench_run(res, aussie_bench_vector_call, &args, aussie_bench_vector_reset)) aussie_bench_report(res);
+}
 
-	int memcopybytes = nvecsize * sizeof(v1[0]);
-	unsigned long start_us = clock();  // Before time
-	if (vectorscalarfnptr) {  // Functions that return void on 1 vector
-		for (int i = 0; i <= niter; i++) {
-			// Re-copy test vector fast with memcpy
-			memcpy(v1, vcopy, memcopybytes);
-			vectorscalarfnptr(v1, nvecsize, fscalar);
-		}
+struct aussie_bench_matrix_args {
+	void (*matrixmatrixfnptr)(const ymatrix m1, const ymatrix m2, int n, ymatrix mout);
+	void (*voidmatrixvectorfnptr)(const ymatrix m, const float v[], int n, float vout[]);
+	float (*m1)[AUSSIE_MATRIX_COLUMNS];  // ymatrix
+	float (*m2)[AUSSIE_MATRIX_COLUMNS];
+	float (*m3)[AUSSIE_MATRIX_COLUMNS];
+	float* v1;
+	float* vout;
+	int n;
+};
+
+static void aussie_bench_matrix_call(void* arg)
+{
+	aussie_bench_matrix_args* args = (aussie_bench_matrix_args*)arg;
+	if (args->matrixmatrixfnptr) {
+		args->matrixmatrixfnptr(args->m1, args->m2, args->n, args->m3);
+	}
+	else if (args->voidmatrixvectorfnptr) {
+		args->voidmatrixvectorfnptr(args->m1, args->v1, args->n, args->vout);
 	}
-	unsigned long after_us = clock();  // After time
-	int diff = after_us - start_us;
-
-	fprintf(stdout, "%s: %d ticks (%3.2f seconds)\n", name, diff, diff / (double)CLOCKS_PER_SEC);
-
-
 }
 
-void run_matrix_matrix_matmul(char* name, long int niter, long int nvecsize,
+void run_matrix_matrix_matmul(char* name, long int nvecsize,
 	void (*matrixmatrixfnptr)(const ymatrix m1, const ymatrix m2, int n, ymatrix mout)
 )
 {
@@ -190,22 +684,20 @@ void run_matrix_matrix_matmul(char* name, long int niter, long int nvecsize,
 	aussie_matrix_set_identity(m2);
 	aussie_matrix_set_identity(m3);
 
-	unsigned long start_us = clock();  // Before time
-	if (matrixmatrixfnptr) {  // Functions that return void on 1 vector
-		for (int i = 0; i <= niter; i++) {
-			// Re-copy test vector fast with memcpy
-			matrixmatrixfnptr(m1, m2, nvecsize, m3);
-		}
-	}
-
-	unsigned long after_us = clock();  // After time
-	int diff = after_us - start_us;
-
-	fprintf(stdout, "%s: %d ticks (%3.2f seconds)\n", name, diff, diff / (double)CLOCKS_PER_SEC);
-
+	aussie_bench_matrix_args args;
+	memset(&args, 0, sizeof(args));
+	args.matrixmatrixfnptr = matrixmatrixfnptr;
+	args.m1 = m1;
+	args.m2 = m2;
+	args.m3 = m3;
+	args.n = nvecsize;
+	double nn = (double)nvecsize * nvecsize;
+	aussie_bench_result res;
+	aussie_bench_result_init(res, name, (long)nn, 3.0 * nn * sizeof(float), 2.0 * nn * nvecsize);  // Each matrix once (at best)
+	if (aussie_bench_run(res, aussie_bench_matrix_call, &args, NULL)) aussie_bench_report(res);
 }
 
-void run_matrix_float_N(char* name, long int niter, long int nvecsize,
+void run_matrix_float_N(char* name, long int nvecsize,
 	void (*voidmatrixvectorfnptr)(const ymatrix m, const float v[], int n, float vout[])
 	)
 {
@@ -213,8 +705,6 @@ void run_matrix_float_N(char* name, long int niter, long int nvecsize,
 #undef BENCHMARK_VECTOR_MAXSIZE
 #define BENCHMARK_VECTOR_MAXSIZE 2048
 	alignas(32) float v1[BENCHMARK_VECTOR_MAXSIZE];
-	//alignas(32) float v2[BENCHMARK_VECTOR_MAXSIZE];
-	alignas(32) float vtemp[BENCHMARK_VECTOR_MAXSIZE];
 	alignas(32) float vout[BENCHMARK_VECTOR_MAXSIZE];
 	alignas(32) static ymatrix m;
 	yassert(nvecsize <= BENCHMARK_VECTOR_MAXSIZE);
@@ -222,31 +712,22 @@ void run_matrix_float_N(char* name, long int niter, long int nvecsize,
 
 	aussie_matrix_set_identity(m);
 	aussie_vector_set_1_N(v1, nvecsize);  // Dummy data 1..N
-	//aussie_vector_set_1_N(v2, nvecsize);  // Dummy data 1..N
-	aussie_vector_set_1_N(vtemp, nvecsize);  // Dummy data 1..N
-
-	int memcopybytes = nvecsize * sizeof(v1[0]);
-	unsigned long start_us = clock();  // Before time
-	if (voidmatrixvectorfnptr) {  // Functions that return void on 1 vector
-		float c = 0.0;
-		float a = 555.5;
-		float b = 555.5;
-		for (int i = 0; i <= niter; i++) {
-			// Re-copy test vector fast with memcpy
-			memcpy(v1, vtemp, memcopybytes);
-			voidmatrixvectorfnptr(m, v1, nvecsize, vout);
-		}
-	}
-
-	unsigned long after_us = clock();  // After time
-	int diff = after_us - start_us;
-
-	fprintf(stdout, "%s: %d ticks (%3.2f seconds)\n", name, diff, diff / (double)CLOCKS_PER_SEC);
 
+	aussie_bench_matrix_args args;
+	memset(&args, 0, sizeof(args));
+	args.voidmatrixvectorfnptr = voidmatrixvectorfnptr;
+	args.m1 = m;
+	args.v1 = v1;
+	args.vout = vout;
+	args.n = nvecsize;
+	double nn = (double)nvecsize * nvecsize;
+	aussie_bench_result res;
+	aussie_bench_result_init(res, name, (long)nn, (nn + 2.0 * nvecsize) * sizeof(float), 2.0 * nn);
+	if (aussie_bench_run(res, aussie_bench_matrix_call, &args, NULL)) aussie_bench_report(res);
 }
 
 
-void run_vector_float_N(char* name, long int niter, long int nvecsize, 
+void run_vector_float_N(char* name, long int nvecsize, 
 	void (*voidvectorfnptr)(const float v[], int n),
 	float (*floatvectorfnptr)(const float v[], const float v2[], int n)
 )
@@ -256,48 +737,26 @@ void run_vector_float_N(char* name, long int niter, long int nvecsize,
 #define BENCHMARK_VECTOR_MAXSIZE 10000
 	alignas(32) float v1[BENCHMARK_VECTOR_MAXSIZE];
 	alignas(32) float v2[BENCHMARK_VECTOR_MAXSIZE];
-	alignas(32) float vtemp[BENCHMARK_VECTOR_MAXSIZE];
 	yassert(nvecsize <= BENCHMARK_VECTOR_MAXSIZE);
 	if (nvecsize >= BENCHMARK_VECTOR_MAXSIZE) return;  // fail
 	aussie_vector_set_1_N(v1, nvecsize);  // Dummy data 1..N
 	aussie_vector_set_1_N(v2, nvecsize);  // Dummy data 1..N
-	aussie_vector_set_1_N(vtemp, nvecsize);  // Dummy data 1..N
-
-	int memcopybytes = nvecsize * sizeof(v1[0]);
-	unsigned long start_us = clock();  // Before time
-	if (voidvectorfnptr) {  // Functions that return void on 1 vector
-		float c = 0.0;
-		float a = 555.5;
-		float b = 555.5;
-		for (int i = 0; i <= niter; i++) {
-			// Re-copy test vector fast with memcpy
-			memcpy(v1, vtemp, memcopybytes);
-			voidvectorfnptr(v1, nvecsize);
-		}
-	}
-
-	if (floatvectorfnptr) {  // Functions that return FLOAT on 2 vectors
-		float c = 0.0;
-		float a = 555.5;
-		float b = 555.5;
-		float f = 0.0;
-		for (int i = 0; i <= niter; i++) {
-			// Re-copy test vector fast with memcpy
-			//memcpy(v1, vtemp, memcopybytes); // No need to copy, it's a read-only function like vecdot...
-			//memcpy(v2, vtemp, memcopybytes);
-			f = floatvectorfnptr(v1, v2, nvecsize);
-		}
-	}
-
-	unsigned long after_us = clock();  // After time
-	int diff = after_us - start_us;
-
-	fprintf(stdout, "%s: %d ticks (%3.2f seconds)\n", name, diff, diff / (double)CLOCKS_PER_SEC);
 
+	aussie_bench_vector_args args;
+	memset(&args, 0, sizeof(args));
+	args.v1 = v1;
+	args.v2 = v2;
+	args.n = nvecsize;
+	args.voidvectorfnptr = voidvectorfnptr;
+	args.floatvectorfnptr = voidvectorfnptr ? NULL : floatvectorfnptr;
+	aussie_bench_result res;
+	if (voidvectorfnptr) aussie_bench_result_init(res, name, nvecsize, (double)nvecsize * sizeof(float), 0.0);
+	else aussie_bench_result_init(res, name, nvecsize, 2.0 * nvecsize * sizeof(float), 2.0 * nvecsize);  // Two vectors, a multiply-add each (like vecdot)
+	if (aussie_bench_run(res, aussie_bench_vector_call, &args, NULL)) aussie_bench_report(res);
 }
 
 
-void run_vector_float_N_non_const(char* name, long int niter, long int nvecsize,
+void run_vector_float_N_non_const(char* name, long int nvecsize,
 	void (*voidvectorfnptr)(float v[], int n),
 	float (*floatvectorfnptr)(float v[], float v2[], int n)
 )
@@ -314,37 +773,23 @@ void run_vector_float_N_non_const(char* name, long int niter, long int nvecsize,
 	aussie_vector_set_1_N(v2, nvecsize);  // Dummy data 1..N
 	aussie_vector_set_1_N(vtemp, nvecsize);  // Dummy data 1..N
 
-	int memcopybytes = nvecsize * sizeof(v1[0]);
-	unsigned long start_us = clock();  // Before time
-	if (voidvectorfnptr) {  // Functions that return void on 1 vector
-		float c = 0.0;
-		float a = 555.5;
-		float b = 555.5;
-		for (int i = 0; i <= niter; i++) {
-			// Re-copy test vector fast with memcpy
-			memcpy(v1, vtemp, memcopybytes);
-			voidvectorfnptr(v1, nvecsize);
-		}
+	aussie_bench_vector_args args;
+	memset(&args, 0, sizeof(args));
+	args.v1 = v1;
+	args.v2 = v2;
+	args.vcopy = vtemp;
+	args.n = nvecsize;
+	args.inplacefnptr = voidvectorfnptr;
+	args.floatvectorfnptr2 = voidvectorfnptr ? NULL : floatvectorfnptr;
+	aussie_bench_result res;
+	if (voidvectorfnptr) {  // In place: re-copy the test vector before each call (not timed)
+		aussie_bench_result_init(res, name, nvecsize, 2.0 * nvecsize * sizeof(float), 0.0);
+		if (aussie_bench_run(res, aussie_bench_vector_call, &args, aussie_bench_vector_reset)) aussie_bench_report(res);
 	}
-
-	if (floatvectorfnptr) {  // Functions that return FLOAT on 2 vectors
-		float c = 0.0;
-		float a = 555.5;
-		float b = 555.5;
-		float f = 0.0;
-		for (int i = 0; i <= niter; i++) {
-			// Re-copy test vector fast with memcpy
-			//memcpy(v1, vtemp, memcopybytes); // No need to copy, it's a read-only function like vecdot...
-			//memcpy(v2, vtemp, memcopybytes);
-			f = floatvectorfnptr(v1, v2, nvecsize);
-		}
+	else {  // Read-only like vecdot (no need to copy)
+		aussie_bench_result_init(res, name, nvecsize, 2.0 * nvecsize * sizeof(float), 2.0 * nvecsize);
+		if (aussie_bench_run(res, aussie_bench_vector_call, &args, NULL)) aussie_bench_report(res);
 	}
-
-	unsigned long after_us = clock();  // After time
-	int diff = after_us - start_us;
-
-	fprintf(stdout, "%s: %d ticks (%3.2f seconds)\n", name, diff, diff / (double)CLOCKS_PER_SEC);
-
 }
 
 void aussie_benchmark_matrix_matrix_multiplication()
@@ -352,30 +797,30 @@ void aussie_benchmark_matrix_matrix_multiplication()
 	long int thousand = 1000;
 	long int million = 1000000;
 	long int billion = 1000 * million;
-	long int niter = 1 * 1;
 	int nvecsize = AUSSIE_MATRIX_ROWS; //  512 * 2;  // How big a matrix/vector to test... N elements
 
 	// Matrix-matrix multiply
-	printf("Matrix-Matrix multiplication (MatMul) benchmarks (N=%d, ITER=%d):\n", nvecsize, niter);
-	run_matrix_matrix_matmul("Matrix-matrix fake transpose AVX1 unrolled 4", niter, nvecsize, aussie_matmul_matrix_fake_transpose_vecdot_AVX1_inlined_unrolled4);
+	aussie_bench_printf("Matrix-Matrix multiplication (MatMul) benchmarks (N=%d):\n", nvecsize);
+	run_matrix_matrix_matmul("Matrix-matrix blocked GEMM (packed panels, dispatched microkernel)", nvecsize, aussie_matmul_matrix_gemm);
+	run_matrix_matrix_matmul("Matrix-matrix fake transpose AVX1 unrolled 4", nvecsize, aussie_matmul_matrix_fake_transpose_vecdot_AVX1_inlined_unrolled4);
 
 	
 
-	run_matrix_matrix_matmul("Matrix-matrix fake transpose AVX1 inlined", niter, nvecsize, aussie_matmul_matrix_fake_transpose_vecdot_AVX1_inlined);
-	run_matrix_matrix_matmul("Matrix-matrix fake transpose AVX2 inlined", niter, nvecsize, aussie_matmul_matrix_fake_transpose_vecdot_AVX2_inlined);
-	run_matrix_matrix_matmul("Matrix-matrix fake transpose AVX1", niter, nvecsize, aussie_matmul_matrix_fake_transpose_vecdot_AVX1);
-	run_matrix_matrix_matmul("Matrix-matrix fake transpose AVX2", niter, nvecsize, aussie_matmul_matrix_fake_transpose_vecdot_AVX2);
+	run_matrix_matrix_matmul("Matrix-matrix fake transpose AVX1 inlined", nvecsize, aussie_matmul_matrix_fake_transpose_vecdot_AVX1_inlined);
+	run_matrix_matrix_matmul("Matrix-matrix fake transpose AVX2 inlined", nvecsize, aussie_matmul_matrix_fake_transpose_vecdot_AVX2_inlined);
+	run_matrix_matrix_matmul("Matrix-matrix fake transpose AVX1", nvecsize, aussie_matmul_matrix_fake_transpose_vecdot_AVX1);
+	run_matrix_matrix_matmul("Matrix-matrix fake transpose AVX2", nvecsize, aussie_matmul_matrix_fake_transpose_vecdot_AVX2);
 
-	run_matrix_matrix_matmul("Matrix-matrix fake transpose unrolled 4", niter, nvecsize, aussie_matmul_matrix_fake_transpose_unrolled4);
-	run_matrix_matrix_matmul("Matrix-matrix fake transpose unrolled 8", niter, nvecsize, aussie_matmul_matrix_fake_transpose_unrolled8);
+	run_matrix_matrix_matmul("Matrix-matrix fake transpose unrolled 4", nvecsize, aussie_matmul_matrix_fake_transpose_unrolled4);
+	run_matrix_matrix_matmul("Matrix-matrix fake transpose unrolled 8", nvecsize, aussie_matmul_matrix_fake_transpose_unrolled8);
 
 	
-	run_matrix_matrix_matmul("Matrix-matrix fake transpose", niter, nvecsize, aussie_matmul_matrix_fake_transpose);
+	run_matrix_matrix_matmul("Matrix-matrix fake transpose", nvecsize, aussie_matmul_matrix_fake_transpose);
 
-	run_matrix_matrix_matmul("Matrix-matrix basic unrolled 4", niter, nvecsize, aussie_matmul_matrix_unrolled4);
+	run_matrix_matrix_matmul("Matrix-matrix basic unrolled 4", nvecsize, aussie_matmul_matrix_unrolled4);
 
-	run_matrix_matrix_matmul("Matrix-matrix mult basic", niter, nvecsize, aussie_matmul_matrix_basic);
-	run_matrix_matrix_matmul("Matrix-matrix mult hoisted", niter, nvecsize, aussie_matmul_matrix_hoisted);
+	run_matrix_matrix_matmul("Matrix-matrix mult basic", nvecsize, aussie_matmul_matrix_basic);
+	run_matrix_matrix_matmul("Matrix-matrix mult hoisted", nvecsize, aussie_matmul_matrix_hoisted);
 	
 }
 
@@ -384,58 +829,666 @@ void aussie_benchmark_matrix_vector_multiply()
 	long int thousand = 1000;
 	long int million = 1000000;
 	long int billion = 1000 * million;
-	long int niter = 3 * 100;
 	int nvecsize = AUSSIE_MATRIX_ROWS; //  512 * 2;  // How big a matrix/vector to test... N elements
 
 	// Matrix-vector multiply
-	printf("Matrix-Vector multiplication (MatMulVec) benchmarks (N=%d, ITER=%d):\n", nvecsize, niter);
-	run_matrix_float_N("Matrix-vector nested tiled 2x2", niter, nvecsize, aussie_matmul_vector_tiled_2x2);
-	run_matrix_float_N("Matrix-vector nested tiled 2x2 better", niter, nvecsize, aussie_matmul_vector_tiled_2x2_better);
-	run_matrix_float_N("Matrix-vector nested tiled 2x2 hoisted", niter, nvecsize, aussie_matmul_vector_tiled_2x2_better_hoisted);
-	run_matrix_float_N("Matrix-vector nested tiled 4x4", niter, nvecsize, aussie_matmul_vector_tiled_4x4);
-	run_matrix_float_N("Matrix-vector nested tiled 4x4 CSE", niter, nvecsize, aussie_matmul_vector_tiled_4x4_CSE);
-	run_matrix_float_N("Matrix-vector nested tiled 4x4 CSE+hoisted", niter, nvecsize, aussie_matmul_vector_tiled_4x4_CSE2);
+	aussie_bench_printf("Matrix-Vector multiplication (MatMulVec) benchmarks (N=%d):\n", nvecsize);
+	run_matrix_float_N("Matrix-vector nested tiled 2x2", nvecsize, aussie_matmul_vector_tiled_2x2);
+	run_matrix_float_N("Matrix-vector nested tiled 2x2 better", nvecsize, aussie_matmul_vector_tiled_2x2_better);
+	run_matrix_float_N("Matrix-vector nested tiled 2x2 hoisted", nvecsize, aussie_matmul_vector_tiled_2x2_better_hoisted);
+	run_matrix_float_N("Matrix-vector nested tiled 4x4", nvecsize, aussie_matmul_vector_tiled_4x4);
+	run_matrix_float_N("Matrix-vector nested tiled 4x4 CSE", nvecsize, aussie_matmul_vector_tiled_4x4_CSE);
+	run_matrix_float_N("Matrix-vector nested tiled 4x4 CSE+hoisted", nvecsize, aussie_matmul_vector_tiled_4x4_CSE2);
 
 	
 
-	run_matrix_float_N("Matrix-vector nested interchange (basic)", niter, nvecsize, aussie_matmul_vector_basic_interchange);
-	run_matrix_float_N("Matrix-vector nested interchange (hoisted)", niter, nvecsize, aussie_matmul_vector_hoisted_interchange);
+	run_matrix_float_N("Matrix-vector nested interchange (basic)", nvecsize, aussie_matmul_vector_basic_interchange);
+	run_matrix_float_N("Matrix-vector nested interchange (hoisted)", nvecsize, aussie_matmul_vector_hoisted_interchange);
 
 	
 
-	run_matrix_float_N("Matrix-vector row-wise vecdot", niter, nvecsize, aussie_matmul_vector_basic_out1);
-	run_matrix_float_N("Matrix-vector nested loops", niter, nvecsize, aussie_matmul_vector_basic_out2);
-	run_matrix_float_N("Matrix-vector nested loops simpler", niter, nvecsize, aussie_matmul_vector_basic_out3);
-	run_matrix_float_N("Matrix-vector nested row-wise hoisted", niter, nvecsize, aussie_matmul_vector_basic_out2_rowwise);
-	run_matrix_float_N("Matrix-vector nested ptr-arith", niter, nvecsize, aussie_matmul_vector_basic_out2_pointer_arith);
-	run_matrix_float_N("Matrix-vector unrolled inner (4)", niter, nvecsize, aussie_matmul_vector_unrolled4);
-	// Buggy! run_matrix_float_N("Matrix-vector unrolled inner (4B)", niter, nvecsize, aussie_matmul_vector_unrolled4b);
-	run_matrix_float_N("Matrix-vector unrolled inner (8)", niter, nvecsize, aussie_matmul_vector_unrolled8);
-	//run_matrix_float_N("Matrix-vector unrolled inner (8B)", niter, nvecsize, aussie_matmul_vector_unrolled8b);
+	run_matrix_float_N("Matrix-vector row-wise vecdot", nvecsize, aussie_matmul_vector_basic_out1);
+	run_matrix_float_N("Matrix-vector nested loops", nvecsize, aussie_matmul_vector_basic_out2);
+	run_matrix_float_N("Matrix-vector nested loops simpler", nvecsize, aussie_matmul_vector_basic_out3);
+	run_matrix_float_N("Matrix-vector nested row-wise hoisted", nvecsize, aussie_matmul_vector_basic_out2_rowwise);
+	run_matrix_float_N("Matrix-vector nested ptr-arith", nvecsize, aussie_matmul_vector_basic_out2_pointer_arith);
+	run_matrix_float_N("Matrix-vector unrolled inner (4)", nvecsize, aussie_matmul_vector_unrolled4);
+	// Buggy! run_matrix_float_N("Matrix-vector unrolled inner (4B)", nvecsize, aussie_matmul_vector_unrolled4b);
+	run_matrix_float_N("Matrix-vector unrolled inner (8)", nvecsize, aussie_matmul_vector_unrolled8);
+	//run_matrix_float_N("Matrix-vector unrolled inner (8B)", nvecsize, aussie_matmul_vector_unrolled8b);
 
 	
 
-	run_matrix_float_N("Matrix-vector vecdot AVX1 DP", niter, nvecsize, aussie_matmul_vector_vecdot_AVX1);
-	run_matrix_float_N("Matrix-vector vecdot AVX2 FMA", niter, nvecsize, aussie_matmul_vector_vecdot_AVX2);
+	run_matrix_float_N("Matrix-vector vecdot AVX1 DP", nvecsize, aussie_matmul_vector_vecdot_AVX1);
+	run_matrix_float_N("Matrix-vector vecdot AVX2 FMA", nvecsize, aussie_matmul_vector_vecdot_AVX2);
+
+
+}
+
+struct aussie_bench_gemv_args {
+	float* W;
+	float* Wplaced;
+	float* v;
+	float* vout;
+	int nrows, ncols;
+	int chunk;
+};
+
+static void aussie_bench_gemv_call(void* arg)
+{
+	aussie_bench_gemv_args* args = (aussie_bench_gemv_args*)arg;
+	aussie_gemv_parallel(args->Wplaced, args->nrows, args->ncols, args->ncols, args->v, args->vout, args->chunk);
+}
+
+void aussie_benchmark_matrix_vector_parallel()  // Thread scaling of the parallel GEMV
+{
+	// Wall-clock time here (the harness uses the monotonic clock, not the CPU time of all threads)
+	int nrows = 4096 * 2, ncols = 4096;  // 128MB of weights: bigger than cache, like decode
+	aussie_bench_gemv_args args;
+	args.W = (float*)malloc((size_t)nrows * ncols * sizeof(float));
+	args.Wplaced = (float*)malloc((size_t)nrows * ncols * sizeof(float));
+	args.v = (float*)malloc(ncols * sizeof(float));
+	args.vout = (float*)malloc(nrows * sizeof(float));
+	args.nrows = nrows;
+	args.ncols = ncols;
+	if (!args.W || !args.Wplaced || !args.v || !args.vout) {
+		yassert(args.W && args.Wplaced && args.v && args.vout);
+		free(args.W); free(args.Wplaced); free(args.v); free(args.vout);
+		return;  // fail
+	}
+	for (long long i = 0; i < (long long)nrows * ncols; i++) args.W[i] = (float)(i % 7) / 7.0f;
+	for (int j = 0; j < ncols; j++) args.v[j] = (float)(j % 5) / 5.0f;
+
+	int maxthreads = (int)std::thread::hardware_concurrency();
+	if (maxthreads < 1) maxthreads = 1;
+	aussie_bench_printf("Parallel matrix-vector (GEMV) scaling benchmarks (%dx%d, %d cores):\n", nrows, ncols, maxthreads);
+	double onethread_ns = 0.0;
+	for (int nthreads = 1; ; nthreads *= 2) {
+		if (nthreads > maxthreads) nthreads = maxthreads;
+		aussie_thread_pool_shutdown();
+		aussie_thread_pool_init(nthreads);
+		aussie_gemv_place_rows(args.Wplaced, args.W, nrows, ncols, ncols);  // Owners first-touch their rows
+
+		int chunks[] = { 0, 64 };
+		for (int c = 0; c < 2; c++) {
+			args.chunk = chunks[c];
+			char name[100];
+			sprintf(name, "GEMV %d threads %s", nthreads, chunks[c] == 0 ? "static" : "dynamic");
+			aussie_bench_result res;
+			aussie_bench_result_init(res, name, (long)nrows * ncols, (double)nrows * ncols * sizeof(float), 2.0 * nrows * ncols);
+			if (!aussie_bench_run(res, aussie_bench_gemv_call, &args, NULL)) continue;
+			aussie_bench_report(res);
+			if (nthreads == 1 && c == 0) onethread_ns = res.ns_median;
+			aussie_bench_printf("... speedup %3.2fx\n", onethread_ns / res.ns_median);
+		}
+		if (nthreads >= maxthreads) break;
+	}
+	aussie_thread_pool_shutdown();  // Back to the default size on next use
+	free(args.W); free(args.Wplaced); free(args.v); free(args.vout);
+}
+
+struct aussie_bench_q8_args {
+	const aussie_q8_matrix* m;
+	aussie_q8_vector* x;
+	const float* v;
+	float* vout;
+};
+
+static void aussie_bench_q8_gemv_call(void* arg)
+{
+	aussie_bench_q8_args* args = (aussie_bench_q8_args*)arg;
+	aussie_q8_gemv(*args->m, args->v, *args->x, args->vout);  // Includes quantizing the input
+}
+
+struct aussie_bench_q4_args {
+	const aussie_q4_matrix* m;
+	const float* v;
+	float* vout;
+};
+
+static void aussie_bench_q4_gemv_call(void* arg)
+{
+	aussie_bench_q4_args* args = (aussie_bench_q4_args*)arg;
+	aussie_q4_gemv(*args->m, args->v, args->vout);
+}
+
+void aussie_benchmark_quant_gemv()  // INT8 GEMV (per-row and grouped scales) versus FP32
+{
+	int nrows = 4096 * 2, ncols = 4096;  // Same shape as the parallel GEMV benchmark
+	aussie_bench_gemv_args args;
+	args.W = (float*)malloc((size_t)nrows * ncols * sizeof(float));
+	args.Wplaced = args.W;
+	args.v = (float*)malloc(ncols * sizeof(float));
+	args.vout = (float*)malloc(nrows * sizeof(float));
+	args.nrows = nrows;
+	args.ncols = ncols;
+	args.chunk = 0;
+	if (!args.W || !args.v || !args.vout) {
+		yassert(args.W && args.v && args.vout);
+		free(args.W); free(args.v); free(args.vout);
+		return;  // fail
+	}
+	for (long long i = 0; i < (long long)nrows * ncols; i++) args.W[i] = (float)(i % 7) / 7.0f - 0.5f;
+	for (int j = 0; j < ncols; j++) args.v[j] = (float)(j % 5) / 5.0f;
+
+	aussie_bench_printf("INT8 quantized GEMV benchmarks (%dx%d):\n", nrows, ncols);
+	aussie_bench_result res;
+	aussie_bench_result_init(res, "GEMV FP32", (long)nrows * ncols, (double)nrows * ncols * sizeof(float), 2.0 * nrows * ncols);
+	if (aussie_bench_run(res, aussie_bench_gemv_call, &args, NULL)) aussie_bench_report(res);
+	double fp32_ns = res.ns_median;
+
+	int groups[] = { 0, 32, 128 };
+	for (int k = 0; k < 3; k++) {
+		aussie_q8_matrix m;
+		aussie_q8_vector x;
+		if (!aussie_q8_matrix_quantize(m, args.W, nrows, ncols, ncols, groups[k])) continue;
+		if (!aussie_q8_vector_init(x, m)) {
+			aussie_q8_matrix_free(m);
+			continue;
+		}
+		aussie_bench_q8_args qargs = { &m, &x, args.v, args.vout };
+		char name[100];
+		if (groups[k] == 0) sprintf(name, "GEMV INT8 per-row");
+		else sprintf(name, "GEMV INT8 group %d", groups[k]);
+		double bytes = (double)nrows * m.ldq + (double)nrows * m.ngroups * sizeof(float);  // Weights and scales
+		aussie_bench_result_init(res, name, (long)nrows * ncols, bytes, 2.0 * nrows * ncols);
+		if (aussie_bench_run(res, aussie_bench_q8_gemv_call, &qargs, NULL)) {
+			aussie_bench_report(res);
+			if (fp32_ns > 0.0) aussie_bench_printf("... speedup %3.2fx versus FP32\n", fp32_ns / res.ns_median);
+		}
+		aussie_q8_vector_free(x);
+		aussie_q8_matrix_free(m);
+	}
+
+	// 4-bit groups (FP16 scales, optional min)
+	for (int k = 0; k < 3; k++) {
+		int groupsize = (k == 0) ? 32 : 64;
+		bool with_min = (k == 2);
+		aussie_q4_matrix m;
+		if (!aussie_q4_matrix_quantize(m, args.W, nrows, ncols, ncols, groupsize, with_min)) continue;
+		aussie_bench_q4_args qargs = { &m, args.v, args.vout };
+		char name[100];
+		sprintf(name, "GEMV Q4 group %d%s", groupsize, with_min ? " min" : "");
+		double bytes = (double)nrows * m.ldq / 2 + (double)nrows * m.ngroups * sizeof(yfp16_t) * (with_min ? 2 : 1);
+		aussie_bench_result_init(res, name, (long)nrows * ncols, bytes, 2.0 * nrows * ncols);
+		if (aussie_bench_run(res, aussie_bench_q4_gemv_call, &qargs, NULL)) {
+			aussie_bench_report(res);
+			if (fp32_ns > 0.0) aussie_bench_printf("... speedup %3.2fx versus FP32\n", fp32_ns / res.ns_median);
+		}
+		aussie_q4_matrix_free(m);
+	}
+	free(args.W); free(args.v); free(args.vout);
+
+	// Q4 accuracy versus the FP32 reference GEMV (aussie_matmul_vector_basic_out1)
+	ymatrix* pW = (ymatrix*)malloc(sizeof(ymatrix));
+	float* v = (float*)malloc(AUSSIE_MATRIX_ROWS * sizeof(float));
+	if (!pW || !v) {
+		yassert(pW && v);
+		free(pW); free(v);
+		return;  // fail
+	}
+	unsigned int seed = 1;
+	for (int i = 0; i < AUSSIE_MATRIX_ROWS; i++) {
+		for (int j = 0; j < AUSSIE_MATRIX_COLUMNS; j++) {
+			seed = seed * 1103515245u + 12345u;
+			(*pW)[i][j] = (float)((seed >> 8) % 20001) / 10000.0f - 1.0f;  // Uniform [-1,1]
+		}
+		v[i] = (float)(i % 9) / 9.0f - 0.5f;
+	}
+	for (int k = 0; k < 4; k++) {
+		int groupsize = (k < 2) ? 32 : 64;
+		bool with_min = (k % 2) == 1;
+		aussie_q4_matrix m;
+		aussie_quant_error err;
+		if (!aussie_q4_matrix_quantize(m, &(*pW)[0][0], AUSSIE_MATRIX_ROWS, AUSSIE_MATRIX_COLUMNS, AUSSIE_MATRIX_COLUMNS, groupsize, with_min)) continue;
+		char name[100];
+		sprintf(name, "Q4 group %d%s error (%dx%d)", groupsize, with_min ? " min" : "", AUSSIE_MATRIX_ROWS, AUSSIE_MATRIX_COLUMNS);
+		if (aussie_q4_error(m, *pW, v, err) && g_aussie_bench_config.format == AUSSIE_BENCH_TEXT) {  // Titles were printed, so the config is read
+			aussie_quant_error_print(g_aussie_bench_config.fp ? g_aussie_bench_config.fp : stdout, name, err);
+		}
+		aussie_q4_matrix_free(m);
+	}
+	free(pW); free(v);
+}
+
+struct aussie_bench_half_args {
+	const yfp16_t* W;  // FP16 or BF16
+	const yfp8_t* W8;  // FP8 (with scales)
+	const float* scales;
+	int format;        // AUSSIE_HALF_*
+	const float* v;
+	float* vout;
+	int nrows, ncols;
+};
+
+static void aussie_bench_half_gemv_call(void* arg)
+{
+	aussie_bench_half_args* args = (aussie_bench_half_args*)arg;
+	if (args->format == AUSSIE_HALF_FP8_E4M3) aussie_gemv_fp8(AUSSIE_FP8_E4M3, args->W8, args->scales, args->nrows, args->ncols, args->ncols, args->v, args->vout);
+	else if (args->format == AUSSIE_HALF_FP8_E5M2) aussie_gemv_fp8(AUSSIE_FP8_E5M2, args->W8, args->scales, args->nrows, args->ncols, args->ncols, args->v, args->vout);
+	else if (args->format == AUSSIE_HALF_BF16) aussie_gemv_bf16(args->W, args->nrows, args->ncols, args->ncols, args->v, args->vout);
+	else aussie_gemv_fp16(args->W, args->nrows, args->ncols, args->ncols, args->v, args->vout);
+}
+
+void aussie_benchmark_half_gemv()  // FP16, BF16 and FP8 weights (FP32 accumulation) versus FP32 GEMV
+{
+	int nrows = 4096 * 2, ncols = 4096;  // Same shape as the quantized GEMV benchmark
+	long long nw = (long long)nrows * ncols;
+	aussie_bench_gemv_args args;
+	args.W = (float*)malloc(nw * sizeof(float));
+	args.Wplaced = args.W;
+	args.v = (float*)malloc(ncols * sizeof(float));
+	args.vout = (float*)malloc(nrows * sizeof(float));
+	args.nrows = nrows;
+	args.ncols = ncols;
+	args.chunk = 0;
+	yfp16_t* Wh = (yfp16_t*)malloc(nw * sizeof(yfp16_t));
+	yfp8_t* W8 = (yfp8_t*)malloc(nw * sizeof(yfp8_t));
+	float* scales = (float*)malloc(nrows * sizeof(float));
+	if (!args.W || !args.v || !args.vout || !Wh || !W8 || !scales) {
+		yassert(args.W && args.v && args.vout && Wh && W8 && scales);
+		free(args.W); free(args.v); free(args.vout); free(Wh); free(W8); free(scales);
+		return;  // fail
+	}
+	for (long long i = 0; i < nw; i++) args.W[i] = (float)(i % 7) / 7.0f - 0.5f;
+	for (int j = 0; j < ncols; j++) args.v[j] = (float)(j % 5) / 5.0f;
+
+	aussie_bench_printf("FP16/BF16/FP8 weight GEMV benchmarks (%dx%d, FP32 accumulation):\n", nrows, ncols);
+	aussie_bench_result res;
+	aussie_bench_result_init(res, "GEMV FP32", (long)nw, (double)nw * sizeof(float), 2.0 * nw);
+	if (aussie_bench_run(res, aussie_bench_gemv_call, &args, NULL)) aussie_bench_report(res);
+	double fp32_ns = res.ns_median;
+
+	const char* names[] = { "GEMV FP16", "GEMV BF16", "GEMV FP8 E4M3", "GEMV FP8 E5M2" };
+	for (int format = AUSSIE_HALF_FP16; format <= AUSSIE_HALF_FP8_E5M2; format++) {
+		double bytes = (double)nw * sizeof(yfp16_t);
+		if (format == AUSSIE_HALF_FP8_E4M3 || format == AUSSIE_HALF_FP8_E5M2) {
+			aussie_fp8_quantize_rows(format == AUSSIE_HALF_FP8_E5M2 ? AUSSIE_FP8_E5M2 : AUSSIE_FP8_E4M3, args.W, nrows, ncols, ncols, W8, ncols, scales);
+			bytes = (double)nw * sizeof(yfp8_t) + (double)nrows * sizeof(float);
+		}
+		else if (format == AUSSIE_HALF_BF16) aussie_float32_to_bfloat16_array(args.W, Wh, (int)nw);
+		else aussie_float32_to_float16_array(args.W, Wh, (int)nw);
+		aussie_bench_half_args hargs = { Wh, W8, scales, format, args.v, args.vout, nrows, ncols };
+		aussie_bench_result_init(res, names[format], (long)nw, bytes, 2.0 * nw);
+		if (aussie_bench_run(res, aussie_bench_half_gemv_call, &hargs, NULL)) {
+			aussie_bench_report(res);
+			if (fp32_ns > 0.0) aussie_bench_printf("... speedup %3.2fx versus FP32\n", fp32_ns / res.ns_median);
+		}
+	}
+	free(args.W); free(args.v); free(args.vout); free(Wh); free(W8); free(scales);
+
+	// Accuracy versus the FP32 reference GEMV (aussie_matmul_vector_basic_out1)
+	ymatrix* pW = (ymatrix*)malloc(sizeof(ymatrix));
+	float* v = (float*)malloc(AUSSIE_MATRIX_ROWS * sizeof(float));
+	if (!pW || !v) {
+		yassert(pW && v);
+		free(pW); free(v);
+		return;  // fail
+	}
+	unsigned int seed = 1;
+	for (int i = 0; i < AUSSIE_MATRIX_ROWS; i++) {
+		for (int j = 0; j < AUSSIE_MATRIX_COLUMNS; j++) {
+			seed = seed * 1103515245u + 12345u;
+			(*pW)[i][j] = (float)((seed >> 8) % 20001) / 10000.0f - 1.0f;  // Uniform [-1,1]
+		}
+		v[i] = (float)(i % 9) / 9.0f - 0.5f;
+	}
+	const char* errnames[] = { "FP16 error", "BF16 error", "FP8 E4M3 error", "FP8 E5M2 error" };
+	for (int format = AUSSIE_HALF_FP16; format <= AUSSIE_HALF_FP8_E5M2; format++) {
+		aussie_quant_error err;
+		if (aussie_half_error(format, *pW, v, err) && g_aussie_bench_config.format == AUSSIE_BENCH_TEXT) {
+			aussie_quant_error_print(g_aussie_bench_config.fp ? g_aussie_bench_config.fp : stdout, errnames[format], err);
+		}
+	}
+	free(pW); free(v);
+}
 
+struct aussie_bench_convert_args {
+	float* f;        // FP32 side
+	yfp16_t* h;      // 16-bit side (FP16 or BF16)
+	int n;
+	void (*tohalf)(const float src[], yfp16_t dst[], int n);   // One of these
+	void (*tofloat)(const yfp16_t src[], float dst[], int n);
+};
 
+static void aussie_bench_convert_call(void* arg)
+{
+	aussie_bench_convert_args* args = (aussie_bench_convert_args*)arg;
+	if (args->tohalf) args->tohalf(args->f, args->h, args->n);
+	else args->tofloat(args->h, args->f, args->n);
+	g_aussie_bench_sink += (float)args->h[args->n / 2];
+}
+
+void aussie_benchmark_float_conversions()  // FP32 to/from FP16 and BF16 arrays: scalar versus SIMD
+{
+	int n = 16 * 1024 * 1024;  // 64MB of floats (bigger than cache, like a weight tensor)
+	float* f = (float*)malloc(n * sizeof(float));
+	yfp16_t* h = (yfp16_t*)malloc(n * sizeof(yfp16_t));
+	if (!f || !h) {
+		yassert(f && h);
+		free(f); free(h);
+		return;  // fail
+	}
+	for (int i = 0; i < n; i++) f[i] = (float)((i * 7919) % 20000) * 0.01f - 100.0f;
+	aussie_float32_to_float16_array(f, h, n);
+
+	bool f16c = aussie_cpu_has_avx2() && aussie_cpu_detect().f16c;
+	bool avx2 = aussie_cpu_has_avx2();
+	bool avx512 = aussie_cpu_has_avx512();
+	struct {
+		const char* name;
+		bool ok;
+		void (*tohalf)(const float src[], yfp16_t dst[], int n);
+		void (*tofloat)(const yfp16_t src[], float dst[], int n);
+	} kernels[] = {
+		{ "FP32->FP16 basic", true, aussie_float32_to_float16_array_basic, NULL },
+		{ "FP32->FP16 F16C", f16c, aussie_float32_to_float16_array_F16C, NULL },
+		{ "FP32->FP16 AVX-512", avx512, aussie_float32_to_float16_array_AVX512, NULL },
+		{ "FP16->FP32 basic", true, NULL, aussie_float16_to_float32_array_basic },
+		{ "FP16->FP32 F16C", f16c, NULL, aussie_float16_to_float32_array_F16C },
+		{ "FP16->FP32 AVX-512", avx512, NULL, aussie_float16_to_float32_array_AVX512 },
+		{ "FP32->BF16 basic", true, aussie_float32_to_bfloat16_array_basic, NULL },
+		{ "FP32->BF16 AVX2", avx2, aussie_float32_to_bfloat16_array_AVX2, NULL },
+		{ "BF16->FP32 basic", true, NULL, aussie_bfloat16_to_float32_array_basic },
+		{ "BF16->FP32 AVX2", avx2, NULL, aussie_bfloat16_to_float32_array_AVX2 },
+	};
+	aussie_bench_printf("Float conversion benchmarks (N=%d, GB/sec read plus written)\n", n);
+	aussie_bench_convert_args args;
+	args.f = f;
+	args.h = h;
+	args.n = n;
+	for (int k = 0; k < (int)(sizeof(kernels) / sizeof(kernels[0])); k++) {
+		if (!kernels[k].ok) continue;
+		args.tohalf = kernels[k].tohalf;
+		args.tofloat = kernels[k].tofloat;
+		aussie_bench_result res;
+		aussie_bench_result_init(res, kernels[k].name, n, (double)n * (sizeof(float) + sizeof(yfp16_t)), 0.0);
+		if (aussie_bench_run(res, aussie_bench_convert_call, &args, NULL)) aussie_bench_report(res);
+	}
+	free(f); free(h);
+}
+
+struct aussie_bench_lut_args {
+	const float* in;
+	float* out;
+	int n;
+	const aussie_lut* lut;
+	aussie_lut_apply_fnptr apply;   // Table version, or
+	float (*exact)(float);          // the exact function
+};
+
+static void aussie_bench_lut_call(void* arg)
+{
+	aussie_bench_lut_args* args = (aussie_bench_lut_args*)arg;
+	if (args->apply) args->apply(*args->lut, args->in, args->out, args->n);
+	else {
+		for (int i = 0; i < args->n; i++) args->out[i] = args->exact(args->in[i]);
+	}
+	g_aussie_bench_sink += args->out[args->n / 2];
+}
+
+static float aussie_bench_expf(float x) { return expf(x); }
+
+void aussie_benchmark_lut_activations()  // Interpolated tables versus the exact functions
+{
+	int n = 64 * 1024;  // 256KB in, 256KB out (L2)
+	float* in = (float*)malloc(n * sizeof(float));
+	float* out = (float*)malloc(n * sizeof(float));
+	if (!in || !out) {
+		yassert(in && out);
+		free(in); free(out);
+		return;  // fail
+	}
+	for (int i = 0; i < n; i++) in[i] = (float)((i * 7919) % 20000) * 0.001f - 10.0f;  // [-10,10]
+
+	bool avx2 = aussie_cpu_has_avx2();
+	bool avx512 = aussie_cpu_has_avx512();
+	struct {
+		const char* name;
+		bool ok;
+		int fn;
+		aussie_lut_apply_fnptr apply;
+		float (*exact)(float);
+	} kernels[] = {
+		{ "GELU exact (erff)", true, AUSSIE_LUT_GELU, NULL, aussie_GELU_basic },
+		{ "GELU LUT basic", true, AUSSIE_LUT_GELU, aussie_lut_apply_basic, NULL },
+		{ "GELU LUT AVX2", avx2, AUSSIE_LUT_GELU, aussie_lut_apply_AVX2, NULL },
+		{ "GELU LUT AVX-512", avx512, AUSSIE_LUT_GELU, aussie_lut_apply_AVX512, NULL },
+		{ "SiLU exact", true, AUSSIE_LUT_SILU, NULL, aussie_SiLU_basic },
+		{ "SiLU LUT AVX-512", avx512, AUSSIE_LUT_SILU, aussie_lut_apply_AVX512, NULL },
+		{ "expf exact", true, AUSSIE_LUT_EXP, NULL, aussie_bench_expf },
+		{ "expf LUT basic", true, AUSSIE_LUT_EXP, aussie_lut_apply_basic, NULL },
+		{ "expf LUT AVX2", avx2, AUSSIE_LUT_EXP, aussie_lut_apply_AVX2, NULL },
+		{ "expf LUT AVX-512", avx512, AUSSIE_LUT_EXP, aussie_lut_apply_AVX512, NULL },
+	};
+	aussie_bench_printf("Activation LUT benchmarks (N=%d, quadratic %d-interval tables)\n", n, AUSSIE_LUT_DEFAULT_INTERVALS);
+	aussie_bench_lut_args args;
+	args.in = in;
+	args.out = out;
+	args.n = n;
+	for (int k = 0; k < (int)(sizeof(kernels) / sizeof(kernels[0])); k++) {
+		if (!kernels[k].ok) continue;
+		args.lut = aussie_lut_get(kernels[k].fn);
+		args.apply = kernels[k].apply;
+		args.exact = kernels[k].exact;
+		aussie_bench_result res;
+		aussie_bench_result_init(res, kernels[k].name, n, (double)n * 2 * sizeof(float), 0.0);
+		if (aussie_bench_run(res, aussie_bench_lut_call, &args, NULL)) aussie_bench_report(res);
+	}
+	free(in); free(out);
+}
+
+struct aussie_bench_activation_args {
+	const float* in;
+	float* work;
+	int n;
+	void (*vecfn)(float v[], int n);   // In-place vector kernel, or
+	const aussie_lut* lut;             // an interpolated table, or
+	float (*scalarfn)(float);          // a per-element function
+};
+
+static void aussie_bench_activation_call(void* arg)
+{
+	// Every variant starts from a copy of the input (in-place kernels would otherwise drift into denormals)
+	aussie_bench_activation_args* args = (aussie_bench_activation_args*)arg;
+	memcpy(args->work, args->in, args->n * sizeof(float));
+	if (args->vecfn) args->vecfn(args->work, args->n);
+	else if (args->lut) aussie_lut_apply(*args->lut, args->work, args->work, args->n);
+	else {
+		for (int i = 0; i < args->n; i++) args->work[i] = args->scalarfn(args->work[i]);
+	}
+	g_aussie_bench_sink += args->work[args->n / 2];
+}
+
+void aussie_benchmark_vector_activations()  // GELU, SiLU, sigmoid over one FFN vector
+{
+	int n = 14336;  // FFN width of an 8B model (11008 for 7B)
+	float* in = (float*)malloc(n * sizeof(float));
+	float* work = (float*)malloc(n * sizeof(float));
+	if (!in || !work) {
+		yassert(in && work);
+		free(in); free(work);
+		return;  // fail
+	}
+	for (int i = 0; i < n; i++) in[i] = (float)((i * 7919) % 16000) * 0.0005f - 4.0f;  // [-4,4]
+
+	bool avx2 = aussie_cpu_has_avx2();
+	bool avx512 = aussie_cpu_has_avx512();
+	const aussie_lut* lutnull = NULL;
+	struct {
+		const char* name;
+		bool ok;
+		void (*vecfn)(float v[], int n);
+		const aussie_lut* lut;
+		float (*scalarfn)(float);
+	} kernels[] = {
+		{ "GELU exact (erff)", true, aussie_vector_GELU_basic, lutnull, NULL },
+		{ "GELU tanh basic", true, aussie_vector_GELU_tanh, lutnull, NULL },
+		{ "GELU tanh AVX2", avx2, aussie_vector_GELU_tanh_AVX2, lutnull, NULL },
+		{ "GELU tanh AVX-512", avx512, aussie_vector_GELU_tanh_AVX512, lutnull, NULL },
+		{ "GELU sigmoid basic", true, aussie_vector_GELU_sigmoid, lutnull, NULL },
+		{ "GELU sigmoid AVX-512", avx512, aussie_vector_GELU_sigmoid_AVX512, lutnull, NULL },
+		{ "GELU LUT (dispatched)", true, NULL, aussie_lut_get(AUSSIE_LUT_GELU), NULL },
+		{ "GELU bf16 constexpr table", true, NULL, lutnull, aussie_GELU_table_bf16 },
+		{ "SiLU basic", true, aussie_vector_SiLU, lutnull, NULL },
+		{ "SiLU AVX2", avx2, aussie_vector_SiLU_AVX2, lutnull, NULL },
+		{ "SiLU AVX-512", avx512, aussie_vector_SiLU_AVX512, lutnull, NULL },
+		{ "SiLU LUT (dispatched)", true, NULL, aussie_lut_get(AUSSIE_LUT_SILU), NULL },
+		{ "sigmoid basic", true, aussie_vector_sigmoid, lutnull, NULL },
+		{ "sigmoid AVX2", avx2, aussie_vector_sigmoid_AVX2, lutnull, NULL },
+		{ "sigmoid AVX-512", avx512, aussie_vector_sigmoid_AVX512, lutnull, NULL },
+		{ "sigmoid LUT (dispatched)", true, NULL, aussie_lut_get(AUSSIE_LUT_SIGMOID), NULL },
+	};
+	aussie_bench_printf("Vector activation benchmarks (N=%d, including a copy of the input)\n", n);
+	aussie_bench_activation_args args;
+	args.in = in;
+	args.work = work;
+	args.n = n;
+	for (int k = 0; k < (int)(sizeof(kernels) / sizeof(kernels[0])); k++) {
+		if (!kernels[k].ok) continue;
+		args.vecfn = kernels[k].vecfn;
+		args.lut = kernels[k].lut;
+		args.scalarfn = kernels[k].scalarfn;
+		aussie_bench_result res;
+		aussie_bench_result_init(res, kernels[k].name, n, (double)n * 2 * sizeof(float), 0.0);
+		if (aussie_bench_run(res, aussie_bench_activation_call, &args, NULL)) aussie_bench_report(res);
+	}
+	free(in); free(work);
+}
+
+struct aussie_bench_ffn_args {
+	const aussie_ffn_weights* w;
+	const float* x;
+	float* h;
+	float* scratch;
+	int mode;  // 0 = unfused, 1 = fused (thread pool), 2 = fused forced ISA, 3 = whole FFN
+	int isa;
+};
+
+static void aussie_bench_ffn_call(void* arg)
+{
+	aussie_bench_ffn_args* args = (aussie_bench_ffn_args*)arg;
+	if (args->mode == 0) aussie_ffn_gated_hidden_unfused(*args->w, args->x, args->h, args->scratch);
+	else if (args->mode == 1) aussie_ffn_gated_hidden(*args->w, args->x, args->h);
+	else if (args->mode == 2) aussie_ffn_gated_hidden_isa(args->isa, *args->w, args->x, args->h);
+	else aussie_ffn_gated(*args->w, args->x, args->scratch);
+	g_aussie_bench_sink += args->h[1] + args->scratch[1];
+}
+
+void aussie_benchmark_gated_ffn()  // Fused SwiGLU hidden layer versus two GEMVs and separate passes
+{
+	int ndim = 2048, nhidden = 5632;  // 1B-class model (TinyLlama): 92MB of W1+W3, far bigger than the caches
+	size_t nw = (size_t)ndim * nhidden;
+	float* W1 = (float*)malloc(nw * sizeof(float));
+	float* W3 = (float*)malloc(nw * sizeof(float));
+	float* W2 = (float*)malloc(nw * sizeof(float));
+	float* x = (float*)malloc(ndim * sizeof(float));
+	float* h = (float*)malloc(nhidden * sizeof(float));
+	float* scratch = (float*)malloc(nhidden * sizeof(float));
+	if (!W1 || !W3 || !W2 || !x || !h || !scratch) {
+		yassert(W1 && W3 && W2 && x && h && scratch);
+		free(W1); free(W3); free(W2); free(x); free(h); free(scratch);
+		return;  // fail
+	}
+	for (size_t i = 0; i < nw; i++) {
+		W1[i] = (float)((i * 7919) % 1000) * 0.00002f - 0.01f;
+		W3[i] = (float)((i * 104729) % 1000) * 0.00002f - 0.01f;
+		W2[i] = (float)((i * 31) % 1000) * 0.00002f - 0.01f;
+	}
+	for (int i = 0; i < ndim; i++) x[i] = (float)(i % 97) * 0.02f - 1.0f;
+	aussie_ffn_weights w;
+	aussie_ffn_weights_init(w, AUSSIE_GLU_SWIGLU, W1, W3, W2, ndim, nhidden);
+
+	aussie_bench_printf("Gated FFN benchmarks (SwiGLU, %d x %d, %d threads; bytes = weights read)\n", ndim, nhidden, aussie_thread_count());
+	aussie_bench_ffn_args args;
+	args.w = &w;
+	args.x = x;
+	args.h = h;
+	args.scratch = scratch;
+	args.isa = AUSSIE_ISA_SCALAR;
+	double bytes13 = 2.0 * nw * sizeof(float);
+	double flops13 = 4.0 * nw;
+	struct {
+		const char* name;
+		bool ok;
+		int mode;
+		int isa;
+		double bytes;
+		double flops;
+	} runs[] = {
+		{ "Hidden unfused (2 GEMV + SiLU + multiply)", true, 0, 0, bytes13, flops13 },
+		{ "Hidden fused (dispatched)", true, 1, 0, bytes13, flops13 },
+		{ "Hidden fused AVX2, 1 thread", aussie_cpu_has_avx2(), 2, AUSSIE_ISA_AVX2, bytes13, flops13 },
+		{ "Hidden fused AVX-512, 1 thread", aussie_cpu_has_avx512(), 2, AUSSIE_ISA_AVX512, bytes13, flops13 },
+		{ "Whole FFN (fused hidden + W2 GEMV)", true, 3, 0, bytes13 * 1.5, flops13 * 1.5 },
+	};
+	for (int k = 0; k < (int)(sizeof(runs) / sizeof(runs[0])); k++) {
+		if (!runs[k].ok) continue;
+		args.mode = runs[k].mode;
+		args.isa = runs[k].isa;
+		aussie_bench_result res;
+		aussie_bench_result_init(res, runs[k].name, nhidden, runs[k].bytes, runs[k].flops);
+		if (aussie_bench_run(res, aussie_bench_ffn_call, &args, NULL)) aussie_bench_report(res);
+	}
+	free(W1); free(W3); free(W2); free(x); free(h); free(scratch);
+}
+
+struct aussie_bench_precompute_args {
+	float* arr;
+	int bits;
+	float (*fnptr)(float);
+	bool parallel;
+};
+
+static void aussie_bench_precompute_call(void* arg)
+{
+	aussie_bench_precompute_args* args = (aussie_bench_precompute_args*)arg;
+	if (args->parallel) aussie_precompute_table_FP32_generic_bits_parallel(args->arr, args->bits, args->fnptr);
+	else aussie_precompute_table_FP32_generic_bits(args->arr, args->bits, args->fnptr);
+	g_aussie_bench_sink += args->arr[(1 << args->bits) / 3];
+}
+
+void aussie_benchmark_precompute_tables()  // Table generation: one thread versus the thread pool
+{
+	int bits = 20;  // 1M entries (4MB); the 24-bit tables are 16x this
+	int n = 1 << bits;
+	float* arr = (float*)malloc(n * sizeof(float));
+	if (!arr) {
+		yassert(arr);
+		return;  // fail
+	}
+	aussie_bench_printf("Precomputed table generation (%d bits, %d threads; bf16 constexpr tables cost nothing at startup)\n",
+		bits, aussie_thread_count());
+	aussie_bench_precompute_args args;
+	args.arr = arr;
+	args.bits = bits;
+	args.fnptr = aussie_GELU_basic;
+	args.parallel = false;
+	aussie_bench_result res;
+	aussie_bench_result_init(res, "GELU table sequential", n, (double)n * sizeof(float), 0.0);
+	if (aussie_bench_run(res, aussie_bench_precompute_call, &args, NULL)) aussie_bench_report(res);
+	args.parallel = true;
+	aussie_bench_result_init(res, "GELU table parallel", n, (double)n * sizeof(float), 0.0);
+	if (aussie_bench_run(res, aussie_bench_precompute_call, &args, NULL)) aussie_bench_report(res);
+	free(arr);
 }
 
 void aussie_benchmark_vector_exponentiation_operations()  // Vector expf benchmarks...
 {
 	long int million = 1000000;
 	long int billion = 1000 * million;
-	long int niter = 100 * 1000;
 	int nvecsize = 512 * 2;  // How big a vector to test... N elements
 
 	// Exponentiation of all elements of a vector (SIMD expf)
-	printf("Vector-exponentiation operation benchmarks (N=%d, ITER=%d):\n", nvecsize, niter);
-	run_vector_float_N_non_const("Vector expf basic", niter, nvecsize, aussie_vector_expf);
-	run_vector_float_N_non_const("Vector expf pointer-arith", niter, nvecsize, aussie_vector_expf_pointer_arith);
-#if !LINUX
-	run_vector_float_N_non_const("Vector expf AVX1", niter, nvecsize, aussie_vector_expf_AVX1);
-	run_vector_float_N_non_const("Vector expf AVX2", niter, nvecsize, aussie_vector_expf_AVX2);
-#endif //LINUX
+	aussie_bench_printf("Vector-exponentiation operation benchmarks (N=%d):\n", nvecsize);
+	run_vector_float_N_non_const("Vector expf basic", nvecsize, aussie_vector_expf);
+	run_vector_float_N_non_const("Vector expf pointer-arith", nvecsize, aussie_vector_expf_pointer_arith);
+#if AUSSIE_X86
+	if (aussie_cpu_has_avx()) run_vector_float_N_non_const("Vector expf AVX1", nvecsize, aussie_vector_expf_AVX1);
+	if (aussie_cpu_has_avx2()) run_vector_float_N_non_const("Vector expf AVX2", nvecsize, aussie_vector_expf_AVX2);
+	if (aussie_cpu_has_avx512()) run_vector_float_N_non_const("Vector expf AVX-512", nvecsize, aussie_vector_expf_AVX512);
+#endif //AUSSIE_X86
+	run_vector_float_N_non_const("Vector expf dispatched", nvecsize, aussie_vector_expf_dispatch);
 
 	
 
@@ -445,19 +1498,26 @@ void aussie_benchmark_vector_scalar_operations()  // Vector-scalar benchmarks...
 {
 	long int million = 1000000;
 	long int billion = 1000 * million;
-	long int niter = 1 * million;
 	int nvecsize = 512 * 2;  // How big a vector to test... N elements
 
 
 	// Multiply-by-scalar
-	printf("Vector-scalar operation benchmarks (N=%d, ITER=%d):\n", nvecsize, niter);
-	run_vector_scalar_N("Vector mult-scalar C++", niter, nvecsize, aussie_vector_multiply_scalar);
-	run_vector_scalar_N("Vector mult-scalar pointer-arith", niter, nvecsize, aussie_vector_multiply_scalar_pointer_arith);
-#if !LINUX
-	run_vector_scalar_N("Vector mult-scalar AVX1", niter, nvecsize, aussie_vector_multiply_scalar_AVX1);
-	run_vector_scalar_N("Vector mult-scalar AVX2", niter, nvecsize, aussie_vector_multiply_scalar_AVX2);
-	run_vector_scalar_N("Vector mult-scalar AVX2 + pointer arith", niter, nvecsize, aussie_vector_multiply_scalar_AVX2_pointer_arith);
-#endif //LINUX
+	aussie_bench_printf("Vector-scalar operation benchmarks (N=%d):\n", nvecsize);
+	run_vector_scalar_N("Vector mult-scalar C++", nvecsize, aussie_vector_multiply_scalar);
+	run_vector_scalar_N("Vector mult-scalar pointer-arith", nvecsize, aussie_vector_multiply_scalar_pointer_arith);
+#if AUSSIE_X86
+	if (aussie_cpu_has_avx()) {
+		run_vector_scalar_N("Vector mult-scalar AVX1", nvecsize, aussie_vector_multiply_scalar_AVX1);
+	}
+	if (aussie_cpu_has_avx2()) {
+		run_vector_scalar_N("Vector mult-scalar AVX2", nvecsize, aussie_vector_multiply_scalar_AVX2);
+		run_vector_scalar_N("Vector mult-scalar AVX2 + pointer arith", nvecsize, aussie_vector_multiply_scalar_AVX2_pointer_arith);
+	}
+	if (aussie_cpu_has_avx512()) {
+		run_vector_scalar_N("Vector mult-scalar AVX-512", nvecsize, aussie_vector_multiply_scalar_AVX512);
+	}
+#endif //AUSSIE_X86
+	run_vector_scalar_N("Vector mult-scalar dispatched", nvecsize, aussie_vector_multiply_scalar_dispatch);
 	
 }
 
@@ -465,46 +1525,53 @@ void aussie_benchmark_vecdot()  // vector dot product benchmarks...
 {
 	long int million = 1000000;
 	long int billion = 1000 * million;
-	long int niter = 1 * million;
 	int nvecsize = 512 * 2;  // How big a vector to test... N elements
 
-	printf("INT Vector dot product benchmarks: (N=%d, Iter=%d)\n", nvecsize, niter);
-	run_vector_int_N("Vecdot int", niter, nvecsize, aussie_vecdot_int_basic);
+	aussie_bench_printf("INT Vector dot product benchmarks: (N=%d)\n", nvecsize);
+	run_vector_int_N("Vecdot int", nvecsize, aussie_vecdot_int_basic);
 
-	printf("FLOAT Vector dot product benchmarks: (N=%d, Iter=%d)\n", nvecsize, niter);
+	aussie_bench_printf("FLOAT Vector dot product benchmarks: (N=%d)\n", nvecsize);
 
-	run_vector_int_N("Vecdot integer (fixed-point)", niter, nvecsize, aussie_vecdot_integer_fixed_point);
-	run_vector_int_N("Vecdot integer (bitshift)", niter, nvecsize, aussie_vecdot_integer_bitshift);
-	run_vector_float_N("Vecdot basic", niter, nvecsize, NULL, aussie_vecdot_basic);
-#if !LINUX
-	run_vector_float_N("Vecdot AVX1 unroll (4 floats, 128-bits)", niter, nvecsize, NULL, aussie_vecdot_unroll_AVX1);
-	run_vector_float_N("Vecdot AVX1 FMA (4 floats, 128-bits)", niter, nvecsize, NULL, aussie_vecdot_FMA_unroll_AVX1);
-	run_vector_float_N("Vecdot AVX2 FMA (8 floats, 256-bits)", niter, nvecsize, NULL, aussie_vecdot_FMA_unroll_AVX2);
-#endif //LINUX
+	run_vector_int_N("Vecdot integer (fixed-point)", nvecsize, aussie_vecdot_integer_fixed_point);
+	run_vector_int_N("Vecdot integer (bitshift)", nvecsize, aussie_vecdot_integer_bitshift);
+	run_vector_float_N("Vecdot basic", nvecsize, NULL, aussie_vecdot_basic);
+#if AUSSIE_X86
+	if (aussie_cpu_has_avx()) {
+		run_vector_float_N("Vecdot AVX1 unroll (4 floats, 128-bits)", nvecsize, NULL, aussie_vecdot_unroll_AVX1);
+	}
+	if (aussie_cpu_has_avx2()) {
+		run_vector_float_N("Vecdot AVX1 FMA (4 floats, 128-bits)", nvecsize, NULL, aussie_vecdot_FMA_unroll_AVX1);
+		run_vector_float_N("Vecdot AVX2 FMA (8 floats, 256-bits)", nvecsize, NULL, aussie_vecdot_FMA_unroll_AVX2);
+	}
+	if (aussie_cpu_has_avx512()) {
+		run_vector_float_N("Vecdot AVX-512 FMA (16 floats, 512-bits)", nvecsize, NULL, aussie_vecdot_FMA_unroll_AVX512);
+	}
 
 
 
-#if !LINUX
-	run_vector_float_N("Vecdot AVX2 unroll (8 floats, 256-bits)", niter, nvecsize, NULL, aussie_vecdot_unroll_AVX2);
-#endif //LINUX
+	if (aussie_cpu_has_avx2()) {
+		run_vector_float_N("Vecdot AVX2 unroll (8 floats, 256-bits)", nvecsize, NULL, aussie_vecdot_unroll_AVX2);
+	}
+#endif //AUSSIE_X86
+	run_vector_float_N("Vecdot dispatched", nvecsize, NULL, aussie_vecdot_dispatch);
 
 
 
-	run_vector_float_N_non_const("Vecdot pointer arith", niter, nvecsize, NULL, aussie_vecdot_pointer_arithmetic);
-	run_vector_float_N_non_const("Vecdot reverse basic", niter, nvecsize, NULL, aussie_vecdot_reverse_basic);
-	run_vector_float_N_non_const("Vecdot reverse basic2", niter, nvecsize, NULL, aussie_vecdot_reverse_basic2);
-	run_vector_float_N_non_const("Vecdot reverse zero-test", niter, nvecsize, NULL, aussie_vecdot_reverse_zerotest);
-	run_vector_float_N_non_const("Vecdot unroll4 basic", niter, nvecsize, NULL, aussie_vecdot_unroll4_basic);
-	run_vector_float_N_non_const("Vecdot unroll4 better", niter, nvecsize, NULL, aussie_vecdot_unroll4_better);
-	run_vector_float_N_non_const("Vecdot Duff's Device unroll", niter, nvecsize, NULL, aussie_vecdot_unroll4_duffs_device);
+	run_vector_float_N_non_const("Vecdot pointer arith", nvecsize, NULL, aussie_vecdot_pointer_arithmetic);
+	run_vector_float_N_non_const("Vecdot reverse basic", nvecsize, NULL, aussie_vecdot_reverse_basic);
+	run_vector_float_N_non_const("Vecdot reverse basic2", nvecsize, NULL, aussie_vecdot_reverse_basic2);
+	run_vector_float_N_non_const("Vecdot reverse zero-test", nvecsize, NULL, aussie_vecdot_reverse_zerotest);
+	run_vector_float_N_non_const("Vecdot unroll4 basic", nvecsize, NULL, aussie_vecdot_unroll4_basic);
+	run_vector_float_N_non_const("Vecdot unroll4 better", nvecsize, NULL, aussie_vecdot_unroll4_better);
+	run_vector_float_N_non_const("Vecdot Duff's Device unroll", nvecsize, NULL, aussie_vecdot_unroll4_duffs_device);
 
 
 
-	//run_vector_float_N("Vecdot section512", niter, nvecsize, NULL, aussie_vecdot_section512);
-	run_vector_float_N_non_const("Vecdot parallel basic", niter, nvecsize, NULL, aussie_vecdot_parallel_basic);
-	run_vector_float_N_non_const("Vecdot parallel odd sizes", niter, nvecsize, NULL, aussie_vecdot_parallel_odd_sizes);
-	run_vector_float_N_non_const("Vecdot parallel padding", niter, nvecsize, NULL, aussie_vecdot_parallel_padding);
-	run_vector_float_N("Vecdot basic", niter, nvecsize, NULL, aussie_vecdot_basic);
+	//run_vector_float_N("Vecdot section512", nvecsize, NULL, aussie_vecdot_section512);
+	run_vector_float_N_non_const("Vecdot parallel basic", nvecsize, NULL, aussie_vecdot_parallel_basic);
+	run_vector_float_N_non_const("Vecdot parallel odd sizes", nvecsize, NULL, aussie_vecdot_parallel_odd_sizes);
+	run_vector_float_N_non_const("Vecdot parallel padding", nvecsize, NULL, aussie_vecdot_parallel_padding);
+	run_vector_float_N("Vecdot basic", nvecsize, NULL, aussie_vecdot_basic);
 }
 
 
@@ -512,51 +1579,231 @@ void aussie_benchmark_softmax()
 {
 	long int million = 1000000;
 	long int billion = 1000 * million;
-	long int niter = 100 * 1000;
 
 	int nvecsize = 1024;  // How big a vector to test... N elements
 
-	printf("Softmax benchmarks (N=%d, ITER=%d)\n", nvecsize, niter);
-	run_vector_float_N_non_const("Softmax basic", niter, nvecsize, aussie_vector_softmax_basic, NULL);
-	run_vector_float_N_non_const("Softmax reciprocal", niter, nvecsize, aussie_vector_softmax_multiply_reciprocal, NULL);
-	run_vector_float_N_non_const("Softmax expf-first", niter, nvecsize, aussie_vector_softmax_exponentiate_first, NULL);
-	run_vector_float_N_non_const("Softmax expf-sum-fused", niter, nvecsize, aussie_vector_softmax_exponentiate_and_sum, NULL);
-	run_vector_float_N_non_const("Softmax expf with AVX1", niter, nvecsize, aussie_vector_softmax_exponentiate_with_AVX1, NULL);
-	run_vector_float_N_non_const("Softmax expf/sum AVX1", niter, nvecsize, aussie_vector_softmax_exponentiate_and_sum_AVX1, NULL);
-	run_vector_float_N_non_const("Softmax fused expf/sum AVX1", niter, nvecsize, aussie_vector_softmax_fused_exponentiate_sum_AVX1, NULL);
-	run_vector_float_N_non_const("Softmax fused expf/sum/mult AVX1", niter, nvecsize, aussie_vector_softmax_fused_exp_sum_mult_AVX1, NULL);
-	run_vector_float_N_non_const("Softmax expf with AVX2", niter, nvecsize, aussie_vector_softmax_exponentiate_with_AVX2, NULL);
-	run_vector_float_N_non_const("Softmax expf/sum AVX2", niter, nvecsize, aussie_vector_softmax_exponentiate_and_sum_AVX2, NULL);
-	run_vector_float_N_non_const("Softmax fused expf/sum AVX2", niter, nvecsize, aussie_vector_softmax_fused_exponentiate_sum_AVX2, NULL);
-	run_vector_float_N_non_const("Softmax fused expf/sum/mult AVX2", niter, nvecsize, aussie_vector_softmax_fused_exp_sum_mult_AVX2, NULL);
+	aussie_bench_printf("Softmax benchmarks (N=%d)\n", nvecsize);
+	run_vector_float_N_non_const("Softmax basic", nvecsize, aussie_vector_softmax_basic, NULL);
+	run_vector_float_N_non_const("Softmax reciprocal", nvecsize, aussie_vector_softmax_multiply_reciprocal, NULL);
+	run_vector_float_N_non_const("Softmax expf-first", nvecsize, aussie_vector_softmax_exponentiate_first, NULL);
+	run_vector_float_N_non_const("Softmax expf-sum-fused", nvecsize, aussie_vector_softmax_exponentiate_and_sum, NULL);
+#if AUSSIE_X86
+	if (aussie_cpu_has_avx()) {
+		run_vector_float_N_non_const("Softmax expf with AVX1", nvecsize, aussie_vector_softmax_exponentiate_with_AVX1, NULL);
+		run_vector_float_N_non_const("Softmax expf/sum AVX1", nvecsize, aussie_vector_softmax_exponentiate_and_sum_AVX1, NULL);
+		run_vector_float_N_non_const("Softmax fused expf/sum AVX1", nvecsize, aussie_vector_softmax_fused_exponentiate_sum_AVX1, NULL);
+		run_vector_float_N_non_const("Softmax fused expf/sum/mult AVX1", nvecsize, aussie_vector_softmax_fused_exp_sum_mult_AVX1, NULL);
+	}
+	if (aussie_cpu_has_avx2()) {
+		run_vector_float_N_non_const("Softmax expf with AVX2", nvecsize, aussie_vector_softmax_exponentiate_with_AVX2, NULL);
+		run_vector_float_N_non_const("Softmax expf/sum AVX2", nvecsize, aussie_vector_softmax_exponentiate_and_sum_AVX2, NULL);
+		run_vector_float_N_non_const("Softmax fused expf/sum AVX2", nvecsize, aussie_vector_softmax_fused_exponentiate_sum_AVX2, NULL);
+		run_vector_float_N_non_const("Softmax fused expf/sum/mult AVX2", nvecsize, aussie_vector_softmax_fused_exp_sum_mult_AVX2, NULL);
+	}
+	if (aussie_cpu_has_avx512()) {
+		run_vector_float_N_non_const("Softmax fused expf/sum/mult AVX-512", nvecsize, aussie_vector_softmax_fused_exp_sum_mult_AVX512, NULL);
+	}
+	run_vector_float_N_non_const("Softmax online", nvecsize, aussie_vector_softmax_online, NULL);
+	if (aussie_cpu_has_avx2()) {
+		run_vector_float_N_non_const("Softmax online AVX2", nvecsize, aussie_vector_softmax_online_AVX2, NULL);
+	}
+	if (aussie_cpu_has_avx512()) {
+		run_vector_float_N_non_const("Softmax online AVX-512", nvecsize, aussie_vector_softmax_online_AVX512, NULL);
+	}
+#endif //AUSSIE_X86
+	run_vector_float_N_non_const("Softmax dispatched", nvecsize, aussie_vector_softmax_dispatch, NULL);
 	
 }
 
+void aussie_benchmark_softmax_vocab()  // Softmax over a full vocabulary (bigger than L2 cache)
+{
+	int nvocab = 128 * 1024;  // 512K of logits
+	float* vtemp = (float*)malloc(nvocab * sizeof(float));
+	float* v = (float*)malloc(nvocab * sizeof(float));
+	if (!vtemp || !v) {
+		yassert(vtemp && v);
+		free(vtemp); free(v);
+		return;  // fail
+	}
+	for (int i = 0; i < nvocab; i++) vtemp[i] = (float)((i * 7919) % 1000) * 0.02f - 10.0f;  // Logits
+
+	typedef void (*softmax_fnptr)(float v[], int n);
+	const char* names[] = { "Softmax vocab basic (3 pass)", "Softmax vocab online", "Softmax vocab online AVX2",
+		"Softmax vocab online AVX-512", "Softmax vocab dispatched", "Softmax vocab parallel" };
+	softmax_fnptr fns[] = { aussie_vector_softmax_basic, aussie_vector_softmax_online, NULL, NULL,
+		aussie_vector_softmax_dispatch, aussie_vector_softmax_parallel };
+#if AUSSIE_X86
+	if (aussie_cpu_has_avx2()) fns[2] = aussie_vector_softmax_online_AVX2;
+	if (aussie_cpu_has_avx512()) fns[3] = aussie_vector_softmax_online_AVX512;
+#endif //AUSSIE_X86
+	aussie_bench_printf("Softmax vocabulary benchmarks (N=%d, GB/sec of logits)\n", nvocab);
+	aussie_bench_vector_args args;
+	memset(&args, 0, sizeof(args));
+	args.v1 = v;
+	args.vcopy = vtemp;
+	args.n = nvocab;
+	for (int k = 0; k < (int)(sizeof(fns) / sizeof(fns[0])); k++) {
+		if (fns[k] == NULL) continue;
+		args.inplacefnptr = fns[k];
+		aussie_bench_result res;
+		aussie_bench_result_init(res, names[k], nvocab, (double)nvocab * sizeof(float), 0.0);
+		if (aussie_bench_run(res, aussie_bench_vector_call, &args, aussie_bench_vector_reset)) aussie_bench_report(res);
+	}
+	free(vtemp); free(v);
+}
+
+struct aussie_bench_topk_args {
+	float* v;            // Sorted in place by the qsort version
+	const float* vtemp;  // The logits
+	int n, k;
+	int version;  // 0 = qsort, 1 = qsort permut, 2 = shuffle, 3 = heap, 4 = select
+	float vout[100];
+	int pout[100];
+	aussie_topk_item items[100];
+};
+
+static void aussie_bench_topk_reset(void* arg)
+{
+	aussie_bench_topk_args* args = (aussie_bench_topk_args*)arg;
+	if (args->version == 0) memcpy(args->v, args->vtemp, args->n * sizeof(float));
+}
+
+static void aussie_bench_topk_call(void* arg)
+{
+	aussie_bench_topk_args* args = (aussie_bench_topk_args*)arg;
+	switch (args->version) {
+	case 0: aussie_vector_top_k_qsort(args->v, args->n, args->k, args->vout); break;
+	case 1: aussie_vector_top_k_qsort_permut((float*)args->vtemp, args->n, args->k, args->vout, args->pout); break;
+	case 2: aussie_vector_top_k_shuffle((float*)args->vtemp, args->n, args->k, args->vout); break;
+	case 3: aussie_vector_top_k_heap(args->vtemp, args->n, args->k, args->items); break;
+	default: aussie_vector_top_k_select(args->vtemp, args->n, args->k, args->items); break;
+	}
+}
+
+void aussie_benchmark_topk()  // Top-k over vocabulary-sized logit vectors
+{
+	int sizes[] = { 50000, 128000, 256000 };
+	int ks[] = { 1, 10, 50, 100 };
+	const char* versions[] = { "qsort", "qsort permut", "shuffle", "heap", "select" };
+	int maxn = 256000;
+	float* vtemp = (float*)malloc(maxn * sizeof(float));
+	float* v = (float*)malloc(maxn * sizeof(float));
+	aussie_bench_topk_args* args = (aussie_bench_topk_args*)malloc(sizeof(aussie_bench_topk_args));
+	if (!vtemp || !v || !args) {
+		yassert(vtemp && v && args);
+		free(vtemp); free(v); free(args);
+		return;  // fail
+	}
+	srand(42);
+	for (int i = 0; i < maxn; i++) vtemp[i] = (float)(rand() % 100000) * 0.0002f - 10.0f;  // Logits
+	args->v = v;
+	args->vtemp = vtemp;
+
+	aussie_bench_printf("Top-k benchmarks:\n");
+	for (int s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++) {
+		for (int j = 0; j < (int)(sizeof(ks) / sizeof(ks[0])); j++) {
+			for (int ver = 0; ver < (int)(sizeof(versions) / sizeof(versions[0])); ver++) {
+				args->n = sizes[s];
+				args->k = ks[j];
+				args->version = ver;
+				char name[100];
+				sprintf(name, "Top-k %s N=%d k=%d", versions[ver], sizes[s], ks[j]);
+				aussie_bench_result res;
+				aussie_bench_result_init(res, name, sizes[s], (double)sizes[s] * sizeof(float), 0.0);
+				if (aussie_bench_run(res, aussie_bench_topk_call, args, aussie_bench_topk_reset)) aussie_bench_report(res);
+			}
+		}
+	}
+	free(vtemp); free(v); free(args);
+}
+
+static int aussie_benchmark_sample_full_sort(aussie_sampler& s, const float logits[], int n)  // Baseline: softmax, sort everything, scan
+{
+	memcpy(s.probs, logits, n * sizeof(float));
+	aussie_vector_multiply_scalar(s.probs, n, 1.0f / s.temperature);
+	aussie_vector_softmax_basic(s.probs, n);
+	for (int i = 0; i < n; i++) {
+		s.items[i].fval = s.probs[i];
+		s.items[i].index = i;
+	}
+	qsort(s.items, n, sizeof(s.items[0]), aussie_top_k_item_cmp);
+	int nkeep = s.topk > 0 && s.topk < n ? s.topk : n;
+	float fmass = 0.0f, ftotal = 0.0f;
+	for (int j = 0; j < nkeep; j++) ftotal += s.items[j].fval;
+	int j = 0;
+	for (; j < nkeep - 1 && fmass + s.items[j].fval < s.topp * ftotal; j++) fmass += s.items[j].fval;
+	return s.items[(int)(aussie_rng_uniform(s.rng) * (j + 1))].index;  // (Not the real draw: timing only)
+}
+
+struct aussie_bench_sample_args {
+	aussie_sampler* s;
+	const float* logits;
+	int n;
+	bool fullsort;
+};
+
+static void aussie_bench_sample_call(void* arg)
+{
+	aussie_bench_sample_args* args = (aussie_bench_sample_args*)arg;
+	if (args->fullsort) g_aussie_bench_sink = (float)aussie_benchmark_sample_full_sort(*args->s, args->logits, args->n);
+	else g_aussie_bench_sink = (float)aussie_sample_token(*args->s, args->logits, args->n);
+}
+
+void aussie_benchmark_sampling()  // Token sampling over a 128K vocabulary
+{
+	int nvocab = 128 * 1024;
+	float* logits = (float*)malloc(nvocab * sizeof(float));
+	if (!logits) {
+		yassert(logits != NULL);
+		return;  // fail
+	}
+	srand(42);
+	for (int i = 0; i < nvocab; i++) logits[i] = (float)(rand() % 100000) * 0.0002f - 10.0f;
+
+	struct { const char* name; float temperature; int topk; float topp; bool fullsort; } configs[] = {
+		{ "Sample greedy", 0.0f, 0, 1.0f, false },
+		{ "Sample temperature 0.8", 0.8f, 0, 1.0f, false },
+		{ "Sample top-k 40", 0.8f, 40, 1.0f, false },
+		{ "Sample top-p 0.9", 0.8f, 0, 0.9f, false },
+		{ "Sample top-k 40 + top-p 0.9", 0.8f, 40, 0.9f, false },
+		{ "Sample top-p 0.9 (full sort)", 0.8f, 0, 0.9f, true },
+	};
+	aussie_bench_printf("Sampling benchmarks (N=%d):\n", nvocab);
+	for (int c = 0; c < (int)(sizeof(configs) / sizeof(configs[0])); c++) {
+		aussie_sampler s;
+		if (!aussie_sampler_init(s, nvocab, configs[c].temperature, configs[c].topk, configs[c].topp, 42)) break;
+		aussie_bench_sample_args args = { &s, logits, nvocab, configs[c].fullsort };
+		aussie_bench_result res;
+		aussie_bench_result_init(res, configs[c].name, nvocab, (double)nvocab * sizeof(float), 0.0);
+		if (aussie_bench_run(res, aussie_bench_sample_call, &args, NULL)) aussie_bench_report(res);
+		aussie_sampler_free(s);
+	}
+	free(logits);
+}
+
 void aussie_benchmark_zscore_normalization()   // Benchmark z-score normalization
 {
 	long int million = 1000000;
 	long int thousand = 1000;
 	long int billion = 1000 * million;
-	long int niter = 1 * million;
 	int nvecsize = 128;  // How big a vector to test... N elements
 	yassert(nvecsize % 4 == 0);  // AVX1
 	yassert(nvecsize % 8 == 0);  // AVX2
 
-	niter = 100 * thousand;
 	nvecsize = 2048;  // How big a vector to test... N elements
 	yassert(nvecsize % 4 == 0);  // AVX1
 	yassert(nvecsize % 8 == 0);  // AVX2
-	printf("Z-score normalization benchmarks (N=%d, ITER=%d)\n", nvecsize, niter);
-	run_vector_float_N_non_const("Z-score norm basic", niter, nvecsize, aussie_vector_normalize_zscore);
-	run_vector_float_N_non_const("Z-score norm fix mean", niter, nvecsize, aussie_vector_normalize_zscore_fix_mean);
-	run_vector_float_N_non_const("Z-score norm reciprocal", niter, nvecsize, aussie_vector_normalize_zscore_reciprocal);
-	run_vector_float_N_non_const("Z-score norm fused", niter, nvecsize, aussie_vector_normalize_zscore_fused);
-	run_vector_float_N_non_const("Z-score norm AVX1 sum", niter, nvecsize, aussie_vector_normalize_zscore_sum_AVX1);
-	run_vector_float_N_non_const("Z-score norm AVX1 sum+multiply", niter, nvecsize, aussie_vector_normalize_zscore_sum_mult_AVX1);
-	run_vector_float_N_non_const("Z-score norm AVX2 sum", niter, nvecsize, aussie_vector_normalize_zscore_sum_AVX2);
-	run_vector_float_N_non_const("Z-score norm AVX2 sum+multiply", niter, nvecsize, aussie_vector_normalize_zscore_sum_mult_AVX2);
-	run_vector_float_N_non_const("Z-score norm AVX1 all", niter, nvecsize, aussie_vector_normalize_zscore_all_AVX1);
-	run_vector_float_N_non_const("Z-score norm AVX2 all", niter, nvecsize, aussie_vector_normalize_zscore_all_AVX2);
+	aussie_bench_printf("Z-score normalization benchmarks (N=%d)\n", nvecsize);
+	run_vector_float_N_non_const("Z-score norm basic", nvecsize, aussie_vector_normalize_zscore);
+	run_vector_float_N_non_const("Z-score norm fix mean", nvecsize, aussie_vector_normalize_zscore_fix_mean);
+	run_vector_float_N_non_const("Z-score norm reciprocal", nvecsize, aussie_vector_normalize_zscore_reciprocal);
+	run_vector_float_N_non_const("Z-score norm fused", nvecsize, aussie_vector_normalize_zscore_fused);
+	run_vector_float_N_non_const("Z-score norm AVX1 sum", nvecsize, aussie_vector_normalize_zscore_sum_AVX1);
+	run_vector_float_N_non_const("Z-score norm AVX1 sum+multiply", nvecsize, aussie_vector_normalize_zscore_sum_mult_AVX1);
+	run_vector_float_N_non_const("Z-score norm AVX2 sum", nvecsize, aussie_vector_normalize_zscore_sum_AVX2);
+	run_vector_float_N_non_const("Z-score norm AVX2 sum+multiply", nvecsize, aussie_vector_normalize_zscore_sum_mult_AVX2);
+	run_vector_float_N_non_const("Z-score norm AVX1 all", nvecsize, aussie_vector_normalize_zscore_all_AVX1);
+	run_vector_float_N_non_const("Z-score norm AVX2 all", nvecsize, aussie_vector_normalize_zscore_all_AVX2);
 
 
 }
@@ -569,14 +1816,13 @@ void aussie_benchmark_minmax_normalization()   // MinMax normalization
 
 	// BatchNorm
 	int nvecsize = 2048;  // How big a vector to test... N elements
-	int niter = 100 * thousand;
 	yassert(nvecsize % 4 == 0);  // AVX1
 	yassert(nvecsize % 8 == 0);  // AVX2
-	printf("MinMax benchmarks (N=%d, ITER=%d)\n", nvecsize, niter);
-	run_vector_float_N_non_const("MinMax basic", niter, nvecsize, aussie_vector_normalize_min_max_basic);
-	run_vector_float_N_non_const("MinMax reciprocal", niter, nvecsize, aussie_vector_normalize_min_max_reciprocal);
-	run_vector_float_N_non_const("MinMax ptr arith", niter, nvecsize, aussie_vector_normalize_min_max_pointer_arith);
-	run_vector_float_N_non_const("MinMax loop fusion", niter, nvecsize, aussie_vector_normalize_min_max_fusion);
+	aussie_bench_printf("MinMax benchmarks (N=%d)\n", nvecsize);
+	run_vector_float_N_non_const("MinMax basic", nvecsize, aussie_vector_normalize_min_max_basic);
+	run_vector_float_N_non_const("MinMax reciprocal", nvecsize, aussie_vector_normalize_min_max_reciprocal);
+	run_vector_float_N_non_const("MinMax ptr arith", nvecsize, aussie_vector_normalize_min_max_pointer_arith);
+	run_vector_float_N_non_const("MinMax loop fusion", nvecsize, aussie_vector_normalize_min_max_fusion);
 
 	
 	
@@ -591,16 +1837,19 @@ void aussie_benchmark_RMS_normalization()   // RMSNorm normalization
 
 	// BatchNorm
 	int nvecsize = 2048;  // How big a vector to test... N elements
-	int niter = 100 * thousand;
 	yassert(nvecsize % 4 == 0);  // AVX1
 	yassert(nvecsize % 8 == 0);  // AVX2
-	printf("MinMax benchmarks (N=%d, ITER=%d)\n", nvecsize, niter);
-	run_vector_float_N_non_const("RMSNorm basic", niter, nvecsize, aussie_vector_rms_normalize_basic);
-	run_vector_float_N_non_const("RMSNorm reciprocal", niter, nvecsize, aussie_vector_rms_normalize_reciprocal);
-#if !LINUX
-	run_vector_float_N_non_const("RMSNorm AVX1", niter, nvecsize, aussie_vector_rms_normalize_AVX1);
-	run_vector_float_N_non_const("RMSNorm AVX2", niter, nvecsize, aussie_vector_rms_normalize_AVX2);
-#endif //LINUX
+	aussie_bench_printf("RMSNorm benchmarks (N=%d)\n", nvecsize);
+	run_vector_float_N_non_const("RMSNorm basic", nvecsize, aussie_vector_rms_normalize_basic);
+	run_vector_float_N_non_const("RMSNorm reciprocal", nvecsize, aussie_vector_rms_normalize_reciprocal);
+#if AUSSIE_X86
+	if (aussie_cpu_has_avx()) {
+		run_vector_float_N_non_const("RMSNorm AVX1", nvecsize, aussie_vector_rms_normalize_AVX1);
+	}
+	if (aussie_cpu_has_avx2()) {
+		run_vector_float_N_non_const("RMSNorm AVX2", nvecsize, aussie_vector_rms_normalize_AVX2);
+	}
+#endif //AUSSIE_X86
 
 
 
@@ -616,23 +1865,22 @@ void aussie_benchmark_batchnorm_normalization()   // BatchNorm normalization
 
 	// BatchNorm
 	int nvecsize = 2048;  // How big a vector to test... N elements
-	int niter = 100 * thousand;
 	yassert(nvecsize % 4 == 0);  // AVX1
 	yassert(nvecsize % 8 == 0);  // AVX2
-	printf("BatchNorm benchmarks (N=%d, ITER=%d)\n", nvecsize, niter);
-	run_vector_float_N_non_const("BatchNorm basic", niter, nvecsize, aussie_vector_batch_normalize_basic_wrapper);
-	run_vector_float_N_non_const("BatchNorm reciprocal", niter, nvecsize, aussie_vector_batch_normalize_with_loop_fission_wrapper);
-	run_vector_float_N_non_const("BatchNorm fission", niter, nvecsize, aussie_vector_batch_normalize_with_loop_fission2_wrapper);
-	run_vector_float_N_non_const("BatchNorm fusion/fission", niter, nvecsize, aussie_vector_batch_normalize_with_loop_fusion_fission_wrapper);
-	run_vector_float_N_non_const("BatchNorm no params", niter, nvecsize, aussie_vector_batch_normalize_NO_PARAMS_wrapper);
+	aussie_bench_printf("BatchNorm benchmarks (N=%d)\n", nvecsize);
+	run_vector_float_N_non_const("BatchNorm basic", nvecsize, aussie_vector_batch_normalize_basic_wrapper);
+	run_vector_float_N_non_const("BatchNorm reciprocal", nvecsize, aussie_vector_batch_normalize_with_loop_fission_wrapper);
+	run_vector_float_N_non_const("BatchNorm fission", nvecsize, aussie_vector_batch_normalize_with_loop_fission2_wrapper);
+	run_vector_float_N_non_const("BatchNorm fusion/fission", nvecsize, aussie_vector_batch_normalize_with_loop_fusion_fission_wrapper);
+	run_vector_float_N_non_const("BatchNorm no params", nvecsize, aussie_vector_batch_normalize_NO_PARAMS_wrapper);
 
-	run_vector_float_N_non_const("BatchNorm fission AVX1", niter, nvecsize, aussie_vector_batch_normalize_with_loop_fission2_wrapper_AVX1);
-	run_vector_float_N_non_const("BatchNorm fission AVX2", niter, nvecsize, aussie_vector_batch_normalize_with_loop_fission2_wrapper_AVX2);
-	run_vector_float_N_non_const("BatchNorm fusion/fission AVX1", niter, nvecsize, aussie_vector_batch_normalize_with_loop_fusion_fission_AVX1_wrapper);
-	run_vector_float_N_non_const("BatchNorm fusion/fission AVX2", niter, nvecsize, aussie_vector_batch_normalize_with_loop_fusion_fission_AVX2_wrapper);
+	run_vector_float_N_non_const("BatchNorm fission AVX1", nvecsize, aussie_vector_batch_normalize_with_loop_fission2_wrapper_AVX1);
+	run_vector_float_N_non_const("BatchNorm fission AVX2", nvecsize, aussie_vector_batch_normalize_with_loop_fission2_wrapper_AVX2);
+	run_vector_float_N_non_const("BatchNorm fusion/fission AVX1", nvecsize, aussie_vector_batch_normalize_with_loop_fusion_fission_AVX1_wrapper);
+	run_vector_float_N_non_const("BatchNorm fusion/fission AVX2", nvecsize, aussie_vector_batch_normalize_with_loop_fusion_fission_AVX2_wrapper);
 
-	printf("Variance benchmarks (N=%d, ITER=%d)\n", nvecsize, niter);
-	run_vector_float_N_non_const("BatchNorm mean/variance", niter, nvecsize, aussie_vector_batchnorm_variance_basic_wrapper); // Low-level variance computations
+	aussie_bench_printf("Variance benchmarks (N=%d)\n", nvecsize);
+	run_vector_float_N_non_const("BatchNorm mean/variance", nvecsize, aussie_vector_batchnorm_variance_basic_wrapper); // Low-level variance computations
 
 }
 
@@ -655,7 +1903,7 @@ void yap_benchmark_operations()
 	int million = 1000000;
 	long int billion = 1000 * million;
 	long int n = 100 * million;
-	printf("Operator benchmarks (ITER=%d)\n", n);
+	aussie_bench_printf("Operator benchmarks (ns/elem is per operation)\n");
 	run_arith_float_1000("Basic float divide", n, basic_float_divide, NULL);
 	run_arith_float_1000("Basic float add", n, basic_float_add, NULL);
 	run_arith_float_1000("Basic float equals", n, basic_float_equals, NULL);
@@ -690,16 +1938,471 @@ void yap_test_operator_accuracy()    // Test approximate operations accuracy...
 
 }
 
+//---------------------------------------------------
+// Roofline size sweep
+//---------------------------------------------------
+
+static long aussie_bench_cache_size(int level)  // Bytes of L1D, L2 or L3 (sysconf, else typical sizes)
+{
+	long defaults[3] = { 32L * 1024, 1024L * 1024, 32L * 1024 * 1024 };
+	long sz = 0;
+#if LINUX && defined(_SC_LEVEL1_DCACHE_SIZE)
+	int names[3] = { _SC_LEVEL1_DCACHE_SIZE, _SC_LEVEL2_CACHE_SIZE, _SC_LEVEL3_CACHE_SIZE };
+	sz = sysconf(names[level]);
+#endif
+	return sz > 0 ? sz : defaults[level];
+}
+
+const char* aussie_bench_cache_level(const aussie_bench_roofline& roof, double working_set_bytes)
+{
+	if (working_set_bytes <= roof.cache_bytes[0]) return "L1";
+	if (working_set_bytes <= roof.cache_bytes[1]) return "L2";
+	if (working_set_bytes <= roof.cache_bytes[2]) return "L3";
+	return "DRAM";
+}
+
+double aussie_bench_roof_gflopsec(const aussie_bench_roofline& roof, double flop_per_byte, bool parallel)
+{
+	int i = parallel ? 1 : 0;
+	double membound = flop_per_byte * roof.gbsec[i];  // FLOP/byte x GB/sec = GFLOP/sec
+	return membound < roof.gflopsec[i] ? membound : roof.gflopsec[i];
+}
+
+struct aussie_bench_peak_args {
+	float* v;
+	int n;
+	long niter;  // FMA loop iterations per call
+};
+
+static float aussie_bench_fma_peak_run(long niter)  // The widest FMA loop for the dispatched ISA
+{
+#if AUSSIE_X86
+	if (g_aussie_dispatch.isa >= AUSSIE_ISA_AVX512) return aussie_fma_peak_AVX512(niter);
+	if (g_aussie_dispatch.isa >= AUSSIE_ISA_AVX2) return aussie_fma_peak_AVX2(niter);
+#endif //AUSSIE_X86
+	float a0 = 1.0f, a1 = 1.1f, a2 = 1.2f, a3 = 1.3f, a4 = 1.4f, a5 = 1.5f, a6 = 1.6f, a7 = 1.7f;
+	for (long i = 0; i < niter; i++) {
+		a0 = a0 * 0.999999f + 1.0e-6f;
+		a1 = a1 * 0.999999f + 1.0e-6f;
+		a2 = a2 * 0.999999f + 1.0e-6f;
+		a3 = a3 * 0.999999f + 1.0e-6f;
+		a4 = a4 * 0.999999f + 1.0e-6f;
+		a5 = a5 * 0.999999f + 1.0e-6f;
+		a6 = a6 * 0.999999f + 1.0e-6f;
+		a7 = a7 * 0.999999f + 1.0e-6f;
+	}
+	return a0 + a1 + a2 + a3 + a4 + a5 + a6 + a7;
+}
+
+static double aussie_bench_fma_flops_per_iter()  // Matches aussie_bench_fma_peak_run
+{
+#if AUSSIE_X86
+	if (g_aussie_dispatch.isa >= AUSSIE_ISA_AVX512) return 10 * 16 * 2;
+	if (g_aussie_dispatch.isa >= AUSSIE_ISA_AVX2) return 10 * 8 * 2;
+#endif //AUSSIE_X86
+	return 8 * 2;
+}
+
+static void aussie_bench_fma_call(void* arg)
+{
+	g_aussie_bench_sink = aussie_bench_fma_peak_run(((aussie_bench_peak_args*)arg)->niter);
+}
+
+static void aussie_bench_fma_task(int itask, void* arg)
+{
+	float f = aussie_bench_fma_peak_run(((aussie_bench_peak_args*)arg)->niter);
+	if (itask == 0) g_aussie_bench_sink = f;
+}
+
+static void aussie_bench_fma_parallel_call(void* arg)
+{
+	aussie_parallel_run(aussie_thread_count(), aussie_bench_fma_task, arg, AUSSIE_SCHEDULE_STATIC);  // One loop per thread
+}
+
+static void aussie_bench_read_call(void* arg)
+{
+	aussie_bench_peak_args* args = (aussie_bench_peak_args*)arg;
+	g_aussie_bench_sink = aussie_vector_sum_dispatch(args->v, args->n);
+}
+
+static float aussie_bench_read_range(int begin, int end, void* arg)
+{
+	aussie_bench_peak_args* args = (aussie_bench_peak_args*)arg;
+	return aussie_vector_sum_dispatch(&args->v[begin], end - begin);
+}
+
+static void aussie_bench_read_parallel_call(void* arg)
+{
+	aussie_bench_peak_args* args = (aussie_bench_peak_args*)arg;
+	g_aussie_bench_sink = aussie_parallel_reduce(0, args->n, 0, aussie_bench_read_range, arg, 0.0f, aussie_combine_sum);
+}
+
+static aussie_bench_roofline s_aussie_bench_roofline;
+static bool s_aussie_bench_roofline_done = false;
+
+const aussie_bench_roofline& aussie_bench_machine_roofline()  // Measured on the first call
+{
+	aussie_bench_roofline& roof = s_aussie_bench_roofline;
+	if (s_aussie_bench_roofline_done) return roof;
+	s_aussie_bench_roofline_done = true;
+	memset(&roof, 0, sizeof(roof));
+	for (int i = 0; i < 3; i++) roof.cache_bytes[i] = aussie_bench_cache_size(i);
+	aussie_dispatch_ensure();
+	int nthreads = aussie_thread_count();
+	char name[100];
+	aussie_bench_result res;
+	aussie_bench_printf("Machine peaks for the roofline:\n");
+
+	// Read bandwidth: a sum over 4x the LLC streams from DRAM (the best time is the peak)
+	aussie_bench_peak_args args;
+	memset(&args, 0, sizeof(args));
+	args.n = (int)(4 * roof.cache_bytes[2] / sizeof(float));
+	args.v = (float*)malloc(args.n * sizeof(float));
+	if (!args.v) {
+		yassert(args.v != NULL);
+	}
+	else {
+		double nbytes = (double)args.n * sizeof(float);
+		for (int i = 0; i < args.n; i++) args.v[i] = 1.0f;  // Also faults in the pages
+		aussie_bench_result_init(res, "Peak read bandwidth (1 thread)", args.n, nbytes, 0.0);
+		if (aussie_bench_run(res, aussie_bench_read_call, &args, NULL)) {
+			aussie_bench_report(res);
+			roof.gbsec[0] = nbytes / res.ns_min;
+		}
+		sprintf(name, "Peak read bandwidth (all %d threads)", nthreads);
+		aussie_bench_result_init(res, name, args.n, nbytes, 0.0);
+		if (aussie_bench_run(res, aussie_bench_read_parallel_call, &args, NULL)) {
+			aussie_bench_report(res);
+			roof.gbsec[1] = nbytes / res.ns_min;
+		}
+		free(args.v);
+		args.v = NULL;
+	}
+
+	// FMA throughput: independent accumulators in registers, no memory
+	args.niter = 100000;
+	double flops = aussie_bench_fma_flops_per_iter() * args.niter;
+	aussie_bench_result_init(res, "Peak FMA throughput (1 thread)", 0, 0.0, flops);
+	if (aussie_bench_run(res, aussie_bench_fma_call, &args, NULL)) {
+		aussie_bench_report(res);
+		roof.gflopsec[0] = flops / res.ns_min;
+	}
+	sprintf(name, "Peak FMA throughput (all %d threads)", nthreads);
+	aussie_bench_result_init(res, name, 0, 0.0, flops * nthreads);
+	if (aussie_bench_run(res, aussie_bench_fma_parallel_call, &args, NULL)) {
+		aussie_bench_report(res);
+		roof.gflopsec[1] = flops * nthreads / res.ns_min;
+	}
+	aussie_bench_printf("Roofline (%s): %.2f GB/sec and %.2f GFLOP/sec on 1 thread (ridge at %.2f FLOP/byte), "
+		"%.2f GB/sec and %.2f GFLOP/sec on all %d threads; L1D %ldK, L2 %ldK, L3 %ldK\n",
+		aussie_dispatch_isa_name(g_aussie_dispatch.isa), roof.gbsec[0], roof.gflopsec[0],
+		roof.gbsec[0] > 0.0 ? roof.gflopsec[0] / roof.gbsec[0] : 0.0, roof.gbsec[1], roof.gflopsec[1], nthreads,
+		roof.cache_bytes[0] / 1024, roof.cache_bytes[1] / 1024, roof.cache_bytes[2] / 1024);
+	return roof;
+}
+
+#define AUSSIE_SWEEP_VECDOT  0   // float fn(v1, v2, n): 2 vectors of n
+#define AUSSIE_SWEEP_REDUCE  1   // float fn(v, n)
+#define AUSSIE_SWEEP_INPLACE 2   // void fn(v, n)
+#define AUSSIE_SWEEP_GEMV    3   // aussie_gemv_parallel: n = rows x 1024 columns
+#define AUSSIE_SWEEP_GEMM    4   // aussie_gemm: n = d x d (square)
+
+#define AUSSIE_SWEEP_GEMM_MAXDIM 1024   // Compute-bound long before this
+
+struct aussie_bench_sweep_kernel {
+	const char* name;
+	int kind;               // AUSSIE_SWEEP_*
+	int isa;                // Needs this AUSSIE_ISA_* level (or better)
+	bool parallel;          // Uses the thread pool (the all-threads roof)
+	aussie_vecdot_fnptr vecdotfn;
+	aussie_vector_reduce_fnptr reducefn;
+	aussie_vector_inplace_fnptr inplacefn;
+	double bytes_per_elem;  // Compulsory memory traffic
+	double flops_per_elem;
+};
+
+static const aussie_bench_sweep_kernel s_aussie_bench_sweep_kernels[] = {
+	{ "Vecdot basic", AUSSIE_SWEEP_VECDOT, AUSSIE_ISA_SCALAR, false, aussie_vecdot_basic, NULL, NULL, 8.0, 2.0 },
+#if AUSSIE_X86
+	{ "Vecdot FMA AVX2", AUSSIE_SWEEP_VECDOT, AUSSIE_ISA_AVX2, false, aussie_vecdot_FMA_unroll_AVX2, NULL, NULL, 8.0, 2.0 },
+	{ "Vecdot FMA AVX-512", AUSSIE_SWEEP_VECDOT, AUSSIE_ISA_AVX512, false, aussie_vecdot_FMA_unroll_AVX512, NULL, NULL, 8.0, 2.0 },
+#endif //AUSSIE_X86
+	{ "Vecdot dispatched", AUSSIE_SWEEP_VECDOT, AUSSIE_ISA_SCALAR, false, aussie_vecdot_dispatch, NULL, NULL, 8.0, 2.0 },
+	{ "Vecdot parallel", AUSSIE_SWEEP_VECDOT, AUSSIE_ISA_SCALAR, true, aussie_vecdot_parallel, NULL, NULL, 8.0, 2.0 },
+	{ "Sum of squares basic", AUSSIE_SWEEP_REDUCE, AUSSIE_ISA_SCALAR, false, NULL, aussie_vector_sum_squares, NULL, 4.0, 2.0 },
+#if AUSSIE_X86
+	{ "Sum of squares AVX1", AUSSIE_SWEEP_REDUCE, AUSSIE_ISA_AVX1, false, NULL, aussie_vector_sum_squares_AVX1, NULL, 4.0, 2.0 },
+	{ "Sum of squares AVX2", AUSSIE_SWEEP_REDUCE, AUSSIE_ISA_AVX2, false, NULL, aussie_vector_sum_squares_AVX2, NULL, 4.0, 2.0 },
+#endif //AUSSIE_X86
+	// Softmax: read + write, 5 FLOPs (max, subtract, exp counted as one, sum, scale)
+	{ "Softmax basic (3 pass)", AUSSIE_SWEEP_INPLACE, AUSSIE_ISA_SCALAR, false, NULL, NULL, aussie_vector_softmax_basic, 8.0, 5.0 },
+	{ "Softmax online", AUSSIE_SWEEP_INPLACE, AUSSIE_ISA_SCALAR, false, NULL, NULL, aussie_vector_softmax_online, 8.0, 5.0 },
+#if AUSSIE_X86
+	{ "Softmax online AVX2", AUSSIE_SWEEP_INPLACE, AUSSIE_ISA_AVX2, false, NULL, NULL, aussie_vector_softmax_online_AVX2, 8.0, 5.0 },
+	{ "Softmax online AVX-512", AUSSIE_SWEEP_INPLACE, AUSSIE_ISA_AVX512, false, NULL, NULL, aussie_vector_softmax_online_AVX512, 8.0, 5.0 },
+#endif //AUSSIE_X86
+	{ "Softmax dispatched", AUSSIE_SWEEP_INPLACE, AUSSIE_ISA_SCALAR, false, NULL, NULL, aussie_vector_softmax_dispatch, 8.0, 5.0 },
+	{ "Softmax parallel", AUSSIE_SWEEP_INPLACE, AUSSIE_ISA_SCALAR, true, NULL, NULL, aussie_vector_softmax_parallel, 8.0, 5.0 },
+	{ "GEMV parallel", AUSSIE_SWEEP_GEMV, AUSSIE_ISA_SCALAR, true, NULL, NULL, NULL, 4.0, 2.0 },
+	{ "GEMM dispatched", AUSSIE_SWEEP_GEMM, AUSSIE_ISA_SCALAR, false, NULL, NULL, NULL, 0.0, 0.0 },
+};
+
+struct aussie_bench_sweep_args {
+	const aussie_bench_sweep_kernel* k;
+	float* v1;
+	float* v2;
+	float* v3;
+	int n;
+	int nrows, ncols;  // GEMV and GEMM
+};
+
+static void aussie_bench_sweep_call(void* arg)
+{
+	aussie_bench_sweep_args* args = (aussie_bench_sweep_args*)arg;
+	const aussie_bench_sweep_kernel* k = args->k;
+	switch (k->kind) {
+	case AUSSIE_SWEEP_VECDOT: g_aussie_bench_sink = k->vecdotfn(args->v1, args->v2, args->n); break;
+	case AUSSIE_SWEEP_REDUCE: g_aussie_bench_sink = k->reducefn(args->v1, args->n); break;
+	case AUSSIE_SWEEP_INPLACE: k->inplacefn(args->v1, args->n); break;
+	case AUSSIE_SWEEP_GEMV: aussie_gemv_parallel(args->v1, args->nrows, args->ncols, args->ncols, args->v2, args->v3, 0); break;
+	default:
+		aussie_gemm(false, false, args->nrows, args->nrows, args->nrows, 1.0f, args->v1, args->nrows,
+			args->v2, args->nrows, 0.0f, args->v3, args->nrows);
+		break;
+	}
+}
+
+void aussie_benchmark_sweep()  // Roofline sweep of the vector and matrix kernels (slow: minutes)
+{
+	const aussie_bench_roofline& roof = aussie_bench_machine_roofline();
+	double maxbytes = 4.0 * roof.cache_bytes[2];
+	long maxn = (long)(maxbytes / sizeof(float));  // The largest single-vector working set
+	if (maxn > (1L << 30)) maxn = 1L << 30;
+	aussie_bench_sweep_args args;
+	memset(&args, 0, sizeof(args));
+	args.v1 = (float*)malloc(maxn * sizeof(float));
+	args.v2 = (float*)malloc(maxn / 2 * sizeof(float));  // Second vecdot vector (half size), GEMV input, GEMM B
+	args.v3 = (float*)malloc(maxn / 2 * sizeof(float));  // GEMV output, GEMM C
+	if (!args.v1 || !args.v2 || !args.v3) {
+		yassert(args.v1 && args.v2 && args.v3);
+		free(args.v1); free(args.v2); free(args.v3);
+		return;  // fail
+	}
+	for (long i = 0; i < maxn; i++) args.v1[i] = (float)(i % 7) / 7.0f;
+	for (long i = 0; i < maxn / 2; i++) args.v2[i] = (float)(i % 5) / 5.0f;
+	memset(args.v3, 0, maxn / 2 * sizeof(float));
+
+	int best = aussie_dispatch_best_isa();
+	aussie_bench_printf("Roofline sweep, 64 elements to %.0f MB (percent of the DRAM roofline, so cache-resident sizes can pass 100%%):\n",
+		maxbytes / (1024.0 * 1024.0));
+	for (int ik = 0; ik < (int)(sizeof(s_aussie_bench_sweep_kernels) / sizeof(s_aussie_bench_sweep_kernels[0])); ik++) {
+		const aussie_bench_sweep_kernel& k = s_aussie_bench_sweep_kernels[ik];
+		if (k.isa > best) continue;  // This CPU can't run it
+		args.k = &k;
+		for (long n = 64; n <= maxn; n *= 2) {
+			long nelem = n;
+			double bytes = k.bytes_per_elem * n;
+			double flops = k.flops_per_elem * n;
+			if (k.kind == AUSSIE_SWEEP_GEMV) {
+				args.ncols = n < 1024 ? (int)n : 1024;
+				args.nrows = (int)(n / args.ncols);
+				bytes = 4.0 * ((double)n + args.ncols + args.nrows);  // Weights, input, output
+			}
+			else if (k.kind == AUSSIE_SWEEP_GEMM) {
+				int d = (int)sqrt((double)n);
+				if (d > AUSSIE_SWEEP_GEMM_MAXDIM) break;
+				args.nrows = args.ncols = d;
+				nelem = (long)d * d;
+				bytes = 12.0 * nelem;  // A, B, C once each
+				flops = 2.0 * nelem * d;
+			}
+			if (bytes > maxbytes) break;
+			args.n = (int)n;
+
+			char name[100];
+			sprintf(name, "%s N=%ld", k.name, nelem);
+			aussie_bench_result res;
+			aussie_bench_result_init(res, name, nelem, bytes, flops);
+			if (!aussie_bench_run(res, aussie_bench_sweep_call, &args, NULL)) continue;
+			res.level = aussie_bench_cache_level(roof, bytes);
+			double roofgflops = aussie_bench_roof_gflopsec(roof, flops / bytes, k.parallel);
+			if (roofgflops > 0.0 && res.ns_median > 0.0) res.roofline_pct = 100.0 * (flops / res.ns_median) / roofgflops;
+			aussie_bench_report(res);
+		}
+		if (k.kind == AUSSIE_SWEEP_INPLACE) {
+			for (long i = 0; i < maxn; i++) args.v1[i] = (float)(i % 7) / 7.0f;  // Undo the in-place kernel
+		}
+	}
+	free(args.v1); free(args.v2); free(args.v3);
+}
+
 void aussie_benchmark_all()
 {
 	aussie_benchmark_matrix_matrix_multiplication();
 	aussie_benchmark_matrix_vector_multiply();
+	aussie_benchmark_matrix_vector_parallel();
+	aussie_benchmark_quant_gemv();
+	aussie_benchmark_half_gemv();
+	aussie_benchmark_float_conversions();
+	aussie_benchmark_lut_activations();
+	aussie_benchmark_vector_activations();
+	aussie_benchmark_gated_ffn();
+	aussie_benchmark_precompute_tables();
 	aussie_benchmark_softmax();
+	aussie_benchmark_softmax_vocab();
+	aussie_benchmark_topk();
+	aussie_benchmark_sampling();
 	aussie_benchmark_vector_exponentiation_operations();
 	aussie_benchmark_vector_scalar_operations();  // Vector-scalar benchmarks...
 	aussie_benchmark_vecdot();  // vector dot product benchmarks...
 	aussie_benchmark_normalization();
 	yap_benchmark_operations();
+	if (g_aussie_bench_config.format == AUSSIE_BENCH_TEXT) {  // Scratch memory used by the kernels
+		aussie_thread_arena_report(g_aussie_bench_config.fp ? g_aussie_bench_config.fp : stdout);
+	}
+}
+
+//---------------------------------------------------
+// Harness unit tests (tiny budget, output to a temporary file)
+//---------------------------------------------------
+
+static void aussie_bench_test_kernel(void* arg)
+{
+	float* v = (float*)arg;
+	float sum = 0.0f;
+	for (int i = 0; i < 64; i++) sum += v[i];
+	g_aussie_bench_sink = sum;
+}
+
+static void aussie_bench_test_setup(void* arg)
+{
+	float* v = (float*)arg;
+	v[0] += 1.0f;
+}
+
+static bool aussie_bench_test_contains(FILE* fp, const char* str)  // Rewind and search the whole output
+{
+	char buf[1000];
+	bool found = false;
+	rewind(fp);
+	while (fgets(buf, sizeof(buf), fp)) {
+		if (strstr(buf, str)) found = true;
+	}
+	return found;
+}
+
+void aussie_benchmark_unit_tests()
+{
+	fprintf(stderr, "INFO: %s: Running unit tests\n", __func__);
+	aussie_bench_config savecfg = g_aussie_bench_config;
+	bool saveenv = s_aussie_bench_env_done;
+	bool saveheader = s_aussie_bench_csv_header_done;
+	s_aussie_bench_env_done = true;  // Not the user's AUSSIE_BENCH_* here
+	g_aussie_bench_config.max_seconds = 0.02;
+	g_aussie_bench_config.min_sample_ns = 10000;
+	g_aussie_bench_config.min_samples = 5;
+	g_aussie_bench_config.max_samples = 50;
+
+	float v[64];
+	for (int i = 0; i < 64; i++) v[i] = (float)i;
+	ytest(aussie_bench_now_ns() > 0.0);
+	double t1 = aussie_bench_now_ns();
+	double t2 = aussie_bench_now_ns();
+	ytest(t2 >= t1);  // Monotonic
+
+	// Statistics are ordered and the run was calibrated
+	aussie_bench_result res;
+	aussie_bench_result_init(res, "test kernel", 64, 64.0 * sizeof(float), 64.0);
+	ytest(aussie_bench_run(res, aussie_bench_test_kernel, v, NULL));
+	ytest(res.nsamples >= 3 && res.nsamples <= 50);
+	ytest(res.calls_per_sample >= 1);
+	ytest(res.ns_min > 0.0);
+	ytest(res.ns_min <= res.ns_median && res.ns_median <= res.ns_p99);
+	ytest(res.ns_stddev >= 0.0);
+
+	// Setup runs before each call (and is not part of the time)
+	float v0 = v[0];
+	aussie_bench_result_init(res, "test kernel with setup", 64, 0.0, 0.0);
+	ytest(aussie_bench_run(res, aussie_bench_test_kernel, v, aussie_bench_test_setup));
+	ytest(v[0] > v0);
+	ytest(res.ns_min <= res.ns_median && res.ns_median <= res.ns_p99);
+
+	// Hardware counters: per call when available, otherwise cleanly time only
+	ytest(strcmp(aussie_bench_counter_name(AUSSIE_COUNTER_FP_OPS), "fp_ops") == 0);
+	g_aussie_bench_config.counters = true;
+	aussie_bench_result_init(res, "test kernel with counters", 64, 64.0 * sizeof(float), 64.0);
+	ytest(res.counters[AUSSIE_COUNTER_CYCLES] == -1.0);
+	ytest(aussie_bench_run(res, aussie_bench_test_kernel, v, aussie_bench_test_setup));
+	ytest(res.ns_min <= res.ns_median);
+	if (aussie_bench_counters_open()) {
+		ytest(res.has_counters);
+		if (res.counters[AUSSIE_COUNTER_INSTRUCTIONS] >= 0.0) ytest(res.counters[AUSSIE_COUNTER_INSTRUCTIONS] >= 64.0);  // 64 adds at least
+	}
+	else {
+		ytest(!res.has_counters);
+		for (int c = 0; c < AUSSIE_COUNTER_MAX; c++) ytest(res.counters[c] == -1.0);
+	}
+	aussie_bench_counters_close();
+	g_aussie_bench_config.counters = false;
+
+	// Roofline arithmetic (made-up machine: no measuring in unit tests)
+	aussie_bench_roofline roof;
+	memset(&roof, 0, sizeof(roof));
+	roof.gbsec[0] = 10.0;  roof.gbsec[1] = 40.0;
+	roof.gflopsec[0] = 100.0;  roof.gflopsec[1] = 400.0;
+	roof.cache_bytes[0] = 32 * 1024;  roof.cache_bytes[1] = 1024 * 1024;  roof.cache_bytes[2] = 32 * 1024 * 1024;
+	ytestf((float)aussie_bench_roof_gflopsec(roof, 0.25, false), 2.5f);  // Memory-bound (vecdot)
+	ytestf((float)aussie_bench_roof_gflopsec(roof, 0.25, true), 10.0f);
+	ytestf((float)aussie_bench_roof_gflopsec(roof, 100.0, false), 100.0f);  // Compute-bound (GEMM)
+	ytest(strcmp(aussie_bench_cache_level(roof, 1024), "L1") == 0);
+	ytest(strcmp(aussie_bench_cache_level(roof, 32 * 1024), "L1") == 0);
+	ytest(strcmp(aussie_bench_cache_level(roof, 512 * 1024), "L2") == 0);
+	ytest(strcmp(aussie_bench_cache_level(roof, 8 * 1024 * 1024), "L3") == 0);
+	ytest(strcmp(aussie_bench_cache_level(roof, 128.0 * 1024 * 1024), "DRAM") == 0);
+	ytest(res.roofline_pct == -1.0 && res.level == NULL);  // Only set by the sweep
+
+	// Output formats
+	FILE* fp = tmpfile();
+	if (fp) {
+		g_aussie_bench_config.fp = fp;
+		g_aussie_bench_config.format = AUSSIE_BENCH_CSV;
+		s_aussie_bench_csv_header_done = false;
+		aussie_bench_printf("title\n");  // Not in CSV
+		aussie_bench_report(res);
+		aussie_bench_report(res);
+		ytest(aussie_bench_test_contains(fp, "name,isa,n,samples"));
+		ytest(aussie_bench_test_contains(fp, ",ipc,"));
+		ytest(aussie_bench_test_contains(fp, "\"test kernel with counters\","));
+		ytest(!aussie_bench_test_contains(fp, "title"));
+		fclose(fp);
+	}
+	fp = tmpfile();
+	if (fp) {
+		g_aussie_bench_config.fp = fp;
+		g_aussie_bench_config.format = AUSSIE_BENCH_JSON;
+		aussie_bench_result_init(res, "quote \" name", 64, 0.0, 0.0);
+		ytest(aussie_bench_run(res, aussie_bench_test_kernel, v, NULL));
+		aussie_bench_report(res);
+		ytest(aussie_bench_test_contains(fp, "{\"name\":\"quote \\\" name\","));
+		ytest(aussie_bench_test_contains(fp, "\"median_ns\":"));
+		ytest(aussie_bench_test_contains(fp, "\"ipc\":null"));  // Not counted
+		ytest(aussie_bench_test_contains(fp, "\"roofline_pct\":null}"));
+		fclose(fp);
+	}
+	fp = tmpfile();
+	if (fp) {
+		g_aussie_bench_config.fp = fp;
+		g_aussie_bench_config.format = AUSSIE_BENCH_TEXT;
+		aussie_bench_printf("title %d\n", 42);
+		aussie_bench_report(res);
+		ytest(aussie_bench_test_contains(fp, "title 42"));
+		ytest(aussie_bench_test_contains(fp, "ns/elem"));
+		fclose(fp);
+	}
+
+	g_aussie_bench_config = savecfg;
+	s_aussie_bench_env_done = saveenv;
+	s_aussie_bench_csv_header_done = saveheader;
 }
 
 //---------------------------------------------------
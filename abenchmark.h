@@ -6,32 +6,145 @@
 #define AUSSIE_YBENCHMARK_INCLUDE_HEADER_H
 
 //---------------------------------------------------
+// Benchmark harness
+// ... monotonic clock (clock_gettime), not clock() CPU time
+// ... each sample runs enough calls to last min_sample_ns (timer overhead is noise)
+// ... warmup first, then samples until the median is stable (or the time budget runs out)
+// ... reports min/median/p99 per call, ns per element, GB/sec and GFLOP/sec
+// ... text, CSV or JSON Lines output, for tracking regressions across builds
+// Environment variables: AUSSIE_BENCH_FORMAT=text|csv|json, AUSSIE_BENCH_SECONDS=budget per kernel,
+//     AUSSIE_BENCH_COUNTERS=1 for hardware counters (below)
+//---------------------------------------------------
+
+#define AUSSIE_BENCH_TEXT 0
+#define AUSSIE_BENCH_CSV  1
+#define AUSSIE_BENCH_JSON 2   // JSON Lines: one object per kernel
+
+struct aussie_bench_config {
+	int format;            // AUSSIE_BENCH_TEXT/CSV/JSON
+	double min_sample_ns;  // Shortest sample (calls are batched up to this)
+	int warmup_samples;    // Untimed samples after calibration
+	int min_samples;       // Fewest samples before checking stability
+	int max_samples;
+	double max_seconds;    // Time budget per kernel (always at least 3 samples)
+	double stable_pct;     // Stable when the median moves less than this (percent) in 10 samples
+	FILE* fp;              // Output (NULL = stdout)
+	bool counters;         // Also read hardware performance counters (if available)
+};
+
+extern aussie_bench_config g_aussie_bench_config;
+void aussie_bench_config_from_env();  // Read AUSSIE_BENCH_* (automatic on first run)
+void aussie_bench_config_ensure();  // Read AUSSIE_BENCH_* unless already done
+
+//---------------------------------------------------
+// Hardware performance counters (Linux perf_event_open), optional
+// ... each kernel is counted in an extra untimed batch after its timed samples
+//     (so the timings have no counter overhead), and setup calls are subtracted
+// ... FP ops are Intel FP_ARITH_INST_RETIRED, weighted by vector width (FMA counts 2)
+// ... counts the calling thread only (parallel kernels: thread 0's share)
+// ... counters that can't be opened are left out (-1); none at all means time only
+//     (no PMU in a VM or container, or perf_event_paranoid too high)
+//---------------------------------------------------
+
+#define AUSSIE_COUNTER_CYCLES        0
+#define AUSSIE_COUNTER_INSTRUCTIONS  1
+#define AUSSIE_COUNTER_L1D_MISSES    2   // L1 data cache read misses
+#define AUSSIE_COUNTER_LLC_MISSES    3   // Last-level cache misses
+#define AUSSIE_COUNTER_BRANCH_MISSES 4
+#define AUSSIE_COUNTER_FP_OPS        5
+#define AUSSIE_COUNTER_MAX           6
+
+bool aussie_bench_counters_open();   // True if any counter works (tried once, on first use)
+void aussie_bench_counters_close();
+const char* aussie_bench_counter_name(int counter);
+
+struct aussie_bench_result {
+	const char* name;
+	long nelements;         // Elements per call (for ns per element)
+	double bytes;           // Memory traffic per call (0 = no GB/sec)
+	double flops;           // Floating-point operations per call (0 = no GFLOP/sec)
+	int nsamples;
+	long calls_per_sample;
+	double ns_min, ns_median, ns_p99, ns_mean, ns_stddev;  // Per call
+	bool has_counters;
+	double counters[AUSSIE_COUNTER_MAX];  // Per call (-1 = not counted)
+	const char* level;      // Sweep only: where the working set fits ("L1", "L2", "L3", "DRAM")
+	double roofline_pct;    // Sweep only: percent of the roofline achieved (-1 = not set)
+};
+
+typedef void (*aussie_bench_fnptr)(void* arg);
 
+double aussie_bench_now_ns();  // Monotonic clock in nanoseconds
+void aussie_bench_result_init(aussie_bench_result& res, const char* name, long nelements, double bytes, double flops);
+bool aussie_bench_run(aussie_bench_result& res, aussie_bench_fnptr fn, void* arg, aussie_bench_fnptr setup);  // setup() runs before each call, not timed
+void aussie_bench_report(const aussie_bench_result& res);
+void aussie_bench_printf(const char* fmt, ...);  // Titles and notes: text format only, so CSV/JSON stay clean
+extern volatile float g_aussie_bench_sink;  // Kernel results go here (so they are not optimized away)
+
+//---------------------------------------------------
+
+
+//---------------------------------------------------
+// Roofline size sweep
+// ... machine peaks are measured once: streaming read bandwidth (4x the LLC, so DRAM)
+//     and register-only FMA throughput, on one thread and on the whole thread pool
+// ... each kernel runs at sizes from 64 elements up to 4x the LLC (doubling), and each point
+//     reports its cache level, FLOP/byte (from the kernel's compulsory traffic),
+//     and the percent achieved of the roof: min(peak FLOP/sec, FLOP/byte x peak GB/sec)
+// ... the peaks are for this build (a -O0 build lowers them, like every kernel)
+//---------------------------------------------------
+
+struct aussie_bench_roofline {
+	double gbsec[2];      // Peak read bandwidth: [0] one thread, [1] all threads
+	double gflopsec[2];   // Peak FMA throughput: [0] one thread, [1] all threads
+	long cache_bytes[3];  // L1D, L2, L3 (LLC) sizes
+};
+
+const aussie_bench_roofline& aussie_bench_machine_roofline();  // Measured on the first call
+const char* aussie_bench_cache_level(const aussie_bench_roofline& roof, double working_set_bytes);  // "L1", "L2", "L3" or "DRAM"
+double aussie_bench_roof_gflopsec(const aussie_bench_roofline& roof, double flop_per_byte, bool parallel);  // Attainable GFLOP/sec
+void aussie_benchmark_sweep();  // Roofline sweep of the vector and matrix kernels (slow: minutes)
+
+//---------------------------------------------------
 
 void aussie_benchmark_all();
 void yap_test_operator_accuracy();    // Test approximate operations accuracy...
 void yap_benchmark_operations();
 void aussie_benchmark_normalization();   // Benchmark BatchNorm (LayerNorm?)
 void aussie_benchmark_softmax();
+void aussie_benchmark_softmax_vocab();  // Softmax over a 128K vocabulary (basic versus online)
+void aussie_benchmark_topk();  // Top-k: qsort and shuffle versus heap and select (50K-256K vocabularies)
+void aussie_benchmark_sampling();  // Token sampling: temperature, top-k, top-p (128K vocabulary)
 void aussie_benchmark_vecdot();  // vector dot product benchmarks...
 void aussie_benchmark_vector_scalar_operations();  // Vector-scalar benchmarks...
 void aussie_benchmark_vector_exponentiation_operations();   // Vector expf
 void aussie_benchmark_matrix_vector_multiply();
+void aussie_benchmark_matrix_vector_parallel();  // Thread scaling of the parallel GEMV
+void aussie_benchmark_quant_gemv();  // INT8 and Q4 GEMV versus FP32, with Q4 error
+void aussie_benchmark_half_gemv();  // FP16, BF16 and FP8 weight GEMV versus FP32, with their error
+void aussie_benchmark_float_conversions();  // FP16 and BF16 array conversions: scalar versus F16C, AVX2, AVX-512
+void aussie_benchmark_lut_activations();  // Interpolated GELU/SiLU/expf tables versus the exact functions
+void aussie_benchmark_vector_activations();  // SIMD GELU/SiLU/sigmoid over an FFN vector versus scalar and tables
+void aussie_benchmark_gated_ffn();  // Fused SwiGLU hidden layer versus two GEMVs and separate passes
+void aussie_benchmark_precompute_tables();  // Table generation: sequential versus the thread pool
 void aussie_benchmark_matrix_matrix_multiplication();
 
-void run_vector_float_N(char* name, long int niter, long int nvecsize, 
+// Old-style runners, now on the harness above (samples repeat until stable)
+void run_vector_float_N(char* name, long int nvecsize, 
 	void (*voidvectorfnptr)(const float v[], int n),
 	float (*floatvectorfnptr)(const float v[], const float v2[], int n));
 
-void run_vector_int_N(char* name, long int niter, long int nvecsize,
+void run_vector_int_N(char* name, long int nvecsize,
 	int (*intvectorfnptr)(int v[], int v2[], int n));
 
-void run_vector_scalar_N(char* name, long int niter, long int nvecsize, void (*vectorscalarfnptr)(float v[], int n, float scalar));
+void run_vector_scalar_N(char* name, long int nvecsize, void (*vectorscalarfnptr)(float v[], int n, float scalar));
 
 void run_arith_float_1000(char* name, long int n, float (*fnptr)(float a, float b), int (*ifnptr)(int a, int b));
 
 void test_accuracy_1000(char* name, long int n, float (*fnptr)(float a, float b), int (*ifnptr)(int a, int b));
 
+void aussie_benchmark_unit_tests();
+
 //---------------------------------------------------
 
 
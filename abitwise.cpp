@@ -60,14 +60,9 @@ void aussie_unit_test_one_popcount(unsigned int x, int expected)
 {
 	ytesti(aussie_popcount_basic(x), expected);
 	ytesti(aussie_popcount_kernighan_algorithm(x), expected);
-#if !LINUX
 	ytesti(aussie_popcount_intrinsics1(x), expected);
 	ytesti(aussie_popcount_intrinsics2(x), expected);
-#endif //LINUX
-
-#if !LINUX
-	ytesti(AUSSIE_POPCOUNT_MACRO(x), expected);
-#endif //LINUX
+	ytesti(AUSSIE_POPCOUNT(x), expected);
 	
 
 
@@ -144,10 +139,8 @@ int aussie_popcount_kernighan_algorithm(unsigned int x) // Brian Kernighan algor
 int aussie_popcount_intrinsics1(unsigned int x) // MSVC version &lt;intrin.h>
 {
 #if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
-	return 0;
+	return __builtin_popcount(x);  // GCC builtin (POPCNT instruction if enabled)
 #else
-	// TODO: __builtin_popcount for GCC on Linux
 	return _mm_popcnt_u32(x);  // Microsoft intrinsics MSVS
 #endif //LINUX
 }
@@ -155,10 +148,8 @@ int aussie_popcount_intrinsics1(unsigned int x) // MSVC version &lt;intrin.h>
 int aussie_popcount_intrinsics2(unsigned int x) // MSVC version &lt;intrin.h>
 {
 #if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
-	return 0;
+	return __builtin_popcount(x);  // GCC builtin
 #else
-	// TODO: __builtin_popcount for GCC on Linux
 	return __popcnt(x);  // Microsoft intrinsics MSVS
 #endif //LINUX
 }
@@ -171,12 +162,8 @@ void aussie_test_one_log2_integer(unsigned int u, int expected)
 {
 	ytesti(aussie_log2_integer_slow(u), expected);
 	ytesti(aussie_log2_integer_clz(u), expected);
-#if !LINUX
 	ytesti(aussie_log2_integer_clz_intrinsic(u), expected);
-#endif //LINUX
-#if !LINUX
 	ytesti(AUSSIE_LOG2_LZCNT(u), expected);
-#endif
 
 
 }
@@ -198,10 +185,8 @@ void aussie_unit_test_log2() // Log2 of integer unit tests
 void aussie_unit_test_one_clz(unsigned int u, int expected)
 {
 	ytesti(aussie_clz_slow(u), expected);
-#if !LINUX
 	ytesti(aussie_clz_intrinsics1(u), expected); // __lzcnt
 	ytesti(aussie_clz_intrinsics2(u), expected); // _BitScanReverse
-#endif //LINUX
 	
 
 }
@@ -238,10 +223,9 @@ int aussie_clz_slow(unsigned int u)
 int aussie_clz_intrinsics1(unsigned int u)
 {
 #if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
-	return 0;
+	if (u == 0) return 32;  // __builtin_clz(0) is undefined
+	return __builtin_clz(u);  // GCC builtin
 #else
-	// TODO: __builtin_clz on GCC for Linux
 	return __lzcnt(u);  // Windows <intrin.h>
 #endif //LINUX
 }
@@ -253,10 +237,10 @@ int aussie_clz_intrinsics1(unsigned int u)
 int aussie_clz_intrinsics2(unsigned int u)
 {
 #if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
-	return 0;
+	if (u == 0) return 32;  // Didn't find any bits set...
+	int bitindex = 31 - __builtin_clz(u);  // Highest set bit (like _BitScanReverse)
+	return 31 - bitindex;
 #else
-	// TODO: __builtin_clz on GCC for Linux
 	// _BitScanReverse or _BitScanForward
 	unsigned long ulongret = 0;
 	unsigned char foundbits = _BitScanReverse(&ulongret, u);  // Windows <intrin.h>
@@ -290,8 +274,9 @@ int aussie_log2_integer_clz(unsigned int u)  // LOG2 using count-leading-zeros
 int aussie_log2_integer_clz_intrinsic(unsigned int u)  // LOG2 using CLZ
 {
 #if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
-	return 0;
+	int clz = aussie_clz_intrinsics1(u);  // Count leading zeros (GCC builtin)
+	const int bits = 8 * sizeof(u);
+	return bits - clz - 1;
 #else
 	int clz = __lzcnt(u);  // Count leading zeros
 	const int bits = 8 * sizeof(u);
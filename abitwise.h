@@ -41,7 +41,12 @@ int aussie_popcount_basic(unsigned int x);  // Count number of 1's
 int aussie_popcount_kernighan_algorithm(unsigned int x); // Count number of 1's
 int aussie_popcount_intrinsics1(unsigned int x); // MSVC version <intrin.h>
 int aussie_popcount_intrinsics2(unsigned int x); // MSVC version <intrin.h>
-#define AUSSIE_POPCOUNT_MACRO(x) ( __popcnt((unsigned int)(x)) )
+#if LINUX
+#define AUSSIE_POPCOUNT(x) ( __builtin_popcount((unsigned int)(x)) )
+#else
+#define AUSSIE_POPCOUNT(x) ( __popcnt((unsigned int)(x)) )
+#define AUSSIE_POPCOUNT_MACRO(x) ( __popcnt((unsigned int)(x)) )  // Older name (MSVC only)
+#endif
 
 //--------------------------------------------------------------
 // LOG2 integer
@@ -49,7 +54,11 @@ int aussie_popcount_intrinsics2(unsigned int x); // MSVC version <intrin.h>
 int aussie_log2_integer_slow(unsigned int u);
 int aussie_log2_integer_clz(unsigned int u);  // LOG2 using count-leading-zeros;
 int aussie_log2_integer_clz_intrinsic(unsigned int u);  // LOG2 using CLZ
-#define AUSSIE_LOG2_LZCNT(u)  ( (8 * sizeof(unsigned)) - (__lzcnt((unsigned)(u))) - 1 )
+#if LINUX
+#define AUSSIE_LOG2_LZCNT(u)  ( (u) == 0 ? (yassert((u) != 0), -1) : (int)(8 * sizeof(unsigned)) - (int)__builtin_clz((unsigned)(u)) - 1 )  // -1 for zero (clz(0) is undefined)
+#else
+#define AUSSIE_LOG2_LZCNT(u)  ( (u) == 0 ? (yassert((u) != 0), -1) : (int)(8 * sizeof(unsigned)) - (int)__lzcnt((unsigned)(u)) - 1 )
+#endif
 
 
 //--------------------------------------------------------------
@@ -0,0 +1,145 @@
+// aconstexpr.cpp -- Compile-time precomputed tables -- Aussie AI Base Library
+// Created Oct 17th 2026
+// Copyright (c) 2023 Aussie AI Labs Pty Ltd
+//---------------------------------------------------
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "aport.h"
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+#include "aussieai.h"
+#include "aassert.h"
+#include "atest.h"
+#include "aactivation.h"
+#include "aprecompute.h"
+
+#include "aconstexpr.h"  // self-include
+
+//---------------------------------------------------
+// The ready-made tables: constant-initialized, so no startup code at all
+//---------------------------------------------------
+
+constexpr aussie_constexpr_table<1 << AUSSIE_CONSTEXPR_BF16_BITS> g_aussie_GELU_table_bf16 =
+	aussie_constexpr_table_bits<AUSSIE_CONSTEXPR_BF16_BITS>(aussie_constexpr_GELU);
+constexpr aussie_constexpr_table<1 << AUSSIE_CONSTEXPR_BF16_BITS> g_aussie_SiLU_table_bf16 =
+	aussie_constexpr_table_bits<AUSSIE_CONSTEXPR_BF16_BITS>(aussie_constexpr_SiLU);
+constexpr aussie_constexpr_table<1 << AUSSIE_CONSTEXPR_BF16_BITS> g_aussie_sqrt_table_bf16 =
+	aussie_constexpr_table_bits<AUSSIE_CONSTEXPR_BF16_BITS>(aussie_constexpr_sqrt);
+constexpr aussie_constexpr_table<AUSSIE_CONSTEXPR_SIGMOID_RANGE_N> g_aussie_sigmoid_table_range =
+	aussie_constexpr_table_range<AUSSIE_CONSTEXPR_SIGMOID_RANGE_N>(-16.0f, 16.0f, aussie_constexpr_sigmoid);
+
+// Checked by the compiler (a table built at startup couldn't be used here)
+static_assert(g_aussie_sqrt_table_bf16[0x4080] == 2.0f, "sqrt(4) in the constexpr table");  // 4.0f = 0x40800000
+static_assert(g_aussie_GELU_table_bf16[0x0000] == 0.0f, "GELU(0) in the constexpr table");
+static_assert(g_aussie_GELU_table_bf16[0x4120] == 10.0f, "GELU(10) in the constexpr table");  // 10.0f = 0x41200000
+static_assert(g_aussie_sigmoid_table_range[AUSSIE_CONSTEXPR_SIGMOID_RANGE_N - 1] > 0.9999998f, "sigmoid(16)");
+
+float aussie_GELU_table_bf16(float x)
+{
+	return g_aussie_GELU_table_bf16.lookup(x);
+}
+
+float aussie_SiLU_table_bf16(float x)
+{
+	return g_aussie_SiLU_table_bf16.lookup(x);
+}
+
+//---------------------------------------------------
+// Unit tests
+//---------------------------------------------------
+
+static float aussie_constexpr_test_max_relerr(const float* tbl, double (*refptr)(double))  // Over every finite bf16 value
+{
+	float maxerr = 0.0f;
+	for (unsigned int i = 0; i < (1u << AUSSIE_CONSTEXPR_BF16_BITS); i++) {
+		unsigned int u = i << (32 - AUSSIE_CONSTEXPR_BF16_BITS);
+		float x = *(float*)&u;
+		if (isnan(x) || isinf(x)) continue;
+		double ref = (*refptr)((double)x);
+		if (fabs(ref) < 1e-37) continue;  // Float denormal results: absolute error only
+		float err = (float)(fabs((double)tbl[i] - ref) / fabs(ref));
+		if (err > maxerr) maxerr = err;
+	}
+	return maxerr;
+}
+
+static double aussie_constexpr_test_GELU_ref(double x)
+{
+	return 0.5 * x * erfc(-x / sqrt(2.0));
+}
+
+static double aussie_constexpr_test_SiLU_ref(double x)
+{
+	return x / (1.0 + exp(-x));
+}
+
+void aussie_constexpr_unit_tests()
+{
+	fprintf(stderr, "INFO: %s: Running unit tests\n", __func__);
+
+	// The constexpr math against <math.h> (at run time, same functions)
+	ytest(fabs(aussie_constexpr_exp(1.0) - exp(1.0)) < 1e-15);
+	ytest(fabs(aussie_constexpr_exp(-20.5) - exp(-20.5)) < 1e-15 * exp(-20.5));
+	ytest(fabs(aussie_constexpr_erf(0.3) - erf(0.3)) < 1e-15);
+	ytest(fabs(aussie_constexpr_erfc(4.5) - erfc(4.5)) < 1e-13 * erfc(4.5));
+	ytest(fabs(aussie_constexpr_tanh(0.7) - tanh(0.7)) < 1e-15);
+	ytest(fabs(aussie_constexpr_tanh(1e-5) - tanh(1e-5)) < 1e-20);
+	ytest(fabs(aussie_constexpr_sqrt(2.0) - sqrt(2.0)) < 1e-15);
+	ytest(aussie_constexpr_float_from_bits(0x3F800000u) == 1.0);
+	ytest(aussie_constexpr_float_from_bits(0x00000001u) == (double)1.4e-45f);  // Smallest denormal
+	ytest(isinf(aussie_constexpr_float_from_bits(0xFF800000u)));
+
+	// Each table entry is the correctly rounded float, or within an ulp
+	float errgelu = aussie_constexpr_test_max_relerr(g_aussie_GELU_table_bf16.data, aussie_constexpr_test_GELU_ref);
+	float errsilu = aussie_constexpr_test_max_relerr(g_aussie_SiLU_table_bf16.data, aussie_constexpr_test_SiLU_ref);
+	fprintf(stderr, "INFO: Constexpr bf16 tables: GELU max relative error %g, SiLU %g\n", errgelu, errsilu);
+	ytest(errgelu < 1.2e-7f);
+	ytest(errsilu < 1.2e-7f);
+
+	// sqrt: same as sqrtf on every bf16 value (NaN for negatives)
+	int nbad = 0;
+	for (unsigned int i = 0; i < (1u << AUSSIE_CONSTEXPR_BF16_BITS); i++) {
+		unsigned int u = i << (32 - AUSSIE_CONSTEXPR_BF16_BITS);
+		float x = *(float*)&u;
+		float expect = sqrtf(x);
+		float got = g_aussie_sqrt_table_bf16[i];
+		if (got != expect && !(isnan(got) && isnan(expect))) {
+			if (nbad == 0) fprintf(stderr, "ERROR: constexpr sqrt(%g) = %.9g, expected %.9g\n", x, got, expect);
+			nbad++;
+		}
+	}
+	ytesti(nbad, 0);
+
+	// Range table: same breakpoints as aussie_precompute_table_FP32_range
+	float* rt = (float*)malloc(AUSSIE_CONSTEXPR_SIGMOID_RANGE_N * sizeof(float));
+	aussie_precompute_table_FP32_range(rt, AUSSIE_CONSTEXPR_SIGMOID_RANGE_N, -16.0f, 16.0f, aussie_sigmoid);
+	float maxdiff = 0.0f;
+	for (int i = 0; i < AUSSIE_CONSTEXPR_SIGMOID_RANGE_N; i++) {
+		float d = fabsf(rt[i] - g_aussie_sigmoid_table_range[i]);
+		if (d > maxdiff) maxdiff = d;
+	}
+	free(rt);
+	ytest(maxdiff < 2e-7f);
+
+	// Lookups (bf16 inputs are exact)
+	ytest(g_aussie_GELU_table_bf16.size() == 65536);
+	ytest(fabsf(aussie_GELU_table_bf16(1.0f) - aussie_GELU_basic(1.0f)) < 1e-6f);
+	ytest(fabsf(aussie_GELU_table_bf16(-2.5f) - aussie_GELU_basic(-2.5f)) < 1e-6f);
+	ytest(fabsf(aussie_SiLU_table_bf16(3.0f) - aussie_SiLU_basic(3.0f)) < 1e-6f);
+	ytestf(aussie_GELU_table_bf16(INFINITY), INFINITY);
+	ytestf(aussie_SiLU_table_bf16(-INFINITY), 0.0f);
+	ytestf(g_aussie_sqrt_table_bf16.lookup(9.0f), 3.0f);
+	ytest(isnan(aussie_GELU_table_bf16(NAN)));
+}
+
+//---------------------------------------------------
+//---------------------------------------------------
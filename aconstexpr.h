@@ -0,0 +1,224 @@
+//---------------------------------------------------
+// aconstexpr.h -- Compile-time precomputed tables -- Aussie AI Base Library
+// Created Oct 17th 2026
+// Copyright (c) 2023 Aussie AI Labs Pty Ltd
+//---------------------------------------------------
+
+#ifndef AUSSIE_YCONSTEXPR_INCLUDE_HEADER_H
+#define AUSSIE_YCONSTEXPR_INCLUDE_HEADER_H
+
+//---------------------------------------------------
+// Small tables (up to 64K entries) computed by the compiler: a constexpr table object
+// is emitted into .rodata, so there is no startup cost and no generated source file.
+// ... the math is in double (the <math.h> functions aren't constexpr), rounded to float once
+// ... compilers cap the work in one constant expression (GCC -fconstexpr-ops-limit, 33M by default;
+//     clang -fconstexpr-steps; MSVC /constexpr:steps), which is a few hundred operations
+//     per entry for a 64K table: enough for the functions below
+// ... bigger tables: the 24-bit table files (aprecompute.h), generated in parallel
+//---------------------------------------------------
+
+#define AUSSIE_CONSTEXPR_MAX_ENTRIES  (1 << 16)
+
+//---------------------------------------------------
+// Constexpr math (double precision, about 1e-15 relative error)
+//---------------------------------------------------
+
+constexpr double aussie_constexpr_pow2(int k)  // 2^k, exact (until it underflows)
+{
+	double p = (k >= 0) ? 2.0 : 0.5;
+	unsigned int m = (k >= 0) ? (unsigned int)k : (unsigned int)-k;
+	double r = 1.0;
+	while (m) {
+		if (m & 1u) r *= p;
+		m >>= 1;
+		if (m) p *= p;
+	}
+	return r;
+}
+
+constexpr double aussie_constexpr_exp(double x)
+{
+	if (x != x) return x;  // NaN
+	if (x > 709.0) return __builtin_inf();
+	if (x < -745.0) return 0.0;
+	// x = k*ln2 + r, |r| <= ln2/2, Taylor series for e^r
+	const double ln2 = 0.69314718055994530942;
+	long long k = (long long)(x / ln2 + (x >= 0.0 ? 0.5 : -0.5));
+	double r = x - (double)k * ln2;
+	double term = 1.0, sum = 1.0;
+	for (int i = 1; i <= 20; i++) {
+		term *= r / i;
+		sum += term;
+		if (term < 1e-18 && term > -1e-18) break;
+	}
+	return sum * aussie_constexpr_pow2((int)k);
+}
+
+constexpr double aussie_constexpr_sqrt(double x)
+{
+	if (x != x || x < 0.0) return __builtin_nan("");
+	if (x == 0.0 || x > 1.7976931348623157e308) return x;  // Zero, Inf
+	double scale = 1.0;  // Bring x into [0.25,4]: sqrt(x * 4^k) = sqrt(x) * 2^k
+	while (x > 4.0) { x *= 0.25; scale *= 2.0; }
+	while (x < 0.25) { x *= 4.0; scale *= 0.5; }
+	double y = 0.5 * (1.0 + x);
+	for (int i = 0; i < 8; i++) y = 0.5 * (y + x / y);  // Newton
+	return y * scale;
+}
+
+constexpr double aussie_constexpr_tanh(double x)
+{
+	if (x != x) return x;
+	if (x > 20.0) return 1.0;
+	if (x < -20.0) return -1.0;
+	if (x < 1e-3 && x > -1e-3) {  // Series (no cancellation in e^2x - 1)
+		double x2 = x * x;
+		return x * (1.0 - x2 * (1.0 / 3.0 - x2 * (2.0 / 15.0)));
+	}
+	double e2x = aussie_constexpr_exp(2.0 * x);
+	return (e2x - 1.0) / (e2x + 1.0);
+}
+
+constexpr double aussie_constexpr_sigmoid(double x)
+{
+	if (x != x) return x;
+	if (x < -745.0) return 0.0;
+	return 1.0 / (1.0 + aussie_constexpr_exp(-x));
+}
+
+constexpr double aussie_constexpr_SiLU(double x)
+{
+	if (x > 40.0) return x;
+	if (x < -120.0) return -0.0;  // Below the smallest float denormal
+	return x * aussie_constexpr_sigmoid(x);
+}
+
+constexpr double aussie_constexpr_erfc_large(double x)  // x >= 3: continued fraction
+{
+	double t = x;
+	for (int k = 60; k >= 1; k--) t = x + (k * 0.5) / t;
+	return aussie_constexpr_exp(-x * x) / (t * 1.7724538509055160273);  // sqrt(pi)
+}
+
+constexpr double aussie_constexpr_erf(double x)
+{
+	if (x != x) return x;
+	if (x < 0.0) return -aussie_constexpr_erf(-x);
+	if (x > 6.0) return 1.0;
+	if (x >= 3.0) return 1.0 - aussie_constexpr_erfc_large(x);
+	// Taylor series: 2/sqrt(pi) * sum (-1)^n x^(2n+1) / (n! (2n+1))
+	double x2 = x * x, term = x, sum = x;
+	for (int n = 1; n < 60; n++) {
+		term *= -x2 / n;
+		double d = term / (2 * n + 1);
+		sum += d;
+		if (d < 1e-18 * sum && d > -1e-18 * sum) break;
+	}
+	return sum * 1.1283791670955125739;
+}
+
+constexpr double aussie_constexpr_erfc(double x)  // 1 - erf(x), without the cancellation for large x
+{
+	if (x != x) return x;
+	if (x > 27.0) return 0.0;
+	if (x >= 3.0) return aussie_constexpr_erfc_large(x);
+	return 1.0 - aussie_constexpr_erf(x);
+}
+
+constexpr double aussie_constexpr_GELU(double x)  // 0.5 * x * (1 + erf(x/sqrt(2)))
+{
+	if (x > 10.0) return x;
+	if (x < -20.0) return -0.0;  // Below the smallest float denormal
+	return 0.5 * x * aussie_constexpr_erfc(-x * 0.70710678118654752440);
+}
+
+constexpr double aussie_constexpr_float_from_bits(unsigned int u)  // Value of a float's bit pattern (no bit casts in constexpr)
+{
+	unsigned int expo = (u >> 23) & 0xFFu;
+	unsigned int mant = u & 0x7FFFFFu;
+	double v = 0.0;
+	if (expo == 0) v = mant * aussie_constexpr_pow2(-149);  // Zero or denormal
+	else if (expo == 0xFFu) v = mant ? __builtin_nan("") : __builtin_inf();
+	else v = (1.0 + mant / 8388608.0) * aussie_constexpr_pow2((int)expo - 127);
+	return (u >> 31) ? -v : v;
+}
+
+constexpr int aussie_constexpr_log2(unsigned int n)  // Floor
+{
+	int k = 0;
+	while (n > 1) { n >>= 1; k++; }
+	return k;
+}
+
+//---------------------------------------------------
+// Tables
+//---------------------------------------------------
+
+template<int N>
+struct aussie_constexpr_table {
+	float data[N];
+
+	constexpr int size() const { return N; }
+	constexpr float operator[](int i) const { return data[i]; }
+	float lookup(float f) const  // Tables from aussie_constexpr_table_bits: index by the top bits of f
+	{
+		return data[(*(const unsigned int*)&f) >> (32 - aussie_constexpr_log2(N))];
+	}
+};
+
+// Table indexed by the top BITS bits of a float, like aussie_precompute_table_FP32_generic_bits
+// (16 bits = the bfloat16 bit pattern). NaN patterns give NaN without calling fn.
+template<int BITS, typename FN>
+constexpr aussie_constexpr_table<(1 << BITS)> aussie_constexpr_table_bits(FN fn)
+{
+	static_assert(BITS >= 1 && (1 << BITS) <= AUSSIE_CONSTEXPR_MAX_ENTRIES, "aussie_constexpr_table_bits: 1..16 bits");
+	aussie_constexpr_table<(1 << BITS)> t = {};
+	for (unsigned int i = 0; i < (1u << BITS); i++) {
+		unsigned int u = i << (32 - BITS);
+		if (((u >> 23) & 0xFFu) == 0xFFu && (u & 0x7FFFFFu) != 0) t.data[i] = __builtin_nanf("");
+		else t.data[i] = (float)fn(aussie_constexpr_float_from_bits(u));
+	}
+	return t;
+}
+
+// N evenly spaced x in [xmin,xmax], both ends included, like aussie_precompute_table_FP32_range
+// (same float breakpoints, so the two agree to rounding)
+template<int N, typename FN>
+constexpr aussie_constexpr_table<N> aussie_constexpr_table_range(float xmin, float xmax, FN fn)
+{
+	static_assert(N >= 2 && N <= AUSSIE_CONSTEXPR_MAX_ENTRIES, "aussie_constexpr_table_range: 2..64K entries");
+	aussie_constexpr_table<N> t = {};
+	double step = ((double)xmax - (double)xmin) / (double)(N - 1);
+	for (int i = 0; i < N; i++) {
+		float x = (i == N - 1) ? xmax : (float)((double)xmin + step * i);
+		t.data[i] = (float)fn((double)x);
+	}
+	return t;
+}
+
+//---------------------------------------------------
+// Ready-made tables (aconstexpr.cpp), in .rodata
+//---------------------------------------------------
+
+#define AUSSIE_CONSTEXPR_BF16_BITS  16
+
+extern const aussie_constexpr_table<1 << AUSSIE_CONSTEXPR_BF16_BITS> g_aussie_GELU_table_bf16;   // 256KB, g_aussie_GELU_table_bf16.lookup(x)
+extern const aussie_constexpr_table<1 << AUSSIE_CONSTEXPR_BF16_BITS> g_aussie_SiLU_table_bf16;
+extern const aussie_constexpr_table<1 << AUSSIE_CONSTEXPR_BF16_BITS> g_aussie_sqrt_table_bf16;   // Same as g_sqrt_float_precomp_table, without aussie_precompute_sqrt
+
+#define AUSSIE_CONSTEXPR_SIGMOID_RANGE_N  4096
+extern const aussie_constexpr_table<AUSSIE_CONSTEXPR_SIGMOID_RANGE_N> g_aussie_sigmoid_table_range;  // x in [-16,16]
+
+float aussie_GELU_table_bf16(float x);  // Truncates x to bfloat16 (like the 24-bit table truncates to 24 bits)
+float aussie_SiLU_table_bf16(float x);
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+void aussie_constexpr_unit_tests();
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+
+#endif //AUSSIE_YCONSTEXPR_INCLUDE_HEADER_H
@@ -0,0 +1,531 @@
+// adispatch.cpp -- Runtime CPU feature detection and SIMD kernel dispatch -- Aussie AI Base Library
+// Created Oct 17th 2026
+// Copyright (c) 2023 Aussie AI Labs Pty Ltd
+//---------------------------------------------------
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <math.h>
+#include <mutex>
+#include <atomic>
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+#include "aport.h"
+#include "aussieai.h"
+#include "aassert.h"
+#include "atest.h"
+#include "avector.h"
+#include "aactivation.h"
+#include "aavx.h"
+#include "asoftmax.h"
+#include "atopk.h"
+
+#if AUSSIE_X86
+#if LINUX
+#include <cpuid.h>   // GCC __cpuid_count
+#else
+#include <intrin.h>  // MSVC __cpuidex, _xgetbv
+#endif
+#endif //AUSSIE_X86
+
+#include "adispatch.h"  // self-include
+
+//---------------------------------------------------
+// CPU feature detection
+//---------------------------------------------------
+
+#if AUSSIE_X86
+static void aussie_cpuid(unsigned int leaf, unsigned int subleaf, unsigned int regs[4])
+{
+	// regs[] = EAX, EBX, ECX, EDX
+#if LINUX
+	__cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#else
+	int r[4] = { 0 };
+	__cpuidex(r, (int)leaf, (int)subleaf);
+	for (int i = 0; i < 4; i++) regs[i] = (unsigned int)r[i];
+#endif
+}
+
+static unsigned long long aussie_xgetbv(unsigned int xcr)
+{
+	// Which register states the OS saves on context switches (XCR0)
+#if LINUX
+	unsigned int eax = 0, edx = 0;
+	__asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(xcr));
+	return ((unsigned long long)edx << 32) | eax;
+#else
+	return _xgetbv(xcr);
+#endif
+}
+#endif //AUSSIE_X86
+
+#define AUSSIE_CPUID_BIT(reg, bit)  ( ((reg) & (1u << (bit))) != 0 )
+
+static aussie_cpu_features aussie_cpu_run_cpuid()
+{
+	aussie_cpu_features f;
+	memset(&f, 0, sizeof(f));
+#if AUSSIE_X86
+	unsigned int regs[4] = { 0 };
+	aussie_cpuid(0, 0, regs);
+	unsigned int maxleaf = regs[0];
+
+	aussie_cpuid(1, 0, regs);
+	unsigned int ecx1 = regs[2], edx1 = regs[3];
+	f.sse2 = AUSSIE_CPUID_BIT(edx1, 26);
+	f.sse3 = AUSSIE_CPUID_BIT(ecx1, 0);
+	f.ssse3 = AUSSIE_CPUID_BIT(ecx1, 9);
+	f.fma = AUSSIE_CPUID_BIT(ecx1, 12);
+	f.sse41 = AUSSIE_CPUID_BIT(ecx1, 19);
+	f.sse42 = AUSSIE_CPUID_BIT(ecx1, 20);
+	f.popcnt = AUSSIE_CPUID_BIT(ecx1, 23);
+	bool osxsave = AUSSIE_CPUID_BIT(ecx1, 27);
+	f.avx = AUSSIE_CPUID_BIT(ecx1, 28);
+	f.f16c = AUSSIE_CPUID_BIT(ecx1, 29);
+
+	if (osxsave) {
+		unsigned long long xcr0 = aussie_xgetbv(0);
+		f.os_avx = (xcr0 & 0x6) == 0x6;   // XMM and YMM state
+		f.os_avx512 = (xcr0 & 0xE6) == 0xE6;  // ... plus opmask and ZMM state
+	}
+
+	if (maxleaf >= 7) {
+		aussie_cpuid(7, 0, regs);
+		unsigned int ebx7 = regs[1], ecx7 = regs[2];
+		unsigned int maxsubleaf = regs[0];
+		f.avx2 = AUSSIE_CPUID_BIT(ebx7, 5);
+		f.avx512f = AUSSIE_CPUID_BIT(ebx7, 16);
+		f.avx512bw = AUSSIE_CPUID_BIT(ebx7, 30);
+		f.avx512vl = AUSSIE_CPUID_BIT(ebx7, 31);
+		f.avx512vnni = AUSSIE_CPUID_BIT(ecx7, 11);
+		f.avx512vbmi = AUSSIE_CPUID_BIT(ecx7, 1);
+		if (maxsubleaf >= 1) {
+			aussie_cpuid(7, 1, regs);
+			f.avxvnni = AUSSIE_CPUID_BIT(regs[0], 4);
+			f.avx512bf16 = AUSSIE_CPUID_BIT(regs[0], 5);
+		}
+	}
+#endif //AUSSIE_X86
+	f.detected = true;
+	return f;
+}
+
+const aussie_cpu_features& aussie_cpu_detect()  // Run CPUID (only once)
+{
+	static const aussie_cpu_features s_aussie_cpu = aussie_cpu_run_cpuid();  // Thread-safe static init: concurrent first calls wait
+	return s_aussie_cpu;
+}
+
+bool aussie_cpu_has_sse41()
+{
+	return aussie_cpu_detect().sse41;
+}
+
+bool aussie_cpu_has_avx()  // AVX (128-bit "AVX1" kernels) and OS support
+{
+	const aussie_cpu_features& f = aussie_cpu_detect();
+	return f.avx && f.sse41 && f.os_avx;
+}
+
+bool aussie_cpu_has_avx2()  // AVX-2 and FMA (256-bit kernels)
+{
+	const aussie_cpu_features& f = aussie_cpu_detect();
+	return f.avx2 && f.fma && f.os_avx;
+}
+
+bool aussie_cpu_has_avx512()  // AVX-512 F/BW/VL (512-bit kernels)
+{
+	const aussie_cpu_features& f = aussie_cpu_detect();
+	return aussie_cpu_has_avx2() && f.avx512f && f.avx512bw && f.avx512vl && f.os_avx512;
+}
+
+bool aussie_cpu_has_avx512_vnni()  // ... plus VNNI (int8 dot products)
+{
+	return aussie_cpu_has_avx512() && aussie_cpu_detect().avx512vnni;
+}
+
+bool aussie_cpu_has_avx512_vbmi()  // ... plus VBMI (byte shuffles: vpermb, vpermi2b)
+{
+	return aussie_cpu_has_avx512() && aussie_cpu_detect().avx512vbmi;
+}
+
+void aussie_cpu_print_features(FILE* fp)
+{
+	const aussie_cpu_features& f = aussie_cpu_detect();
+	fprintf(fp, "CPU features:%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s\n",
+		f.sse2 ? " SSE2" : "",
+		f.sse3 ? " SSE3" : "",
+		f.ssse3 ? " SSSE3" : "",
+		f.sse41 ? " SSE4.1" : "",
+		f.sse42 ? " SSE4.2" : "",
+		f.popcnt ? " POPCNT" : "",
+		f.avx ? " AVX" : "",
+		f.avx2 ? " AVX2" : "",
+		f.fma ? " FMA" : "",
+		f.f16c ? " F16C" : "",
+		f.avx512f ? " AVX512F" : "",
+		f.avx512bw ? " AVX512BW" : "",
+		f.avx512vl ? " AVX512VL" : "",
+		f.avx512vnni ? " AVX512VNNI" : "",
+		f.avx512bf16 ? " AVX512BF16" : "",
+		f.avx512vbmi ? " AVX512VBMI" : "",
+		f.avxvnni ? " AVXVNNI" : ""
+	);
+	fprintf(fp, "CPU best dispatch level: %s\n", aussie_dispatch_isa_name(aussie_dispatch_best_isa()));
+}
+
+//---------------------------------------------------
+// Kernel dispatch table
+//---------------------------------------------------
+
+aussie_dispatch_table g_aussie_dispatch = { 0 };
+static std::atomic<bool> s_aussie_dispatch_bound(false);  // Set (release) after the table is fully written
+static std::once_flag s_aussie_dispatch_once;
+
+const char* aussie_dispatch_isa_name(int isa)
+{
+	switch (isa) {
+	case AUSSIE_ISA_SCALAR: return "scalar";
+	case AUSSIE_ISA_AVX1: return "avx1";
+	case AUSSIE_ISA_AVX2: return "avx2";
+	case AUSSIE_ISA_AVX512: return "avx512";
+	default: return "unknown";
+	}
+}
+
+static bool aussie_dispatch_isa_supported(int isa)
+{
+	switch (isa) {
+	case AUSSIE_ISA_SCALAR: return true;
+	case AUSSIE_ISA_AVX1: return aussie_cpu_has_avx();
+	case AUSSIE_ISA_AVX2: return aussie_cpu_has_avx2();
+	case AUSSIE_ISA_AVX512: return aussie_cpu_has_avx512();
+	default: return false;
+	}
+}
+
+int aussie_dispatch_best_isa()  // Fastest level supported by this CPU
+{
+	for (int isa = AUSSIE_ISA_AVX512; isa > AUSSIE_ISA_SCALAR; isa--) {
+		if (aussie_dispatch_isa_supported(isa)) return isa;
+	}
+	return AUSSIE_ISA_SCALAR;
+}
+
+bool aussie_dispatch_set_isa(int isa)  // Force a level (false if this CPU doesn't support it)
+{
+	if (!aussie_dispatch_isa_supported(isa)) return false;
+	aussie_dispatch_table t;
+	memset(&t, 0, sizeof(t));
+	t.isa = isa;
+	switch (isa) {
+#if AUSSIE_X86
+	case AUSSIE_ISA_AVX1:
+		t.lanes = 4;
+		t.fn_vecdot = aussie_vecdot_unroll_AVX1;
+		t.fn_sum = aussie_vector_sum_AVX1;
+		t.fn_max = aussie_vector_max_AVX1;
+		t.fn_min = aussie_vector_min_AVX1;
+		t.fn_multiply_scalar = aussie_vector_multiply_scalar_AVX1;
+		t.fn_reluize = aussie_vector_reluize_AVX1;
+		t.fn_sum_diff_squared_fused = aussie_vector_sum_diff_squared_fused_AVX1;
+		t.fn_expf = aussie_vector_expf_AVX1;
+		t.fn_expf_sum = aussie_vector_fused_expf_sum_AVX1;
+		t.fn_indices_ge = aussie_vector_indices_ge;  // No 128-bit version (no movemask gain)
+		t.fn_sigmoid = aussie_vector_sigmoid;  // No 128-bit activations (AVX1 has no FMA)
+		t.fn_SiLU = aussie_vector_SiLU;
+		t.fn_GELU_tanh = aussie_vector_GELU_tanh;
+		t.fn_GELU_sigmoid = aussie_vector_GELU_sigmoid;
+		break;
+	case AUSSIE_ISA_AVX2:
+		t.lanes = 8;
+		t.fn_vecdot = aussie_vecdot_FMA_unroll_AVX2;
+		t.fn_sum = aussie_vector_sum_AVX2;
+		t.fn_max = aussie_vector_max_AVX2;
+		t.fn_min = aussie_vector_min_AVX2;
+		t.fn_multiply_scalar = aussie_vector_multiply_scalar_AVX2;
+		t.fn_reluize = aussie_vector_reluize_AVX2;
+		t.fn_sum_diff_squared_fused = aussie_vector_sum_diff_squared_fused_AVX2;
+		t.fn_expf = aussie_vector_expf_AVX2;
+		t.fn_expf_sum = aussie_vector_fused_expf_sum_AVX2;
+		t.fn_indices_ge = aussie_vector_indices_ge_AVX2;
+		t.fn_sigmoid = aussie_vector_sigmoid_AVX2;
+		t.fn_SiLU = aussie_vector_SiLU_AVX2;
+		t.fn_GELU_tanh = aussie_vector_GELU_tanh_AVX2;
+		t.fn_GELU_sigmoid = aussie_vector_GELU_sigmoid_AVX2;
+		break;
+	case AUSSIE_ISA_AVX512:
+		t.lanes = 16;
+		t.fn_vecdot = aussie_vecdot_FMA_unroll_AVX512;
+		t.fn_sum = aussie_vector_sum_AVX512;
+		t.fn_max = aussie_vector_max_AVX512;
+		t.fn_min = aussie_vector_min_AVX512;
+		t.fn_multiply_scalar = aussie_vector_multiply_scalar_AVX512;
+		t.fn_reluize = aussie_vector_reluize_AVX512;
+		t.fn_sum_diff_squared_fused = aussie_vector_sum_diff_squared_fused_AVX512;
+		t.fn_expf = aussie_vector_expf_AVX512;
+		t.fn_expf_sum = aussie_vector_fused_expf_sum_AVX512;
+		t.fn_indices_ge = aussie_vector_indices_ge_AVX512;
+		t.fn_sigmoid = aussie_vector_sigmoid_AVX512;
+		t.fn_SiLU = aussie_vector_SiLU_AVX512;
+		t.fn_GELU_tanh = aussie_vector_GELU_tanh_AVX512;
+		t.fn_GELU_sigmoid = aussie_vector_GELU_sigmoid_AVX512;
+		break;
+#endif //AUSSIE_X86
+	default:
+		t.isa = AUSSIE_ISA_SCALAR;
+		t.lanes = 1;
+		t.fn_vecdot = aussie_vecdot_basic;
+		t.fn_sum = aussie_vector_sum;
+		t.fn_max = aussie_vector_max;
+		t.fn_min = aussie_vector_min;
+		t.fn_multiply_scalar = aussie_vector_multiply_scalar;
+		t.fn_reluize = aussie_vector_reluize;
+		t.fn_sum_diff_squared_fused = aussie_vector_sum_diff_squared_fused;
+		t.fn_expf = aussie_vector_expf;
+		t.fn_expf_sum = aussie_vector_expf_and_sum;
+		t.fn_indices_ge = aussie_vector_indices_ge;
+		t.fn_sigmoid = aussie_vector_sigmoid;
+		t.fn_SiLU = aussie_vector_SiLU;
+		t.fn_GELU_tanh = aussie_vector_GELU_tanh;
+		t.fn_GELU_sigmoid = aussie_vector_GELU_sigmoid;
+		break;
+	}
+	g_aussie_dispatch = t;
+	s_aussie_dispatch_bound.store(true, std::memory_order_release);
+	return true;
+}
+
+void aussie_dispatch_init()  // Bind the function pointers (once, automatically on first call)
+{
+	int isa = aussie_dispatch_best_isa();
+	const char* envstr = getenv("AUSSIE_ISA");  // Manual override (e.g. debugging a SIMD kernel)
+	if (envstr != NULL) {
+		int envisa = -1;
+		for (int i = AUSSIE_ISA_SCALAR; i <= AUSSIE_ISA_AVX512; i++) {
+			if (strcmp(envstr, aussie_dispatch_isa_name(i)) == 0) envisa = i;
+		}
+		if (envisa >= 0 && aussie_dispatch_isa_supported(envisa)) isa = envisa;
+		else fprintf(stderr, "WARNING: %s: AUSSIE_ISA=%s not supported, using %s\n", __func__, envstr, aussie_dispatch_isa_name(isa));
+	}
+	aussie_dispatch_set_isa(isa);
+}
+
+void aussie_dispatch_ensure()  // Lazy init, safe from any thread (the table is complete before anyone sees it)
+{
+	if (s_aussie_dispatch_bound.load(std::memory_order_acquire)) return;
+	std::call_once(s_aussie_dispatch_once, []() {
+		if (!s_aussie_dispatch_bound.load(std::memory_order_acquire)) aussie_dispatch_init();  // Not if set_isa got there first
+	});
+}
+
+#define AUSSIE_DISPATCH_CHECK()  aussie_dispatch_ensure()
+
+//---------------------------------------------------
+// Dispatched kernels
+// ... all the bound kernels handle any n and unaligned vectors themselves.
+//---------------------------------------------------
+
+float aussie_vecdot_dispatch(const float v1[], const float v2[], int n)
+{
+	AUSSIE_DISPATCH_CHECK();
+	return g_aussie_dispatch.fn_vecdot(v1, v2, n);
+}
+
+float aussie_vector_sum_dispatch(float v[], int n)
+{
+	AUSSIE_DISPATCH_CHECK();
+	return g_aussie_dispatch.fn_sum(v, n);
+}
+
+float aussie_vector_max_dispatch(float v[], int n)
+{
+	if (n <= 0) {
+		yassert(n > 0);
+		return 0.0f;  // fail
+	}
+	AUSSIE_DISPATCH_CHECK();
+	return g_aussie_dispatch.fn_max(v, n);
+}
+
+float aussie_vector_min_dispatch(float v[], int n)
+{
+	if (n <= 0) {
+		yassert(n > 0);
+		return 0.0f;  // fail
+	}
+	AUSSIE_DISPATCH_CHECK();
+	return g_aussie_dispatch.fn_min(v, n);
+}
+
+void aussie_vector_multiply_scalar_dispatch(float v[], int n, float c)
+{
+	AUSSIE_DISPATCH_CHECK();
+	g_aussie_dispatch.fn_multiply_scalar(v, n, c);
+}
+
+void aussie_vector_reluize_dispatch(float v[], int n)
+{
+	AUSSIE_DISPATCH_CHECK();
+	g_aussie_dispatch.fn_reluize(v, n);
+}
+
+float aussie_vector_mean_and_variance_dispatch(float v[], int n, float& fmean_out)
+{
+	// Fused version: leaves the DIFF from MEAN in the vector
+	if (n <= 0) {
+		yassert(n > 0);
+		return 0.0f;  // fail
+	}
+	fmean_out = aussie_vector_sum_dispatch(v, n) / (float)n;
+	float sumsquares = g_aussie_dispatch.fn_sum_diff_squared_fused(v, n, fmean_out);
+	return sumsquares / (float)n;
+}
+
+void aussie_vector_expf_dispatch(float v[], int n)   // Apply EXPF (exponential) to each element
+{
+	AUSSIE_DISPATCH_CHECK();
+	g_aussie_dispatch.fn_expf(v, n);
+}
+
+float aussie_vector_fused_expf_sum_dispatch(float v[], int n)   // Apply EXPF to each element and SUM them
+{
+	AUSSIE_DISPATCH_CHECK();
+	return g_aussie_dispatch.fn_expf_sum(v, n);
+}
+
+int aussie_vector_indices_ge_dispatch(const float v[], int n, float threshold, int indices_out[], int maxout)  // Indices of v[i] >= threshold (-1 if more than maxout)
+{
+	AUSSIE_DISPATCH_CHECK();
+	return g_aussie_dispatch.fn_indices_ge(v, n, threshold, indices_out, maxout);
+}
+
+void aussie_vector_sigmoid_dispatch(float v[], int n)   // 1 / (1 + e^-x)
+{
+	AUSSIE_DISPATCH_CHECK();
+	g_aussie_dispatch.fn_sigmoid(v, n);
+}
+
+void aussie_vector_SiLU_dispatch(float v[], int n)   // x * sigmoid(x)
+{
+	AUSSIE_DISPATCH_CHECK();
+	g_aussie_dispatch.fn_SiLU(v, n);
+}
+
+void aussie_vector_GELU_tanh_dispatch(float v[], int n)   // GELU tanh approximation
+{
+	AUSSIE_DISPATCH_CHECK();
+	g_aussie_dispatch.fn_GELU_tanh(v, n);
+}
+
+void aussie_vector_GELU_sigmoid_dispatch(float v[], int n)   // x * sigmoid(1.702 * x)
+{
+	AUSSIE_DISPATCH_CHECK();
+	g_aussie_dispatch.fn_GELU_sigmoid(v, n);
+}
+
+//---------------------------------------------------
+// Unit tests: every supported level against the scalar versions
+//---------------------------------------------------
+
+static void aussie_dispatch_test_one_size(int n, int offset)
+{
+	const int maxn = 1000 + 16;
+	alignas(64) float vbuf1[maxn];
+	alignas(64) float vbuf2[maxn];
+	alignas(64) float vcopy[maxn];
+	yassert(n + offset <= maxn);
+	float* v1 = vbuf1 + offset;  // Test unaligned vectors too
+	float* v2 = vbuf2 + offset;
+	for (int i = 0; i < n; i++) {
+		v1[i] = (float)((i * 7) % 19) - 9.0f;  // Small integers (exact sums)
+		v2[i] = (float)((i * 3) % 11) - 5.0f;
+	}
+
+	ytestf(aussie_vecdot_dispatch(v1, v2, n), aussie_vecdot_basic(v1, v2, n));
+	ytestf(aussie_vector_sum_dispatch(v1, n), aussie_vector_sum(v1, n));
+	ytestf(aussie_vector_max_dispatch(v1, n), aussie_vector_max(v1, n));
+	ytestf(aussie_vector_min_dispatch(v1, n), aussie_vector_min(v1, n));
+
+	aussie_vector_copy_basic(vcopy, v1, n);
+	aussie_vector_multiply_scalar_dispatch(v1, n, -2.0f);
+	aussie_vector_multiply_scalar(vcopy, n, -2.0f);
+	ytest(aussie_vector_equal(v1, vcopy, n));
+
+	aussie_vector_reluize_dispatch(v1, n);
+	aussie_vector_reluize(vcopy, n);
+	ytest(aussie_vector_equal(v1, vcopy, n));
+
+	float fmean = 0.0f, fmean2 = 0.0f;
+	aussie_vector_copy_basic(vcopy, v2, n);
+	float fvar = aussie_vector_mean_and_variance_dispatch(v2, n, fmean);
+	float fvar2 = aussie_vector_mean_and_variance_fused(vcopy, n, fmean2);
+	ytest(fabsf(fmean - fmean2) <= 1e-5f);
+	ytest(fabsf(fvar - fvar2) <= 1e-4f * (1.0f + fvar2));
+	ytest(aussie_vector_equal_approx(v2, vcopy, n, 1e-5f));
+
+	for (int i = 0; i < n; i++) v1[i] = (float)((i * 5) % 17) * 0.25f - 2.0f;  // expf in [0.13, 7.4]
+	aussie_vector_copy_basic(vcopy, v1, n);
+	aussie_vector_expf_dispatch(v1, n);
+	aussie_vector_expf(vcopy, n);
+	ytest(aussie_vector_equal_approx(v1, vcopy, n, 1e-5f));
+
+	for (int i = 0; i < n; i++) v1[i] = (float)((i * 7) % 19) * -0.5f;
+	aussie_vector_copy_basic(vcopy, v1, n);
+	float fsum = aussie_vector_fused_expf_sum_dispatch(v1, n);
+	float fsum2 = aussie_vector_expf_and_sum(vcopy, n);
+	ytest(fabsf(fsum - fsum2) <= 1e-5f * fsum2);
+	ytest(aussie_vector_equal_approx(v1, vcopy, n, 1e-6f));
+
+	int indices[maxn], indices2[maxn];
+	for (int i = 0; i < n; i++) v1[i] = (float)((i * 7) % 19) - 9.0f;
+	int nfound = aussie_vector_indices_ge_dispatch(v1, n, 5.0f, indices, maxn);
+	ytesti(nfound, aussie_vector_indices_ge(v1, n, 5.0f, indices2, maxn));
+	ytest(nfound >= 0 && memcmp(indices, indices2, nfound * sizeof(int)) == 0);
+	if (nfound > 0) ytesti(aussie_vector_indices_ge_dispatch(v1, n, 5.0f, indices, nfound - 1), -1);  // Too many
+
+	// Activations: the SIMD expf is within an ulp, and GELU tanh uses sigmoid(2u) for 0.5 * (1 + tanh(u))
+	aussie_vector_inplace_fnptr acts[] = { aussie_vector_sigmoid_dispatch, aussie_vector_SiLU_dispatch,
+		aussie_vector_GELU_tanh_dispatch, aussie_vector_GELU_sigmoid_dispatch };
+	aussie_vector_inplace_fnptr actrefs[] = { aussie_vector_sigmoid, aussie_vector_SiLU,
+		aussie_vector_GELU_tanh, aussie_vector_GELU_sigmoid };
+	for (int k = 0; k < 4; k++) {
+		for (int i = 0; i < n; i++) v1[i] = (float)((i * 7) % 37) * 0.5f - 9.0f;  // [-9,9]
+		aussie_vector_copy_basic(vcopy, v1, n);
+		acts[k](v1, n);
+		actrefs[k](vcopy, n);
+		ytest(aussie_vector_equal_approx(v1, vcopy, n, 4e-6f));
+	}
+}
+
+void aussie_dispatch_unit_tests()
+{
+	fprintf(stderr, "INFO: %s: Running unit tests\n", __func__);
+	aussie_cpu_print_features(stderr);
+
+	int sizes[] = { 1, 3, 4, 7, 8, 15, 16, 17, 31, 33, 100, 1000 };
+	int nsizes = (int)(sizeof(sizes) / sizeof(sizes[0]));
+	for (int isa = AUSSIE_ISA_SCALAR; isa <= AUSSIE_ISA_AVX512; isa++) {
+		if (!aussie_dispatch_set_isa(isa)) continue;  // Not on this CPU
+		ytesti(g_aussie_dispatch.isa, isa);
+		for (int i = 0; i < nsizes; i++) {
+			for (int offset = 0; offset < 4; offset++) {
+				aussie_dispatch_test_one_size(sizes[i], offset);
+			}
+		}
+	}
+	aussie_dispatch_init();  // Restore the default level
+}
+
+//---------------------------------------------------
+//---------------------------------------------------
+
@@ -0,0 +1,107 @@
+//---------------------------------------------------
+// adispatch.h -- Runtime CPU feature detection and SIMD kernel dispatch -- Aussie AI Base Library
+// Created Oct 17th 2026
+// Copyright (c) 2023 Aussie AI Labs Pty Ltd
+//---------------------------------------------------
+
+#ifndef AUSSIE_YDISPATCH_INCLUDE_HEADER_H
+#define AUSSIE_YDISPATCH_INCLUDE_HEADER_H
+
+//---------------------------------------------------
+// CPU features (CPUID + XGETBV), detected once at startup
+//---------------------------------------------------
+
+struct aussie_cpu_features {
+	bool detected;   // Has CPUID been run yet?
+	bool sse2, sse3, ssse3, sse41, sse42, popcnt;
+	bool avx, avx2, fma, f16c;
+	bool avx512f, avx512bw, avx512vl, avx512vnni, avx512bf16, avx512vbmi;
+	bool avxvnni;
+	bool os_avx;     // OS saves the YMM registers (XCR0)
+	bool os_avx512;  // OS saves the ZMM/opmask registers (XCR0)
+};
+
+const aussie_cpu_features& aussie_cpu_detect();  // Run CPUID (only once)
+void aussie_cpu_print_features(FILE* fp);
+
+bool aussie_cpu_has_sse41();
+bool aussie_cpu_has_avx();     // AVX (128-bit "AVX1" kernels) and OS support
+bool aussie_cpu_has_avx2();    // AVX-2 and FMA (256-bit kernels)
+bool aussie_cpu_has_avx512();  // AVX-512 F/BW/VL (512-bit kernels)
+bool aussie_cpu_has_avx512_vnni();  // ... plus VNNI (int8 dot products)
+bool aussie_cpu_has_avx512_vbmi();  // ... plus VBMI (byte shuffles: vpermb, vpermi2b)
+
+//---------------------------------------------------
+// Dispatch levels: the fastest supported path is chosen at startup.
+// Override with environment variable AUSSIE_ISA=scalar|avx1|avx2|avx512
+//---------------------------------------------------
+
+#define AUSSIE_ISA_SCALAR  0   // Plain C++ loops
+#define AUSSIE_ISA_AVX1    1   // 128-bit, 4 floats
+#define AUSSIE_ISA_AVX2    2   // 256-bit with FMA, 8 floats
+#define AUSSIE_ISA_AVX512  3   // 512-bit, 16 floats
+
+typedef float (*aussie_vecdot_fnptr)(const float v1[], const float v2[], int n);
+typedef float (*aussie_vector_reduce_fnptr)(float v[], int n);
+typedef void (*aussie_vector_scalar_fnptr)(float v[], int n, float c);
+typedef void (*aussie_vector_inplace_fnptr)(float v[], int n);
+typedef float (*aussie_vector_diffsquares_fnptr)(float v[], int n, float meanval);
+typedef int (*aussie_vector_indices_fnptr)(const float v[], int n, float threshold, int indices_out[], int maxout);
+
+struct aussie_dispatch_table {
+	int isa;    // AUSSIE_ISA_* level bound
+	int lanes;  // Floats per SIMD register
+	aussie_vecdot_fnptr fn_vecdot;
+	aussie_vector_reduce_fnptr fn_sum;
+	aussie_vector_reduce_fnptr fn_max;
+	aussie_vector_reduce_fnptr fn_min;
+	aussie_vector_scalar_fnptr fn_multiply_scalar;
+	aussie_vector_inplace_fnptr fn_reluize;
+	aussie_vector_diffsquares_fnptr fn_sum_diff_squared_fused;
+	aussie_vector_inplace_fnptr fn_expf;
+	aussie_vector_reduce_fnptr fn_expf_sum;  // Fused expf and sum (leaves expf values in vector)
+	aussie_vector_indices_fnptr fn_indices_ge;  // Filter: indices of elements >= threshold
+	aussie_vector_inplace_fnptr fn_sigmoid;  // Activations (aactivation.h)
+	aussie_vector_inplace_fnptr fn_SiLU;
+	aussie_vector_inplace_fnptr fn_GELU_tanh;
+	aussie_vector_inplace_fnptr fn_GELU_sigmoid;
+};
+
+extern aussie_dispatch_table g_aussie_dispatch;
+
+void aussie_dispatch_init();   // Bind the function pointers (once, automatically on first call)
+void aussie_dispatch_ensure();   // aussie_dispatch_init if not bound yet (thread-safe: call before reading g_aussie_dispatch)
+bool aussie_dispatch_set_isa(int isa);  // Force a level (false if this CPU doesn't support it; not while kernels are running)
+int aussie_dispatch_best_isa();  // Fastest level supported by this CPU
+const char* aussie_dispatch_isa_name(int isa);
+
+//---------------------------------------------------
+// Dispatched kernels (any n, any alignment)
+//---------------------------------------------------
+
+float aussie_vecdot_dispatch(const float v1[], const float v2[], int n);
+float aussie_vector_sum_dispatch(float v[], int n);
+float aussie_vector_max_dispatch(float v[], int n);
+float aussie_vector_min_dispatch(float v[], int n);
+void aussie_vector_multiply_scalar_dispatch(float v[], int n, float c);
+void aussie_vector_reluize_dispatch(float v[], int n);
+float aussie_vector_mean_and_variance_dispatch(float v[], int n, float& fmean_out);  // Leaves DIFF from MEAN in vector
+void aussie_vector_expf_dispatch(float v[], int n);   // Apply EXPF (exponential) to each element
+float aussie_vector_fused_expf_sum_dispatch(float v[], int n);   // Apply EXPF to each element and SUM them
+int aussie_vector_indices_ge_dispatch(const float v[], int n, float threshold, int indices_out[], int maxout);  // Indices of v[i] >= threshold (-1 if more than maxout)
+void aussie_vector_sigmoid_dispatch(float v[], int n);   // 1 / (1 + e^-x)
+void aussie_vector_SiLU_dispatch(float v[], int n);   // x * sigmoid(x)
+void aussie_vector_GELU_tanh_dispatch(float v[], int n);   // GELU tanh approximation
+void aussie_vector_GELU_sigmoid_dispatch(float v[], int n);   // x * sigmoid(1.702 * x)
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+void aussie_dispatch_unit_tests();
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+
+#endif //AUSSIE_YDISPATCH_INCLUDE_HEADER_H
+
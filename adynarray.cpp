@@ -19,6 +19,8 @@
 #include "aport.h"
 #include "aussieai.h"
 #include "aassert.h"
+#include "atest.h"
+#include "aarena.h"
 
 #include "adynarray.h"  // self-include
 
@@ -276,8 +278,90 @@ void aussie_dynamic_tensor3D_indexed_deallocate(float*** tensorarr, int slices_u
 
 
 //---------------------------------------------------
+// Arena versions: the same layouts, with the blocks bumped from an arena
 //---------------------------------------------------
 
+float* aussie_dynamic_vector_arena_allocate(aussie_arena& arena, int n)
+{
+	// Allocate 1-D vector from an arena (zeroed)
+	float* arr = (float*)aussie_arena_calloc(arena, n * sizeof(float));
+	yassert(arr);
+	return arr;
+}
+
+float** aussie_dynamic_matrix_arena_allocate(aussie_arena& arena, int rows, int cols)
+{
+	// Allocate Indexed 2-D matrix from an arena: data block (zeroed) and index block
+	// ... no deallocate: the arena frees both (reset, or release to a mark)
+	float* dataarr = (float*)aussie_arena_calloc(arena, (size_t)rows * cols * sizeof(float));
+	float** arr = (float**)aussie_arena_alloc(arena, rows * sizeof(float*), sizeof(float*));
+	if (!dataarr || !arr) {
+		yassert(dataarr && arr);
+		return NULL;
+	}
+	float* rowarr = &dataarr[0];
+	for (int i = 0; i < rows; i++, rowarr += cols) {
+		arr[i] = rowarr;
+	}
+	return arr;
+}
+
+float*** aussie_dynamic_tensor3D_arena_allocate(aussie_arena& arena, int slices, int rows, int cols)
+{
+	// Allocate Indexed 3-D tensor from an arena: data block (zeroed), matrix row index, slice index
+	float* data = (float*)aussie_arena_calloc(arena, (size_t)slices * rows * cols * sizeof(float));
+	float** marr = (float**)aussie_arena_alloc(arena, (size_t)slices * rows * sizeof(float*), sizeof(float*));
+	float*** tensorarr = (float***)aussie_arena_alloc(arena, slices * sizeof(float**), sizeof(float**));
+	if (!data || !marr || !tensorarr) {
+		yassert(data && marr && tensorarr);
+		return NULL;
+	}
+	float** matrixarr = &marr[0];
+	float* rowarr = &data[0];
+	for (int slice = 0; slice < slices; slice++) {
+		tensorarr[slice] = matrixarr;
+		for (int i = 0; i < rows; i++) {
+			*matrixarr++ = rowarr;
+			rowarr += cols;  // Note: pointer aritmetic
+		}
+	}
+	return tensorarr;
+}
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+static void aussie_test_dynarray_arena()
+{
+	// Arena versions: one "inference step" at a time, no heap calls after the first
+	aussie_arena arena;
+	ytest(aussie_arena_init(arena, 1024, "dynarray test"));
+	long long nheap = 0;
+	for (int step = 0; step < 3; step++) {
+		float* farr = aussie_dynamic_vector_arena_allocate(arena, 20);
+		float** marr = aussie_dynamic_matrix_arena_allocate(arena, 10, 20);
+		float*** tensorarr = aussie_dynamic_tensor3D_arena_allocate(arena, 5, 10, 20);
+		ytest(((size_t)farr % AUSSIE_ARENA_ALIGN) == 0 && ((size_t)marr[0] % AUSSIE_ARENA_ALIGN) == 0);
+		ytestf(farr[19] + marr[9][19] + tensorarr[4][9][19], 0.0f);  // Zeroed
+		int ct = 0;
+		for (int slice = 0; slice < 5; slice++) {
+			for (int i = 0; i < 10; i++) {
+				for (int j = 0; j < 20; j++) {
+					tensorarr[slice][i][j] = (float)ct++;
+				}
+			}
+		}
+		ytestf(tensorarr[0][0][0] + 1.0f, tensorarr[0][0][1]);
+		ytest(&tensorarr[1][0][0] == &tensorarr[0][9][19] + 1);  // One data block
+		marr[9][19] = 1.0f;
+		aussie_arena_reset(arena);
+		if (step == 0) nheap = arena.nheap;  // Overflowed, then grew
+		else ytest(arena.nheap == nheap);
+	}
+	ytest(arena.capacity >= arena.high_water);
+	aussie_arena_destroy(arena);
+}
+
 void aussie_test_dynarray()  // Unit tests for dynamic arrays
 {
 	int cols = 20;
@@ -360,7 +444,7 @@ void aussie_test_dynarray()  // Unit tests for dynamic arrays
 	aussie_dynamic_tensor3D_indexed_deallocate(tensorarr, slices, rows, cols); // Free the 2 blocks
 	marr = NULL;
 
-
+	aussie_test_dynarray_arena();
 }
 
 //---------------------------------------------------
@@ -20,6 +20,7 @@ void aussie_dynamic_vector_deallocate(float* farr);
 //---------------------------------------------------
 //---------------------------------------------------
 
+// ... one calloc per row (no alignment, no fixed row stride): see atensor.h for a single aligned block with views
 float** aussie_dynamic_matrix_basic_allocate(int rows, int cols);
 void aussie_dynamic_matrix_basic_deallocate(float** arr, int rows, int cols_unused = 0);
 
@@ -39,6 +40,17 @@ float*** aussie_dynamic_tensor3D_basic_allocate(int slices, int rows, int cols);
 void aussie_dynamic_tensor3D_indexed_deallocate(float*** tensorarr, int slices_unused = 0, int rows_unused = 0, int cols_unused = 0);
 float*** aussie_dynamic_tensor3D_indexed_allocate(int slices, int rows, int cols);
 
+//---------------------------------------------------
+// Arena versions (aarena.h): zeroed like calloc, same indexed layout, 64-byte aligned data,
+// but no heap calls and no deallocate (freed all at once by aussie_arena_reset or release)
+//---------------------------------------------------
+
+struct aussie_arena;  // aarena.h
+
+float* aussie_dynamic_vector_arena_allocate(aussie_arena& arena, int n);
+float** aussie_dynamic_matrix_arena_allocate(aussie_arena& arena, int rows, int cols);
+float*** aussie_dynamic_tensor3D_arena_allocate(aussie_arena& arena, int slices, int rows, int cols);
+
 //---------------------------------------------------
 //---------------------------------------------------
 
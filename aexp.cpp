@@ -0,0 +1,135 @@
+// aexp.cpp -- Portable SIMD exponential (expf) kernels -- Aussie AI Base Library
+// Created Oct 17th 2026
+// Copyright (c) 2023 Aussie AI Labs Pty Ltd
+//---------------------------------------------------
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <math.h>
+#include <stdint.h>
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+#include "aport.h"
+#include "aussieai.h"
+#include "aassert.h"
+#include "atest.h"
+#include "adispatch.h"
+
+#include "aexp.h"  // self-include
+
+//---------------------------------------------------
+// Accuracy measurement
+//---------------------------------------------------
+
+static int aussie_exp_ulp_diff(float f1, float f2)
+{
+	// ULP distance between two non-negative floats (adjacent floats have adjacent bit patterns)
+	int32_t i1 = 0, i2 = 0;
+	memcpy(&i1, &f1, sizeof(i1));
+	memcpy(&i2, &f2, sizeof(i2));
+	int32_t diff = i1 - i2;
+	return diff < 0 ? -diff : diff;
+}
+
+#if AUSSIE_X86
+AUSSIE_TARGET_AVX1 static void aussie_exp_16_AVX1(const float vin[16], float vout[16])
+{
+	for (int i = 0; i < 16; i += 4) _mm_storeu_ps(&vout[i], aussie_exp_ps_AVX1(_mm_loadu_ps(&vin[i])));
+}
+
+AUSSIE_TARGET_AVX2 static void aussie_exp_16_AVX2(const float vin[16], float vout[16])
+{
+	for (int i = 0; i < 16; i += 8) _mm256_storeu_ps(&vout[i], aussie_exp_ps_AVX2(_mm256_loadu_ps(&vin[i])));
+}
+
+AUSSIE_TARGET_AVX512 static void aussie_exp_16_AVX512(const float vin[16], float vout[16])
+{
+	_mm512_storeu_ps(vout, aussie_exp_ps_AVX512(_mm512_loadu_ps(vin)));
+}
+#endif //AUSSIE_X86
+
+static void aussie_exp_simd_16(int isa, const float vin[16], float vout[16])
+{
+	// Run the SIMD expf for the given AUSSIE_ISA_* level on 16 floats
+#if AUSSIE_X86
+	switch (isa) {
+	case AUSSIE_ISA_AVX1: aussie_exp_16_AVX1(vin, vout); return;
+	case AUSSIE_ISA_AVX2: aussie_exp_16_AVX2(vin, vout); return;
+	case AUSSIE_ISA_AVX512: aussie_exp_16_AVX512(vin, vout); return;
+	default: break;
+	}
+#endif //AUSSIE_X86
+	for (int i = 0; i < 16; i++) vout[i] = expf(vin[i]);
+}
+
+int aussie_exp_max_ulp_error(int isa, float xlo, float xhi, int nsteps)  // Measure SIMD expf error (AUSSIE_ISA_*)
+{
+	// Compare against expf computed in double precision (correctly rounded to float)
+	if (nsteps <= 0 || xhi < xlo) {
+		yassert(nsteps > 0);
+		return -1;  // fail
+	}
+	int maxulp = 0;
+	float vin[16], vout[16];
+	double step = ((double)xhi - (double)xlo) / nsteps;
+	for (int i = 0; i < nsteps; i += 16) {
+		for (int j = 0; j < 16; j++) {
+			int istep = i + j <= nsteps ? i + j : nsteps;
+			float x = (float)(xlo + istep * step);
+			vin[j] = x > xhi ? xhi : x;
+		}
+		aussie_exp_simd_16(isa, vin, vout);
+		for (int j = 0; j < 16; j++) {
+			float fexpect = (float)exp((double)vin[j]);
+			int ulp = aussie_exp_ulp_diff(vout[j], fexpect);
+			if (ulp > maxulp) maxulp = ulp;
+		}
+	}
+	return maxulp;
+}
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+static void aussie_exp_test_special_values(int isa)
+{
+	float vin[16] = { 0.0f, -200.0f, 200.0f, NAN, 1.0f, -1.0f };
+	float vout[16];
+	aussie_exp_simd_16(isa, vin, vout);
+	ytestf(vout[0], 1.0f);
+	ytestf(vout[1], 0.0f);  // Underflow
+	ytest(isinf(vout[2]) && vout[2] > 0.0f);  // Overflow
+	ytest(isnan(vout[3]));
+	ytest(aussie_exp_ulp_diff(vout[4], expf(1.0f)) <= AUSSIE_EXP_MAX_ULP);
+	ytest(aussie_exp_ulp_diff(vout[5], expf(-1.0f)) <= AUSSIE_EXP_MAX_ULP);
+}
+
+void aussie_exp_unit_tests()
+{
+	fprintf(stderr, "INFO: %s: Running unit tests\n", __func__);
+	for (int isa = AUSSIE_ISA_AVX1; isa <= AUSSIE_ISA_AVX512; isa++) {
+		if (isa == AUSSIE_ISA_AVX1 && !aussie_cpu_has_avx()) continue;
+		if (isa == AUSSIE_ISA_AVX2 && !aussie_cpu_has_avx2()) continue;
+		if (isa == AUSSIE_ISA_AVX512 && !aussie_cpu_has_avx512()) continue;
+		// Whole range, plus a dense sweep of the softmax range (logits minus max are <= 0)
+		int ulp1 = aussie_exp_max_ulp_error(isa, AUSSIE_EXP_MIN_X, AUSSIE_EXP_MAX_X, 1000 * 1000);
+		int ulp2 = aussie_exp_max_ulp_error(isa, -20.0f, 0.0f, 1000 * 1000);
+		ytest(ulp1 >= 0 && ulp1 <= AUSSIE_EXP_MAX_ULP);
+		ytest(ulp2 >= 0 && ulp2 <= AUSSIE_EXP_MAX_ULP);
+		if (ulp1 > AUSSIE_EXP_MAX_ULP || ulp2 > AUSSIE_EXP_MAX_ULP) {
+			fprintf(stderr, "ERROR: %s: %s expf max error %d/%d ULPs\n", __func__, aussie_dispatch_isa_name(isa), ulp1, ulp2);
+		}
+		aussie_exp_test_special_values(isa);
+	}
+}
+
+//---------------------------------------------------
+//---------------------------------------------------
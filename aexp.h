@@ -0,0 +1,168 @@
+//---------------------------------------------------
+// aexp.h -- Portable SIMD exponential (expf) kernels -- Aussie AI Base Library
+// Created Oct 17th 2026
+// Copyright (c) 2023 Aussie AI Labs Pty Ltd
+//---------------------------------------------------
+
+#ifndef AUSSIE_YEXP_INCLUDE_HEADER_H
+#define AUSSIE_YEXP_INCLUDE_HEADER_H
+
+//---------------------------------------------------
+// Vectorized expf without SVML (_mm_exp_ps/_mm256_exp_ps are MSVC/Intel only).
+// Method (Cephes expf): range reduction x = k*ln2 + r with |r| <= ln2/2,
+// degree-7 polynomial for exp(r), then scale by 2^k in the exponent bits.
+//
+// Accuracy: max error AUSSIE_EXP_MAX_ULP ULP versus correctly rounded expf
+// for x in [AUSSIE_EXP_MIN_X, AUSSIE_EXP_MAX_X], for all three versions (checked
+// exhaustively over every float in the range; aussie_exp_unit_tests samples it).
+// Outside that range: below returns 0.0 (no denormals), above returns +INF.
+// NaN inputs return NaN.
+//---------------------------------------------------
+
+#define AUSSIE_EXP_MAX_ULP 1   // Max error (ULPs) of the SIMD expf kernels
+#define AUSSIE_EXP_MIN_X (-87.3365447505531f)  // ln(FLT_MIN), smallest normal result
+#define AUSSIE_EXP_MAX_X (88.3762626647949f)  // 127.5 * ln(2), largest x with 2^k in range
+
+#define AUSSIE_GELU_TANH_C     0.7978845608f   // sqrt(2/pi) (GELU tanh approximation, scalar and SIMD)
+#define AUSSIE_GELU_TANH_A     0.044715f
+
+#if AUSSIE_X86
+#include <math.h>  // INFINITY
+#include <immintrin.h>
+
+#define AUSSIE_EXP_LOG2E  1.44269504088896341f
+#define AUSSIE_EXP_LN2_HI 0.693359375f    // ln(2) split in two for exact k*ln2 (Cody-Waite)
+#define AUSSIE_EXP_LN2_LO (-2.12194440e-4f)
+#define AUSSIE_EXP_P0 1.9875691500E-4f   // Cephes expf polynomial coefficients
+#define AUSSIE_EXP_P1 1.3981999507E-3f
+#define AUSSIE_EXP_P2 8.3334519073E-3f
+#define AUSSIE_EXP_P3 4.1665795894E-2f
+#define AUSSIE_EXP_P4 1.6666665459E-1f
+#define AUSSIE_EXP_P5 5.0000001201E-1f
+
+AUSSIE_TARGET_AVX1 static inline __m128 aussie_exp_ps_AVX1(__m128 x)  // expf of 4 floats (SSE4.1, no FMA)
+{
+	const __m128 xorig = x;
+	x = _mm_min_ps(_mm_set1_ps(AUSSIE_EXP_MAX_X), x);  // Clamp (operand order keeps NaN)
+	x = _mm_max_ps(_mm_set1_ps(AUSSIE_EXP_MIN_X), x);
+	__m128i k = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(AUSSIE_EXP_LOG2E)));  // k = round(x/ln2)
+	__m128 fk = _mm_cvtepi32_ps(k);
+	x = _mm_sub_ps(x, _mm_mul_ps(fk, _mm_set1_ps(AUSSIE_EXP_LN2_HI)));  // r = x - k*ln2
+	x = _mm_sub_ps(x, _mm_mul_ps(fk, _mm_set1_ps(AUSSIE_EXP_LN2_LO)));
+	__m128 y = _mm_set1_ps(AUSSIE_EXP_P0);  // Horner's rule
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(AUSSIE_EXP_P1));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(AUSSIE_EXP_P2));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(AUSSIE_EXP_P3));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(AUSSIE_EXP_P4));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(AUSSIE_EXP_P5));
+	y = _mm_add_ps(_mm_mul_ps(y, _mm_mul_ps(x, x)), _mm_add_ps(x, _mm_set1_ps(1.0f)));
+	__m128i e = _mm_slli_epi32(_mm_add_epi32(k, _mm_set1_epi32(127)), 23);  // 2^k as float bits
+	y = _mm_mul_ps(y, _mm_castsi128_ps(e));
+	y = _mm_blendv_ps(y, _mm_setzero_ps(), _mm_cmplt_ps(xorig, _mm_set1_ps(AUSSIE_EXP_MIN_X)));  // Underflow
+	y = _mm_blendv_ps(y, _mm_set1_ps(INFINITY), _mm_cmpgt_ps(xorig, _mm_set1_ps(AUSSIE_EXP_MAX_X)));  // Overflow
+	return y;
+}
+
+AUSSIE_TARGET_AVX2 static inline __m256 aussie_exp_ps_AVX2(__m256 x)  // expf of 8 floats (AVX-2 with FMA)
+{
+	const __m256 xorig = x;
+	x = _mm256_min_ps(_mm256_set1_ps(AUSSIE_EXP_MAX_X), x);  // Clamp (operand order keeps NaN)
+	x = _mm256_max_ps(_mm256_set1_ps(AUSSIE_EXP_MIN_X), x);
+	__m256i k = _mm256_cvtps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(AUSSIE_EXP_LOG2E)));  // k = round(x/ln2)
+	__m256 fk = _mm256_cvtepi32_ps(k);
+	x = _mm256_fnmadd_ps(fk, _mm256_set1_ps(AUSSIE_EXP_LN2_HI), x);  // r = x - k*ln2
+	x = _mm256_fnmadd_ps(fk, _mm256_set1_ps(AUSSIE_EXP_LN2_LO), x);
+	__m256 y = _mm256_set1_ps(AUSSIE_EXP_P0);  // Horner's rule
+	y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(AUSSIE_EXP_P1));
+	y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(AUSSIE_EXP_P2));
+	y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(AUSSIE_EXP_P3));
+	y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(AUSSIE_EXP_P4));
+	y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(AUSSIE_EXP_P5));
+	y = _mm256_fmadd_ps(y, _mm256_mul_ps(x, x), _mm256_add_ps(x, _mm256_set1_ps(1.0f)));
+	__m256i e = _mm256_slli_epi32(_mm256_add_epi32(k, _mm256_set1_epi32(127)), 23);  // 2^k as float bits
+	y = _mm256_mul_ps(y, _mm256_castsi256_ps(e));
+	y = _mm256_blendv_ps(y, _mm256_setzero_ps(), _mm256_cmp_ps(xorig, _mm256_set1_ps(AUSSIE_EXP_MIN_X), _CMP_LT_OQ));  // Underflow
+	y = _mm256_blendv_ps(y, _mm256_set1_ps(INFINITY), _mm256_cmp_ps(xorig, _mm256_set1_ps(AUSSIE_EXP_MAX_X), _CMP_GT_OQ));  // Overflow
+	return y;
+}
+
+AUSSIE_TARGET_AVX512 static inline __m512 aussie_exp_ps_AVX512(__m512 x)  // expf of 16 floats (AVX-512)
+{
+	const __m512 xorig = x;
+	x = _mm512_min_ps(_mm512_set1_ps(AUSSIE_EXP_MAX_X), x);  // Clamp (operand order keeps NaN)
+	x = _mm512_max_ps(_mm512_set1_ps(AUSSIE_EXP_MIN_X), x);
+	__m512i k = _mm512_cvtps_epi32(_mm512_mul_ps(x, _mm512_set1_ps(AUSSIE_EXP_LOG2E)));  // k = round(x/ln2)
+	__m512 fk = _mm512_cvtepi32_ps(k);
+	x = _mm512_fnmadd_ps(fk, _mm512_set1_ps(AUSSIE_EXP_LN2_HI), x);  // r = x - k*ln2
+	x = _mm512_fnmadd_ps(fk, _mm512_set1_ps(AUSSIE_EXP_LN2_LO), x);
+	__m512 y = _mm512_set1_ps(AUSSIE_EXP_P0);  // Horner's rule
+	y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(AUSSIE_EXP_P1));
+	y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(AUSSIE_EXP_P2));
+	y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(AUSSIE_EXP_P3));
+	y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(AUSSIE_EXP_P4));
+	y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(AUSSIE_EXP_P5));
+	y = _mm512_fmadd_ps(y, _mm512_mul_ps(x, x), _mm512_add_ps(x, _mm512_set1_ps(1.0f)));
+	__m512i e = _mm512_slli_epi32(_mm512_add_epi32(k, _mm512_set1_epi32(127)), 23);  // 2^k as float bits
+	y = _mm512_mul_ps(y, _mm512_castsi512_ps(e));
+	y = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(xorig, _mm512_set1_ps(AUSSIE_EXP_MIN_X), _CMP_LT_OQ), y, _mm512_setzero_ps());  // Underflow
+	y = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(xorig, _mm512_set1_ps(AUSSIE_EXP_MAX_X), _CMP_GT_OQ), y, _mm512_set1_ps(INFINITY));  // Overflow
+	return y;
+}
+
+//---------------------------------------------------
+// num / (1 + e^-cx): sigmoid (num = 1, cx = x), SiLU (num = cx = x), GELU approximations (num = x, aactivation.h)
+// ... e^-(c*x) overflows to +INF for very negative x, giving 0 (-0 for SiLU); NaN stays NaN
+//---------------------------------------------------
+
+AUSSIE_TARGET_AVX2 static inline __m256 aussie_div_1_plus_exp_neg_ps_AVX2(__m256 num, __m256 cx)  // num / (1 + e^-cx)
+{
+	__m256 e = aussie_exp_ps_AVX2(_mm256_xor_ps(cx, _mm256_set1_ps(-0.0f)));  // Flip the sign bit
+	return _mm256_div_ps(num, _mm256_add_ps(_mm256_set1_ps(1.0f), e));
+}
+
+AUSSIE_TARGET_AVX512 static inline __m512 aussie_div_1_plus_exp_neg_ps_AVX512(__m512 num, __m512 cx)  // num / (1 + e^-cx)
+{
+	__m512 e = aussie_exp_ps_AVX512(_mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(cx), _mm512_set1_epi32((int)0x80000000))));
+	return _mm512_div_ps(num, _mm512_add_ps(_mm512_set1_ps(1.0f), e));
+}
+
+AUSSIE_TARGET_AVX2 static inline __m256 aussie_sigmoid_ps_AVX2(__m256 x)  // 1 / (1 + e^-x) of 8 floats
+{
+	return aussie_div_1_plus_exp_neg_ps_AVX2(_mm256_set1_ps(1.0f), x);
+}
+
+AUSSIE_TARGET_AVX512 static inline __m512 aussie_sigmoid_ps_AVX512(__m512 x)  // 1 / (1 + e^-x) of 16 floats
+{
+	return aussie_div_1_plus_exp_neg_ps_AVX512(_mm512_set1_ps(1.0f), x);
+}
+
+// GELU tanh approximation: 0.5 * x * (1 + tanh(u)) = x / (1 + e^-2u), u = sqrt(2/pi) * (x + 0.044715 * x^3)
+AUSSIE_TARGET_AVX2 static inline __m256 aussie_GELU_tanh_ps_AVX2(__m256 x)
+{
+	__m256 x2 = _mm256_mul_ps(x, x);
+	__m256 inner = _mm256_fmadd_ps(x2, _mm256_set1_ps(AUSSIE_GELU_TANH_A), _mm256_set1_ps(1.0f));  // 1 + 0.044715 * x^2
+	__m256 twou = _mm256_mul_ps(_mm256_mul_ps(x, _mm256_set1_ps(2.0f * AUSSIE_GELU_TANH_C)), inner);
+	return aussie_div_1_plus_exp_neg_ps_AVX2(x, twou);
+}
+
+AUSSIE_TARGET_AVX512 static inline __m512 aussie_GELU_tanh_ps_AVX512(__m512 x)
+{
+	__m512 x2 = _mm512_mul_ps(x, x);
+	__m512 inner = _mm512_fmadd_ps(x2, _mm512_set1_ps(AUSSIE_GELU_TANH_A), _mm512_set1_ps(1.0f));
+	__m512 twou = _mm512_mul_ps(_mm512_mul_ps(x, _mm512_set1_ps(2.0f * AUSSIE_GELU_TANH_C)), inner);
+	return aussie_div_1_plus_exp_neg_ps_AVX512(x, twou);
+}
+
+#endif //AUSSIE_X86
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+int aussie_exp_max_ulp_error(int isa, float xlo, float xhi, int nsteps);  // Measure SIMD expf error (AUSSIE_ISA_*)
+void aussie_exp_unit_tests();
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+
+#endif //AUSSIE_YEXP_INCLUDE_HEADER_H
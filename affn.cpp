@@ -0,0 +1,454 @@
+// affn.cpp -- Fused gated feed-forward (SwiGLU, GeGLU) -- Aussie AI Base Library
+// Created Oct 17th 2026
+// Copyright (c) 2023 Aussie AI Labs Pty Ltd
+//---------------------------------------------------
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <math.h>
+
+#include "aport.h"
+
+#if AUSSIE_X86
+#include <immintrin.h>  // AVX-2/AVX-512 kernels
+#endif //AUSSIE_X86
+#if !LINUX
+#include <malloc.h>  // _aligned_malloc
+#endif
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+#include "aussieai.h"
+#include "aassert.h"
+#include "atest.h"
+#include "adispatch.h"
+#include "aactivation.h"
+#include "aexp.h"
+#include "avector.h"
+#include "agemm.h"
+#include "athread.h"
+#include "aarena.h"
+
+#include "affn.h"  // self-include
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+void aussie_ffn_weights_init(aussie_ffn_weights& w, int act, const float* W1, const float* W3, const float* W2, int ndim, int nhidden)  // Dense strides
+{
+	w.W1 = W1;
+	w.W3 = W3;
+	w.W2 = W2;
+	w.ndim = ndim;
+	w.nhidden = nhidden;
+	w.ld13 = ndim;
+	w.ld2 = nhidden;
+	w.act = act;
+}
+
+static bool aussie_ffn_weights_ok(const aussie_ffn_weights& w)
+{
+	if (w.W1 == NULL || w.W3 == NULL || w.ndim <= 0 || w.nhidden <= 0 || w.ld13 < w.ndim
+		|| (w.act != AUSSIE_GLU_SWIGLU && w.act != AUSSIE_GLU_GEGLU)) {
+		yassert(w.W1 != NULL && w.W3 != NULL);
+		yassert(w.ndim > 0 && w.nhidden > 0 && w.ld13 >= w.ndim);
+		yassert(w.act == AUSSIE_GLU_SWIGLU || w.act == AUSSIE_GLU_GEGLU);
+		return false;
+	}
+	return true;
+}
+
+static inline float aussie_ffn_act(int act, float g)  // Scalar gate activation
+{
+	if (act == AUSSIE_GLU_GEGLU) {
+		return 0.5f * g * (1.0f + tanhf(AUSSIE_GELU_TANH_C * g * (1.0f + AUSSIE_GELU_TANH_A * g * g)));
+	}
+	return g / (1.0f + expf(-g));  // SiLU
+}
+
+//---------------------------------------------------
+// Row kernels: hout[j] for j in [r0,r1)
+//---------------------------------------------------
+
+typedef void (*aussie_ffn_rows_fnptr)(const aussie_ffn_weights& w, const float x[], float hout[], int r0, int r1);
+
+static void aussie_ffn_rows_basic(const aussie_ffn_weights& w, const float x[], float hout[], int r0, int r1)
+{
+	for (int j = r0; j < r1; j++) {
+		const float* a = &w.W1[(long long)j * w.ld13];
+		const float* b = &w.W3[(long long)j * w.ld13];
+		float g = 0.0f, u = 0.0f;
+		for (int i = 0; i < w.ndim; i++) {  // Both dot products in one sweep over x
+			g += a[i] * x[i];
+			u += b[i] * x[i];
+		}
+		hout[j] = aussie_ffn_act(w.act, g) * u;
+	}
+}
+
+#if AUSSIE_X86
+
+static inline AUSSIE_TARGET_AVX2 float aussie_ffn_hsum_AVX2(__m256 acc)
+{
+	__m128 s = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+	s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+	s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+	return _mm_cvtss_f32(s);
+}
+
+AUSSIE_TARGET_AVX2 static void aussie_ffn_dots4_AVX2(const aussie_ffn_weights& w, const float x[], int j, int nrows, float gate[4], float up[4])
+{
+	// Rows j..j+3 of W1 and W3 against x: 8 accumulators, one load of x per 8 FMAs
+	// ... fewer than 4 rows: the missing ones repeat row j (results ignored)
+	long long ld = w.ld13;
+	const float* a0 = &w.W1[(long long)j * ld];
+	const float* b0 = &w.W3[(long long)j * ld];
+	const float* a1 = nrows > 1 ? a0 + ld : a0;
+	const float* a2 = nrows > 2 ? a0 + 2 * ld : a0;
+	const float* a3 = nrows > 3 ? a0 + 3 * ld : a0;
+	const float* b1 = nrows > 1 ? b0 + ld : b0;
+	const float* b2 = nrows > 2 ? b0 + 2 * ld : b0;
+	const float* b3 = nrows > 3 ? b0 + 3 * ld : b0;
+	__m256 g0 = _mm256_setzero_ps(), g1 = _mm256_setzero_ps(), g2 = _mm256_setzero_ps(), g3 = _mm256_setzero_ps();
+	__m256 u0 = _mm256_setzero_ps(), u1 = _mm256_setzero_ps(), u2 = _mm256_setzero_ps(), u3 = _mm256_setzero_ps();
+	int n = w.ndim;
+	int i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 xv = _mm256_loadu_ps(&x[i]);
+		g0 = _mm256_fmadd_ps(_mm256_loadu_ps(&a0[i]), xv, g0);
+		u0 = _mm256_fmadd_ps(_mm256_loadu_ps(&b0[i]), xv, u0);
+		g1 = _mm256_fmadd_ps(_mm256_loadu_ps(&a1[i]), xv, g1);
+		u1 = _mm256_fmadd_ps(_mm256_loadu_ps(&b1[i]), xv, u1);
+		g2 = _mm256_fmadd_ps(_mm256_loadu_ps(&a2[i]), xv, g2);
+		u2 = _mm256_fmadd_ps(_mm256_loadu_ps(&b2[i]), xv, u2);
+		g3 = _mm256_fmadd_ps(_mm256_loadu_ps(&a3[i]), xv, g3);
+		u3 = _mm256_fmadd_ps(_mm256_loadu_ps(&b3[i]), xv, u3);
+	}
+	gate[0] = aussie_ffn_hsum_AVX2(g0); up[0] = aussie_ffn_hsum_AVX2(u0);
+	gate[1] = aussie_ffn_hsum_AVX2(g1); up[1] = aussie_ffn_hsum_AVX2(u1);
+	gate[2] = aussie_ffn_hsum_AVX2(g2); up[2] = aussie_ffn_hsum_AVX2(u2);
+	gate[3] = aussie_ffn_hsum_AVX2(g3); up[3] = aussie_ffn_hsum_AVX2(u3);
+	for (; i < n; i++) {  // Leftovers
+		gate[0] += a0[i] * x[i]; up[0] += b0[i] * x[i];
+		gate[1] += a1[i] * x[i]; up[1] += b1[i] * x[i];
+		gate[2] += a2[i] * x[i]; up[2] += b2[i] * x[i];
+		gate[3] += a3[i] * x[i]; up[3] += b3[i] * x[i];
+	}
+}
+
+AUSSIE_TARGET_AVX2 static void aussie_ffn_rows_AVX2(const aussie_ffn_weights& w, const float x[], float hout[], int r0, int r1)
+{
+	alignas(32) float gate[8], up[8];
+	for (int jb = r0; jb < r1; jb += 8) {  // 8 hidden units per register
+		int nb = r1 - jb < 8 ? r1 - jb : 8;
+		if (nb < 8) {  // Unused lanes: zero, not stack garbage, through expf
+			memset(gate, 0, sizeof(gate));
+			memset(up, 0, sizeof(up));
+		}
+		for (int k = 0; k < nb; k += 4) {
+			aussie_ffn_dots4_AVX2(w, x, jb + k, nb - k < 4 ? nb - k : 4, &gate[k], &up[k]);
+		}
+		__m256 g = _mm256_load_ps(gate);
+		__m256 h = (w.act == AUSSIE_GLU_GEGLU) ? aussie_GELU_tanh_ps_AVX2(g) : aussie_div_1_plus_exp_neg_ps_AVX2(g, g);
+		h = _mm256_mul_ps(h, _mm256_load_ps(up));
+		if (nb == 8) _mm256_storeu_ps(&hout[jb], h);
+		else {
+			alignas(32) float hbuf[8];
+			_mm256_store_ps(hbuf, h);
+			for (int k = 0; k < nb; k++) hout[jb + k] = hbuf[k];
+		}
+	}
+}
+
+#define AUSSIE_FFN_TAIL_MASK(nleft) \
+	( (nleft) >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << (nleft)) - 1u) )  // Lanes still in range
+
+AUSSIE_TARGET_AVX512 static void aussie_ffn_dots4_AVX512(const aussie_ffn_weights& w, const float x[], int j, int nrows, float gate[4], float up[4])
+{
+	// As the AVX2 version, 16 floats at a time, with a masked last block
+	long long ld = w.ld13;
+	const float* a0 = &w.W1[(long long)j * ld];
+	const float* b0 = &w.W3[(long long)j * ld];
+	const float* a1 = nrows > 1 ? a0 + ld : a0;
+	const float* a2 = nrows > 2 ? a0 + 2 * ld : a0;
+	const float* a3 = nrows > 3 ? a0 + 3 * ld : a0;
+	const float* b1 = nrows > 1 ? b0 + ld : b0;
+	const float* b2 = nrows > 2 ? b0 + 2 * ld : b0;
+	const float* b3 = nrows > 3 ? b0 + 3 * ld : b0;
+	__m512 g0 = _mm512_setzero_ps(), g1 = _mm512_setzero_ps(), g2 = _mm512_setzero_ps(), g3 = _mm512_setzero_ps();
+	__m512 u0 = _mm512_setzero_ps(), u1 = _mm512_setzero_ps(), u2 = _mm512_setzero_ps(), u3 = _mm512_setzero_ps();
+	int n = w.ndim;
+	int i = 0;
+	for (; i + 16 <= n; i += 16) {
+		__m512 xv = _mm512_loadu_ps(&x[i]);
+		g0 = _mm512_fmadd_ps(_mm512_loadu_ps(&a0[i]), xv, g0);
+		u0 = _mm512_fmadd_ps(_mm512_loadu_ps(&b0[i]), xv, u0);
+		g1 = _mm512_fmadd_ps(_mm512_loadu_ps(&a1[i]), xv, g1);
+		u1 = _mm512_fmadd_ps(_mm512_loadu_ps(&b1[i]), xv, u1);
+		g2 = _mm512_fmadd_ps(_mm512_loadu_ps(&a2[i]), xv, g2);
+		u2 = _mm512_fmadd_ps(_mm512_loadu_ps(&b2[i]), xv, u2);
+		g3 = _mm512_fmadd_ps(_mm512_loadu_ps(&a3[i]), xv, g3);
+		u3 = _mm512_fmadd_ps(_mm512_loadu_ps(&b3[i]), xv, u3);
+	}
+	if (i < n) {
+		__mmask16 m = AUSSIE_FFN_TAIL_MASK(n - i);
+		__m512 xv = _mm512_maskz_loadu_ps(m, &x[i]);
+		g0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, &a0[i]), xv, g0);
+		u0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, &b0[i]), xv, u0);
+		g1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, &a1[i]), xv, g1);
+		u1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, &b1[i]), xv, u1);
+		g2 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, &a2[i]), xv, g2);
+		u2 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, &b2[i]), xv, u2);
+		g3 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, &a3[i]), xv, g3);
+		u3 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, &b3[i]), xv, u3);
+	}
+	gate[0] = _mm512_reduce_add_ps(g0); up[0] = _mm512_reduce_add_ps(u0);
+	gate[1] = _mm512_reduce_add_ps(g1); up[1] = _mm512_reduce_add_ps(u1);
+	gate[2] = _mm512_reduce_add_ps(g2); up[2] = _mm512_reduce_add_ps(u2);
+	gate[3] = _mm512_reduce_add_ps(g3); up[3] = _mm512_reduce_add_ps(u3);
+}
+
+AUSSIE_TARGET_AVX512 static void aussie_ffn_rows_AVX512(const aussie_ffn_weights& w, const float x[], float hout[], int r0, int r1)
+{
+	alignas(64) float gate[16], up[16];
+	for (int jb = r0; jb < r1; jb += 16) {  // 16 hidden units per register
+		int nb = r1 - jb < 16 ? r1 - jb : 16;
+		for (int k = 0; k < nb; k += 4) {
+			aussie_ffn_dots4_AVX512(w, x, jb + k, nb - k < 4 ? nb - k : 4, &gate[k], &up[k]);
+		}
+		__mmask16 mask = AUSSIE_FFN_TAIL_MASK(nb);
+		__m512 g = _mm512_maskz_load_ps(mask, gate);
+		__m512 h = (w.act == AUSSIE_GLU_GEGLU) ? aussie_GELU_tanh_ps_AVX512(g) : aussie_div_1_plus_exp_neg_ps_AVX512(g, g);
+		h = _mm512_mul_ps(h, _mm512_maskz_load_ps(mask, up));
+		_mm512_mask_storeu_ps(&hout[jb], mask, h);
+	}
+}
+
+#endif //AUSSIE_X86
+
+static aussie_ffn_rows_fnptr aussie_ffn_rows_for_isa(int isa, int& block)
+{
+	// Row kernel and its register width (thread blocks are whole registers of hidden units)
+#if AUSSIE_X86
+	if (isa >= AUSSIE_ISA_AVX512 && aussie_cpu_has_avx512()) {
+		block = 16;
+		return aussie_ffn_rows_AVX512;
+	}
+	if (isa >= AUSSIE_ISA_AVX2 && aussie_cpu_has_avx2()) {
+		block = 8;
+		return aussie_ffn_rows_AVX2;
+	}
+#endif //AUSSIE_X86
+	block = 1;
+	return aussie_ffn_rows_basic;
+}
+
+//---------------------------------------------------
+// Thread pool: static blocks of hidden rows
+//---------------------------------------------------
+
+struct aussie_ffn_job {
+	const aussie_ffn_weights* w;
+	const float* x;
+	float* hout;
+	int ntasks;
+	int block;   // Hidden units per register
+	aussie_ffn_rows_fnptr rows;
+};
+
+static void aussie_ffn_task(int itask, void* arg)
+{
+	const aussie_ffn_job* job = (const aussie_ffn_job*)arg;
+	int nblocks = (job->w->nhidden + job->block - 1) / job->block;
+	int b0 = (int)(((long long)nblocks * itask) / job->ntasks);
+	int b1 = (int)(((long long)nblocks * (itask + 1)) / job->ntasks);
+	int r0 = b0 * job->block;
+	int r1 = b1 * job->block < job->w->nhidden ? b1 * job->block : job->w->nhidden;
+	if (r0 < r1) job->rows(*job->w, job->x, job->hout, r0, r1);
+}
+
+void aussie_ffn_gated_hidden(const aussie_ffn_weights& w, const float x[], float hout[])  // hout = act(W1 x) (.) (W3 x), thread pool
+{
+	if (!aussie_ffn_weights_ok(w) || x == NULL || hout == NULL) {
+		yassert(x != NULL && hout != NULL);
+		return;  // fail
+	}
+	aussie_dispatch_ensure();
+	aussie_ffn_job job;
+	job.w = &w;
+	job.x = x;
+	job.hout = hout;
+	job.rows = aussie_ffn_rows_for_isa(g_aussie_dispatch.isa, job.block);
+	int nblocks = (w.nhidden + job.block - 1) / job.block;
+	int nthreads = aussie_thread_count();
+	job.ntasks = nblocks < nthreads ? nblocks : nthreads;
+	aussie_parallel_run(job.ntasks, aussie_ffn_task, &job, AUSSIE_SCHEDULE_STATIC);
+}
+
+void aussie_ffn_gated_hidden_isa(int isa, const aussie_ffn_weights& w, const float x[], float hout[])  // Force a kernel, one thread
+{
+	if (!aussie_ffn_weights_ok(w) || x == NULL || hout == NULL) {
+		yassert(x != NULL && hout != NULL);
+		return;  // fail
+	}
+	int block = 1;
+	aussie_ffn_rows_fnptr rows = aussie_ffn_rows_for_isa(isa, block);
+	rows(w, x, hout, 0, w.nhidden);
+}
+
+void aussie_ffn_gated_hidden_unfused(const aussie_ffn_weights& w, const float x[], float hout[], float scratch[])  // The separate passes
+{
+	if (!aussie_ffn_weights_ok(w) || x == NULL || hout == NULL || scratch == NULL) {
+		yassert(x != NULL && hout != NULL && scratch != NULL);
+		return;  // fail
+	}
+	aussie_gemv_parallel(w.W1, w.nhidden, w.ndim, w.ld13, x, hout, 0);  // Gate
+	aussie_gemv_parallel(w.W3, w.nhidden, w.ndim, w.ld13, x, scratch, 0);  // Up
+	if (w.act == AUSSIE_GLU_GEGLU) aussie_vector_GELU_tanh_dispatch(hout, w.nhidden);
+	else aussie_vector_SiLU_dispatch(hout, w.nhidden);
+	aussie_vector_multiply_vector(hout, scratch, w.nhidden);
+}
+
+void aussie_ffn_gated(const aussie_ffn_weights& w, const float x[], float out[])  // Whole FFN: fused hidden, then the W2 GEMV
+{
+	if (!aussie_ffn_weights_ok(w) || w.W2 == NULL || w.ld2 < w.nhidden || x == NULL || out == NULL) {
+		yassert(w.W2 != NULL && w.ld2 >= w.nhidden);
+		yassert(x != NULL && out != NULL);
+		return;  // fail
+	}
+	// Hidden vector from this thread's arena (no heap calls after the first call), the heap only without one
+	aussie_arena* arena = aussie_thread_arena();
+	aussie_arena_mark mark;
+	float* h = NULL;
+	if (arena) {
+		mark = aussie_arena_get_mark(*arena);
+		h = aussie_arena_alloc_floats(*arena, w.nhidden);
+	}
+	else {
+		h = (float*)malloc(w.nhidden * sizeof(float));
+	}
+	if (h == NULL) {
+		yassert(h != NULL);
+		if (arena) aussie_arena_release(*arena, mark);
+		return;  // fail
+	}
+	aussie_ffn_gated_hidden(w, x, h);
+	aussie_gemv_parallel(w.W2, w.ndim, w.nhidden, w.ld2, h, out, 0);
+	if (arena) aussie_arena_release(*arena, mark);
+	else free(h);
+}
+
+//---------------------------------------------------
+// Unit tests
+//---------------------------------------------------
+
+static void aussie_ffn_test_one(int act, int ndim, int nhidden, int pad)
+{
+	int ld13 = ndim + pad;
+	float* W1 = (float*)malloc((size_t)nhidden * ld13 * sizeof(float));
+	float* W3 = (float*)malloc((size_t)nhidden * ld13 * sizeof(float));
+	float* W2 = (float*)malloc((size_t)ndim * nhidden * sizeof(float));
+	float* x = (float*)malloc(ndim * sizeof(float));
+	float* href = (float*)malloc(nhidden * sizeof(float));
+	float* h = (float*)malloc(nhidden * sizeof(float));
+	float* h2 = (float*)malloc(nhidden * sizeof(float));
+	float* out = (float*)malloc(ndim * sizeof(float));
+	for (int j = 0; j < nhidden; j++) {
+		for (int i = 0; i < ld13; i++) {
+			W1[(size_t)j * ld13 + i] = i < ndim ? AUSSIE_TEST_VALUE(j, i, 1) / 4.0f : NAN;  // Padding is never read
+			W3[(size_t)j * ld13 + i] = i < ndim ? AUSSIE_TEST_VALUE(j, i, 2) / 4.0f : NAN;
+		}
+	}
+	for (int i = 0; i < ndim; i++) {
+		for (int j = 0; j < nhidden; j++) W2[(size_t)i * nhidden + j] = AUSSIE_TEST_VALUE(i, j, 3) / 4.0f;
+		x[i] = AUSSIE_TEST_VALUE(i, 0, 4);
+	}
+	aussie_ffn_weights w;
+	aussie_ffn_weights_init(w, act, W1, W3, W2, ndim, nhidden);
+	w.ld13 = ld13;
+
+	// Reference: dot products in double
+	for (int j = 0; j < nhidden; j++) {
+		double g = 0.0, u = 0.0;
+		for (int i = 0; i < ndim; i++) {
+			g += (double)W1[(size_t)j * ld13 + i] * x[i];
+			u += (double)W3[(size_t)j * ld13 + i] * x[i];
+		}
+		href[j] = aussie_ffn_act(act, (float)g) * (float)u;
+	}
+	float tol = 1e-5f * (float)ndim;
+	for (int isa = AUSSIE_ISA_SCALAR; isa <= AUSSIE_ISA_AVX512; isa++) {
+		aussie_ffn_gated_hidden_isa(isa, w, x, h);
+		float maxdiff = 0.0f;
+		for (int j = 0; j < nhidden; j++) {
+			float d = fabsf(h[j] - href[j]);
+			if (!(d <= maxdiff)) maxdiff = d;  // NaN counts
+		}
+		if (!(maxdiff <= tol)) {
+			fprintf(stderr, "ERROR: FFN act %d isa %d ndim %d nhidden %d: max diff %g\n", act, isa, ndim, nhidden, maxdiff);
+		}
+		ytest(maxdiff <= tol);
+	}
+
+	// Thread pool: the same rows in the same registers, so the same bits as one thread
+	aussie_ffn_gated_hidden(w, x, h);
+	aussie_ffn_gated_hidden_isa(g_aussie_dispatch.isa, w, x, h2);
+	ytest(memcmp(h, h2, nhidden * sizeof(float)) == 0);
+
+	// Unfused pipeline: same result to rounding
+	float* scratch = (float*)malloc(nhidden * sizeof(float));
+	aussie_ffn_gated_hidden_unfused(w, x, h2, scratch);
+	float maxdiff = 0.0f;
+	for (int j = 0; j < nhidden; j++) {
+		float d = fabsf(h[j] - h2[j]);
+		if (!(d <= maxdiff)) maxdiff = d;
+	}
+	ytest(maxdiff <= tol);
+
+	// Whole FFN against W2 * href
+	aussie_ffn_gated(w, x, out);
+	maxdiff = 0.0f;
+	for (int i = 0; i < ndim; i++) {
+		double ref = 0.0;
+		for (int j = 0; j < nhidden; j++) ref += (double)W2[(size_t)i * nhidden + j] * href[j];
+		float d = fabsf(out[i] - (float)ref);
+		if (!(d <= maxdiff)) maxdiff = d;
+	}
+	ytest(maxdiff <= tol * (float)nhidden);
+
+	free(W1); free(W3); free(W2); free(x);
+	free(href); free(h); free(h2); free(out); free(scratch);
+}
+
+void aussie_ffn_unit_tests()
+{
+	fprintf(stderr, "INFO: %s: Running unit tests\n", __func__);
+
+	// Odd sizes: partial registers of hidden units, masked and scalar column tails, 1-3 row groups
+	static const int sizes[][2] = { { 1, 1 }, { 16, 16 }, { 37, 23 }, { 100, 50 }, { 64, 35 }, { 7, 129 } };
+	int nsizes = (int)(sizeof(sizes) / sizeof(sizes[0]));
+	aussie_thread_pool_shutdown();
+	aussie_thread_pool_init(4);  // Several tasks, even on one core
+	for (int act = AUSSIE_GLU_SWIGLU; act <= AUSSIE_GLU_GEGLU; act++) {
+		for (int k = 0; k < nsizes; k++) {
+			aussie_ffn_test_one(act, sizes[k][0], sizes[k][1], 0);
+		}
+		aussie_ffn_test_one(act, 37, 23, 5);  // Padded rows (ld13 > ndim)
+	}
+	aussie_thread_pool_shutdown();  // Back to the default size on next use
+
+	// Scalar activations at known points
+	ytest(fabsf(aussie_ffn_act(AUSSIE_GLU_SWIGLU, 1.0f) - 0.7310586f) < 1e-6f);  // sigmoid(1)
+	ytest(fabsf(aussie_ffn_act(AUSSIE_GLU_GEGLU, 1.0f) - 0.8411920f) < 1e-6f);
+	ytestf(aussie_ffn_act(AUSSIE_GLU_SWIGLU, 0.0f), 0.0f);
+}
+
+//---------------------------------------------------
+//---------------------------------------------------
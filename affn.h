@@ -0,0 +1,51 @@
+//---------------------------------------------------
+// affn.h -- Fused gated feed-forward (SwiGLU, GeGLU) -- Aussie AI Base Library
+// Created Oct 17th 2026
+// Copyright (c) 2023 Aussie AI Labs Pty Ltd
+//---------------------------------------------------
+
+#ifndef AUSSIE_YFFN_INCLUDE_HEADER_H
+#define AUSSIE_YFFN_INCLUDE_HEADER_H
+
+//---------------------------------------------------
+// Gated FFN: out = W2 * ( act(W1 * x) (.) (W3 * x) )
+// ... W1 (gate) and W3 (up) are nhidden x ndim, W2 (down) is ndim x nhidden, all row-major
+// ... the fused hidden kernel reads row j of W1 and W3 in the same sweep over x (4 rows of each
+//     at a time, one load of x for 8 FMAs), then applies the activation and the gate to 16
+//     (AVX-512) or 8 (AVX2) hidden units in registers and stores only the gated hidden vector:
+//     no separate activation or multiply passes, one thread-pool job instead of four
+// ... hidden rows are split across the thread pool in static blocks (as aussie_gemv_parallel)
+//---------------------------------------------------
+
+#define AUSSIE_GLU_SWIGLU  0   // SiLU gate (LLaMA, Mistral)
+#define AUSSIE_GLU_GEGLU   1   // GELU gate, tanh approximation (Gemma)
+
+struct aussie_ffn_weights {
+	const float* W1;   // Gate: nhidden x ndim (stride ld13)
+	const float* W3;   // Up: nhidden x ndim (stride ld13)
+	const float* W2;   // Down: ndim x nhidden (stride ld2)
+	int ndim;
+	int nhidden;
+	int ld13;
+	int ld2;
+	int act;           // AUSSIE_GLU_*
+};
+
+void aussie_ffn_weights_init(aussie_ffn_weights& w, int act, const float* W1, const float* W3, const float* W2, int ndim, int nhidden);  // Dense strides
+
+void aussie_ffn_gated_hidden(const aussie_ffn_weights& w, const float x[], float hout[]);  // hout = act(W1 x) (.) (W3 x), thread pool
+void aussie_ffn_gated_hidden_isa(int isa, const aussie_ffn_weights& w, const float x[], float hout[]);  // Force a kernel, one thread (AUSSIE_ISA_*; AVX1 uses scalar)
+void aussie_ffn_gated_hidden_unfused(const aussie_ffn_weights& w, const float x[], float hout[], float scratch[]);  // Two GEMVs, activation pass, multiply pass (scratch: nhidden floats)
+
+void aussie_ffn_gated(const aussie_ffn_weights& w, const float x[], float out[]);  // Whole FFN: fused hidden, then the W2 GEMV (hidden vector from the thread arena)
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+void aussie_ffn_unit_tests();
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+
+#endif //AUSSIE_YFFN_INCLUDE_HEADER_H
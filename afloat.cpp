@@ -18,9 +18,13 @@
 //---------------------------------------------------
 
 #include "aport.h"
+#if AUSSIE_X86
+#include <immintrin.h>  // F16C, AVX-2 and AVX-512 array conversions
+#endif //AUSSIE_X86
 #include "aussieai.h"
 #include "aassert.h"
 #include "atest.h"
+#include "adispatch.h"
 
 #include "afloat.h"  // self-include
 
@@ -88,48 +92,62 @@ yfp16_t aussie_float32_to_float16(float f)
 {
 	// FP32 = 1 sign, 8 exponent (offset 127), 23 mantissa bits = 32-bits
 	// FP16 = 1 sign, 5 exponent (offset 15), 10 mantissa bits = 16-bits
-	int signbit;
-	int exponentbits;
-	int mantissabits;
-	aussie_float32_get_bits(f, signbit, exponentbits, mantissabits);
-	yassert(exponentbits >= -128);
-	yassert(exponentbits <= 127);
-
-	if (f != 0.0) {  // 0.0 is special case all 8 bits set = 127
-		yassert(exponentbits <= 31);
-		yassert(exponentbits >= -32);
-	}
-
-#if 0 // old bad try
-	int newexponent = ((exponentbits + 127));
-	yassert(newexponent >= 0);
-	yassert(newexponent <= 255);
-	newexponent = (newexponent & ((1 << 5) - 1)) - 15;
-	yassert(newexponent >= -32);
-	yassert(newexponent <= 31);  // 5-bits
-	
-	if (f == 0) {
-		f = f;  // debug breakpoint
+	// Round to nearest even; overflow gives Inf, tiny values give FP16 denormals or zero, NaN stays NaN
+	unsigned int u = *(unsigned int*)&f;
+	unsigned int sign = (u >> 16) & 0x8000u;
+	u &= 0x7fffffffu;
+	if (u >= 0x7f800000u) {  // Inf or NaN
+		if (u == 0x7f800000u) return (yfp16_t)(sign | 0x7c00u);
+		return (yfp16_t)(sign | 0x7e00u | ((u >> 13) & 0x3ffu));  // Quiet NaN (keeps the top payload bits)
 	}
-	unsigned int uexp = (unsigned)exponentbits;
-	int fixexponentbits = ((unsigned)uexp & 31); /* ((1 << 5) - 1));*/ // Truncate from 8 to 5 bits
-#endif
-
-	int fixexponentbits = exponentbits;
-	return aussie_float16_from_bits(signbit, fixexponentbits, mantissabits);
+	if (u >= 0x477ff000u) return (yfp16_t)(sign | 0x7c00u);  // 65520 and up rounds to Inf (max FP16 is 65504)
+	if (u < 0x38800000u) {  // Below 2^-14: FP16 denormal (units of 2^-24) or zero
+		if (u <= 0x33000000u) return (yfp16_t)sign;  // 2^-25 and below rounds to zero (exact half ties to even zero)
+		int exponent = (int)(u >> 23);
+		unsigned int mantissa = (u & 0x7fffffu) | 0x800000u;  // Implicit leading 1
+		int shift = 126 - exponent;  // 14..24
+		unsigned int h = mantissa >> shift;
+		unsigned int rem = mantissa & ((1u << shift) - 1);
+		unsigned int half = 1u << (shift - 1);
+		if (rem > half || (rem == half && (h & 1))) h++;
+		return (yfp16_t)(sign | h);
+	}
+	unsigned int h = (u >> 13) - (112u << 10);  // Exponent offset 127 -> 15, top 10 mantissa bits
+	unsigned int rem = u & 0x1fffu;  // Dropped 13 bits
+	if (rem > 0x1000u || (rem == 0x1000u && (h & 1))) h++;  // A carry into the exponent is still correct
+	return (yfp16_t)(sign | h);
 }
 
 float aussie_float16_to_float32(yfp16_t f)
 {
 	// FP32 = 1 sign, 8 exponent (offset 127), 23 mantissa bits = 32-bits
 	// FP16 = 1 sign, 5 exponent (offset 15), 10 mantissa bits = 16-bits
-	int signbit;
-	int exponentbits;
-	int mantissabits;
-	aussie_float16_get_bits(f, signbit, exponentbits, mantissabits);
-	yassert(exponentbits >= -16);
-	yassert(exponentbits <= 15);
-	return aussie_float32_from_bits(signbit, exponentbits, mantissabits);
+	// Always exact (every FP16 value is an FP32 value)
+	unsigned int sign = ((unsigned int)f & 0x8000u) << 16;
+	unsigned int exponent = ((unsigned int)f >> 10) & 0x1fu;
+	unsigned int mantissa = (unsigned int)f & 0x3ffu;
+	unsigned int u = 0;
+	if (exponent == 0x1fu) {  // Inf or NaN
+		u = sign | 0x7f800000u | (mantissa << 13);
+		if (mantissa != 0) u |= 0x400000u;  // NaN comes out quiet (as F16C does)
+	}
+	else if (exponent == 0) {
+		if (mantissa == 0) {
+			u = sign;  // Zero (either sign)
+		}
+		else {  // Denormal: normalize it (FP32 has the range)
+			exponent = 113;
+			while ((mantissa & 0x400u) == 0) {
+				mantissa <<= 1;
+				exponent--;
+			}
+			u = sign | (exponent << 23) | ((mantissa & 0x3ffu) << 13);
+		}
+	}
+	else {
+		u = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+	}
+	return *(float*)&u;
 }
 
 void aussie_float16_get_bits(yfp16_t fp16, int& signbit, int& exponentbits, int& mantissabits)
@@ -181,25 +199,303 @@ ybf16_t aussie_float32_to_bfloat16(float f)
 {
 	// FP32 = 1 sign, 8 exponent, 23 mantissa bits = 32-bits
 	// BF16 = 1 sign, 8 exponent, 7 mantissa bits = 16-bits
-	int signbit;
-	int exponentbits;
-	int mantissabits;
-	aussie_float32_get_bits(f, signbit, exponentbits, mantissabits);
-	return aussie_bfloat16_from_bits(signbit, exponentbits, mantissabits);
-
+	// Same exponent, so just the top 16 bits, rounded to nearest even (Inf, denormals and overflow come out right)
+	unsigned int u = *(unsigned int*)&f;
+	if ((u & 0x7fffffffu) > 0x7f800000u) return (ybf16_t)((u >> 16) | 0x40u);  // NaN: keep it a (quiet) NaN
+	u += 0x7fffu + ((u >> 16) & 1);
+	return (ybf16_t)(u >> 16);
 }
 
 float aussie_bfloat16_to_float32(ybf16_t fb)
 {
 	// FP32 = 1 sign, 8 exponent, 23 mantissa bits = 32-bits
 	// BF16 = 1 sign, 8 exponent, 7 mantissa bits = 16-bits
-	int signbit;
-	int exponentbits;
-	int mantissabits;
-	aussie_bfloat16_get_bits(fb, signbit, exponentbits, mantissabits);
-	return aussie_float32_from_bits(signbit, exponentbits, mantissabits);
+	unsigned int u = (unsigned int)fb << 16;  // Exact
+	return *(float*)&u;
+}
+
+// -------- FP8 -----------------
+
+void aussie_fp8_e4m3_get_bits(yfp8_t f, int& signbit, int& exponentbits, int& mantissabits)
+{
+	// E4M3 is 1 sign bit, 4 exponent bits (offset 7), 3 stored mantissa bits
+	signbit = f >> 7;
+	exponentbits = ((f >> 3) & ((1 << 4) - 1)) - 7;
+	mantissabits = f & ((1 << 3) - 1);
+}
+
+yfp8_t aussie_fp8_e4m3_from_bits(int isign, int iexponent, int imantissa)
+{
+	unsigned int u = 0;
+	if (isign) u |= (1u << 7);
+	iexponent += 7;  // Offset for the 4-bit exponent
+	yassert(iexponent >= 0 && iexponent < 16);
+	u |= ((unsigned)iexponent << 3);
+	u |= (imantissa & ((1 << 3) - 1));  // Truncate mantissa to 3 bits
+	return (yfp8_t)u;
+}
+
+void aussie_fp8_e5m2_get_bits(yfp8_t f, int& signbit, int& exponentbits, int& mantissabits)
+{
+	// E5M2 is 1 sign bit, 5 exponent bits (offset 15), 2 stored mantissa bits
+	signbit = f >> 7;
+	exponentbits = ((f >> 2) & ((1 << 5) - 1)) - 15;
+	mantissabits = f & ((1 << 2) - 1);
+}
+
+yfp8_t aussie_fp8_e5m2_from_bits(int isign, int iexponent, int imantissa)
+{
+	unsigned int u = 0;
+	if (isign) u |= (1u << 7);
+	iexponent += 15;  // Offset for the 5-bit exponent (as FP16)
+	yassert(iexponent >= 0 && iexponent < 32);
+	u |= ((unsigned)iexponent << 2);
+	u |= (imantissa & ((1 << 2) - 1));  // Truncate mantissa to 2 bits
+	return (yfp8_t)u;
+}
+
+static yfp8_t aussie_float32_to_fp8_generic(float f, int mbits, int bias, unsigned int maxcode, unsigned int nancode)
+{
+	// Round to nearest even, saturating at maxcode (the largest finite magnitude)
+	unsigned int u = *(unsigned int*)&f;
+	unsigned int sign = (u >> 24) & 0x80u;
+	u &= 0x7fffffffu;
+	if (u > 0x7f800000u) return (yfp8_t)(sign | nancode);  // NaN
+	if (u == 0x7f800000u) return (yfp8_t)(sign | maxcode);  // Inf saturates
+	int exponent = (int)(u >> 23) - 127;
+	int emin = 1 - bias;  // Smallest normal exponent
+	unsigned int h = 0;
+	if (exponent < emin) {  // FP8 denormal (units of 2^(emin-mbits)) or zero
+		double q = nearbyint(ldexp((double)*(float*)&u, mbits - emin));  // Exact scaling, ties to even
+		h = (unsigned int)q;  // Rounding up to 2^mbits gives the smallest normal, correctly
+	}
+	else {
+		int shift = 23 - mbits;
+		unsigned int mantissa = u & 0x7fffffu;
+		if (exponent + bias > 31) return (yfp8_t)(sign | maxcode);  // Far too big
+		h = ((unsigned int)(exponent + bias) << mbits) | (mantissa >> shift);
+		unsigned int rem = mantissa & ((1u << shift) - 1);
+		unsigned int half = 1u << (shift - 1);
+		if (rem > half || (rem == half && (h & 1))) h++;  // A carry into the exponent is still correct
+	}
+	if (h > maxcode) h = maxcode;  // Saturate (never rounds into Inf/NaN codes)
+	return (yfp8_t)(sign | h);
+}
+
+yfp8_t aussie_float32_to_fp8_e4m3(float f)
+{
+	return aussie_float32_to_fp8_generic(f, 3, 7, 0x7eu, 0x7fu);  // Max 0x7e = 448
+}
+
+yfp8_t aussie_float32_to_fp8_e5m2(float f)
+{
+	return aussie_float32_to_fp8_generic(f, 2, 15, 0x7bu, 0x7eu);  // Max 0x7b = 57344 (0x7c is Inf)
+}
+
+float aussie_fp8_e4m3_to_float32(yfp8_t f)
+{
+	int sign = f >> 7;
+	int exponent = (f >> 3) & 0xf;
+	int mantissa = f & 0x7;
+	float result = 0.0f;
+	if (exponent == 0xf && mantissa == 0x7) result = NAN;
+	else if (exponent == 0) result = ldexpf((float)mantissa, -9);  // Denormal: mantissa * 2^(1-7-3)
+	else result = ldexpf((float)(8 + mantissa), exponent - 10);  // 1.mmm * 2^(e-7)
+	return sign ? -result : result;
+}
+
+float aussie_fp8_e5m2_to_float32(yfp8_t f)
+{
+	return aussie_float16_to_float32((yfp16_t)((unsigned int)f << 8));  // E5M2 is the top byte of FP16 (exact)
+}
+
+yfp8_t aussie_float32_to_fp8(int format, float f)
+{
+	return format == AUSSIE_FP8_E5M2 ? aussie_float32_to_fp8_e5m2(f) : aussie_float32_to_fp8_e4m3(f);
+}
+
+float aussie_fp8_to_float32(int format, yfp8_t f)
+{
+	return format == AUSSIE_FP8_E5M2 ? aussie_fp8_e5m2_to_float32(f) : aussie_fp8_e4m3_to_float32(f);
+}
+
+void aussie_float32_to_fp8_array(int format, const float src[], yfp8_t dst[], int n)
+{
+	if (format == AUSSIE_FP8_E5M2) {
+		for (int i = 0; i < n; i++) dst[i] = aussie_float32_to_fp8_e5m2(src[i]);
+	}
+	else {
+		for (int i = 0; i < n; i++) dst[i] = aussie_float32_to_fp8_e4m3(src[i]);
+	}
+}
+
+//-----------------------------------------------------
+// Array conversions
+//-----------------------------------------------------
+
+void aussie_float32_to_float16_array_basic(const float src[], yfp16_t dst[], int n)
+{
+	for (int i = 0; i < n; i++) dst[i] = aussie_float32_to_float16(src[i]);
+}
+
+void aussie_float16_to_float32_array_basic(const yfp16_t src[], float dst[], int n)
+{
+	for (int i = 0; i < n; i++) dst[i] = aussie_float16_to_float32(src[i]);
+}
+
+void aussie_float32_to_bfloat16_array_basic(const float src[], ybf16_t dst[], int n)
+{
+	for (int i = 0; i < n; i++) dst[i] = aussie_float32_to_bfloat16(src[i]);
+}
+
+void aussie_bfloat16_to_float32_array_basic(const ybf16_t src[], float dst[], int n)
+{
+	for (int i = 0; i < n; i++) dst[i] = aussie_bfloat16_to_float32(src[i]);
+}
+
+#if AUSSIE_X86
+
+AUSSIE_TARGET_AVX2_F16C void aussie_float32_to_float16_array_F16C(const float src[], yfp16_t dst[], int n)
+{
+	int i = 0;
+	for (; i + 16 <= n; i += 16) {  // Two independent conversions per loop
+		__m128i h0 = _mm256_cvtps_ph(_mm256_loadu_ps(&src[i]), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		__m128i h1 = _mm256_cvtps_ph(_mm256_loadu_ps(&src[i + 8]), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		_mm_storeu_si128((__m128i*)&dst[i], h0);
+		_mm_storeu_si128((__m128i*)&dst[i + 8], h1);
+	}
+	for (; i + 8 <= n; i += 8) {
+		_mm_storeu_si128((__m128i*)&dst[i], _mm256_cvtps_ph(_mm256_loadu_ps(&src[i]), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+	}
+	for (; i < n; i++) dst[i] = aussie_float32_to_float16(src[i]);  // Leftovers
+}
+
+AUSSIE_TARGET_AVX2_F16C void aussie_float16_to_float32_array_F16C(const yfp16_t src[], float dst[], int n)
+{
+	int i = 0;
+	for (; i + 16 <= n; i += 16) {
+		_mm256_storeu_ps(&dst[i], _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)&src[i])));
+		_mm256_storeu_ps(&dst[i + 8], _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)&src[i + 8])));
+	}
+	for (; i + 8 <= n; i += 8) {
+		_mm256_storeu_ps(&dst[i], _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)&src[i])));
+	}
+	for (; i < n; i++) dst[i] = aussie_float16_to_float32(src[i]);  // Leftovers
+}
+
+AUSSIE_TARGET_AVX512 void aussie_float32_to_float16_array_AVX512(const float src[], yfp16_t dst[], int n)
+{
+	int i = 0;
+	for (; i + 16 <= n; i += 16) {
+		_mm256_storeu_si256((__m256i*)&dst[i], _mm512_cvtps_ph(_mm512_loadu_ps(&src[i]), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+	}
+	if (i < n) {  // Masked leftovers
+		__mmask16 mask = (__mmask16)((1u << (n - i)) - 1);
+		__m256i h = _mm512_cvtps_ph(_mm512_maskz_loadu_ps(mask, &src[i]), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		_mm256_mask_storeu_epi16(&dst[i], mask, h);
+	}
+}
+
+AUSSIE_TARGET_AVX512 void aussie_float16_to_float32_array_AVX512(const yfp16_t src[], float dst[], int n)
+{
+	int i = 0;
+	for (; i + 16 <= n; i += 16) {
+		_mm512_storeu_ps(&dst[i], _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)&src[i])));
+	}
+	if (i < n) {  // Masked leftovers
+		__mmask16 mask = (__mmask16)((1u << (n - i)) - 1);
+		_mm512_mask_storeu_ps(&dst[i], mask, _mm512_cvtph_ps(_mm256_maskz_loadu_epi16(mask, &src[i])));
+	}
+}
+
+static inline AUSSIE_TARGET_AVX2 __m256i aussie_float32_to_bfloat16_8_AVX2(__m256i u)
+{
+	// 8 floats (as bits) to BF16 in the low half of each 32-bit lane, same rounding as the scalar version
+	const __m256i one = _mm256_set1_epi32(1);
+	const __m256i bias = _mm256_set1_epi32(0x7fff);
+	const __m256i absmask = _mm256_set1_epi32(0x7fffffff);
+	const __m256i inf = _mm256_set1_epi32(0x7f800000);
+	const __m256i quiet = _mm256_set1_epi32(0x00400000);
+	__m256i lsb = _mm256_and_si256(_mm256_srli_epi32(u, 16), one);
+	__m256i rounded = _mm256_add_epi32(u, _mm256_add_epi32(bias, lsb));  // Round to nearest even
+	__m256i isnan = _mm256_cmpgt_epi32(_mm256_and_si256(u, absmask), inf);
+	__m256i result = _mm256_blendv_epi8(rounded, _mm256_or_si256(u, quiet), isnan);  // NaN: no rounding, set the quiet bit
+	return _mm256_srli_epi32(result, 16);
 }
 
+AUSSIE_TARGET_AVX2 void aussie_float32_to_bfloat16_array_AVX2(const float src[], ybf16_t dst[], int n)
+{
+	int i = 0;
+	for (; i + 16 <= n; i += 16) {
+		__m256i lo = aussie_float32_to_bfloat16_8_AVX2(_mm256_loadu_si256((const __m256i*)&src[i]));
+		__m256i hi = aussie_float32_to_bfloat16_8_AVX2(_mm256_loadu_si256((const __m256i*)&src[i + 8]));
+		__m256i packed = _mm256_packus_epi32(lo, hi);  // Per 128-bit lane: lo0-3 hi0-3 lo4-7 hi4-7
+		packed = _mm256_permute4x64_epi64(packed, 0xD8);  // ... back in order
+		_mm256_storeu_si256((__m256i*)&dst[i], packed);
+	}
+	for (; i < n; i++) dst[i] = aussie_float32_to_bfloat16(src[i]);  // Leftovers
+}
+
+AUSSIE_TARGET_AVX2 void aussie_bfloat16_to_float32_array_AVX2(const ybf16_t src[], float dst[], int n)
+{
+	int i = 0;
+	for (; i + 16 <= n; i += 16) {
+		__m256i w0 = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)&src[i]));
+		__m256i w1 = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)&src[i + 8]));
+		_mm256_storeu_si256((__m256i*)&dst[i], _mm256_slli_epi32(w0, 16));  // BF16 is the top half of FP32
+		_mm256_storeu_si256((__m256i*)&dst[i + 8], _mm256_slli_epi32(w1, 16));
+	}
+	for (; i < n; i++) dst[i] = aussie_bfloat16_to_float32(src[i]);  // Leftovers
+}
+
+#else
+
+void aussie_float32_to_float16_array_F16C(const float src[], yfp16_t dst[], int n) { aussie_float32_to_float16_array_basic(src, dst, n); }
+void aussie_float16_to_float32_array_F16C(const yfp16_t src[], float dst[], int n) { aussie_float16_to_float32_array_basic(src, dst, n); }
+void aussie_float32_to_float16_array_AVX512(const float src[], yfp16_t dst[], int n) { aussie_float32_to_float16_array_basic(src, dst, n); }
+void aussie_float16_to_float32_array_AVX512(const yfp16_t src[], float dst[], int n) { aussie_float16_to_float32_array_basic(src, dst, n); }
+void aussie_float32_to_bfloat16_array_AVX2(const float src[], ybf16_t dst[], int n) { aussie_float32_to_bfloat16_array_basic(src, dst, n); }
+void aussie_bfloat16_to_float32_array_AVX2(const ybf16_t src[], float dst[], int n) { aussie_bfloat16_to_float32_array_basic(src, dst, n); }
+
+#endif //AUSSIE_X86
+
+static bool aussie_float_has_f16c()
+{
+	return aussie_cpu_has_avx2() && aussie_cpu_detect().f16c;
+}
+
+void aussie_float32_to_float16_array(const float src[], yfp16_t dst[], int n)
+{
+	aussie_dispatch_ensure();
+	if (g_aussie_dispatch.isa >= AUSSIE_ISA_AVX512) aussie_float32_to_float16_array_AVX512(src, dst, n);
+	else if (g_aussie_dispatch.isa >= AUSSIE_ISA_AVX2 && aussie_float_has_f16c()) aussie_float32_to_float16_array_F16C(src, dst, n);
+	else aussie_float32_to_float16_array_basic(src, dst, n);
+}
+
+void aussie_float16_to_float32_array(const yfp16_t src[], float dst[], int n)
+{
+	aussie_dispatch_ensure();
+	if (g_aussie_dispatch.isa >= AUSSIE_ISA_AVX512) aussie_float16_to_float32_array_AVX512(src, dst, n);
+	else if (g_aussie_dispatch.isa >= AUSSIE_ISA_AVX2 && aussie_float_has_f16c()) aussie_float16_to_float32_array_F16C(src, dst, n);
+	else aussie_float16_to_float32_array_basic(src, dst, n);
+}
+
+void aussie_float32_to_bfloat16_array(const float src[], ybf16_t dst[], int n)
+{
+	// Not the AVX512-BF16 instruction (vcvtneps2bf16), which flushes denormals to zero
+	aussie_dispatch_ensure();
+	if (g_aussie_dispatch.isa >= AUSSIE_ISA_AVX2) aussie_float32_to_bfloat16_array_AVX2(src, dst, n);
+	else aussie_float32_to_bfloat16_array_basic(src, dst, n);
+}
+
+void aussie_bfloat16_to_float32_array(const ybf16_t src[], float dst[], int n)
+{
+	aussie_dispatch_ensure();
+	if (g_aussie_dispatch.isa >= AUSSIE_ISA_AVX2) aussie_bfloat16_to_float32_array_AVX2(src, dst, n);
+	else aussie_bfloat16_to_float32_array_basic(src, dst, n);
+}
+
+
 
 
 //-----------------------------------------------------
@@ -312,7 +608,6 @@ void aussie_test_BFLOAT16_conversions_one_float(float f)  // Test FP16/FP32 conv
 
 void aussie_test_FP16_conversions_one_float(float f)  // Test FP16/FP32 conversions
 {
-	// NOTE: This is currently buggy... needs to adjust bits sometimes...
 	int signbit2 = 0;
 	int exponent2 = 0;
 	int mantissa2 = 0;
@@ -672,11 +967,9 @@ void aussie_float_tests_range()
 		aussie_test_one_float_basic(f);
 
 
-#if 0 // not yet bug-free converting between FP16/FP32 or Bfloat16
 		aussie_test_FP16_conversions_one_float(f);
 		aussie_test_BFLOAT16_conversions_one_float(f);
 
-#endif
 	}
 }
 
@@ -727,6 +1020,218 @@ void aussie_float_tests_tricks()
 
 }
 
+void aussie_float_tests_fp16_edges()
+{
+	// Every FP16 value converts to FP32 and back unchanged (NaNs stay NaN)
+	int nbad = 0;
+	for (unsigned int u = 0; u < 65536u; u++) {
+		float f = aussie_float16_to_float32((yfp16_t)u);
+		yfp16_t h = aussie_float32_to_float16(f);
+		bool isnan16 = ((u & 0x7c00u) == 0x7c00u) && (u & 0x3ffu) != 0;
+		if (isnan16 ? !(f != f) || (h & 0x7c00u) != 0x7c00u || (h & 0x3ffu) == 0 : h != (yfp16_t)u) nbad++;
+	}
+	ytesti(nbad, 0);
+
+	ytestf(aussie_float16_to_float32(aussie_float32_to_float16(65504.0f)), 65504.0f);  // Largest FP16
+	ytest(aussie_float32_to_float16(65519.0f) == 0x7bffu);   // Rounds down to 65504
+	ytest(aussie_float32_to_float16(65520.0f) == 0x7c00u);   // Rounds up to Inf
+	ytest(aussie_float32_to_float16(-1e10f) == 0xfc00u);     // -Inf
+	ytest(aussie_float32_to_float16(1.0f + 1.0f / 2048.0f) == 0x3c00u);  // Tie: to even (1.0)
+	ytest(aussie_float32_to_float16(1.0f + 3.0f / 2048.0f) == 0x3c02u);  // Tie: to even (up)
+	ytest(aussie_float32_to_float16(ldexpf(1.0f, -24)) == 0x0001u);      // Smallest denormal
+	ytest(aussie_float32_to_float16(ldexpf(1.0f, -25)) == 0x0000u);      // Half of it: ties to zero
+	ytest(aussie_float32_to_float16(ldexpf(1.5f, -25)) == 0x0001u);
+	ytest(aussie_float32_to_float16(-0.0f) == 0x8000u);
+	float fnan = NAN;
+	ytest(aussie_float16_to_float32(aussie_float32_to_float16(fnan)) != aussie_float16_to_float32(aussie_float32_to_float16(fnan)));
+	ytestf(aussie_float16_to_float32(aussie_float32_to_float16(0.01f)), 1311.0f / 131072.0f);  // Nearest FP16
+}
+
+static unsigned int aussie_float_test_random(unsigned int& seed)
+{
+	seed = seed * 1664525u + 1013904223u;  // LCG (any 32-bit pattern, so NaNs and denormals too)
+	return seed;
+}
+
+static int aussie_float_test_compare_fp16(const float src[], const yfp16_t expect[], int n,
+	void (*fn)(const float src[], yfp16_t dst[], int n))
+{
+	yfp16_t* out = (yfp16_t*)malloc((n + 1) * sizeof(yfp16_t));
+	out[n] = 0x5555;  // Guard: no writes past the end
+	fn(src, out, n);
+	int nbad = (out[n] != 0x5555) ? 1 : 0;
+	for (int i = 0; i < n; i++) if (out[i] != expect[i]) nbad++;
+	free(out);
+	return nbad;
+}
+
+void aussie_float_tests_arrays()
+{
+	// Every SIMD array conversion gives the same bits as the scalar one
+	// ... all 65536 16-bit patterns, random 32-bit patterns, and every tail length
+	const int n16 = 65536;
+	const int nrand = 100000;
+	bool f16c = aussie_cpu_has_avx2() && aussie_cpu_detect().f16c;
+	bool avx2 = aussie_cpu_has_avx2();
+	bool avx512 = aussie_cpu_has_avx512();
+
+	yfp16_t* h = (yfp16_t*)malloc(n16 * sizeof(yfp16_t));
+	float* f = (float*)malloc((n16 + 1) * sizeof(float));
+	float* fexpect = (float*)malloc(n16 * sizeof(float));
+	for (int i = 0; i < n16; i++) h[i] = (yfp16_t)i;
+
+	// 16-bit to FP32 (compared as bits, so NaNs must match too)
+	aussie_float16_to_float32_array_basic(h, fexpect, n16);
+	for (int k = 0; k < 3; k++) {
+		if ((k == 1 && !f16c) || (k == 2 && !avx512)) continue;
+		f[n16] = 1.5f;
+		if (k == 0) aussie_float16_to_float32_array(h, f, n16);
+		else if (k == 1) aussie_float16_to_float32_array_F16C(h, f, n16);
+		else aussie_float16_to_float32_array_AVX512(h, f, n16);
+		ytesti(memcmp(f, fexpect, n16 * sizeof(float)), 0);
+		ytestf(f[n16], 1.5f);
+	}
+	aussie_bfloat16_to_float32_array_basic(h, fexpect, n16);
+	for (int k = 0; k < 2; k++) {
+		if (k == 1 && !avx2) continue;
+		if (k == 0) aussie_bfloat16_to_float32_array(h, f, n16);
+		else aussie_bfloat16_to_float32_array_AVX2(h, f, n16);
+		ytesti(memcmp(f, fexpect, n16 * sizeof(float)), 0);
+	}
+
+	// FP32 to 16-bit: random bit patterns plus the awkward values
+	float* src = (float*)malloc(nrand * sizeof(float));
+	yfp16_t* expect = (yfp16_t*)malloc(nrand * sizeof(yfp16_t));
+	unsigned int seed = 12345;
+	for (int i = 0; i < nrand; i++) {
+		unsigned int u = aussie_float_test_random(seed);
+		if (i % 4 == 1) u = (u & 0x8fffffffu) | 0x38000000u;  // Mostly in FP16 range
+		memcpy(&src[i], &u, sizeof(float));
+	}
+	const float specials[] = { 0.0f, -0.0f, 1.0f, -1.0f, 65504.0f, 65519.0f, 65520.0f, 1e10f, -1e10f,
+		ldexpf(1.0f, -24), ldexpf(1.0f, -25), ldexpf(1.5f, -25), ldexpf(1.0f, -130),
+		1.0f + 1.0f / 2048.0f, 1.0f + 3.0f / 2048.0f, 1.0f + 1.0f / 256.0f, 1.0f + 3.0f / 256.0f,
+		INFINITY, -INFINITY, NAN, 3.4e38f };
+	const int nspecials = (int)(sizeof(specials) / sizeof(specials[0]));
+	memcpy(src, specials, sizeof(specials));
+
+	int nbad = 0;
+	aussie_float32_to_float16_array_basic(src, expect, nrand);
+	for (int n = 0; n <= 40; n++) {  // Tails
+		nbad += aussie_float_test_compare_fp16(src + nspecials - n % 8, expect + nspecials - n % 8, n, aussie_float32_to_float16_array);
+		if (f16c) nbad += aussie_float_test_compare_fp16(src + 3, expect + 3, n, aussie_float32_to_float16_array_F16C);
+		if (avx512) nbad += aussie_float_test_compare_fp16(src + 5, expect + 5, n, aussie_float32_to_float16_array_AVX512);
+	}
+	nbad += aussie_float_test_compare_fp16(src, expect, nrand, aussie_float32_to_float16_array);
+	if (f16c) nbad += aussie_float_test_compare_fp16(src, expect, nrand, aussie_float32_to_float16_array_F16C);
+	if (avx512) nbad += aussie_float_test_compare_fp16(src, expect, nrand, aussie_float32_to_float16_array_AVX512);
+	ytesti(nbad, 0);
+
+	nbad = 0;
+	aussie_float32_to_bfloat16_array_basic(src, expect, nrand);  // ybf16_t is the same type as yfp16_t
+	for (int n = 0; n <= 40; n++) {
+		nbad += aussie_float_test_compare_fp16(src + 1, expect + 1, n, aussie_float32_to_bfloat16_array);
+		if (avx2) nbad += aussie_float_test_compare_fp16(src + 7, expect + 7, n, aussie_float32_to_bfloat16_array_AVX2);
+	}
+	nbad += aussie_float_test_compare_fp16(src, expect, nrand, aussie_float32_to_bfloat16_array);
+	if (avx2) nbad += aussie_float_test_compare_fp16(src, expect, nrand, aussie_float32_to_bfloat16_array_AVX2);
+	ytesti(nbad, 0);
+
+	// BF16: NaN stays NaN, ties to even, denormals kept
+	ytest(aussie_float32_to_bfloat16(1.0f + 1.0f / 256.0f) == 0x3f80u);
+	ytest(aussie_float32_to_bfloat16(1.0f + 3.0f / 256.0f) == 0x3f82u);
+	ytest(aussie_float32_to_bfloat16(ldexpf(1.0f, -130)) != 0);
+	float fnan = NAN;
+	ytest(aussie_bfloat16_to_float32(aussie_float32_to_bfloat16(fnan)) != aussie_bfloat16_to_float32(aussie_float32_to_bfloat16(fnan)));
+
+	free(expect);
+	free(src);
+	free(fexpect);
+	free(f);
+	free(h);
+}
+
+static yfp8_t aussie_float_test_fp8_nearest(int format, float f)
+{
+	// Brute force: the nearest of the 256 values, ties to the even code, clamped to +/-max
+	float fmax = format == AUSSIE_FP8_E5M2 ? AUSSIE_FP8_E5M2_MAX : AUSSIE_FP8_E4M3_MAX;
+	if (f > fmax) f = fmax;
+	if (f < -fmax) f = -fmax;
+	int best = -1;
+	double besterr = 0.0;
+	for (int i = 0; i < 256; i++) {
+		float g = aussie_fp8_to_float32(format, (yfp8_t)i);
+		if (g != g || fabsf(g) > fmax) continue;  // NaN, Inf
+		if ((i & 0x80) && g == 0.0f && !(f < 0.0f || (f == 0.0f && signbit(f)))) continue;  // Signed zeros
+		if (!(i & 0x80) && g == 0.0f && (f < 0.0f || signbit(f))) continue;
+		double err = fabs((double)g - (double)f);
+		if (best < 0 || err < besterr || (err == besterr && (i & 1) == 0)) {
+			best = i;
+			besterr = err;
+		}
+	}
+	return (yfp8_t)best;
+}
+
+void aussie_float_tests_fp8()
+{
+	// Every code decodes and encodes back to itself (NaNs stay NaN, E5M2 Inf saturates)
+	int nbad = 0;
+	for (int i = 0; i < 256; i++) {
+		float f = aussie_fp8_e4m3_to_float32((yfp8_t)i);
+		bool isnan8 = (i & 0x7f) == 0x7f;
+		if (isnan8 ? (f == f) || (aussie_float32_to_fp8_e4m3(f) & 0x7f) != 0x7f : aussie_float32_to_fp8_e4m3(f) != (yfp8_t)i) nbad++;
+		f = aussie_fp8_e5m2_to_float32((yfp8_t)i);
+		isnan8 = (i & 0x7f) > 0x7c;
+		bool isinf8 = (i & 0x7f) == 0x7c;
+		yfp8_t back = aussie_float32_to_fp8_e5m2(f);
+		if (isnan8) { if (f == f || (back & 0x7f) <= 0x7c) nbad++; }
+		else if (isinf8) { if (back != (yfp8_t)((i & 0x80) | 0x7b)) nbad++; }
+		else if (back != (yfp8_t)i) nbad++;
+	}
+	ytesti(nbad, 0);
+
+	// Bits helpers agree with the conversions
+	int s = 0, e = 0, m = 0;
+	aussie_fp8_e4m3_get_bits(aussie_float32_to_fp8_e4m3(-1.5f), s, e, m);
+	ytesti(s, 1); ytesti(e, 0); ytesti(m, 4);
+	ytestf(aussie_fp8_e4m3_to_float32(aussie_fp8_e4m3_from_bits(s, e, m)), -1.5f);
+	aussie_fp8_e5m2_get_bits(aussie_float32_to_fp8_e5m2(6.0f), s, e, m);
+	ytesti(s, 0); ytesti(e, 2); ytesti(m, 2);
+	ytestf(aussie_fp8_e5m2_to_float32(aussie_fp8_e5m2_from_bits(s, e, m)), 6.0f);
+
+	// Saturation, NaN, denormals, ties
+	ytestf(aussie_fp8_e4m3_to_float32(0x7e), 448.0f);
+	ytestf(aussie_fp8_e5m2_to_float32(0x7b), 57344.0f);
+	ytest(aussie_float32_to_fp8_e4m3(1e6f) == 0x7e);
+	ytest(aussie_float32_to_fp8_e4m3(464.0f) == 0x7e);  // Would round to 480 (the NaN code)
+	ytest(aussie_float32_to_fp8_e4m3(-INFINITY) == 0xfe);
+	ytest(aussie_float32_to_fp8_e5m2(1e10f) == 0x7b);
+	ytest(aussie_float32_to_fp8_e5m2(-INFINITY) == 0xfb);
+	ytest((aussie_float32_to_fp8_e4m3(NAN) & 0x7f) == 0x7f);
+	ytest(aussie_fp8_e5m2_to_float32(aussie_float32_to_fp8_e5m2(NAN)) != aussie_fp8_e5m2_to_float32(aussie_float32_to_fp8_e5m2(NAN)));
+	ytest(aussie_float32_to_fp8_e4m3(ldexpf(1.0f, -9)) == 0x01);   // Smallest E4M3 denormal
+	ytest(aussie_float32_to_fp8_e4m3(ldexpf(1.0f, -10)) == 0x00);  // Half of it: ties to zero
+	ytest(aussie_float32_to_fp8_e4m3(ldexpf(1.5f, -10)) == 0x01);
+	ytest(aussie_float32_to_fp8_e4m3(ldexpf(1.0f, -16)) == 0x00);
+	ytest(aussie_float32_to_fp8_e5m2(ldexpf(1.0f, -16)) == 0x01);  // Smallest E5M2 denormal
+	ytest(aussie_float32_to_fp8_e4m3(1.0f + 1.0f / 16.0f) == 0x38);  // Tie: to even (1.0)
+	ytest(aussie_float32_to_fp8_e4m3(1.0f + 3.0f / 16.0f) == 0x3a);  // Tie: to even (up)
+	ytest(aussie_float32_to_fp8_e4m3(-0.0f) == 0x80);
+
+	// Random values (including out of range) match a brute-force nearest search
+	unsigned int seed = 99;
+	nbad = 0;
+	for (int k = 0; k < 4000; k++) {
+		seed = seed * 1664525u + 1013904223u;
+		float f = ldexpf((float)((int)(seed >> 8) % 20001 - 10000) / 10000.0f, (int)(seed % 40) - 20);
+		for (int format = AUSSIE_FP8_E4M3; format <= AUSSIE_FP8_E5M2; format++) {
+			if (aussie_float32_to_fp8(format, f) != aussie_float_test_fp8_nearest(format, f)) nbad++;
+		}
+	}
+	ytesti(nbad, 0);
+}
+
 void aussie_float_tests()
 {
 	fprintf(stderr, "INFO: %s: Running unit tests\n", __func__);
@@ -737,4 +1242,10 @@ void aussie_float_tests()
 	aussie_float_tests_basic();
 
 	aussie_float_tests_range();
+
+	aussie_float_tests_fp16_edges();
+
+	aussie_float_tests_arrays();
+
+	aussie_float_tests_fp8();
 }
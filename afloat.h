@@ -59,6 +59,56 @@ ybf16_t aussie_bfloat16_from_bits(int isign, int iexponent, int imantissa);
 ybf16_t aussie_float32_to_bfloat16(float f);
 float aussie_bfloat16_to_float32(ybf16_t f);
 
+//------------------------------------------------------------
+// FP8 types (OCP 8-bit floats)
+// ... E4M3: 1 sign, 4 exponent (offset 7), 3 mantissa bits; no Inf, only S.1111.111 is NaN; max 448
+// ... E5M2: 1 sign, 5 exponent (offset 15), 2 mantissa bits; IEEE-style Inf/NaN (the top byte of FP16); max 57344
+// ... conversions from FP32 round to nearest even and saturate: overflow and Inf give +/-max, NaN stays NaN
+//------------------------------------------------------------
+
+typedef unsigned char yfp8_t;  // 8-bit type (either format)
+
+#define AUSSIE_FP8_E4M3  0
+#define AUSSIE_FP8_E5M2  1
+
+#define AUSSIE_FP8_E4M3_MAX  448.0f
+#define AUSSIE_FP8_E5M2_MAX  57344.0f
+
+void aussie_fp8_e4m3_get_bits(yfp8_t f, int& signbit, int& exponentbits, int& mantissabits);
+yfp8_t aussie_fp8_e4m3_from_bits(int isign, int iexponent, int imantissa);
+void aussie_fp8_e5m2_get_bits(yfp8_t f, int& signbit, int& exponentbits, int& mantissabits);
+yfp8_t aussie_fp8_e5m2_from_bits(int isign, int iexponent, int imantissa);
+yfp8_t aussie_float32_to_fp8_e4m3(float f);
+float aussie_fp8_e4m3_to_float32(yfp8_t f);
+yfp8_t aussie_float32_to_fp8_e5m2(float f);
+float aussie_fp8_e5m2_to_float32(yfp8_t f);
+yfp8_t aussie_float32_to_fp8(int format, float f);  // AUSSIE_FP8_*
+float aussie_fp8_to_float32(int format, yfp8_t f);
+void aussie_float32_to_fp8_array(int format, const float src[], yfp8_t dst[], int n);
+
+//------------------------------------------------------------
+// Array conversions (whole weight tensors or activations), round to nearest even,
+// Inf/NaN/denormals as in the scalar versions above
+// ... dispatched: F16C (_mm256_cvtps_ph/_mm256_cvtph_ps) or AVX-512 for FP16,
+//     AVX-2 integer round-and-shift for BF16, else the scalar loop
+//------------------------------------------------------------
+
+void aussie_float32_to_float16_array(const float src[], yfp16_t dst[], int n);
+void aussie_float16_to_float32_array(const yfp16_t src[], float dst[], int n);
+void aussie_float32_to_bfloat16_array(const float src[], ybf16_t dst[], int n);
+void aussie_bfloat16_to_float32_array(const ybf16_t src[], float dst[], int n);
+
+void aussie_float32_to_float16_array_basic(const float src[], yfp16_t dst[], int n);
+void aussie_float16_to_float32_array_basic(const yfp16_t src[], float dst[], int n);
+void aussie_float32_to_bfloat16_array_basic(const float src[], ybf16_t dst[], int n);
+void aussie_bfloat16_to_float32_array_basic(const ybf16_t src[], float dst[], int n);
+void aussie_float32_to_float16_array_F16C(const float src[], yfp16_t dst[], int n);
+void aussie_float16_to_float32_array_F16C(const yfp16_t src[], float dst[], int n);
+void aussie_float32_to_float16_array_AVX512(const float src[], yfp16_t dst[], int n);
+void aussie_float16_to_float32_array_AVX512(const yfp16_t src[], float dst[], int n);
+void aussie_float32_to_bfloat16_array_AVX2(const float src[], ybf16_t dst[], int n);
+void aussie_bfloat16_to_float32_array_AVX2(const ybf16_t src[], float dst[], int n);
+
 //------------------------------------------------------------
 // Bit twicks on floats...
 //------------------------------------------------------------
@@ -74,6 +124,9 @@ void aussie_float_tests();
 void aussie_float_tests_basic();
 void aussie_test_one_float(float f);
 void aussie_float_tests_range();
+void aussie_float_tests_fp16_edges();  // FP16 rounding, Inf/NaN, denormals
+void aussie_float_tests_arrays();  // SIMD array conversions match the scalar ones
+void aussie_float_tests_fp8();  // FP8 rounding, saturation, NaN, denormals
 void aussie_float_test_tricks_one_float(float f);
 
 //------------------------------------------------------------
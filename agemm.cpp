@@ -0,0 +1,620 @@
+// agemm.cpp -- Cache-blocked GEMM and parallel GEMV on plain float pointers -- Aussie AI Base Library
+// Created Oct 17th 2026
+// Copyright (c) 2023 Aussie AI Labs Pty Ltd
+//---------------------------------------------------
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <math.h>
+
+#include "aport.h"
+
+#if AUSSIE_X86
+#include <immintrin.h>  // AVX-2/AVX-512 microkernels
+#endif //AUSSIE_X86
+#if !LINUX
+#include <malloc.h>  // _aligned_malloc
+#endif
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+#include "aussieai.h"
+#include "aassert.h"
+#include "atest.h"
+#include "adispatch.h"
+#include "amatmul.h"
+#include "aavx.h"
+#include "athread.h"
+#include "aarena.h"
+
+#include "agemm.h"  // self-include
+
+//---------------------------------------------------
+// Microkernels: C[MRxNR] += Ap[MRxkc] * Bp[kcxNR]
+// ... Ap is a packed panel, column by column (MR floats per k step)
+// ... Bp is a packed panel, row by row (NR floats per k step, 64-byte aligned)
+// ... C is row-major with stride ldc
+//---------------------------------------------------
+
+typedef void (*aussie_gemm_kernel_fnptr)(int kc, const float* Ap, const float* Bp, float* C, int ldc);
+
+#define AUSSIE_GEMM_MR_SCALAR 4
+#define AUSSIE_GEMM_MR_AVX2   6   // 6x16 tile = 12 YMM accumulators (of 16 registers)
+#define AUSSIE_GEMM_MR_AVX512 12  // 12x16 tile = 12 ZMM accumulators (of 32 registers)
+
+static void aussie_gemm_kernel_4x16_scalar(int kc, const float* Ap, const float* Bp, float* C, int ldc)
+{
+	float acc[AUSSIE_GEMM_MR_SCALAR][AUSSIE_GEMM_NR];
+	memset(acc, 0, sizeof(acc));
+	for (int k = 0; k < kc; k++) {
+		for (int r = 0; r < AUSSIE_GEMM_MR_SCALAR; r++) {
+			float a = Ap[r];
+			for (int c = 0; c < AUSSIE_GEMM_NR; c++) {
+				acc[r][c] += a * Bp[c];
+			}
+		}
+		Ap += AUSSIE_GEMM_MR_SCALAR;
+		Bp += AUSSIE_GEMM_NR;
+	}
+	for (int r = 0; r < AUSSIE_GEMM_MR_SCALAR; r++) {
+		for (int c = 0; c < AUSSIE_GEMM_NR; c++) {
+			C[r * ldc + c] += acc[r][c];
+		}
+	}
+}
+
+#if AUSSIE_X86
+
+// One row of the AVX-2 tile: broadcast A[r] times both halves of the B row
+#define AUSSIE_GEMM_FMA_ROW_AVX2(r, c0, c1) \
+	a = _mm256_broadcast_ss(&Ap[r]); \
+	c0 = _mm256_fmadd_ps(a, b0, c0); \
+	c1 = _mm256_fmadd_ps(a, b1, c1)
+
+#define AUSSIE_GEMM_STORE_ROW_AVX2(r, c0, c1) \
+	_mm256_storeu_ps(&C[(r) * ldc], _mm256_add_ps(_mm256_loadu_ps(&C[(r) * ldc]), c0)); \
+	_mm256_storeu_ps(&C[(r) * ldc + 8], _mm256_add_ps(_mm256_loadu_ps(&C[(r) * ldc + 8]), c1))
+
+AUSSIE_TARGET_AVX2 static void aussie_gemm_kernel_6x16_AVX2(int kc, const float* Ap, const float* Bp, float* C, int ldc)
+{
+	__m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+	__m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+	__m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+	__m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+	__m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+	__m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+	__m256 a;
+	for (int k = 0; k < kc; k++) {
+		__m256 b0 = _mm256_load_ps(&Bp[0]);
+		__m256 b1 = _mm256_load_ps(&Bp[8]);
+		AUSSIE_GEMM_FMA_ROW_AVX2(0, c00, c01);
+		AUSSIE_GEMM_FMA_ROW_AVX2(1, c10, c11);
+		AUSSIE_GEMM_FMA_ROW_AVX2(2, c20, c21);
+		AUSSIE_GEMM_FMA_ROW_AVX2(3, c30, c31);
+		AUSSIE_GEMM_FMA_ROW_AVX2(4, c40, c41);
+		AUSSIE_GEMM_FMA_ROW_AVX2(5, c50, c51);
+		Ap += AUSSIE_GEMM_MR_AVX2;
+		Bp += AUSSIE_GEMM_NR;
+	}
+	AUSSIE_GEMM_STORE_ROW_AVX2(0, c00, c01);
+	AUSSIE_GEMM_STORE_ROW_AVX2(1, c10, c11);
+	AUSSIE_GEMM_STORE_ROW_AVX2(2, c20, c21);
+	AUSSIE_GEMM_STORE_ROW_AVX2(3, c30, c31);
+	AUSSIE_GEMM_STORE_ROW_AVX2(4, c40, c41);
+	AUSSIE_GEMM_STORE_ROW_AVX2(5, c50, c51);
+}
+
+#define AUSSIE_GEMM_FMA_ROW_AVX512(r, c0) \
+	c0 = _mm512_fmadd_ps(_mm512_set1_ps(Ap[r]), b0, c0)
+
+#define AUSSIE_GEMM_STORE_ROW_AVX512(r, c0) \
+	_mm512_storeu_ps(&C[(r) * ldc], _mm512_add_ps(_mm512_loadu_ps(&C[(r) * ldc]), c0))
+
+AUSSIE_TARGET_AVX512 static void aussie_gemm_kernel_12x16_AVX512(int kc, const float* Ap, const float* Bp, float* C, int ldc)
+{
+	__m512 c0 = _mm512_setzero_ps(), c1 = _mm512_setzero_ps(), c2 = _mm512_setzero_ps();
+	__m512 c3 = _mm512_setzero_ps(), c4 = _mm512_setzero_ps(), c5 = _mm512_setzero_ps();
+	__m512 c6 = _mm512_setzero_ps(), c7 = _mm512_setzero_ps(), c8 = _mm512_setzero_ps();
+	__m512 c9 = _mm512_setzero_ps(), c10 = _mm512_setzero_ps(), c11 = _mm512_setzero_ps();
+	for (int k = 0; k < kc; k++) {
+		__m512 b0 = _mm512_load_ps(Bp);
+		AUSSIE_GEMM_FMA_ROW_AVX512(0, c0);
+		AUSSIE_GEMM_FMA_ROW_AVX512(1, c1);
+		AUSSIE_GEMM_FMA_ROW_AVX512(2, c2);
+		AUSSIE_GEMM_FMA_ROW_AVX512(3, c3);
+		AUSSIE_GEMM_FMA_ROW_AVX512(4, c4);
+		AUSSIE_GEMM_FMA_ROW_AVX512(5, c5);
+		AUSSIE_GEMM_FMA_ROW_AVX512(6, c6);
+		AUSSIE_GEMM_FMA_ROW_AVX512(7, c7);
+		AUSSIE_GEMM_FMA_ROW_AVX512(8, c8);
+		AUSSIE_GEMM_FMA_ROW_AVX512(9, c9);
+		AUSSIE_GEMM_FMA_ROW_AVX512(10, c10);
+		AUSSIE_GEMM_FMA_ROW_AVX512(11, c11);
+		Ap += AUSSIE_GEMM_MR_AVX512;
+		Bp += AUSSIE_GEMM_NR;
+	}
+	AUSSIE_GEMM_STORE_ROW_AVX512(0, c0);
+	AUSSIE_GEMM_STORE_ROW_AVX512(1, c1);
+	AUSSIE_GEMM_STORE_ROW_AVX512(2, c2);
+	AUSSIE_GEMM_STORE_ROW_AVX512(3, c3);
+	AUSSIE_GEMM_STORE_ROW_AVX512(4, c4);
+	AUSSIE_GEMM_STORE_ROW_AVX512(5, c5);
+	AUSSIE_GEMM_STORE_ROW_AVX512(6, c6);
+	AUSSIE_GEMM_STORE_ROW_AVX512(7, c7);
+	AUSSIE_GEMM_STORE_ROW_AVX512(8, c8);
+	AUSSIE_GEMM_STORE_ROW_AVX512(9, c9);
+	AUSSIE_GEMM_STORE_ROW_AVX512(10, c10);
+	AUSSIE_GEMM_STORE_ROW_AVX512(11, c11);
+}
+
+#endif //AUSSIE_X86
+
+//---------------------------------------------------
+// Packing (zero-padded to whole MR/NR panels, so the microkernels never see edges)
+//---------------------------------------------------
+
+static void aussie_gemm_pack_A(bool transA, const float* A, int lda, int i0, int mc, int p0, int kc, int mr, float alpha, float* Ap)
+{
+	// Rows i0..i0+mc-1 and columns p0..p0+kc-1 of op(A), scaled by alpha
+	for (int ir = 0; ir < mc; ir += mr) {
+		int mrows = mc - ir < mr ? mc - ir : mr;
+		for (int k = 0; k < kc; k++) {
+			int r = 0;
+			for (; r < mrows; r++) {
+				int i = i0 + ir + r;
+				int p = p0 + k;
+				Ap[r] = alpha * (transA ? A[p * lda + i] : A[i * lda + p]);
+			}
+			for (; r < mr; r++) Ap[r] = 0.0f;  // Padding
+			Ap += mr;
+		}
+	}
+}
+
+static void aussie_gemm_pack_B(bool transB, const float* B, int ldb, int p0, int kc, int j0, int nc, float* Bp)
+{
+	// Rows p0..p0+kc-1 and columns j0..j0+nc-1 of op(B)
+	for (int jr = 0; jr < nc; jr += AUSSIE_GEMM_NR) {
+		int ncols = nc - jr < AUSSIE_GEMM_NR ? nc - jr : AUSSIE_GEMM_NR;
+		for (int k = 0; k < kc; k++) {
+			int p = p0 + k;
+			int c = 0;
+			if (!transB) {
+				memcpy(Bp, &B[p * ldb + j0 + jr], ncols * sizeof(float));  // Contiguous row
+				c = ncols;
+			}
+			else {
+				for (; c < ncols; c++) Bp[c] = B[(j0 + jr + c) * ldb + p];
+			}
+			for (; c < AUSSIE_GEMM_NR; c++) Bp[c] = 0.0f;  // Padding
+			Bp += AUSSIE_GEMM_NR;
+		}
+	}
+}
+
+static void aussie_gemm_scale_C(int M, int N, float beta, float* C, int ldc)
+{
+	if (beta == 1.0f) return;
+	for (int i = 0; i < M; i++) {
+		float* crow = &C[i * ldc];
+		if (beta == 0.0f) {
+			memset(crow, 0, N * sizeof(float));  // Don't multiply (0 * NaN is NaN)
+		}
+		else {
+			for (int j = 0; j < N; j++) crow[j] *= beta;
+		}
+	}
+}
+
+//---------------------------------------------------
+// GEMM
+//---------------------------------------------------
+
+static int aussie_gemm_round_up(int n, int multiple)
+{
+	return ((n + multiple - 1) / multiple) * multiple;
+}
+
+void aussie_gemm_isa(int isa, bool transA, bool transB, int M, int N, int K,
+	float alpha, const float* A, int lda, const float* B, int ldb,
+	float beta, float* C, int ldc)  // Force a microkernel (AUSSIE_ISA_*; AVX1 uses scalar)
+{
+	if (M < 0 || N < 0 || K < 0 || ldc < N || lda < (transA ? M : K) || ldb < (transB ? K : N)) {
+		yassert(M >= 0 && N >= 0 && K >= 0);
+		yassert(ldc >= N);
+		yassert(lda >= (transA ? M : K));
+		yassert(ldb >= (transB ? K : N));
+		return;  // fail
+	}
+	if (M == 0 || N == 0) return;  // Nothing to do
+	if (C == NULL || (K > 0 && (A == NULL || B == NULL))) {
+		yassert(C != NULL);
+		yassert(A != NULL && B != NULL);
+		return;  // fail
+	}
+
+	aussie_gemm_scale_C(M, N, beta, C, ldc);  // Microkernels then accumulate into C
+	if (K == 0 || alpha == 0.0f) return;
+
+	// Pick the microkernel (never one this CPU can't run)
+	aussie_gemm_kernel_fnptr kernel = aussie_gemm_kernel_4x16_scalar;
+	int mr = AUSSIE_GEMM_MR_SCALAR;
+#if AUSSIE_X86
+	if (isa >= AUSSIE_ISA_AVX512 && aussie_cpu_has_avx512()) {
+		kernel = aussie_gemm_kernel_12x16_AVX512;
+		mr = AUSSIE_GEMM_MR_AVX512;
+	}
+	else if (isa >= AUSSIE_ISA_AVX2 && aussie_cpu_has_avx2()) {
+		kernel = aussie_gemm_kernel_6x16_AVX2;
+		mr = AUSSIE_GEMM_MR_AVX2;
+	}
+#endif //AUSSIE_X86
+
+	// Packing buffers, sized for this call (small matrices don't need the full blocks)
+	// ... from this thread's arena (no heap calls after the first call), the heap only without one
+	int kcmax = K < AUSSIE_GEMM_KC ? K : AUSSIE_GEMM_KC;
+	int mcmax = aussie_gemm_round_up(M < AUSSIE_GEMM_MC ? M : AUSSIE_GEMM_MC, mr);
+	int ncmax = aussie_gemm_round_up(N < AUSSIE_GEMM_NC ? N : AUSSIE_GEMM_NC, AUSSIE_GEMM_NR);
+	aussie_arena* arena = aussie_thread_arena();
+	aussie_arena_mark mark;
+	float* Ap = NULL;
+	float* Bp = NULL;
+	if (arena) {
+		mark = aussie_arena_get_mark(*arena);
+		Ap = aussie_arena_alloc_floats(*arena, (long long)mcmax * kcmax);
+		Bp = aussie_arena_alloc_floats(*arena, (long long)kcmax * ncmax);
+	}
+	else {
+		Ap = (float*)AUSSIE_ALIGNED_MALLOC(mcmax * kcmax * sizeof(float), 64);
+		Bp = (float*)AUSSIE_ALIGNED_MALLOC(kcmax * ncmax * sizeof(float), 64);
+	}
+	if (Ap == NULL || Bp == NULL) {
+		yassert(Ap != NULL && Bp != NULL);
+		if (arena) aussie_arena_release(*arena, mark);
+		else {
+			if (Ap) AUSSIE_ALIGNED_FREE(Ap);
+			if (Bp) AUSSIE_ALIGNED_FREE(Bp);
+		}
+		return;  // fail
+	}
+
+	alignas(64) float ctile[AUSSIE_GEMM_MR_MAX * AUSSIE_GEMM_NR];  // Edge tiles
+	for (int jc = 0; jc < N; jc += AUSSIE_GEMM_NC) {
+		int nc = N - jc < AUSSIE_GEMM_NC ? N - jc : AUSSIE_GEMM_NC;
+		for (int pc = 0; pc < K; pc += AUSSIE_GEMM_KC) {
+			int kc = K - pc < AUSSIE_GEMM_KC ? K - pc : AUSSIE_GEMM_KC;
+			aussie_gemm_pack_B(transB, B, ldb, pc, kc, jc, nc, Bp);
+			for (int ic = 0; ic < M; ic += AUSSIE_GEMM_MC) {
+				int mc = M - ic < AUSSIE_GEMM_MC ? M - ic : AUSSIE_GEMM_MC;
+				aussie_gemm_pack_A(transA, A, lda, ic, mc, pc, kc, mr, alpha, Ap);
+				for (int jr = 0; jr < nc; jr += AUSSIE_GEMM_NR) {
+					int ncols = nc - jr < AUSSIE_GEMM_NR ? nc - jr : AUSSIE_GEMM_NR;
+					const float* Bpanel = &Bp[jr * kc];
+					for (int ir = 0; ir < mc; ir += mr) {
+						int mrows = mc - ir < mr ? mc - ir : mr;
+						const float* Apanel = &Ap[ir * kc];
+						float* Ctile = &C[(ic + ir) * ldc + jc + jr];
+						if (mrows == mr && ncols == AUSSIE_GEMM_NR) {
+							kernel(kc, Apanel, Bpanel, Ctile, ldc);
+						}
+						else {
+							// Partial tile: run the full kernel into a scratch tile, add the valid part
+							memset(ctile, 0, sizeof(ctile));
+							kernel(kc, Apanel, Bpanel, ctile, AUSSIE_GEMM_NR);
+							for (int r = 0; r < mrows; r++) {
+								for (int c = 0; c < ncols; c++) {
+									Ctile[r * ldc + c] += ctile[r * AUSSIE_GEMM_NR + c];
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	if (arena) aussie_arena_release(*arena, mark);
+	else {
+		AUSSIE_ALIGNED_FREE(Ap);
+		AUSSIE_ALIGNED_FREE(Bp);
+	}
+}
+
+void aussie_gemm(bool transA, bool transB, int M, int N, int K,
+	float alpha, const float* A, int lda, const float* B, int ldb,
+	float beta, float* C, int ldc)  // Dispatched to the fastest microkernel for this CPU
+{
+	aussie_dispatch_ensure();
+	aussie_gemm_isa(g_aussie_dispatch.isa, transA, transB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+}
+
+void aussie_gemm_basic(bool transA, bool transB, int M, int N, int K,
+	float alpha, const float* A, int lda, const float* B, int ldb,
+	float beta, float* C, int ldc)  // Simple triple loop (reference)
+{
+	for (int i = 0; i < M; i++) {
+		for (int j = 0; j < N; j++) {
+			float sum = 0.0f;
+			for (int k = 0; k < K; k++) {
+				float a = transA ? A[k * lda + i] : A[i * lda + k];
+				float b = transB ? B[j * ldb + k] : B[k * ldb + j];
+				sum += a * b;
+			}
+			C[i * ldc + j] = alpha * sum + (beta == 0.0f ? 0.0f : beta * C[i * ldc + j]);
+		}
+	}
+}
+
+void aussie_matmul_matrix_gemm(const ymatrix m, const ymatrix m2, int n, ymatrix mout)
+{
+	// Same as aussie_matmul_matrix_basic: mout = m * m2 for the top-left NxN (any n, not just 2048)
+	if (n < 0 || n > AUSSIE_MATRIX_ROWS) {
+		yassert(n >= 0 && n <= AUSSIE_MATRIX_ROWS);
+		return;  // fail
+	}
+	aussie_gemm(false, false, n, n, n, 1.0f, &m[0][0], AUSSIE_MATRIX_COLUMNS, &m2[0][0], AUSSIE_MATRIX_COLUMNS,
+		0.0f, &mout[0][0], AUSSIE_MATRIX_COLUMNS);
+}
+
+//---------------------------------------------------
+// Parallel GEMV (decode: one token, so matrix-vector not matrix-matrix)
+//---------------------------------------------------
+
+struct aussie_gemv_job {
+	const float* W;
+	int nrows;
+	int ncols;
+	int ldw;
+	const float* v;
+	float* vout;
+	int chunk;   // Rows per task (0 = one contiguous block per thread)
+	int ntasks;
+	aussie_vecdot_fnptr vecdot;  // Per-row kernel
+};
+
+static void aussie_gemv_rows(const aussie_gemv_job* job, int itask, int& rowstart, int& rowend)
+{
+	if (job->chunk <= 0) {  // Static: block t of ntasks near-equal blocks (always the same thread)
+		rowstart = (int)(((long long)job->nrows * itask) / job->ntasks);
+		rowend = (int)(((long long)job->nrows * (itask + 1)) / job->ntasks);
+	}
+	else {  // Dynamic: chunks handed out in order
+		rowstart = itask * job->chunk;
+		rowend = rowstart + job->chunk < job->nrows ? rowstart + job->chunk : job->nrows;
+	}
+}
+
+static void aussie_gemv_task(int itask, void* arg)
+{
+	const aussie_gemv_job* job = (const aussie_gemv_job*)arg;
+	int rowstart = 0, rowend = 0;
+	aussie_gemv_rows(job, itask, rowstart, rowend);
+	for (int i = rowstart; i < rowend; i++) {
+		job->vout[i] = job->vecdot(&job->W[(long long)i * job->ldw], job->v, job->ncols);
+	}
+}
+
+static void aussie_gemv_copy_task(int itask, void* arg)
+{
+	// Copy this task's rows (the source pointer is passed in v)
+	const aussie_gemv_job* job = (const aussie_gemv_job*)arg;
+	int rowstart = 0, rowend = 0;
+	aussie_gemv_rows(job, itask, rowstart, rowend);
+	for (int i = rowstart; i < rowend; i++) {
+		memcpy((float*)&job->W[(long long)i * job->ldw], &job->v[(long long)i * job->ldw], job->ncols * sizeof(float));
+	}
+}
+
+static bool aussie_gemv_setup(aussie_gemv_job& job, const float* W, int nrows, int ncols, int ldw, const float* v, float* vout, int chunk)
+{
+	if (W == NULL || v == NULL || vout == NULL || nrows < 0 || ncols < 0 || ldw < ncols) {
+		yassert(W != NULL && v != NULL && vout != NULL);
+		yassert(nrows >= 0 && ncols >= 0 && ldw >= ncols);
+		return false;  // fail
+	}
+	aussie_dispatch_ensure();
+	job.W = W;
+	job.nrows = nrows;
+	job.ncols = ncols;
+	job.ldw = ldw;
+	job.v = v;
+	job.vout = vout;
+	job.chunk = chunk;
+	if (chunk <= 0) {
+		int nthreads = aussie_thread_count();
+		job.ntasks = nrows < nthreads ? nrows : nthreads;
+	}
+	else {
+		job.ntasks = (nrows + chunk - 1) / chunk;
+	}
+	job.vecdot = g_aussie_dispatch.fn_vecdot;
+#if AUSSIE_X86
+	if (g_aussie_dispatch.isa >= AUSSIE_ISA_AVX512) job.vecdot = aussie_vecdot_FMA_unroll_AVX512;
+	else if (g_aussie_dispatch.isa >= AUSSIE_ISA_AVX2) job.vecdot = aussie_vecdot_FMA_unroll_AVX2;
+#endif //AUSSIE_X86
+	return true;
+}
+
+void aussie_gemv_parallel(const float* W, int nrows, int ncols, int ldw, const float* v, float* vout, int chunk)  // vout = W * v
+{
+	aussie_gemv_job job;
+	if (!aussie_gemv_setup(job, W, nrows, ncols, ldw, v, vout, chunk)) return;  // fail
+	aussie_parallel_run(job.ntasks, aussie_gemv_task, &job, chunk <= 0 ? AUSSIE_SCHEDULE_STATIC : AUSSIE_SCHEDULE_DYNAMIC);
+}
+
+void aussie_gemv_place_rows(float* Wdst, const float* Wsrc, int nrows, int ncols, int ldw)  // Copy weights, first-touched by their static owners
+{
+	aussie_gemv_job job;
+	float vdummy = 0.0f;
+	if (Wsrc == NULL || !aussie_gemv_setup(job, Wdst, nrows, ncols, ldw, &vdummy, &vdummy, 0)) return;  // fail
+	job.v = Wsrc;
+	aussie_parallel_run(job.ntasks, aussie_gemv_copy_task, &job, AUSSIE_SCHEDULE_STATIC);
+}
+
+void aussie_matmul_vector_parallel(const ymatrix m, const float v[], int n, float vout[])
+{
+	// Same as aussie_matmul_vector_basic_out1 (top-left NxN), rows split across the thread pool
+	if (n < 0 || n > AUSSIE_MATRIX_ROWS) {
+		yassert(n >= 0 && n <= AUSSIE_MATRIX_ROWS);
+		return;  // fail
+	}
+	aussie_gemv_parallel(&m[0][0], n, n, AUSSIE_MATRIX_COLUMNS, v, vout, 0);
+}
+
+//---------------------------------------------------
+// Unit tests
+//---------------------------------------------------
+
+static void aussie_gemm_test_one(int isa, bool transA, bool transB, int M, int N, int K, float alpha, float beta)
+{
+	int pad = 3;  // Leading dimensions bigger than the widths
+	int arows = transA ? K : M, acols = transA ? M : K;
+	int brows = transB ? N : K, bcols = transB ? K : N;
+	int lda = acols + pad, ldb = bcols + pad, ldc = N + pad;
+	float* A = (float*)malloc(arows * lda * sizeof(float));
+	float* B = (float*)malloc(brows * ldb * sizeof(float));
+	float* C = (float*)malloc(M * ldc * sizeof(float));
+	float* Cref = (float*)malloc(M * ldc * sizeof(float));
+	if (!A || !B || !C || !Cref) {
+		yassert(A && B && C && Cref);
+		free(A); free(B); free(C); free(Cref);
+		return;  // fail
+	}
+	for (int i = 0; i < arows * lda; i++) A[i] = AUSSIE_TEST_VALUE(i / lda, i % lda, 1);
+	for (int i = 0; i < brows * ldb; i++) B[i] = AUSSIE_TEST_VALUE(i / ldb, i % ldb, 2);
+	for (int i = 0; i < M * ldc; i++) {
+		C[i] = Cref[i] = AUSSIE_TEST_VALUE(i / ldc, i % ldc, 3);
+		if (beta == 0.0f && i % ldc < N) C[i] = NAN;  // beta==0 must not read C
+	}
+
+	aussie_gemm_isa(isa, transA, transB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+	aussie_gemm_basic(transA, transB, M, N, K, alpha, A, lda, B, ldb, beta, Cref, ldc);
+
+	float maxerr = 0.0f;
+	bool padding_ok = true;
+	for (int i = 0; i < M * ldc; i++) {
+		if (i % ldc >= N) {
+			if (C[i] != Cref[i]) padding_ok = false;  // Never write past N columns
+			continue;
+		}
+		float err = fabsf(C[i] - Cref[i]);
+		if (!(err <= maxerr)) maxerr = err;  // NaN too
+	}
+	float tol = 1e-5f * K + 1e-5f;  // Summation order differs
+	ytest(maxerr <= tol);
+	ytest(padding_ok);
+	if (!(maxerr <= tol) || !padding_ok) {
+		fprintf(stderr, "ERROR: %s: %s M=%d N=%d K=%d transA=%d transB=%d: max error %g\n",
+			__func__, aussie_dispatch_isa_name(isa), M, N, K, (int)transA, (int)transB, maxerr);
+	}
+	free(A); free(B); free(C); free(Cref);
+}
+
+static void aussie_gemm_test_matrix_wrapper()
+{
+	// ymatrix wrapper on a small corner (aussie_matmul_matrix_basic only allows n=2048, too slow here)
+	ymatrix* m1 = (ymatrix*)malloc(sizeof(ymatrix));
+	ymatrix* m2 = (ymatrix*)malloc(sizeof(ymatrix));
+	ymatrix* m3 = (ymatrix*)malloc(sizeof(ymatrix));
+	if (!m1 || !m2 || !m3) {
+		yassert(m1 && m2 && m3);
+		free(m1); free(m2); free(m3);
+		return;  // fail
+	}
+	int n = 37;
+	for (int i = 0; i < n; i++) {
+		for (int j = 0; j < n; j++) {
+			(*m1)[i][j] = AUSSIE_TEST_VALUE(i, j, 4);
+			(*m2)[i][j] = AUSSIE_TEST_VALUE(i, j, 5);
+		}
+	}
+	aussie_matmul_matrix_gemm(*m1, *m2, n, *m3);
+	float maxerr = 0.0f;
+	for (int i = 0; i < n; i++) {
+		for (int j = 0; j < n; j++) {
+			float sum = 0.0f;
+			for (int k = 0; k < n; k++) sum += (*m1)[i][k] * (*m2)[k][j];
+			float err = fabsf((*m3)[i][j] - sum);
+			if (err > maxerr) maxerr = err;
+		}
+	}
+	ytest(maxerr <= 1e-4f);
+	free(m1); free(m2); free(m3);
+}
+
+static void aussie_gemv_test_one(int nrows, int ncols, int chunk)
+{
+	int ldw = ncols + 5;
+	float* W = (float*)malloc((nrows * ldw + 1) * sizeof(float));
+	float* W2 = (float*)malloc((nrows * ldw + 1) * sizeof(float));
+	float* v = (float*)malloc((ncols + 1) * sizeof(float));
+	float* vout = (float*)malloc((nrows + 1) * sizeof(float));
+	if (!W || !W2 || !v || !vout) {
+		yassert(W && W2 && v && vout);
+		free(W); free(W2); free(v); free(vout);
+		return;  // fail
+	}
+	for (int i = 0; i < nrows * ldw; i++) W[i] = AUSSIE_TEST_VALUE(i / ldw, i % ldw, 6);
+	for (int j = 0; j < ncols; j++) v[j] = AUSSIE_TEST_VALUE(j, 0, 7);
+	for (int i = 0; i <= nrows; i++) vout[i] = -999.0f;  // Guard at vout[nrows]
+	aussie_gemv_place_rows(W2, W, nrows, ncols, ldw);
+	aussie_gemv_parallel(W2, nrows, ncols, ldw, v, vout, chunk);
+	float maxerr = 0.0f;
+	for (int i = 0; i < nrows; i++) {
+		float sum = 0.0f;
+		for (int j = 0; j < ncols; j++) sum += W[i * ldw + j] * v[j];
+		float err = fabsf(vout[i] - sum);
+		if (!(err <= maxerr)) maxerr = err;
+	}
+	ytest(maxerr <= 1e-5f * ncols + 1e-5f);
+	ytestf(vout[nrows], -999.0f);
+	free(W); free(W2); free(v); free(vout);
+}
+
+void aussie_gemm_unit_tests()
+{
+	fprintf(stderr, "INFO: %s: Running unit tests\n", __func__);
+	// Odd sizes for edge tiles, plus sizes over MC and KC for multiple blocks
+	static const int sizes[][3] = {  // M, N, K
+		{ 1, 1, 1 }, { 5, 7, 3 }, { 6, 16, 8 }, { 12, 32, 5 }, { 13, 17, 29 },
+		{ 37, 50, AUSSIE_GEMM_KC + 44 }, { AUSSIE_GEMM_MC + 11, 33, 20 }, { 2, 3, 0 },
+	};
+	int nsizes = (int)(sizeof(sizes) / sizeof(sizes[0]));
+	for (int isa = AUSSIE_ISA_SCALAR; isa <= AUSSIE_ISA_AVX512; isa++) {
+		if (isa == AUSSIE_ISA_AVX1) continue;  // No AVX1 microkernel (same as scalar)
+		if (isa == AUSSIE_ISA_AVX2 && !aussie_cpu_has_avx2()) continue;
+		if (isa == AUSSIE_ISA_AVX512 && !aussie_cpu_has_avx512()) continue;
+		for (int s = 0; s < nsizes; s++) {
+			for (int t = 0; t < 4; t++) {
+				bool transA = (t & 1) != 0, transB = (t & 2) != 0;
+				aussie_gemm_test_one(isa, transA, transB, sizes[s][0], sizes[s][1], sizes[s][2], 1.0f, 0.0f);
+			}
+		}
+		aussie_gemm_test_one(isa, false, false, 13, 17, 29, 1.5f, 0.5f);
+		aussie_gemm_test_one(isa, true, true, 13, 17, 29, -2.0f, 1.0f);
+		aussie_gemm_test_one(isa, false, true, 9, 20, 11, 0.0f, 2.0f);  // C = beta * C
+	}
+	aussie_gemm_test_matrix_wrapper();
+
+	// Parallel GEMV, on a pool bigger than this machine may have
+	aussie_thread_pool_shutdown();
+	aussie_thread_pool_init(4);
+	int chunks[] = { 0, 1, 7, 64 };  // Static, then dynamic chunk sizes
+	for (int c = 0; c < 4; c++) {
+		aussie_gemv_test_one(1, 3, chunks[c]);
+		aussie_gemv_test_one(3, 17, chunks[c]);  // Fewer rows than threads
+		aussie_gemv_test_one(301, 129, chunks[c]);
+	}
+	aussie_thread_pool_shutdown();  // Back to the default size on next use
+}
+
+//---------------------------------------------------
+//---------------------------------------------------
+
@@ -0,0 +1,62 @@
+//---------------------------------------------------
+// agemm.h -- Cache-blocked GEMM and parallel GEMV on plain float pointers -- Aussie AI Base Library
+// Created Oct 17th 2026
+// Copyright (c) 2023 Aussie AI Labs Pty Ltd
+//---------------------------------------------------
+
+#ifndef AUSSIE_YGEMM_INCLUDE_HEADER_H
+#define AUSSIE_YGEMM_INCLUDE_HEADER_H
+
+//---------------------------------------------------
+// GEMM: C = alpha * op(A) * op(B) + beta * C
+// ... all matrices are row-major: element (i,j) of X is X[i * ldx + j]
+// ... op(A) is MxK, op(B) is KxN, C is MxN
+// ... transA: A is stored as KxM (lda >= M), otherwise MxK (lda >= K)
+// ... transB: B is stored as NxK (ldb >= K), otherwise KxN (ldb >= N)
+// ... beta == 0 overwrites C (old contents of C are never read, so NaN garbage is fine)
+//
+// Any sizes (unlike the fixed 2048x2048 ymatrix APIs in amatmul.h, which remain
+// as simple correctness references). Blocking follows the usual BLIS loop order:
+//   NC columns of B (L3) -> KC rows packed into NR-wide panels (L1)
+//   -> MC rows of A packed into MR-high panels (L2) -> MRxNR register microkernel
+//---------------------------------------------------
+
+#define AUSSIE_GEMM_KC 256    // Depth of a packed block (rows of op(B) panel)
+#define AUSSIE_GEMM_MC 120    // Rows of op(A) per packed block (120x256 floats = 120K, fits L2)
+#define AUSSIE_GEMM_NC 2048   // Columns of op(B) per packed block
+#define AUSSIE_GEMM_NR 16     // Microkernel tile width (2 YMM or 1 ZMM registers)
+#define AUSSIE_GEMM_MR_MAX 12 // Largest microkernel tile height (AVX-512 is 12x16, AVX-2 is 6x16)
+
+void aussie_gemm(bool transA, bool transB, int M, int N, int K,
+	float alpha, const float* A, int lda, const float* B, int ldb,
+	float beta, float* C, int ldc);  // Dispatched to the fastest microkernel for this CPU
+void aussie_gemm_isa(int isa, bool transA, bool transB, int M, int N, int K,
+	float alpha, const float* A, int lda, const float* B, int ldb,
+	float beta, float* C, int ldc);  // Force a microkernel (AUSSIE_ISA_*; AVX1 uses scalar)
+void aussie_gemm_basic(bool transA, bool transB, int M, int N, int K,
+	float alpha, const float* A, int lda, const float* B, int ldb,
+	float beta, float* C, int ldc);  // Simple triple loop (reference)
+
+//---------------------------------------------------
+// Parallel GEMV: vout = W * v, W is nrows x ncols (row-major, stride ldw)
+// ... output rows are split across the thread pool (athread.h)
+// ... chunk == 0: static, one contiguous block of rows per thread. The same thread
+//     owns the same rows on every call, so the rows stay in its cache (and with
+//     aussie_gemv_place_rows, on its NUMA node by first-touch).
+// ... chunk > 0: dynamic, threads take chunk rows at a time (uneven or busy cores)
+// ... per-row kernel is the FMA vecdot (aussie_vecdot_FMA_unroll_AVX2 or AVX-512)
+//---------------------------------------------------
+
+void aussie_gemv_parallel(const float* W, int nrows, int ncols, int ldw, const float* v, float* vout, int chunk);  // vout = W * v
+void aussie_gemv_place_rows(float* Wdst, const float* Wsrc, int nrows, int ncols, int ldw);  // Copy weights, first-touched by their static owners
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+void aussie_gemm_unit_tests();
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+
+#endif //AUSSIE_YGEMM_INCLUDE_HEADER_H
@@ -0,0 +1,748 @@
+// ahalf.cpp -- Mixed-precision FP16/BF16/FP8 weight kernels -- Aussie AI Base Library
+// Created Oct 17th 2026
+// Copyright (c) 2023 Aussie AI Labs Pty Ltd
+//---------------------------------------------------
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <math.h>
+
+#include "aport.h"
+
+#if AUSSIE_X86
+#include <immintrin.h>  // F16C, AVX-2, AVX-512
+#endif //AUSSIE_X86
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+#include "aussieai.h"
+#include "aassert.h"
+#include "atest.h"
+#include "adispatch.h"
+#include "athread.h"
+#include "afloat.h"
+#include "amatmul.h"
+#include "aquant.h"
+#include "aprecompute.h"
+
+#include "ahalf.h"  // self-include
+
+//---------------------------------------------------
+// Vector dot products: 16-bit weights times FP32 activations
+//---------------------------------------------------
+
+float aussie_vecdot_fp16_basic(const yfp16_t w[], const float x[], int n)
+{
+	float sum = 0.0f;
+	for (int i = 0; i < n; i++) sum += aussie_float16_to_float32(w[i]) * x[i];
+	return sum;
+}
+
+float aussie_vecdot_bf16_basic(const ybf16_t w[], const float x[], int n)
+{
+	float sum = 0.0f;
+	for (int i = 0; i < n; i++) sum += aussie_bfloat16_to_float32(w[i]) * x[i];
+	return sum;
+}
+
+#if AUSSIE_X86
+
+static inline AUSSIE_TARGET_AVX2 float aussie_half_hsum_AVX2(__m256 acc)
+{
+	float* farr = (float*)&acc;
+	return farr[0] + farr[1] + farr[2] + farr[3] + farr[4] + farr[5] + farr[6] + farr[7];
+}
+
+static inline AUSSIE_TARGET_AVX2 __m256 aussie_bf16_load8_AVX2(const ybf16_t w[])
+{
+	// 8 BF16 -> 8 floats: the BF16 bits are the top half of the FP32 bits
+	__m256i w32 = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)w));
+	return _mm256_castsi256_ps(_mm256_slli_epi32(w32, 16));
+}
+
+AUSSIE_TARGET_AVX2_F16C float aussie_vecdot_fp16_F16C(const yfp16_t w[], const float x[], int n)
+{
+	// Four accumulators (32 weights per loop), so the FMA latency is hidden
+	__m256 acc0 = _mm256_setzero_ps();
+	__m256 acc1 = _mm256_setzero_ps();
+	__m256 acc2 = _mm256_setzero_ps();
+	__m256 acc3 = _mm256_setzero_ps();
+	int i = 0;
+	for (; i + 32 <= n; i += 32) {
+		acc0 = _mm256_fmadd_ps(_mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)&w[i])), _mm256_loadu_ps(&x[i]), acc0);
+		acc1 = _mm256_fmadd_ps(_mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)&w[i + 8])), _mm256_loadu_ps(&x[i + 8]), acc1);
+		acc2 = _mm256_fmadd_ps(_mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)&w[i + 16])), _mm256_loadu_ps(&x[i + 16]), acc2);
+		acc3 = _mm256_fmadd_ps(_mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)&w[i + 24])), _mm256_loadu_ps(&x[i + 24]), acc3);
+	}
+	for (; i + 8 <= n; i += 8) {
+		acc0 = _mm256_fmadd_ps(_mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)&w[i])), _mm256_loadu_ps(&x[i]), acc0);
+	}
+	float sum = aussie_half_hsum_AVX2(_mm256_add_ps(_mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3)));
+	for (; i < n; i++) sum += aussie_float16_to_float32(w[i]) * x[i];  // Leftovers
+	return sum;
+}
+
+AUSSIE_TARGET_AVX2 float aussie_vecdot_bf16_AVX2(const ybf16_t w[], const float x[], int n)
+{
+	__m256 acc0 = _mm256_setzero_ps();
+	__m256 acc1 = _mm256_setzero_ps();
+	__m256 acc2 = _mm256_setzero_ps();
+	__m256 acc3 = _mm256_setzero_ps();
+	int i = 0;
+	for (; i + 32 <= n; i += 32) {
+		acc0 = _mm256_fmadd_ps(aussie_bf16_load8_AVX2(&w[i]), _mm256_loadu_ps(&x[i]), acc0);
+		acc1 = _mm256_fmadd_ps(aussie_bf16_load8_AVX2(&w[i + 8]), _mm256_loadu_ps(&x[i + 8]), acc1);
+		acc2 = _mm256_fmadd_ps(aussie_bf16_load8_AVX2(&w[i + 16]), _mm256_loadu_ps(&x[i + 16]), acc2);
+		acc3 = _mm256_fmadd_ps(aussie_bf16_load8_AVX2(&w[i + 24]), _mm256_loadu_ps(&x[i + 24]), acc3);
+	}
+	for (; i + 8 <= n; i += 8) {
+		acc0 = _mm256_fmadd_ps(aussie_bf16_load8_AVX2(&w[i]), _mm256_loadu_ps(&x[i]), acc0);
+	}
+	float sum = aussie_half_hsum_AVX2(_mm256_add_ps(_mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3)));
+	for (; i < n; i++) sum += aussie_bfloat16_to_float32(w[i]) * x[i];  // Leftovers
+	return sum;
+}
+
+AUSSIE_TARGET_AVX512 float aussie_vecdot_fp16_AVX512(const yfp16_t w[], const float x[], int n)
+{
+	__m512 acc0 = _mm512_setzero_ps();
+	__m512 acc1 = _mm512_setzero_ps();
+	int i = 0;
+	for (; i + 32 <= n; i += 32) {
+		acc0 = _mm512_fmadd_ps(_mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)&w[i])), _mm512_loadu_ps(&x[i]), acc0);
+		acc1 = _mm512_fmadd_ps(_mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)&w[i + 16])), _mm512_loadu_ps(&x[i + 16]), acc1);
+	}
+	for (; i < n; i += 16) {  // Last 1..31 (masked loads read nothing past the end)
+		__mmask16 mask = n - i >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << (n - i)) - 1);
+		__m512 wf = _mm512_cvtph_ps(_mm256_maskz_loadu_epi16(mask, &w[i]));
+		acc0 = _mm512_fmadd_ps(wf, _mm512_maskz_loadu_ps(mask, &x[i]), acc0);
+	}
+	return _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+}
+
+AUSSIE_TARGET_AVX512 float aussie_vecdot_bf16_AVX512(const ybf16_t w[], const float x[], int n)
+{
+	// Widening by shift, not AVX512-BF16 vdpbf16ps (that would round the activations to BF16 too)
+	__m512 acc0 = _mm512_setzero_ps();
+	__m512 acc1 = _mm512_setzero_ps();
+	int i = 0;
+	for (; i + 32 <= n; i += 32) {
+		__m512i w0 = _mm512_slli_epi32(_mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i*)&w[i])), 16);
+		__m512i w1 = _mm512_slli_epi32(_mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i*)&w[i + 16])), 16);
+		acc0 = _mm512_fmadd_ps(_mm512_castsi512_ps(w0), _mm512_loadu_ps(&x[i]), acc0);
+		acc1 = _mm512_fmadd_ps(_mm512_castsi512_ps(w1), _mm512_loadu_ps(&x[i + 16]), acc1);
+	}
+	for (; i < n; i += 16) {  // Last 1..31, masked
+		__mmask16 mask = n - i >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << (n - i)) - 1);
+		__m512i w0 = _mm512_slli_epi32(_mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(mask, &w[i])), 16);
+		acc0 = _mm512_fmadd_ps(_mm512_castsi512_ps(w0), _mm512_maskz_loadu_ps(mask, &x[i]), acc0);
+	}
+	return _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+}
+
+#else
+
+float aussie_vecdot_fp16_F16C(const yfp16_t w[], const float x[], int n) { return aussie_vecdot_fp16_basic(w, x, n); }
+float aussie_vecdot_fp16_AVX512(const yfp16_t w[], const float x[], int n) { return aussie_vecdot_fp16_basic(w, x, n); }
+float aussie_vecdot_bf16_AVX2(const ybf16_t w[], const float x[], int n) { return aussie_vecdot_bf16_basic(w, x, n); }
+float aussie_vecdot_bf16_AVX512(const ybf16_t w[], const float x[], int n) { return aussie_vecdot_bf16_basic(w, x, n); }
+
+#endif //AUSSIE_X86
+
+static aussie_vecdot_half_fnptr aussie_half_kernel(int isa, int format)
+{
+	if (format == AUSSIE_HALF_BF16) {
+		if (isa >= AUSSIE_ISA_AVX512 && aussie_cpu_has_avx512()) return aussie_vecdot_bf16_AVX512;
+		if (isa >= AUSSIE_ISA_AVX2 && aussie_cpu_has_avx2()) return aussie_vecdot_bf16_AVX2;
+		return aussie_vecdot_bf16_basic;
+	}
+	if (isa >= AUSSIE_ISA_AVX512 && aussie_cpu_has_avx512()) return aussie_vecdot_fp16_AVX512;
+	if (isa >= AUSSIE_ISA_AVX2 && aussie_cpu_has_avx2() && aussie_cpu_detect().f16c) return aussie_vecdot_fp16_F16C;
+	return aussie_vecdot_fp16_basic;
+}
+
+float aussie_vecdot_fp16(const yfp16_t w[], const float x[], int n)
+{
+	aussie_dispatch_ensure();
+	return aussie_half_kernel(g_aussie_dispatch.isa, AUSSIE_HALF_FP16)(w, x, n);
+}
+
+float aussie_vecdot_bf16(const ybf16_t w[], const float x[], int n)
+{
+	aussie_dispatch_ensure();
+	return aussie_half_kernel(g_aussie_dispatch.isa, AUSSIE_HALF_BF16)(w, x, n);
+}
+
+//---------------------------------------------------
+// GEMV
+//---------------------------------------------------
+
+struct aussie_half_gemv_job {
+	const yfp16_t* W;
+	int nrows, ncols, ldw;
+	const float* v;
+	float* vout;
+	int ntasks;
+	aussie_vecdot_half_fnptr vecdot;
+};
+
+static void aussie_half_gemv_rows(const aussie_half_gemv_job* job, int rowstart, int rowend)
+{
+	for (int i = rowstart; i < rowend; i++) {
+		job->vout[i] = job->vecdot(&job->W[(long long)i * job->ldw], job->v, job->ncols);
+	}
+}
+
+static void aussie_half_gemv_task(int itask, void* arg)
+{
+	const aussie_half_gemv_job* job = (const aussie_half_gemv_job*)arg;
+	int rowstart = (int)(((long long)job->nrows * itask) / job->ntasks);
+	int rowend = (int)(((long long)job->nrows * (itask + 1)) / job->ntasks);
+	aussie_half_gemv_rows(job, rowstart, rowend);
+}
+
+static bool aussie_half_gemv_setup(aussie_half_gemv_job& job, int isa, int format, const yfp16_t* W, int nrows, int ncols, int ldw, const float* v, float* vout)
+{
+	if (W == NULL || v == NULL || vout == NULL || nrows < 0 || ncols < 0 || ldw < ncols) {
+		yassert(W != NULL && v != NULL && vout != NULL);
+		yassert(nrows >= 0 && ncols >= 0 && ldw >= ncols);
+		return false;  // fail
+	}
+	job.W = W;
+	job.nrows = nrows;
+	job.ncols = ncols;
+	job.ldw = ldw;
+	job.v = v;
+	job.vout = vout;
+	job.ntasks = 1;
+	job.vecdot = aussie_half_kernel(isa, format);
+	return true;
+}
+
+void aussie_gemv_half_isa(int isa, int format, const yfp16_t* W, int nrows, int ncols, int ldw, const float* v, float* vout)  // Force a kernel, one thread
+{
+	aussie_half_gemv_job job;
+	if (!aussie_half_gemv_setup(job, isa, format, W, nrows, ncols, ldw, v, vout)) return;  // fail
+	aussie_half_gemv_rows(&job, 0, nrows);
+}
+
+static void aussie_half_gemv_parallel(int format, const yfp16_t* W, int nrows, int ncols, int ldw, const float* v, float* vout)
+{
+	aussie_dispatch_ensure();
+	aussie_half_gemv_job job;
+	if (!aussie_half_gemv_setup(job, g_aussie_dispatch.isa, format, W, nrows, ncols, ldw, v, vout)) return;  // fail
+	int nthreads = aussie_thread_count();
+	job.ntasks = nrows < nthreads ? nrows : nthreads;
+	if (job.ntasks <= 1) {
+		aussie_half_gemv_rows(&job, 0, nrows);
+		return;
+	}
+	aussie_parallel_run(job.ntasks, aussie_half_gemv_task, &job, AUSSIE_SCHEDULE_STATIC);
+}
+
+void aussie_gemv_fp16(const yfp16_t* W, int nrows, int ncols, int ldw, const float* v, float* vout)
+{
+	aussie_half_gemv_parallel(AUSSIE_HALF_FP16, W, nrows, ncols, ldw, v, vout);
+}
+
+void aussie_gemv_bf16(const ybf16_t* W, int nrows, int ncols, int ldw, const float* v, float* vout)
+{
+	aussie_half_gemv_parallel(AUSSIE_HALF_BF16, W, nrows, ncols, ldw, v, vout);
+}
+
+//---------------------------------------------------
+// FP8 weights
+//---------------------------------------------------
+
+bool aussie_fp8_quantize_rows(int format, const float* W, int nrows, int ncols, int ldw, yfp8_t* Q, int ldq, float scales[])
+{
+	if (W == NULL || Q == NULL || scales == NULL || nrows < 0 || ncols < 0 || ldw < ncols || ldq < ncols) {
+		yassert(W != NULL && Q != NULL && scales != NULL);
+		yassert(nrows >= 0 && ncols >= 0 && ldw >= ncols && ldq >= ncols);
+		return false;  // fail
+	}
+	float fmax = format == AUSSIE_FP8_E5M2 ? AUSSIE_FP8_E5M2_MAX : AUSSIE_FP8_E4M3_MAX;
+	for (int i = 0; i < nrows; i++) {
+		const float* row = &W[(long long)i * ldw];
+		yfp8_t* qrow = &Q[(long long)i * ldq];
+		float maxabs = 0.0f;
+		for (int j = 0; j < ncols; j++) if (fabsf(row[j]) > maxabs) maxabs = fabsf(row[j]);
+		float scale = maxabs > 0.0f ? maxabs / fmax : 1.0f;
+		for (int j = 0; j < ncols; j++) qrow[j] = aussie_float32_to_fp8(format, row[j] / scale);
+		for (int j = ncols; j < ldq; j++) qrow[j] = 0;
+		scales[i] = scale;
+	}
+	return true;
+}
+
+float aussie_vecdot_fp8_basic(int format, const yfp8_t w[], const float x[], int n)
+{
+	const float* table = aussie_fp8_table(format);
+	float sum = 0.0f;
+	for (int i = 0; i < n; i++) sum += table[w[i]] * x[i];
+	return sum;
+}
+
+#if AUSSIE_X86
+
+struct aussie_fp8_fp16_table {
+	alignas(64) unsigned char lo[128];  // Low byte of the FP16 bits of each magnitude (7 bits)
+	alignas(64) unsigned char hi[128];  // High byte (the sign is OR'ed in from the weight)
+};
+static aussie_fp8_fp16_table s_aussie_fp8_fp16_tables[2];
+
+static void aussie_fp8_fp16_tables_init()
+{
+	// Every E4M3 and E5M2 value (NaN too) is exactly an FP16 value
+	for (int format = AUSSIE_FP8_E4M3; format <= AUSSIE_FP8_E5M2; format++) {
+		const float* table = aussie_fp8_table(format);
+		for (int m = 0; m < 128; m++) {
+			yfp16_t h = aussie_float32_to_float16(table[m]);
+			s_aussie_fp8_fp16_tables[format].lo[m] = (unsigned char)(h & 0xff);
+			s_aussie_fp8_fp16_tables[format].hi[m] = (unsigned char)(h >> 8);
+		}
+	}
+}
+
+static unsigned char s_aussie_fp8_unpack_order[64];  // Byte order so that unpacklo/hi give weights 0..31, 32..63
+
+static void aussie_fp8_unpack_order_init()
+{
+	for (int k = 0; k < 4; k++) {  // 128-bit lanes
+		for (int j = 0; j < 8; j++) {
+			s_aussie_fp8_unpack_order[16 * k + j] = (unsigned char)(8 * k + j);
+			s_aussie_fp8_unpack_order[16 * k + 8 + j] = (unsigned char)(32 + 8 * k + j);
+		}
+	}
+}
+
+static bool aussie_fp8_fp16_tables_build()
+{
+	aussie_fp8_unpack_order_init();
+	aussie_fp8_fp16_tables_init();
+	return true;
+}
+
+static void aussie_fp8_fp16_tables_ensure()  // Build the AVX-512 tables (only once)
+{
+	static const bool s_done = aussie_fp8_fp16_tables_build();  // Thread-safe static init: concurrent first calls wait
+	(void)s_done;
+}
+
+AUSSIE_TARGET_AVX2 float aussie_vecdot_fp8_AVX2(int format, const yfp8_t w[], const float x[], int n)
+{
+	const float* table = aussie_fp8_table(format);
+	__m256 acc0 = _mm256_setzero_ps();
+	__m256 acc1 = _mm256_setzero_ps();
+	int i = 0;
+	for (; i + 16 <= n; i += 16) {
+		__m128i b = _mm_loadu_si128((const __m128i*)&w[i]);
+		__m256 w0 = _mm256_i32gather_ps(table, _mm256_cvtepu8_epi32(b), 4);
+		__m256 w1 = _mm256_i32gather_ps(table, _mm256_cvtepu8_epi32(_mm_srli_si128(b, 8)), 4);
+		acc0 = _mm256_fmadd_ps(w0, _mm256_loadu_ps(&x[i]), acc0);
+		acc1 = _mm256_fmadd_ps(w1, _mm256_loadu_ps(&x[i + 8]), acc1);
+	}
+	float sum = aussie_half_hsum_AVX2(_mm256_add_ps(acc0, acc1));
+	for (; i < n; i++) sum += table[w[i]] * x[i];  // Leftovers
+	return sum;
+}
+
+AUSSIE_TARGET_AVX512_VBMI float aussie_vecdot_fp8_AVX512_VBMI(int format, const yfp8_t w[], const float x[], int n)
+{
+	aussie_fp8_fp16_tables_ensure();  // Normally done by the GEMV setup
+	const aussie_fp8_fp16_table& t = s_aussie_fp8_fp16_tables[format == AUSSIE_FP8_E5M2 ? 1 : 0];
+	const __m512i lo0 = _mm512_load_si512(&t.lo[0]);  // The 128-entry tables live in 4 registers
+	const __m512i lo1 = _mm512_load_si512(&t.lo[64]);
+	const __m512i hi0 = _mm512_load_si512(&t.hi[0]);
+	const __m512i hi1 = _mm512_load_si512(&t.hi[64]);
+	const __m512i order = _mm512_loadu_si512(s_aussie_fp8_unpack_order);
+	const __m512i signmask = _mm512_set1_epi8((char)0x80);
+	__m512 acc0 = _mm512_setzero_ps();
+	__m512 acc1 = _mm512_setzero_ps();
+	__m512 acc2 = _mm512_setzero_ps();
+	__m512 acc3 = _mm512_setzero_ps();
+	int i = 0;
+	for (; i + 64 <= n; i += 64) {
+		__m512i b = _mm512_permutexvar_epi8(order, _mm512_loadu_si512(&w[i]));
+		__m512i lo = _mm512_permutex2var_epi8(lo0, b, lo1);  // Index bits 0-5 pick a byte, bit 6 the register
+		__m512i hi = _mm512_or_si512(_mm512_permutex2var_epi8(hi0, b, hi1), _mm512_and_si512(b, signmask));
+		__m512i h0 = _mm512_unpacklo_epi8(lo, hi);  // FP16 of weights 0..31
+		__m512i h1 = _mm512_unpackhi_epi8(lo, hi);  // FP16 of weights 32..63
+		acc0 = _mm512_fmadd_ps(_mm512_cvtph_ps(_mm512_castsi512_si256(h0)), _mm512_loadu_ps(&x[i]), acc0);
+		acc1 = _mm512_fmadd_ps(_mm512_cvtph_ps(_mm512_extracti64x4_epi64(h0, 1)), _mm512_loadu_ps(&x[i + 16]), acc1);
+		acc2 = _mm512_fmadd_ps(_mm512_cvtph_ps(_mm512_castsi512_si256(h1)), _mm512_loadu_ps(&x[i + 32]), acc2);
+		acc3 = _mm512_fmadd_ps(_mm512_cvtph_ps(_mm512_extracti64x4_epi64(h1, 1)), _mm512_loadu_ps(&x[i + 48]), acc3);
+	}
+	float sum = _mm512_reduce_add_ps(_mm512_add_ps(_mm512_add_ps(acc0, acc1), _mm512_add_ps(acc2, acc3)));
+	if (i < n) sum += aussie_vecdot_fp8_AVX2(format, &w[i], &x[i], n - i);  // Last 1..63
+	return sum;
+}
+
+#else
+
+float aussie_vecdot_fp8_AVX2(int format, const yfp8_t w[], const float x[], int n) { return aussie_vecdot_fp8_basic(format, w, x, n); }
+float aussie_vecdot_fp8_AVX512_VBMI(int format, const yfp8_t w[], const float x[], int n) { return aussie_vecdot_fp8_basic(format, w, x, n); }
+
+#endif //AUSSIE_X86
+
+static aussie_vecdot_fp8_fnptr aussie_fp8_kernel(int isa)
+{
+	aussie_precompute_fp8_tables();  // Before any threads use them
+#if AUSSIE_X86
+	aussie_fp8_fp16_tables_ensure();
+#endif //AUSSIE_X86
+	if (isa >= AUSSIE_ISA_AVX512 && aussie_cpu_has_avx512_vbmi()) return aussie_vecdot_fp8_AVX512_VBMI;
+	if (isa >= AUSSIE_ISA_AVX2 && aussie_cpu_has_avx2()) return aussie_vecdot_fp8_AVX2;
+	return aussie_vecdot_fp8_basic;
+}
+
+float aussie_vecdot_fp8(int format, const yfp8_t w[], const float x[], int n)
+{
+	aussie_dispatch_ensure();
+	return aussie_fp8_kernel(g_aussie_dispatch.isa)(format, w, x, n);
+}
+
+struct aussie_fp8_gemv_job {
+	int format;
+	const yfp8_t* W;
+	const float* scales;
+	int nrows, ncols, ldw;
+	const float* v;
+	float* vout;
+	int ntasks;
+	aussie_vecdot_fp8_fnptr vecdot;
+};
+
+static void aussie_fp8_gemv_rows(const aussie_fp8_gemv_job* job, int rowstart, int rowend)
+{
+	for (int i = rowstart; i < rowend; i++) {
+		float sum = job->vecdot(job->format, &job->W[(long long)i * job->ldw], job->v, job->ncols);
+		job->vout[i] = job->scales ? job->scales[i] * sum : sum;
+	}
+}
+
+static void aussie_fp8_gemv_task(int itask, void* arg)
+{
+	const aussie_fp8_gemv_job* job = (const aussie_fp8_gemv_job*)arg;
+	int rowstart = (int)(((long long)job->nrows * itask) / job->ntasks);
+	int rowend = (int)(((long long)job->nrows * (itask + 1)) / job->ntasks);
+	aussie_fp8_gemv_rows(job, rowstart, rowend);
+}
+
+static bool aussie_fp8_gemv_setup(aussie_fp8_gemv_job& job, int isa, int format, const yfp8_t* W, const float scales[], int nrows, int ncols, int ldw, const float* v, float* vout)
+{
+	if (W == NULL || v == NULL || vout == NULL || nrows < 0 || ncols < 0 || ldw < ncols) {
+		yassert(W != NULL && v != NULL && vout != NULL);
+		yassert(nrows >= 0 && ncols >= 0 && ldw >= ncols);
+		return false;  // fail
+	}
+	job.format = format;
+	job.W = W;
+	job.scales = scales;
+	job.nrows = nrows;
+	job.ncols = ncols;
+	job.ldw = ldw;
+	job.v = v;
+	job.vout = vout;
+	job.ntasks = 1;
+	job.vecdot = aussie_fp8_kernel(isa);
+	return true;
+}
+
+void aussie_gemv_fp8_isa(int isa, int format, const yfp8_t* W, const float scales[], int nrows, int ncols, int ldw, const float* v, float* vout)  // Force a kernel, one thread
+{
+	aussie_fp8_gemv_job job;
+	if (!aussie_fp8_gemv_setup(job, isa, format, W, scales, nrows, ncols, ldw, v, vout)) return;  // fail
+	aussie_fp8_gemv_rows(&job, 0, nrows);
+}
+
+void aussie_gemv_fp8(int format, const yfp8_t* W, const float scales[], int nrows, int ncols, int ldw, const float* v, float* vout)  // scales NULL = 1
+{
+	aussie_dispatch_ensure();
+	aussie_fp8_gemv_job job;
+	if (!aussie_fp8_gemv_setup(job, g_aussie_dispatch.isa, format, W, scales, nrows, ncols, ldw, v, vout)) return;  // fail
+	int nthreads = aussie_thread_count();
+	job.ntasks = nrows < nthreads ? nrows : nthreads;
+	if (job.ntasks <= 1) {
+		aussie_fp8_gemv_rows(&job, 0, nrows);
+		return;
+	}
+	aussie_parallel_run(job.ntasks, aussie_fp8_gemv_task, &job, AUSSIE_SCHEDULE_STATIC);
+}
+
+//---------------------------------------------------
+// Accuracy
+//---------------------------------------------------
+
+bool aussie_half_error(int format, const ymatrix W, const float v[], aussie_quant_error& err)  // Rounds all of W (AUSSIE_HALF_*)
+{
+	memset(&err, 0, sizeof(err));
+	int n = AUSSIE_MATRIX_ROWS;  // aussie_matmul_vector_basic_out1 is only for the full matrix
+	int ncols = AUSSIE_MATRIX_COLUMNS;
+	long long nw = (long long)n * ncols;
+	bool fp8 = format == AUSSIE_HALF_FP8_E4M3 || format == AUSSIE_HALF_FP8_E5M2;
+	int fp8format = format == AUSSIE_HALF_FP8_E5M2 ? AUSSIE_FP8_E5M2 : AUSSIE_FP8_E4M3;
+	yfp16_t* Wh = (yfp16_t*)malloc(nw * (fp8 ? sizeof(yfp8_t) : sizeof(yfp16_t)));
+	yfp8_t* W8 = (yfp8_t*)Wh;  // Same buffer
+	float* scales = (float*)malloc(n * sizeof(float));
+	float* row = (float*)malloc(ncols * sizeof(float));
+	float* vref = (float*)malloc(n * sizeof(float));
+	float* vout = (float*)malloc(n * sizeof(float));
+	if (!Wh || !scales || !row || !vref || !vout) {
+		yassert(Wh && scales && row && vref && vout);
+		free(Wh); free(scales); free(row); free(vref); free(vout);
+		return false;  // fail
+	}
+	if (fp8) aussie_fp8_quantize_rows(fp8format, &W[0][0], n, ncols, ncols, W8, ncols, scales);
+	double wsq = 0.0;
+	for (int i = 0; i < n; i++) {
+		yfp16_t* wrow = &Wh[(long long)i * ncols];
+		if (fp8) {
+			for (int j = 0; j < ncols; j++) row[j] = scales[i] * aussie_fp8_to_float32(fp8format, W8[(long long)i * ncols + j]);
+		}
+		else if (format == AUSSIE_HALF_BF16) {
+			aussie_float32_to_bfloat16_array(W[i], wrow, ncols);
+			aussie_bfloat16_to_float32_array(wrow, row, ncols);
+		}
+		else {
+			aussie_float32_to_float16_array(W[i], wrow, ncols);
+			aussie_float16_to_float32_array(wrow, row, ncols);
+		}
+		for (int j = 0; j < ncols; j++) {
+			float e = fabsf(row[j] - W[i][j]);
+			if (!(e <= err.weight_max)) err.weight_max = e;  // FP16 overflow to Inf too
+			wsq += (double)e * e;
+		}
+	}
+	err.weight_rms = (float)sqrt(wsq / (double)nw);
+
+	aussie_matmul_vector_basic_out1(W, v, n, vref);  // FP32 reference
+	if (fp8) aussie_gemv_fp8(fp8format, W8, scales, n, ncols, ncols, v, vout);
+	else if (format == AUSSIE_HALF_BF16) aussie_gemv_bf16(Wh, n, ncols, ncols, v, vout);
+	else aussie_gemv_fp16(Wh, n, ncols, ncols, v, vout);
+	double osq = 0.0, refsq = 0.0;
+	for (int i = 0; i < n; i++) {
+		float e = fabsf(vout[i] - vref[i]);
+		if (!(e <= err.output_max)) err.output_max = e;  // NaN too
+		osq += (double)e * e;
+		refsq += (double)vref[i] * vref[i];
+	}
+	err.output_rms = (float)sqrt(osq / n);
+	err.output_rel = refsq > 0.0 ? (float)sqrt(osq / refsq) : 0.0f;
+	free(Wh); free(scales); free(row); free(vref); free(vout);
+	return true;
+}
+
+//---------------------------------------------------
+// Unit tests
+//---------------------------------------------------
+
+static float aussie_half_test_random(unsigned int& seed)
+{
+	seed = seed * 1103515245u + 12345u;
+	return (float)((seed >> 8) % 20001) / 10000.0f - 1.0f;  // [-1,1]
+}
+
+static void aussie_half_test_vecdot(int format, int n, int offset)
+{
+	// Every kernel against a double-precision sum of the widened weights (exact inputs)
+	yfp16_t* w = (yfp16_t*)malloc((n + offset + 1) * sizeof(yfp16_t));
+	float* x = (float*)malloc((n + offset + 1) * sizeof(float));
+	if (!w || !x) {
+		yassert(w && x);
+		free(w); free(x);
+		return;  // fail
+	}
+	unsigned int seed = 77u + n;
+	double dsum = 0.0, dabs = 0.0;
+	for (int i = 0; i < n; i++) {
+		float f = aussie_half_test_random(seed) * 4.0f;
+		w[offset + i] = format == AUSSIE_HALF_BF16 ? aussie_float32_to_bfloat16(f) : aussie_float32_to_float16(f);
+		x[offset + i] = aussie_half_test_random(seed);
+		float wf = format == AUSSIE_HALF_BF16 ? aussie_bfloat16_to_float32(w[offset + i]) : aussie_float16_to_float32(w[offset + i]);
+		dsum += (double)wf * x[offset + i];
+		dabs += fabs((double)wf * x[offset + i]);
+	}
+	w[offset + n] = 0x7e00u;  // NaN just past the end: must not be read
+	x[offset + n] = NAN;
+	int isas[] = { AUSSIE_ISA_SCALAR, AUSSIE_ISA_AVX2, AUSSIE_ISA_AVX512 };
+	for (int k = 0; k < 3; k++) {
+		if (isas[k] == AUSSIE_ISA_AVX2 && !aussie_cpu_has_avx2()) continue;
+		if (isas[k] == AUSSIE_ISA_AVX512 && !aussie_cpu_has_avx512()) continue;
+		float sum = aussie_half_kernel(isas[k], format)(&w[offset], &x[offset], n);
+		float err = (float)fabs(sum - dsum);
+		float tolerance = 1.2e-7f * (n + 1) * (float)dabs + 1e-6f;  // Float rounding bound for n additions
+		ytest(err <= tolerance);
+		if (!(err <= tolerance)) {
+			fprintf(stderr, "ERROR: %s: format %d isa %d n=%d: %g versus %g\n", __func__, format, isas[k], n, sum, dsum);
+		}
+	}
+	free(w); free(x);
+}
+
+static void aussie_half_test_gemv(int format, int nrows, int ncols)
+{
+	int ldw = ncols + 3;
+	yfp16_t* W = (yfp16_t*)malloc(((size_t)nrows * ldw + 1) * sizeof(yfp16_t));
+	float* v = (float*)malloc((ncols + 1) * sizeof(float));
+	float* vout = (float*)malloc((nrows + 1) * sizeof(float));
+	float* vref = (float*)malloc((nrows + 1) * sizeof(float));
+	if (!W || !v || !vout || !vref) {
+		yassert(W && v && vout && vref);
+		free(W); free(v); free(vout); free(vref);
+		return;  // fail
+	}
+	unsigned int seed = 5u;
+	for (long long i = 0; i < (long long)nrows * ldw; i++) {
+		float f = (i % ldw) < ncols ? aussie_half_test_random(seed) : NAN;  // Padding must not be read
+		W[i] = format == AUSSIE_HALF_BF16 ? aussie_float32_to_bfloat16(f) : aussie_float32_to_float16(f);
+	}
+	for (int j = 0; j < ncols; j++) v[j] = aussie_half_test_random(seed);
+	vout[nrows] = vref[nrows] = -999.0f;
+
+	aussie_gemv_half_isa(AUSSIE_ISA_SCALAR, format, W, nrows, ncols, ldw, v, vref);
+	if (format == AUSSIE_HALF_BF16) aussie_gemv_bf16(W, nrows, ncols, ldw, v, vout);
+	else aussie_gemv_fp16(W, nrows, ncols, ldw, v, vout);
+	float maxerr = 0.0f;
+	for (int i = 0; i < nrows; i++) {
+		float err = fabsf(vout[i] - vref[i]);
+		if (!(err <= maxerr)) maxerr = err;
+	}
+	ytest(maxerr <= 1e-5f * (ncols + 1));  // Only the summation order differs
+	ytestf(vout[nrows], -999.0f);
+	ytestf(vref[nrows], -999.0f);
+	free(W); free(v); free(vout); free(vref);
+}
+
+static void aussie_half_test_fp8(int format, int nrows, int ncols)
+{
+	// Every FP8 kernel against a double-precision sum of the decoded weights, then the GEMV
+	int ldw = ncols + 5;
+	float* W = (float*)malloc(((size_t)nrows * ncols + 1) * sizeof(float));
+	yfp8_t* Q = (yfp8_t*)malloc((size_t)nrows * ldw + 1);
+	float* scales = (float*)malloc((nrows + 1) * sizeof(float));
+	float* v = (float*)malloc((ncols + 1) * sizeof(float));
+	float* vout = (float*)malloc((nrows + 1) * sizeof(float));
+	if (!W || !Q || !scales || !v || !vout) {
+		yassert(W && Q && scales && v && vout);
+		free(W); free(Q); free(scales); free(v); free(vout);
+		return;  // fail
+	}
+	unsigned int seed = 11u + ncols;
+	for (long long i = 0; i < (long long)nrows * ncols; i++) W[i] = aussie_half_test_random(seed) * 0.05f;
+	for (int j = 0; j < ncols; j++) v[j] = aussie_half_test_random(seed);
+	ytest(aussie_fp8_quantize_rows(format, W, nrows, ncols, ncols, Q, ldw, scales));
+	for (int i = 0; i < nrows; i++) for (int j = ncols; j < ldw; j++) Q[(long long)i * ldw + j] = 0x7f;  // NaN padding: must not be read
+	vout[nrows] = -999.0f;
+
+	const float* table = aussie_fp8_table(format);
+	int isas[] = { AUSSIE_ISA_SCALAR, AUSSIE_ISA_AVX2, AUSSIE_ISA_AVX512 };
+	int nbad = 0;
+	for (int k = 0; k < 3; k++) {
+		if (isas[k] == AUSSIE_ISA_AVX2 && !aussie_cpu_has_avx2()) continue;
+		if (isas[k] == AUSSIE_ISA_AVX512 && !aussie_cpu_has_avx512()) continue;
+		aussie_gemv_fp8_isa(isas[k], format, Q, scales, nrows, ncols, ldw, v, vout);
+		for (int i = 0; i < nrows; i++) {
+			double dsum = 0.0, dabs = 0.0;
+			for (int j = 0; j < ncols; j++) {
+				double t = (double)table[Q[(long long)i * ldw + j]] * v[j];
+				dsum += t;
+				dabs += fabs(t);
+			}
+			double err = fabs((double)vout[i] - scales[i] * dsum);
+			if (!(err <= 1.2e-7 * (ncols + 2) * scales[i] * dabs + 1e-6)) nbad++;
+		}
+	}
+	ytesti(nbad, 0);
+	ytestf(vout[nrows], -999.0f);
+
+	// Dispatched and parallel: close to the FP32 GEMV (3 or 2 mantissa bits)
+	aussie_gemv_fp8(format, Q, scales, nrows, ncols, ldw, v, vout);
+	float maxerr = 0.0f, maxref = 0.0f;
+	for (int i = 0; i < nrows; i++) {
+		float sum = 0.0f, sumabs = 0.0f;
+		for (int j = 0; j < ncols; j++) {
+			sum += W[(long long)i * ncols + j] * v[j];
+			sumabs += fabsf(W[(long long)i * ncols + j] * v[j]);
+		}
+		float err = fabsf(vout[i] - sum);
+		if (!(err <= maxerr)) maxerr = err;
+		if (sumabs > maxref) maxref = sumabs;
+	}
+	float bound = format == AUSSIE_FP8_E5M2 ? 0.125f : 0.0625f;  // Worst case: every weight off by half a step
+	ytest(maxerr <= bound * maxref + 1e-6f);
+	ytestf(vout[nrows], -999.0f);
+	free(W); free(Q); free(scales); free(v); free(vout);
+}
+
+static void aussie_half_test_error()
+{
+	// Versus FP32: FP16 keeps 11 significant bits, BF16 keeps 8
+	ymatrix* pW = (ymatrix*)malloc(sizeof(ymatrix));
+	float* v = (float*)malloc(AUSSIE_MATRIX_ROWS * sizeof(float));
+	if (!pW || !v) {
+		yassert(pW && v);
+		free(pW); free(v);
+		return;  // fail
+	}
+	unsigned int seed = 3u;
+	for (int i = 0; i < AUSSIE_MATRIX_ROWS; i++) {
+		for (int j = 0; j < AUSSIE_MATRIX_COLUMNS; j++) (*pW)[i][j] = aussie_half_test_random(seed) * 0.1f;
+		v[i] = aussie_half_test_random(seed);
+	}
+	aussie_quant_error err16, errbf;
+	ytest(aussie_half_error(AUSSIE_HALF_FP16, *pW, v, err16));
+	ytest(aussie_half_error(AUSSIE_HALF_BF16, *pW, v, errbf));
+	ytest(err16.weight_max <= 0.1f / 2048.0f);   // Half an FP16 step below 0.1
+	ytest(errbf.weight_max <= 0.1f / 256.0f);    // Half a BF16 step
+	ytest(err16.output_rel < 1e-3f);
+	ytest(errbf.output_rel < 1e-2f);
+	ytest(err16.output_rel < errbf.output_rel);
+	if (!(err16.output_rel < 1e-3f) || !(errbf.output_rel < 1e-2f)) {
+		aussie_quant_error_print(stderr, "ERROR: FP16", err16);
+		aussie_quant_error_print(stderr, "ERROR: BF16", errbf);
+	}
+	aussie_quant_error err43, err52;
+	ytest(aussie_half_error(AUSSIE_HALF_FP8_E4M3, *pW, v, err43));
+	ytest(aussie_half_error(AUSSIE_HALF_FP8_E5M2, *pW, v, err52));
+	ytest(err43.output_rel < 0.05f);
+	ytest(err52.output_rel < 0.1f);
+	ytest(errbf.output_rel < err43.output_rel && err43.output_rel < err52.output_rel);
+	if (!(err43.output_rel < 0.05f) || !(err52.output_rel < 0.1f)) {
+		aussie_quant_error_print(stderr, "ERROR: FP8 E4M3", err43);
+		aussie_quant_error_print(stderr, "ERROR: FP8 E5M2", err52);
+	}
+	free(pW); free(v);
+}
+
+void aussie_half_unit_tests()
+{
+	fprintf(stderr, "INFO: %s: Running unit tests\n", __func__);
+	for (int format = AUSSIE_HALF_FP16; format <= AUSSIE_HALF_BF16; format++) {
+		for (int n = 0; n <= 70; n++) {
+			aussie_half_test_vecdot(format, n, n % 3);
+		}
+		aussie_half_test_vecdot(format, 4099, 1);
+		aussie_half_test_gemv(format, 0, 16);
+		aussie_half_test_gemv(format, 1, 1);
+		aussie_half_test_gemv(format, 7, 37);
+		aussie_half_test_gemv(format, 33, 256);
+		aussie_half_test_gemv(format, 100, 1000);
+	}
+	for (int format = AUSSIE_FP8_E4M3; format <= AUSSIE_FP8_E5M2; format++) {
+		for (int ncols = 0; ncols <= 130; ncols += 13) aussie_half_test_fp8(format, 3, ncols);
+		aussie_half_test_fp8(format, 1, 64);
+		aussie_half_test_fp8(format, 37, 1000);
+	}
+	aussie_half_test_error();
+}
+
+//---------------------------------------------------
+//---------------------------------------------------
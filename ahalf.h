@@ -0,0 +1,79 @@
+//---------------------------------------------------
+// ahalf.h -- Mixed-precision FP16/BF16/FP8 weight kernels -- Aussie AI Base Library
+// Created Oct 17th 2026
+// Copyright (c) 2023 Aussie AI Labs Pty Ltd
+//---------------------------------------------------
+
+#ifndef AUSSIE_YHALF_INCLUDE_HEADER_H
+#define AUSSIE_YHALF_INCLUDE_HEADER_H
+
+//---------------------------------------------------
+// Mixed precision: 16-bit weights (FP16 or BF16), FP32 activations, FP32 accumulation
+// ... weights are widened to FP32 in registers (F16C vcvtph2ps for FP16, a 16-bit shift for BF16)
+//     and never stored as FP32, so a GEMV reads half the bytes of the FP32 version
+// ... needs afloat.h first (yfp16_t, ybf16_t)
+//---------------------------------------------------
+
+#define AUSSIE_HALF_FP16  0   // IEEE half: 5 exponent bits, 10 mantissa bits
+#define AUSSIE_HALF_BF16  1   // Brain float: 8 exponent bits, 7 mantissa bits
+#define AUSSIE_HALF_FP8_E4M3  2   // FP8 weights with per-row scales (aussie_half_error only)
+#define AUSSIE_HALF_FP8_E5M2  3
+
+typedef float (*aussie_vecdot_half_fnptr)(const yfp16_t w[], const float x[], int n);  // ybf16_t is the same type
+
+float aussie_vecdot_fp16(const yfp16_t w[], const float x[], int n);  // Dispatched
+float aussie_vecdot_bf16(const ybf16_t w[], const float x[], int n);  // Dispatched
+
+float aussie_vecdot_fp16_basic(const yfp16_t w[], const float x[], int n);
+float aussie_vecdot_fp16_F16C(const yfp16_t w[], const float x[], int n);
+float aussie_vecdot_fp16_AVX512(const yfp16_t w[], const float x[], int n);
+float aussie_vecdot_bf16_basic(const ybf16_t w[], const float x[], int n);
+float aussie_vecdot_bf16_AVX2(const ybf16_t w[], const float x[], int n);
+float aussie_vecdot_bf16_AVX512(const ybf16_t w[], const float x[], int n);
+
+//---------------------------------------------------
+// GEMV: vout = W * v, W is nrows x ncols 16-bit weights (row-major, stride ldw)
+// ... rows split across the thread pool (static blocks, as aussie_gemv_parallel)
+//---------------------------------------------------
+
+void aussie_gemv_fp16(const yfp16_t* W, int nrows, int ncols, int ldw, const float* v, float* vout);
+void aussie_gemv_bf16(const ybf16_t* W, int nrows, int ncols, int ldw, const float* v, float* vout);
+void aussie_gemv_half_isa(int isa, int format, const yfp16_t* W, int nrows, int ncols, int ldw, const float* v, float* vout);  // Force a kernel, one thread
+
+//---------------------------------------------------
+// FP8 weights (afloat.h AUSSIE_FP8_E4M3 or AUSSIE_FP8_E5M2) with one float scale per row:
+// w = scale * fp8, the scale maps the row's largest weight to the format's max
+// ... a quarter of the FP32 weight bytes; decoded to FP32 in registers, FP32 accumulation
+// ... AVX-512 VBMI: table lookup by byte shuffles (two vpermi2b give the FP16 bits of 64 weights,
+//     then vcvtph2ps); AVX-2: gathers from the 256-entry decode table (aprecompute.h)
+//---------------------------------------------------
+
+bool aussie_fp8_quantize_rows(int format, const float* W, int nrows, int ncols, int ldw, yfp8_t* Q, int ldq, float scales[]);
+
+typedef float (*aussie_vecdot_fp8_fnptr)(int format, const yfp8_t w[], const float x[], int n);
+
+float aussie_vecdot_fp8(int format, const yfp8_t w[], const float x[], int n);  // Dispatched
+float aussie_vecdot_fp8_basic(int format, const yfp8_t w[], const float x[], int n);
+float aussie_vecdot_fp8_AVX2(int format, const yfp8_t w[], const float x[], int n);
+float aussie_vecdot_fp8_AVX512_VBMI(int format, const yfp8_t w[], const float x[], int n);
+
+void aussie_gemv_fp8(int format, const yfp8_t* W, const float scales[], int nrows, int ncols, int ldw, const float* v, float* vout);  // scales NULL = 1
+void aussie_gemv_fp8_isa(int isa, int format, const yfp8_t* W, const float scales[], int nrows, int ncols, int ldw, const float* v, float* vout);  // Force a kernel, one thread
+
+//---------------------------------------------------
+// Accuracy versus the FP32 GEMV (aussie_matmul_vector_basic_out1)
+// ... needs amatmul.h (ymatrix) and aquant.h (aussie_quant_error) first
+//---------------------------------------------------
+
+bool aussie_half_error(int format, const ymatrix W, const float v[], aussie_quant_error& err);  // Rounds all of W (AUSSIE_HALF_*)
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+void aussie_half_unit_tests();
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+
+#endif //AUSSIE_YHALF_INCLUDE_HEADER_H
@@ -0,0 +1,516 @@
+// alut.cpp -- Interpolated lookup tables for activation functions -- Aussie AI Base Library
+// Created Oct 17th 2026
+// Copyright (c) 2023 Aussie AI Labs Pty Ltd
+//---------------------------------------------------
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <math.h>
+#include <mutex>
+#include <atomic>
+
+#include "aport.h"
+
+#if AUSSIE_X86
+#include <immintrin.h>  // AVX-2, AVX-512 gathers
+#endif //AUSSIE_X86
+#if !LINUX
+#include <malloc.h>  // _aligned_malloc
+#endif
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+#include "aussieai.h"
+#include "aassert.h"
+#include "atest.h"
+#include "adispatch.h"
+#include "afloat.h"
+#include "aprecompute.h"
+#include "aactivation.h"
+
+#include "alut.h"  // self-include
+
+//---------------------------------------------------
+// The functions: range and the asymptotes outside it
+//---------------------------------------------------
+
+static float aussie_lut_tanh_basic(float x) { return tanhf(x); }
+static float aussie_lut_exp_basic(float x) { return expf(x); }
+
+struct aussie_lut_function {
+	const char* name;
+	float (*fnptr)(float);
+	float xmin, xmax;
+	float left_slope, left_icpt, right_slope, right_icpt;
+};
+
+static const aussie_lut_function s_aussie_lut_functions[AUSSIE_LUT_NFUNCS] = {
+	{ "GELU", aussie_GELU_basic, -8.0f, 8.0f, 0.0f, 0.0f, 1.0f, 0.0f },  // |GELU(x) - asymptote| < 1e-14 outside
+	{ "SiLU", aussie_SiLU_basic, -20.0f, 20.0f, 0.0f, 0.0f, 1.0f, 0.0f },  // < 5e-8 outside
+	{ "sigmoid", aussie_sigmoid, -18.0f, 18.0f, 0.0f, 0.0f, 0.0f, 1.0f },  // < 2e-8 outside
+	{ "tanh", aussie_lut_tanh_basic, -10.0f, 10.0f, 0.0f, -1.0f, 0.0f, 1.0f },  // < 5e-9 outside
+	{ "expf", aussie_lut_exp_basic, -0.01f, 0.70f, 0.0f, 0.0f, 0.0f, 0.0f },  // e^r for r in [0,ln2] (with rounding slack)
+};
+
+// expf range reduction: x = k*ln2 + r, with ln2 split so k*LN2_HI is exact
+#define AUSSIE_LUT_LOG2E   1.44269504088896341f
+#define AUSSIE_LUT_LN2_HI  0.693145751953125f
+#define AUSSIE_LUT_LN2_LO  1.42860682030941723e-6f
+#define AUSSIE_LUT_EXP_LO  -87.3365448f   // ln(FLT_MIN): below this, 0 (no denormals)
+#define AUSSIE_LUT_EXP_HI  88.7228317f    // ln(FLT_MAX): above this, +inf
+
+//---------------------------------------------------
+// Building
+//---------------------------------------------------
+
+static bool aussie_lut_build(aussie_lut& lut, float (*fnptr)(float), float xmin, float xmax, int nintervals, int order)
+{
+	memset(&lut, 0, sizeof(lut));
+	if (nintervals < 1 || nintervals > AUSSIE_LUT_MAX_INTERVALS || !(xmax > xmin) || fnptr == NULL
+		|| (order != AUSSIE_LUT_LINEAR && order != AUSSIE_LUT_QUADRATIC)) {
+		yassert(nintervals >= 1 && nintervals <= AUSSIE_LUT_MAX_INTERVALS);
+		yassert(xmax > xmin && fnptr != NULL);
+		yassert(order == AUSSIE_LUT_LINEAR || order == AUSSIE_LUT_QUADRATIC);
+		return false;  // fail
+	}
+	int n = nintervals;
+	size_t bytes = (size_t)(n + 1) * sizeof(float);  // One more: the end point (vector gathers never go past it)
+	lut.c0 = (float*)AUSSIE_ALIGNED_MALLOC(bytes, 64);
+	lut.c1 = (float*)AUSSIE_ALIGNED_MALLOC(bytes, 64);
+	lut.c2 = (float*)AUSSIE_ALIGNED_MALLOC(bytes, 64);
+	int npts = order == AUSSIE_LUT_QUADRATIC ? 2 * n + 1 : n + 1;  // Quadratic: midpoints too
+	float* y = (float*)malloc(npts * sizeof(float));
+	if (!lut.c0 || !lut.c1 || !lut.c2 || !y) {
+		yassert(lut.c0 && lut.c1 && lut.c2 && y);
+		free(y);
+		aussie_lut_free(lut);
+		return false;  // fail
+	}
+	aussie_precompute_table_FP32_range(y, npts, xmin, xmax, fnptr);
+	for (int i = 0; i < n; i++) {
+		if (order == AUSSIE_LUT_LINEAR) {
+			lut.c0[i] = y[i];
+			lut.c1[i] = (float)((double)y[i + 1] - (double)y[i]);
+			lut.c2[i] = 0.0f;
+		}
+		else {
+			// The parabola through the ends and the midpoint of the interval (t = 0, 1/2, 1)
+			double y0 = y[2 * i], ym = y[2 * i + 1], y1 = y[2 * i + 2];
+			lut.c0[i] = (float)y0;
+			lut.c1[i] = (float)(-3.0 * y0 + 4.0 * ym - y1);
+			lut.c2[i] = (float)(2.0 * y0 - 4.0 * ym + 2.0 * y1);
+		}
+	}
+	lut.c0[n] = y[npts - 1];
+	lut.c1[n] = 0.0f;
+	lut.c2[n] = 0.0f;
+	free(y);
+
+	lut.fn = AUSSIE_LUT_CUSTOM;
+	lut.order = order;
+	lut.n = n;
+	lut.xmin = xmin;
+	lut.xmax = xmax;
+	lut.scale = (float)((double)n / ((double)xmax - (double)xmin));
+	lut.fnptr = fnptr;
+	return true;
+}
+
+bool aussie_lut_init(aussie_lut& lut, int fn, int nintervals /*= AUSSIE_LUT_DEFAULT_INTERVALS*/, int order /*= AUSSIE_LUT_QUADRATIC*/)
+{
+	if (fn < 0 || fn >= AUSSIE_LUT_NFUNCS) {
+		yassert(fn >= 0 && fn < AUSSIE_LUT_NFUNCS);
+		memset(&lut, 0, sizeof(lut));
+		return false;  // fail
+	}
+	const aussie_lut_function& f = s_aussie_lut_functions[fn];
+	if (!aussie_lut_build(lut, f.fnptr, f.xmin, f.xmax, nintervals, order)) return false;  // fail
+	lut.fn = fn;
+	lut.left_slope = f.left_slope;
+	lut.left_icpt = f.left_icpt;
+	lut.right_slope = f.right_slope;
+	lut.right_icpt = f.right_icpt;
+	return true;
+}
+
+bool aussie_lut_init_custom(aussie_lut& lut, float (*fnptr)(float), float xmin, float xmax, int nintervals, int order)  // Constant outside the range
+{
+	if (!aussie_lut_build(lut, fnptr, xmin, xmax, nintervals, order)) return false;  // fail
+	lut.left_icpt = fnptr(xmin);
+	lut.right_icpt = fnptr(xmax);
+	return true;
+}
+
+void aussie_lut_free(aussie_lut& lut)
+{
+	if (lut.c0) AUSSIE_ALIGNED_FREE(lut.c0);
+	if (lut.c1) AUSSIE_ALIGNED_FREE(lut.c1);
+	if (lut.c2) AUSSIE_ALIGNED_FREE(lut.c2);
+	memset(&lut, 0, sizeof(lut));
+}
+
+size_t aussie_lut_bytes(const aussie_lut& lut)  // Coefficient table size
+{
+	if (lut.c0 == NULL) return 0;
+	int ncoeffs = lut.order == AUSSIE_LUT_QUADRATIC ? 3 : 2;  // c2 unused (zero) when linear
+	return (size_t)(lut.n + 1) * ncoeffs * sizeof(float);
+}
+
+static aussie_lut s_aussie_lut_defaults[AUSSIE_LUT_NFUNCS];
+static std::atomic<const aussie_lut*> s_aussie_lut_ready[AUSSIE_LUT_NFUNCS];  // Published (release) once fully built
+static std::mutex s_aussie_lut_mutex;  // Guards building the defaults
+
+const aussie_lut* aussie_lut_get(int fn)  // Shared default tables (built on first use)
+{
+	if (fn < 0 || fn >= AUSSIE_LUT_NFUNCS) {
+		yassert(fn >= 0 && fn < AUSSIE_LUT_NFUNCS);
+		return NULL;  // fail
+	}
+	const aussie_lut* ready = s_aussie_lut_ready[fn].load(std::memory_order_acquire);
+	if (ready != NULL) return ready;  // Every field written before it was published
+	std::lock_guard<std::mutex> guard(s_aussie_lut_mutex);
+	ready = s_aussie_lut_ready[fn].load(std::memory_order_relaxed);
+	if (ready == NULL) {
+		if (!aussie_lut_init(s_aussie_lut_defaults[fn], fn)) return NULL;  // fail
+		ready = &s_aussie_lut_defaults[fn];
+		s_aussie_lut_ready[fn].store(ready, std::memory_order_release);
+	}
+	return ready;
+}
+
+//---------------------------------------------------
+// Scalar evaluation
+//---------------------------------------------------
+
+static inline float aussie_lut_eval_range(const aussie_lut& lut, float x)
+{
+	float u = (x - lut.xmin) * lut.scale;
+	if (!(u >= 0.0f)) return lut.left_slope == 0.0f ? lut.left_icpt : lut.left_slope * x + lut.left_icpt;
+	if (u >= (float)lut.n) return lut.right_slope == 0.0f ? lut.right_icpt : lut.right_slope * x + lut.right_icpt;
+	int i = (int)u;
+	float t = u - (float)i;
+	return lut.c0[i] + t * (lut.c1[i] + t * lut.c2[i]);
+}
+
+static inline float aussie_lut_eval_exp(const aussie_lut& lut, float x)
+{
+	if (x < AUSSIE_LUT_EXP_LO) return 0.0f;
+	if (x > AUSSIE_LUT_EXP_HI) return INFINITY;
+	float k = floorf(x * AUSSIE_LUT_LOG2E);  // -126..127
+	float r = (x - k * AUSSIE_LUT_LN2_HI) - k * AUSSIE_LUT_LN2_LO;
+	float p = aussie_lut_eval_range(lut, r);  // e^r in [1,2]
+	unsigned int u = AUSSIE_FLOAT_TO_UINT(p) + ((unsigned int)(int)k << 23);  // Times 2^k
+	return AUSSIE_UINT_TO_FLOAT(u);
+}
+
+float aussie_lut_eval(const aussie_lut& lut, float x)
+{
+	if (x != x) return x;  // NaN
+	if (lut.fn == AUSSIE_LUT_EXP) return aussie_lut_eval_exp(lut, x);
+	return aussie_lut_eval_range(lut, x);
+}
+
+void aussie_lut_apply_basic(const aussie_lut& lut, const float in[], float out[], int n)
+{
+	for (int i = 0; i < n; i++) out[i] = aussie_lut_eval(lut, in[i]);
+}
+
+//---------------------------------------------------
+// SIMD: gather the coefficients of 8 or 16 intervals at once
+//---------------------------------------------------
+
+#if AUSSIE_X86
+
+static inline AUSSIE_TARGET_AVX2 __m256 aussie_lut_tail_AVX2(float slope, float icpt, __m256 x)
+{
+	if (slope == 0.0f) return _mm256_set1_ps(icpt);  // Not 0 * inf
+	return _mm256_fmadd_ps(_mm256_set1_ps(slope), x, _mm256_set1_ps(icpt));
+}
+
+static inline AUSSIE_TARGET_AVX2 __m256 aussie_lut_range_AVX2(const aussie_lut& lut, __m256 x)
+{
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 nf = _mm256_set1_ps((float)lut.n);
+	__m256 u = _mm256_mul_ps(_mm256_sub_ps(x, _mm256_set1_ps(lut.xmin)), _mm256_set1_ps(lut.scale));
+	__m256 left = _mm256_cmp_ps(u, zero, _CMP_NGE_UQ);  // Below, or NaN
+	__m256 right = _mm256_cmp_ps(u, nf, _CMP_GE_OQ);
+	__m256 uc = _mm256_min_ps(_mm256_max_ps(u, zero), nf);  // NaN becomes 0 (blended away)
+	__m256i i = _mm256_min_epi32(_mm256_cvttps_epi32(uc), _mm256_set1_epi32(lut.n));
+	__m256 t = _mm256_sub_ps(uc, _mm256_cvtepi32_ps(i));
+	__m256 y = _mm256_fmadd_ps(t, _mm256_i32gather_ps(lut.c1, i, 4), _mm256_i32gather_ps(lut.c0, i, 4));
+	if (lut.order == AUSSIE_LUT_QUADRATIC) {
+		__m256 c2 = _mm256_i32gather_ps(lut.c2, i, 4);
+		y = _mm256_fmadd_ps(_mm256_mul_ps(t, t), c2, y);
+	}
+	y = _mm256_blendv_ps(y, aussie_lut_tail_AVX2(lut.left_slope, lut.left_icpt, x), left);
+	return _mm256_blendv_ps(y, aussie_lut_tail_AVX2(lut.right_slope, lut.right_icpt, x), right);
+}
+
+static inline AUSSIE_TARGET_AVX2 __m256 aussie_lut_eval_AVX2(const aussie_lut& lut, __m256 x)
+{
+	__m256 y;
+	if (lut.fn == AUSSIE_LUT_EXP) {
+		const __m256 lo = _mm256_set1_ps(AUSSIE_LUT_EXP_LO), hi = _mm256_set1_ps(AUSSIE_LUT_EXP_HI);
+		__m256 xc = _mm256_min_ps(_mm256_max_ps(x, lo), hi);
+		__m256 k = _mm256_floor_ps(_mm256_mul_ps(xc, _mm256_set1_ps(AUSSIE_LUT_LOG2E)));
+		__m256 r = _mm256_fnmadd_ps(k, _mm256_set1_ps(AUSSIE_LUT_LN2_HI), xc);
+		r = _mm256_fnmadd_ps(k, _mm256_set1_ps(AUSSIE_LUT_LN2_LO), r);
+		__m256 p = aussie_lut_range_AVX2(lut, r);
+		__m256i e = _mm256_slli_epi32(_mm256_cvtps_epi32(k), 23);
+		y = _mm256_castsi256_ps(_mm256_add_epi32(_mm256_castps_si256(p), e));
+		y = _mm256_blendv_ps(y, _mm256_setzero_ps(), _mm256_cmp_ps(x, lo, _CMP_LT_OQ));
+		y = _mm256_blendv_ps(y, _mm256_set1_ps(INFINITY), _mm256_cmp_ps(x, hi, _CMP_GT_OQ));
+	}
+	else {
+		y = aussie_lut_range_AVX2(lut, x);
+	}
+	return _mm256_blendv_ps(y, x, _mm256_cmp_ps(x, x, _CMP_UNORD_Q));  // NaN in, NaN out
+}
+
+AUSSIE_TARGET_AVX2 void aussie_lut_apply_AVX2(const aussie_lut& lut, const float in[], float out[], int n)
+{
+	int i = 0;
+	for (; i + 8 <= n; i += 8) {
+		_mm256_storeu_ps(&out[i], aussie_lut_eval_AVX2(lut, _mm256_loadu_ps(&in[i])));
+	}
+	for (; i < n; i++) out[i] = aussie_lut_eval(lut, in[i]);
+}
+
+static inline AUSSIE_TARGET_AVX512 __m512 aussie_lut_tail_AVX512(float slope, float icpt, __m512 x)
+{
+	if (slope == 0.0f) return _mm512_set1_ps(icpt);  // Not 0 * inf
+	return _mm512_fmadd_ps(_mm512_set1_ps(slope), x, _mm512_set1_ps(icpt));
+}
+
+static inline AUSSIE_TARGET_AVX512 __m512 aussie_lut_range_AVX512(const aussie_lut& lut, __m512 x)
+{
+	const __m512 zero = _mm512_setzero_ps();
+	const __m512 nf = _mm512_set1_ps((float)lut.n);
+	__m512 u = _mm512_mul_ps(_mm512_sub_ps(x, _mm512_set1_ps(lut.xmin)), _mm512_set1_ps(lut.scale));
+	__mmask16 left = _mm512_cmp_ps_mask(u, zero, _CMP_NGE_UQ);  // Below, or NaN
+	__mmask16 right = _mm512_cmp_ps_mask(u, nf, _CMP_GE_OQ);
+	__m512 uc = _mm512_min_ps(_mm512_max_ps(u, zero), nf);  // NaN becomes 0 (blended away)
+	__m512i i = _mm512_min_epi32(_mm512_cvttps_epi32(uc), _mm512_set1_epi32(lut.n));
+	__m512 t = _mm512_sub_ps(uc, _mm512_cvtepi32_ps(i));
+	__m512 y = _mm512_fmadd_ps(t, _mm512_i32gather_ps(i, lut.c1, 4), _mm512_i32gather_ps(i, lut.c0, 4));
+	if (lut.order == AUSSIE_LUT_QUADRATIC) {
+		__m512 c2 = _mm512_i32gather_ps(i, lut.c2, 4);
+		y = _mm512_fmadd_ps(_mm512_mul_ps(t, t), c2, y);
+	}
+	y = _mm512_mask_blend_ps(left, y, aussie_lut_tail_AVX512(lut.left_slope, lut.left_icpt, x));
+	return _mm512_mask_blend_ps(right, y, aussie_lut_tail_AVX512(lut.right_slope, lut.right_icpt, x));
+}
+
+static inline AUSSIE_TARGET_AVX512 __m512 aussie_lut_eval_AVX512(const aussie_lut& lut, __m512 x)
+{
+	__m512 y;
+	if (lut.fn == AUSSIE_LUT_EXP) {
+		const __m512 lo = _mm512_set1_ps(AUSSIE_LUT_EXP_LO), hi = _mm512_set1_ps(AUSSIE_LUT_EXP_HI);
+		__m512 xc = _mm512_min_ps(_mm512_max_ps(x, lo), hi);
+		__m512 k = _mm512_roundscale_ps(_mm512_mul_ps(xc, _mm512_set1_ps(AUSSIE_LUT_LOG2E)), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+		__m512 r = _mm512_fnmadd_ps(k, _mm512_set1_ps(AUSSIE_LUT_LN2_HI), xc);
+		r = _mm512_fnmadd_ps(k, _mm512_set1_ps(AUSSIE_LUT_LN2_LO), r);
+		y = _mm512_scalef_ps(aussie_lut_range_AVX512(lut, r), k);  // Times 2^k
+		y = _mm512_mask_mov_ps(y, _mm512_cmp_ps_mask(x, lo, _CMP_LT_OQ), _mm512_setzero_ps());
+		y = _mm512_mask_mov_ps(y, _mm512_cmp_ps_mask(x, hi, _CMP_GT_OQ), _mm512_set1_ps(INFINITY));
+	}
+	else {
+		y = aussie_lut_range_AVX512(lut, x);
+	}
+	return _mm512_mask_mov_ps(y, _mm512_cmp_ps_mask(x, x, _CMP_UNORD_Q), x);  // NaN in, NaN out
+}
+
+AUSSIE_TARGET_AVX512 void aussie_lut_apply_AVX512(const aussie_lut& lut, const float in[], float out[], int n)
+{
+	int i = 0;
+	for (; i + 16 <= n; i += 16) {
+		_mm512_storeu_ps(&out[i], aussie_lut_eval_AVX512(lut, _mm512_loadu_ps(&in[i])));
+	}
+	if (i < n) {  // Masked tail
+		__mmask16 mask = (__mmask16)((1u << (n - i)) - 1);
+		_mm512_mask_storeu_ps(&out[i], mask, aussie_lut_eval_AVX512(lut, _mm512_maskz_loadu_ps(mask, &in[i])));
+	}
+}
+
+#else
+
+void aussie_lut_apply_AVX2(const aussie_lut& lut, const float in[], float out[], int n) { aussie_lut_apply_basic(lut, in, out, n); }
+void aussie_lut_apply_AVX512(const aussie_lut& lut, const float in[], float out[], int n) { aussie_lut_apply_basic(lut, in, out, n); }
+
+#endif //AUSSIE_X86
+
+void aussie_lut_apply(const aussie_lut& lut, const float in[], float out[], int n)  // Dispatched (in == out is fine)
+{
+	aussie_dispatch_ensure();
+	if (g_aussie_dispatch.isa >= AUSSIE_ISA_AVX512 && aussie_cpu_has_avx512()) aussie_lut_apply_AVX512(lut, in, out, n);
+	else if (g_aussie_dispatch.isa >= AUSSIE_ISA_AVX2 && aussie_cpu_has_avx2()) aussie_lut_apply_AVX2(lut, in, out, n);
+	else aussie_lut_apply_basic(lut, in, out, n);
+}
+
+//---------------------------------------------------
+// The default tables
+//---------------------------------------------------
+
+static float aussie_lut_eval_default(int fn, float x, float (*exact)(float))
+{
+	const aussie_lut* lut = aussie_lut_get(fn);
+	if (lut == NULL) return exact(x);  // fail (no memory for the table): compute it exactly
+	return aussie_lut_eval(*lut, x);
+}
+
+float aussie_GELU_lut(float x) { return aussie_lut_eval_default(AUSSIE_LUT_GELU, x, aussie_GELU_basic); }
+float aussie_SiLU_lut(float x) { return aussie_lut_eval_default(AUSSIE_LUT_SILU, x, aussie_SiLU_basic); }
+float aussie_sigmoid_lut(float x) { return aussie_lut_eval_default(AUSSIE_LUT_SIGMOID, x, aussie_sigmoid); }
+float aussie_tanh_lut(float x) { return aussie_lut_eval_default(AUSSIE_LUT_TANH, x, tanhf); }
+float aussie_expf_lut(float x) { return aussie_lut_eval_default(AUSSIE_LUT_EXP, x, expf); }
+
+void aussie_vector_lut(int fn, float v[], int n)  // In place, with the default table
+{
+	const aussie_lut* lut = aussie_lut_get(fn);
+	if (lut == NULL) return;  // fail
+	aussie_lut_apply(*lut, v, v, n);
+}
+
+//---------------------------------------------------
+// Accuracy
+//---------------------------------------------------
+
+float aussie_lut_max_error(const aussie_lut& lut, float xmin, float xmax, int nsamples, float* maxrelerr /*= NULL*/)
+{
+	// Evenly spaced samples, so most fall between breakpoints (the worst case for interpolation)
+	float maxerr = 0.0f, maxrel = 0.0f;
+	for (int i = 0; i < nsamples; i++) {
+		float x = xmin + (xmax - xmin) * (float)((double)i / (double)(nsamples - 1));
+		float exact = lut.fn == AUSSIE_LUT_EXP ? expf(x) : lut.fnptr(x);
+		float err = fabsf(aussie_lut_eval(lut, x) - exact);
+		if (err > maxerr) maxerr = err;
+		if (exact != 0.0f && err / fabsf(exact) > maxrel) maxrel = err / fabsf(exact);
+	}
+	if (maxrelerr) *maxrelerr = maxrel;
+	return maxerr;
+}
+
+float aussie_table24_max_error(float (*fnptr)(float), float xmin, float xmax, int nsamples)  // The 24-bit table's error (aactivation.h), without building it
+{
+	// The 24-bit table returns fn() of x with its low 8 mantissa bits cleared
+	float maxerr = 0.0f;
+	for (int i = 0; i < nsamples; i++) {
+		float x = xmin + (xmax - xmin) * (float)((double)i / (double)(nsamples - 1));
+		unsigned int u = AUSSIE_FLOAT_TO_UINT(x) & ~0xFFu;
+		float err = fabsf(fnptr(AUSSIE_UINT_TO_FLOAT(u)) - fnptr(x));
+		if (err > maxerr) maxerr = err;
+	}
+	return maxerr;
+}
+
+//---------------------------------------------------
+// Unit tests
+//---------------------------------------------------
+
+static void aussie_lut_test_function(int fn, float maxerr_expect)
+{
+	const aussie_lut* lut = aussie_lut_get(fn);
+	if (lut == NULL) {
+		ytest(lut != NULL);
+		return;  // fail
+	}
+	const aussie_lut_function& f = s_aussie_lut_functions[fn];
+	float lo = fn == AUSSIE_LUT_EXP ? -20.0f : f.xmin - 2.0f, hi = fn == AUSSIE_LUT_EXP ? 20.0f : f.xmax + 2.0f;
+	float relerr = 0.0f;
+	float err = aussie_lut_max_error(*lut, lo, hi, 100001, &relerr);
+	aussie_lut linear;
+	ytest(aussie_lut_init(linear, fn, 4 * AUSSIE_LUT_DEFAULT_INTERVALS, AUSSIE_LUT_LINEAR));
+	float errlin = aussie_lut_max_error(linear, lo, hi, 100001);
+	float err24 = fn == AUSSIE_LUT_EXP ? 0.0f : aussie_table24_max_error(f.fnptr, lo, hi, 100001);
+	if (fn == AUSSIE_LUT_EXP) {  // Relative error (the 24-bit table has none for expf)
+		fprintf(stderr, "INFO: LUT %s [%g,%g]: quadratic %d intervals (%dKB) max relative error %g\n",
+			f.name, lo, hi, lut->n, (int)(aussie_lut_bytes(*lut) / 1024), relerr);
+		ytest(relerr < maxerr_expect);
+	}
+	else {
+		fprintf(stderr, "INFO: LUT %s [%g,%g]: quadratic %d intervals (%dKB) max error %g, linear %d intervals %g, 24-bit table %g\n",
+			f.name, lo, hi, lut->n, (int)(aussie_lut_bytes(*lut) / 1024), err, linear.n, errlin, err24);
+		ytest(err < maxerr_expect);
+		ytest(err < err24);  // Better than the 64MB table
+	}
+
+	// SIMD versions match the scalar one (FMA rounding aside), at and beyond the range ends
+	int n = 1003;
+	float* in = (float*)malloc(n * sizeof(float));
+	float* out = (float*)malloc(n * sizeof(float));
+	float* out2 = (float*)malloc(n * sizeof(float));
+	for (int i = 0; i < n; i++) in[i] = lo + (hi - lo) * (float)i / (float)(n - 1);
+	in[0] = -INFINITY;
+	in[1] = INFINITY;
+	in[2] = NAN;
+	in[3] = f.xmin;
+	in[4] = f.xmax;
+	if (fn == AUSSIE_LUT_EXP) { in[5] = -100.0f; in[6] = 100.0f; in[7] = 88.7f; in[8] = -87.3f; }
+	aussie_lut_apply_basic(*lut, in, out, n);
+	ytest(out[2] != out[2]);  // NaN
+	ytest(!isnan(out[0]) && !isnan(out[1]));
+	aussie_lut_apply_fnptr simd[] = { aussie_lut_apply_AVX2, aussie_lut_apply_AVX512 };
+	bool ok[] = { aussie_cpu_has_avx2(), aussie_cpu_has_avx512() };
+	for (int k = 0; k < 2; k++) {
+		if (!ok[k]) continue;
+		simd[k](*lut, in, out2, n);
+		int nbad = 0;
+		for (int i = 0; i < n; i++) {
+			bool same = (out[i] == out2[i]) || (isnan(out[i]) && isnan(out2[i]))
+				|| fabsf(out[i] - out2[i]) <= 4e-7f * (fabsf(out[i]) + 1.0f);
+			if (!same) {
+				if (nbad == 0) fprintf(stderr, "ERROR: LUT %s SIMD %d: x=%g %g versus %g\n", f.name, k, in[i], out2[i], out[i]);
+				nbad++;
+			}
+		}
+		ytesti(nbad, 0);
+	}
+	aussie_lut_free(linear);
+	free(in); free(out); free(out2);
+}
+
+void aussie_lut_unit_tests()
+{
+	fprintf(stderr, "INFO: %s: Running unit tests\n", __func__);
+	aussie_lut_test_function(AUSSIE_LUT_GELU, 2e-6f);  // A few ulps of |x| <= 10
+	aussie_lut_test_function(AUSSIE_LUT_SILU, 4e-6f);  // |x| <= 22
+	aussie_lut_test_function(AUSSIE_LUT_SIGMOID, 1e-6f);
+	aussie_lut_test_function(AUSSIE_LUT_TANH, 1e-6f);
+	aussie_lut_test_function(AUSSIE_LUT_EXP, 1e-6f);  // Relative
+
+	// Spot checks and the asymptotes
+	ytestf(aussie_GELU_lut(100.0f), 100.0f);
+	ytestf(aussie_GELU_lut(-100.0f), 0.0f);
+	ytestf(aussie_sigmoid_lut(-INFINITY), 0.0f);
+	ytestf(aussie_tanh_lut(50.0f), 1.0f);
+	ytest(fabsf(aussie_expf_lut(0.0f) - 1.0f) < 1e-6f);
+	ytestf(aussie_expf_lut(-1000.0f), 0.0f);
+	ytest(isinf(aussie_expf_lut(1000.0f)));
+	ytest(fabsf(aussie_expf_lut(1.0f) - expf(1.0f)) < 4e-6f);
+	ytest(fabsf(aussie_SiLU_lut(1.5f) - aussie_SiLU_basic(1.5f)) < 2e-6f);
+
+	// In place, default table
+	float v[20];
+	for (int i = 0; i < 20; i++) v[i] = (float)(i - 10) * 0.3f;
+	aussie_vector_lut(AUSSIE_LUT_SIGMOID, v, 20);
+	ytest(fabsf(v[10] - 0.5f) < 1e-6f);
+	ytest(fabsf(v[19] - aussie_sigmoid(2.7f)) < 1e-6f);
+
+	// Custom function, constant outside its range
+	aussie_lut sq;
+	ytest(aussie_lut_init_custom(sq, sqrtf, 0.0f, 4.0f, 64, AUSSIE_LUT_LINEAR));
+	ytestf(aussie_lut_eval(sq, 9.0f), 2.0f);
+	ytestf(aussie_lut_eval(sq, 1.0f), 1.0f);  // Breakpoint: exact
+	ytest(aussie_lut_bytes(sq) == 65 * 2 * sizeof(float));
+	aussie_lut_free(sq);
+}
+
+//---------------------------------------------------
+//---------------------------------------------------
@@ -0,0 +1,86 @@
+//---------------------------------------------------
+// alut.h -- Interpolated lookup tables for activation functions -- Aussie AI Base Library
+// Created Oct 17th 2026
+// Copyright (c) 2023 Aussie AI Labs Pty Ltd
+//---------------------------------------------------
+
+#ifndef AUSSIE_YLUT_INCLUDE_HEADER_H
+#define AUSSIE_YLUT_INCLUDE_HEADER_H
+
+//---------------------------------------------------
+// LUT with interpolation: a few thousand breakpoints over a clamped range [xmin,xmax],
+// with a linear or quadratic piece in each interval (coefficients precomputed, aprecompute.h).
+// ... tens of KB (fits L1/L2), unlike the 64MB 24-bit table, and more accurate than it
+// ... outside the range each function follows its asymptote (slope * x + intercept),
+//     e.g. GELU(x) = x above the range and 0 below it
+// ... expf uses range reduction: x = k*ln2 + r, a table of e^r over [0,ln2], then 2^k in the exponent
+// ... vectorized with gathers of the coefficients (AVX2, AVX-512)
+//---------------------------------------------------
+
+#define AUSSIE_LUT_GELU     0
+#define AUSSIE_LUT_SILU     1
+#define AUSSIE_LUT_SIGMOID  2
+#define AUSSIE_LUT_TANH     3
+#define AUSSIE_LUT_EXP      4
+#define AUSSIE_LUT_NFUNCS   5
+#define AUSSIE_LUT_CUSTOM  -1   // aussie_lut_init_custom
+
+#define AUSSIE_LUT_LINEAR     1
+#define AUSSIE_LUT_QUADRATIC  2
+
+#define AUSSIE_LUT_DEFAULT_INTERVALS  1024   // With quadratic pieces: 12KB per function
+#define AUSSIE_LUT_MAX_INTERVALS      (1 << 16)
+
+struct aussie_lut {
+	int fn;          // AUSSIE_LUT_* (AUSSIE_LUT_CUSTOM for aussie_lut_init_custom)
+	int order;       // AUSSIE_LUT_LINEAR or AUSSIE_LUT_QUADRATIC
+	int n;           // Intervals
+	float xmin, xmax;
+	float scale;     // n / (xmax - xmin)
+	float left_slope, left_icpt;    // Below xmin: left_slope * x + left_icpt
+	float right_slope, right_icpt;  // Above xmax
+	float* c0;       // Per interval: y = c0 + t * (c1 + t * c2), t in [0,1] across the interval
+	float* c1;
+	float* c2;       // All zero for linear
+	float (*fnptr)(float);  // The exact function (for building and error checks)
+};
+
+bool aussie_lut_init(aussie_lut& lut, int fn, int nintervals = AUSSIE_LUT_DEFAULT_INTERVALS, int order = AUSSIE_LUT_QUADRATIC);
+bool aussie_lut_init_custom(aussie_lut& lut, float (*fnptr)(float), float xmin, float xmax, int nintervals, int order);  // Constant outside the range
+void aussie_lut_free(aussie_lut& lut);
+size_t aussie_lut_bytes(const aussie_lut& lut);  // Coefficient table size
+const aussie_lut* aussie_lut_get(int fn);  // Shared default tables (built on first use)
+
+float aussie_lut_eval(const aussie_lut& lut, float x);
+
+typedef void (*aussie_lut_apply_fnptr)(const aussie_lut& lut, const float in[], float out[], int n);
+
+void aussie_lut_apply(const aussie_lut& lut, const float in[], float out[], int n);  // Dispatched (in == out is fine)
+void aussie_lut_apply_basic(const aussie_lut& lut, const float in[], float out[], int n);
+void aussie_lut_apply_AVX2(const aussie_lut& lut, const float in[], float out[], int n);
+void aussie_lut_apply_AVX512(const aussie_lut& lut, const float in[], float out[], int n);
+
+float aussie_GELU_lut(float x);
+float aussie_SiLU_lut(float x);
+float aussie_sigmoid_lut(float x);
+float aussie_tanh_lut(float x);
+float aussie_expf_lut(float x);
+void aussie_vector_lut(int fn, float v[], int n);  // In place, with the default table
+
+//---------------------------------------------------
+// Accuracy: max absolute error versus the exact function over nsamples points in [xmin,xmax]
+//---------------------------------------------------
+
+float aussie_lut_max_error(const aussie_lut& lut, float xmin, float xmax, int nsamples, float* maxrelerr = NULL);
+float aussie_table24_max_error(float (*fnptr)(float), float xmin, float xmax, int nsamples);  // The 24-bit table's error (aactivation.h), without building it
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+void aussie_lut_unit_tests();
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+
+#endif //AUSSIE_YLUT_INCLUDE_HEADER_H
@@ -22,10 +22,9 @@
 #include "atest.h"
 #include "aactivation.h"
 
-#if !LINUX
-#include <xmmintrin.h>  // AVX
-#include <intrin.h>
-#endif //LINUX
+#if AUSSIE_X86
+#include <immintrin.h>  // AVX
+#endif //AUSSIE_X86
 
 #include "amatmul.h"  // self-include
 
@@ -456,8 +455,8 @@ void aussie_VMM_vector_basic_vecdot_nonfused(const ymatrix m, const float v[], i
 
 void aussie_VMM_vector_vecdot_AVX1(const ymatrix m, const float v[], int n, float vout[])
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
 	// VMM matrix-by-vector using AVX1 vector dot product
@@ -466,18 +465,18 @@ void aussie_VMM_vector_vecdot_AVX1(const ymatrix m, const float v[], int n, floa
 		float sum = aussie_vecdot_unroll_AVX1(rowvector, v, n);  // Dot product
 		vout[i] = sum;
 	}
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 void aussie_VMM_vecdot_RELU_AVX1(const ymatrix m, const float v[], int n, float vout[])
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
-	return 0;
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
+	return;
 #else
 	aussie_VMM_vector_vecdot_AVX1(m, v, n, vout);  // Matrix-vector multiply
 	aussie_vector_reluize_AVX1(vout, n);  // Apply RELU on the output
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 void aussie_matmul_vector_basic_vecdot_RELU_nonfused(const ymatrix m, const float v[], int n, float vout[])
@@ -537,8 +536,8 @@ void aussie_matmul_vector_basic_out2_pointer_arith(const ymatrix m, const float
 
 void aussie_matmul_vector_vecdot_AVX1(const ymatrix m, const float v[], int n, float vout[])
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
 	// Matrix-by-vector using AVX1 vector dot products..
@@ -549,7 +548,7 @@ void aussie_matmul_vector_vecdot_AVX1(const ymatrix m, const float v[], int n, f
 		float sum = aussie_vecdot_unroll_AVX1(rowvector, v, n);  // Dot product
 		vout[i] = sum;
 	}
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 
@@ -557,8 +556,8 @@ void aussie_matmul_vector_vecdot_AVX1(const ymatrix m, const float v[], int n, f
 
 void aussie_matmul_vector_vecdot_AVX2(const ymatrix m, const float v[], int n, float vout[])
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
 	// Matrix-by-vector using AVX2 vector dot products with AVX2 FMA intrinsic.
@@ -570,7 +569,7 @@ void aussie_matmul_vector_vecdot_AVX2(const ymatrix m, const float v[], int n, f
 		float sum = aussie_vecdot_FMA_unroll_AVX2(rowvector, v, n);  // Dot product
 		vout[i] = sum;
 	}
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 
@@ -1057,20 +1056,20 @@ void aussie_matmul_matrix_fake_transpose_unrolled8(const ymatrix m1, const ymatr
 	}
 }
 
-void aussie_matmul_matrix_fake_transpose_vecdot_AVX1_inlined(const ymatrix m1, const ymatrix m2, int n, ymatrix mout)
+AUSSIE_TARGET_AVX1 void aussie_matmul_matrix_fake_transpose_vecdot_AVX1_inlined(const ymatrix m1, const ymatrix m2, int n, ymatrix mout)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
-	// AVX1 Matrix-Matrix multiplication 
-	yassert(n % 8 == 0);
+	// AVX1 Matrix-Matrix multiplication (any n)
 	for (int row = 0; row < n; row++) {
 		const float* rowvec = &m1[row][0];
 		for (int col = 0; col < n; col++) {
 			const float* colvec = &m2[col][0];
 			float sum = 0.0;
-			for (int i = 0; i < n; i += 4) {
+			int i = 0;
+			for (; i + 4 <= n; i += 4) {
 				// AVX1: Vector dot product of 2 vectors 
 				//  ... process 4x32-bit floats in 128 bits
 				__m128 r1 = _mm_loadu_ps(&rowvec[i]);   // Load floats into 128-bits
@@ -1078,27 +1077,28 @@ void aussie_matmul_matrix_fake_transpose_vecdot_AVX1_inlined(const ymatrix m1, c
 				__m128 dst = _mm_dp_ps(r1, r2, 0xf1); // Dot product
 				sum += _mm_cvtss_f32(dst);
 			}
+			for (; i < n; i++) sum += rowvec[i] * colvec[i];  // Leftovers
 			mout[row][col] = sum;
 		}
 	}
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 
-void aussie_matmul_matrix_fake_transpose_vecdot_AVX1_inlined_unrolled4(const ymatrix m1, const ymatrix m2, int n, ymatrix mout)
+AUSSIE_TARGET_AVX1 void aussie_matmul_matrix_fake_transpose_vecdot_AVX1_inlined_unrolled4(const ymatrix m1, const ymatrix m2, int n, ymatrix mout)
 {
 	// AVX1 Matrix-Matrix multiplication 
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
-	return 0;
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
+	return;
 #else
-	yassert(n % 16 == 0);
 	for (int row = 0; row < n; row++) {
 		const float* rowvec = &m1[row][0];
 		for (int col = 0; col < n; col++) {
 			const float* colvec = &m2[col][0];
 			float sum = 0.0;
-			for (int i = 0; i < n; i += 16) {
+			int i = 0;
+			for (; i + 16 <= n; i += 16) {
 				// AVX1: Vector dot product of 2 vectors 
 				//  ... process 4x32-bit floats in 128 bits
 				__m128 r1 = _mm_loadu_ps(&rowvec[i]);   // Load floats into 128-bits
@@ -1121,23 +1121,23 @@ void aussie_matmul_matrix_fake_transpose_vecdot_AVX1_inlined_unrolled4(const yma
 				dst = _mm_dp_ps(r1, r2, 0xf1); // Dot product
 				sum += _mm_cvtss_f32(dst);
 			}
+			for (; i < n; i++) sum += rowvec[i] * colvec[i];  // Leftovers
 			mout[row][col] = sum;
 		}
 	}
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 
 void aussie_matmul_matrix_fake_transpose_vecdot_AVX1(const ymatrix m1, const ymatrix m2, int n, ymatrix mout)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
 	// AVX1 Matrix-Matrix multiplication 
 
 	yassert(n == AUSSIE_MATRIX_ROWS);  // Matrix & vector dimensions must match
-	yassert(n % 8 == 0);
 
 	for (int row = 0; row < n; row++) {
 		const float* rowvec = &m1[row][0];
@@ -1146,27 +1146,27 @@ void aussie_matmul_matrix_fake_transpose_vecdot_AVX1(const ymatrix m1, const yma
 			mout[row][col] = aussie_vecdot_unroll_AVX1(rowvec, colvec, n);
 		}
 	}
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 
-void aussie_matmul_matrix_fake_transpose_vecdot_AVX2_inlined(const ymatrix m1, const ymatrix m2, int n, ymatrix mout)
+AUSSIE_TARGET_AVX2 void aussie_matmul_matrix_fake_transpose_vecdot_AVX2_inlined(const ymatrix m1, const ymatrix m2, int n, ymatrix mout)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
-	return 0;
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
+	return;
 #else
 	// AVX2 Matrix-Matrix multiplication .
 
 	yassert(n == AUSSIE_MATRIX_ROWS);  // Matrix & vector dimensions must match
-	yassert(n % 8 == 0);
 
 	for (int row = 0; row < n; row++) {
 		const float* rowvec = &m1[row][0];
 		for (int col = 0; col < n; col++) {
 			const float* colvec = &m2[col][0];
 			__m256 sumdst = _mm256_setzero_ps();   // Set accumulators to zero
-			for (int i = 0; i < n; i += 8) {
+			int i = 0;
+			for (; i + 8 <= n; i += 8) {
 				// AVX2: Vector dot product of 2 vectors 
 				//  ... process 4x32-bit floats in 128 bits
 				__m256 r1 = _mm256_loadu_ps(&rowvec[i]);   // Load floats into 256-bits
@@ -1177,10 +1177,11 @@ void aussie_matmul_matrix_fake_transpose_vecdot_AVX2_inlined(const ymatrix m1, c
 			float* farr = (float*)&sumdst;
 			float sum = farr[0] + farr[1] + farr[2] + farr[3]
 				+ farr[4] + farr[5] + farr[6] + farr[7];
+			for (; i < n; i++) sum += rowvec[i] * colvec[i];  // Leftovers
 			mout[row][col] = sum;
 		}
 	}
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 
@@ -1189,7 +1190,6 @@ void aussie_matmul_matrix_fake_transpose_vecdot_AVX2(const ymatrix m1, const yma
 	// AVX2 Matrix-Matrix multiplication .
 
 	yassert(n == AUSSIE_MATRIX_ROWS);  // Matrix & vector dimensions must match
-	yassert(n % 8 == 0);
 
 	for (int row = 0; row < n; row++) {
 		const float* rowvec = &m1[row][0];
@@ -67,6 +67,7 @@ void aussie_matmul_matrix_fake_transpose_vecdot_AVX2(const ymatrix m, const ymat
 void aussie_matmul_matrix_fake_transpose_vecdot_AVX1_inlined(const ymatrix m, const ymatrix m2, int n, ymatrix mout);
 void aussie_matmul_matrix_fake_transpose_vecdot_AVX2_inlined(const ymatrix m, const ymatrix m2, int n, ymatrix mout);
 void aussie_matmul_matrix_fake_transpose_vecdot_AVX1_inlined_unrolled4(const ymatrix m, const ymatrix m2, int n, ymatrix mout);
+void aussie_matmul_matrix_gemm(const ymatrix m, const ymatrix m2, int n, ymatrix mout);  // Blocked GEMM (agemm.cpp)
 
 
 
@@ -103,6 +104,7 @@ void aussie_matmul_vector_basic_out2_pointer_arith(const ymatrix m, const float
 
 void aussie_matmul_vector_vecdot_AVX1(const ymatrix m, const float v[], int n, float vout[]);
 void aussie_matmul_vector_vecdot_AVX2(const ymatrix m, const float v[], int n, float vout[]);
+void aussie_matmul_vector_parallel(const ymatrix m, const float v[], int n, float vout[]);  // Thread pool GEMV (agemm.cpp)
 
 //-------------------------------------------------------------------------
 //-------------------------------------------------------------------------
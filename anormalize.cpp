@@ -21,6 +21,8 @@
 #include "aassert.h"
 #include "atest.h"
 #include "avector.h"
+#include "adispatch.h"
+#include "athread.h"
 
 #include "anormalize.h"  // self-include
 
@@ -49,8 +51,8 @@ void aussie_vector_normalize_zscore_fused(float v[], int n)
 
 void aussie_vector_normalize_zscore_sum_AVX1(float v[], int n)  // Use AVX1 for the sum only
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
 	// Fused version which stores "v[i]-mean" in the array...
@@ -60,13 +62,13 @@ void aussie_vector_normalize_zscore_sum_AVX1(float v[], int n)  // Use AVX1 for
 	for (int i = 0; i < n; i++) {
 		v[i] = (v[i] - vmean) * frecip; // Multiply by reciprocal
 	}
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 void aussie_vector_normalize_zscore_sum_AVX2(float v[], int n)  // Use AVX1 for the sum only
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
 	// Fused version which stores "v[i]-mean" in the array...
@@ -76,13 +78,13 @@ void aussie_vector_normalize_zscore_sum_AVX2(float v[], int n)  // Use AVX1 for
 	for (int i = 0; i < n; i++) {
 		v[i] = (v[i] - vmean) * frecip; // Multiply by reciprocal
 	}
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 void aussie_vector_normalize_zscore_sum_mult_AVX1(float v[], int n)  // Use AVX1 for the sum and multiply-by-reciprocal
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
 	// Fused version which stores "v[i]-mean" in the array...
@@ -90,13 +92,13 @@ void aussie_vector_normalize_zscore_sum_mult_AVX1(float v[], int n)  // Use AVX1
 	float stddev = aussie_vector_mean_and_stddev_fused_AVX1(v, n, vmean);
 	float frecip = 1.0f / stddev;  // Before the loop
 	aussie_vector_multiply_scalar_AVX1(v, n, frecip);  // Multiply by reciprocal
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 void aussie_vector_normalize_zscore_all_AVX1(float v[], int n)  // Use AVX1 for the sum and multiply-by-reciprocal
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
 	// Fused version which stores "v[i]-mean" in the array...
@@ -104,13 +106,13 @@ void aussie_vector_normalize_zscore_all_AVX1(float v[], int n)  // Use AVX1 for
 	float stddev = aussie_vector_mean_and_stddev_all_AVX1(v, n, vmean);
 	float frecip = 1.0f / stddev;  // Before the loop
 	aussie_vector_multiply_scalar_AVX1(v, n, frecip);  // Multiply by reciprocal
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 void aussie_vector_normalize_zscore_all_AVX2(float v[], int n)  // Use AVX1 for the sum and multiply-by-reciprocal
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
 	// Fused version which stores "v[i]-mean" in the array...
@@ -118,13 +120,13 @@ void aussie_vector_normalize_zscore_all_AVX2(float v[], int n)  // Use AVX1 for
 	float stddev = aussie_vector_mean_and_stddev_all_AVX2(v, n, vmean);
 	float frecip = 1.0f / stddev;  // Before the loop
 	aussie_vector_multiply_scalar_AVX2(v, n, frecip);  // Multiply by reciprocal
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 void aussie_vector_normalize_zscore_sum_mult_AVX2(float v[], int n)  // Use AVX1 for the sum and multiply-by-reciprocal
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
 	// Fused version which stores "v[i]-mean" in the array...
@@ -132,7 +134,7 @@ void aussie_vector_normalize_zscore_sum_mult_AVX2(float v[], int n)  // Use AVX1
 	float stddev = aussie_vector_mean_and_stddev_fused_AVX2(v, n, vmean);
 	float frecip = 1.0f / stddev;  // Before the loop
 	aussie_vector_multiply_scalar_AVX2(v, n, frecip);  // Multiply by reciprocal
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 
@@ -266,8 +268,8 @@ void aussie_vector_batch_normalize_with_loop_fission2_wrapper(float v[], int n)
 
 void aussie_vector_batch_normalize_with_loop_fission2_wrapper_AVX1(float v[], int n)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
 	aussie_vector_batch_normalize_with_loop_fission2_AVX1(    // Basic normalization (BatchNorm)
@@ -276,13 +278,13 @@ void aussie_vector_batch_normalize_with_loop_fission2_wrapper_AVX1(float v[], in
 		1.0f, // lambda, // Scaling term hyper-parameter (multiplication)
 		0.0f // beta    // Bias/shift term hyper-parameter (addition)
 	);
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 void aussie_vector_batch_normalize_with_loop_fission2_wrapper_AVX2(float v[], int n)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
 	aussie_vector_batch_normalize_with_loop_fission2_AVX2(    // Basic normalization (BatchNorm)
@@ -291,13 +293,13 @@ void aussie_vector_batch_normalize_with_loop_fission2_wrapper_AVX2(float v[], in
 		1.0f, // lambda, // Scaling term hyper-parameter (multiplication)
 		0.0f // beta    // Bias/shift term hyper-parameter (addition)
 	);
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 void aussie_vector_batch_normalize_with_loop_fusion_fission_AVX1_wrapper(float v[], int n)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
 	aussie_vector_batch_normalize_with_loop_fusion_fission_AVX1(    // Basic normalization (BatchNorm)
@@ -306,13 +308,13 @@ void aussie_vector_batch_normalize_with_loop_fusion_fission_AVX1_wrapper(float v
 		1.0f, // lambda, // Scaling term hyper-parameter (multiplication)
 		0.0f // beta    // Bias/shift term hyper-parameter (addition)
 	);
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 void aussie_vector_batch_normalize_with_loop_fusion_fission_AVX2_wrapper(float v[], int n)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
 	aussie_vector_batch_normalize_with_loop_fusion_fission_AVX2(    // Basic normalization (BatchNorm)
@@ -321,7 +323,7 @@ void aussie_vector_batch_normalize_with_loop_fusion_fission_AVX2_wrapper(float v
 		1.0f, // lambda, // Scaling term hyper-parameter (multiplication)
 		0.0f // beta    // Bias/shift term hyper-parameter (addition)
 	);
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 void aussie_vector_batch_normalize_with_loop_fusion_fission_wrapper(float v[], int n)
@@ -417,8 +419,8 @@ void aussie_vector_batch_normalize_with_loop_fission2_AVX1(    // Fission-improv
 	float beta    // Bias/shift term hyper-parameter (addition)
 )
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
 
@@ -435,7 +437,7 @@ void aussie_vector_batch_normalize_with_loop_fission2_AVX1(    // Fission-improv
 	float scalef = lambda / denom;  // Combined scale factor
 	aussie_vector_multiply_scalar_AVX1(v, n, scalef);  // Scale by both denom and lambda 
 	aussie_vector_add_scalar_AVX1(v, n, beta);  // Add beta hyper-param to all values 
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 
@@ -446,8 +448,8 @@ void aussie_vector_batch_normalize_with_loop_fission2_AVX2(    // Fission-improv
 	float beta    // Bias/shift term hyper-parameter (addition)
 )
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
 	// NOTE: epsilon smoothing term is usually 1^e-5
@@ -463,7 +465,7 @@ void aussie_vector_batch_normalize_with_loop_fission2_AVX2(    // Fission-improv
 	float scalef = lambda / denom;  // Combined scale factor
 	aussie_vector_multiply_scalar_AVX2(v, n, scalef);  // Scale by both denom and lambda 
 	aussie_vector_add_scalar_AVX2(v, n, beta);  // Add beta hyper-param to all values 
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 void aussie_vector_batch_normalize_with_loop_fission2(    // Fission-improved normalization (BatchNorm)
@@ -497,8 +499,8 @@ void aussie_vector_batch_normalize_with_loop_fusion_fission_AVX1(    // Fusion &
 	float beta    // Bias/shift term hyper-parameter (addition)
 )
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
 
@@ -516,7 +518,7 @@ void aussie_vector_batch_normalize_with_loop_fusion_fission_AVX1(    // Fusion &
 	aussie_vector_multiply_scalar_AVX1(v, n, scalef);  // Scale by both denom and lambda 
 	aussie_vector_add_scalar_AVX1(v, n, beta);  // Add beta hyper-param to all values 
 
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 void aussie_vector_batch_normalize_with_loop_fusion_fission_AVX2(    // Fusion & fission (BatchNorm)
@@ -526,8 +528,8 @@ void aussie_vector_batch_normalize_with_loop_fusion_fission_AVX2(    // Fusion &
 	float beta    // Bias/shift term hyper-parameter (addition)
 )
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
 
@@ -545,7 +547,7 @@ void aussie_vector_batch_normalize_with_loop_fusion_fission_AVX2(    // Fusion &
 	aussie_vector_multiply_scalar_AVX2(v, n, scalef);  // Scale by both denom and lambda 
 	aussie_vector_add_scalar_AVX2(v, n, beta);  // Add beta hyper-param to all values 
 
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 void aussie_vector_batch_normalize_with_loop_fusion_fission(    // Fusion & fission of loops (BatchNorm)
@@ -617,8 +619,8 @@ void aussie_vector_rms_normalize_reciprocal(float v[], int n)  // Basic RMS norm
 
 void aussie_vector_rms_normalize_AVX1(float v[], int n)	// RMS normalization (RMSNorm)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
 	const float epsilon = 0.00005; // Smoothing term -- usually 1^e-5 (0.00005)
@@ -626,13 +628,13 @@ void aussie_vector_rms_normalize_AVX1(float v[], int n)	// RMS normalization (RM
 	float avg_squares = sum_squares / n;  // Average of the squares...
 	float fmult = 1.0f / sqrtf(avg_squares + epsilon);  // Reciprocal of factor, so we can multiply
 	aussie_vector_multiply_scalar_AVX1(v, n, fmult);  // Divide all values by the RMS scale factor
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 void aussie_vector_rms_normalize_AVX2(float v[], int n)	// RMS normalization (RMSNorm)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
 	const float epsilon = 0.00005; // Smoothing term -- usually 1^e-5 (0.00005)
@@ -640,7 +642,70 @@ void aussie_vector_rms_normalize_AVX2(float v[], int n)	// RMS normalization (RM
 	float avg_squares = sum_squares / n;  // Average of the squares...
 	float fmult = 1.0f / sqrtf(avg_squares + epsilon);  // Reciprocal of factor, so we can multiply
 	aussie_vector_multiply_scalar_AVX2(v, n, fmult);  // Divide all values by the RMS scale factor
-#endif //LINUX
+#endif //AUSSIE_X86
+}
+
+//---------------------------------------------------
+// Parallel versions: the reductions and the scaling are split into chunks
+// for the thread pool (athread.h), each using the dispatched SIMD kernels
+//---------------------------------------------------
+
+struct aussie_normalize_parallel_args {
+	float* v;
+	float fmean;
+};
+
+static float aussie_normalize_sum_squares_chunk(int begin, int end, void* arg)
+{
+	const aussie_normalize_parallel_args* args = (const aussie_normalize_parallel_args*)arg;
+	return aussie_vecdot_dispatch(&args->v[begin], &args->v[begin], end - begin);
+}
+
+static float aussie_normalize_sum_chunk(int begin, int end, void* arg)
+{
+	const aussie_normalize_parallel_args* args = (const aussie_normalize_parallel_args*)arg;
+	return aussie_vector_sum_dispatch(&args->v[begin], end - begin);
+}
+
+static float aussie_normalize_diff_squares_chunk(int begin, int end, void* arg)
+{
+	// Fused: leaves the DIFF from MEAN in the chunk
+	const aussie_normalize_parallel_args* args = (const aussie_normalize_parallel_args*)arg;
+	return g_aussie_dispatch.fn_sum_diff_squared_fused(&args->v[begin], end - begin, args->fmean);
+}
+
+void aussie_vector_rms_normalize_parallel(float v[], int n)	// RMSNorm split across the thread pool
+{
+	if (n <= 0) {
+		yassert(n > 0);
+		return;  // fail
+	}
+	const float epsilon = 0.00005; // Smoothing term -- usually 1^e-5 (0.00005)
+	aussie_normalize_parallel_args args;
+	args.v = v;
+	float sum_squares = aussie_parallel_reduce(0, n, g_aussie_parallel_grain, aussie_normalize_sum_squares_chunk, &args, 0.0f, aussie_combine_sum);
+	float avg_squares = sum_squares / n;  // Average of the squares...
+	float fmult = 1.0f / sqrtf(avg_squares + epsilon);  // Reciprocal of factor, so we can multiply
+	aussie_vector_multiply_scalar_parallel(v, n, fmult);
+}
+
+void aussie_vector_normalize_zscore_parallel(float v[], int n)  // Dispatched kernels, split across the thread pool
+{
+	if (n <= 0) {
+		yassert(n > 0);
+		return;  // fail
+	}
+	aussie_dispatch_ensure();
+	aussie_normalize_parallel_args args;
+	args.v = v;
+	args.fmean = aussie_parallel_reduce(0, n, g_aussie_parallel_grain, aussie_normalize_sum_chunk, &args, 0.0f, aussie_combine_sum) / n;
+	float sumsquares = aussie_parallel_reduce(0, n, g_aussie_parallel_grain, aussie_normalize_diff_squares_chunk, &args, 0.0f, aussie_combine_sum);
+	float stddev = sqrtf(sumsquares / n);
+	if (stddev == 0.0f) {
+		yassert(stddev != 0.0f);
+		return;  // fail
+	}
+	aussie_vector_multiply_scalar_parallel(v, n, 1.0f / stddev);  // Vector already has DIFF from MEAN
 }
 
 
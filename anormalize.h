@@ -36,6 +36,7 @@ void aussie_vector_normalize_zscore_sum_mult_AVX2(float v[], int n);  // Use AVX
 
 void aussie_vector_normalize_zscore_all_AVX1(float v[], int n);  // Use AVX1 for All: sum, diff-squares & multiply-by-reciprocal
 void aussie_vector_normalize_zscore_all_AVX2(float v[], int n);  // Use AVX2 for All: sum, diff-squares & multiply-by-reciprocal
+void aussie_vector_normalize_zscore_parallel(float v[], int n);  // Dispatched kernels, split across the thread pool
 
 //-------------------------------------------------------------------------
 // RMSNorm...
@@ -44,6 +45,7 @@ void aussie_vector_rms_normalize_basic(float v[], int n);	// Basic RMS normaliza
 void aussie_vector_rms_normalize_reciprocal(float v[], int n);  // Basic RMS normalization (RMSNorm)
 void aussie_vector_rms_normalize_AVX1(float v[], int n);	// RMS normalization (RMSNorm)
 void aussie_vector_rms_normalize_AVX2(float v[], int n);	// RMS normalization (RMSNorm)
+void aussie_vector_rms_normalize_parallel(float v[], int n);	// RMSNorm split across the thread pool
 
 
 //-------------------------------------------------------------------------
@@ -18,5 +18,44 @@ extern long int g_aussie_multiplications_count;   // Count multiplications
 #define LINUX 0
 #endif
 
+// x86/x64 CPUs (SSE/AVX/AVX-2/AVX-512 intrinsics are available)
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define AUSSIE_X86 1
+#else
+#define AUSSIE_X86 0
+#endif
+
+// Per-function instruction set targets for SIMD kernels.
+// The rest of the build stays at the baseline ISA, so the same binary runs anywhere,
+// and these kernels are only called after a runtime CPUID check (see adispatch.h).
+// MSVC allows any intrinsic in any function, so these are empty there.
+#if LINUX && AUSSIE_X86
+#define AUSSIE_TARGET_AVX1      __attribute__((target("avx")))   // 128-bit kernels (also SSE4.1 _mm_dp_ps)
+#define AUSSIE_TARGET_AVX1_FMA  __attribute__((target("avx,fma")))  // 128-bit FMA kernels
+#define AUSSIE_TARGET_AVX2      __attribute__((target("avx2,fma")))  // 256-bit kernels
+#define AUSSIE_TARGET_AVX2_F16C __attribute__((target("avx2,fma,f16c")))  // 256-bit kernels with FP16 conversions
+#define AUSSIE_TARGET_AVX512    __attribute__((target("avx512f,avx512bw,avx512vl,avx2,fma")))  // 512-bit kernels
+#define AUSSIE_TARGET_AVX512_VNNI  __attribute__((target("avx512f,avx512bw,avx512vl,avx512vnni,avx2,fma")))  // 512-bit int8 dot products
+#define AUSSIE_TARGET_AVX512_VBMI  __attribute__((target("avx512f,avx512bw,avx512vl,avx512vbmi,avx2,fma")))  // 512-bit byte shuffles (table lookups)
+#else
+#define AUSSIE_TARGET_AVX1      /*nothing*/
+#define AUSSIE_TARGET_AVX1_FMA  /*nothing*/
+#define AUSSIE_TARGET_AVX2      /*nothing*/
+#define AUSSIE_TARGET_AVX2_F16C /*nothing*/
+#define AUSSIE_TARGET_AVX512    /*nothing*/
+#define AUSSIE_TARGET_AVX512_VNNI  /*nothing*/
+#define AUSSIE_TARGET_AVX512_VBMI  /*nothing*/
+#endif
+
+// Aligned heap allocation (e.g. packed GEMM panels for aligned SIMD loads).
+// Needs <stdlib.h> on Linux or <malloc.h> on Windows. Free with AUSSIE_ALIGNED_FREE only.
+#if LINUX
+#define AUSSIE_ALIGNED_MALLOC(sz, align)  aligned_alloc((align), (((sz) + (align) - 1) / (align)) * (align))  // Size must be a multiple
+#define AUSSIE_ALIGNED_FREE(ptr)          free(ptr)
+#else
+#define AUSSIE_ALIGNED_MALLOC(sz, align)  _aligned_malloc((sz), (align))
+#define AUSSIE_ALIGNED_FREE(ptr)          _aligned_free(ptr)
+#endif
+
 #endif //AUSSIE_INCLUDE_HEADER_H
 
@@ -19,11 +19,23 @@
 
 #include "aport.h"
 
+#if LINUX
+#include <sys/mman.h>  // mmap
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#else
+#include <io.h>  // _commit
+#include <process.h>  // _getpid
+#endif //LINUX
+
 #include "aussieai.h" // Overall API
 
 #include "aassert.h"
 #include "afloat.h"
 #include "atest.h"
+#include "athread.h"
+#include "aconstexpr.h"
 
 #include "aprecompute.h"  // self-include
 
@@ -62,7 +74,8 @@ void aussie_generic_precompute_float(float farr[], unsigned int maxn, float (*fn
 }
 
 float g_sqrt_float_precomp_table[1u << 16];
-float g_sqrt_float_24bit_precomp_table[1u << 24];
+const float* g_sqrt_float_24bit_precomp_table = NULL;  // Mapped file or heap (was 64MB of BSS)
+static aussie_table s_aussie_sqrt_24bit_table;
 
  
 float aussie_table_lookup_sqrt_float(float f)
@@ -76,6 +89,14 @@ float aussie_table_lookup_sqrt_24bit_float(float f)
 {
 	unsigned u = *(unsigned int*)&f;
 	u >>= 8;  // 32-24 bits
+	if (g_sqrt_float_24bit_precomp_table == NULL) {  // Not set up (aussie_precompute_sqrt)
+		static bool s_warned = false;
+		if (!s_warned) {
+			s_warned = true;
+			yassert(g_sqrt_float_24bit_precomp_table != NULL);
+		}
+		return sqrtf(f);
+	}
 	return g_sqrt_float_24bit_precomp_table[u];
 }
 
@@ -112,13 +133,14 @@ void aussie_precompute_sqrt()
 	);
 
 #define AUSSIE_SQRT_24bit_MAX (1u << 24) 
-	printf("INFO: Size of sqrt FLOAT 16-bit table of %d = %d\n", (int)AUSSIE_SQRT_24bit_MAX, (int)sizeof(g_sqrt_float_24bit_precomp_table));
-	aussie_generic_precompute_24bit_float(
-		g_sqrt_float_24bit_precomp_table,
-		(int)AUSSIE_SQRT_24bit_MAX, 
-		aussie_sqrtf_basic_float
-	);
-
+	printf("INFO: Size of sqrt FLOAT 24-bit table of %d = %d\n", (int)AUSSIE_SQRT_24bit_MAX, (int)(AUSSIE_SQRT_24bit_MAX * sizeof(float)));
+	// Mapped from $AUSSIE_TABLE_DIR (generated there the first time), else computed on the heap
+	char path[1000];
+	aussie_table_release(s_aussie_sqrt_24bit_table);
+	aussie_table_load(s_aussie_sqrt_24bit_table, aussie_table_default_path(path, (int)sizeof(path), AUSSIE_TABLE_FN_SQRT, 24),
+		AUSSIE_TABLE_FN_SQRT, 24, aussie_sqrtf_basic_float);
+	g_sqrt_float_24bit_precomp_table = s_aussie_sqrt_24bit_table.data;
+	yassert(g_sqrt_float_24bit_precomp_table != NULL);
 }
 
 //---------------------------------------------------
@@ -139,6 +161,326 @@ float aussie_table_lookup_sqrt2(int i)
 
 
 
+//---------------------------------------------------
+// FP8 decode tables
+//---------------------------------------------------
+
+float g_aussie_fp8_e4m3_table[256];
+float g_aussie_fp8_e5m2_table[256];
+
+static float aussie_fp8_e4m3_decode_int(int i)
+{
+	return aussie_fp8_e4m3_to_float32((yfp8_t)i);
+}
+
+static float aussie_fp8_e5m2_decode_int(int i)
+{
+	return aussie_fp8_e5m2_to_float32((yfp8_t)i);
+}
+
+static bool aussie_fp8_tables_build()
+{
+	aussie_generic_precompute_int(g_aussie_fp8_e4m3_table, 256, aussie_fp8_e4m3_decode_int);
+	aussie_generic_precompute_int(g_aussie_fp8_e5m2_table, 256, aussie_fp8_e5m2_decode_int);
+	return true;
+}
+
+void aussie_precompute_fp8_tables()  // Build both (once; cheap to call again)
+{
+	static const bool s_done = aussie_fp8_tables_build();  // Thread-safe static init: concurrent first calls wait
+	(void)s_done;
+}
+
+const float* aussie_fp8_table(int format)  // AUSSIE_FP8_* (builds the tables if needed)
+{
+	aussie_precompute_fp8_tables();
+	return format == AUSSIE_FP8_E5M2 ? g_aussie_fp8_e5m2_table : g_aussie_fp8_e4m3_table;
+}
+
+//---------------------------------------------------
+// Table files
+//---------------------------------------------------
+
+void aussie_precompute_table_FP32_generic_bits(float arr[], int bits, float (*fnptr)(float))  // Indexed by the top bits of the float
+{
+	unsigned int maxn = 1u << bits;
+	int shift = 32 - bits;  // Zeros in the least significant mantissa bits
+	for (unsigned int u = 0; u < maxn; u++) {
+		unsigned int uval = u << shift;
+		float f = AUSSIE_UINT_TO_FLOAT(uval);
+		arr[u] = (*fnptr)(f);
+	}
+}
+
+void aussie_precompute_table_FP32_range(float arr[], unsigned int n, float xmin, float xmax, float (*fnptr)(float))  // n evenly spaced x, both ends included
+{
+	// Breakpoints for interpolated tables (alut.h): x computed in double, so the last one is exactly xmax
+	yassert(n >= 2);
+	double step = ((double)xmax - (double)xmin) / (double)(n - 1);
+	for (unsigned int i = 0; i < n; i++) {
+		float x = (i == n - 1) ? xmax : (float)((double)xmin + step * i);
+		arr[i] = (*fnptr)(x);
+	}
+}
+
+struct aussie_precompute_bits_args {
+	float* arr;
+	int shift;
+	float (*fnptr)(float);
+};
+
+static void aussie_precompute_bits_chunk(int begin, int end, void* arg)  // Entries [begin,end) of a bits-indexed table
+{
+	aussie_precompute_bits_args* args = (aussie_precompute_bits_args*)arg;
+	float (*fnptr)(float) = args->fnptr;
+	for (int i = begin; i < end; i++) {
+		unsigned int uval = (unsigned int)i << args->shift;
+		float f = AUSSIE_UINT_TO_FLOAT(uval);
+		args->arr[i] = (*fnptr)(f);
+	}
+}
+
+void aussie_precompute_table_FP32_generic_bits_parallel(float arr[], int bits, float (*fnptr)(float))  // Chunks across the thread pool
+{
+	// Same table as aussie_precompute_table_FP32_generic_bits (each entry is written once, by one thread),
+	// so fnptr must be safe to call from several threads (no static state)
+	yassert(bits >= 1 && bits <= 30);
+	aussie_precompute_bits_args args;
+	args.arr = arr;
+	args.shift = 32 - bits;
+	args.fnptr = fnptr;
+	aussie_parallel_for(0, 1 << bits, AUSSIE_PRECOMPUTE_GRAIN, aussie_precompute_bits_chunk, &args);
+}
+
+unsigned long long aussie_table_checksum(const float arr[], unsigned long long count)  // 64-bit FNV-1a over the 32-bit words
+{
+	const unsigned int* words = (const unsigned int*)arr;
+	unsigned long long h = 14695981039346656037ULL;
+	for (unsigned long long i = 0; i < count; i++) {
+		h ^= words[i];
+		h *= 1099511628211ULL;
+	}
+	return h;
+}
+
+static bool aussie_table_bits_ok(int bits)
+{
+	if (bits < 1 || bits > 24) {
+		yassert(bits >= 1 && bits <= 24);  // 24 bits is already 64MB
+		return false;
+	}
+	return true;
+}
+
+static unsigned int aussie_table_function_version(int function_id)
+{
+	switch (function_id) {
+	case AUSSIE_TABLE_FN_GELU: return AUSSIE_TABLE_FN_GELU_VERSION;
+	case AUSSIE_TABLE_FN_SQRT: return AUSSIE_TABLE_FN_SQRT_VERSION;
+	default: return 0;
+	}
+}
+
+static const char* aussie_table_function_name(int function_id)
+{
+	switch (function_id) {
+	case AUSSIE_TABLE_FN_GELU: return "gelu";
+	case AUSSIE_TABLE_FN_SQRT: return "sqrt";
+	default: return "table";
+	}
+}
+
+const char* aussie_table_default_path(char buf[], int bufsize, int function_id, int bits)  // $AUSSIE_TABLE_DIR/aussie_gelu_24bits.tbl (NULL if unset)
+{
+	const char* dir = getenv("AUSSIE_TABLE_DIR");
+	if (dir == NULL || *dir == 0) return NULL;
+	snprintf(buf, bufsize, "%s/aussie_%s_%dbits.tbl", dir, aussie_table_function_name(function_id), bits);
+	return buf;
+}
+
+bool aussie_table_file_write(const char* fname, int function_id, int bits, const float arr[])
+{
+	if (!aussie_table_bits_ok(bits)) return false;  // fail
+	aussie_table_file_header hdr;
+	memset(&hdr, 0, sizeof(hdr));
+	memcpy(hdr.magic, AUSSIE_TABLE_FILE_MAGIC, sizeof(hdr.magic));
+	hdr.version = AUSSIE_TABLE_FILE_VERSION;
+	hdr.function_id = function_id;
+	hdr.function_version = aussie_table_function_version(function_id);
+	hdr.bits = bits;
+	hdr.data_offset = AUSSIE_TABLE_FILE_DATA_OFFSET;
+	hdr.count = 1ULL << bits;
+	hdr.checksum = aussie_table_checksum(arr, hdr.count);
+
+	// Write a temporary file of our own (unique name, created exclusively), flush it to disk,
+	// then rename it: no process ever maps half a table, even when several generate it at once
+	char tmpname[1000];
+	FILE* fp = NULL;
+#if LINUX
+	snprintf(tmpname, sizeof(tmpname), "%s.XXXXXX", fname);
+	int fd = mkstemp(tmpname);
+	if (fd >= 0) {
+		fchmod(fd, 0644);  // mkstemp makes it private: other users' processes map it too
+		fp = fdopen(fd, "wb");
+		if (!fp) close(fd);
+	}
+#else
+	snprintf(tmpname, sizeof(tmpname), "%s.%d.tmp", fname, (int)_getpid());
+	fp = fopen(tmpname, "wbx");  // Exclusive create
+#endif
+	if (!fp) {
+		fprintf(stderr, "ERROR: %s: Cannot write table file %s\n", __func__, tmpname);
+		return false;  // fail
+	}
+	static const char s_zeros[AUSSIE_TABLE_FILE_DATA_OFFSET] = { 0 };
+	bool ok = fwrite(&hdr, sizeof(hdr), 1, fp) == 1
+		&& fwrite(s_zeros, AUSSIE_TABLE_FILE_DATA_OFFSET - sizeof(hdr), 1, fp) == 1
+		&& fwrite(arr, sizeof(float), (size_t)hdr.count, fp) == (size_t)hdr.count;
+	if (fflush(fp) != 0) ok = false;
+#if LINUX
+	if (ok && fsync(fileno(fp)) != 0) ok = false;  // Data on disk before the name points at it
+#else
+	if (ok && _commit(_fileno(fp)) != 0) ok = false;
+#endif
+	if (fclose(fp) != 0) ok = false;
+#if !LINUX
+	if (ok) remove(fname);  // rename() won't replace a file on Windows
+#endif
+	if (!ok || rename(tmpname, fname) != 0) {
+		fprintf(stderr, "ERROR: %s: Cannot write table file %s\n", __func__, fname);
+		remove(tmpname);
+		return false;  // fail
+	}
+	return true;
+}
+
+bool aussie_table_file_generate(const char* fname, int function_id, int bits, float (*fnptr)(float))
+{
+	aussie_table t;
+	if (!aussie_table_compute(t, function_id, bits, fnptr)) return false;  // fail
+	bool ok = aussie_table_file_write(fname, function_id, bits, t.data);
+	aussie_table_release(t);
+	return ok;
+}
+
+static bool aussie_table_header_ok(const char* fname, const aussie_table_file_header& hdr, int function_id, int bits, unsigned long long filebytes)
+{
+	// A stale or foreign file is not an error: the caller regenerates it
+	const char* why = NULL;
+	if (memcmp(hdr.magic, AUSSIE_TABLE_FILE_MAGIC, sizeof(hdr.magic)) != 0) why = "not a table file";
+	else if (hdr.version != AUSSIE_TABLE_FILE_VERSION) why = "wrong version";
+	else if ((int)hdr.function_id != function_id) why = "wrong function";
+	else if (hdr.function_version != aussie_table_function_version(function_id)) why = "old function version";
+	else if ((int)hdr.bits != bits || hdr.count != (1ULL << bits)) why = "wrong bits";
+	else if (hdr.data_offset < sizeof(hdr) || hdr.data_offset % sizeof(float) != 0) why = "bad data offset";
+	else if (filebytes < hdr.data_offset + hdr.count * sizeof(float)) why = "truncated";
+	if (why) {
+		fprintf(stderr, "WARNING: %s: Table file %s: %s\n", __func__, fname, why);
+		return false;
+	}
+	return true;
+}
+
+static void aussie_table_clear(aussie_table& t)
+{
+	memset(&t, 0, sizeof(t));
+}
+
+bool aussie_table_file_map(const char* fname, int function_id, int bits, aussie_table& t, bool verify_checksum /*= false*/)  // Read-only
+{
+	aussie_table_clear(t);
+	if (!aussie_table_bits_ok(bits)) return false;  // fail
+	aussie_table_file_header hdr;
+#if LINUX
+	int fd = open(fname, O_RDONLY);
+	if (fd < 0) return false;  // No file (yet)
+	struct stat st;
+	if (fstat(fd, &st) != 0 || read(fd, &hdr, sizeof(hdr)) != (ssize_t)sizeof(hdr)
+		|| !aussie_table_header_ok(fname, hdr, function_id, bits, (unsigned long long)st.st_size)) {
+		close(fd);
+		return false;
+	}
+	void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);  // The mapping stays
+	if (map == MAP_FAILED) {
+		fprintf(stderr, "ERROR: %s: Cannot map table file %s\n", __func__, fname);
+		return false;  // fail
+	}
+	t.mapping = map;
+	t.mapbytes = (size_t)st.st_size;
+	t.data = (const float*)((const char*)map + hdr.data_offset);
+#else
+	// No mmap: read a private copy
+	FILE* fp = fopen(fname, "rb");
+	if (!fp) return false;  // No file (yet)
+	fseek(fp, 0, SEEK_END);
+	unsigned long long filebytes = (unsigned long long)ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+	if (fread(&hdr, sizeof(hdr), 1, fp) != 1 || !aussie_table_header_ok(fname, hdr, function_id, bits, filebytes)) {
+		fclose(fp);
+		return false;
+	}
+	t.heap = (float*)malloc((size_t)hdr.count * sizeof(float));
+	fseek(fp, hdr.data_offset, SEEK_SET);
+	bool ok = t.heap != NULL && fread(t.heap, sizeof(float), (size_t)hdr.count, fp) == (size_t)hdr.count;
+	fclose(fp);
+	if (!ok) {
+		fprintf(stderr, "ERROR: %s: Cannot read table file %s\n", __func__, fname);
+		aussie_table_release(t);
+		return false;  // fail
+	}
+	t.data = t.heap;
+#endif //LINUX
+	t.count = hdr.count;
+	t.function_id = function_id;
+	t.bits = bits;
+	if (verify_checksum && aussie_table_checksum(t.data, t.count) != hdr.checksum) {  // Reads every page
+		fprintf(stderr, "WARNING: %s: Table file %s: bad checksum\n", __func__, fname);
+		aussie_table_release(t);
+		return false;
+	}
+	return true;
+}
+
+bool aussie_table_compute(aussie_table& t, int function_id, int bits, float (*fnptr)(float))  // Heap, no file
+{
+	aussie_table_clear(t);
+	if (!aussie_table_bits_ok(bits)) return false;  // fail
+	t.count = 1ULL << bits;
+	t.heap = (float*)malloc((size_t)t.count * sizeof(float));
+	if (t.heap == NULL) {
+		yassert(t.heap != NULL);
+		aussie_table_clear(t);
+		return false;  // fail
+	}
+	aussie_precompute_table_FP32_generic_bits_parallel(t.heap, bits, fnptr);
+	t.data = t.heap;
+	t.function_id = function_id;
+	t.bits = bits;
+	return true;
+}
+
+bool aussie_table_load(aussie_table& t, const char* fname, int function_id, int bits, float (*fnptr)(float))  // Map, else generate the file and map, else compute
+{
+	if (fname != NULL) {
+		if (aussie_table_file_map(fname, function_id, bits, t)) return true;
+		if (aussie_table_file_generate(fname, function_id, bits, fnptr)
+			&& aussie_table_file_map(fname, function_id, bits, t)) {
+			return true;
+		}
+	}
+	return aussie_table_compute(t, function_id, bits, fnptr);
+}
+
+void aussie_table_release(aussie_table& t)
+{
+#if LINUX
+	if (t.mapping) munmap(t.mapping, t.mapbytes);
+#endif //LINUX
+	if (t.heap) free(t.heap);
+	aussie_table_clear(t);
+}
+
 //---------------------------------------------------
 //---------------------------------------------------
 
@@ -165,6 +507,87 @@ void aussie_test_sqrt_int(int i)
 
 }
 
+static void aussie_table_test_writer_task(int itask, void* arg)
+{
+	ytest(aussie_table_file_generate((const char*)arg, AUSSIE_TABLE_FN_SQRT, 16, aussie_sqrtf_basic_float));
+}
+
+static void aussie_unit_test_table_files()
+{
+	// Generate a 16-bit sqrt table file, map it, and compare with the computed table
+	const char* path = "aussie_table_unit_test.tbl";
+	int bits = 16;
+	aussie_table tc, tm;
+	ytest(aussie_table_compute(tc, AUSSIE_TABLE_FN_SQRT, bits, aussie_sqrtf_basic_float));
+	ytest(tc.count == (1ULL << bits) && tc.mapping == NULL);
+	ytestf(tc.data[0], 0.0f);  // sqrt(+0)
+	float* seq = (float*)malloc((size_t)tc.count * sizeof(float));  // Parallel generation: identical to one thread
+	aussie_precompute_table_FP32_generic_bits(seq, bits, aussie_sqrtf_basic_float);
+	ytest(memcmp(seq, tc.data, (size_t)tc.count * sizeof(float)) == 0);
+	free(seq);
+	remove(path);
+	ytest(!aussie_table_file_map(path, AUSSIE_TABLE_FN_SQRT, bits, tm));  // Missing file
+	ytest(aussie_table_file_generate(path, AUSSIE_TABLE_FN_SQRT, bits, aussie_sqrtf_basic_float));
+	ytest(aussie_table_file_map(path, AUSSIE_TABLE_FN_SQRT, bits, tm, true));
+	ytest(tm.count == tc.count && tm.data != NULL);
+	ytest(((size_t)tm.data % 64) == 0);
+	ytest(memcmp(tm.data, tc.data, (size_t)tc.count * sizeof(float)) == 0);
+	float f = 2.0f;
+	ytestf(tm.data[AUSSIE_FLOAT_TO_UINT(f) >> (32 - bits)], sqrtf(2.0f));  // 2.0 is exact in 16 bits
+	aussie_table_release(tm);
+	ytest(tm.data == NULL);
+
+	// Wrong function or bits: rejected (a warning), not an error
+	ytest(!aussie_table_file_map(path, AUSSIE_TABLE_FN_GELU, bits, tm));
+	ytest(!aussie_table_file_map(path, AUSSIE_TABLE_FN_SQRT, 15, tm));
+
+	// A corrupted float: only the checksum notices
+	FILE* fp = fopen(path, "r+b");
+	if (fp) {
+		fseek(fp, AUSSIE_TABLE_FILE_DATA_OFFSET + 1000 * sizeof(float), SEEK_SET);
+		float bad = -1.0f;
+		fwrite(&bad, sizeof(bad), 1, fp);
+		fclose(fp);
+		ytest(aussie_table_file_map(path, AUSSIE_TABLE_FN_SQRT, bits, tm));
+		aussie_table_release(tm);
+		ytest(!aussie_table_file_map(path, AUSSIE_TABLE_FN_SQRT, bits, tm, true));
+	}
+
+	// A file from an older implementation of the function: rejected, then regenerated by load
+	ytest(aussie_table_file_generate(path, AUSSIE_TABLE_FN_SQRT, bits, aussie_sqrtf_basic_float));
+	fp = fopen(path, "r+b");
+	if (fp) {
+		aussie_table_file_header hdr;
+		ytest(fread(&hdr, sizeof(hdr), 1, fp) == 1);
+		hdr.function_version = AUSSIE_TABLE_FN_SQRT_VERSION - 1;
+		fseek(fp, 0, SEEK_SET);
+		fwrite(&hdr, sizeof(hdr), 1, fp);
+		fclose(fp);
+		ytest(!aussie_table_file_map(path, AUSSIE_TABLE_FN_SQRT, bits, tm));
+		ytest(aussie_table_load(tm, path, AUSSIE_TABLE_FN_SQRT, bits, aussie_sqrtf_basic_float));
+		ytest(tm.mapping != NULL);
+		aussie_table_release(tm);
+	}
+
+	// Load: regenerates a file that doesn't match, then maps it
+	ytest(aussie_table_load(tm, path, AUSSIE_TABLE_FN_SQRT, 14, aussie_sqrtf_basic_float));
+	ytest(tm.bits == 14 && tm.count == (1ULL << 14));
+	ytestf(tm.data[AUSSIE_FLOAT_TO_UINT(f) >> 18], tc.data[AUSSIE_FLOAT_TO_UINT(f) >> 16]);  // Same float prefix
+	aussie_table_release(tm);
+	ytest(aussie_table_load(tm, NULL, AUSSIE_TABLE_FN_SQRT, bits, aussie_sqrtf_basic_float));  // No file: computed
+	ytest(tm.heap != NULL && tm.data[12345] == tc.data[12345]);
+	aussie_table_release(tm);
+
+	// Several writers at once (each with its own temporary file): the result is always a whole table
+	remove(path);
+	aussie_parallel_run(4, aussie_table_test_writer_task, (void*)path, AUSSIE_SCHEDULE_STATIC);
+	ytest(aussie_table_file_map(path, AUSSIE_TABLE_FN_SQRT, bits, tm, true));
+	ytest(tm.count == tc.count && memcmp(tm.data, tc.data, (size_t)tc.count * sizeof(float)) == 0);
+	aussie_table_release(tm);
+	aussie_table_release(tc);
+	remove(path);
+}
+
 void aussie_unit_test_precompute()
 {
 	fprintf(stderr, "INFO: %s: Running unit tests\n", __func__);
@@ -173,6 +596,17 @@ void aussie_unit_test_precompute()
 	for (int i = 0; i < 1000; i++) {
 		aussie_test_sqrt_int(i);
 	}
+
+	// FP8 tables match the conversions bit for bit (NaN codes too)
+	int nbad = 0;
+	for (int i = 0; i < 256; i++) {
+		float f1 = aussie_fp8_e4m3_to_float32((yfp8_t)i), f2 = aussie_fp8_e5m2_to_float32((yfp8_t)i);
+		if (memcmp(&aussie_fp8_table(AUSSIE_FP8_E4M3)[i], &f1, sizeof(float)) != 0) nbad++;
+		if (memcmp(&aussie_fp8_table(AUSSIE_FP8_E5M2)[i], &f2, sizeof(float)) != 0) nbad++;
+	}
+	ytesti(nbad, 0);
+
+	aussie_unit_test_table_files();
 }
 //---------------------------------------------------
 //---------------------------------------------------
@@ -208,6 +642,11 @@ void aussie_generic_setup_table_FP32_24bits_PRINT_SOURCE( // Print C++ of 24-bit
 	}
 	// Generate C++ source code so we can pre-compile the precomputed GELU table (24-bits)
 	// There are 2^24 = 16.7 million numbers...
+	// ... too many for most compilers: use the table files (aussie_table_load) for 24 bits,
+	//     and aussie_constexpr_table_bits (aconstexpr.h) for tables the compiler can build itself
+	if (maxn > AUSSIE_CONSTEXPR_MAX_ENTRIES) {
+		fprintf(stderr, "WARNING: %s: %u entries of C++ source (%s); compilers may not cope\n", __func__, maxn, nickname);
+	}
 	FILE* fp = stdout;
 	bool writingfile = false;
 	bool add_commented_number = true;
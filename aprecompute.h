@@ -36,6 +36,72 @@ void aussie_generic_setup_table_FP32_24bits_PRINT_SOURCE( // Print C++ of 24-bit
 	float arrout[]  // array to store (optional, can be NULL)
 );
 
+void aussie_generic_precompute_int(float arr[], unsigned int maxn, float (*fnptr)(int));  // arr[i] = fn(i)
+void aussie_precompute_table_FP32_generic_bits(float arr[], int bits, float (*fnptr)(float));  // Indexed by the top bits of the float
+void aussie_precompute_table_FP32_range(float arr[], unsigned int n, float xmin, float xmax, float (*fnptr)(float));  // n evenly spaced x, both ends included
+
+#define AUSSIE_PRECOMPUTE_GRAIN  (1 << 16)   // Entries per parallel task (256 tasks for a 24-bit table)
+void aussie_precompute_table_FP32_generic_bits_parallel(float arr[], int bits, float (*fnptr)(float));  // Same table, chunks across the thread pool (athread.h)
+
+//-----------------------------------------------
+// Table files: a precomputed float table on disk, generated once and then mmap'd read-only
+// ... processes on one host share the same pages, and loading costs a map, not 16M function calls
+// ... layout: one page of header (aussie_table_file_header), then the floats (page-aligned)
+// ... the table is indexed by the top "bits" bits of a float (24 bits = 64MB of floats)
+//-----------------------------------------------
+
+#define AUSSIE_TABLE_FILE_MAGIC    "AUSSITBL"  // 8 bytes, no terminator in the file
+#define AUSSIE_TABLE_FILE_VERSION  2   // File layout (2: function_version added)
+#define AUSSIE_TABLE_FILE_DATA_OFFSET 4096   // Floats start on a page boundary
+
+#define AUSSIE_TABLE_FN_GELU  1
+#define AUSSIE_TABLE_FN_SQRT  2
+
+// Version of each function's implementation: bump it when the function changes
+// (e.g. aussie_GELU_basic), so files generated by the old code are regenerated
+#define AUSSIE_TABLE_FN_GELU_VERSION  1   // aussie_GELU_basic
+#define AUSSIE_TABLE_FN_SQRT_VERSION  1   // aussie_sqrtf_basic_float
+
+struct aussie_table_file_header {
+	char magic[8];                 // AUSSIE_TABLE_FILE_MAGIC
+	unsigned int version;          // AUSSIE_TABLE_FILE_VERSION
+	unsigned int function_id;      // AUSSIE_TABLE_FN_*
+	unsigned int function_version; // AUSSIE_TABLE_FN_*_VERSION when the file was written
+	unsigned int bits;             // Index bits (count = 1 << bits)
+	unsigned int data_offset;      // Bytes from the start of the file to the floats
+	unsigned long long count;      // Floats in the table
+	unsigned long long checksum;   // aussie_table_checksum of the floats
+};
+
+struct aussie_table {  // A loaded table (mapped file, or computed on the heap)
+	const float* data;
+	unsigned long long count;
+	int function_id;
+	int bits;
+	void* mapping;      // mmap'd file (NULL if computed)
+	size_t mapbytes;
+	float* heap;        // Computed or read copy (NULL if mapped)
+};
+
+unsigned long long aussie_table_checksum(const float arr[], unsigned long long count);  // 64-bit FNV-1a over the 32-bit words
+bool aussie_table_file_write(const char* fname, int function_id, int bits, const float arr[]);
+bool aussie_table_file_generate(const char* fname, int function_id, int bits, float (*fnptr)(float));
+bool aussie_table_file_map(const char* fname, int function_id, int bits, aussie_table& t, bool verify_checksum = false);  // Read-only
+bool aussie_table_compute(aussie_table& t, int function_id, int bits, float (*fnptr)(float));  // Heap, no file
+bool aussie_table_load(aussie_table& t, const char* fname, int function_id, int bits, float (*fnptr)(float));  // Map, else generate the file and map, else compute
+void aussie_table_release(aussie_table& t);
+const char* aussie_table_default_path(char buf[], int bufsize, int function_id, int bits);  // $AUSSIE_TABLE_DIR/aussie_gelu_24bits.tbl (NULL if unset)
+
+//-----------------------------------------------
+// FP8 decode tables: 256 floats each, indexed by the FP8 byte (afloat.h formats)
+//-----------------------------------------------
+
+extern float g_aussie_fp8_e4m3_table[256];
+extern float g_aussie_fp8_e5m2_table[256];
+
+void aussie_precompute_fp8_tables();  // Build both (once; cheap to call again)
+const float* aussie_fp8_table(int format);  // AUSSIE_FP8_* (builds the tables if needed)
+
 //-----------------------------------------------
 //-----------------------------------------------
 
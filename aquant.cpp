@@ -0,0 +1,896 @@
+// aquant.cpp -- INT8 and 4-bit quantized weights and GEMV -- Aussie AI Base Library
+// Created Oct 17th 2026
+// Copyright (c) 2023 Aussie AI Labs Pty Ltd
+//---------------------------------------------------
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <math.h>
+
+#include "aport.h"
+
+#if AUSSIE_X86
+#include <immintrin.h>  // AVX-2 maddubs, AVX-512 VNNI
+#endif //AUSSIE_X86
+#if !LINUX
+#include <malloc.h>  // _aligned_malloc
+#endif
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+#include "aussieai.h"
+#include "aassert.h"
+#include "atest.h"
+#include "adispatch.h"
+#include "athread.h"
+#include "afloat.h"
+#include "amatmul.h"
+
+#include "aquant.h"  // self-include
+
+//---------------------------------------------------
+// Quantization
+//---------------------------------------------------
+
+static float aussie_q8_quantize_group(const float v[], int n, signed char q[])  // Returns the scale
+{
+	float maxabs = 0.0f;
+	for (int i = 0; i < n; i++) {
+		float f = fabsf(v[i]);
+		if (f > maxabs) maxabs = f;
+	}
+	if (maxabs == 0.0f) {  // All zeros (and the padding)
+		memset(q, 0, n);
+		return 0.0f;
+	}
+	float scale = maxabs / 127.0f;
+	float recip = 127.0f / maxabs;
+	for (int i = 0; i < n; i++) {
+		int iq = (int)lrintf(v[i] * recip);  // Round to nearest
+		if (iq > 127) iq = 127;
+		if (iq < -127) iq = -127;  // Symmetric: -128 is never used
+		q[i] = (signed char)iq;
+	}
+	return scale;
+}
+
+static bool aussie_q8_layout(int ncols, int groupsize, int& ldq, int& groupsize_out, int& ngroups)
+{
+	if (ncols < 0 || groupsize < 0 || groupsize % AUSSIE_Q8_BLOCK != 0 || groupsize > AUSSIE_Q8_MAX_GROUP) {
+		yassert(ncols >= 0 && groupsize >= 0);
+		yassert(groupsize % AUSSIE_Q8_BLOCK == 0 && groupsize <= AUSSIE_Q8_MAX_GROUP);
+		return false;  // fail
+	}
+	ldq = (ncols + AUSSIE_Q8_BLOCK - 1) / AUSSIE_Q8_BLOCK * AUSSIE_Q8_BLOCK;
+	if (ldq == 0) ldq = AUSSIE_Q8_BLOCK;  // Empty rows still have one (zero) block
+	if (groupsize == 0) {  // Per-row scales
+		if (ldq > AUSSIE_Q8_MAX_GROUP) {
+			yassert(ldq <= AUSSIE_Q8_MAX_GROUP);  // Use groups for longer rows
+			return false;  // fail
+		}
+		groupsize = ldq;
+	}
+	ldq = (ldq + groupsize - 1) / groupsize * groupsize;  // Whole groups
+	groupsize_out = groupsize;
+	ngroups = ldq / groupsize;
+	return true;
+}
+
+bool aussie_q8_matrix_quantize(aussie_q8_matrix& m, const float* W, int nrows, int ncols, int ldw, int groupsize)  // groupsize 0 = per-row
+{
+	memset(&m, 0, sizeof(m));
+	if (W == NULL || nrows < 0 || ldw < ncols) {
+		yassert(W != NULL && nrows >= 0 && ldw >= ncols);
+		return false;  // fail
+	}
+	if (!aussie_q8_layout(ncols, groupsize, m.ldq, m.groupsize, m.ngroups)) return false;  // fail
+	m.nrows = nrows;
+	m.ncols = ncols;
+	size_t nbytes = (size_t)(nrows > 0 ? nrows : 1) * m.ldq;
+	m.q = (signed char*)AUSSIE_ALIGNED_MALLOC(nbytes, 64);
+	m.scales = (float*)malloc((size_t)(nrows > 0 ? nrows : 1) * m.ngroups * sizeof(float));
+	float* row = (float*)malloc(m.ldq * sizeof(float));
+	if (!m.q || !m.scales || !row) {
+		yassert(m.q && m.scales && row);
+		free(row);
+		aussie_q8_matrix_free(m);
+		return false;  // fail
+	}
+	for (int i = 0; i < nrows; i++) {
+		memcpy(row, &W[(long long)i * ldw], ncols * sizeof(float));
+		for (int j = ncols; j < m.ldq; j++) row[j] = 0.0f;  // Padding quantizes to zero
+		for (int g = 0; g < m.ngroups; g++) {
+			m.scales[(long long)i * m.ngroups + g] = aussie_q8_quantize_group(&row[g * m.groupsize], m.groupsize,
+				&m.q[(long long)i * m.ldq + g * m.groupsize]);
+		}
+	}
+	free(row);
+	return true;
+}
+
+void aussie_q8_matrix_free(aussie_q8_matrix& m)
+{
+	if (m.q) AUSSIE_ALIGNED_FREE(m.q);
+	free(m.scales);
+	memset(&m, 0, sizeof(m));
+}
+
+void aussie_q8_matrix_dequantize_row(const aussie_q8_matrix& m, int row, float out[])  // ncols floats
+{
+	if (row < 0 || row >= m.nrows) {
+		yassert(row >= 0 && row < m.nrows);
+		return;  // fail
+	}
+	const signed char* q = &m.q[(long long)row * m.ldq];
+	const float* scales = &m.scales[(long long)row * m.ngroups];
+	for (int j = 0; j < m.ncols; j++) out[j] = scales[j / m.groupsize] * q[j];
+}
+
+bool aussie_q8_vector_init(aussie_q8_vector& x, const aussie_q8_matrix& m)  // Scratch for this matrix's input
+{
+	memset(&x, 0, sizeof(x));
+	x.n = m.ncols;
+	x.ldq = m.ldq;
+	x.groupsize = m.groupsize;
+	x.ngroups = m.ngroups;
+	x.q = (signed char*)AUSSIE_ALIGNED_MALLOC(x.ldq, 64);
+	x.scales = (float*)malloc(x.ngroups * sizeof(float));
+	if (!x.q || !x.scales || x.ldq <= 0) {
+		yassert(x.q && x.scales && x.ldq > 0);
+		aussie_q8_vector_free(x);
+		return false;  // fail
+	}
+	memset(x.q, 0, x.ldq);
+	for (int g = 0; g < x.ngroups; g++) x.scales[g] = 0.0f;
+	return true;
+}
+
+void aussie_q8_vector_free(aussie_q8_vector& x)
+{
+	if (x.q) AUSSIE_ALIGNED_FREE(x.q);
+	free(x.scales);
+	memset(&x, 0, sizeof(x));
+}
+
+void aussie_q8_vector_quantize(aussie_q8_vector& x, const float v[])  // x.n floats
+{
+	for (int g = 0; g < x.ngroups; g++) {
+		int start = g * x.groupsize;
+		int len = x.n - start;  // Only the real elements (the padding stays zero)
+		if (len > x.groupsize) len = x.groupsize;
+		if (len <= 0) {
+			x.scales[g] = 0.0f;
+			continue;
+		}
+		x.scales[g] = aussie_q8_quantize_group(&v[start], len, &x.q[start]);
+	}
+}
+
+//---------------------------------------------------
+// Row kernels
+//---------------------------------------------------
+
+float aussie_q8_vecdot_basic(const signed char wq[], const float wscales[], const signed char xq[], const float xscales[], int ngroups, int groupsize)
+{
+	float sum = 0.0f;
+	for (int g = 0; g < ngroups; g++) {
+		int isum = 0;  // Exact
+		const signed char* w = &wq[g * groupsize];
+		const signed char* x = &xq[g * groupsize];
+		for (int j = 0; j < groupsize; j++) isum += (int)w[j] * (int)x[j];
+		sum += (float)isum * (wscales[g] * xscales[g]);  // Dequantize once per group
+	}
+	return sum;
+}
+
+#if AUSSIE_X86
+
+AUSSIE_TARGET_AVX2 float aussie_q8_vecdot_AVX2(const signed char wq[], const float wscales[], const signed char xq[], const float xscales[], int ngroups, int groupsize)
+{
+	// maddubs multiplies unsigned by signed bytes, so use |x| and w * sign(x)
+	const __m256i ones = _mm256_set1_epi16(1);
+	__m256 facc = _mm256_setzero_ps();
+	for (int g = 0; g < ngroups; g++) {
+		const signed char* w = &wq[g * groupsize];
+		const signed char* x = &xq[g * groupsize];
+		__m256i iacc = _mm256_setzero_si256();  // 8 int32 partial sums
+		for (int j = 0; j < groupsize; j += AUSSIE_Q8_BLOCK) {
+			__m256i wv = _mm256_loadu_si256((const __m256i*)&w[j]);
+			__m256i xv = _mm256_loadu_si256((const __m256i*)&x[j]);
+			__m256i xabs = _mm256_sign_epi8(xv, xv);   // |x| (fits unsigned, never -128)
+			__m256i wsgn = _mm256_sign_epi8(wv, xv);   // w * sign(x)
+			__m256i p16 = _mm256_maddubs_epi16(xabs, wsgn);  // Pairs: at most 2*127*127, no saturation
+			iacc = _mm256_add_epi32(iacc, _mm256_madd_epi16(p16, ones));  // Pairs of pairs into int32
+		}
+		__m256 scale = _mm256_set1_ps(wscales[g] * xscales[g]);
+		facc = _mm256_fmadd_ps(_mm256_cvtepi32_ps(iacc), scale, facc);  // Dequantize once per group
+	}
+	float* farr = (float*)&facc;
+	return farr[0] + farr[1] + farr[2] + farr[3] + farr[4] + farr[5] + farr[6] + farr[7];
+}
+
+AUSSIE_TARGET_AVX512_VNNI float aussie_q8_vecdot_AVX512_VNNI(const signed char wq[], const float wscales[], const signed char xq[], const float xscales[], int ngroups, int groupsize)
+{
+	// dpbusd: 4 unsigned-by-signed byte products added into each int32 (same |x| and w * sign(x) trick)
+	const __m512i zero = _mm512_setzero_si512();
+	__m512 facc = _mm512_setzero_ps();
+	for (int g = 0; g < ngroups; g++) {
+		const signed char* w = &wq[g * groupsize];
+		const signed char* x = &xq[g * groupsize];
+		__m512i iacc = _mm512_setzero_si512();
+		int j = 0;
+		for (; j + 64 <= groupsize; j += 64) {
+			__m512i wv = _mm512_loadu_si512((const void*)&w[j]);
+			__m512i xv = _mm512_loadu_si512((const void*)&x[j]);
+			__mmask64 neg = _mm512_movepi8_mask(xv);   // Negative x bytes
+			__m512i wsgn = _mm512_mask_sub_epi8(wv, neg, zero, wv);  // w * sign(x) (x == 0 adds nothing)
+			iacc = _mm512_dpbusd_epi32(iacc, _mm512_abs_epi8(xv), wsgn);
+		}
+		if (j < groupsize) {  // Last 32 bytes (groups are multiples of 32)
+			__m256i wv = _mm256_loadu_si256((const __m256i*)&w[j]);
+			__m256i xv = _mm256_loadu_si256((const __m256i*)&x[j]);
+			__m256i iacc256 = _mm256_dpbusd_epi32(_mm256_setzero_si256(), _mm256_sign_epi8(xv, xv), _mm256_sign_epi8(wv, xv));
+			iacc = _mm512_add_epi32(iacc, _mm512_zextsi256_si512(iacc256));
+		}
+		__m512 scale = _mm512_set1_ps(wscales[g] * xscales[g]);
+		facc = _mm512_fmadd_ps(_mm512_cvtepi32_ps(iacc), scale, facc);  // Dequantize once per group
+	}
+	return _mm512_reduce_add_ps(facc);
+}
+
+#else
+
+float aussie_q8_vecdot_AVX2(const signed char wq[], const float wscales[], const signed char xq[], const float xscales[], int ngroups, int groupsize)
+{
+	return aussie_q8_vecdot_basic(wq, wscales, xq, xscales, ngroups, groupsize);
+}
+
+float aussie_q8_vecdot_AVX512_VNNI(const signed char wq[], const float wscales[], const signed char xq[], const float xscales[], int ngroups, int groupsize)
+{
+	return aussie_q8_vecdot_basic(wq, wscales, xq, xscales, ngroups, groupsize);
+}
+
+#endif //AUSSIE_X86
+
+static aussie_q8_vecdot_fnptr aussie_q8_kernel(int isa)
+{
+	if (isa >= AUSSIE_ISA_AVX512 && aussie_cpu_has_avx512_vnni()) return aussie_q8_vecdot_AVX512_VNNI;
+	if (isa >= AUSSIE_ISA_AVX2 && aussie_cpu_has_avx2()) return aussie_q8_vecdot_AVX2;  // Also AVX-512 without VNNI
+	return aussie_q8_vecdot_basic;
+}
+
+//---------------------------------------------------
+// GEMV
+//---------------------------------------------------
+
+struct aussie_q8_gemv_job {
+	const aussie_q8_matrix* m;
+	const aussie_q8_vector* x;
+	float* vout;
+	int ntasks;
+	aussie_q8_vecdot_fnptr vecdot;
+};
+
+static void aussie_q8_gemv_rows(const aussie_q8_gemv_job* job, int rowstart, int rowend)
+{
+	const aussie_q8_matrix& m = *job->m;
+	for (int i = rowstart; i < rowend; i++) {
+		job->vout[i] = job->vecdot(&m.q[(long long)i * m.ldq], &m.scales[(long long)i * m.ngroups],
+			job->x->q, job->x->scales, m.ngroups, m.groupsize);
+	}
+}
+
+static void aussie_q8_gemv_task(int itask, void* arg)
+{
+	// Static: one contiguous block of rows per thread (same rows every call, like aussie_gemv_parallel)
+	const aussie_q8_gemv_job* job = (const aussie_q8_gemv_job*)arg;
+	int nrows = job->m->nrows;
+	int rowstart = (int)(((long long)nrows * itask) / job->ntasks);
+	int rowend = (int)(((long long)nrows * (itask + 1)) / job->ntasks);
+	aussie_q8_gemv_rows(job, rowstart, rowend);
+}
+
+static bool aussie_q8_gemv_setup(aussie_q8_gemv_job& job, int isa, const aussie_q8_matrix& m, const aussie_q8_vector& x, float vout[])
+{
+	if (m.q == NULL || x.q == NULL || vout == NULL || x.ldq != m.ldq || x.groupsize != m.groupsize) {
+		yassert(m.q != NULL && x.q != NULL && vout != NULL);
+		yassert(x.ldq == m.ldq && x.groupsize == m.groupsize);  // Use aussie_q8_vector_init(x, m)
+		return false;  // fail
+	}
+	job.m = &m;
+	job.x = &x;
+	job.vout = vout;
+	job.ntasks = 1;
+	job.vecdot = aussie_q8_kernel(isa);
+	return true;
+}
+
+void aussie_q8_gemv_isa(int isa, const aussie_q8_matrix& m, const aussie_q8_vector& x, float vout[])  // Force a kernel, one thread
+{
+	aussie_q8_gemv_job job;
+	if (!aussie_q8_gemv_setup(job, isa, m, x, vout)) return;  // fail
+	aussie_q8_gemv_rows(&job, 0, m.nrows);
+}
+
+void aussie_q8_gemv_quantized(const aussie_q8_matrix& m, const aussie_q8_vector& x, float vout[])  // Already quantized input (thread pool)
+{
+	aussie_dispatch_ensure();
+	aussie_q8_gemv_job job;
+	if (!aussie_q8_gemv_setup(job, g_aussie_dispatch.isa, m, x, vout)) return;  // fail
+	int nthreads = aussie_thread_count();
+	job.ntasks = m.nrows < nthreads ? m.nrows : nthreads;
+	if (job.ntasks <= 1) {
+		aussie_q8_gemv_rows(&job, 0, m.nrows);
+		return;
+	}
+	aussie_parallel_run(job.ntasks, aussie_q8_gemv_task, &job, AUSSIE_SCHEDULE_STATIC);
+}
+
+void aussie_q8_gemv(const aussie_q8_matrix& m, const float v[], aussie_q8_vector& x, float vout[])  // Quantize v into x, then rows across the thread pool
+{
+	if (v == NULL || x.q == NULL) {
+		yassert(v != NULL && x.q != NULL);
+		return;  // fail
+	}
+	aussie_q8_vector_quantize(x, v);  // Once per call, shared by all rows
+	aussie_q8_gemv_quantized(m, x, vout);
+}
+
+//---------------------------------------------------
+// 4-bit grouped weights (Q4)
+//---------------------------------------------------
+
+static void aussie_q4_quantize_group(const float v[], int n, int groupsize, bool with_min, unsigned char q[], yfp16_t& scale_out, yfp16_t& min_out)
+{
+	// n real weights (the last group can be short), packed into groupsize / 2 bytes
+	float vmin = 0.0f, vmax = 0.0f, vbig = 0.0f;  // vbig: the weight with the largest magnitude
+	for (int i = 0; i < n; i++) {
+		if (i == 0 || v[i] < vmin) vmin = v[i];
+		if (i == 0 || v[i] > vmax) vmax = v[i];
+		if (fabsf(v[i]) > fabsf(vbig)) vbig = v[i];
+	}
+	// Quantize with the FP16-rounded scale and min, the same values the kernels will use
+	float scale = 0.0f, fmin = 0.0f;
+	if (with_min) {
+		min_out = aussie_float32_to_float16(vmin);
+		fmin = aussie_float16_to_float32(min_out);
+		scale_out = aussie_float32_to_float16((vmax - fmin) / 15.0f);
+	}
+	else {
+		min_out = 0;
+		scale_out = aussie_float32_to_float16(vbig / -8.0f);  // vbig maps to q=0 exactly, the other side gets 7 steps
+	}
+	scale = aussie_float16_to_float32(scale_out);
+	float recip = (scale != 0.0f) ? 1.0f / scale : 0.0f;
+
+	int half = groupsize / 2;
+	memset(q, with_min ? 0 : 0x88, half);  // Padding is weight zero (symmetric) or the min
+	for (int i = 0; i < n; i++) {
+		int iq = with_min ? (int)lrintf((v[i] - fmin) * recip) : (int)lrintf(v[i] * recip) + 8;
+		if (iq < 0) iq = 0;
+		if (iq > 15) iq = 15;
+		int byte = i < half ? i : i - half;
+		if (i < half) q[byte] = (unsigned char)((q[byte] & 0xF0) | iq);
+		else q[byte] = (unsigned char)((q[byte] & 0x0F) | (iq << 4));
+	}
+}
+
+bool aussie_q4_matrix_quantize(aussie_q4_matrix& m, const float* W, int nrows, int ncols, int ldw, int groupsize, bool with_min)
+{
+	memset(&m, 0, sizeof(m));
+	if (W == NULL || nrows < 0 || ncols < 0 || ldw < ncols || groupsize < AUSSIE_Q8_BLOCK || groupsize % AUSSIE_Q8_BLOCK != 0) {
+		yassert(W != NULL && nrows >= 0 && ncols >= 0 && ldw >= ncols);
+		yassert(groupsize >= AUSSIE_Q8_BLOCK && groupsize % AUSSIE_Q8_BLOCK == 0);  // 32 or 64
+		return false;  // fail
+	}
+	m.nrows = nrows;
+	m.ncols = ncols;
+	m.groupsize = groupsize;
+	m.ngroups = (ncols + groupsize - 1) / groupsize;
+	if (m.ngroups == 0) m.ngroups = 1;
+	m.ldq = m.ngroups * groupsize;
+	size_t nrows1 = (size_t)(nrows > 0 ? nrows : 1);
+	m.q = (unsigned char*)AUSSIE_ALIGNED_MALLOC(nrows1 * (m.ldq / 2), 64);
+	m.scales = (yfp16_t*)malloc(nrows1 * m.ngroups * sizeof(yfp16_t));
+	if (with_min) m.mins = (yfp16_t*)malloc(nrows1 * m.ngroups * sizeof(yfp16_t));
+	if (!m.q || !m.scales || (with_min && !m.mins)) {
+		yassert(m.q && m.scales && (!with_min || m.mins));
+		aussie_q4_matrix_free(m);
+		return false;  // fail
+	}
+	for (int i = 0; i < nrows; i++) {
+		for (int g = 0; g < m.ngroups; g++) {
+			int start = g * groupsize;
+			int len = ncols - start < groupsize ? ncols - start : groupsize;
+			long long k = (long long)i * m.ngroups + g;
+			yfp16_t fmin = 0;
+			aussie_q4_quantize_group(&W[(long long)i * ldw + start], len, groupsize, with_min,
+				&m.q[(long long)i * (m.ldq / 2) + start / 2], m.scales[k], fmin);
+			if (with_min) m.mins[k] = fmin;
+		}
+	}
+	return true;
+}
+
+void aussie_q4_matrix_free(aussie_q4_matrix& m)
+{
+	if (m.q) AUSSIE_ALIGNED_FREE(m.q);
+	free(m.scales);
+	free(m.mins);
+	memset(&m, 0, sizeof(m));
+}
+
+void aussie_q4_matrix_dequantize_row(const aussie_q4_matrix& m, int row, float out[])  // ncols floats
+{
+	if (row < 0 || row >= m.nrows) {
+		yassert(row >= 0 && row < m.nrows);
+		return;  // fail
+	}
+	const unsigned char* q = &m.q[(long long)row * (m.ldq / 2)];
+	int half = m.groupsize / 2;
+	for (int g = 0; g < m.ngroups; g++) {
+		long long k = (long long)row * m.ngroups + g;
+		float scale = aussie_float16_to_float32(m.scales[k]);
+		float fmin = m.mins ? aussie_float16_to_float32(m.mins[k]) : -8.0f * scale;
+		const unsigned char* qg = &q[g * half];
+		for (int i = 0; i < m.groupsize && g * m.groupsize + i < m.ncols; i++) {
+			int iq = i < half ? (qg[i] & 0x0F) : (qg[i - half] >> 4);
+			out[g * m.groupsize + i] = iq * scale + fmin;
+		}
+	}
+}
+
+static float aussie_q4_vecdot_group_basic(const unsigned char qg[], float scale, const yfp16_t* pmin, const float x[], int n, int groupsize)
+{
+	// One group, n real weights: scale * sum(q' * x) + min * sum(x), with q' = q - 8 if symmetric
+	int half = groupsize / 2;
+	int offset = pmin ? 0 : 8;
+	float sum = 0.0f, xsum = 0.0f;
+	for (int i = 0; i < n; i++) {
+		int iq = i < half ? (qg[i] & 0x0F) : (qg[i - half] >> 4);
+		sum += (float)(iq - offset) * x[i];
+		xsum += x[i];
+	}
+	float result = scale * sum;
+	if (pmin) result += aussie_float16_to_float32(*pmin) * xsum;
+	return result;
+}
+
+float aussie_q4_vecdot_basic(const unsigned char q[], const yfp16_t scales[], const yfp16_t mins[], const float x[], int n, int groupsize)
+{
+	float sum = 0.0f;
+	int half = groupsize / 2;
+	for (int g = 0; g * groupsize < n; g++) {
+		int len = n - g * groupsize < groupsize ? n - g * groupsize : groupsize;
+		sum += aussie_q4_vecdot_group_basic(&q[g * half], aussie_float16_to_float32(scales[g]), mins ? &mins[g] : NULL,
+			&x[g * groupsize], len, groupsize);
+	}
+	return sum;
+}
+
+#if AUSSIE_X86
+
+static inline AUSSIE_TARGET_AVX2_F16C __m256 aussie_q4_fma16_AVX2(__m128i q16, const float x[], __m256 acc)
+{
+	// 16 small signed bytes -> 2 x 8 floats, multiplied by 16 activations
+	__m256 f0 = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(q16));
+	__m256 f1 = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_srli_si128(q16, 8)));
+	acc = _mm256_fmadd_ps(f0, _mm256_loadu_ps(&x[0]), acc);
+	return _mm256_fmadd_ps(f1, _mm256_loadu_ps(&x[8]), acc);
+}
+
+AUSSIE_TARGET_AVX2_F16C float aussie_q4_vecdot_AVX2(const unsigned char q[], const yfp16_t scales[], const yfp16_t mins[], const float x[], int n, int groupsize)
+{
+	const __m128i mask = _mm_set1_epi8(0x0F);
+	const __m128i eight = _mm_set1_epi8(8);
+	int half = groupsize / 2;
+	int nfull = n / groupsize;  // Whole groups (a short last group never reads past x[n-1])
+	__m256 facc = _mm256_setzero_ps();
+	for (int g = 0; g < nfull; g++) {
+		const unsigned char* qg = &q[g * half];
+		const float* xg = &x[g * groupsize];
+		__m256 acclo = _mm256_setzero_ps();  // Two chains (low and high nibbles)
+		__m256 acchi = _mm256_setzero_ps();
+		__m256 xacc = _mm256_setzero_ps();
+		for (int k = 0; k < half; k += 16) {
+			__m128i b = _mm_loadu_si128((const __m128i*)&qg[k]);
+			__m128i lo = _mm_and_si128(b, mask);                       // Weights k..k+15
+			__m128i hi = _mm_and_si128(_mm_srli_epi16(b, 4), mask);    // Weights half+k..half+k+15
+			if (mins) {
+				xacc = _mm256_add_ps(xacc, _mm256_add_ps(_mm256_loadu_ps(&xg[k]), _mm256_loadu_ps(&xg[k + 8])));
+				xacc = _mm256_add_ps(xacc, _mm256_add_ps(_mm256_loadu_ps(&xg[half + k]), _mm256_loadu_ps(&xg[half + k + 8])));
+			}
+			else {
+				lo = _mm_sub_epi8(lo, eight);  // Symmetric: -8..7
+				hi = _mm_sub_epi8(hi, eight);
+			}
+			acclo = aussie_q4_fma16_AVX2(lo, &xg[k], acclo);
+			acchi = aussie_q4_fma16_AVX2(hi, &xg[half + k], acchi);
+		}
+		__m256 scale = _mm256_set1_ps(_cvtsh_ss(scales[g]));  // F16C
+		facc = _mm256_fmadd_ps(_mm256_add_ps(acclo, acchi), scale, facc);  // Dequantize once per group
+		if (mins) facc = _mm256_fmadd_ps(xacc, _mm256_set1_ps(_cvtsh_ss(mins[g])), facc);
+	}
+	float* farr = (float*)&facc;
+	float sum = farr[0] + farr[1] + farr[2] + farr[3] + farr[4] + farr[5] + farr[6] + farr[7];
+	if (nfull * groupsize < n) {  // Short last group
+		int g = nfull;
+		sum += aussie_q4_vecdot_group_basic(&q[g * half], aussie_float16_to_float32(scales[g]), mins ? &mins[g] : NULL,
+			&x[g * groupsize], n - g * groupsize, groupsize);
+	}
+	return sum;
+}
+
+#else
+
+float aussie_q4_vecdot_AVX2(const unsigned char q[], const yfp16_t scales[], const yfp16_t mins[], const float x[], int n, int groupsize)
+{
+	return aussie_q4_vecdot_basic(q, scales, mins, x, n, groupsize);
+}
+
+#endif //AUSSIE_X86
+
+struct aussie_q4_gemv_job {
+	const aussie_q4_matrix* m;
+	const float* v;
+	float* vout;
+	int ntasks;
+	aussie_q4_vecdot_fnptr vecdot;
+};
+
+static void aussie_q4_gemv_rows(const aussie_q4_gemv_job* job, int rowstart, int rowend)
+{
+	const aussie_q4_matrix& m = *job->m;
+	for (int i = rowstart; i < rowend; i++) {
+		long long k = (long long)i * m.ngroups;
+		job->vout[i] = job->vecdot(&m.q[(long long)i * (m.ldq / 2)], &m.scales[k], m.mins ? &m.mins[k] : NULL,
+			job->v, m.ncols, m.groupsize);
+	}
+}
+
+static void aussie_q4_gemv_task(int itask, void* arg)
+{
+	const aussie_q4_gemv_job* job = (const aussie_q4_gemv_job*)arg;
+	int nrows = job->m->nrows;
+	int rowstart = (int)(((long long)nrows * itask) / job->ntasks);
+	int rowend = (int)(((long long)nrows * (itask + 1)) / job->ntasks);
+	aussie_q4_gemv_rows(job, rowstart, rowend);
+}
+
+static bool aussie_q4_gemv_setup(aussie_q4_gemv_job& job, int isa, const aussie_q4_matrix& m, const float v[], float vout[])
+{
+	if (m.q == NULL || v == NULL || vout == NULL) {
+		yassert(m.q != NULL && v != NULL && vout != NULL);
+		return false;  // fail
+	}
+	job.m = &m;
+	job.v = v;
+	job.vout = vout;
+	job.ntasks = 1;
+	bool avx2 = isa >= AUSSIE_ISA_AVX2 && aussie_cpu_has_avx2() && aussie_cpu_detect().f16c;
+	job.vecdot = avx2 ? aussie_q4_vecdot_AVX2 : aussie_q4_vecdot_basic;
+	return true;
+}
+
+void aussie_q4_gemv_isa(int isa, const aussie_q4_matrix& m, const float v[], float vout[])  // Force a kernel, one thread
+{
+	aussie_q4_gemv_job job;
+	if (!aussie_q4_gemv_setup(job, isa, m, v, vout)) return;  // fail
+	aussie_q4_gemv_rows(&job, 0, m.nrows);
+}
+
+void aussie_q4_gemv(const aussie_q4_matrix& m, const float v[], float vout[])  // vout = W * v, rows across the thread pool
+{
+	aussie_dispatch_ensure();
+	aussie_q4_gemv_job job;
+	if (!aussie_q4_gemv_setup(job, g_aussie_dispatch.isa, m, v, vout)) return;  // fail
+	int nthreads = aussie_thread_count();
+	job.ntasks = m.nrows < nthreads ? m.nrows : nthreads;
+	if (job.ntasks <= 1) {
+		aussie_q4_gemv_rows(&job, 0, m.nrows);
+		return;
+	}
+	aussie_parallel_run(job.ntasks, aussie_q4_gemv_task, &job, AUSSIE_SCHEDULE_STATIC);
+}
+
+//---------------------------------------------------
+// Quantization error
+//---------------------------------------------------
+
+bool aussie_q4_error(const aussie_q4_matrix& m, const ymatrix W, const float v[], aussie_quant_error& err)  // m is all of W
+{
+	memset(&err, 0, sizeof(err));
+	int n = AUSSIE_MATRIX_ROWS;  // aussie_matmul_vector_basic_out1 is only for the full matrix
+	if (m.nrows != n || m.ncols != n) {
+		yassert(m.nrows == n && m.ncols == n);
+		return false;  // fail
+	}
+	float* row = (float*)malloc(n * sizeof(float));
+	float* vref = (float*)malloc(n * sizeof(float));
+	float* vout = (float*)malloc(n * sizeof(float));
+	if (!row || !vref || !vout) {
+		yassert(row && vref && vout);
+		free(row); free(vref); free(vout);
+		return false;  // fail
+	}
+	double wsq = 0.0;
+	for (int i = 0; i < n; i++) {
+		aussie_q4_matrix_dequantize_row(m, i, row);
+		for (int j = 0; j < n; j++) {
+			float e = fabsf(row[j] - W[i][j]);
+			if (e > err.weight_max) err.weight_max = e;
+			wsq += (double)e * e;
+		}
+	}
+	err.weight_rms = (float)sqrt(wsq / ((double)n * n));
+
+	aussie_matmul_vector_basic_out1(W, v, n, vref);  // FP32 reference
+	aussie_q4_gemv(m, v, vout);
+	double osq = 0.0, refsq = 0.0;
+	for (int i = 0; i < n; i++) {
+		float e = fabsf(vout[i] - vref[i]);
+		if (!(e <= err.output_max)) err.output_max = e;  // NaN too
+		osq += (double)e * e;
+		refsq += (double)vref[i] * vref[i];
+	}
+	err.output_rms = (float)sqrt(osq / n);
+	err.output_rel = refsq > 0.0 ? (float)sqrt(osq / refsq) : 0.0f;
+	free(row); free(vref); free(vout);
+	return true;
+}
+
+void aussie_quant_error_print(FILE* fp, const char* name, const aussie_quant_error& err)
+{
+	fprintf(fp, "%s: weights max error %g, RMS %g; GEMV max error %g, RMS %g (%.3f%% of the reference)\n",
+		name, err.weight_max, err.weight_rms, err.output_max, err.output_rms, 100.0 * err.output_rel);
+}
+
+//---------------------------------------------------
+// Unit tests
+//---------------------------------------------------
+
+static float aussie_quant_test_value(int i, int j, bool outliers)
+{
+	// Deterministic in [-1,1], optionally with a few big outliers per row (the case where groups help)
+	int h = (i * 131 + j * 71) % 257;
+	float f = (float)(h - 128) / 128.0f;
+	if (outliers && j % 97 == 5) f *= 8.0f;
+	return f;
+}
+
+static void aussie_quant_test_gemv(int nrows, int ncols, int groupsize)
+{
+	int ldw = ncols + 3;
+	float* W = (float*)malloc((size_t)(nrows > 0 ? nrows : 1) * ldw * sizeof(float));
+	float* v = (float*)malloc((ncols > 0 ? ncols : 1) * sizeof(float));
+	float* vout = (float*)malloc((nrows + 1) * sizeof(float));
+	float* vref = (float*)malloc((nrows + 1) * sizeof(float));
+	float* row = (float*)malloc((ncols > 0 ? ncols : 1) * sizeof(float));
+	if (!W || !v || !vout || !vref || !row) {
+		yassert(W && v && vout && vref && row);
+		free(W); free(v); free(vout); free(vref); free(row);
+		return;  // fail
+	}
+	for (int i = 0; i < nrows; i++) for (int j = 0; j < ldw; j++) W[i * ldw + j] = aussie_quant_test_value(i, j, true);
+	for (int j = 0; j < ncols; j++) v[j] = aussie_quant_test_value(j, 7, false) * 0.5f;
+
+	aussie_q8_matrix m;
+	aussie_q8_vector x;
+	if (!aussie_q8_matrix_quantize(m, W, nrows, ncols, ldw, groupsize) || !aussie_q8_vector_init(x, m)) {
+		ytest(false);
+		free(W); free(v); free(vout); free(vref); free(row);
+		return;  // fail
+	}
+	ytest(m.ldq % AUSSIE_Q8_BLOCK == 0 && m.ldq >= ncols);
+	ytest(m.ngroups * m.groupsize == m.ldq);
+
+	// Round trip: each weight within half a step of its group's scale
+	bool roundtrip_ok = true;
+	for (int i = 0; i < nrows; i++) {
+		aussie_q8_matrix_dequantize_row(m, i, row);
+		for (int j = 0; j < ncols; j++) {
+			float scale = m.scales[i * m.ngroups + j / m.groupsize];
+			if (fabsf(row[j] - W[i * ldw + j]) > 0.5f * scale + 1e-6f) roundtrip_ok = false;
+		}
+		for (int j = ncols; j < m.ldq; j++) if (m.q[(long long)i * m.ldq + j] != 0) roundtrip_ok = false;
+	}
+	ytest(roundtrip_ok);
+
+	// Every kernel gives the same answer (integer sums are exact, only the float order differs)
+	vout[nrows] = vref[nrows] = -999.0f;
+	aussie_q8_vector_quantize(x, v);
+	aussie_q8_gemv_isa(AUSSIE_ISA_SCALAR, m, x, vref);
+	int isas[] = { AUSSIE_ISA_AVX2, AUSSIE_ISA_AVX512 };
+	for (int k = 0; k < 2; k++) {
+		if (isas[k] == AUSSIE_ISA_AVX2 && !aussie_cpu_has_avx2()) continue;
+		if (isas[k] == AUSSIE_ISA_AVX512 && !aussie_cpu_has_avx512_vnni()) continue;
+		aussie_q8_gemv_isa(isas[k], m, x, vout);
+		float maxerr = 0.0f, maxout = 0.0f;
+		for (int i = 0; i < nrows; i++) {
+			float err = fabsf(vout[i] - vref[i]);
+			if (!(err <= maxerr)) maxerr = err;
+			if (fabsf(vref[i]) > maxout) maxout = fabsf(vref[i]);
+		}
+		ytest(maxerr <= 1e-5f * (1.0f + maxout));
+	}
+	ytestf(vout[nrows], -999.0f);
+
+	// Dispatched, parallel, quantizing on the fly: close to the FP32 GEMV
+	aussie_q8_gemv(m, v, x, vout);
+	float maxerr = 0.0f, maxref = 0.0f;
+	for (int i = 0; i < nrows; i++) {
+		float sum = 0.0f, sumabs = 0.0f;
+		for (int j = 0; j < ncols; j++) {
+			sum += W[i * ldw + j] * v[j];
+			sumabs += fabsf(W[i * ldw + j] * v[j]);
+		}
+		float err = fabsf(vout[i] - sum);
+		if (!(err <= maxerr)) maxerr = err;
+		if (sumabs > maxref) maxref = sumabs;
+	}
+	ytest(maxerr <= 0.02f * maxref + 1e-6f);  // Two 8-bit roundings per product
+	ytestf(vout[nrows], -999.0f);
+	if (!(maxerr <= 0.02f * maxref + 1e-6f)) {
+		fprintf(stderr, "ERROR: %s: %dx%d group %d: max error %g (terms up to %g)\n", __func__, nrows, ncols, groupsize, maxerr, maxref);
+	}
+
+	aussie_q8_matrix_free(m);
+	aussie_q8_vector_free(x);
+	free(W); free(v); free(vout); free(vref); free(row);
+}
+
+static float aussie_quant_test_random(unsigned int& seed)
+{
+	// Uncorrelated test data in [-1,1] (so rounding errors average out as they do in real weights)
+	seed = seed * 1103515245u + 12345u;
+	return (float)((seed >> 8) % 20001) / 10000.0f - 1.0f;
+}
+
+static void aussie_quant_test_q4(int nrows, int ncols, int groupsize, bool with_min)
+{
+	int ldw = ncols + 5;
+	float* W = (float*)malloc((size_t)nrows * ldw * sizeof(float));
+	float* v = (float*)malloc((ncols + 1) * sizeof(float));
+	float* vout = (float*)malloc((nrows + 1) * sizeof(float));
+	float* vref = (float*)malloc((nrows + 1) * sizeof(float));
+	float* row = (float*)malloc((ncols + 1) * sizeof(float));
+	if (!W || !v || !vout || !vref || !row) {
+		yassert(W && v && vout && vref && row);
+		free(W); free(v); free(vout); free(vref); free(row);
+		return;  // fail
+	}
+	unsigned int seed = 42;
+	for (int i = 0; i < nrows * ldw; i++) W[i] = aussie_quant_test_random(seed);
+	for (int j = 0; j < ncols; j++) v[j] = aussie_quant_test_random(seed);
+	aussie_q4_matrix m;
+	if (!aussie_q4_matrix_quantize(m, W, nrows, ncols, ldw, groupsize, with_min)) {
+		ytest(false);
+		free(W); free(v); free(vout); free(vref); free(row);
+		return;  // fail
+	}
+	ytest((m.mins != NULL) == with_min);
+	ytest(m.ldq % groupsize == 0 && m.ldq >= ncols);
+
+	// Round trip: within one step of the group's scale (symmetric clamps +8 steps to +7)
+	bool roundtrip_ok = true;
+	for (int i = 0; i < nrows; i++) {
+		aussie_q4_matrix_dequantize_row(m, i, row);
+		for (int j = 0; j < ncols; j++) {
+			float scale = fabsf(aussie_float16_to_float32(m.scales[i * m.ngroups + j / groupsize]));
+			if (fabsf(row[j] - W[i * ldw + j]) > scale * 1.01f + 1e-3f) roundtrip_ok = false;
+		}
+	}
+	ytest(roundtrip_ok);
+
+	// AVX-2 unpacking matches the scalar kernel; both are close to FP32
+	vout[nrows] = vref[nrows] = -999.0f;
+	aussie_q4_gemv_isa(AUSSIE_ISA_SCALAR, m, v, vref);
+	if (aussie_cpu_has_avx2() && aussie_cpu_detect().f16c) {
+		aussie_q4_gemv_isa(AUSSIE_ISA_AVX2, m, v, vout);
+		float maxerr = 0.0f, maxout = 0.0f;
+		for (int i = 0; i < nrows; i++) {
+			float err = fabsf(vout[i] - vref[i]);
+			if (!(err <= maxerr)) maxerr = err;
+			if (fabsf(vref[i]) > maxout) maxout = fabsf(vref[i]);
+		}
+		ytest(maxerr <= 1e-5f * ncols * (1.0f + maxout));
+	}
+	aussie_q4_gemv(m, v, vout);
+	double errsq = 0.0, termsq = 0.0;
+	for (int i = 0; i < nrows; i++) {
+		float sum = 0.0f;
+		for (int j = 0; j < ncols; j++) {
+			sum += W[i * ldw + j] * v[j];
+			termsq += (double)W[i * ldw + j] * v[j] * W[i * ldw + j] * v[j];
+		}
+		errsq += (double)(vout[i] - sum) * (vout[i] - sum);
+	}
+	ytest(errsq <= 0.1 * 0.1 * termsq + 1e-6);  // 16 levels: about 6% error per weight, uncorrelated
+	ytestf(vout[nrows], -999.0f);
+	aussie_q4_matrix_free(m);
+	free(W); free(v); free(vout); free(vref); free(row);
+}
+
+static void aussie_quant_test_q4_error()
+{
+	// Error report against aussie_matmul_vector_basic_out1, and the min helps skewed weights
+	int n = AUSSIE_MATRIX_ROWS;
+	ymatrix* pW = (ymatrix*)malloc(sizeof(ymatrix));
+	float* v = (float*)malloc(n * sizeof(float));
+	if (!pW || !v) {
+		yassert(pW && v);
+		free(pW); free(v);
+		return;  // fail
+	}
+	ymatrix& W = *pW;
+	unsigned int seed = 7;
+	for (int i = 0; i < n; i++) for (int j = 0; j < n; j++) W[i][j] = aussie_quant_test_random(seed) * 0.5f + 0.75f;  // All positive
+	for (int j = 0; j < n; j++) v[j] = aussie_quant_test_random(seed);
+	aussie_quant_error errs[2];
+	for (int k = 0; k < 2; k++) {
+		aussie_q4_matrix m;
+		ytest(aussie_q4_matrix_quantize(m, &W[0][0], n, n, AUSSIE_MATRIX_COLUMNS, 32, k == 1));
+		ytest(aussie_q4_error(m, W, v, errs[k]));
+		ytest(errs[k].output_rel < 0.2f);
+		ytest(errs[k].weight_rms <= errs[k].weight_max);
+		aussie_q4_matrix_free(m);
+	}
+	ytest(errs[1].weight_rms < errs[0].weight_rms);  // Min: 16 levels over [min,max], not [-max,max]
+	free(pW); free(v);
+}
+
+void aussie_quant_unit_tests()
+{
+	fprintf(stderr, "INFO: %s: Running unit tests\n", __func__);
+
+	// Quantize a known group
+	float g[AUSSIE_Q8_BLOCK] = { 0 };
+	g[0] = 1.27f; g[1] = -1.27f; g[2] = 0.5f; g[3] = 0.004f;
+	signed char q[AUSSIE_Q8_BLOCK];
+	float scale = aussie_q8_quantize_group(g, AUSSIE_Q8_BLOCK, q);
+	ytestf(scale, 1.27f / 127.0f);
+	ytest(q[0] == 127 && q[1] == -127 && q[2] == 50 && q[3] == 0 && q[4] == 0);
+	float zeros[AUSSIE_Q8_BLOCK] = { 0 };
+	ytestf(aussie_q8_quantize_group(zeros, AUSSIE_Q8_BLOCK, q), 0.0f);
+
+	// Worst case magnitudes: no int16 saturation in maddubs
+	alignas(64) signed char wmax[64], xmax[64];
+	float ones[2] = { 1.0f, 1.0f };
+	for (int j = 0; j < 64; j++) {
+		wmax[j] = (j % 3 == 0) ? -127 : 127;
+		xmax[j] = (j % 5 == 0) ? -127 : 127;
+	}
+	float expect = aussie_q8_vecdot_basic(wmax, ones, xmax, ones, 1, 64);
+	if (aussie_cpu_has_avx2()) ytestf(aussie_q8_vecdot_AVX2(wmax, ones, xmax, ones, 1, 64), expect);
+	if (aussie_cpu_has_avx512_vnni()) ytestf(aussie_q8_vecdot_AVX512_VNNI(wmax, ones, xmax, ones, 2, 32), expect);
+
+	// Sizes: under a block, odd widths, per-row and groups, more rows than threads
+	aussie_quant_test_gemv(1, 1, 0);
+	aussie_quant_test_gemv(3, 31, 0);
+	aussie_quant_test_gemv(7, 32, 32);
+	aussie_quant_test_gemv(5, 100, 32);
+	aussie_quant_test_gemv(9, 100, 64);
+	aussie_quant_test_gemv(33, 257, 0);
+	aussie_quant_test_gemv(17, 1000, 128);
+	aussie_quant_test_gemv(4, 0, 0);
+
+	// 4-bit groups, symmetric and with a min
+	for (int k = 0; k < 2; k++) {
+		aussie_quant_test_q4(3, 32, 32, k == 1);
+		aussie_quant_test_q4(5, 100, 32, k == 1);
+		aussie_quant_test_q4(7, 130, 64, k == 1);
+		aussie_quant_test_q4(33, 512, 64, k == 1);
+		aussie_quant_test_q4(2, 5, 32, k == 1);
+	}
+	aussie_quant_test_q4_error();
+}
+
+//---------------------------------------------------
+//---------------------------------------------------
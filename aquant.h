@@ -0,0 +1,133 @@
+//---------------------------------------------------
+// aquant.h -- INT8 and 4-bit quantized weights and GEMV -- Aussie AI Base Library
+// Created Oct 17th 2026
+// Copyright (c) 2023 Aussie AI Labs Pty Ltd
+//---------------------------------------------------
+
+#ifndef AUSSIE_YQUANT_INCLUDE_HEADER_H
+#define AUSSIE_YQUANT_INCLUDE_HEADER_H
+
+//---------------------------------------------------
+// Symmetric INT8 quantization: w ~= scale * q, q in [-127,127] (never -128)
+// ... one float scale per group of columns: groupsize 0 = one group per row (per-row scales)
+// ... rows are padded with zeros to a multiple of AUSSIE_Q8_BLOCK (and of the group size)
+// ... weights are 1 byte instead of 4, so a GEMV reads a quarter of the FP32 bytes
+//---------------------------------------------------
+
+#define AUSSIE_Q8_BLOCK       32       // Row padding and group size granularity (one YMM register of int8)
+#define AUSSIE_Q8_MAX_GROUP   131072   // Longest group: 127*127*n must fit an int32 sum
+
+struct aussie_q8_matrix {
+	int nrows;
+	int ncols;
+	int ldq;          // Bytes per row (padded)
+	int groupsize;    // Columns per scale (ldq for per-row scales)
+	int ngroups;      // Groups per row (ldq / groupsize)
+	signed char* q;   // nrows x ldq, 64-byte aligned
+	float* scales;    // nrows x ngroups
+};
+
+bool aussie_q8_matrix_quantize(aussie_q8_matrix& m, const float* W, int nrows, int ncols, int ldw, int groupsize);  // groupsize 0 = per-row
+void aussie_q8_matrix_free(aussie_q8_matrix& m);
+void aussie_q8_matrix_dequantize_row(const aussie_q8_matrix& m, int row, float out[]);  // ncols floats
+
+//---------------------------------------------------
+// Activations are quantized on the fly (once per GEMV, not per row), with the same groups
+// as the weights, so each group's int32 dot product is dequantized by one multiply
+// (once per output row for per-row scales).
+//---------------------------------------------------
+
+struct aussie_q8_vector {
+	int n;
+	int ldq;
+	int groupsize;
+	int ngroups;
+	signed char* q;   // ldq bytes, zero padded
+	float* scales;    // ngroups
+};
+
+bool aussie_q8_vector_init(aussie_q8_vector& x, const aussie_q8_matrix& m);  // Scratch for this matrix's input
+void aussie_q8_vector_free(aussie_q8_vector& x);
+void aussie_q8_vector_quantize(aussie_q8_vector& x, const float v[]);  // x.n floats
+
+//---------------------------------------------------
+// Row kernels: sum over groups of (int8 dot product) * wscale * xscale
+// ... AVX2: _mm256_maddubs_epi16 on |x| (unsigned) and w * sign(x), no saturation since |q| <= 127
+// ... AVX-512 VNNI: _mm512_dpbusd_epi32 does the same multiply-add in one instruction
+//---------------------------------------------------
+
+typedef float (*aussie_q8_vecdot_fnptr)(const signed char wq[], const float wscales[],
+	const signed char xq[], const float xscales[], int ngroups, int groupsize);
+
+float aussie_q8_vecdot_basic(const signed char wq[], const float wscales[], const signed char xq[], const float xscales[], int ngroups, int groupsize);
+float aussie_q8_vecdot_AVX2(const signed char wq[], const float wscales[], const signed char xq[], const float xscales[], int ngroups, int groupsize);
+float aussie_q8_vecdot_AVX512_VNNI(const signed char wq[], const float wscales[], const signed char xq[], const float xscales[], int ngroups, int groupsize);
+
+//---------------------------------------------------
+// GEMV: vout = W * v (nrows outputs)
+//---------------------------------------------------
+
+void aussie_q8_gemv(const aussie_q8_matrix& m, const float v[], aussie_q8_vector& x, float vout[]);  // Quantize v into x, then rows across the thread pool
+void aussie_q8_gemv_quantized(const aussie_q8_matrix& m, const aussie_q8_vector& x, float vout[]);  // Already quantized input (thread pool)
+void aussie_q8_gemv_isa(int isa, const aussie_q8_matrix& m, const aussie_q8_vector& x, float vout[]);  // Force a kernel, one thread (AUSSIE_ISA_*; AVX-512 needs VNNI, else AVX2)
+
+//---------------------------------------------------
+// 4-bit grouped weights (Q4): 32 or 64 weights per group with an FP16 scale (afloat.h yfp16_t)
+// ... symmetric: weight = (q - 8) * scale, q in [0,15]
+// ... with a min: weight = q * scale + min (better for skewed groups, 2 more bytes per group)
+// ... within a group, byte j holds weight j (low nibble) and weight j + groupsize/2 (high nibble)
+// ... the GEMV unpacks nibbles in registers and accumulates in FP32 against FP32 activations,
+//     so no dequantized matrix is ever stored (an eighth of the FP32 weight bytes, plus scales)
+// ... needs afloat.h first (yfp16_t)
+//---------------------------------------------------
+
+struct aussie_q4_matrix {
+	int nrows;
+	int ncols;
+	int ldq;            // Weights per row, padded to whole groups (ldq / 2 bytes)
+	int groupsize;      // Weights per scale (multiple of 32)
+	int ngroups;        // Groups per row
+	unsigned char* q;   // nrows x (ldq / 2) bytes, 64-byte aligned
+	yfp16_t* scales;    // nrows x ngroups
+	yfp16_t* mins;      // nrows x ngroups (NULL = symmetric)
+};
+
+bool aussie_q4_matrix_quantize(aussie_q4_matrix& m, const float* W, int nrows, int ncols, int ldw, int groupsize, bool with_min);
+void aussie_q4_matrix_free(aussie_q4_matrix& m);
+void aussie_q4_matrix_dequantize_row(const aussie_q4_matrix& m, int row, float out[]);  // ncols floats
+
+typedef float (*aussie_q4_vecdot_fnptr)(const unsigned char q[], const yfp16_t scales[], const yfp16_t mins[],
+	const float x[], int n, int groupsize);
+
+float aussie_q4_vecdot_basic(const unsigned char q[], const yfp16_t scales[], const yfp16_t mins[], const float x[], int n, int groupsize);
+float aussie_q4_vecdot_AVX2(const unsigned char q[], const yfp16_t scales[], const yfp16_t mins[], const float x[], int n, int groupsize);
+
+void aussie_q4_gemv(const aussie_q4_matrix& m, const float v[], float vout[]);  // vout = W * v, rows across the thread pool
+void aussie_q4_gemv_isa(int isa, const aussie_q4_matrix& m, const float v[], float vout[]);  // Force a kernel, one thread
+
+//---------------------------------------------------
+// Quantization error versus the FP32 GEMV (aussie_matmul_vector_basic_out1)
+// ... needs amatmul.h first (ymatrix)
+//---------------------------------------------------
+
+struct aussie_quant_error {
+	float weight_max;   // Largest |W - dequantized W|
+	float weight_rms;   // RMS of W - dequantized W
+	float output_max;   // Largest |W*v - reference|
+	float output_rms;   // RMS of W*v - reference
+	float output_rel;   // output_rms / RMS of the reference
+};
+
+bool aussie_q4_error(const aussie_q4_matrix& m, const ymatrix W, const float v[], aussie_quant_error& err);  // m is all of W (the reference is AUSSIE_MATRIX_ROWS square)
+void aussie_quant_error_print(FILE* fp, const char* name, const aussie_quant_error& err);
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+void aussie_quant_unit_tests();
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+
+#endif //AUSSIE_YQUANT_INCLUDE_HEADER_H
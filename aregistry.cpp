@@ -0,0 +1,670 @@
+// aregistry.cpp -- Kernel registry and auto-tuner -- Aussie AI Base Library
+// Created Oct 17th 2026
+// Copyright (c) 2023 Aussie AI Labs Pty Ltd
+//---------------------------------------------------
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <math.h>
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+#include "aport.h"
+
+#if LINUX
+#include <unistd.h>  // close
+#else
+#include <process.h>  // _getpid
+#endif //LINUX
+#include "aussieai.h"
+#include "aassert.h"
+#include "atest.h"
+#include "avector.h"
+#include "aavx.h"
+#include "asoftmax.h"
+#include "adispatch.h"
+#include "abenchmark.h"
+
+#include "aregistry.h"  // self-include
+
+//---------------------------------------------------
+// Wrappers for variants without const pointers (they don't modify the vectors)
+//---------------------------------------------------
+
+static float aussie_registry_vecdot_pointer_arithmetic(const float v1[], const float v2[], int n)
+{
+	return aussie_vecdot_pointer_arithmetic((float*)v1, (float*)v2, n);
+}
+
+static float aussie_registry_vecdot_unroll4_basic(const float v1[], const float v2[], int n)
+{
+	return aussie_vecdot_unroll4_basic((float*)v1, (float*)v2, n);
+}
+
+static float aussie_registry_vecdot_unroll4_better(const float v1[], const float v2[], int n)
+{
+	return aussie_vecdot_unroll4_better((float*)v1, (float*)v2, n);
+}
+
+static float aussie_registry_vecdot_unroll4_duffs_device(const float v1[], const float v2[], int n)
+{
+	return aussie_vecdot_unroll4_duffs_device((float*)v1, (float*)v2, n);
+}
+
+//---------------------------------------------------
+// Built-in variants
+//---------------------------------------------------
+
+#define AUSSIE_REG_VECDOT(name, fn, isa, nmultiple, nmin) \
+	{ name, AUSSIE_OP_VECDOT, isa, 0, nmultiple, nmin, 1e-4f, fn, NULL, NULL }
+#define AUSSIE_REG_REDUCE(name, op, fn, isa, nmin, tol) \
+	{ name, op, isa, 0, 1, nmin, tol, NULL, fn, NULL }
+#define AUSSIE_REG_SOFTMAX(name, fn, isa) \
+	{ name, AUSSIE_OP_SOFTMAX, isa, 0, 1, 1, 1e-4f, NULL, NULL, fn }
+
+static const aussie_kernel_variant s_aussie_registry_builtins[] = {
+	AUSSIE_REG_VECDOT("aussie_vecdot_basic", aussie_vecdot_basic, AUSSIE_ISA_SCALAR, 1, 0),
+	AUSSIE_REG_VECDOT("aussie_vecdot_pointer_arithmetic", aussie_registry_vecdot_pointer_arithmetic, AUSSIE_ISA_SCALAR, 1, 0),
+	AUSSIE_REG_VECDOT("aussie_vecdot_unroll4_basic", aussie_registry_vecdot_unroll4_basic, AUSSIE_ISA_SCALAR, 4, 0),
+	AUSSIE_REG_VECDOT("aussie_vecdot_unroll4_better", aussie_registry_vecdot_unroll4_better, AUSSIE_ISA_SCALAR, 1, 0),
+	AUSSIE_REG_VECDOT("aussie_vecdot_unroll4_duffs_device", aussie_registry_vecdot_unroll4_duffs_device, AUSSIE_ISA_SCALAR, 1, 1),  // Wrong for n == 0
+#if AUSSIE_X86
+	AUSSIE_REG_VECDOT("aussie_vecdot_unroll_AVX1", aussie_vecdot_unroll_AVX1, AUSSIE_ISA_AVX1, 1, 0),
+	AUSSIE_REG_VECDOT("aussie_vecdot_unroll_AVX2", aussie_vecdot_unroll_AVX2, AUSSIE_ISA_AVX2, 1, 0),
+	AUSSIE_REG_VECDOT("aussie_vecdot_FMA_unroll_AVX1", aussie_vecdot_FMA_unroll_AVX1, AUSSIE_ISA_AVX2, 1, 0),  // FMA: AVX2 level
+	AUSSIE_REG_VECDOT("aussie_vecdot_FMA_unroll_AVX2", aussie_vecdot_FMA_unroll_AVX2, AUSSIE_ISA_AVX2, 1, 0),
+	AUSSIE_REG_VECDOT("aussie_vecdot_FMA_unroll_AVX512", aussie_vecdot_FMA_unroll_AVX512, AUSSIE_ISA_AVX512, 1, 0),
+#endif //AUSSIE_X86
+	AUSSIE_REG_VECDOT("aussie_vecdot_parallel", aussie_vecdot_parallel, AUSSIE_ISA_SCALAR, 1, 0),
+
+	AUSSIE_REG_REDUCE("aussie_vector_sum", AUSSIE_OP_SUM, aussie_vector_sum, AUSSIE_ISA_SCALAR, 0, 1e-4f),
+#if AUSSIE_X86
+	AUSSIE_REG_REDUCE("aussie_vector_sum_AVX1", AUSSIE_OP_SUM, aussie_vector_sum_AVX1, AUSSIE_ISA_AVX1, 0, 1e-4f),
+	AUSSIE_REG_REDUCE("aussie_vector_sum_AVX2", AUSSIE_OP_SUM, aussie_vector_sum_AVX2, AUSSIE_ISA_AVX2, 0, 1e-4f),
+	AUSSIE_REG_REDUCE("aussie_vector_sum_AVX512", AUSSIE_OP_SUM, aussie_vector_sum_AVX512, AUSSIE_ISA_AVX512, 0, 1e-4f),
+#endif //AUSSIE_X86
+
+	AUSSIE_REG_REDUCE("aussie_vector_sum_squares", AUSSIE_OP_SUM_SQUARES, aussie_vector_sum_squares, AUSSIE_ISA_SCALAR, 0, 1e-4f),
+#if AUSSIE_X86
+	AUSSIE_REG_REDUCE("aussie_vector_sum_squares_AVX1", AUSSIE_OP_SUM_SQUARES, aussie_vector_sum_squares_AVX1, AUSSIE_ISA_AVX1, 0, 1e-4f),
+	AUSSIE_REG_REDUCE("aussie_vector_sum_squares_AVX2", AUSSIE_OP_SUM_SQUARES, aussie_vector_sum_squares_AVX2, AUSSIE_ISA_AVX2, 0, 1e-4f),
+#endif //AUSSIE_X86
+
+	AUSSIE_REG_REDUCE("aussie_vector_max", AUSSIE_OP_MAX, aussie_vector_max, AUSSIE_ISA_SCALAR, 1, 0.0f),  // Max is exact
+#if AUSSIE_X86
+	AUSSIE_REG_REDUCE("aussie_vector_max_AVX1", AUSSIE_OP_MAX, aussie_vector_max_AVX1, AUSSIE_ISA_AVX1, 1, 0.0f),
+	AUSSIE_REG_REDUCE("aussie_vector_max_AVX1b", AUSSIE_OP_MAX, aussie_vector_max_AVX1b, AUSSIE_ISA_AVX1, 1, 0.0f),
+	AUSSIE_REG_REDUCE("aussie_vector_max_AVX2", AUSSIE_OP_MAX, aussie_vector_max_AVX2, AUSSIE_ISA_AVX2, 1, 0.0f),
+	AUSSIE_REG_REDUCE("aussie_vector_max_AVX512", AUSSIE_OP_MAX, aussie_vector_max_AVX512, AUSSIE_ISA_AVX512, 1, 0.0f),
+#endif //AUSSIE_X86
+
+	AUSSIE_REG_SOFTMAX("aussie_vector_softmax_basic", aussie_vector_softmax_basic, AUSSIE_ISA_SCALAR),
+	AUSSIE_REG_SOFTMAX("aussie_vector_softmax_online", aussie_vector_softmax_online, AUSSIE_ISA_SCALAR),
+#if AUSSIE_X86
+	AUSSIE_REG_SOFTMAX("aussie_vector_softmax_online_AVX2", aussie_vector_softmax_online_AVX2, AUSSIE_ISA_AVX2),
+	AUSSIE_REG_SOFTMAX("aussie_vector_softmax_online_AVX512", aussie_vector_softmax_online_AVX512, AUSSIE_ISA_AVX512),
+#endif //AUSSIE_X86
+	AUSSIE_REG_SOFTMAX("aussie_vector_softmax_parallel", aussie_vector_softmax_parallel, AUSSIE_ISA_SCALAR),
+};
+
+//---------------------------------------------------
+// Registry
+//---------------------------------------------------
+
+struct aussie_tune_entry {
+	int variant;   // Index into the registry (-1 = not tuned)
+	double ns;     // Median time of the winner
+};
+
+static aussie_kernel_variant s_aussie_registry[AUSSIE_REGISTRY_MAX];
+static int s_aussie_registry_count = 0;
+static bool s_aussie_registry_init_done = false;
+static aussie_tune_entry s_aussie_tuned[AUSSIE_OP_MAX_OPS][AUSSIE_TUNE_BUCKETS];
+static const aussie_kernel_variant* s_aussie_bound[AUSSIE_OP_MAX_OPS][AUSSIE_TUNE_BUCKETS];  // Nearest tuned winner per bucket
+
+static bool aussie_registry_add_one(const aussie_kernel_variant& v)
+{
+	bool hasfn = (v.op == AUSSIE_OP_VECDOT && v.vecdotfn) || (v.op == AUSSIE_OP_SOFTMAX && v.inplacefn)
+		|| ((v.op == AUSSIE_OP_SUM || v.op == AUSSIE_OP_SUM_SQUARES || v.op == AUSSIE_OP_MAX) && v.reducefn);
+	if (!v.name || !hasfn || v.nmultiple < 1 || v.align < 0 || s_aussie_registry_count >= AUSSIE_REGISTRY_MAX) {
+		yassert(v.name && hasfn && v.nmultiple >= 1 && v.align >= 0 && s_aussie_registry_count < AUSSIE_REGISTRY_MAX);
+		return false;  // fail
+	}
+	s_aussie_registry[s_aussie_registry_count++] = v;
+	return true;
+}
+
+static void aussie_registry_init()  // Built-in variants (once, on first use)
+{
+	if (s_aussie_registry_init_done) return;
+	s_aussie_registry_init_done = true;
+	aussie_tune_reset();
+	int nbuiltins = (int)(sizeof(s_aussie_registry_builtins) / sizeof(s_aussie_registry_builtins[0]));
+	for (int i = 0; i < nbuiltins; i++) aussie_registry_add_one(s_aussie_registry_builtins[i]);
+}
+
+bool aussie_registry_add(const aussie_kernel_variant& v)
+{
+	aussie_registry_init();
+	if (v.name && aussie_registry_find(v.name) != NULL) {
+		fprintf(stderr, "WARNING: %s: Duplicate kernel name %s, not added\n", __func__, v.name);  // Names are the tuning file keys
+		return false;  // fail
+	}
+	return aussie_registry_add_one(v);
+}
+
+int aussie_registry_count(int op)
+{
+	aussie_registry_init();
+	int count = 0;
+	for (int i = 0; i < s_aussie_registry_count; i++) {
+		if (s_aussie_registry[i].op == op) count++;
+	}
+	return count;
+}
+
+const aussie_kernel_variant* aussie_registry_get(int op, int i)
+{
+	aussie_registry_init();
+	for (int j = 0; j < s_aussie_registry_count; j++) {
+		if (s_aussie_registry[j].op == op && i-- == 0) return &s_aussie_registry[j];
+	}
+	return NULL;
+}
+
+const aussie_kernel_variant* aussie_registry_find(const char* name)
+{
+	aussie_registry_init();
+	for (int i = 0; name && i < s_aussie_registry_count; i++) {
+		if (strcmp(s_aussie_registry[i].name, name) == 0) return &s_aussie_registry[i];
+	}
+	return NULL;
+}
+
+const char* aussie_registry_op_name(int op)
+{
+	switch (op) {
+	case AUSSIE_OP_VECDOT: return "vecdot";
+	case AUSSIE_OP_SUM: return "sum";
+	case AUSSIE_OP_SUM_SQUARES: return "sum_squares";
+	case AUSSIE_OP_MAX: return "max";
+	case AUSSIE_OP_SOFTMAX: return "softmax";
+	default: return "unknown";
+	}
+}
+
+static bool aussie_registry_fits(const aussie_kernel_variant& v, int n, const float* v1, const float* v2)  // Length and alignment only
+{
+	if (n < v.nmin || n % v.nmultiple != 0) return false;
+	if (v.align > 0) {
+		if (v1 && (size_t)v1 % v.align != 0) return false;
+		if (v2 && (size_t)v2 % v.align != 0) return false;
+	}
+	return true;
+}
+
+bool aussie_registry_eligible(const aussie_kernel_variant& v, int n, const float* v1, const float* v2)
+{
+	aussie_dispatch_ensure();
+	if (v.isa > g_aussie_dispatch.isa) return false;  // This CPU (or AUSSIE_ISA) can't run it
+	return aussie_registry_fits(v, n, v1, v2);
+}
+
+//---------------------------------------------------
+// Verification against double precision
+//---------------------------------------------------
+
+#define AUSSIE_REGISTRY_VERIFY_MAXN 4096   // Big sizes are checked at this size plus the same leftover (n % 64)
+
+bool aussie_registry_verify(const aussie_kernel_variant& v, int n)
+{
+	if (n > AUSSIE_REGISTRY_VERIFY_MAXN) n = AUSSIE_REGISTRY_VERIFY_MAXN + n % 64;  // Same tail handling, rounding stays small
+	if (!aussie_registry_eligible(v, n, NULL, NULL)) return false;
+	int nalloc = n > 0 ? n : 1;
+	float* v1 = (float*)AUSSIE_ALIGNED_MALLOC(nalloc * sizeof(float), 64);
+	float* v2 = (float*)AUSSIE_ALIGNED_MALLOC(nalloc * sizeof(float), 64);
+	if (!v1 || !v2) {
+		yassert(v1 && v2);
+		if (v1) AUSSIE_ALIGNED_FREE(v1);
+		if (v2) AUSSIE_ALIGNED_FREE(v2);
+		return false;  // fail
+	}
+	unsigned int seed = 12345;
+	for (int i = 0; i < n; i++) {
+		seed = seed * 1103515245u + 12345u;  // Same test data every time
+		v1[i] = (float)((seed >> 8) % 20001) / 10000.0f - 1.0f;   // [-1,1]
+		v2[i] = (float)((seed >> 4) % 1001) / 1000.0f - 0.5f;
+	}
+
+	bool ok = true;
+	double ref = 0.0, scale = 0.0;  // Scale: size of the terms (sums can cancel)
+	float got = 0.0f;
+	switch (v.op) {
+	case AUSSIE_OP_VECDOT:
+		for (int i = 0; i < n; i++) { ref += (double)v1[i] * v2[i]; scale += fabs((double)v1[i] * v2[i]); }
+		got = v.vecdotfn(v1, v2, n);
+		break;
+	case AUSSIE_OP_SUM:
+		for (int i = 0; i < n; i++) { ref += v1[i]; scale += fabs(v1[i]); }
+		got = v.reducefn(v1, n);
+		break;
+	case AUSSIE_OP_SUM_SQUARES:
+		for (int i = 0; i < n; i++) { ref += (double)v1[i] * v1[i]; }
+		scale = ref;
+		got = v.reducefn(v1, n);
+		break;
+	case AUSSIE_OP_MAX:
+		ref = v1[0];
+		for (int i = 1; i < n; i++) if (v1[i] > ref) ref = v1[i];
+		got = v.reducefn(v1, n);
+		break;
+	default: {  // Softmax: each probability (logits in [-5,5])
+		for (int i = 0; i < n; i++) v1[i] *= 5.0f;
+		double vmax = v1[0], sum = 0.0;
+		for (int i = 1; i < n; i++) if (v1[i] > vmax) vmax = v1[i];
+		for (int i = 0; i < n; i++) sum += exp((double)v1[i] - vmax);
+		for (int i = 0; i < n; i++) v2[i] = (float)(exp((double)v1[i] - vmax) / sum);  // v2 = expected
+		v.inplacefn(v1, n);
+		for (int i = 0; i < n; i++) {
+			if (fabs(v1[i] - v2[i]) > v.tolerance * v2[i] + 1e-7) ok = false;
+		}
+		break;
+	}
+	}
+	if (v.op != AUSSIE_OP_SOFTMAX) {
+		if (scale < 1.0) scale = 1.0;
+		if (fabs(got - ref) > v.tolerance * scale) ok = false;
+		if (v.op == AUSSIE_OP_MAX && n > 0 && got != (float)ref) ok = false;  // Exact
+	}
+	AUSSIE_ALIGNED_FREE(v1);
+	AUSSIE_ALIGNED_FREE(v2);
+	return ok;
+}
+
+//---------------------------------------------------
+// Auto-tuner
+//---------------------------------------------------
+
+static int aussie_tune_bucket(int n)  // floor(log2(n)), 0 for n <= 1
+{
+	if (n <= 1) return 0;
+#if LINUX
+	return 31 - __builtin_clz((unsigned int)n);
+#else
+	int b = 0;
+	while ((n >> (b + 1)) > 0) b++;
+	return b;
+#endif
+}
+
+void aussie_tune_reset()  // Unbind everything (dispatched kernels again)
+{
+	for (int op = 0; op < AUSSIE_OP_MAX_OPS; op++) {
+		for (int b = 0; b < AUSSIE_TUNE_BUCKETS; b++) {
+			s_aussie_tuned[op][b].variant = -1;
+			s_aussie_tuned[op][b].ns = 0.0;
+			s_aussie_bound[op][b] = NULL;
+		}
+	}
+}
+
+static void aussie_tune_rebind(int op)  // Every bucket gets the nearest tuned winner (smaller size first on ties)
+{
+	for (int b = 0; b < AUSSIE_TUNE_BUCKETS; b++) {
+		s_aussie_bound[op][b] = NULL;
+		for (int d = 0; d < AUSSIE_TUNE_BUCKETS; d++) {
+			if (b - d >= 0 && s_aussie_tuned[op][b - d].variant >= 0) {
+				s_aussie_bound[op][b] = &s_aussie_registry[s_aussie_tuned[op][b - d].variant];
+				break;
+			}
+			if (b + d < AUSSIE_TUNE_BUCKETS && s_aussie_tuned[op][b + d].variant >= 0) {
+				s_aussie_bound[op][b] = &s_aussie_registry[s_aussie_tuned[op][b + d].variant];
+				break;
+			}
+		}
+	}
+}
+
+struct aussie_tune_args {
+	const aussie_kernel_variant* v;
+	float* v1;
+	float* v2;
+	int n;
+};
+
+static void aussie_tune_call(void* arg)
+{
+	aussie_tune_args* args = (aussie_tune_args*)arg;
+	switch (args->v->op) {
+	case AUSSIE_OP_VECDOT: g_aussie_bench_sink = args->v->vecdotfn(args->v1, args->v2, args->n); break;
+	case AUSSIE_OP_SOFTMAX: args->v->inplacefn(args->v1, args->n); break;
+	default: g_aussie_bench_sink = args->v->reducefn(args->v1, args->n); break;
+	}
+}
+
+const aussie_kernel_variant* aussie_tune_op(int op, int n)  // Benchmark the eligible, verified variants, bind the fastest
+{
+	aussie_registry_init();
+	if (op < 0 || op >= AUSSIE_OP_MAX_OPS || n <= 0) {
+		yassert(op >= 0 && op < AUSSIE_OP_MAX_OPS && n > 0);
+		return NULL;  // fail
+	}
+	aussie_tune_args args;
+	args.n = n;
+	args.v1 = (float*)AUSSIE_ALIGNED_MALLOC(n * sizeof(float), 64);  // Aligned enough for any variant
+	args.v2 = (float*)AUSSIE_ALIGNED_MALLOC(n * sizeof(float), 64);
+	if (!args.v1 || !args.v2) {
+		yassert(args.v1 && args.v2);
+		if (args.v1) AUSSIE_ALIGNED_FREE(args.v1);
+		if (args.v2) AUSSIE_ALIGNED_FREE(args.v2);
+		return NULL;  // fail
+	}
+	for (int i = 0; i < n; i++) {
+		args.v1[i] = (float)(i % 13) * 0.1f - 0.6f;
+		args.v2[i] = (float)(i % 7) * 0.1f - 0.3f;
+	}
+
+	// A short budget: tuning runs at startup or install time
+	aussie_bench_config_ensure();  // Apply AUSSIE_BENCH_* first: the first run would otherwise override these, and the restore would drop them
+	aussie_bench_config savecfg = g_aussie_bench_config;
+	g_aussie_bench_config.max_seconds = 0.02;
+	g_aussie_bench_config.min_sample_ns = 20000;
+	g_aussie_bench_config.warmup_samples = 1;
+	g_aussie_bench_config.min_samples = 3;
+	g_aussie_bench_config.counters = false;
+
+	int best = -1;
+	double bestns = 0.0;
+	for (int i = 0; i < s_aussie_registry_count; i++) {
+		const aussie_kernel_variant& v = s_aussie_registry[i];
+		if (v.op != op || !aussie_registry_eligible(v, n, args.v1, args.v2)) continue;
+		if (!aussie_registry_verify(v, n)) {
+			fprintf(stderr, "WARNING: %s: %s fails verification at n=%d, not used\n", __func__, v.name, n);
+			continue;
+		}
+		args.v = &v;
+		aussie_bench_result res;
+		aussie_bench_result_init(res, v.name, n, 0.0, 0.0);
+		if (!aussie_bench_run(res, aussie_tune_call, &args, NULL)) continue;
+		if (best < 0 || res.ns_median < bestns) {
+			best = i;
+			bestns = res.ns_median;
+		}
+	}
+	g_aussie_bench_config = savecfg;
+	AUSSIE_ALIGNED_FREE(args.v1);
+	AUSSIE_ALIGNED_FREE(args.v2);
+
+	if (best < 0) return NULL;  // Nothing eligible
+	int b = aussie_tune_bucket(n);
+	s_aussie_tuned[op][b].variant = best;
+	s_aussie_tuned[op][b].ns = bestns;
+	aussie_tune_rebind(op);
+	return &s_aussie_registry[best];
+}
+
+void aussie_tune(const int sizes[], int nsizes)  // Benchmark and bind every operation at these sizes
+{
+	for (int op = 0; op < AUSSIE_OP_MAX_OPS; op++) {
+		for (int i = 0; i < nsizes; i++) {
+			const aussie_kernel_variant* v = aussie_tune_op(op, sizes[i]);
+			if (v) aussie_bench_printf("Tuned %s N=%d: %s\n", aussie_registry_op_name(op), sizes[i], v->name);
+		}
+	}
+}
+
+const aussie_kernel_variant* aussie_tuned_variant(int op, int n)
+{
+	if (op < 0 || op >= AUSSIE_OP_MAX_OPS) return NULL;
+	return s_aussie_bound[op][aussie_tune_bucket(n)];
+}
+
+//---------------------------------------------------
+// Tuning file: one line per operation and bucket
+//   isa avx512
+//   vecdot 10 aussie_vecdot_FMA_unroll_AVX512 123.4
+//---------------------------------------------------
+
+static const char* aussie_tune_path(const char* path)
+{
+	if (path) return path;
+	const char* env = getenv("AUSSIE_TUNE_FILE");
+	return env ? env : "aussie_tune.txt";
+}
+
+bool aussie_tune_save(const char* path)
+{
+	aussie_registry_init();
+	aussie_dispatch_ensure();
+	path = aussie_tune_path(path);
+	FILE* fp = fopen(path, "w");
+	if (!fp) {
+		fprintf(stderr, "ERROR: %s: Cannot write tuning file %s\n", __func__, path);
+		return false;  // fail
+	}
+	fprintf(fp, "# Aussie AI kernel tuning (operation, size bucket log2(n), winner, median ns)\n");
+	fprintf(fp, "isa %s\n", aussie_dispatch_isa_name(g_aussie_dispatch.isa));
+	for (int op = 0; op < AUSSIE_OP_MAX_OPS; op++) {
+		for (int b = 0; b < AUSSIE_TUNE_BUCKETS; b++) {
+			const aussie_tune_entry& e = s_aussie_tuned[op][b];
+			if (e.variant >= 0) fprintf(fp, "%s %d %s %.1f\n", aussie_registry_op_name(op), b, s_aussie_registry[e.variant].name, e.ns);
+		}
+	}
+	fclose(fp);
+	return true;
+}
+
+bool aussie_tune_load(const char* path)
+{
+	aussie_registry_init();
+	aussie_dispatch_ensure();
+	path = aussie_tune_path(path);
+	FILE* fp = fopen(path, "r");
+	if (!fp) return false;  // Not tuned yet
+	char line[256], opname[64], isaname[64], vname[128];
+	bool isa_ok = false;
+	int nloaded = 0;
+	while (fgets(line, sizeof(line), fp)) {
+		if (line[0] == '#') continue;
+		if (sscanf(line, "isa %63s", isaname) == 1) {
+			isa_ok = (strcmp(isaname, aussie_dispatch_isa_name(g_aussie_dispatch.isa)) == 0);
+			if (!isa_ok) break;  // Tuned on another machine (or another AUSSIE_ISA)
+			continue;
+		}
+		int b = 0;
+		double ns = 0.0;
+		if (!isa_ok || sscanf(line, "%63s %d %127s %lf", opname, &b, vname, &ns) != 4) continue;
+		const aussie_kernel_variant* v = aussie_registry_find(vname);
+		if (!v || b < 0 || b >= AUSSIE_TUNE_BUCKETS || strcmp(aussie_registry_op_name(v->op), opname) != 0) continue;  // Stale entry
+		if (v->isa > g_aussie_dispatch.isa) continue;
+		s_aussie_tuned[v->op][b].variant = (int)(v - s_aussie_registry);
+		s_aussie_tuned[v->op][b].ns = ns;
+		nloaded++;
+	}
+	fclose(fp);
+	if (!isa_ok) return false;
+	for (int op = 0; op < AUSSIE_OP_MAX_OPS; op++) aussie_tune_rebind(op);
+	return true;
+}
+
+void aussie_tune_startup(const int sizes[], int nsizes)  // Load the tuning file, tune whatever it lacks, save it
+{
+	aussie_registry_init();
+	if (aussie_tune_load(NULL)) aussie_bench_printf("Loaded tuning file %s\n", aussie_tune_path(NULL));
+	bool changed = false;
+	for (int op = 0; op < AUSSIE_OP_MAX_OPS; op++) {
+		for (int i = 0; i < nsizes; i++) {
+			if (sizes[i] <= 0 || s_aussie_tuned[op][aussie_tune_bucket(sizes[i])].variant >= 0) continue;  // Cached
+			const aussie_kernel_variant* v = aussie_tune_op(op, sizes[i]);
+			if (!v) continue;
+			aussie_bench_printf("Tuned %s N=%d: %s\n", aussie_registry_op_name(op), sizes[i], v->name);
+			changed = true;
+		}
+	}
+	if (changed && aussie_tune_save(NULL)) aussie_bench_printf("Saved tuning file %s\n", aussie_tune_path(NULL));
+}
+
+//---------------------------------------------------
+// Tuned kernels: the bound winner if it fits this call, else the dispatched kernel
+//---------------------------------------------------
+
+float aussie_vecdot_tuned(const float v1[], const float v2[], int n)
+{
+	const aussie_kernel_variant* v = s_aussie_bound[AUSSIE_OP_VECDOT][aussie_tune_bucket(n)];
+	if (v && aussie_registry_fits(*v, n, v1, v2)) return v->vecdotfn(v1, v2, n);
+	return aussie_vecdot_dispatch(v1, v2, n);
+}
+
+float aussie_vector_sum_tuned(float v[], int n)
+{
+	const aussie_kernel_variant* k = s_aussie_bound[AUSSIE_OP_SUM][aussie_tune_bucket(n)];
+	if (k && aussie_registry_fits(*k, n, v, NULL)) return k->reducefn(v, n);
+	return aussie_vector_sum_dispatch(v, n);
+}
+
+float aussie_vector_sum_squares_tuned(float v[], int n)
+{
+	const aussie_kernel_variant* k = s_aussie_bound[AUSSIE_OP_SUM_SQUARES][aussie_tune_bucket(n)];
+	if (k && aussie_registry_fits(*k, n, v, NULL)) return k->reducefn(v, n);
+	return aussie_vector_sum_squares(v, n);  // No dispatched version
+}
+
+float aussie_vector_max_tuned(float v[], int n)
+{
+	const aussie_kernel_variant* k = s_aussie_bound[AUSSIE_OP_MAX][aussie_tune_bucket(n)];
+	if (k && aussie_registry_fits(*k, n, v, NULL)) return k->reducefn(v, n);
+	return aussie_vector_max_dispatch(v, n);
+}
+
+void aussie_vector_softmax_tuned(float v[], int n)
+{
+	const aussie_kernel_variant* k = s_aussie_bound[AUSSIE_OP_SOFTMAX][aussie_tune_bucket(n)];
+	if (k && aussie_registry_fits(*k, n, v, NULL)) k->inplacefn(v, n);
+	else aussie_vector_softmax_dispatch(v, n);
+}
+
+//---------------------------------------------------
+// Unit tests
+//---------------------------------------------------
+
+static float aussie_registry_test_vecdot_wrong(const float v1[], const float v2[], int n)  // Drops the last element
+{
+	return aussie_vecdot_basic(v1, v2, n > 0 ? n - 1 : 0);
+}
+
+void aussie_registry_unit_tests()
+{
+	fprintf(stderr, "INFO: %s: Running unit tests\n", __func__);
+	aussie_dispatch_ensure();
+
+	// Lookup
+	for (int op = 0; op < AUSSIE_OP_MAX_OPS; op++) ytest(aussie_registry_count(op) >= 2);
+	ytest(aussie_registry_get(AUSSIE_OP_VECDOT, 0) == aussie_registry_find("aussie_vecdot_basic"));
+	ytest(aussie_registry_get(AUSSIE_OP_VECDOT, aussie_registry_count(AUSSIE_OP_VECDOT)) == NULL);
+	ytest(aussie_registry_find("no such kernel") == NULL);
+	ytest(strcmp(aussie_registry_op_name(AUSSIE_OP_SOFTMAX), "softmax") == 0);
+
+	// Every variant this CPU can run is correct, at each size it accepts
+	int sizes[] = { 1, 2, 3, 4, 7, 8, 15, 16, 17, 31, 33, 64, 65, 100, 1000, 5000 };
+	for (int op = 0; op < AUSSIE_OP_MAX_OPS; op++) {
+		for (int i = 0; i < aussie_registry_count(op); i++) {
+			const aussie_kernel_variant* v = aussie_registry_get(op, i);
+			for (int s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++) {
+				if (!aussie_registry_eligible(*v, sizes[s], NULL, NULL)) continue;
+				if (!aussie_registry_verify(*v, sizes[s])) {
+					fprintf(stderr, "ERROR: %s: %s fails at n=%d\n", __func__, v->name, sizes[s]);
+					ytest(false);
+				}
+			}
+		}
+	}
+
+	// Constraints: length, alignment, ISA
+	const aussie_kernel_variant* unroll4 = aussie_registry_find("aussie_vecdot_unroll4_basic");
+	ytest(unroll4 && aussie_registry_eligible(*unroll4, 8, NULL, NULL));
+	ytest(unroll4 && !aussie_registry_eligible(*unroll4, 7, NULL, NULL));
+	aussie_kernel_variant aligned = *aussie_registry_find("aussie_vecdot_basic");
+	aligned.align = 64;
+	alignas(64) float buf[32] = { 0 };
+	ytest(aussie_registry_eligible(aligned, 16, buf, buf));
+	ytest(!aussie_registry_eligible(aligned, 16, buf + 1, buf));
+	aussie_kernel_variant avx512 = aligned;
+	avx512.align = 0;
+	avx512.isa = AUSSIE_ISA_AVX512;
+	int saveisa = g_aussie_dispatch.isa;
+	aussie_dispatch_set_isa(AUSSIE_ISA_SCALAR);
+	ytest(!aussie_registry_eligible(avx512, 16, NULL, NULL));  // AUSSIE_ISA=scalar also limits the tuner
+	aussie_dispatch_set_isa(saveisa);
+
+	// A wrong variant fails verification (checked on its own, not registered)
+	aussie_kernel_variant wrong = aligned;
+	wrong.align = 0;
+	wrong.name = "test_vecdot_wrong";
+	wrong.vecdotfn = aussie_registry_test_vecdot_wrong;
+	ytest(aussie_registry_verify(wrong, 100) == false);
+	ytest(aussie_registry_add(aligned) == false);  // Duplicate name
+
+	// Tune, then the tuned call gives the same answer
+	aussie_tune_reset();
+	float v1[1000], v2[1000];
+	for (int i = 0; i < 1000; i++) { v1[i] = (float)(i % 11) * 0.1f; v2[i] = (float)(i % 5) * 0.2f - 0.4f; }
+	ytest(aussie_tuned_variant(AUSSIE_OP_VECDOT, 1000) == NULL);
+	const aussie_kernel_variant* win = aussie_tune_op(AUSSIE_OP_VECDOT, 1000);
+	ytest(win != NULL);
+	ytest(aussie_tuned_variant(AUSSIE_OP_VECDOT, 1000) == win);
+	ytest(aussie_tuned_variant(AUSSIE_OP_VECDOT, 1023) == win);  // Same bucket
+	ytest(aussie_tuned_variant(AUSSIE_OP_VECDOT, 64) == win);    // Nearest tuned bucket
+	ytest(fabs(aussie_vecdot_tuned(v1, v2, 1000) - aussie_vecdot_basic(v1, v2, 1000)) < 1e-3);
+	ytest(fabs(aussie_vecdot_tuned(v1, v2, 999) - aussie_vecdot_basic(v1, v2, 999)) < 1e-3);  // Falls back if the winner needs n % 4 == 0
+	const aussie_kernel_variant* winmax = aussie_tune_op(AUSSIE_OP_MAX, 1000);
+	ytest(winmax != NULL);
+	ytestf(aussie_vector_max_tuned(v1, 1000), aussie_vector_max(v1, 1000));
+
+	// Save, reset, load: the same winners come back
+	// A unique temporary file, so concurrent test runs don't share it
+	char path[1000];
+#if LINUX
+	const char* tmpdir = getenv("TMPDIR");
+	snprintf(path, sizeof(path), "%s/aussie_tune_unit_test.XXXXXX", tmpdir && *tmpdir ? tmpdir : "/tmp");
+	int fd = mkstemp(path);
+	if (fd < 0) {
+		ytest(fd >= 0);
+		aussie_tune_reset();
+		return;  // fail
+	}
+	close(fd);
+#else
+	const char* tmpdir = getenv("TEMP");
+	snprintf(path, sizeof(path), "%s\\aussie_tune_unit_test.%d.txt", tmpdir && *tmpdir ? tmpdir : ".", (int)_getpid());
+#endif //LINUX
+	ytest(aussie_tune_save(path));
+	aussie_tune_reset();
+	ytest(aussie_tuned_variant(AUSSIE_OP_VECDOT, 1000) == NULL);
+	ytest(aussie_tune_load(path));
+	ytest(aussie_tuned_variant(AUSSIE_OP_VECDOT, 1000) == win);
+	ytest(aussie_tuned_variant(AUSSIE_OP_MAX, 1000) == winmax);
+	ytest(aussie_tuned_variant(AUSSIE_OP_SOFTMAX, 1000) == NULL);
+
+	// A file for another ISA is ignored
+	FILE* fp = fopen(path, "w");
+	if (fp) {
+		fprintf(fp, "isa some_other_cpu\nvecdot 9 aussie_vecdot_basic 1.0\n");
+		fclose(fp);
+		aussie_tune_reset();
+		ytest(!aussie_tune_load(path));
+		ytest(aussie_tuned_variant(AUSSIE_OP_VECDOT, 1000) == NULL);
+	}
+	remove(path);
+	ytest(!aussie_tune_load(path));  // Missing file
+	aussie_tune_reset();
+}
+
+//---------------------------------------------------
+//---------------------------------------------------
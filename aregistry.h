@@ -0,0 +1,81 @@
+//---------------------------------------------------
+// aregistry.h -- Kernel registry and auto-tuner -- Aussie AI Base Library
+// Created Oct 17th 2026
+// Copyright (c) 2023 Aussie AI Labs Pty Ltd
+//---------------------------------------------------
+
+#ifndef AUSSIE_YREGISTRY_INCLUDE_HEADER_H
+#define AUSSIE_YREGISTRY_INCLUDE_HEADER_H
+
+//---------------------------------------------------
+// Kernel registry: the interchangeable variants of an operation, each self-describing
+// ... ISA requirement, alignment and length constraints, and a correctness tolerance
+// ... the built-in variants are registered on first use; aussie_registry_add() adds more
+// ... needs adispatch.h first (function pointer types and AUSSIE_ISA_*)
+//---------------------------------------------------
+
+#define AUSSIE_OP_VECDOT       0   // float fn(v1, v2, n)
+#define AUSSIE_OP_SUM          1   // float fn(v, n)
+#define AUSSIE_OP_SUM_SQUARES  2   // float fn(v, n)
+#define AUSSIE_OP_MAX          3   // float fn(v, n)
+#define AUSSIE_OP_SOFTMAX      4   // void fn(v, n), in place
+#define AUSSIE_OP_MAX_OPS      5
+
+struct aussie_kernel_variant {
+	const char* name;       // The function name
+	int op;                 // AUSSIE_OP_*
+	int isa;                // Needs this AUSSIE_ISA_* level (as dispatched, so AUSSIE_ISA limits it too)
+	int align;              // Vectors must be aligned to this many bytes (0 = any)
+	int nmultiple;          // n must be a multiple of this (1 = any)
+	int nmin;               // Smallest n
+	float tolerance;        // Allowed error versus a double-precision reference, relative to the size of the terms
+	aussie_vecdot_fnptr vecdotfn;           // AUSSIE_OP_VECDOT
+	aussie_vector_reduce_fnptr reducefn;    // AUSSIE_OP_SUM, AUSSIE_OP_SUM_SQUARES, AUSSIE_OP_MAX
+	aussie_vector_inplace_fnptr inplacefn;  // AUSSIE_OP_SOFTMAX
+};
+
+#define AUSSIE_REGISTRY_MAX 64
+
+bool aussie_registry_add(const aussie_kernel_variant& v);  // False if the registry is full or the entry is bad
+int aussie_registry_count(int op);
+const aussie_kernel_variant* aussie_registry_get(int op, int i);  // i-th variant of an operation (NULL past the end)
+const aussie_kernel_variant* aussie_registry_find(const char* name);
+const char* aussie_registry_op_name(int op);
+bool aussie_registry_eligible(const aussie_kernel_variant& v, int n, const float* v1, const float* v2);  // This CPU, this n, these pointers
+bool aussie_registry_verify(const aussie_kernel_variant& v, int n);  // Within tolerance on test data of about this size
+
+//---------------------------------------------------
+// Auto-tuner: benchmark the eligible, verified variants at the sizes actually used,
+// and bind the fastest for each operation and size bucket (powers of 2).
+// ... the winners are cached in a small text file (AUSSIE_TUNE_FILE, default "aussie_tune.txt"),
+//     for one ISA, so later runs load them instead of benchmarking
+// ... a *_tuned call uses the winner of the nearest tuned bucket if it fits this call
+//     (length, alignment), otherwise the dispatched kernel
+//---------------------------------------------------
+
+#define AUSSIE_TUNE_BUCKETS 32   // Bucket b holds n in [2^b, 2^(b+1))
+
+void aussie_tune(const int sizes[], int nsizes);  // Benchmark and bind every operation at these sizes
+const aussie_kernel_variant* aussie_tune_op(int op, int n);  // One operation at one size (returns the winner)
+bool aussie_tune_save(const char* path);  // NULL = AUSSIE_TUNE_FILE or the default
+bool aussie_tune_load(const char* path);  // False if missing, or tuned for another ISA
+void aussie_tune_startup(const int sizes[], int nsizes);  // Load the tuning file, tune whatever it lacks, save it
+void aussie_tune_reset();  // Unbind everything (dispatched kernels again)
+const aussie_kernel_variant* aussie_tuned_variant(int op, int n);  // Bound variant for this size (NULL = none)
+
+float aussie_vecdot_tuned(const float v1[], const float v2[], int n);
+float aussie_vector_sum_tuned(float v[], int n);
+float aussie_vector_sum_squares_tuned(float v[], int n);
+float aussie_vector_max_tuned(float v[], int n);
+void aussie_vector_softmax_tuned(float v[], int n);
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+void aussie_registry_unit_tests();
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+
+#endif //AUSSIE_YREGISTRY_INCLUDE_HEADER_H
@@ -0,0 +1,318 @@
+// asample.cpp -- Token sampling (temperature, top-k, top-p) -- Aussie AI Base Library
+// Created Oct 17th 2026
+// Copyright (c) 2023 Aussie AI Labs Pty Ltd
+//---------------------------------------------------
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <math.h>
+#include <algorithm>   // std::nth_element, std::sort
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+#include "aport.h"
+#include "aussieai.h"
+#include "aassert.h"
+#include "atest.h"
+#include "avector.h"
+#include "adispatch.h"
+#include "asoftmax.h"
+#include "atopk.h"
+
+#include "asample.h"  // self-include
+
+//---------------------------------------------------
+// RNG
+//---------------------------------------------------
+
+void aussie_rng_seed(aussie_rng& rng, unsigned long long seed)
+{
+	// SplitMix64 scrambles the seed (so seeds 1, 2, 3... give unrelated sequences)
+	unsigned long long z = seed + 0x9E3779B97F4A7C15ULL;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	z = z ^ (z >> 31);
+	rng.state = z ? z : 0x9E3779B97F4A7C15ULL;  // Xorshift state must not be zero
+}
+
+unsigned int aussie_rng_next_u32(aussie_rng& rng)
+{
+	unsigned long long x = rng.state;
+	x ^= x >> 12;
+	x ^= x << 25;
+	x ^= x >> 27;
+	rng.state = x;
+	return (unsigned int)((x * 0x2545F4914F6CDD1DULL) >> 32);  // High bits are the best
+}
+
+float aussie_rng_uniform(aussie_rng& rng)  // In [0,1)
+{
+	return (float)(aussie_rng_next_u32(rng) >> 8) * (1.0f / 16777216.0f);  // 24 bits of mantissa
+}
+
+//---------------------------------------------------
+// Sampler
+//---------------------------------------------------
+
+bool aussie_sampler_init(aussie_sampler& s, int nvocab, float temperature, int topk, float topp, unsigned long long seed)
+{
+	memset(&s, 0, sizeof(s));
+	if (nvocab <= 0 || topk < 0 || !(topp > 0.0f)) {
+		yassert(nvocab > 0 && topk >= 0 && topp > 0.0f);
+		return false;  // fail
+	}
+	s.temperature = temperature;
+	s.topk = topk;
+	s.topp = topp;
+	aussie_rng_seed(s.rng, seed);
+	s.nvocab = nvocab;
+	s.probs = (float*)malloc(nvocab * sizeof(float));
+	s.indices = (int*)malloc(nvocab * sizeof(int));
+	s.items = (aussie_topk_item*)malloc(nvocab * sizeof(aussie_topk_item));
+	if (!s.probs || !s.indices || !s.items) {
+		yassert(s.probs && s.indices && s.items);
+		aussie_sampler_free(s);
+		return false;  // fail
+	}
+	return true;
+}
+
+void aussie_sampler_free(aussie_sampler& s)
+{
+	free(s.probs);
+	free(s.indices);
+	free(s.items);
+	s.probs = NULL;
+	s.indices = NULL;
+	s.items = NULL;
+	s.nvocab = 0;
+}
+
+static inline bool aussie_sample_item_better(const aussie_topk_item& a, const aussie_topk_item& b)  // Ranks above (descending, ties by index)
+{
+	return a.fval > b.fval || (a.fval == b.fval && a.index < b.index);
+}
+
+static int aussie_sample_nucleus_select(aussie_topk_item items[], int nitems, float fneed)
+{
+	// Weighted quickselect: reorder items so the fewest most likely items holding fneed
+	// come first, and return how many. Only the last small range gets sorted, O(n) average.
+	int lo = 0, hi = nitems;
+	float fbefore = 0.0f;  // Mass of items[0..lo), which all rank above items[lo..hi)
+	while (hi - lo > 16) {
+		int mid = lo + (hi - lo) / 2;
+		std::nth_element(items + lo, items + mid, items + hi, aussie_sample_item_better);
+		float fleft = 0.0f;
+		for (int j = lo; j < mid; j++) fleft += items[j].fval;
+		if (fbefore + fleft >= fneed) {
+			hi = mid;  // Cutoff is in the left half
+		}
+		else {
+			fbefore += fleft;
+			lo = mid;
+		}
+	}
+	std::sort(items + lo, items + hi, aussie_sample_item_better);
+	for (int j = lo; j < hi; j++) {
+		fbefore += items[j].fval;
+		if (fbefore >= fneed) return j + 1;
+	}
+	return hi;  // Roundoff: keep them all
+}
+
+static int aussie_sample_from_items(aussie_sampler& s, aussie_topk_item items[], int nitems, float total)
+{
+	// items[].fval are weights (probabilities, maybe unnormalized)
+	// Top-p: keep the fewest most likely items whose weights reach topp of the total
+	int nkeep = nitems;
+	if (s.topp < 1.0f) nkeep = aussie_sample_nucleus_select(items, nitems, s.topp * total);
+	float fkept = 0.0f;
+	for (int j = 0; j < nkeep; j++) fkept += items[j].fval;
+
+	// Draw from the kept items (renormalized)
+	float r = aussie_rng_uniform(s.rng) * fkept;
+	for (int j = 0; j < nkeep; j++) {
+		r -= items[j].fval;
+		if (r < 0.0f) return items[j].index;
+	}
+	return items[nkeep - 1].index;  // Roundoff
+}
+
+int aussie_sample_token(aussie_sampler& s, const float logits[], int n)  // Returns the token index (-1 on error)
+{
+	if (n <= 0 || n > s.nvocab || !s.probs) {
+		yassert(n > 0 && n <= s.nvocab && s.probs);
+		return -1;  // fail
+	}
+
+	// Greedy decoding: argmax only
+	if (s.temperature <= 0.0f) {
+		aussie_vector_top_k_select_scratch(logits, n, 1, s.items, s.indices, s.items);
+		return s.items[0].index;
+	}
+
+	// Top-k: partial selection first, then softmax over only k logits
+	float rtemp = 1.0f / s.temperature;
+	if (s.topk > 0 && s.topk < n) {
+		int nk = aussie_vector_top_k_select_scratch(logits, n, s.topk, s.items, s.indices, s.items);  // Sorted descending (sampler scratch)
+		float fmax = s.items[0].fval;
+		float total = 0.0f;
+		for (int j = 0; j < nk; j++) {
+			s.items[j].fval = expf((s.items[j].fval - fmax) * rtemp);  // Softmax numerators
+			total += s.items[j].fval;
+		}
+		return aussie_sample_from_items(s, s.items, nk, total);
+	}
+
+	// Whole vocabulary: SIMD softmax of the scaled logits
+	memcpy(s.probs, logits, n * sizeof(float));
+	if (rtemp != 1.0f) aussie_vector_multiply_scalar_dispatch(s.probs, n, rtemp);
+	aussie_vector_softmax_dispatch(s.probs, n);
+
+	if (s.topp >= 1.0f) {
+		// No cutoff: inverse CDF by a linear scan (no sorting needed)
+		float r = aussie_rng_uniform(s.rng);
+		int ilast = 0;
+		for (int i = 0; i < n; i++) {
+			if (s.probs[i] > 0.0f) {
+				r -= s.probs[i];
+				ilast = i;
+				if (r < 0.0f) return i;
+			}
+		}
+		return ilast;  // Roundoff
+	}
+
+	// Top-p: candidates above a probability threshold, lowered until they hold mass p.
+	// A token in the nucleus has probability > (1-p)/n (the tokens no more likely than it
+	// hold more than 1-p of the mass, and there are at most n of them),
+	// so the last threshold always finds the whole nucleus.
+	float fthresh_min = (1.0f - s.topp) / (float)n;
+	float fthresh = 1.0f / 64.0f;
+	int ncand = 0;
+	for (;;) {
+		if (fthresh < fthresh_min) fthresh = fthresh_min;
+		ncand = aussie_vector_indices_ge_dispatch(s.probs, n, fthresh, s.indices, n);
+		float fmass = 0.0f;
+		for (int j = 0; j < ncand; j++) fmass += s.probs[s.indices[j]];
+		if (fmass >= s.topp || fthresh <= fthresh_min) break;
+		fthresh *= (1.0f / 16.0f);
+	}
+	if (ncand <= 0) {
+		yassert(ncand > 0);
+		return -1;  // fail (NaN logits?)
+	}
+	for (int j = 0; j < ncand; j++) {
+		s.items[j].fval = s.probs[s.indices[j]];
+		s.items[j].index = s.indices[j];
+	}
+	return aussie_sample_from_items(s, s.items, ncand, 1.0f);
+}
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+static void aussie_sample_test_frequencies(float temperature, int topk, float topp, const float expect[4])
+{
+	// Four tokens with probabilities 0.5, 0.3, 0.15, 0.05 (at temperature 1)
+	float logits[4] = { logf(0.5f), logf(0.3f), logf(0.15f), logf(0.05f) };
+	aussie_sampler s;
+	ytest(aussie_sampler_init(s, 4, temperature, topk, topp, 12345));
+	int counts[4] = { 0, 0, 0, 0 };
+	const int ndraws = 20000;
+	for (int i = 0; i < ndraws; i++) {
+		int tok = aussie_sample_token(s, logits, 4);
+		ytest(tok >= 0 && tok < 4);
+		if (tok >= 0 && tok < 4) counts[tok]++;
+	}
+	for (int t = 0; t < 4; t++) {
+		ytest(fabsf((float)counts[t] / ndraws - expect[t]) <= 0.015f);
+		if (expect[t] == 0.0f) ytesti(counts[t], 0);
+	}
+	aussie_sampler_free(s);
+}
+
+void aussie_sample_unit_tests()
+{
+	fprintf(stderr, "INFO: %s: Running unit tests\n", __func__);
+
+	// RNG: deterministic per seed, in [0,1), about uniform
+	aussie_rng r1, r2;
+	aussie_rng_seed(r1, 42);
+	aussie_rng_seed(r2, 42);
+	bool same = true, inrange = true;
+	double dsum = 0.0;
+	for (int i = 0; i < 10000; i++) {
+		float f1 = aussie_rng_uniform(r1);
+		if (f1 != aussie_rng_uniform(r2)) same = false;
+		if (f1 < 0.0f || f1 >= 1.0f) inrange = false;
+		dsum += f1;
+	}
+	ytest(same);
+	ytest(inrange);
+	ytest(fabs(dsum / 10000 - 0.5) < 0.01);
+	aussie_rng_seed(r2, 43);
+	ytest(aussie_rng_next_u32(r1) != aussie_rng_next_u32(r2));
+
+	// Frequencies: plain, top-p (first two tokens hold 0.8), top-k (renormalized), both
+	float expect_all[4] = { 0.5f, 0.3f, 0.15f, 0.05f };
+	aussie_sample_test_frequencies(1.0f, 0, 1.0f, expect_all);
+	float expect_p[4] = { 0.625f, 0.375f, 0.0f, 0.0f };
+	aussie_sample_test_frequencies(1.0f, 0, 0.75f, expect_p);
+	float expect_k[4] = { 0.5f / 0.95f, 0.3f / 0.95f, 0.15f / 0.95f, 0.0f };
+	aussie_sample_test_frequencies(1.0f, 3, 1.0f, expect_k);
+	aussie_sample_test_frequencies(1.0f, 3, 0.75f, expect_p);
+	float expect_greedy[4] = { 1.0f, 0.0f, 0.0f, 0.0f };
+	aussie_sample_test_frequencies(0.0f, 0, 1.0f, expect_greedy);
+	aussie_sample_test_frequencies(1.0f, 1, 1.0f, expect_greedy);
+	aussie_sample_test_frequencies(1.0f, 0, 0.01f, expect_greedy);
+	float expect_cold[4] = { 0.25f / 0.365f, 0.09f / 0.365f, 0.0225f / 0.365f, 0.0025f / 0.365f };  // Squared (T=0.5)
+	aussie_sample_test_frequencies(0.5f, 0, 1.0f, expect_cold);
+
+	// Big vocabulary: every top-p token drawn is in the nucleus (found by a full sort)
+	const int n = 50000;
+	float* logits = (float*)malloc(n * sizeof(float));
+	float* lcopy = (float*)malloc(n * sizeof(float));
+	aussie_topk_item* sorted = (aussie_topk_item*)malloc(n * sizeof(aussie_topk_item));
+	aussie_sampler s;
+	if (!logits || !lcopy || !sorted || !aussie_sampler_init(s, n, 0.8f, 0, 0.9f, 7)) {
+		yassert(false);
+		free(logits); free(lcopy); free(sorted);
+		return;  // fail
+	}
+	for (int i = 0; i < n; i++) logits[i] = (float)((i * 7919L) % 10007) * 0.001f;  // 0..10
+	aussie_vector_copy_basic(lcopy, logits, n);
+	aussie_vector_copy_basic(s.probs, logits, n);
+	aussie_vector_multiply_scalar(s.probs, n, 1.0f / 0.8f);
+	aussie_vector_softmax_basic(s.probs, n);
+	for (int i = 0; i < n; i++) {
+		sorted[i].fval = s.probs[i];
+		sorted[i].index = i;
+	}
+	qsort(sorted, n, sizeof(sorted[0]), aussie_top_k_item_cmp);
+	float fmass = 0.0f;
+	int nnucleus = 0;
+	while (nnucleus < n && fmass < 0.9f) fmass += sorted[nnucleus++].fval;
+	float fsmallest = sorted[nnucleus - 1].fval;
+	bool innucleus = true;
+	for (int i = 0; i < 200; i++) {
+		int tok = aussie_sample_token(s, logits, n);
+		if (tok < 0 || tok >= n) innucleus = false;
+		else if (s.probs[tok] < fsmallest * 0.999f) innucleus = false;  // Roundoff at the boundary
+	}
+	ytest(innucleus);
+	ytest(aussie_vector_equal(logits, lcopy, n));  // Logits unchanged
+	aussie_sampler_free(s);
+	free(logits); free(lcopy); free(sorted);
+}
+
+//---------------------------------------------------
+//---------------------------------------------------
+
@@ -0,0 +1,59 @@
+//---------------------------------------------------
+// asample.h -- Token sampling (temperature, top-k, top-p) -- Aussie AI Base Library
+// Created Oct 17th 2026
+// Copyright (c) 2023 Aussie AI Labs Pty Ltd
+//---------------------------------------------------
+
+#ifndef AUSSIE_YSAMPLE_INCLUDE_HEADER_H
+#define AUSSIE_YSAMPLE_INCLUDE_HEADER_H
+
+//---------------------------------------------------
+// Seeded fast RNG (xorshift64*): same seed, same tokens
+//---------------------------------------------------
+
+struct aussie_rng {
+	unsigned long long state;  // Never zero
+};
+
+void aussie_rng_seed(aussie_rng& rng, unsigned long long seed);
+unsigned int aussie_rng_next_u32(aussie_rng& rng);
+float aussie_rng_uniform(aussie_rng& rng);  // In [0,1)
+
+//---------------------------------------------------
+// Sampler: temperature -> softmax -> top-k -> top-p -> draw, in one call
+// ... the vocabulary is never fully sorted:
+//     top-k uses partial selection (aussie_vector_top_k_select_scratch), then softmax over the k candidates
+//     top-p alone uses the SIMD softmax, then keeps only tokens above a probability threshold
+//     (lowered until their mass reaches p), then a weighted quickselect finds the nucleus
+// ... scratch buffers are allocated once by aussie_sampler_init, and the top-k selection runs in them,
+//     so no allocation per token
+// ... logits are not modified
+//---------------------------------------------------
+
+struct aussie_topk_item;
+
+struct aussie_sampler {
+	float temperature;  // 0 = greedy (argmax), 1 = unchanged, >1 flatter
+	int topk;           // Keep only the k most likely tokens (0 = no limit)
+	float topp;         // Keep the fewest tokens with this much probability mass (1.0 = no limit)
+	aussie_rng rng;
+	int nvocab;         // Size of the scratch buffers
+	float* probs;       // Scratch: nvocab probabilities
+	int* indices;       // Scratch: nvocab candidate indices
+	aussie_topk_item* items;  // Scratch: nvocab candidates (value, index)
+};
+
+bool aussie_sampler_init(aussie_sampler& s, int nvocab, float temperature, int topk, float topp, unsigned long long seed);
+void aussie_sampler_free(aussie_sampler& s);
+int aussie_sample_token(aussie_sampler& s, const float logits[], int n);  // Returns the token index (-1 on error)
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+void aussie_sample_unit_tests();
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+
+#endif //AUSSIE_YSAMPLE_INCLUDE_HEADER_H
@@ -22,6 +22,9 @@
 #include "atest.h"
 #include "avector.h"
 #include "aavx.h"
+#include "adispatch.h"
+#include "athread.h"
+#include "aarena.h"
 
 #include "asoftmax.h"  // self-include
 
@@ -90,12 +93,11 @@ void aussie_vector_softmax_exponentiate_first(float v[], int n)
 
 void aussie_vector_softmax_exponentiate_and_sum_AVX1(float v[], int n)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
 	// Calculate the expf() values first into the vector (to avoid doing it twice)
-	yassert(n % 4 == 0);
 
 	// Element-wise expf on vector...
 	aussie_vector_expf_AVX1(v, n);  // Element-wise expf...
@@ -108,19 +110,18 @@ void aussie_vector_softmax_exponentiate_and_sum_AVX1(float v[], int n)
 	for (int i = 0; i < n; i++) {
 		v[i] *= recip;  // NOTE: v[i] is already expf'd
 	}
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 
 
 void aussie_vector_softmax_fused_exp_sum_mult_AVX1(float v[], int n)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
 	// Calculate the expf() values first into the vector (to avoid doing it twice)
-	yassert(n % 4 == 0);
 	float denom = aussie_vector_fused_expf_sum_AVX1(v, n);  // Element-wise expf fused with SUM...
 	if (denom == 0.0) {
 		yassert(denom != 0.0);
@@ -128,17 +129,16 @@ void aussie_vector_softmax_fused_exp_sum_mult_AVX1(float v[], int n)
 	}
 	float recip = 1.0f / denom;
 	aussie_vector_multiply_scalar_AVX1(v, n, recip);
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 void aussie_vector_softmax_fused_exponentiate_sum_AVX1(float v[], int n)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
 	// Calculate the expf() values first into the vector (to avoid doing it twice)
-	yassert(n % 4 == 0);
 
 	// Element-wise expf on vector...
 	float denom = aussie_vector_fused_expf_sum_AVX1(v, n);  // Element-wise expf fused with SUM...
@@ -151,18 +151,17 @@ void aussie_vector_softmax_fused_exponentiate_sum_AVX1(float v[], int n)
 	for (int i = 0; i < n; i++) {
 		v[i] *= recip;  // NOTE: v[i] is already expf'd
 	}
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 //---------------------------------------------------
 void aussie_vector_softmax_exponentiate_with_AVX1(float v[], int n)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
 	// Calculate the expf() values first into the vector (to avoid doing it twice)
-	yassert(n % 4 == 0);
 
 	// Element-wise expf on vector...
 	aussie_vector_expf_AVX1(v, n);  // Element-wise expf...
@@ -175,18 +174,17 @@ void aussie_vector_softmax_exponentiate_with_AVX1(float v[], int n)
 	for (int i = 0; i < n; i++) {
 		v[i] *= recip;  // NOTE: v[i] is already expf'd
 	}
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 //---------------------------------------------------
 void aussie_vector_softmax_exponentiate_with_AVX2(float v[], int n)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
 	// Calculate the expf() values first into the vector (to avoid doing it twice)
-	yassert(n % 8 == 0);
 
 	// Element-wise expf on vector...
 	aussie_vector_expf_AVX2(v, n);  // Element-wise expf...
@@ -199,17 +197,16 @@ void aussie_vector_softmax_exponentiate_with_AVX2(float v[], int n)
 	for (int i = 0; i < n; i++) {
 		v[i] *= recip;  // NOTE: v[i] is already expf'd
 	}
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 //---------------------------------------------------
 void aussie_vector_softmax_fused_exp_sum_mult_AVX2(float v[], int n) // Softmax with EXP and SUM and MULT in AVX2
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
-	yassert(n % 8 == 0);
 	float denom = aussie_vector_fused_expf_sum_AVX2(v, n);  // Element-wise expf...
 	if (denom == 0.0) {
 		yassert(denom != 0.0);
@@ -217,19 +214,18 @@ void aussie_vector_softmax_fused_exp_sum_mult_AVX2(float v[], int n) // Softmax
 	}
 	float recip = 1.0f / denom;
 	aussie_vector_multiply_scalar_AVX2(v, n, recip);
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 
 //---------------------------------------------------
 void aussie_vector_softmax_fused_exponentiate_sum_AVX2(float v[], int n) // Softmax with both EXP and SUM in AVX2
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
 	// Calculate the expf() values first into the vector (to avoid doing it twice)
-	yassert(n % 8 == 0);
 
 	// Element-wise expf on vector...
 	float denom = aussie_vector_fused_expf_sum_AVX2(v, n);  // Element-wise expf...
@@ -242,17 +238,16 @@ void aussie_vector_softmax_fused_exponentiate_sum_AVX2(float v[], int n) // Soft
 	for (int i = 0; i < n; i++) {
 		v[i] *= recip;  // NOTE: v[i] is already expf'd
 	}
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 //---------------------------------------------------
 void aussie_vector_softmax_exponentiate_and_sum_AVX2(float v[], int n) // Softmax with both EXP and SUM in AVX2
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return;
 #else
 	// Calculate the expf() values first into the vector (to avoid doing it twice)
-	yassert(n % 8 == 0);
 
 	// Element-wise expf on vector...
 	aussie_vector_expf_AVX2(v, n);  // Element-wise expf...
@@ -265,8 +260,197 @@ void aussie_vector_softmax_exponentiate_and_sum_AVX2(float v[], int n) // Softma
 	for (int i = 0; i < n; i++) {
 		v[i] *= recip;  // NOTE: v[i] is already expf'd
 	}
-#endif //LINUX
+#endif //AUSSIE_X86
 }
+//---------------------------------------------------
+void aussie_vector_softmax_fused_exp_sum_mult_AVX512(float v[], int n) // Softmax with EXP and SUM and MULT in AVX-512
+{
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
+	return;
+#else
+	float denom = aussie_vector_fused_expf_sum_AVX512(v, n);  // Element-wise expf...
+	if (denom == 0.0) {
+		yassert(denom != 0.0);
+		return;  // fail (should not occur)
+	}
+	float recip = 1.0f / denom;
+	aussie_vector_multiply_scalar_AVX512(v, n, recip);
+#endif //AUSSIE_X86
+}
+
+//---------------------------------------------------
+// Online softmax (running max and rescaled sum in one read pass)
+//---------------------------------------------------
+
+aussie_softmax_partial aussie_softmax_partial_merge(aussie_softmax_partial p1, aussie_softmax_partial p2)
+{
+	// Rescale both sums to the bigger max
+	aussie_softmax_partial p;
+	p.fmax = p1.fmax > p2.fmax ? p1.fmax : p2.fmax;
+	p.fsum = p1.fsum * expf(p1.fmax - p.fmax) + p2.fsum * expf(p2.fmax - p.fmax);
+	return p;
+}
+
+aussie_softmax_partial aussie_softmax_online_partial(const float v[], int n)  // Read pass
+{
+	aussie_softmax_partial p = { AUSSIE_SOFTMAX_NO_MAX, 0.0f };
+	for (int i = 0; i < n; i++) {
+		if (v[i] > p.fmax) {  // New max: rescale the sum so far
+			p.fsum = p.fsum * expf(p.fmax - v[i]) + 1.0f;
+			p.fmax = v[i];
+		}
+		else {
+			p.fsum += expf(v[i] - p.fmax);
+		}
+	}
+	return p;
+}
+
+void aussie_softmax_online_finish(float v[], int n, aussie_softmax_partial p)  // Write pass
+{
+	float recip = 1.0f / p.fsum;
+	for (int i = 0; i < n; i++) {
+		v[i] = expf(v[i] - p.fmax) * recip;
+	}
+}
+
+void aussie_vector_softmax_online(float v[], int n)
+{
+	aussie_softmax_partial p = aussie_softmax_online_partial(v, n);
+	if (p.fsum == 0.0f) {
+		yassert(p.fsum != 0.0f);
+		return;  // fail (empty, or all -INF)
+	}
+	aussie_softmax_online_finish(v, n, p);
+}
+
+void aussie_vector_softmax_online_AVX2(float v[], int n)
+{
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
+	return;
+#else
+	aussie_softmax_partial p = aussie_softmax_online_partial_AVX2(v, n);
+	if (p.fsum == 0.0f) {
+		yassert(p.fsum != 0.0f);
+		return;  // fail (empty, or all -INF)
+	}
+	aussie_softmax_online_finish_AVX2(v, n, p);
+#endif //AUSSIE_X86
+}
+
+void aussie_vector_softmax_online_AVX512(float v[], int n)
+{
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
+	return;
+#else
+	aussie_softmax_partial p = aussie_softmax_online_partial_AVX512(v, n);
+	if (p.fsum == 0.0f) {
+		yassert(p.fsum != 0.0f);
+		return;  // fail (empty, or all -INF)
+	}
+	aussie_softmax_online_finish_AVX512(v, n, p);
+#endif //AUSSIE_X86
+}
+
+//---------------------------------------------------
+// Dispatched and parallel softmax (online)
+//---------------------------------------------------
+
+typedef aussie_softmax_partial (*aussie_softmax_partial_fnptr)(const float v[], int n);
+typedef void (*aussie_softmax_finish_fnptr)(float v[], int n, aussie_softmax_partial p);
+
+static void aussie_softmax_online_kernels(aussie_softmax_partial_fnptr& partialfn, aussie_softmax_finish_fnptr& finishfn)
+{
+	aussie_dispatch_ensure();
+	partialfn = aussie_softmax_online_partial;
+	finishfn = aussie_softmax_online_finish;
+#if AUSSIE_X86
+	if (g_aussie_dispatch.isa >= AUSSIE_ISA_AVX512) {
+		partialfn = aussie_softmax_online_partial_AVX512;
+		finishfn = aussie_softmax_online_finish_AVX512;
+	}
+	else if (g_aussie_dispatch.isa >= AUSSIE_ISA_AVX2) {
+		partialfn = aussie_softmax_online_partial_AVX2;
+		finishfn = aussie_softmax_online_finish_AVX2;
+	}
+#endif //AUSSIE_X86
+}
+
+void aussie_vector_softmax_dispatch(float v[], int n)  // Softmax with the fastest SIMD kernels (any n)
+{
+	aussie_softmax_partial_fnptr partialfn = NULL;
+	aussie_softmax_finish_fnptr finishfn = NULL;
+	aussie_softmax_online_kernels(partialfn, finishfn);
+	aussie_softmax_partial p = partialfn(v, n);
+	if (p.fsum == 0.0f) {
+		yassert(p.fsum != 0.0f);
+		return;  // fail (empty, or all -INF)
+	}
+	finishfn(v, n, p);
+}
+
+struct aussie_softmax_parallel_args {
+	float* v;
+	int n;
+	int grain;
+	aussie_softmax_partial* partials;  // One per chunk
+	aussie_softmax_partial ptotal;
+	aussie_softmax_partial_fnptr partialfn;
+	aussie_softmax_finish_fnptr finishfn;
+};
+
+static void aussie_vector_softmax_parallel_read(int itask, void* arg)
+{
+	aussie_softmax_parallel_args* args = (aussie_softmax_parallel_args*)arg;
+	int b = itask * args->grain;
+	int len = args->n - b < args->grain ? args->n - b : args->grain;
+	args->partials[itask] = args->partialfn(&args->v[b], len);
+}
+
+static void aussie_vector_softmax_parallel_write(int begin, int end, void* arg)
+{
+	aussie_softmax_parallel_args* args = (aussie_softmax_parallel_args*)arg;
+	args->finishfn(&args->v[begin], end - begin, args->ptotal);
+}
+
+void aussie_vector_softmax_parallel(float v[], int n)  // Dispatched kernels, chunks split across the thread pool
+{
+	if (n <= 0) {
+		yassert(n > 0);
+		return;  // fail
+	}
+	aussie_softmax_parallel_args args;
+	aussie_softmax_online_kernels(args.partialfn, args.finishfn);
+	args.v = v;
+	args.n = n;
+	args.grain = g_aussie_parallel_grain > 0 ? g_aussie_parallel_grain : AUSSIE_PARALLEL_GRAIN;
+	int nchunks = (n + args.grain - 1) / args.grain;
+	aussie_arena* arena = aussie_thread_arena();  // Scratch partials (no heap calls after warmup)
+	aussie_arena_mark mark;
+	aussie_softmax_partial* partials = NULL;
+	if (arena) {
+		mark = aussie_arena_get_mark(*arena);
+		partials = (aussie_softmax_partial*)aussie_arena_alloc(*arena, nchunks * sizeof(aussie_softmax_partial));
+	}
+	else {
+		partials = new aussie_softmax_partial[nchunks];
+	}
+	args.partials = partials;
+	aussie_parallel_run(nchunks, aussie_vector_softmax_parallel_read, &args, AUSSIE_SCHEDULE_DYNAMIC);
+	args.ptotal = partials[0];
+	for (int i = 1; i < nchunks; i++) args.ptotal = aussie_softmax_partial_merge(args.ptotal, partials[i]);  // In order (deterministic)
+	if (arena) aussie_arena_release(*arena, mark);
+	else delete[] partials;
+	if (args.ptotal.fsum == 0.0f) {
+		yassert(args.ptotal.fsum != 0.0f);
+		return;  // fail (all -INF)
+	}
+	aussie_parallel_for(0, n, args.grain, aussie_vector_softmax_parallel_write, &args);
+}
+
 //---------------------------------------------------
 void aussie_vector_softmax_exponentiate_and_sum(float v[], int n)
 {
@@ -291,9 +475,10 @@ void aussie_vector_softmax_exponentiate_and_sum(float v[], int n)
 void aussie_softmax_unit_tests()
 {
 
+	fprintf(stderr, "INFO: %s: Running unit tests\n", __func__);
 	int n = 16;
-	float v1[1000];
-	float v2[1000];
+	alignas(64) float v1[1000];
+	alignas(64) float v2[1000];
 	float f = 0.0f;
 
 	aussie_vector_set_1_N(v1, n);
@@ -315,17 +500,110 @@ void aussie_softmax_unit_tests()
 	aussie_vector_softmax_exponentiate_first(v2, n);
 	ytestf(aussie_vector_sum(v2, n), 1.0); // Should add up to 1 after softmax
 	
-#if !LINUX
-	aussie_vector_set_1_N(v1, n);
-	aussie_vector_set_1_N(v2, n);
-	aussie_vector_softmax_exponentiate_with_AVX1(v2, n);
-	ytestf(aussie_vector_sum(v2, n), 1.0); // Should add up to 1 after softmax
-	
-	aussie_vector_set_1_N(v1, n);
-	aussie_vector_set_1_N(v2, n);
-	aussie_vector_softmax_exponentiate_with_AVX2(v2, n);
-	ytestf(aussie_vector_sum(v2, n), 1.0); // Should add up to 1 after softmax
-#endif //LINUX
+#if AUSSIE_X86
+	if (aussie_cpu_has_avx()) {
+		aussie_vector_set_1_N(v1, n);
+		aussie_vector_set_1_N(v2, n);
+		aussie_vector_softmax_exponentiate_with_AVX1(v2, n);
+		ytestfapprox(aussie_vector_sum(v2, n), 1.0, 0.00001); // Should add up to 1 after softmax
+
+		aussie_vector_set_1_N(v2, n);
+		aussie_vector_softmax_fused_exp_sum_mult_AVX1(v2, n);
+		ytest(fabsf(aussie_vector_sum(v2, n) - 1.0f) <= 1e-5f);
+	}
+	if (aussie_cpu_has_avx2()) {
+		aussie_vector_set_1_N(v1, n);
+		aussie_vector_set_1_N(v2, n);
+		aussie_vector_softmax_exponentiate_with_AVX2(v2, n);
+		ytestfapprox(aussie_vector_sum(v2, n), 1.0, 0.00001); // Should add up to 1 after softmax
+
+		aussie_vector_set_1_N(v2, n);
+		aussie_vector_softmax_fused_exp_sum_mult_AVX2(v2, n);
+		ytest(fabsf(aussie_vector_sum(v2, n) - 1.0f) <= 1e-5f);
+
+		aussie_vector_set_1_N(v2, n);
+		aussie_vector_softmax_fused_exponentiate_sum_AVX2(v2, n);
+		ytest(fabsf(aussie_vector_sum(v2, n) - 1.0f) <= 1e-5f);
+	}
+	if (aussie_cpu_has_avx512()) {
+		aussie_vector_set_1_N(v2, n);
+		aussie_vector_softmax_fused_exp_sum_mult_AVX512(v2, n);
+		ytest(fabsf(aussie_vector_sum(v2, n) - 1.0f) <= 1e-5f);
+	}
+#endif //AUSSIE_X86
+
+	// Dispatched softmax versus the scalar version (any n, any level)
+	for (int nn = 1; nn <= 100; nn += 7) {
+		for (int i = 0; i < nn; i++) v1[i] = (float)((i * 7) % 23) * 0.5f - 5.0f;
+		aussie_vector_copy_basic(v2, v1, nn);
+		aussie_vector_softmax_basic(v1, nn);
+		aussie_vector_softmax_dispatch(v2, nn);
+		ytest(aussie_vector_equal_approx(v1, v2, nn, 1e-6f));
+	}
+
+	// Online softmax: large logits (no max-subtraction pass), versus a double-precision reference
+	typedef void (*softmax_fnptr)(float v[], int n);
+	softmax_fnptr online_fns[4] = { aussie_vector_softmax_online, NULL, NULL, aussie_vector_softmax_dispatch };
+#if AUSSIE_X86
+	if (aussie_cpu_has_avx2()) online_fns[1] = aussie_vector_softmax_online_AVX2;
+	if (aussie_cpu_has_avx512()) online_fns[2] = aussie_vector_softmax_online_AVX512;
+#endif //AUSSIE_X86
+	for (int k = 0; k < 4; k++) {
+		if (online_fns[k] == NULL) continue;
+		for (int nn = 1; nn <= 70; nn++) {
+			double dmax = -1e30, dsum = 0.0;
+			for (int i = 0; i < nn; i++) {
+				v1[i] = 1000.0f + (float)((i * 37 + nn) % 29) * 0.75f - (i % 3 == 0 ? 50.0f : 0.0f);
+				if (v1[i] > dmax) dmax = v1[i];
+			}
+			for (int i = 0; i < nn; i++) dsum += exp((double)v1[i] - dmax);
+			aussie_vector_copy_basic(v2, v1, nn);
+			online_fns[k](v2, nn);
+			bool ok = true;
+			for (int i = 0; i < nn; i++) {
+				double dref = exp((double)v1[i] - dmax) / dsum;
+				if (fabs(v2[i] - dref) > 1e-6 + 1e-5 * dref) ok = false;
+			}
+			ytest(ok);
+		}
+	}
+
+	// Partials of two halves merge to the partial of the whole (any split point)
+	for (int i = 0; i < 70; i++) v1[i] = (float)((i * 11) % 17) * 3.0f - 20.0f;
+	aussie_softmax_partial pwhole = aussie_softmax_online_partial(v1, 70);
+	for (int split = 0; split <= 70; split += 5) {
+		aussie_softmax_partial p1 = aussie_softmax_online_partial(v1, split);
+		aussie_softmax_partial p2 = aussie_softmax_online_partial(&v1[split], 70 - split);
+		aussie_softmax_partial pm = aussie_softmax_partial_merge(p1, p2);
+		ytest(pm.fmax == pwhole.fmax);
+		ytest(fabsf(pm.fsum - pwhole.fsum) <= 1e-5f * pwhole.fsum);
+	}
+
+	// -INFINITY logits (masked tokens) come out as exactly 0
+	for (int k = 0; k < 4; k++) {
+		if (online_fns[k] == NULL) continue;
+		for (int i = 0; i < 37; i++) v2[i] = (i % 4 == 1) ? -INFINITY : (float)i * 0.1f;
+		online_fns[k](v2, 37);
+		bool ok = true;
+		for (int i = 1; i < 37; i += 4) if (v2[i] != 0.0f) ok = false;
+		ytest(ok);
+		ytest(fabsf(aussie_vector_sum(v2, 37) - 1.0f) <= 1e-5f);
+	}
+
+	// Full vocabulary (128K logits): sums to 1
+	int nvocab = 128 * 1024;
+	float* vbig = (float*)malloc(nvocab * sizeof(float));
+	if (vbig) {
+		for (int k = 0; k < 4; k++) {
+			if (online_fns[k] == NULL) continue;
+			for (int i = 0; i < nvocab; i++) vbig[i] = (float)((i * 7919) % 1000) * 0.02f + 500.0f;
+			online_fns[k](vbig, nvocab);
+			double dsum = 0.0;
+			for (int i = 0; i < nvocab; i++) dsum += vbig[i];
+			ytest(fabs(dsum - 1.0) <= 1e-4);
+		}
+		free(vbig);
+	}
 
 	
 	aussie_vector_set_1_N(v1, n);
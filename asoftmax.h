@@ -35,6 +35,35 @@ void aussie_vector_softmax_fused_exponentiate_sum_AVX2(float v[], int n);
 float aussie_vector_fused_expf_sum_AVX2(float v[], int n);   // Apply EXPF (exponential) to each element and SUM them
 void aussie_vector_softmax_fused_exp_sum_mult_AVX2(float v[], int n);
 
+// Softmax AVX-512
+void aussie_vector_softmax_fused_exp_sum_mult_AVX512(float v[], int n);
+
+// Online softmax: one read pass keeps a running max and a sum rescaled whenever
+// the max grows, then one write pass does expf(v[i] - max) / sum.
+// Safe for any logits (every expf argument is <= 0), unlike the versions above,
+// which overflow to inf/NaN once a logit exceeds about 88.
+struct aussie_softmax_partial {  // Summary of a chunk (mergeable across chunks/threads)
+	float fmax;   // Largest element (AUSSIE_SOFTMAX_NO_MAX if none)
+	float fsum;   // Sum of expf(v[i] - fmax)
+};
+#define AUSSIE_SOFTMAX_NO_MAX (-3.402823466e+38f)  // -FLT_MAX (not -INF, so that max - max is never NaN)
+
+aussie_softmax_partial aussie_softmax_partial_merge(aussie_softmax_partial p1, aussie_softmax_partial p2);
+aussie_softmax_partial aussie_softmax_online_partial(const float v[], int n);  // Read pass
+aussie_softmax_partial aussie_softmax_online_partial_AVX2(const float v[], int n);
+aussie_softmax_partial aussie_softmax_online_partial_AVX512(const float v[], int n);
+void aussie_softmax_online_finish(float v[], int n, aussie_softmax_partial p);  // Write pass
+void aussie_softmax_online_finish_AVX2(float v[], int n, aussie_softmax_partial p);
+void aussie_softmax_online_finish_AVX512(float v[], int n, aussie_softmax_partial p);
+
+void aussie_vector_softmax_online(float v[], int n);
+void aussie_vector_softmax_online_AVX2(float v[], int n);
+void aussie_vector_softmax_online_AVX512(float v[], int n);
+
+// Softmax with runtime dispatch to the best kernels (any n, online so any logits)
+void aussie_vector_softmax_dispatch(float v[], int n);
+void aussie_vector_softmax_parallel(float v[], int n);  // Dispatched kernels, chunks split across the thread pool
+
 
 void aussie_softmax_unit_tests();
 void aussie_benchmark_softmax();
@@ -0,0 +1,509 @@
+// atensor.cpp -- Aligned tensors with strides and zero-copy views -- Aussie AI Base Library
+// Created Oct 17th 2026
+// Copyright (c) 2023 Aussie AI Labs Pty Ltd
+//---------------------------------------------------
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <math.h>
+
+#include "aport.h"
+
+#if LINUX
+#include <sys/mman.h>  // madvise (transparent huge pages)
+#else
+#include <malloc.h>  // _aligned_malloc
+#endif
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+#include "aussieai.h"
+#include "aassert.h"
+#include "atest.h"
+#include "avector.h"
+#include "aarena.h"
+
+#include "atensor.h"  // self-include
+
+//---------------------------------------------------
+// Allocation
+//---------------------------------------------------
+
+static void aussie_tensor_clear(aussie_tensor& t)
+{
+	memset(&t, 0, sizeof(t));
+}
+
+static void aussie_tensor_set_strides(aussie_tensor& t, long long lastdim)
+{
+	// Row-major, with the last dimension possibly padded to lastdim floats
+	long long stride = 1;
+	for (int d = t.ndims - 1; d >= 0; d--) {
+		t.strides[d] = stride;
+		stride *= (d == t.ndims - 1) ? lastdim : t.shape[d];
+	}
+}
+
+static bool aussie_tensor_layout(aussie_tensor& t, int ndims, const int shape[], int flags, size_t& bytes)
+{
+	// Shape and strides, and the bytes of floats needed (before rounding to the alignment)
+	aussie_tensor_clear(t);
+	if (ndims < 1 || ndims > AUSSIE_TENSOR_MAX_DIMS || shape == NULL) {
+		yassert(ndims >= 1 && ndims <= AUSSIE_TENSOR_MAX_DIMS && shape != NULL);
+		return false;  // fail
+	}
+	for (int d = 0; d < ndims; d++) {
+		if (shape[d] < 0) {
+			yassert(shape[d] >= 0);
+			return false;  // fail
+		}
+	}
+	t.ndims = ndims;
+	t.flags = flags;
+	for (int d = 0; d < ndims; d++) t.shape[d] = shape[d];
+	long long lastdim = shape[ndims - 1];
+	const int floats_per_line = AUSSIE_TENSOR_ALIGN / (int)sizeof(float);
+	if (flags & AUSSIE_TENSOR_PAD_ROWS) lastdim = (lastdim + floats_per_line - 1) / floats_per_line * floats_per_line;
+	aussie_tensor_set_strides(t, lastdim);
+
+	long long nfloats = lastdim;
+	for (int d = 0; d < ndims - 1; d++) nfloats *= shape[d];
+	bytes = (size_t)nfloats * sizeof(float);
+	return true;
+}
+
+bool aussie_tensor_alloc(aussie_tensor& t, int ndims, const int shape[], int flags)
+{
+	size_t bytes = 0;
+	if (!aussie_tensor_layout(t, ndims, shape, flags & ~AUSSIE_TENSOR_ARENA, bytes)) return false;  // fail
+	size_t align = (flags & AUSSIE_TENSOR_HUGEPAGES) ? AUSSIE_TENSOR_HUGEPAGE : AUSSIE_TENSOR_ALIGN;
+	bytes = (bytes + align - 1) / align * align;  // Whole lines (or pages), at least one
+	if (bytes == 0) bytes = align;
+	void* block = AUSSIE_ALIGNED_MALLOC(bytes, align);
+	if (block == NULL) {
+		yassert(block != NULL);
+		aussie_tensor_clear(t);
+		return false;  // fail
+	}
+#if LINUX
+	if (flags & AUSSIE_TENSOR_HUGEPAGES) madvise(block, bytes, MADV_HUGEPAGE);  // A hint: still fine without
+#endif //LINUX
+	if (flags & (AUSSIE_TENSOR_ZERO | AUSSIE_TENSOR_PAD_ROWS)) memset(block, 0, bytes);  // Padding is always zero
+	t.block = block;
+	t.bytes = bytes;
+	t.data = (float*)block;
+	return true;
+}
+
+bool aussie_tensor_alloc_2d(aussie_tensor& t, int rows, int cols, int flags)
+{
+	int shape[2] = { rows, cols };
+	return aussie_tensor_alloc(t, 2, shape, flags);
+}
+
+bool aussie_tensor_alloc_3d(aussie_tensor& t, int d0, int d1, int d2, int flags)
+{
+	int shape[3] = { d0, d1, d2 };
+	return aussie_tensor_alloc(t, 3, shape, flags);
+}
+
+bool aussie_tensor_alloc_arena(aussie_arena& arena, aussie_tensor& t, int ndims, const int shape[], int flags)
+{
+	// The block comes from the arena, and goes back with it (aussie_arena_reset or release)
+	size_t bytes = 0;
+	int tflags = (flags & ~AUSSIE_TENSOR_HUGEPAGES) | AUSSIE_TENSOR_ARENA;
+	if (!aussie_tensor_layout(t, ndims, shape, tflags, bytes)) return false;  // fail
+	bytes = (bytes + AUSSIE_TENSOR_ALIGN - 1) / AUSSIE_TENSOR_ALIGN * AUSSIE_TENSOR_ALIGN;
+	void* block = aussie_arena_alloc(arena, bytes, AUSSIE_TENSOR_ALIGN);
+	if (block == NULL) {
+		yassert(block != NULL);
+		aussie_tensor_clear(t);
+		return false;  // fail
+	}
+	if (tflags & (AUSSIE_TENSOR_ZERO | AUSSIE_TENSOR_PAD_ROWS)) memset(block, 0, bytes);
+	t.block = block;
+	t.bytes = bytes;
+	t.data = (float*)block;
+	return true;
+}
+
+void aussie_tensor_free(aussie_tensor& t)  // Owners only (a view is left alone)
+{
+	if (t.block == NULL) return;  // A view, or already freed
+	if ((t.flags & AUSSIE_TENSOR_ARENA) == 0) AUSSIE_ALIGNED_FREE(t.block);  // Arena memory goes back with the arena
+	aussie_tensor_clear(t);
+}
+
+//---------------------------------------------------
+// Queries
+//---------------------------------------------------
+
+long long aussie_tensor_numel(const aussie_tensor& t)
+{
+	if (t.ndims == 0) return 0;
+	long long n = 1;
+	for (int d = 0; d < t.ndims; d++) n *= t.shape[d];
+	return n;
+}
+
+bool aussie_tensor_is_contiguous(const aussie_tensor& t)  // Row-major with no gaps
+{
+	long long stride = 1;
+	for (int d = t.ndims - 1; d >= 0; d--) {
+		if (t.shape[d] != 1 && t.strides[d] != stride) return false;  // Size-1 dimensions can have any stride
+		stride *= t.shape[d];
+	}
+	return t.ndims > 0;
+}
+
+bool aussie_tensor_is_view(const aussie_tensor& t)
+{
+	return t.block == NULL && t.data != NULL;
+}
+
+float* aussie_tensor_ptr(const aussie_tensor& t, const int index[])  // One index per dimension
+{
+	long long offset = 0;
+	for (int d = 0; d < t.ndims; d++) {
+		if (index[d] < 0 || index[d] >= t.shape[d]) {
+			yassert(index[d] >= 0 && index[d] < t.shape[d]);
+			return NULL;  // fail
+		}
+		offset += (long long)index[d] * t.strides[d];
+	}
+	return t.data + offset;
+}
+
+float* aussie_tensor_row_ptr(const aussie_tensor& t, int row)  // 2-D: start of a row
+{
+	if (t.ndims != 2 || row < 0 || row >= t.shape[0]) {
+		yassert(t.ndims == 2 && row >= 0 && row < t.shape[0]);
+		return NULL;  // fail
+	}
+	return t.data + (long long)row * t.strides[0];
+}
+
+//---------------------------------------------------
+// Views
+//---------------------------------------------------
+
+static bool aussie_tensor_view_init(const aussie_tensor& t, aussie_tensor& view)
+{
+	// A non-owning copy of the descriptor (t may be view itself)
+	aussie_tensor tmp = t;
+	tmp.block = NULL;
+	tmp.bytes = 0;
+	view = tmp;
+	return t.data != NULL;
+}
+
+bool aussie_tensor_slice(const aussie_tensor& t, int dim, int start, int len, aussie_tensor& view)  // [start,start+len) of one dimension
+{
+	if (dim < 0 || dim >= t.ndims || start < 0 || len < 0 || start + len > t.shape[dim]) {
+		yassert(dim >= 0 && dim < t.ndims);
+		yassert(start >= 0 && len >= 0 && start + len <= t.shape[dim]);
+		aussie_tensor_clear(view);
+		return false;  // fail
+	}
+	aussie_tensor_view_init(t, view);
+	view.data = t.data + (long long)start * t.strides[dim];
+	view.shape[dim] = len;
+	return true;
+}
+
+bool aussie_tensor_select(const aussie_tensor& t, int dim, int index, aussie_tensor& view)  // Drop a dimension (one fewer)
+{
+	if (t.ndims < 2 || dim < 0 || dim >= t.ndims || index < 0 || index >= t.shape[dim]) {
+		yassert(t.ndims >= 2 && dim >= 0 && dim < t.ndims);
+		yassert(index >= 0 && index < t.shape[dim]);
+		aussie_tensor_clear(view);
+		return false;  // fail
+	}
+	aussie_tensor src = t;  // view may be t
+	aussie_tensor_view_init(src, view);
+	view.data = src.data + (long long)index * src.strides[dim];
+	view.ndims = src.ndims - 1;
+	for (int d = dim; d < view.ndims; d++) {
+		view.shape[d] = src.shape[d + 1];
+		view.strides[d] = src.strides[d + 1];
+	}
+	view.shape[view.ndims] = 0;
+	view.strides[view.ndims] = 0;
+	return true;
+}
+
+bool aussie_tensor_row(const aussie_tensor& t, int row, aussie_tensor& view)  // 2-D: row vector (stride 1)
+{
+	yassert(t.ndims == 2);
+	return aussie_tensor_select(t, 0, row, view);
+}
+
+bool aussie_tensor_column(const aussie_tensor& t, int col, aussie_tensor& view)  // 2-D: column vector (strided)
+{
+	yassert(t.ndims == 2);
+	return aussie_tensor_select(t, 1, col, view);
+}
+
+bool aussie_tensor_transpose(const aussie_tensor& t, int dim1, int dim2, aussie_tensor& view)  // Swap two dimensions
+{
+	if (dim1 < 0 || dim1 >= t.ndims || dim2 < 0 || dim2 >= t.ndims) {
+		yassert(dim1 >= 0 && dim1 < t.ndims && dim2 >= 0 && dim2 < t.ndims);
+		aussie_tensor_clear(view);
+		return false;  // fail
+	}
+	aussie_tensor_view_init(t, view);
+	int s = view.shape[dim1];
+	view.shape[dim1] = view.shape[dim2];
+	view.shape[dim2] = s;
+	long long st = view.strides[dim1];
+	view.strides[dim1] = view.strides[dim2];
+	view.strides[dim2] = st;
+	return true;
+}
+
+bool aussie_tensor_reshape(const aussie_tensor& t, int ndims, const int shape[], aussie_tensor& view)  // Contiguous tensors only
+{
+	if (ndims < 1 || ndims > AUSSIE_TENSOR_MAX_DIMS || shape == NULL) {
+		yassert(ndims >= 1 && ndims <= AUSSIE_TENSOR_MAX_DIMS && shape != NULL);
+		aussie_tensor_clear(view);
+		return false;  // fail
+	}
+	long long n = 1;
+	for (int d = 0; d < ndims; d++) n *= shape[d];
+	if (n != aussie_tensor_numel(t) || !aussie_tensor_is_contiguous(t)) {  // Not an error: copy it first
+		aussie_tensor_clear(view);
+		return false;
+	}
+	aussie_tensor src = t;
+	aussie_tensor_view_init(src, view);
+	view.ndims = ndims;
+	for (int d = 0; d < AUSSIE_TENSOR_MAX_DIMS; d++) view.shape[d] = d < ndims ? shape[d] : 0;
+	aussie_tensor_set_strides(view, shape[ndims - 1]);
+	for (int d = ndims; d < AUSSIE_TENSOR_MAX_DIMS; d++) view.strides[d] = 0;
+	return true;
+}
+
+bool aussie_tensor_split_heads(const aussie_tensor& t, int nheads, aussie_tensor& view)  // [seq, nheads*hd] -> [nheads, seq, hd]
+{
+	if (t.ndims != 2 || nheads <= 0 || t.shape[1] % nheads != 0 || t.strides[1] != 1) {
+		yassert(t.ndims == 2 && nheads > 0 && t.shape[1] % nheads == 0 && t.strides[1] == 1);
+		aussie_tensor_clear(view);
+		return false;  // fail
+	}
+	// Head h of row i starts at row i + h*hd: just strides, so padded rows are fine too
+	int seq = t.shape[0], hd = t.shape[1] / nheads;
+	long long rowstride = t.strides[0];
+	aussie_tensor_view_init(t, view);
+	view.ndims = 3;
+	view.shape[0] = nheads;  view.strides[0] = hd;
+	view.shape[1] = seq;     view.strides[1] = rowstride;
+	view.shape[2] = hd;      view.strides[2] = 1;
+	view.shape[3] = 0;       view.strides[3] = 0;
+	return true;
+}
+
+bool aussie_tensor_head(const aussie_tensor& t, int nheads, int h, aussie_tensor& view)  // [seq, nheads*hd] -> head h: [seq, hd]
+{
+	if (t.ndims != 2 || nheads <= 0 || t.shape[1] % nheads != 0 || h < 0 || h >= nheads) {
+		yassert(t.ndims == 2 && nheads > 0 && t.shape[1] % nheads == 0);
+		yassert(h >= 0 && h < nheads);
+		aussie_tensor_clear(view);
+		return false;  // fail
+	}
+	int hd = t.shape[1] / nheads;
+	return aussie_tensor_slice(t, 1, h * hd, hd, view);
+}
+
+//---------------------------------------------------
+// Copying
+//---------------------------------------------------
+
+bool aussie_tensor_copy(aussie_tensor& dst, const aussie_tensor& src)  // Same shape, any strides (e.g. make a view contiguous)
+{
+	if (dst.ndims != src.ndims || dst.data == NULL || src.data == NULL) {
+		yassert(dst.ndims == src.ndims && dst.data != NULL && src.data != NULL);
+		return false;  // fail
+	}
+	for (int d = 0; d < src.ndims; d++) {
+		if (dst.shape[d] != src.shape[d]) {
+			yassert(dst.shape[d] == src.shape[d]);
+			return false;  // fail
+		}
+	}
+	if (aussie_tensor_numel(src) == 0) return true;
+	// Rows of the last dimension: memcpy when both have stride 1, else element by element
+	int last = src.ndims - 1;
+	int n = src.shape[last];
+	long long nrows = aussie_tensor_numel(src) / n;
+	int index[AUSSIE_TENSOR_MAX_DIMS] = { 0, 0, 0, 0 };
+	for (long long r = 0; r < nrows; r++) {
+		long long soff = 0, doff = 0;
+		for (int d = 0; d < last; d++) {
+			soff += (long long)index[d] * src.strides[d];
+			doff += (long long)index[d] * dst.strides[d];
+		}
+		const float* s = src.data + soff;
+		float* p = dst.data + doff;
+		if (src.strides[last] == 1 && dst.strides[last] == 1) {
+			memmove(p, s, n * sizeof(float));
+		}
+		else {
+			for (int j = 0; j < n; j++) p[j * dst.strides[last]] = s[j * src.strides[last]];
+		}
+		for (int d = last - 1; d >= 0; d--) {  // Next row (odometer)
+			if (++index[d] < src.shape[d]) break;
+			index[d] = 0;
+		}
+	}
+	return true;
+}
+
+//---------------------------------------------------
+// Unit tests
+//---------------------------------------------------
+
+static void aussie_tensor_test_fill(aussie_tensor& t)  // t[i][j] = 100*i + j (2-D)
+{
+	for (int i = 0; i < t.shape[0]; i++) {
+		for (int j = 0; j < t.shape[1]; j++) AUSSIE_TENSOR_AT2(t, i, j) = (float)(100 * i + j);
+	}
+}
+
+static void aussie_tensor_test_2d(int flags)
+{
+	int rows = 5, cols = 12;
+	aussie_tensor t;
+	if (!aussie_tensor_alloc_2d(t, rows, cols, flags)) {
+		ytest(false);
+		return;  // fail
+	}
+	aussie_tensor_test_fill(t);
+	ytest(((size_t)t.data % AUSSIE_TENSOR_ALIGN) == 0);
+	ytest(!aussie_tensor_is_view(t));
+	ytest(aussie_tensor_numel(t) == rows * cols);
+	bool padded = (flags & AUSSIE_TENSOR_PAD_ROWS) != 0;
+	ytest(aussie_tensor_is_contiguous(t) == !padded);
+	if (padded) {
+		ytest(t.strides[0] == 16);
+		ytest(((size_t)aussie_tensor_row_ptr(t, 3) % AUSSIE_TENSOR_ALIGN) == 0);  // Every row aligned
+		ytestf(t.data[cols], 0.0f);  // Padding is zero
+	}
+	if (flags & AUSSIE_TENSOR_HUGEPAGES) ytest(((size_t)t.data % AUSSIE_TENSOR_HUGEPAGE) == 0);
+
+	// Row view: a plain vector for the kernels
+	aussie_tensor v;
+	ytest(aussie_tensor_row(t, 2, v));
+	ytest(aussie_tensor_is_view(v) && v.ndims == 1 && v.shape[0] == cols && v.strides[0] == 1);
+	ytestf(aussie_vector_sum(v.data, v.shape[0]), (float)(200 * cols + cols * (cols - 1) / 2));
+	ytest(aussie_tensor_row_ptr(t, 2) == v.data);
+
+	// Column view: strided
+	ytest(aussie_tensor_column(t, 3, v));
+	ytest(v.ndims == 1 && v.shape[0] == rows && v.strides[0] == t.strides[0]);
+	ytestf(v.data[4 * v.strides[0]], 403.0f);
+	ytest(!aussie_tensor_is_contiguous(v));
+
+	// Slices of rows and columns
+	aussie_tensor s;
+	ytest(aussie_tensor_slice(t, 0, 1, 3, s));
+	ytest(s.shape[0] == 3 && s.shape[1] == cols);
+	ytestf(AUSSIE_TENSOR_AT2(s, 0, 5), 105.0f);
+	ytest(aussie_tensor_is_contiguous(s) == !padded);
+	ytest(aussie_tensor_slice(s, 1, 4, 2, s));  // A view of a view (in place)
+	ytest(s.shape[0] == 3 && s.shape[1] == 2);
+	ytestf(AUSSIE_TENSOR_AT2(s, 2, 1), 305.0f);
+	AUSSIE_TENSOR_AT2(s, 2, 1) = -1.0f;  // Writes go to the owner
+	ytestf(AUSSIE_TENSOR_AT2(t, 3, 5), -1.0f);
+	AUSSIE_TENSOR_AT2(t, 3, 5) = 305.0f;
+
+	// Transpose, then copy to contiguous
+	aussie_tensor tt, c;
+	ytest(aussie_tensor_transpose(t, 0, 1, tt));
+	ytest(tt.shape[0] == cols && tt.shape[1] == rows);
+	ytestf(AUSSIE_TENSOR_AT2(tt, 7, 4), 407.0f);
+	ytest(!aussie_tensor_is_contiguous(tt));
+	ytest(aussie_tensor_alloc_2d(c, cols, rows, 0));
+	ytest(aussie_tensor_copy(c, tt));
+	ytest(aussie_tensor_is_contiguous(c));
+	ytestf(c.data[7 * rows + 4], 407.0f);
+
+	// Reshape: only contiguous tensors (no copy)
+	int shape3[3] = { rows, 3, 4 };
+	aussie_tensor r;
+	ytest(aussie_tensor_reshape(t, 3, shape3, r) == !padded);
+	if (!padded) {
+		ytestf(AUSSIE_TENSOR_AT3(r, 2, 1, 3), 207.0f);
+		ytest(r.data == t.data);
+	}
+	ytest(!aussie_tensor_reshape(tt, 3, shape3, r));  // Transposed: copy first
+	int shapebad[2] = { 7, 7 };
+	ytest(!aussie_tensor_reshape(c, 2, shapebad, r));  // Wrong size
+
+	// Attention heads: [seq, nheads*hd] -> [nheads, seq, hd]
+	aussie_tensor heads, h1;
+	ytest(aussie_tensor_split_heads(t, 3, heads));
+	ytest(heads.ndims == 3 && heads.shape[0] == 3 && heads.shape[1] == rows && heads.shape[2] == 4);
+	ytestf(AUSSIE_TENSOR_AT3(heads, 2, 1, 3), 111.0f);  // Head 2 starts at column 8
+	ytest(aussie_tensor_head(t, 3, 2, h1));
+	ytest(h1.shape[0] == rows && h1.shape[1] == 4);
+	ytestf(AUSSIE_TENSOR_AT2(h1, 1, 3), 111.0f);
+	aussie_tensor h2;
+	ytest(aussie_tensor_select(heads, 0, 2, h2));
+	ytest(h2.data == h1.data && h2.strides[0] == h1.strides[0]);
+
+	aussie_tensor_free(v);  // Views: nothing happens
+	ytest(v.data != NULL);
+	aussie_tensor_free(c);
+	aussie_tensor_free(t);
+	ytest(t.data == NULL && t.block == NULL);
+}
+
+void aussie_tensor_unit_tests()
+{
+	fprintf(stderr, "INFO: %s: Running unit tests\n", __func__);
+	aussie_tensor_test_2d(0);
+	aussie_tensor_test_2d(AUSSIE_TENSOR_ZERO);
+	aussie_tensor_test_2d(AUSSIE_TENSOR_PAD_ROWS);
+	aussie_tensor_test_2d(AUSSIE_TENSOR_HUGEPAGES);
+
+	// Zeroed, 3-D, 4-D
+	aussie_tensor t;
+	ytest(aussie_tensor_alloc_3d(t, 2, 3, 5, AUSSIE_TENSOR_ZERO));
+	ytest(t.strides[0] == 15 && t.strides[1] == 5 && t.strides[2] == 1);
+	ytestf(aussie_vector_sum(t.data, (int)aussie_tensor_numel(t)), 0.0f);
+	int index[3] = { 1, 2, 4 };
+	ytest(aussie_tensor_ptr(t, index) == t.data + 29);
+	aussie_tensor_free(t);
+	int shape4[4] = { 2, 2, 2, 2 };
+	ytest(aussie_tensor_alloc(t, 4, shape4, 0));
+	ytest(aussie_tensor_is_contiguous(t) && aussie_tensor_numel(t) == 16);
+	aussie_tensor_free(t);
+
+	// Empty tensors
+	ytest(aussie_tensor_alloc_2d(t, 0, 8, 0));
+	ytest(aussie_tensor_numel(t) == 0 && t.data != NULL);
+	aussie_tensor_free(t);
+
+	// Arena tensors: aligned, not views, returned with the arena
+	aussie_arena arena;
+	ytest(aussie_arena_init(arena, 4096, "tensor test"));
+	int shape2[2] = { 3, 5 };
+	ytest(aussie_tensor_alloc_arena(arena, t, 2, shape2, AUSSIE_TENSOR_PAD_ROWS));
+	ytest(((size_t)aussie_tensor_row_ptr(t, 2) % AUSSIE_TENSOR_ALIGN) == 0);
+	ytest(!aussie_tensor_is_view(t) && (t.flags & AUSSIE_TENSOR_ARENA) != 0);
+	ytestf(AUSSIE_TENSOR_AT2(t, 2, 4), 0.0f);
+	ytest(arena.used == 3 * 16 * sizeof(float));
+	aussie_tensor_free(t);  // Nothing to free
+	ytest(t.data == NULL);
+	aussie_arena_destroy(arena);
+}
+
+//---------------------------------------------------
+//---------------------------------------------------
@@ -0,0 +1,81 @@
+//---------------------------------------------------
+// atensor.h -- Aligned tensors with strides and zero-copy views -- Aussie AI Base Library
+// Created Oct 17th 2026
+// Copyright (c) 2023 Aussie AI Labs Pty Ltd
+//---------------------------------------------------
+
+#ifndef AUSSIE_YTENSOR_INCLUDE_HEADER_H
+#define AUSSIE_YTENSOR_INCLUDE_HEADER_H
+
+//---------------------------------------------------
+// Tensor: up to 4 dimensions of floats in one allocated block (64-byte aligned, or huge pages),
+// with the shape and strides (in floats) alongside.
+// ... unlike adynarray.h (one calloc per row, or float** indexes), rows are evenly strided in one block,
+//     so a tensor can be sliced, transposed or reshaped without copying
+// ... views share the owner's block (never free a view; the owner must outlive its views)
+// ... the last dimension has stride 1 unless transposed, so each row (aussie_tensor_row_ptr)
+//     works with the "float v[], int n" kernels, and a contiguous tensor's data pointer
+//     works with them for all aussie_tensor_numel() floats
+//---------------------------------------------------
+
+#define AUSSIE_TENSOR_MAX_DIMS  4
+#define AUSSIE_TENSOR_ALIGN     64          // Bytes (one cache line, one AVX-512 register)
+#define AUSSIE_TENSOR_HUGEPAGE  (2u << 20)  // Bytes (x86 2MB pages)
+
+#define AUSSIE_TENSOR_ZERO       1   // Zero the floats
+#define AUSSIE_TENSOR_PAD_ROWS   2   // Pad the last dimension to 16 floats, so every row is aligned (not contiguous)
+#define AUSSIE_TENSOR_HUGEPAGES  4   // 2MB-aligned block with transparent huge pages (Linux madvise), for big weights
+#define AUSSIE_TENSOR_ARENA      8   // Block from an arena (set by aussie_tensor_alloc_arena, not freed by aussie_tensor_free)
+
+struct aussie_arena;  // aarena.h
+
+struct aussie_tensor {
+	int ndims;
+	int shape[AUSSIE_TENSOR_MAX_DIMS];
+	long long strides[AUSSIE_TENSOR_MAX_DIMS];  // Floats between neighbours in each dimension
+	float* data;    // Element [0,0,...] (views point into their owner's block)
+	void* block;    // The allocation (NULL in views)
+	size_t bytes;   // Size of the block
+	int flags;      // AUSSIE_TENSOR_* used to allocate it
+};
+
+bool aussie_tensor_alloc(aussie_tensor& t, int ndims, const int shape[], int flags);
+bool aussie_tensor_alloc_2d(aussie_tensor& t, int rows, int cols, int flags);
+bool aussie_tensor_alloc_3d(aussie_tensor& t, int d0, int d1, int d2, int flags);
+bool aussie_tensor_alloc_arena(aussie_arena& arena, aussie_tensor& t, int ndims, const int shape[], int flags);  // Block from the arena
+void aussie_tensor_free(aussie_tensor& t);  // Owners only (a view is left alone)
+
+long long aussie_tensor_numel(const aussie_tensor& t);
+bool aussie_tensor_is_contiguous(const aussie_tensor& t);  // Row-major with no gaps
+bool aussie_tensor_is_view(const aussie_tensor& t);
+float* aussie_tensor_ptr(const aussie_tensor& t, const int index[]);  // One index per dimension
+float* aussie_tensor_row_ptr(const aussie_tensor& t, int row);  // 2-D: start of a row
+
+#define AUSSIE_TENSOR_AT2(t, i, j)     ((t).data[(long long)(i) * (t).strides[0] + (long long)(j) * (t).strides[1]])
+#define AUSSIE_TENSOR_AT3(t, i, j, k)  ((t).data[(long long)(i) * (t).strides[0] + (long long)(j) * (t).strides[1] + (long long)(k) * (t).strides[2]])
+
+//---------------------------------------------------
+// Views (no copying): false (and an empty view) if the arguments don't fit
+//---------------------------------------------------
+
+bool aussie_tensor_slice(const aussie_tensor& t, int dim, int start, int len, aussie_tensor& view);  // [start,start+len) of one dimension
+bool aussie_tensor_select(const aussie_tensor& t, int dim, int index, aussie_tensor& view);  // Drop a dimension (one fewer)
+bool aussie_tensor_row(const aussie_tensor& t, int row, aussie_tensor& view);  // 2-D: row vector (stride 1)
+bool aussie_tensor_column(const aussie_tensor& t, int col, aussie_tensor& view);  // 2-D: column vector (strided)
+bool aussie_tensor_transpose(const aussie_tensor& t, int dim1, int dim2, aussie_tensor& view);  // Swap two dimensions
+bool aussie_tensor_reshape(const aussie_tensor& t, int ndims, const int shape[], aussie_tensor& view);  // Contiguous tensors only
+bool aussie_tensor_split_heads(const aussie_tensor& t, int nheads, aussie_tensor& view);  // [seq, nheads*hd] -> [nheads, seq, hd]
+bool aussie_tensor_head(const aussie_tensor& t, int nheads, int h, aussie_tensor& view);  // [seq, nheads*hd] -> head h: [seq, hd]
+
+bool aussie_tensor_copy(aussie_tensor& dst, const aussie_tensor& src);  // Same shape, any strides (e.g. make a view contiguous)
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+void aussie_tensor_unit_tests();
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+
+#endif //AUSSIE_YTENSOR_INCLUDE_HEADER_H
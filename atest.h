@@ -14,6 +14,8 @@ bool aussie_ytest_failui(char* condstr, unsigned int ival, unsigned int iexpect,
 #define ytesti(ival, iexpect) ( (((int)ival) == ((int)iexpect)) || aussie_ytest_faili(#ival "==" #iexpect, ival, iexpect, __FILE__, __LINE__) )
 #define ytestf(fval, fexpect) ( ((fval) == (fexpect)) || aussie_ytest_failf(#fval "==" #fexpect, fval, fexpect, __FILE__, __LINE__) )
 #define ytestfapprox(fval, fexpect, err) ( fabs(( (fval) - (fexpect)) < err) || aussie_ytest_failf(#fval "==" #fexpect, fval, fexpect, __FILE__, __LINE__) )
+#define AUSSIE_TEST_VALUE(i, j, seed)  ( (float)((((i) * 7 + (j) * 13 + (seed) * 5) % 17) - 8) / 8.0f )  // Deterministic test data in [-1,1] (exact in float)
+
 #define ytestui(uival, uiexpect) ( ((unsigned)(uival) == (unsigned)(uiexpect)) || aussie_ytest_failui(#uival "==" #uiexpect, (unsigned)uival, (unsigned)uiexpect, __FILE__, __LINE__) )
 
 void aussie_unit_tests_report();
@@ -0,0 +1,553 @@
+// athread.cpp -- Work-stealing thread pool for parallel kernels -- Aussie AI Base Library
+// Created Oct 17th 2026
+// Copyright (c) 2023 Aussie AI Labs Pty Ltd
+//---------------------------------------------------
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <math.h>
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+#include "aport.h"
+
+#if LINUX
+#include <pthread.h>  // pthread_setaffinity_np
+#include <sched.h>
+#else
+#include <windows.h>  // SetThreadAffinityMask
+#endif
+
+#include "aussieai.h"
+#include "aassert.h"
+#include "atest.h"
+
+#include "athread.h"  // self-include
+
+//---------------------------------------------------
+// Pool state
+//---------------------------------------------------
+
+struct aussie_task_group {  // The tasks of one aussie_parallel_run call
+	std::atomic<int> remaining;
+};
+
+struct aussie_task {
+	aussie_task_fnptr fn;
+	void* arg;
+	int itask;
+	bool pinned;  // AUSSIE_SCHEDULE_STATIC: only the owner thread may run it
+	aussie_task_group* group;
+};
+
+struct aussie_task_deque {
+	std::mutex mtx;
+	std::deque<aussie_task> tasks;  // Owner pops the back, thieves take the front
+	std::atomic<int> npinned;  // Pinned tasks waiting here (wakes the owner)
+};
+
+struct aussie_thread_pool {
+	int nthreads;
+	std::vector<std::thread> workers;  // Threads 1..n-1 (slot 0 is for callers outside the pool)
+	aussie_task_deque* deques;   // One per slot
+	std::atomic<int> nstealable;  // Unpinned tasks waiting in any deque
+	std::atomic<bool> stopping;
+	std::mutex sleep_mtx;
+	std::condition_variable cv_work;   // Idle workers sleep here
+};
+
+int g_aussie_parallel_grain = AUSSIE_PARALLEL_GRAIN;   // Chunk size used by the parallel vector kernels (tunable)
+
+static std::atomic<aussie_thread_pool*> s_aussie_pool(NULL);  // Published with release, read with acquire
+static std::mutex s_aussie_pool_mutex;   // Guards creation/shutdown
+static thread_local int s_aussie_thread_slot = 0;  // Deque of this thread (0 = not a pool worker)
+
+static void aussie_thread_wake_all(aussie_thread_pool* pool)
+{
+	{ std::lock_guard<std::mutex> lock(pool->sleep_mtx); }  // No lost wake-up between check and wait
+	pool->cv_work.notify_all();
+}
+
+static void aussie_thread_push(aussie_thread_pool* pool, int slot, const aussie_task& task)
+{
+	aussie_task_deque& dq = pool->deques[slot];
+	std::lock_guard<std::mutex> lock(dq.mtx);
+	dq.tasks.push_back(task);
+	if (task.pinned) dq.npinned++;
+	else pool->nstealable++;
+}
+
+static bool aussie_thread_pop_own(aussie_thread_pool* pool, int slot, aussie_task& task)
+{
+	aussie_task_deque& dq = pool->deques[slot];
+	std::lock_guard<std::mutex> lock(dq.mtx);
+	if (dq.tasks.empty()) return false;
+	task = dq.tasks.back();
+	dq.tasks.pop_back();
+	if (task.pinned) dq.npinned--;
+	else pool->nstealable--;
+	return true;
+}
+
+static bool aussie_thread_steal(aussie_thread_pool* pool, int thief, aussie_task& task)
+{
+	if (pool->nstealable.load() == 0) return false;
+	for (int k = 1; k < pool->nthreads; k++) {
+		aussie_task_deque& dq = pool->deques[(thief + k) % pool->nthreads];
+		std::lock_guard<std::mutex> lock(dq.mtx);
+		for (std::deque<aussie_task>::iterator it = dq.tasks.begin(); it != dq.tasks.end(); ++it) {
+			if (it->pinned) continue;  // Belongs to that thread
+			task = *it;
+			dq.tasks.erase(it);
+			pool->nstealable--;
+			return true;
+		}
+	}
+	return false;
+}
+
+static bool aussie_thread_run_one(aussie_thread_pool* pool, int slot)
+{
+	// Run one queued task (own first, else steal): false if there was nothing to run
+	aussie_task task;
+	if (!aussie_thread_pop_own(pool, slot, task) && !aussie_thread_steal(pool, slot, task)) return false;
+	task.fn(task.itask, task.arg);
+	task.group->remaining.fetch_sub(1, std::memory_order_release);
+	return true;
+}
+
+static void aussie_thread_worker_main(aussie_thread_pool* pool, int slot)
+{
+	s_aussie_thread_slot = slot;
+	aussie_task_deque& mine = pool->deques[slot];
+	for (;;) {
+		if (aussie_thread_run_one(pool, slot)) continue;
+		std::unique_lock<std::mutex> lock(pool->sleep_mtx);
+		pool->cv_work.wait(lock, [&] {
+			return pool->stopping.load() || pool->nstealable.load() > 0 || mine.npinned.load() > 0;
+		});
+		if (pool->stopping.load()) return;
+	}
+}
+
+//---------------------------------------------------
+// Pool creation
+//---------------------------------------------------
+
+#define AUSSIE_THREAD_MAX_CPUS  1024
+
+static int aussie_thread_allowed_cpus(int cpus[], int maxcpus)  // CPUs this process may run on (taskset, cgroup cpuset)
+{
+	int n = 0;
+#if LINUX
+	cpu_set_t cpuset;
+	CPU_ZERO(&cpuset);
+	if (sched_getaffinity(0, sizeof(cpuset), &cpuset) == 0) {
+		for (int c = 0; c < CPU_SETSIZE && n < maxcpus; c++) {
+			if (CPU_ISSET(c, &cpuset)) cpus[n++] = c;
+		}
+	}
+#else
+	DWORD_PTR procmask = 0, sysmask = 0;
+	if (GetProcessAffinityMask(GetCurrentProcess(), &procmask, &sysmask)) {
+		for (int c = 0; c < (int)(8 * sizeof(DWORD_PTR)) && n < maxcpus; c++) {
+			if (procmask & (((DWORD_PTR)1) << c)) cpus[n++] = c;
+		}
+	}
+#endif
+	return n;  // 0 if unknown
+}
+
+static int aussie_thread_current_cpu()  // Where the calling thread is running now (-1 if unknown)
+{
+#if LINUX
+	return sched_getcpu();
+#else
+	return (int)GetCurrentProcessorNumber();
+#endif
+}
+
+static int aussie_thread_default_count()
+{
+	const char* envstr = getenv("AUSSIE_THREADS");  // Manual override
+	if (envstr != NULL && atoi(envstr) > 0) return atoi(envstr);
+	static int cpus[AUSSIE_THREAD_MAX_CPUS];
+	int ncores = aussie_thread_allowed_cpus(cpus, AUSSIE_THREAD_MAX_CPUS);
+	if (ncores <= 0) ncores = (int)std::thread::hardware_concurrency();
+	return ncores > 0 ? ncores : 1;
+}
+
+static void aussie_thread_pin_to_core(std::thread& thr, int core)
+{
+#if LINUX
+	cpu_set_t cpuset;
+	CPU_ZERO(&cpuset);
+	CPU_SET(core, &cpuset);
+	if (pthread_setaffinity_np(thr.native_handle(), sizeof(cpuset), &cpuset) != 0) {
+		fprintf(stderr, "WARNING: %s: Could not pin thread to core %d\n", __func__, core);
+	}
+#else
+	if (SetThreadAffinityMask((HANDLE)thr.native_handle(), ((DWORD_PTR)1) << core) == 0) {
+		fprintf(stderr, "WARNING: %s: Could not pin thread to core %d\n", __func__, core);
+	}
+#endif
+}
+
+void aussie_thread_pool_init(int nthreads)  // Start the pool (0 = AUSSIE_THREADS or number of cores)
+{
+	std::lock_guard<std::mutex> guard(s_aussie_pool_mutex);
+	if (s_aussie_pool.load(std::memory_order_relaxed) != NULL) return;  // Already running (shutdown first to resize)
+	if (nthreads <= 0) nthreads = aussie_thread_default_count();
+
+	aussie_thread_pool* pool = new aussie_thread_pool;
+	pool->nthreads = nthreads;
+	pool->deques = new aussie_task_deque[nthreads];
+	for (int i = 0; i < nthreads; i++) pool->deques[i].npinned = 0;
+	pool->nstealable = 0;
+	pool->stopping = false;
+	for (int i = 1; i < nthreads; i++) {
+		pool->workers.push_back(std::thread(aussie_thread_worker_main, pool, i));
+	}
+
+	// Pin the workers to the allowed CPUs, one each, skipping the CPU the caller is on
+	// (thread 0 is the caller's own thread: leave it alone)
+	const char* pinstr = getenv("AUSSIE_PIN_THREADS");
+	if (pinstr == NULL || atoi(pinstr) != 0) {
+		static int cpus[AUSSIE_THREAD_MAX_CPUS];  // Under s_aussie_pool_mutex
+		int ncpus = aussie_thread_allowed_cpus(cpus, AUSSIE_THREAD_MAX_CPUS);
+		int callercpu = aussie_thread_current_cpu();
+		int nfree = 0;
+		for (int k = 0; k < ncpus; k++) {
+			if (cpus[k] != callercpu) cpus[nfree++] = cpus[k];
+		}
+		if (nthreads - 1 <= nfree) {  // Otherwise workers would share CPUs: let the OS schedule them
+			for (int i = 1; i < nthreads; i++) aussie_thread_pin_to_core(pool->workers[i - 1], cpus[i - 1]);
+		}
+	}
+	s_aussie_pool.store(pool, std::memory_order_release);  // Fully built before anyone sees it
+
+	static bool s_registered = false;
+	if (!s_registered) {
+		s_registered = true;
+		atexit(aussie_thread_pool_shutdown);  // Join the threads before static destructors run
+	}
+}
+
+void aussie_thread_pool_shutdown()  // Join all the worker threads (only when no jobs are running)
+{
+	std::lock_guard<std::mutex> guard(s_aussie_pool_mutex);
+	aussie_thread_pool* pool = s_aussie_pool.load(std::memory_order_relaxed);
+	if (pool == NULL) return;
+	pool->stopping = true;
+	aussie_thread_wake_all(pool);
+	for (size_t i = 0; i < pool->workers.size(); i++) {
+		pool->workers[i].join();
+	}
+	s_aussie_pool.store(NULL, std::memory_order_release);
+	delete[] pool->deques;
+	delete pool;
+}
+
+static aussie_thread_pool* aussie_thread_pool_get()
+{
+	aussie_thread_pool* pool = s_aussie_pool.load(std::memory_order_acquire);
+	if (pool != NULL) return pool;  // Fast path: no lock
+	aussie_thread_pool_init(0);  // Locks and re-checks, so racing callers create one pool
+	return s_aussie_pool.load(std::memory_order_acquire);
+}
+
+int aussie_thread_count()  // Threads in the pool, including the caller
+{
+	return aussie_thread_pool_get()->nthreads;
+}
+
+int aussie_thread_index()  // This thread's slot (0 = a thread outside the pool)
+{
+	return s_aussie_thread_slot;
+}
+
+//---------------------------------------------------
+// Parallel execution
+//---------------------------------------------------
+
+void aussie_parallel_run(int ntasks, aussie_task_fnptr fn, void* arg, int schedule)
+{
+	if (fn == NULL || ntasks < 0) {
+		yassert(fn != NULL);
+		yassert(ntasks >= 0);
+		return;  // fail
+	}
+	if (ntasks == 0) return;
+	aussie_thread_pool* pool = aussie_thread_pool_get();
+	if (ntasks == 1 || pool->nthreads == 1) {
+		for (int t = 0; t < ntasks; t++) fn(t, arg);  // Not worth waking anyone
+		return;
+	}
+
+	int myslot = s_aussie_thread_slot;
+	aussie_task_group group;
+	group.remaining = ntasks;
+	aussie_task task;
+	task.fn = fn;
+	task.arg = arg;
+	task.group = &group;
+	if (schedule == AUSSIE_SCHEDULE_STATIC) {
+		task.pinned = true;
+		for (int t = 0; t < ntasks; t++) {
+			int owner = t % pool->nthreads;  // Thread 0's share is the caller's
+			task.itask = t;
+			aussie_thread_push(pool, owner == 0 ? myslot : owner, task);
+		}
+	}
+	else {
+		task.pinned = false;
+		for (int t = ntasks - 1; t >= 0; t--) {  // Caller pops task 0 first, thieves take the end
+			task.itask = t;
+			aussie_thread_push(pool, myslot, task);
+		}
+	}
+	aussie_thread_wake_all(pool);
+
+	// Help until our tasks are done (maybe running other jobs' tasks meanwhile)
+	while (group.remaining.load(std::memory_order_acquire) > 0) {
+		if (!aussie_thread_run_one(pool, myslot)) std::this_thread::yield();
+	}
+}
+
+struct aussie_parallel_range {
+	int begin;
+	int end;
+	int grain;
+	aussie_range_fnptr fn;
+	aussie_range_reduce_fnptr reduce_fn;
+	void* arg;
+	float* partials;  // One per chunk (reduce only)
+};
+
+static int aussie_parallel_chunks(int begin, int end, int& grain)
+{
+	int n = end - begin;
+	if (grain <= 0) {
+		int nchunks = 4 * aussie_thread_count();  // A few per thread, for stealing
+		grain = (n + nchunks - 1) / nchunks;
+		if (grain < 1) grain = 1;
+	}
+	return (n + grain - 1) / grain;
+}
+
+static void aussie_parallel_range_task(int itask, void* arg)
+{
+	aussie_parallel_range* range = (aussie_parallel_range*)arg;
+	int b = range->begin + itask * range->grain;
+	int e = range->end - b < range->grain ? range->end : b + range->grain;
+	if (range->partials) range->partials[itask] = range->reduce_fn(b, e, range->arg);
+	else range->fn(b, e, range->arg);
+}
+
+void aussie_parallel_for(int begin, int end, int grain, aussie_range_fnptr fn, void* arg)
+{
+	if (fn == NULL) {
+		yassert(fn != NULL);
+		return;  // fail
+	}
+	if (end <= begin) return;
+	aussie_parallel_range range;
+	range.begin = begin;
+	range.end = end;
+	range.grain = grain;
+	int nchunks = aussie_parallel_chunks(begin, end, range.grain);
+	range.fn = fn;
+	range.reduce_fn = NULL;
+	range.arg = arg;
+	range.partials = NULL;
+	aussie_parallel_run(nchunks, aussie_parallel_range_task, &range, AUSSIE_SCHEDULE_DYNAMIC);
+}
+
+float aussie_parallel_reduce(int begin, int end, int grain, aussie_range_reduce_fnptr fn, void* arg,
+	float finit, aussie_combine_fnptr combine)
+{
+	if (fn == NULL || combine == NULL) {
+		yassert(fn != NULL && combine != NULL);
+		return finit;  // fail
+	}
+	if (end <= begin) return finit;
+	aussie_parallel_range range;
+	range.begin = begin;
+	range.end = end;
+	range.grain = grain;
+	int nchunks = aussie_parallel_chunks(begin, end, range.grain);
+	std::vector<float> partials(nchunks);
+	range.fn = NULL;
+	range.reduce_fn = fn;
+	range.arg = arg;
+	range.partials = &partials[0];
+	aussie_parallel_run(nchunks, aussie_parallel_range_task, &range, AUSSIE_SCHEDULE_DYNAMIC);
+	float f = finit;
+	for (int i = 0; i < nchunks; i++) f = combine(f, partials[i]);  // Fixed order (deterministic)
+	return f;
+}
+
+float aussie_combine_sum(float f1, float f2)
+{
+	return f1 + f2;
+}
+
+float aussie_combine_max(float f1, float f2)
+{
+	return f1 > f2 ? f1 : f2;
+}
+
+//---------------------------------------------------
+// Unit tests
+//---------------------------------------------------
+
+#define AUSSIE_THREAD_TEST_TASKS 100
+
+struct aussie_thread_test_data {
+	std::atomic<int> runs[AUSSIE_THREAD_TEST_TASKS];
+	std::thread::id owner[AUSSIE_THREAD_TEST_TASKS];
+	std::atomic<int> nested_sum;
+};
+
+static void aussie_thread_test_task(int itask, void* arg)
+{
+	aussie_thread_test_data* data = (aussie_thread_test_data*)arg;
+	data->runs[itask]++;
+	data->owner[itask] = std::this_thread::get_id();
+}
+
+static void aussie_thread_test_nested_inner(int itask, void* arg)
+{
+	std::atomic<int>* sum = (std::atomic<int>*)arg;
+	*sum += itask;
+}
+
+static void aussie_thread_test_nested_task(int itask, void* arg)
+{
+	// Nested submission in both schedules
+	aussie_thread_test_data* data = (aussie_thread_test_data*)arg;
+	aussie_parallel_run(10, aussie_thread_test_nested_inner, &data->nested_sum, AUSSIE_SCHEDULE_DYNAMIC);
+	aussie_parallel_run(10, aussie_thread_test_nested_inner, &data->nested_sum, AUSSIE_SCHEDULE_STATIC);
+}
+
+static void aussie_thread_test_schedule(int schedule)
+{
+	aussie_thread_test_data data;
+	for (int t = 0; t < AUSSIE_THREAD_TEST_TASKS; t++) data.runs[t] = 0;
+	aussie_parallel_run(AUSSIE_THREAD_TEST_TASKS, aussie_thread_test_task, &data, schedule);
+	bool once = true;
+	for (int t = 0; t < AUSSIE_THREAD_TEST_TASKS; t++) {
+		if (data.runs[t] != 1) once = false;
+	}
+	ytest(once);  // Every task exactly once
+
+	if (schedule == AUSSIE_SCHEDULE_STATIC) {
+		int nthreads = aussie_thread_count();
+		bool fixed = true;
+		for (int t = nthreads; t < AUSSIE_THREAD_TEST_TASKS; t++) {
+			if (data.owner[t] != data.owner[t % nthreads]) fixed = false;
+		}
+		ytest(fixed);  // Same thread owns tasks t, t+n, t+2n, ...
+		ytest(data.owner[0] == std::this_thread::get_id());
+	}
+}
+
+static void aussie_thread_test_fill(int begin, int end, void* arg)
+{
+	int* v = (int*)arg;
+	for (int i = begin; i < end; i++) v[i]++;
+}
+
+static float aussie_thread_test_sum(int begin, int end, void* arg)
+{
+	const float* v = (const float*)arg;
+	float sum = 0.0f;
+	for (int i = begin; i < end; i++) sum += v[i];
+	return sum;
+}
+
+static float aussie_thread_test_max(int begin, int end, void* arg)
+{
+	const float* v = (const float*)arg;
+	float fmax = v[begin];
+	for (int i = begin + 1; i < end; i++) if (v[i] > fmax) fmax = v[i];
+	return fmax;
+}
+
+static void aussie_thread_test_nested_for(int begin, int end, void* arg)
+{
+	// Each outer chunk runs an inner parallel loop over its own sub-range
+	aussie_parallel_for(begin, end, 3, aussie_thread_test_fill, arg);
+}
+
+static void aussie_thread_test_ranges()
+{
+	const int n = 1001;
+	int vi[n + 1];
+	float vf[n];
+	for (int i = 0; i <= n; i++) vi[i] = 0;
+	for (int i = 0; i < n; i++) vf[i] = (float)((i * 37) % 101) - 50.0f;
+
+	aussie_parallel_for(0, n, 0, aussie_thread_test_fill, vi);  // Default grain
+	aussie_parallel_for(0, n, 7, aussie_thread_test_fill, vi);
+	aussie_parallel_for(0, n, 50, aussie_thread_test_nested_for, vi);
+	bool ok = true;
+	for (int i = 0; i < n; i++) if (vi[i] != 3) ok = false;
+	ytest(ok);
+	ytesti(vi[n], 0);  // Never past end
+
+	float fsum = 0.0f, fmax = vf[0];
+	for (int i = 0; i < n; i++) {
+		fsum += vf[i];
+		if (vf[i] > fmax) fmax = vf[i];
+	}
+	float psum = aussie_parallel_reduce(0, n, 64, aussie_thread_test_sum, vf, 0.0f, aussie_combine_sum);
+	ytest(fabsf(psum - fsum) <= 1e-3f);
+	for (int rep = 0; rep < 5; rep++) {  // Deterministic (integers here, but also the same order)
+		ytestf(aussie_parallel_reduce(0, n, 64, aussie_thread_test_sum, vf, 0.0f, aussie_combine_sum), psum);
+	}
+	ytestf(aussie_parallel_reduce(0, n, 0, aussie_thread_test_max, vf, -INFINITY, aussie_combine_max), fmax);
+	ytestf(aussie_parallel_reduce(5, 5, 0, aussie_thread_test_max, vf, -1.0f, aussie_combine_max), -1.0f);  // Empty
+}
+
+void aussie_thread_unit_tests()
+{
+	fprintf(stderr, "INFO: %s: Running unit tests\n", __func__);
+	aussie_thread_pool_shutdown();
+	aussie_thread_pool_init(4);  // More threads than cores is fine for testing
+	ytesti(aussie_thread_count(), 4);
+	ytesti(aussie_thread_index(), 0);
+	for (int rep = 0; rep < 20; rep++) {  // Back-to-back jobs
+		aussie_thread_test_schedule(AUSSIE_SCHEDULE_STATIC);
+		aussie_thread_test_schedule(AUSSIE_SCHEDULE_DYNAMIC);
+	}
+
+	aussie_thread_test_data data;
+	data.nested_sum = 0;
+	aussie_parallel_run(8, aussie_thread_test_nested_task, &data, AUSSIE_SCHEDULE_STATIC);
+	aussie_parallel_run(8, aussie_thread_test_nested_task, &data, AUSSIE_SCHEDULE_DYNAMIC);
+	ytesti(data.nested_sum.load(), 2 * 8 * 2 * 45);  // 32 nested runs of 0+1+...+9
+
+	aussie_parallel_run(0, aussie_thread_test_task, &data, AUSSIE_SCHEDULE_STATIC);  // Nothing
+	aussie_thread_test_ranges();
+
+	aussie_thread_pool_shutdown();  // Back to the default size on next use
+}
+
+//---------------------------------------------------
+//---------------------------------------------------
+
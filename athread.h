@@ -0,0 +1,61 @@
+//---------------------------------------------------
+// athread.h -- Work-stealing thread pool for parallel kernels -- Aussie AI Base Library
+// Created Oct 17th 2026
+// Copyright (c) 2023 Aussie AI Labs Pty Ltd
+//---------------------------------------------------
+
+#ifndef AUSSIE_YTHREAD_INCLUDE_HEADER_H
+#define AUSSIE_YTHREAD_INCLUDE_HEADER_H
+
+//---------------------------------------------------
+// The pool is created once (on first use) and its threads sleep between jobs,
+// so a parallel kernel costs a wake-up, not a thread creation.
+// Thread count: environment variable AUSSIE_THREADS, else the number of CPUs this process may use
+// (its affinity mask, so taskset and cgroup cpusets are respected).
+// Worker threads are pinned one per allowed CPU, skipping the caller's current CPU (unless there
+// are too few CPUs, or AUSSIE_PIN_THREADS=0). The calling thread is thread 0, unpinned.
+//
+// Each thread has its own task deque: it pops its own tasks from the back (LIFO, cache-warm)
+// and steals other threads' tasks from the front (FIFO, the biggest remaining work).
+// A thread waiting for its tasks runs queued tasks meanwhile, so tasks can
+// submit nested parallel work without deadlock.
+//---------------------------------------------------
+
+typedef void (*aussie_task_fnptr)(int itask, void* arg);
+typedef void (*aussie_range_fnptr)(int begin, int end, void* arg);   // Process [begin,end)
+typedef float (*aussie_range_reduce_fnptr)(int begin, int end, void* arg);  // Partial result of [begin,end)
+typedef float (*aussie_combine_fnptr)(float f1, float f2);
+
+#define AUSSIE_SCHEDULE_STATIC  0   // Task t always runs on thread (t % nthreads): fixed ownership, never stolen
+#define AUSSIE_SCHEDULE_DYNAMIC 1   // Tasks go to the caller's deque, idle threads steal them (load balancing)
+
+void aussie_thread_pool_init(int nthreads);  // Start the pool (0 = AUSSIE_THREADS or number of cores)
+void aussie_thread_pool_shutdown();  // Join all the worker threads (only when no jobs are running)
+int aussie_thread_count();  // Threads in the pool, including the caller
+int aussie_thread_index();  // This thread's slot (0 = a thread outside the pool)
+
+// Run fn(t, arg) for t = 0..ntasks-1 and wait for all of them (may be called from inside a task).
+void aussie_parallel_run(int ntasks, aussie_task_fnptr fn, void* arg, int schedule);
+
+// Split [begin,end) into chunks of grain (0 = a few chunks per thread), dynamic schedule.
+void aussie_parallel_for(int begin, int end, int grain, aussie_range_fnptr fn, void* arg);
+
+// Combine the partial results of each chunk, in chunk order (same answer every run for a given grain).
+float aussie_parallel_reduce(int begin, int end, int grain, aussie_range_reduce_fnptr fn, void* arg,
+	float finit, aussie_combine_fnptr combine);
+float aussie_combine_sum(float f1, float f2);
+float aussie_combine_max(float f1, float f2);
+
+#define AUSSIE_PARALLEL_GRAIN 16384   // Default chunk of a vector for the parallel kernels (64K of floats)
+extern int g_aussie_parallel_grain;   // Chunk size used by the parallel vector kernels (tunable)
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+void aussie_thread_unit_tests();
+
+//---------------------------------------------------
+//---------------------------------------------------
+
+
+#endif //AUSSIE_YTHREAD_INCLUDE_HEADER_H
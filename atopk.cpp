@@ -11,6 +11,8 @@
 #include <string.h>
 #include <ctype.h>
 #include <time.h>
+#include <algorithm>   // std::nth_element, std::sort
+#include <functional>  // std::greater
 
 //---------------------------------------------------
 //---------------------------------------------------
@@ -20,6 +22,8 @@
 #include "aassert.h"
 #include "atest.h"
 #include "avector.h"
+#include "adispatch.h"
+#include "aarena.h"
 
 #include "atopk.h"  // self-include
 
@@ -83,34 +87,41 @@ void aussie_permutation_identity(int permut[], int n)
 	for (int i = 0; i < n; i++) permut[i] = i;
 }
 
-static float* g_float_array_for_qsort = NULL;
-
-int aussie_top_k_qsort_permutation_cmp(void const* addr1, void const* addr2)
+int aussie_top_k_item_cmp(void const* addr1, void const* addr2)  // qsort order for aussie_topk_item (descending)
 {
-	int index1 = *(int*)addr1;
-	int index2 = *(int*)addr2;
-	float f1 = g_float_array_for_qsort[index1];
-	float f2 = g_float_array_for_qsort[index2];
-	if (f1 < f2) return +1;  // Reversed (descending)
-	else if (f1 > f2) return -1;
-	else return 0;
+	const aussie_topk_item* p1 = (const aussie_topk_item*)addr1;
+	const aussie_topk_item* p2 = (const aussie_topk_item*)addr2;
+	if (p1->fval < p2->fval) return +1;  // Reversed (descending)
+	else if (p1->fval > p2->fval) return -1;
+	else return p1->index - p2->index;  // Ties in index order
 }
 
-void aussie_vector_top_k_qsort_permut(float v[], int n, int k, float vout[], int permut_out[])  // Top-k with general k (permuted qsort algorithm)
+void aussie_vector_top_k_qsort_permut(float v[], int n, int k, float vout[], int permut_out[], aussie_arena* arena /*= NULL*/)  // Top-k with general k (permuted qsort algorithm)
 {
-	// Create a dynamic permutation array
-	int* permut_arr = ::new int[n];
-	aussie_permutation_identity(permut_arr, n);  // Identity permutation
-
-	// Sort the array (by permutation)
-	g_float_array_for_qsort = v;
-	qsort(permut_arr, n, sizeof(permut_arr[0]), aussie_top_k_qsort_permutation_cmp);
+	// Sort (value, index) pairs, so the comparison needs no global pointer to v[] (thread-safe)
+	// ... scratch pairs from the arena (no heap calls after warmup), the heap only without one
+	if (arena == NULL) arena = aussie_thread_arena();
+	aussie_arena_mark mark;
+	aussie_topk_item* items = NULL;
+	if (arena) {
+		mark = aussie_arena_get_mark(*arena);
+		items = (aussie_topk_item*)aussie_arena_alloc(*arena, n * sizeof(aussie_topk_item));
+	}
+	else {
+		items = ::new aussie_topk_item[n];
+	}
+	for (int i = 0; i < n; i++) {
+		items[i].fval = v[i];
+		items[i].index = i;
+	}
+	qsort(items, n, sizeof(items[0]), aussie_top_k_item_cmp);
 	// Copy top-k elements
 	for (int i = 0; i < k; i++) {
-		permut_out[i] = permut_arr[i];
-		vout[i] = v[permut_arr[i]];
+		permut_out[i] = items[i].index;
+		vout[i] = items[i].fval;
 	}
-	delete[] permut_arr;
+	if (arena) aussie_arena_release(*arena, mark);
+	else delete[] items;
 }
 
 void aussie_vector_top_k_shuffle(float v[], int n, int k, float vout[])  // Top-k with general k (shuffle algorithm)
@@ -211,6 +222,217 @@ void aussie_vector_top_k_shuffle_BUGGY(float v[], int n, int k, float vout[])  /
 	}
 }
 
+//---------------------------------------------------
+// Top-k with indices (non-destructive)
+//---------------------------------------------------
+
+static inline bool aussie_topk_better(const aussie_topk_item& a, const aussie_topk_item& b)  // Does a rank above b?
+{
+	return a.fval > b.fval || (a.fval == b.fval && a.index < b.index);
+}
+
+static void aussie_topk_heap_sift_down(aussie_topk_item heap[], int n, int i)  // Min-heap: heap[0] is the worst item
+{
+	for (;;) {
+		int worst = 2 * i + 1;
+		if (worst >= n) break;
+		if (worst + 1 < n && aussie_topk_better(heap[worst], heap[worst + 1])) worst++;  // The worse child
+		if (!aussie_topk_better(heap[i], heap[worst])) break;  // Parent already the worst
+		aussie_topk_item tmp = heap[i];
+		heap[i] = heap[worst];
+		heap[worst] = tmp;
+		i = worst;
+	}
+}
+
+int aussie_vector_top_k_heap(const float v[], int n, int k, aussie_topk_item out[])  // Bounded min-heap of k items, O(n log k)
+{
+	if (k <= 0 || n <= 0) return 0;
+	if (k > n) k = n;
+
+	// The heap lives in out[]: first k elements, then heapify
+	for (int i = 0; i < k; i++) {
+		out[i].fval = v[i];
+		out[i].index = i;
+	}
+	for (int i = k / 2 - 1; i >= 0; i--) aussie_topk_heap_sift_down(out, k, i);
+
+	// Usual case is one comparison against the smallest of the top k
+	float fworst = out[0].fval;
+	for (int i = k; i < n; i++) {
+		if (v[i] > fworst) {  // Equal values lose (higher index)
+			out[0].fval = v[i];
+			out[0].index = i;
+			aussie_topk_heap_sift_down(out, k, 0);
+			fworst = out[0].fval;
+		}
+	}
+
+	// Heapsort in place: pop the worst item to the back each time (gives descending order)
+	for (int m = k - 1; m > 0; m--) {
+		aussie_topk_item tmp = out[0];
+		out[0] = out[m];
+		out[m] = tmp;
+		aussie_topk_heap_sift_down(out, m, 0);
+	}
+	return k;
+}
+
+int aussie_vector_indices_ge(const float v[], int n, float threshold, int indices_out[], int maxout)  // Indices of v[i] >= threshold (-1 if more than maxout)
+{
+	int nout = 0;
+	for (int i = 0; i < n; i++) {
+		if (v[i] >= threshold) {
+			if (nout >= maxout) return -1;  // fail (too many)
+			indices_out[nout++] = i;
+		}
+	}
+	return nout;
+}
+
+#define AUSSIE_TOPK_SELECT_NSAMPLE  1024
+
+int aussie_vector_top_k_select_scratch(const float v[], int n, int k, aussie_topk_item out[], int cand[], aussie_topk_item items[])  // Caller's scratch: n each (items may be out)
+{
+	if (k <= 0 || n <= 0) return 0;
+	if (k > n) k = n;
+	const int nsample = AUSSIE_TOPK_SELECT_NSAMPLE;
+	if (nsample * 4 > n || k * 8 > nsample) return aussie_vector_top_k_heap(v, n, k, out);  // Small vector (or big k)
+	if (cand == NULL || items == NULL) {
+		yassert(cand != NULL && items != NULL);
+		return aussie_vector_top_k_heap(v, n, k, out);  // fail
+	}
+
+	// 1. Threshold from a strided sample. The top k of v[] should have about k*nsample/n
+	//    elements in the sample, so a threshold at about twice that rank lets through
+	//    only a few hundred candidates. If that misses (rare), the k-th largest of the sample is
+	//    a safe threshold: it is <= the k-th largest of v[], so k elements always pass.
+	float sample[AUSSIE_TOPK_SELECT_NSAMPLE];  // 4KB, on the stack
+	int stride = n / nsample;
+	for (int i = 0; i < nsample; i++) sample[i] = v[i * stride];
+	int rank = (int)((2L * k * nsample) / n) + 4;  // Twice the expected rank, plus slack
+	if (rank > k - 1) rank = k - 1;  // The safe rank is never needed below this
+	int ncand = -1;
+	for (int attempt = 0; attempt < 2 && ncand < k; attempt++) {
+		if (attempt == 1) rank = k - 1;  // Safe threshold
+		std::nth_element(sample, sample + rank, sample + nsample, std::greater<float>());
+		float threshold = sample[rank];
+		// 2. SIMD filter: expect about (rank+1)*n/nsample candidates
+		long maxcand = 4L * (rank + 1) * (n / nsample) + 1024;
+		if (attempt == 1 || maxcand > n) maxcand = n;  // Last try cannot overflow
+		ncand = aussie_vector_indices_ge_dispatch(v, n, threshold, cand, (int)maxcand);
+	}
+	if (ncand < k) {  // Cannot happen after the safe threshold
+		yassert(ncand >= k);
+		return aussie_vector_top_k_heap(v, n, k, out);  // fail
+	}
+
+	// 3. Partial selection of the candidates, then sort only the top k
+	for (int i = 0; i < ncand; i++) {
+		items[i].fval = v[cand[i]];
+		items[i].index = cand[i];
+	}
+	std::nth_element(items, items + (k - 1), items + ncand, aussie_topk_better);
+	std::sort(items, items + k, aussie_topk_better);
+	if (out != items) {
+		for (int i = 0; i < k; i++) out[i] = items[i];
+	}
+	return k;
+}
+
+int aussie_vector_top_k_select(const float v[], int n, int k, aussie_topk_item out[], aussie_arena* arena /*= NULL*/)  // SIMD threshold filter, then nth_element on the few candidates
+{
+	if (k <= 0 || n <= 0) return 0;
+	if (AUSSIE_TOPK_SELECT_NSAMPLE * 4 > n || (k < n ? k : n) * 8 > AUSSIE_TOPK_SELECT_NSAMPLE) {
+		return aussie_vector_top_k_heap(v, n, k, out);  // No scratch needed
+	}
+	// Scratch from the arena (no heap calls after warmup), the heap only without one
+	if (arena == NULL) arena = aussie_thread_arena();
+	aussie_arena_mark mark;
+	int* cand = NULL;
+	aussie_topk_item* items = NULL;
+	if (arena) {
+		mark = aussie_arena_get_mark(*arena);
+		cand = (int*)aussie_arena_alloc(*arena, n * sizeof(int));
+		items = (aussie_topk_item*)aussie_arena_alloc(*arena, n * sizeof(aussie_topk_item));
+	}
+	else {
+		cand = (int*)malloc(n * sizeof(int));
+		items = (aussie_topk_item*)malloc(n * sizeof(aussie_topk_item));
+	}
+	int nout = aussie_vector_top_k_select_scratch(v, n, k, out, cand, items);
+	if (arena) aussie_arena_release(*arena, mark);
+	else {
+		free(cand);
+		free(items);
+	}
+	return nout;
+}
+
+static void aussie_vector_topk_index_tests()
+{
+	// Heap and select versus the full qsort (both give the same ties order)
+	int sizes[] = { 1, 5, 100, 5000, 50000 };
+	int ks[] = { 1, 2, 10, 100 };
+	const int maxn = 50000;
+	float* v = (float*)malloc(maxn * sizeof(float));
+	float* vcopy = (float*)malloc(maxn * sizeof(float));
+	aussie_topk_item* expect = (aussie_topk_item*)malloc(maxn * sizeof(aussie_topk_item));
+	aussie_topk_item out1[100], out2[100];
+	if (!v || !vcopy || !expect) {
+		yassert(v && vcopy && expect);
+		free(v); free(vcopy); free(expect);
+		return;  // fail
+	}
+	for (int pattern = 0; pattern < 3; pattern++) {
+		for (int s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++) {
+			int n = sizes[s];
+			for (int i = 0; i < n; i++) {
+				if (pattern == 0) v[i] = (float)((i * 7919L) % 10007) * 0.01f - 50.0f;  // Mostly distinct
+				else if (pattern == 1) v[i] = (float)((i * 31) % 7);  // Lots of ties
+				else v[i] = (float)i;  // Ascending (worst case for the heap)
+			}
+			for (int i = 0; i < n; i++) {
+				expect[i].fval = v[i];
+				expect[i].index = i;
+			}
+			qsort(expect, n, sizeof(expect[0]), aussie_top_k_item_cmp);
+			aussie_vector_copy_basic(vcopy, v, n);
+			for (int j = 0; j < (int)(sizeof(ks) / sizeof(ks[0])); j++) {
+				int k = ks[j];
+				int kk = k < n ? k : n;
+				ytesti(aussie_vector_top_k_heap(v, n, k, out1), kk);
+				ytesti(aussie_vector_top_k_select(v, n, k, out2), kk);
+				bool ok = true;
+				for (int i = 0; i < kk; i++) {
+					if (out1[i].index != expect[i].index || out1[i].fval != expect[i].fval) ok = false;
+					if (out2[i].index != expect[i].index || out2[i].fval != expect[i].fval) ok = false;
+				}
+				ytest(ok);
+			}
+			ytest(aussie_vector_equal(v, vcopy, n));  // v[] unchanged
+		}
+	}
+
+	// Caller's scratch, with the output in the items buffer (as the sampler does)
+	int* cand = (int*)malloc(maxn * sizeof(int));
+	aussie_topk_item* items = (aussie_topk_item*)malloc(maxn * sizeof(aussie_topk_item));
+	if (cand && items) {
+		ytesti(aussie_vector_top_k_select_scratch(v, maxn, 10, items, cand, items), 10);
+		ytesti(aussie_vector_top_k_heap(v, maxn, 10, out1), 10);
+		bool ok = true;
+		for (int i = 0; i < 10; i++) {
+			if (items[i].index != out1[i].index || items[i].fval != out1[i].fval) ok = false;
+		}
+		ytest(ok);
+	}
+	free(cand);
+	free(items);
+	free(v);
+	free(vcopy);
+	free(expect);
+}
+
 //---------------------------------------------------
 //---------------------------------------------------
 
@@ -340,7 +562,7 @@ void aussie_vector_topk_tests()
 	ytestf(aussie_vector_max(vout, 5), 10.0f);
 	ytestf(aussie_vector_min(vout, 5), 6.0f);
 
-
+	aussie_vector_topk_index_tests();  // Heap and select versions
 }
 
 //---------------------------------------------------
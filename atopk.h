@@ -8,13 +8,32 @@
 void aussie_vector_top_k_2(float v[], int n, float vout[]);  // Topk with k=2
 int aussie_top_k_qsort_cmp(void const* addr1, void const* addr2);
 void aussie_vector_top_k_qsort(float v[], int n, int k, float vout[]);  // Top-k with general k (qsort algorithm)
-void aussie_vector_top_k_qsort_permut(float v[], int n, int k, float vout[], int permut_out[]);  // Top-k with general k (permuted qsort algorithm)
+struct aussie_arena;  // aarena.h
+
+void aussie_vector_top_k_qsort_permut(float v[], int n, int k, float vout[], int permut_out[], aussie_arena* arena = NULL);  // Top-k with general k (permuted qsort algorithm), scratch from arena (NULL = this thread's)
 void aussie_vector_top_k_shuffle(float v[], int n, int k, float vout[]);  // Top-k with general k (shuffle algorithm)
 void aussie_vector_top_k_shuffle_BUGGY(float v[], int n, int k, float vout[]);  // Top-k with general k (shuffle algorithm)
 
+//---------------------------------------------------
+// Top-k with indices (non-destructive, v[] is not modified, thread-safe)
+// ... output is sorted descending by value; equal values in index order (lowest first)
+// ... returns the number of items written (k, or n if n < k)
+// ... assumes no NaNs in v[]
+//---------------------------------------------------
+
+struct aussie_topk_item {
+	float fval;  // The value v[index]
+	int index;   // Its position in v[] (e.g. token id)
+};
+
+int aussie_vector_top_k_heap(const float v[], int n, int k, aussie_topk_item out[]);  // Bounded min-heap of k items, O(n log k)
+int aussie_vector_top_k_select(const float v[], int n, int k, aussie_topk_item out[], aussie_arena* arena = NULL);  // SIMD threshold filter, then nth_element on the few candidates, scratch from arena (NULL = this thread's)
+int aussie_vector_top_k_select_scratch(const float v[], int n, int k, aussie_topk_item out[], int cand[], aussie_topk_item items[]);  // Same, caller's scratch: n indices, n items (items may be out)
+int aussie_vector_indices_ge(const float v[], int n, float threshold, int indices_out[], int maxout);  // Indices of v[i] >= threshold (-1 if more than maxout)
+int aussie_top_k_item_cmp(void const* addr1, void const* addr2);  // qsort order for aussie_topk_item (descending)
+
 // PERMUTATIONS
 void aussie_permutation_identity(int permut[], int n);
-int aussie_top_k_qsort_permutation_cmp(void const* addr1, void const* addr2);
 
 void aussie_vector_topk_tests();  // Unit tests for Top-K 
 
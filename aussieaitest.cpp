@@ -29,11 +29,24 @@
 #include "adebug.h"
 #include "anorms.h"
 #include "asoftmax.h"
+#include "aexp.h"
 #include "anormalize.h"
 #include "aavx.h"
 #include "abenchmark.h"
 #include "abook1.h"  // Book examples
 #include "adynarray.h"
+#include "adispatch.h"
+#include "agemm.h"
+#include "athread.h"
+#include "asample.h"
+#include "aregistry.h"
+#include "aquant.h"
+#include "ahalf.h"
+#include "atensor.h"
+#include "aarena.h"
+#include "alut.h"
+#include "aconstexpr.h"
+#include "affn.h"
 
 //---------------------------------------------------
 //---------------------------------------------------
@@ -80,23 +93,37 @@ void aussie_test_one_reluize(float v[], int n)
 	float sumafter2 = aussie_vector_sum(v, n);
 	ytestf(sumafter2, sumafter);
 
-#if !LINUX
-	aussie_vector_copy_basic(v, vcopy, n);  // AVX1...
-	sumbefore2 = aussie_vector_sum(v, n);
-	ytestf(sumbefore, sumbefore2);
-	aussie_vector_reluize_AVX1(v, n);
-	sumafter2 = aussie_vector_sum(v, n);
-	ytestf(sumafter2, sumafter);
-#endif //LINUX
-
-#if !LINUX
-	aussie_vector_copy_basic(v, vcopy, n);  // AVX2...
-	sumbefore2 = aussie_vector_sum(v, n);
-	ytestf(sumbefore, sumbefore2);
-	aussie_vector_reluize_AVX2(v, n);
+#if AUSSIE_X86
+	if (aussie_cpu_has_avx()) {
+		aussie_vector_copy_basic(v, vcopy, n);  // AVX1...
+		sumbefore2 = aussie_vector_sum(v, n);
+		ytestf(sumbefore, sumbefore2);
+		aussie_vector_reluize_AVX1(v, n);
+		sumafter2 = aussie_vector_sum(v, n);
+		ytestf(sumafter2, sumafter);
+	}
+
+	if (aussie_cpu_has_avx2()) {
+		aussie_vector_copy_basic(v, vcopy, n);  // AVX2...
+		sumbefore2 = aussie_vector_sum(v, n);
+		ytestf(sumbefore, sumbefore2);
+		aussie_vector_reluize_AVX2(v, n);
+		sumafter2 = aussie_vector_sum(v, n);
+		ytestf(sumafter2, sumafter);
+	}
+
+	if (aussie_cpu_has_avx512()) {
+		aussie_vector_copy_basic(v, vcopy, n);  // AVX-512...
+		aussie_vector_reluize_AVX512(v, n);
+		sumafter2 = aussie_vector_sum(v, n);
+		ytestf(sumafter2, sumafter);
+	}
+#endif //AUSSIE_X86
+
+	aussie_vector_copy_basic(v, vcopy, n);  // Dispatched (best for this CPU)...
+	aussie_vector_reluize_dispatch(v, n);
 	sumafter2 = aussie_vector_sum(v, n);
 	ytestf(sumafter2, sumafter);
-#endif //LINUX
 
 }
 
@@ -134,9 +161,13 @@ void aussie_unit_tests()
 
 	aussie_reluize_unit_tests();
 
-#if !LINUX
+#if AUSSIE_X86
 	aussie_unit_test_avx();
-#endif //LINUX
+#endif //AUSSIE_X86
+	aussie_dispatch_unit_tests();
+	aussie_exp_unit_tests();
+	aussie_thread_unit_tests();
+	aussie_gemm_unit_tests();
 
 	aussie_book_examples();
 
@@ -151,6 +182,16 @@ void aussie_unit_tests()
 
 	// Test vector dot products...
 	aussie_yvector_unit_tests();
+	aussie_sample_unit_tests();  // Token sampling (uses softmax and top-k)
+	aussie_benchmark_unit_tests();  // Benchmark harness (timing, statistics, CSV/JSON)
+	aussie_registry_unit_tests();  // Kernel registry and auto-tuner
+	aussie_quant_unit_tests();  // INT8 quantized GEMV
+	aussie_half_unit_tests();  // FP16/BF16 weights, FP32 accumulation
+	aussie_tensor_unit_tests();  // Aligned tensors, strided views
+	aussie_arena_unit_tests();  // Arena allocator, per-thread scratch
+	aussie_lut_unit_tests();  // Interpolated activation tables
+	aussie_constexpr_unit_tests();  // Compile-time tables
+	aussie_ffn_unit_tests();  // Fused gated FFN
 
 
 	aussie_float_tests();
@@ -172,7 +213,8 @@ void aussie_unit_tests()
 int main(int argc, char* argv[], char *envp[])
 {
 	printf("AUSSIE AI BASE: starting test execution.\n");
-	int action = 0;  // 0=unit tests, 1=printenv, 2=accuracy, 3=benchmark basic ops, 4=model!, 5=benchmarks
+	int action = 0;  // 0=unit tests, 1=printenv, 2=accuracy, 3=benchmark basic ops, 4=model!, 5=benchmarks, 6=roofline sweep, 7=tune kernels
+	if (argc > 1) action = atoi(argv[1]);  // e.g. "aussieai 6"
 
 	switch (action) {
 	case 0: 
@@ -199,6 +241,16 @@ int main(int argc, char* argv[], char *envp[])
 		aussie_test_benchmarks();
 		break;
 
+	case 6:   // Roofline size sweep of the vector and matrix kernels
+		aussie_benchmark_sweep();
+		break;
+
+	case 7: {  // Tune the kernels at typical sizes (cached in the tuning file)
+		int sizes[] = { 64, 256, 1024, 4096, 16384, 65536 };
+		aussie_tune_startup(sizes, (int)(sizeof(sizes) / sizeof(sizes[0])));
+		break;
+	}
+
 
 	} // End switch
 	exit(0);
@@ -33,6 +33,8 @@
 #include "anormalize.h"
 #include "atopk.h"
 #include "aavx.h"
+#include "adispatch.h"
+#include "athread.h"
 
 #include "avector.h"  // Self-include
 
@@ -219,8 +221,8 @@ float aussie_vector_mean(float v[], int n)  // Mean (same as average)
 
 float aussie_vector_mean_AVX1(float v[], int n)  // Mean (same as average)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return 0;
 #else
 	if (n == 0) {
@@ -229,13 +231,13 @@ float aussie_vector_mean_AVX1(float v[], int n)  // Mean (same as average)
 	}
 	float sum = aussie_vector_sum_AVX1(v, n);
 	return sum / (float)n;
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 float aussie_vector_mean_AVX2(float v[], int n)  // Mean (same as average)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return 0;
 #else
 	if (n == 0) {
@@ -244,7 +246,22 @@ float aussie_vector_mean_AVX2(float v[], int n)  // Mean (same as average)
 	}
 	float sum = aussie_vector_sum_AVX2(v, n);
 	return sum / (float)n;
-#endif //LINUX
+#endif //AUSSIE_X86
+}
+
+float aussie_vector_mean_AVX512(float v[], int n)  // Mean (same as average)
+{
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
+	return 0;
+#else
+	if (n == 0) {
+		yassert(n != 0);
+		return 0.0;  // fail internal error
+	}
+	float sum = aussie_vector_sum_AVX512(v, n);
+	return sum / (float)n;
+#endif //AUSSIE_X86
 }
 
 float aussie_vector_sum_diff_squared(float v[], int n, float meanval)
@@ -295,28 +312,28 @@ float aussie_vector_sum_diff_squared_fissionB(float v[], int n, float meanval)
 
 float aussie_vector_sum_diff_squared_fission_AVX1(float v[], int n, float meanval)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return 0;
 #else
 	// FISSION version of "sum diff squared" 
 	aussie_vector_add_scalar_AVX1(v, n, -meanval);  // Loop 1. DIFFs
 	float sum = aussie_vector_sum_squares_AVX1(v, n);  // Loop 2. Sum-of-squares...
 	return sum;
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 float aussie_vector_sum_diff_squared_fission_AVX2(float v[], int n, float meanval)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return 0;
 #else
 	// FISSION version of "sum diff squared" 
 	aussie_vector_add_scalar_AVX2(v, n, -meanval);  // Loop 1. DIFFs
 	float sum = aussie_vector_sum_squares_AVX2(v, n);  // Loop 2. Sum-of-squares...
 	return sum;
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 float aussie_vector_sum_squared(float v[], int n)
@@ -339,50 +356,62 @@ float aussie_vector_mean_and_variance_fused(float v[], int n, float& fmean_out)
 
 float aussie_vector_mean_and_variance_fused_AVX1(float v[], int n, float& fmean_out)  // Variance (square of std. dev.)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return 0;
 #else
 	fmean_out = aussie_vector_mean_AVX1(v, n);  // Get the mean/average
 	float sumsquares = aussie_vector_sum_diff_squared_fused_AVX1(v, n, fmean_out);  // Sum of squared-diffs from mean
 	return sumsquares / (float)n;  // Divide the sum-of-squares by N...
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 float aussie_vector_mean_and_variance_fused_AVX2(float v[], int n, float& fmean_out)  // Variance (square of std. dev.)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return 0;
 #else
 	fmean_out = aussie_vector_mean_AVX1(v, n);  // Get the mean/average
 	float sumsquares = aussie_vector_sum_diff_squared_fused_AVX2(v, n, fmean_out);  // Sum of squared-diffs from mean
 	return sumsquares / (float)n;  // Divide the sum-of-squares by N...
-#endif //LINUX
+#endif //AUSSIE_X86
+}
+
+float aussie_vector_mean_and_variance_fused_AVX512(float v[], int n, float& fmean_out)  // Variance (square of std. dev.)
+{
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
+	return 0;
+#else
+	fmean_out = aussie_vector_mean_AVX512(v, n);  // Get the mean/average
+	float sumsquares = aussie_vector_sum_diff_squared_fused_AVX512(v, n, fmean_out);  // Sum of squared-diffs from mean
+	return sumsquares / (float)n;  // Divide the sum-of-squares by N...
+#endif //AUSSIE_X86
 }
 
 float aussie_vector_mean_and_variance_all_AVX1(float v[], int n, float& fmean_out)  // Variance (square of std. dev.)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return 0;
 #else
 	fmean_out = aussie_vector_mean_AVX1(v, n);  // Get the mean/average
 	float sumsquares = aussie_vector_sum_diff_squared_fission_AVX1(v, n, fmean_out);  // Sum of squared-diffs from mean
 	return sumsquares / (float)n;  // Divide the sum-of-squares by N...
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 float aussie_vector_mean_and_variance_all_AVX2(float v[], int n, float& fmean_out)  // Variance (square of std. dev.)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return 0;
 #else
 	fmean_out = aussie_vector_mean_AVX2(v, n);  // Get the mean/average
 	float sumsquares = aussie_vector_sum_diff_squared_fission_AVX2(v, n, fmean_out);  // Sum of squared-diffs from mean
 	return sumsquares / (float)n;  // Divide the sum-of-squares by N...
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 
@@ -417,26 +446,26 @@ float aussie_vector_variance_of_mean_fused(float v[], int n, float fmean)  // Va
 
 float aussie_vector_variance_of_mean_fused_AVX1(float v[], int n, float fmean)  // Variance with Fusion (leaves DIFF from MEAN in the vector)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return 0;
 #else
 	// Fusion version that leaves the DIFF in the vector..
 	float sumsquares = aussie_vector_sum_diff_squared_fused_AVX1(v, n, fmean);  // Sum of squared-diffs from mean (leaves DIFF in vector)
 	return sumsquares / (float)n;  // Divide the sum-of-squares by N...
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 float aussie_vector_variance_of_mean_fused_AVX2(float v[], int n, float fmean)  // Variance with Fusion (leaves DIFF from MEAN in the vector)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return 0;
 #else
 	// Fusion version that leaves the DIFF in the vector..
 	float sumsquares = aussie_vector_sum_diff_squared_fused_AVX2(v, n, fmean);  // Sum of squared-diffs from mean (leaves DIFF in vector)
 	return sumsquares / (float)n;  // Divide the sum-of-squares by N...
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 void aussie_multiply_vectors(float v1[], float v2[], float result[], int n)
@@ -478,48 +507,48 @@ float aussie_vector_mean_and_stddev_fused(float v[], int n, float& meanout)  //
 
 float aussie_vector_mean_and_stddev_all_AVX1(float v[], int n, float& meanout)  // Std. dev (sqrt of variance)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return 0;
 #else
 	float vvariance = aussie_vector_mean_and_variance_all_AVX1(v, n, meanout);  // Get the Variance
 	return sqrtf(vvariance);   // Std.dev is just the sqrt of variance...
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 
 
 float aussie_vector_mean_and_stddev_fused_AVX1(float v[], int n, float& meanout)  // Std. dev (sqrt of variance)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return 0;
 #else
 	float vvariance = aussie_vector_mean_and_variance_fused_AVX1(v, n, meanout);  // Get the Variance
 	return sqrtf(vvariance);   // Std.dev is just the sqrt of variance...
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 float aussie_vector_mean_and_stddev_all_AVX2(float v[], int n, float& meanout)  // Std. dev (sqrt of variance)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return 0;
 #else
 	float vvariance = aussie_vector_mean_and_variance_all_AVX2(v, n, meanout);  // Get the Variance
 	return sqrtf(vvariance);   // Std.dev is just the sqrt of variance...
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 float aussie_vector_mean_and_stddev_fused_AVX2(float v[], int n, float& meanout)  // Std. dev (sqrt of variance)
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return 0;
 #else
 	float vvariance = aussie_vector_mean_and_variance_fused_AVX2(v, n, meanout);  // Get the Variance
 	return sqrtf(vvariance);   // Std.dev is just the sqrt of variance...
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 float aussie_vector_standard_deviation(float v[], int n)  // Std. dev (sqrt of variance)
@@ -987,6 +1016,46 @@ float aussie_vecdot_parallel_padding(float v1[], float v2[], int n)   // Use pad
 	return sum;
 }
 
+//---------------------------------------------------
+// Real parallel versions: chunks go to the thread pool (athread.h)
+// ... each chunk uses the dispatched SIMD kernel
+//---------------------------------------------------
+
+struct aussie_vector_parallel_args {
+	const float* v1;
+	const float* v2;
+	float* v;
+	float c;
+};
+
+static float aussie_vecdot_parallel_chunk(int begin, int end, void* arg)
+{
+	const aussie_vector_parallel_args* args = (const aussie_vector_parallel_args*)arg;
+	return aussie_vecdot_dispatch(&args->v1[begin], &args->v2[begin], end - begin);
+}
+
+float aussie_vecdot_parallel(const float v1[], const float v2[], int n)   // Real parallel vector dot product (thread pool)
+{
+	aussie_vector_parallel_args args;
+	args.v1 = v1;
+	args.v2 = v2;
+	return aussie_parallel_reduce(0, n, g_aussie_parallel_grain, aussie_vecdot_parallel_chunk, &args, 0.0f, aussie_combine_sum);
+}
+
+static void aussie_vector_multiply_scalar_parallel_chunk(int begin, int end, void* arg)
+{
+	const aussie_vector_parallel_args* args = (const aussie_vector_parallel_args*)arg;
+	aussie_vector_multiply_scalar_dispatch(&args->v[begin], end - begin, args->c);
+}
+
+void aussie_vector_multiply_scalar_parallel(float v[], int n, float c)  // Multiply by constant, split across the thread pool
+{
+	aussie_vector_parallel_args args;
+	args.v = v;
+	args.c = c;
+	aussie_parallel_for(0, n, g_aussie_parallel_grain, aussie_vector_multiply_scalar_parallel_chunk, &args);
+}
+
 
 //---------------------------------------------------
 //---------------------------------------------------
@@ -1050,25 +1119,22 @@ float aussie_vecdot_unroll4_basic(float v1[], float v2[], int n)  // Loop-unroll
 	return sum;
 }
 
-#if !LINUX
-#include <intrin.h>
-#endif //LINUX
+#if AUSSIE_X86
+#include <immintrin.h>  // SSE/AVX/AVX-2 intrinsics
+#endif //AUSSIE_X86
 
 // aussie_vecdot_AVX1 ... 
-float aussie_vecdot_unroll_AVX1(const float v1[], const float v2[], int n)  // AVX-1 loop-unrolled (4 floats) Vector dot product 
+AUSSIE_TARGET_AVX1 float aussie_vecdot_unroll_AVX1(const float v1[], const float v2[], int n)  // AVX-1 loop-unrolled (4 floats) Vector dot product 
 {		
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return 0;
 #else
 	// Code sequence from aussie_vecdot_unroll_AVX1
 
-	if (n % 4 != 0) {
-		yassert(n % 4 == 0);
-		return 0.0; // fail
-	}
 	float sum = 0.0;
-	for (int i = 0; i < n; i += 4) {
+	int i = 0;
+	for (; i + 4 <= n; i += 4) {
 		// AVX1: Vector dot product of 2 vectors 
 		//  ... process 4x32-bit floats in 128 bits
 		__m128 r1 = _mm_loadu_ps(&v1[i]);   // Load floats into 128-bits
@@ -1076,23 +1142,19 @@ float aussie_vecdot_unroll_AVX1(const float v1[], const float v2[], int n)  // A
 		__m128 dst = _mm_dp_ps(r1, r2, 0xf1); // Dot product
 		sum += _mm_cvtss_f32(dst);
 	}
+	for (; i < n; i++) sum += v1[i] * v2[i];  // Leftovers
 	return sum;
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 // aussie_vecdot_AVX2
-float aussie_vecdot_FMA_unroll_AVX2(const float v1[], const float v2[], int n)   // AVX2 vecdot using FMA (Fused Multiply-Add) primitives
+AUSSIE_TARGET_AVX2 float aussie_vecdot_FMA_unroll_AVX2(const float v1[], const float v2[], int n)   // AVX2 vecdot using FMA (Fused Multiply-Add) primitives
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return 0;
 #else
 
-	if (n % 8 != 0) {
-		yassert(n % 8 == 0);
-		return 0.0; // fail
-	}
-
 	__m256 sumdst = _mm256_setzero_ps();   // Set accumulators to zero
 #if 0
 	float* farrtest = (float*)&sumdst;
@@ -1105,7 +1167,8 @@ float aussie_vecdot_FMA_unroll_AVX2(const float v1[], const float v2[], int n)
 	ytestf(sumtest, 0.0f);
 #endif
 
-	for (int i = 0; i < n; i += 8) {
+	int i = 0;
+	for (; i + 8 <= n; i += 8) {
 		// AVX2: Vector dot product of 2 vectors 
 		//  ... process 8x32-bit floats in 256 bits
 		__m256 r1 = _mm256_loadu_ps(&v1[i]);   // Load floats into 128-bits
@@ -1117,25 +1180,22 @@ float aussie_vecdot_FMA_unroll_AVX2(const float v1[], const float v2[], int n)
 	float* farr = (float*)&sumdst;
 	float sum = farr[0] + farr[1] + farr[2] + farr[3]
 		+ farr[4] + farr[5] + farr[6] + farr[7];
+	for (; i < n; i++) sum += v1[i] * v2[i];  // Leftovers
 	return sum;
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
-float aussie_vecdot_FMA_unroll_AVX1(const float v1[], const float v2[], int n)   // AVX1 vecdot using FMA (Fused Multiply-Add) primitives
+AUSSIE_TARGET_AVX1_FMA float aussie_vecdot_FMA_unroll_AVX1(const float v1[], const float v2[], int n)   // AVX1 vecdot using FMA (Fused Multiply-Add) primitives
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return 0;
 #else
 	// Code sequence from aussie_vecdot_unroll_AVX1
 
-	if (n % 4 != 0) {
-		yassert(n % 4 == 0);
-		return 0.0; // fail
-	}
-
 	__m128 sumdst = _mm_setzero_ps();   // Set accumulators to zero
-	for (int i = 0; i < n; i += 4) {
+	int i = 0;
+	for (; i + 4 <= n; i += 4) {
 		// AVX1: Vector dot product of 2 vectors 
 		//  ... process 4x32-bit floats in 128 bits
 		__m128 r1 = _mm_loadu_ps(&v1[i]);   // Load floats into 128-bits
@@ -1146,22 +1206,19 @@ float aussie_vecdot_FMA_unroll_AVX1(const float v1[], const float v2[], int n)
 	// Add the final 4 accumulators manually
 	float* farr = (float*)&sumdst;
 	float sum = farr[0] + farr[1] + farr[2] + farr[3];  // Manual add the 4 floats...
+	for (; i < n; i++) sum += v1[i] * v2[i];  // Leftovers
 	return sum;
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 
 
-float aussie_vecdot_unroll_AVX2(const float v1[], const float v2[], int n)  // AVX-2 loop-unrolled (8 floats) Vector dot product 
+AUSSIE_TARGET_AVX2 float aussie_vecdot_unroll_AVX2(const float v1[], const float v2[], int n)  // AVX-2 loop-unrolled (8 floats) Vector dot product 
 {
-#if LINUX
-	fprintf(stderr, "ERROR: %s: Not supported on Linux\n", __func__);
+#if !AUSSIE_X86
+	fprintf(stderr, "ERROR: %s: Not supported on non-x86 CPUs\n", __func__);
 	return 0;
 #else
-	if (n % 8 != 0) { 
-		yassert(n % 8 == 0);
-		return 0.0; // fail
-	}
 #if 0 // manual enable
 	yassert(aussie_is_aligned_16(v1));
 	yassert(aussie_is_aligned_16(v2));
@@ -1170,16 +1227,20 @@ float aussie_vecdot_unroll_AVX2(const float v1[], const float v2[], int n)  // A
 #endif
 
 	float sum = 0.0;
-	for (int i = 0; i < n; i += 4 /*4 not 8! problem..*/) {
+	int i = 0;
+	for (; i + 8 <= n; i += 4 /*4 not 8! problem..*/) {
 		// AVX2 dot product of 8 float's in 256-bits
 		// Code sequence from aussie_vecdot_unroll_AVX2
+		// ... _mm256_dp_ps does each 128-bit half separately, so only the low 4 floats are used,
+		// ... but it loads 8 (so stop 8 before the end, not 4, to avoid reading past it)
 		__m256 r1 = _mm256_loadu_ps(&v1[i]);   // Load floats into 256-bits ...
 		__m256 r2 = _mm256_loadu_ps(&v2[i]);
 		__m256 dst = _mm256_dp_ps(r1, r2, 0xFF);   // Dot product (dotp)
 		sum += _mm256_cvtss_f32(dst);
 	}
+	for (; i < n; i++) sum += v1[i] * v2[i];  // Leftovers
 	return sum;
-#endif //LINUX
+#endif //AUSSIE_X86
 }
 
 
@@ -1538,26 +1599,30 @@ void aussie_yvector_test_dot_products(float v1[], float v2[], int n, float expec
 	if (n % 4 == 0) {
 		f2 = aussie_vecdot_unroll4_basic(v1, v2, n);
 		ytestf(f2, f);
+	}
 
-#if !LINUX
+#if AUSSIE_X86  // SIMD kernels handle any n (scalar or masked leftovers)
+	if (aussie_cpu_has_avx()) {
 		f2 = aussie_vecdot_unroll_AVX1(v1, v2, n);
 		ytestf(f2, f);
+	}
 
+	if (aussie_cpu_has_avx2()) {  // FMA
 		f2 = aussie_vecdot_FMA_unroll_AVX1(v1, v2, n);
 		ytestf(f2, f);
 
 		f2 = aussie_vecdot_FMA_unroll_AVX2(v1, v2, n);
 		ytestf(f2, f);
-#endif //LINUX
-
 
-	}
-#if !LINUX
-	if (n % 8 == 0) {
 		f2 = aussie_vecdot_unroll_AVX2(v1, v2, n);
 		ytestf(f2 , f);
 	}
-#endif //LINUX
+
+	if (aussie_cpu_has_avx512()) {
+		f2 = aussie_vecdot_FMA_unroll_AVX512(v1, v2, n);
+		ytestf(f2, f);
+	}
+#endif //AUSSIE_X86
 
 	f2 = aussie_vecdot_unroll4_better(v1, v2, n);
 	ytestf(f2, f);
@@ -1599,6 +1664,9 @@ void aussie_yvector_test_dot_products_BIG(float v1[], float v2[], int n, float e
 		ytestf(f2, expected);
 	}
 
+	float f4 = aussie_vecdot_parallel(v1, v2, n);   // Real parallel version (thread pool)
+	ytestf(f4, expected);
+
 
 	float f3 = aussie_vecdot_parallel_odd_sizes(v1, v2, n);
 	ytestf(f3, expected);
@@ -1623,19 +1691,22 @@ void aussie_test_vector_sum(float v[], int n, float fexpected)
 	float f2 = aussie_vector_sum_pointer_arith(v, n);
 	ytestf(f2, fexpected);
 
-#if !LINUX
-	if (n % 4 == 0) {
+#if AUSSIE_X86
+	if (aussie_cpu_has_avx()) {
 		f2 = aussie_vector_sum_AVX1(v, n);
 		ytestf(f2, fexpected);
 	}
-#endif //LINUX
 
-#if !LINUX
-	if (n % 8 == 0) {
+	if (aussie_cpu_has_avx2()) {
 		f2 = aussie_vector_sum_AVX2(v, n);
 		ytestf(f2, fexpected);
 	}
-#endif //LINUX
+
+	if (aussie_cpu_has_avx512()) {
+		f2 = aussie_vector_sum_AVX512(v, n);
+		ytestf(f2, fexpected);
+	}
+#endif //AUSSIE_X86
 
 }
 
@@ -1643,15 +1714,23 @@ void aussie_vector_max_test_one(float v[], int n)
 {
 	float fmax = aussie_vector_max(v, n);
 
-#if !LINUX
-	float f2 = aussie_vector_max_AVX1(v, n);
-	ytestf(f2, fmax);
-#endif //LINUX
+#if AUSSIE_X86
+	float f2 = 0.0f;
+	if (aussie_cpu_has_avx()) {
+		f2 = aussie_vector_max_AVX1(v, n);
+		ytestf(f2, fmax);
+	}
+
+	if (aussie_cpu_has_avx2()) {
+		f2 = aussie_vector_max_AVX2(v, n);
+		ytestf(f2, fmax);
+	}
 
-#if !LINUX
-	f2 = aussie_vector_max_AVX2(v, n);
-	ytestf(f2, fmax);
-#endif //LINUX
+	if (aussie_cpu_has_avx512()) {
+		f2 = aussie_vector_max_AVX512(v, n);
+		ytestf(f2, fmax);
+	}
+#endif //AUSSIE_X86
 
 }
 
@@ -1659,20 +1738,27 @@ void aussie_vector_min_test_one(float v[], int n)
 {
 	float fmax = aussie_vector_min(v, n);
 
-#if !LINUX
-	float f2 = aussie_vector_min_AVX1(v, n);
-	ytestf(f2, fmax);
-#endif //LINUX
+#if AUSSIE_X86
+	float f2 = 0.0f;
+	if (aussie_cpu_has_avx()) {
+		f2 = aussie_vector_min_AVX1(v, n);
+		ytestf(f2, fmax);
+		f2 = aussie_vector_min_AVX1b(v, n);
+		ytestf(f2, fmax);
+	}
 
-#if !LINUX
-    f2 = aussie_vector_min_AVX1b(v, n);
-	ytestf(f2, fmax);
-	f2 = aussie_vector_min_AVX2b(v, n);
-	ytestf(f2, fmax);
+	if (aussie_cpu_has_avx2()) {
+		f2 = aussie_vector_min_AVX2b(v, n);
+		ytestf(f2, fmax);
+		f2 = aussie_vector_min_AVX2(v, n);
+		ytestf(f2, fmax);
+	}
 
-	f2 = aussie_vector_min_AVX2(v, n);
-	ytestf(f2, fmax);
-#endif //LINUX
+	if (aussie_cpu_has_avx512()) {
+		f2 = aussie_vector_min_AVX512(v, n);
+		ytestf(f2, fmax);
+	}
+#endif //AUSSIE_X86
 
 }
 
@@ -1731,6 +1817,57 @@ void aussie_vector_max_tests()
 }
 
 
+static void aussie_test_parallel_kernels()
+{
+	// Parallel kernels versus the sequential ones, on a 4-thread pool with small chunks
+	aussie_thread_pool_shutdown();
+	aussie_thread_pool_init(4);
+	int saved_grain = g_aussie_parallel_grain;
+	g_aussie_parallel_grain = 100;
+	const int n = 1237;  // Odd number of chunks, partial last chunk
+	static float v1[n], v2[n], v3[n];
+	for (int i = 0; i < n; i++) {
+		v1[i] = (float)((i * 7) % 23) * 0.25f - 2.0f;
+		v2[i] = (float)((i * 5) % 19) * 0.5f - 4.0f;
+	}
+	float fexpect = aussie_vecdot_basic(v1, v2, n);
+	ytest(fabsf(aussie_vecdot_parallel(v1, v2, n) - fexpect) <= 1e-4f * (1.0f + fabsf(fexpect)));
+
+	aussie_vector_copy_basic(v3, v1, n);
+	aussie_vector_multiply_scalar_parallel(v3, n, -3.0f);
+	bool ok = true;
+	for (int i = 0; i < n; i++) if (v3[i] != v1[i] * -3.0f) ok = false;
+	ytest(ok);
+
+	aussie_vector_copy_basic(v3, v1, n);
+	aussie_vector_softmax_basic(v3, n);
+	aussie_vector_copy_basic(v2, v1, n);
+	aussie_vector_softmax_parallel(v2, n);
+	ytest(aussie_vector_equal_approx(v2, v3, n, 1e-6f));
+
+	// Large logits: the merged per-chunk (max, sum) partials versus the sequential online softmax
+	for (int i = 0; i < n; i++) v3[i] = v1[i] * 40.0f + 800.0f;
+	aussie_vector_copy_basic(v2, v3, n);
+	aussie_vector_softmax_online(v3, n);
+	aussie_vector_softmax_parallel(v2, n);
+	ytest(aussie_vector_equal_approx(v2, v3, n, 1e-6f));
+
+	aussie_vector_copy_basic(v3, v1, n);
+	aussie_vector_rms_normalize_basic(v3, n);
+	aussie_vector_copy_basic(v2, v1, n);
+	aussie_vector_rms_normalize_parallel(v2, n);
+	ytest(aussie_vector_equal_approx(v2, v3, n, 1e-5f));
+
+	aussie_vector_copy_basic(v3, v1, n);
+	aussie_vector_normalize_zscore(v3, n);
+	aussie_vector_copy_basic(v2, v1, n);
+	aussie_vector_normalize_zscore_parallel(v2, n);
+	ytest(aussie_vector_equal_approx(v2, v3, n, 1e-4f));
+
+	g_aussie_parallel_grain = saved_grain;
+	aussie_thread_pool_shutdown();  // Back to the default size on next use
+}
+
 // Unit testing wrapper
 void aussie_yvector_unit_tests()
 {
@@ -1741,6 +1878,7 @@ void aussie_yvector_unit_tests()
 	aussie_vector_topk_tests();   // Top-K
 	aussie_softmax_unit_tests();  // Softmax
 	aussie_unit_test_normalization();  // Test BatchNorm/LayerNorm/z-score/etc.
+	aussie_test_parallel_kernels();  // Thread pool versions
 
 	int n = 10;
 	float v1[10];
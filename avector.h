@@ -72,6 +72,8 @@ float aussie_vecdot_section512(float v1[], float v2[]);  // Simulate parallel 51
 float aussie_vecdot_parallel_basic(float v1[], float v2[], int n);   // Simulated parallel vector dot product
 float aussie_vecdot_parallel_odd_sizes(float v1[], float v2[], int n);   // Simulated parallel vector dot product
 float aussie_vecdot_parallel_padding(float v1[], float v2[], int n);   // Padding used for extra leftover array...
+float aussie_vecdot_parallel(const float v1[], const float v2[], int n);   // Real parallel vector dot product (thread pool)
+void aussie_vector_multiply_scalar_parallel(float v[], int n, float c);  // Multiply by constant, split across the thread pool
 float aussie_vecdot_pointer_arithmetic(float v1[], float v2[], int n);   // Pointer arithmetic vector dot product
 float aussie_vecdot_reverse_basic(float v1[], float v2[], int n);  // REVERSED basic vector dot product
 float aussie_vecdot_reverse_basic2(float v1[], float v2[], int n);   // REVERSED basic vector dot product #2
@@ -131,9 +133,11 @@ float aussie_vector_mean_and_variance_all_AVX1(float v[], int n, float& fmean_ou
 
 float aussie_vector_mean_AVX1(float v[], int n);  // Mean (same as average)
 float aussie_vector_mean_AVX2(float v[], int n);  // Mean (same as average)
+float aussie_vector_mean_AVX512(float v[], int n);  // Mean (same as average)
 float aussie_vector_mean_and_stddev_fused_AVX1(float v[], int n, float& meanout);  // Std. dev (sqrt of variance)
 float aussie_vector_mean_and_stddev_fused_AVX2(float v[], int n, float& meanout);  // Std. dev (sqrt of variance)
 float aussie_vector_mean_and_variance_fused_AVX2(float v[], int n, float& fmean_out);  // Variance (square of std. dev.)
+float aussie_vector_mean_and_variance_fused_AVX512(float v[], int n, float& fmean_out);  // Variance (square of std. dev.)
 float aussie_vector_mean_and_stddev_all_AVX1(float v[], int n, float& meanout);  // Std. dev (sqrt of variance)
 float aussie_vector_mean_and_stddev_all_AVX2(float v[], int n, float& meanout);  // Std. dev (sqrt of variance)
 
@@ -288,10 +292,10 @@ bool aussie_vector_equal_approx(float v1[], float v2[], int n, float err, bool w
 //-------------------------------------------------------------------------
 // Vector dot product benchmarking
 void aussie_benchmark_vecdot();  // vector dot product benchmarks...
-void run_vector_float_N(char* name, long int niter, long int nvecsize, 
+void run_vector_float_N(char* name, long int nvecsize, 
 	void (*voidvectorfnptr)(const float v[], int n),
 	float (*floatvectorfnptr)(const float v[], const float v2[], int n) = NULL);
-void run_vector_float_N_non_const(char* name, long int niter, long int nvecsize,
+void run_vector_float_N_non_const(char* name, long int nvecsize,
 	void (*voidvectorfnptr)(float v[], int n),
 	float (*floatvectorfnptr)(float v[], float v2[], int n) = NULL
 );